@@ -45,6 +45,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/autodiff/moduleVersion.cpp
   opm/autodiff/multiPhaseUpwind.cpp
   opm/autodiff/SimulatorFullyImplicitBlackoilOutput.cpp
+  opm/autodiff/SummaryStreamWriter.cpp
   opm/autodiff/SimulatorIncompTwophaseAd.cpp
   opm/autodiff/TransportSolverTwophaseAd.cpp
   opm/autodiff/BlackoilPropsAdFromDeck.cpp
@@ -58,6 +59,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/core/flowdiagnostics/AnisotropicEikonal.cpp
   opm/core/flowdiagnostics/DGBasis.cpp
   opm/core/flowdiagnostics/FlowDiagnostics.cpp
+  opm/core/flowdiagnostics/FlowDiagnosticsEnsemble.cpp
   opm/core/flowdiagnostics/TofDiscGalReorder.cpp
   opm/core/flowdiagnostics/TofReorder.cpp
   opm/core/linalg/LinearSolverFactory.cpp
@@ -92,6 +94,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/core/simulator/BlackoilState.cpp
   opm/core/simulator/TwophaseState.cpp
   opm/core/simulator/SimulatorReport.cpp
+  opm/core/transport/GravityColumnSolve.cpp
   opm/core/transport/TransportSolverTwophaseInterface.cpp
   opm/core/transport/reorder/ReorderSolverInterface.cpp
   opm/core/transport/reorder/TransportSolverCompressibleTwophaseReorder.cpp
@@ -102,6 +105,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/core/utility/miscUtilities.cpp
   opm/core/utility/miscUtilitiesBlackoil.cpp
   opm/core/utility/NullStream.cpp
+  opm/core/utility/SharedStaticArray.cpp
   opm/core/wells/InjectionSpecification.cpp
   opm/core/wells/ProductionSpecification.cpp
   opm/core/wells/WellCollection.cpp
@@ -122,7 +126,13 @@ list (APPEND MAIN_SOURCE_FILES
   opm/polymer/TransportSolverTwophasePolymer.cpp
   opm/simulators/ensureDirectoryExists.cpp
   opm/simulators/SimulatorCompressibleTwophase.cpp
+  opm/simulators/KernelCounters.cpp
+  opm/simulators/MemoryAccounting.cpp
+  opm/simulators/PerformanceTrace.cpp
+  opm/simulators/TimerRegistry.cpp
+  opm/simulators/RunProfile.cpp
   opm/simulators/WellSwitchingLogger.cpp
+  opm/simulators/DeferredLogger.cpp
   opm/simulators/vtk/writeVtkData.cpp
   opm/simulators/timestepping/TimeStepControl.cpp
   opm/simulators/timestepping/AdaptiveSimulatorTimer.cpp
@@ -141,10 +151,19 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_autodiffmatrix.cpp
   tests/test_blackoil_amg.cpp
   tests/test_block.cpp
+  tests/test_blockkernels.cpp
+  tests/test_compactstaticarray.cpp
+  tests/test_krylovsolvers.cpp
+  tests/test_linearsolvertuner.cpp
   tests/test_boprops_ad.cpp
   tests/test_graphcoloring.cpp
   tests/test_rateconverter.cpp
   tests/test_span.cpp
+  tests/test_sparsitypattern.cpp
+  tests/test_regionfluidinplace.cpp
+  tests/test_reordersequence.cpp
+  tests/test_reproduciblesum.cpp
+  tests/test_sharedstaticarray.cpp
   tests/test_syntax.cpp
   tests/test_scalar_mult.cpp
   tests/test_transmissibilitymultipliers.cpp
@@ -155,9 +174,18 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_multmatrixtransposed.cpp
   tests/test_multiphaseupwind.cpp
   tests/test_wellmodel.cpp
+  tests/test_standardwellmatrices.cpp
+  tests/test_segmenttreesolver.cpp
 #  tests/test_thresholdpressure.cpp
   tests/test_wellswitchlogger.cpp
+  tests/test_deferredlogger.cpp
+  tests/test_memoryaccounting.cpp
+  tests/test_performancetrace.cpp
+  tests/test_timerregistry.cpp
+  tests/test_runprofile.cpp
+  tests/test_threadhandle.cpp
   tests/test_timer.cpp
+  tests/test_timestepcontrol.cpp
   tests/test_invert.cpp
   tests/test_event.cpp
   tests/test_dgbasis.cpp
@@ -237,6 +265,9 @@ list (APPEND EXAMPLE_SOURCE_FILES
   examples/compute_initial_state.cpp
   examples/compute_tof_from_files.cpp
   examples/diagnose_relperm.cpp
+  examples/wellmodel_benchmark.cpp
+  examples/autodiff_benchmark.cpp
+  examples/linearsolver_overhead_benchmark.cpp
   tutorials/sim_tutorial1.cpp
   )
 
@@ -278,6 +309,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/autodiff/BlackoilPressureModel.hpp
   opm/autodiff/BlackoilPropsAdFromDeck.hpp
   opm/autodiff/Compat.hpp
+  opm/autodiff/CompactStaticArray.hpp
   opm/autodiff/CPRPreconditioner.hpp
   opm/autodiff/createGlobalCellArray.hpp
   opm/autodiff/DefaultBlackoilSolutionState.hpp
@@ -285,12 +317,13 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/autodiff/BlackoilReorderingTransportModel.hpp
   opm/autodiff/BlackoilTransportModel.hpp
   opm/autodiff/fastSparseOperations.hpp
-  opm/autodiff/DebugTimeReport.hpp
   opm/autodiff/DuneMatrix.hpp
   opm/autodiff/ExtractParallelGridInformationToISTL.hpp
+  opm/autodiff/FlowDiagnosticsEbos.hpp
   opm/autodiff/FlowMain.hpp
   opm/autodiff/FlowMainEbos.hpp
   opm/autodiff/FlowMainSequential.hpp
+  opm/autodiff/FusedReduction.hpp
   opm/autodiff/GeoProps.hpp
   opm/autodiff/GraphColoring.hpp
   opm/autodiff/GridHelpers.hpp
@@ -309,10 +342,16 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/autodiff/NonlinearSolver_impl.hpp
   opm/autodiff/NonlinearSolverEbos.hpp
   opm/autodiff/LinearisedBlackoilResidual.hpp
+  opm/autodiff/LinearSolverTelemetry.hpp
+  opm/autodiff/LinearSolverTuner.hpp
+  opm/autodiff/KrylovSolvers.hpp
+  opm/autodiff/MatrixBlockKernels.hpp
   opm/autodiff/ParallelDebugOutput.hpp
   opm/autodiff/ParallelOverlappingILU0.hpp
   opm/autodiff/ParallelRestrictedAdditiveSchwarz.hpp
+  opm/autodiff/ParallelWellInfo.hpp
   opm/autodiff/RateConverter.hpp
+  opm/autodiff/ReproducibleSum.hpp
   opm/autodiff/RedistributeDataHandles.hpp
   opm/autodiff/SimFIBODetails.hpp
   opm/autodiff/SimulatorBase.hpp
@@ -321,11 +360,16 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/autodiff/SimulatorFullyImplicitBlackoil.hpp
   opm/autodiff/SimulatorIncompTwophaseAd.hpp
   opm/autodiff/SimulatorSequentialBlackoil.hpp
+  opm/autodiff/SimulatorSnapshot.hpp
+  opm/autodiff/RegionFluidInPlace.hpp
+  opm/autodiff/SparsityPattern.hpp
+  opm/autodiff/SubdomainDirectSolver.hpp
   opm/autodiff/TransportSolverTwophaseAd.hpp
   opm/autodiff/WellConnectionAuxiliaryModule.hpp
   opm/autodiff/WellDensitySegmented.hpp
   opm/autodiff/WellStateFullyImplicitBlackoil.hpp
   opm/autodiff/SimulatorFullyImplicitBlackoilOutput.hpp
+  opm/autodiff/SummaryStreamWriter.hpp
   opm/autodiff/ThreadHandle.hpp
   opm/autodiff/VFPProperties.hpp
   opm/autodiff/VFPHelpers.hpp
@@ -337,6 +381,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/autodiff/WellInterface.hpp
   opm/autodiff/WellInterface_impl.hpp
   opm/autodiff/StandardWell.hpp
+  opm/autodiff/StandardWellMatrices.hpp
   opm/autodiff/StandardWell_impl.hpp
   opm/autodiff/MultisegmentWell.hpp
   opm/autodiff/MultisegmentWell_impl.hpp
@@ -347,6 +392,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/core/flowdiagnostics/AnisotropicEikonal.hpp
   opm/core/flowdiagnostics/DGBasis.hpp
   opm/core/flowdiagnostics/FlowDiagnostics.hpp
+  opm/core/flowdiagnostics/FlowDiagnosticsEnsemble.hpp
   opm/core/flowdiagnostics/TofDiscGalReorder.hpp
   opm/core/flowdiagnostics/TofReorder.hpp
   opm/core/linalg/LinearSolverFactory.hpp
@@ -405,6 +451,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/core/simulator/initStateEquil.hpp
   opm/core/simulator/initStateEquil_impl.hpp
   opm/core/simulator/initState_impl.hpp
+  opm/core/transport/GravityColumnSolve.hpp
   opm/core/transport/TransportSolverTwophaseInterface.hpp
   opm/core/transport/reorder/ReorderSolverInterface.hpp
   opm/core/transport/reorder/TransportSolverCompressibleTwophaseReorder.hpp
@@ -419,7 +466,9 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/core/utility/miscUtilitiesBlackoil.hpp
   opm/core/utility/miscUtilities_impl.hpp
   opm/core/utility/NullStream.hpp
+  opm/core/utility/OmpExceptionGuard.hpp
   opm/core/utility/share_obj.hpp
+  opm/core/utility/SharedStaticArray.hpp
   opm/core/well_controls.h
   opm/core/wells.h
   opm/core/wells/InjectionSpecification.hpp
@@ -456,7 +505,14 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/ParallelFileMerger.hpp
   opm/simulators/SimulatorCompressibleTwophase.hpp
   opm/simulators/thresholdPressures.hpp
+  opm/simulators/KernelCounters.hpp
+  opm/simulators/MemoryAccounting.hpp
+  opm/simulators/PerformanceTrace.hpp
+  opm/simulators/ProfileScope.hpp
+  opm/simulators/TimerRegistry.hpp
+  opm/simulators/RunProfile.hpp
   opm/simulators/WellSwitchingLogger.hpp
+  opm/simulators/DeferredLogger.hpp
   opm/simulators/vtk/writeVtkData.hpp
   opm/simulators/timestepping/AdaptiveSimulatorTimer.hpp
   opm/simulators/timestepping/AdaptiveTimeStepping.hpp
@@ -104,6 +104,87 @@ function(add_test_compare_parallel_simulation)
 endfunction()
 
 
+###########################################################################
+# BENCHMARK: add_scaling_benchmark
+###########################################################################
+
+# Input:
+#   - casename: basename (no extension)
+#
+# Details:
+#   - This target runs a model with all combinations of the process counts
+#     in OPM_BENCHMARK_RANKS and the thread counts in OPM_BENCHMARK_THREADS
+#     and writes the timings, speedup and efficiency to scaling.csv.
+function(add_scaling_benchmark)
+  set(oneValueArgs CASENAME FILENAME SIMULATOR)
+  set(multiValueArgs TEST_ARGS)
+  cmake_parse_arguments(PARAM "$" "${oneValueArgs}" "${multiValueArgs}" ${ARGN} )
+
+  if(NOT EXISTS ${OPM_TESTS_ROOT}/${PARAM_CASENAME}/${PARAM_FILENAME}.DATA)
+    return()
+  endif()
+
+  set(RESULT_PATH ${BASE_RESULT_PATH}/scaling/${PARAM_SIMULATOR}+${PARAM_CASENAME})
+  set(TARGET_NAME benchmark_scaling_${PARAM_SIMULATOR}+${PARAM_FILENAME})
+  add_custom_target(${TARGET_NAME}
+                    COMMAND ${PROJECT_SOURCE_DIR}/tests/run-scaling-benchmark.sh
+                            ${OPM_TESTS_ROOT}/${PARAM_CASENAME} ${RESULT_PATH}
+                            ${PROJECT_BINARY_DIR}/bin
+                            ${PARAM_FILENAME}
+                            ${PARAM_SIMULATOR}
+                            ${OPM_BENCHMARK_RANKS} ${OPM_BENCHMARK_THREADS}
+                            ${OPM_TESTS_ROOT}/${PARAM_CASENAME}/${PARAM_FILENAME} ${PARAM_TEST_ARGS}
+                    COMMENT "Running the scaling benchmark of ${PARAM_FILENAME}")
+  if(TARGET ${PARAM_SIMULATOR})
+    add_dependencies(${TARGET_NAME} ${PARAM_SIMULATOR})
+  endif()
+  if(NOT TARGET benchmark_scaling)
+    add_custom_target(benchmark_scaling)
+  endif()
+  add_dependencies(benchmark_scaling ${TARGET_NAME})
+endfunction()
+
+
+###########################################################################
+# TEST: add_test_performance
+###########################################################################
+
+# Input:
+#   - casename: basename (no extension)
+#
+# Details:
+#   - This test class runs a model and compares the wall time, the Newton
+#     and linear iterations and the peak memory to a baseline in
+#     OPM_PERFORMANCE_BASELINE_DIR, with a relative tolerance for each.
+#     A missing baseline is written by the first run.
+function(add_test_performance)
+  set(oneValueArgs CASENAME FILENAME SIMULATOR TIME_TOL ITER_TOL RSS_TOL)
+  set(multiValueArgs TEST_ARGS)
+  cmake_parse_arguments(PARAM "$" "${oneValueArgs}" "${multiValueArgs}" ${ARGN} )
+  if(NOT PARAM_TIME_TOL)
+    set(PARAM_TIME_TOL ${OPM_PERFORMANCE_TIME_TOL})
+  endif()
+  if(NOT PARAM_ITER_TOL)
+    set(PARAM_ITER_TOL ${OPM_PERFORMANCE_ITER_TOL})
+  endif()
+  if(NOT PARAM_RSS_TOL)
+    set(PARAM_RSS_TOL ${OPM_PERFORMANCE_RSS_TOL})
+  endif()
+
+  set(RESULT_PATH ${BASE_RESULT_PATH}/performance/${PARAM_SIMULATOR}+${PARAM_CASENAME})
+  set(TEST_ARGS ${OPM_TESTS_ROOT}/${PARAM_CASENAME}/${PARAM_FILENAME} ${PARAM_TEST_ARGS})
+  opm_add_test(performance_${PARAM_SIMULATOR}+${PARAM_FILENAME} NO_COMPILE
+               EXE_NAME ${PARAM_SIMULATOR}
+               DRIVER_ARGS ${OPM_TESTS_ROOT}/${PARAM_CASENAME} ${RESULT_PATH}
+                           ${PROJECT_BINARY_DIR}/bin
+                           ${PARAM_FILENAME}
+                           ${OPM_PERFORMANCE_BASELINE_DIR}
+                           ${PARAM_TIME_TOL} ${PARAM_ITER_TOL} ${PARAM_RSS_TOL}
+               TEST_ARGS ${TEST_ARGS})
+  set_tests_properties(performance_${PARAM_SIMULATOR}+${PARAM_FILENAME} PROPERTIES RUN_SERIAL TRUE)
+endfunction()
+
+
 ###########################################################################
 # TEST: add_test_compare_parallel_restarted_simulation
 ###########################################################################
@@ -329,6 +410,35 @@ foreach(sim flow flow_legacy)
                            DIR_PREFIX /init)
 endforeach()
 
+# Performance tests, the timings depend on the machine, hence they are
+# only added on request and compared to a baseline of the same machine
+option(OPM_PERFORMANCE_TESTS "Add the performance regression tests" OFF)
+if(OPM_PERFORMANCE_TESTS)
+  set(OPM_PERFORMANCE_BASELINE_DIR ${PROJECT_BINARY_DIR}/tests/performance-baseline
+      CACHE PATH "Directory of the baselines of the performance tests")
+  set(OPM_PERFORMANCE_TIME_TOL 0.1 CACHE STRING "Relative tolerance of the wall time of the performance tests")
+  set(OPM_PERFORMANCE_ITER_TOL 0.05 CACHE STRING "Relative tolerance of the iterations of the performance tests")
+  set(OPM_PERFORMANCE_RSS_TOL 0.1 CACHE STRING "Relative tolerance of the peak memory of the performance tests")
+  opm_set_test_driver(${PROJECT_SOURCE_DIR}/tests/run-performance-regressionTest.sh "")
+
+  foreach(SIM flow flow_legacy)
+    add_test_performance(CASENAME spe1
+                         FILENAME SPE1CASE2
+                         SIMULATOR ${SIM})
+    add_test_performance(CASENAME spe9
+                         FILENAME SPE9_CP_SHORT
+                         SIMULATOR ${SIM})
+  endforeach()
+
+  add_test_performance(CASENAME msw_3d_hfa
+                       FILENAME 3D_MSW
+                       SIMULATOR flow)
+
+  add_test_performance(CASENAME norne
+                       FILENAME NORNE_ATW2013
+                       SIMULATOR flow)
+endif()
+
 # Parallel tests
 if(MPI_FOUND)
   opm_set_test_driver(${PROJECT_SOURCE_DIR}/tests/run-restart-regressionTest.sh "")
@@ -363,4 +473,20 @@ if(MPI_FOUND)
                                        SIMULATOR flow
                                        ABS_TOL ${abs_tol_parallel}
                                        REL_TOL ${coarse_rel_tol_parallel})
+
+  # Scaling benchmarks, not part of the tests but run with "make benchmark_scaling"
+  set(OPM_BENCHMARK_RANKS "1,2,4" CACHE STRING "Comma separated numbers of processes of the scaling benchmarks")
+  set(OPM_BENCHMARK_THREADS "1" CACHE STRING "Comma separated numbers of threads of the scaling benchmarks")
+
+  add_scaling_benchmark(CASENAME spe1
+                        FILENAME SPE1CASE2
+                        SIMULATOR flow)
+
+  add_scaling_benchmark(CASENAME spe9
+                        FILENAME SPE9_CP
+                        SIMULATOR flow)
+
+  add_scaling_benchmark(CASENAME norne
+                        FILENAME NORNE_ATW2013
+                        SIMULATOR flow)
 endif()
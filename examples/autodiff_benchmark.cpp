@@ -0,0 +1,337 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Times the kernels of the AutoDiffBlock / AutoDiffMatrix layer on cartesian
+// grids of increasing size and, optionally, on the grid of a deck. Reports the
+// mean time, the throughput in cells per second and the number of heap
+// allocations of each kernel.
+//
+// Usage: autodiff_benchmark [sizes=8,16,32] [repetitions=20]
+//        [deck_filename=CASE.DATA] [csv_file=results.csv]
+//
+// A cartesian grid of size n has n x n x n cells.
+
+#include "config.h"
+
+#include <opm/autodiff/AutoDiffBlock.hpp>
+#include <opm/autodiff/AutoDiffHelpers.hpp>
+#include <opm/autodiff/AutoDiffMatrix.hpp>
+#include <opm/autodiff/fastSparseOperations.hpp>
+#include <opm/grid/GridManager.hpp>
+#include <opm/grid/UnstructuredGrid.h>
+#include <opm/common/ErrorMacros.hpp>
+#include <opm/common/utility/parameters/ParameterGroup.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+
+#include <dune/common/timer.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Count the heap allocations of the whole program by interposing malloc and
+// friends. Both operator new and Eigen allocate through malloc.
+#ifdef __GLIBC__
+#define OPM_COUNT_ALLOCATIONS 1
+
+namespace
+{
+    std::atomic<long> allocation_count(0);
+    std::atomic<long> allocation_bytes(0);
+
+    inline void countAllocation(const std::size_t size)
+    {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+}
+
+extern "C"
+{
+    void* __libc_malloc(std::size_t size);
+    void* __libc_calloc(std::size_t num, std::size_t size);
+    void* __libc_realloc(void* ptr, std::size_t size);
+
+    void* malloc(std::size_t size)
+    {
+        countAllocation(size);
+        return __libc_malloc(size);
+    }
+
+    void* calloc(std::size_t num, std::size_t size)
+    {
+        countAllocation(num * size);
+        return __libc_calloc(num, size);
+    }
+
+    void* realloc(void* ptr, std::size_t size)
+    {
+        countAllocation(size);
+        return __libc_realloc(ptr, size);
+    }
+}
+#endif // __GLIBC__
+
+namespace
+{
+
+    typedef Opm::AutoDiffBlock<double> ADB;
+    typedef ADB::V V;
+    typedef ADB::M M;
+    typedef Eigen::SparseMatrix<double> Sp;
+
+    /// \brief Accumulated timings and allocations of one kernel.
+    struct Timing
+    {
+        double total = 0.0;
+        double min = 1e100;
+        long calls = 0;
+        long allocations = 0;
+        long bytes = 0;
+    };
+
+    /// \brief One line of the report.
+    struct Result
+    {
+        std::string grid;
+        int cells;
+        std::string kernel;
+        Timing timing;
+    };
+
+    /// \brief Call kernel repetitions times after one warm-up call.
+    template <class Kernel>
+    Timing timeKernel(const int repetitions, Kernel&& kernel)
+    {
+        kernel();
+        Timing t;
+        for (int rep = 0; rep < repetitions; ++rep) {
+#if OPM_COUNT_ALLOCATIONS
+            const long count0 = allocation_count.load();
+            const long bytes0 = allocation_bytes.load();
+#endif
+            Dune::Timer timer;
+            kernel();
+            const double time = timer.elapsed();
+#if OPM_COUNT_ALLOCATIONS
+            t.allocations += allocation_count.load() - count0;
+            t.bytes += allocation_bytes.load() - bytes0;
+#endif
+            t.total += time;
+            t.min = std::min(t.min, time);
+            ++t.calls;
+        }
+        return t;
+    }
+
+    // AutoDiffMatrix of the given type with the sparsity of a cell to cell
+    // operator (div * grad) for the sparse type.
+    M makeMatrix(const std::string& type, const Opm::HelperOps& ops, const int nc)
+    {
+        if (type == "zero") {
+            return M(nc, nc);
+        }
+        if (type == "identity") {
+            return M::createIdentity(nc);
+        }
+        if (type == "diagonal") {
+            const Eigen::DiagonalMatrix<double, Eigen::Dynamic> d(V::Constant(nc, 2.0).matrix());
+            return M(d);
+        }
+        const Sp laplace = ops.div * ops.ngrad;
+        return M(laplace);
+    }
+
+    void benchmarkGrid(const std::string& name, const UnstructuredGrid& grid,
+                       const int repetitions, std::vector<Result>& results)
+    {
+        const Opm::HelperOps ops(grid);
+        const int nc = grid.number_of_cells;
+
+        auto add = [&](const std::string& kernel, const Timing& t) {
+            results.push_back(Result{ name, nc, kernel, t });
+        };
+
+        // AutoDiffMatrix products and sums for all type pairs.
+        const std::vector<std::string> types = { "zero", "identity", "diagonal", "sparse" };
+        for (const auto& lhs_type : types) {
+            const M lhs = makeMatrix(lhs_type, ops, nc);
+            for (const auto& rhs_type : types) {
+                const M rhs = makeMatrix(rhs_type, ops, nc);
+                M res;
+                add("M*M " + lhs_type + "*" + rhs_type,
+                    timeKernel(repetitions, [&]() { res = lhs * rhs; }));
+                add("M+M " + lhs_type + "+" + rhs_type,
+                    timeKernel(repetitions, [&]() { res = lhs + rhs; }));
+            }
+        }
+
+        // Raw sparse kernels.
+        {
+            const Sp laplace = ops.div * ops.ngrad;
+            const std::vector<double> diag(nc, 2.0);
+            Sp res;
+            add("fastSparseProduct",
+                timeKernel(repetitions, [&]() { Opm::fastSparseProduct(laplace, laplace, res); }));
+            add("fastDiagSparseProduct",
+                timeKernel(repetitions, [&]() { Opm::fastDiagSparseProduct(diag, laplace, res); }));
+            add("fastSparseDiagProduct",
+                timeKernel(repetitions, [&]() { Opm::fastSparseDiagProduct(laplace, diag, res); }));
+        }
+
+        // AD variables of a three phase model: pressure and two saturations.
+        const std::vector<ADB> vars = ADB::variables({ V::Constant(nc, 2e7),
+                                                       V::Constant(nc, 0.2),
+                                                       V::Constant(nc, 0.1) });
+        const ADB& p = vars[0];
+
+        // subset / superset on every other cell.
+        {
+            std::vector<int> cells;
+            for (int c = 0; c < nc; c += 2) {
+                cells.push_back(c);
+            }
+            const ADB sub = Opm::subset(p, cells);
+            ADB res = ADB::null();
+            add("subset ADB",
+                timeKernel(repetitions, [&]() { res = Opm::subset(p, cells); }));
+            add("superset ADB",
+                timeKernel(repetitions, [&]() { res = Opm::superset(sub, cells, nc); }));
+        }
+
+        // Discrete operators of the residual assembly.
+        {
+            const ADB flux = ops.ngrad * p;
+            ADB res = ADB::null();
+            add("HelperOps::grad",
+                timeKernel(repetitions, [&]() { res = ops.grad * p; }));
+            add("HelperOps::div",
+                timeKernel(repetitions, [&]() { res = ops.div * flux; }));
+            add("ADB a*b",
+                timeKernel(repetitions, [&]() { res = vars[1] * vars[2]; }));
+            add("ADB a+b",
+                timeKernel(repetitions, [&]() { res = vars[1] + vars[2]; }));
+        }
+    }
+
+    void printResults(const std::vector<Result>& results)
+    {
+        std::cout << std::left << std::setw(12) << "grid"
+                  << std::right << std::setw(10) << "cells"
+                  << std::left << "  " << std::setw(30) << "kernel"
+                  << std::right << std::setw(14) << "mean [us]"
+                  << std::setw(14) << "min [us]"
+                  << std::setw(16) << "Mcells/s"
+                  << std::setw(14) << "allocs/call"
+                  << std::setw(14) << "kB/call" << '\n';
+        for (const auto& r : results) {
+            const Timing& t = r.timing;
+            const double mean = t.total / t.calls;
+            std::cout << std::left << std::setw(12) << r.grid
+                      << std::right << std::setw(10) << r.cells
+                      << std::left << "  " << std::setw(30) << r.kernel
+                      << std::right << std::setprecision(6)
+                      << std::setw(14) << 1e6 * mean
+                      << std::setw(14) << 1e6 * t.min
+                      << std::setw(16) << 1e-6 * r.cells / mean;
+#if OPM_COUNT_ALLOCATIONS
+            std::cout << std::setw(14) << double(t.allocations) / t.calls
+                      << std::setw(14) << 1e-3 * t.bytes / t.calls << '\n';
+#else
+            std::cout << std::setw(14) << "n/a" << std::setw(14) << "n/a" << '\n';
+#endif
+        }
+    }
+
+    void writeCsv(const std::string& filename, const std::vector<Result>& results)
+    {
+        std::ofstream os(filename);
+        if (!os) {
+            OPM_THROW(std::runtime_error, "Failed to open " << filename);
+        }
+        os << "grid,cells,kernel,calls,mean_us,min_us,mcells_per_s,allocs_per_call,bytes_per_call\n";
+        for (const auto& r : results) {
+            const Timing& t = r.timing;
+            const double mean = t.total / t.calls;
+            os << r.grid << ',' << r.cells << ',' << r.kernel << ',' << t.calls << ','
+               << 1e6 * mean << ',' << 1e6 * t.min << ',' << 1e-6 * r.cells / mean << ','
+               << double(t.allocations) / t.calls << ',' << double(t.bytes) / t.calls << '\n';
+        }
+    }
+
+} // anonymous namespace
+
+
+// ----------------- Main program -----------------
+int
+main(int argc, char** argv)
+try
+{
+    Opm::ParameterGroup param(argc, argv, false);
+    const std::string sizes = param.getDefault<std::string>("sizes", "8,16,32");
+    const int repetitions = param.getDefault("repetitions", 20);
+
+    std::vector<Result> results;
+
+    // cartesian grids
+    std::istringstream size_list(sizes);
+    std::string size;
+    while (std::getline(size_list, size, ',')) {
+        const int n = std::atoi(size.c_str());
+        if (n <= 0) {
+            OPM_THROW(std::runtime_error, "Invalid grid size " << size << " in sizes=" << sizes);
+        }
+        const Opm::GridManager grid_manager(n, n, n);
+        benchmarkGrid("cart" + size, *grid_manager.c_grid(), repetitions, results);
+    }
+
+    // the grid of a deck
+    if (param.has("deck_filename")) {
+        const std::string deck_filename = param.get<std::string>("deck_filename");
+        Opm::ParseContext parse_context;
+        Opm::Parser parser;
+        const Opm::Deck deck = parser.parseFile(deck_filename, parse_context);
+        const Opm::EclipseState ecl_state(deck, parse_context);
+        const Opm::GridManager grid_manager(ecl_state.getInputGrid());
+        benchmarkGrid("deck", *grid_manager.c_grid(), repetitions, results);
+    }
+
+    std::cout << "Repetitions: " << repetitions << "\n\n";
+    printResults(results);
+
+    if (param.has("csv_file")) {
+        writeCsv(param.get<std::string>("csv_file"), results);
+    }
+    return EXIT_SUCCESS;
+}
+catch (const std::exception& e)
+{
+    std::cerr << "Program threw an exception: " << e.what() << "\n";
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,231 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Times repeated linear solves of the ISTLSolver with the same matrix object,
+// as in the Newton iterations of a simulation, on block tridiagonal systems of
+// increasing size. The time per solve of the smallest systems is dominated by
+// the fixed overhead of a solve, i.e. the setup of the scalar product, the
+// operators and the preconditioner, rather than by the Krylov iterations.
+//
+// Usage: linearsolver_overhead_benchmark [sizes=1,10,100,1000] [repetitions=1000]
+//        [any parameter of NewtonIterationBlackoilInterleavedParameters]
+
+#include "config.h"
+
+#include <opm/autodiff/ISTLSolver.hpp>
+#include <opm/common/ErrorMacros.hpp>
+#include <opm/common/utility/parameters/ParameterGroup.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/operators.hh>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+    enum { BlockSize = 3 };
+
+    typedef Dune::MatrixBlock<double, BlockSize, BlockSize> MatrixBlockType;
+    typedef Dune::FieldVector<double, BlockSize> VectorBlockType;
+    typedef Dune::BCRSMatrix<MatrixBlockType> Matrix;
+    typedef Dune::BlockVector<VectorBlockType> Vector;
+    typedef Opm::ISTLSolver<MatrixBlockType, VectorBlockType> Solver;
+
+    /// \brief A sequential operator of its own type, like the operator of the
+    ///        simulator that adds the wells, such that the solver has to create
+    ///        the matrix operator of the AMG and CPR preconditioners.
+    class Operator : public Dune::AssembledLinearOperator<Matrix, Vector, Vector>
+    {
+    public:
+        typedef Matrix matrix_type;
+        typedef Vector domain_type;
+        typedef Vector range_type;
+        typedef double field_type;
+
+#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 6)
+        Dune::SolverCategory::Category category() const override
+        {
+            return Dune::SolverCategory::sequential;
+        }
+#else
+        enum {
+            //! \brief The solver category.
+            category = Dune::SolverCategory::sequential
+        };
+#endif
+
+        explicit Operator(const Matrix& A)
+            : A_(A)
+        {}
+
+        virtual void apply(const Vector& x, Vector& y) const
+        {
+            A_.mv(x, y);
+        }
+
+        virtual void applyscaleadd(field_type alpha, const Vector& x, Vector& y) const
+        {
+            A_.usmv(alpha, x, y);
+        }
+
+        virtual const matrix_type& getmat() const
+        {
+            return A_;
+        }
+
+    private:
+        const Matrix& A_;
+    };
+
+    /// \brief A diagonally dominant block tridiagonal matrix with n block rows,
+    ///        whose first component is coupled like a pressure.
+    void buildMatrix(const int n, Matrix& A)
+    {
+        A.setSize(n, n, 3 * n);
+        A.setBuildMode(Matrix::row_wise);
+        for (auto row = A.createbegin(); row != A.createend(); ++row) {
+            const int i = row.index();
+            if (i > 0) {
+                row.insert(i - 1);
+            }
+            row.insert(i);
+            if (i < n - 1) {
+                row.insert(i + 1);
+            }
+        }
+        for (int i = 0; i < n; ++i) {
+            for (auto col = A[i].begin(); col != A[i].end(); ++col) {
+                MatrixBlockType& block = *col;
+                block = 0.0;
+                const bool diagonal = col.index() == static_cast<unsigned>(i);
+                for (int k = 0; k < BlockSize; ++k) {
+                    block[k][k] = diagonal ? 2.5 : -1.0;
+                    if (diagonal && k > 0) {
+                        block[k][0] = 0.1;
+                    }
+                }
+            }
+        }
+    }
+
+    /// \brief Accumulated timings of the solves of one system.
+    struct Result
+    {
+        int cells = 0;
+        double first = 0.0;
+        double total = 0.0;
+        double min = 1e100;
+        long calls = 0;
+        int iterations = 0;
+    };
+
+    Result benchmarkSize(const int n, const int repetitions, const Opm::ParameterGroup& param)
+    {
+        Matrix A;
+        buildMatrix(n, A);
+        Operator opA(A);
+        Solver solver(param);
+
+        Result result;
+        result.cells = n;
+        Vector x(n);
+        Vector b(n);
+        for (int rep = 0; rep <= repetitions; ++rep) {
+            // the solver overwrites the right hand side
+            b = 1.0;
+            x = 0.0;
+            Dune::Timer timer;
+            solver.solve(opA, x, b);
+            const double time = timer.elapsed();
+            if (rep == 0) {
+                // the first solve creates the objects kept by the solver
+                result.first = time;
+                continue;
+            }
+            result.total += time;
+            result.min = std::min(result.min, time);
+            ++result.calls;
+        }
+        result.iterations = solver.iterations();
+        return result;
+    }
+
+    void printResults(const std::vector<Result>& results)
+    {
+        std::cout << std::left << std::setw(10) << "Cells" << std::right
+                  << std::setw(14) << "First [us]" << std::setw(14) << "Mean [us]"
+                  << std::setw(14) << "Min [us]" << std::setw(12) << "Iterations" << '\n';
+        std::cout << std::fixed << std::setprecision(2);
+        for (const Result& r : results) {
+            std::cout << std::left << std::setw(10) << r.cells << std::right
+                      << std::setw(14) << 1e6 * r.first
+                      << std::setw(14) << (r.calls > 0 ? 1e6 * r.total / r.calls : 0.0)
+                      << std::setw(14) << (r.calls > 0 ? 1e6 * r.min : 0.0)
+                      << std::setw(12) << r.iterations << '\n';
+        }
+    }
+
+} // anonymous namespace
+
+
+// ----------------- Main program -----------------
+int
+main(int argc, char** argv)
+try
+{
+    Dune::MPIHelper::instance(argc, argv);
+    Opm::ParameterGroup param(argc, argv, false);
+    const std::string sizes = param.getDefault<std::string>("sizes", "1,10,100,1000");
+    const int repetitions = param.getDefault("repetitions", 1000);
+
+    std::vector<Result> results;
+    std::istringstream size_list(sizes);
+    std::string size;
+    while (std::getline(size_list, size, ',')) {
+        const int n = std::atoi(size.c_str());
+        if (n <= 0) {
+            OPM_THROW(std::runtime_error, "Invalid system size " << size << " in sizes=" << sizes);
+        }
+        results.push_back(benchmarkSize(n, repetitions, param));
+    }
+
+    std::cout << "Block size:  " << BlockSize << '\n'
+              << "Repetitions: " << repetitions << "\n\n";
+    printResults(results);
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception& e)
+{
+    std::cerr << "Program threw an exception: " << e.what() << "\n";
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,334 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Times the parts of the well model on the initial reservoir state of a deck,
+// without running a simulation.
+//
+// Usage: wellmodel_benchmark deck_filename=CASE.DATA [repetitions=100] [dt=86400]
+//        [any parameter of BlackoilModelParameters]
+
+#include "config.h"
+
+#include <opm/grid/CpGrid.hpp>
+#include <opm/autodiff/BlackoilModelEbos.hpp>
+#include <opm/autodiff/BlackoilWellModel.hpp>
+#include <opm/autodiff/BlackoilModelParameters.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+#include <opm/material/common/ResetLocale.hpp>
+
+#include <ewoms/common/start.hh>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+    typedef TTAG(EclFlowProblem) TypeTag;
+    typedef GET_PROP_TYPE(TypeTag, Simulator) EbosSimulator;
+    typedef GET_PROP_TYPE(TypeTag, ThreadManager) EbosThreadManager;
+
+    /// \brief Accumulated timings of one operation.
+    struct Timing
+    {
+        double total = 0.0;
+        double min = 1e100;
+        double max = 0.0;
+        long calls = 0;
+
+        void add(const double time)
+        {
+            total += time;
+            min = std::min(min, time);
+            max = std::max(max, time);
+            ++calls;
+        }
+    };
+
+    /// \brief The well model with access to its wells, timing their parts one by one.
+    class BenchmarkWellModel : public Opm::BlackoilWellModel<TypeTag>
+    {
+    public:
+        typedef Opm::BlackoilWellModel<TypeTag> Base;
+        typedef Base::BVector BVector;
+        typedef Base::WellState WellState;
+
+        // timings by operation and well type
+        typedef std::map<std::string, std::map<std::string, Timing> > Timings;
+
+        using Base::Base;
+        using Base::computeWellPotentials;
+
+        void clearWellPotentialsCache()
+        {
+            this->well_potentials_cache_.clear();
+        }
+
+        void timeWells(const int repetitions, const double dt, Timings& timings)
+        {
+            const int nc = this->ebosSimulator_.model().numGridDof();
+            BVector x(nc);
+            BVector Ax(nc);
+            x = 1e-8;
+            Ax = 0.0;
+
+            // restore the state after each operation, such that all
+            // repetitions see the same well state.
+            const WellState frozen_state = this->well_state_;
+
+            for (auto& well : this->well_container_) {
+                const std::string type = wellType(*well);
+
+                for (int rep = 0; rep < repetitions; ++rep) {
+                    Dune::Timer timer;
+                    well->assembleWellEq(this->ebosSimulator_, dt, this->well_state_, false);
+                    timings["assemble"][type].add(timer.elapsed());
+                }
+
+                for (int rep = 0; rep < repetitions; ++rep) {
+                    Dune::Timer timer;
+                    well->apply(x, Ax);
+                    timings["apply"][type].add(timer.elapsed());
+                }
+
+                for (int rep = 0; rep < repetitions; ++rep) {
+                    Dune::Timer timer;
+                    well->recoverWellSolutionAndUpdateWellState(x, this->well_state_);
+                    timings["recoverWellSolutionAndUpdateWellState"][type].add(timer.elapsed());
+                    this->well_state_ = frozen_state;
+                }
+
+                // the wells themselves do not cache their potentials
+                std::vector<double> potentials;
+                for (int rep = 0; rep < repetitions; ++rep) {
+                    Dune::Timer timer;
+                    well->computeWellPotentials(this->ebosSimulator_, this->well_state_, potentials);
+                    timings["computeWellPotentials"][type].add(timer.elapsed());
+                }
+                this->well_state_ = frozen_state;
+            }
+        }
+
+        // evaluate bhp(thp) and thp(bhp) of the THP constraints of all producers
+        void timeVFP(const int repetitions, Timings& timings) const
+        {
+            const Opm::VFPProdProperties* vfp_prod = this->vfp_properties_->getProd();
+            const auto& pu = this->phase_usage_;
+            const int np = pu.num_phases;
+            const std::vector<double>& rates = this->well_state_.wellRates();
+
+            for (const auto& well : this->well_container_) {
+                if (well->wellType() != PRODUCER) {
+                    continue;
+                }
+                const int w = well->indexOfWell();
+                const double aqua = pu.phase_used[Opm::BlackoilPhases::Aqua] ?
+                    rates[w * np + pu.phase_pos[Opm::BlackoilPhases::Aqua]] : 0.0;
+                const double liquid = pu.phase_used[Opm::BlackoilPhases::Liquid] ?
+                    rates[w * np + pu.phase_pos[Opm::BlackoilPhases::Liquid]] : 0.0;
+                const double vapour = pu.phase_used[Opm::BlackoilPhases::Vapour] ?
+                    rates[w * np + pu.phase_pos[Opm::BlackoilPhases::Vapour]] : 0.0;
+
+                const WellControls* wc = well->wellControls();
+                const int nwc = well_controls_get_num(wc);
+                for (int ctrl_index = 0; ctrl_index < nwc; ++ctrl_index) {
+                    if (well_controls_iget_type(wc, ctrl_index) != THP) {
+                        continue;
+                    }
+                    const int table_id = well_controls_iget_vfp(wc, ctrl_index);
+                    const double alq = well_controls_iget_alq(wc, ctrl_index);
+                    const double thp = well_controls_iget_target(wc, ctrl_index);
+                    const double bhp = vfp_prod->bhp(table_id, aqua, liquid, vapour, thp, alq);
+
+                    for (int rep = 0; rep < repetitions; ++rep) {
+                        Dune::Timer timer;
+                        vfp_prod->bhp(table_id, aqua, liquid, vapour, thp, alq);
+                        timings["vfp bhp"]["producer"].add(timer.elapsed());
+                    }
+                    for (int rep = 0; rep < repetitions; ++rep) {
+                        Dune::Timer timer;
+                        vfp_prod->thp(table_id, aqua, liquid, vapour, bhp, alq);
+                        timings["vfp thp"]["producer"].add(timer.elapsed());
+                    }
+                }
+            }
+        }
+
+        void setWellState(const WellState& well_state)
+        {
+            this->well_state_ = well_state;
+        }
+
+        int numWellsOfType(const std::string& type) const
+        {
+            int count = 0;
+            for (const auto& well : this->well_container_) {
+                if (wellType(*well) == type) {
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+    private:
+        static std::string wellType(const Opm::WellInterface<TypeTag>& well)
+        {
+            if (dynamic_cast<const Opm::MultisegmentWell<TypeTag>* >(&well)) {
+                return "multisegment";
+            }
+            return "standard";
+        }
+    };
+
+    void printTimings(const BenchmarkWellModel::Timings& timings)
+    {
+        std::cout << std::left << std::setw(40) << "operation"
+                  << std::setw(14) << "well type"
+                  << std::right << std::setw(10) << "calls"
+                  << std::setw(14) << "total [s]"
+                  << std::setw(14) << "mean [us]"
+                  << std::setw(14) << "min [us]"
+                  << std::setw(14) << "max [us]" << '\n';
+        for (const auto& operation : timings) {
+            for (const auto& type : operation.second) {
+                const Timing& t = type.second;
+                std::cout << std::left << std::setw(40) << operation.first
+                          << std::setw(14) << type.first
+                          << std::right << std::setw(10) << t.calls
+                          << std::setw(14) << std::setprecision(6) << t.total
+                          << std::setw(14) << 1e6 * t.total / t.calls
+                          << std::setw(14) << 1e6 * t.min
+                          << std::setw(14) << 1e6 * t.max << '\n';
+            }
+        }
+    }
+
+} // anonymous namespace
+
+
+// ----------------- Main program -----------------
+int
+main(int argc, char** argv)
+try
+{
+    Opm::resetLocale();
+    Dune::MPIHelper::instance(argc, argv);
+
+    Opm::ParameterGroup param(argc, argv, false);
+    const std::string deck_filename = param.get<std::string>("deck_filename");
+    const int repetitions = param.getDefault("repetitions", 100);
+    const double dt = param.getDefault("dt", 86400.0);
+    const Opm::BlackoilModelParameters model_param(param);
+
+    // set up the reservoir on the initial state of the deck
+    std::string deck_file_param("--ecl-deck-file-name=");
+    deck_file_param += deck_filename;
+    std::vector<const char*> ebos_argv = { "wellmodel_benchmark", deck_file_param.c_str() };
+
+    EbosSimulator::registerParameters();
+    Ewoms::setupParameters_<TypeTag>(ebos_argv.size(), &ebos_argv[0]);
+    EbosThreadManager::init();
+    EbosSimulator ebos_simulator(/*verbose=*/false);
+    ebos_simulator.model().applyInitialSolution();
+
+    ebos_simulator.startNextEpisode(/*episodeStartTime=*/0.0, /*episodeLength=*/1e30);
+    ebos_simulator.setEpisodeIndex(0);
+    ebos_simulator.setTime(0.0);
+    ebos_simulator.setTimeStepSize(dt);
+    ebos_simulator.problem().beginTimeStep();
+    ebos_simulator.model().linearizer().linearize();
+
+    BenchmarkWellModel well_model(ebos_simulator, model_param, /*terminal_output=*/false);
+    well_model.beginReportStep(0);
+    well_model.beginTimeStep(0, 0.0);
+
+    // the first assembly computes the explicit quantities of the time step
+    well_model.assemble(/*iterationIdx=*/0, dt);
+
+    std::cout << "Deck:                " << deck_filename << '\n'
+              << "Standard wells:      " << well_model.numWellsOfType("standard") << '\n'
+              << "Multisegment wells:  " << well_model.numWellsOfType("multisegment") << '\n'
+              << "Repetitions:         " << repetitions << "\n\n";
+
+    BenchmarkWellModel::Timings timings;
+
+    // the whole well model
+    {
+        const int nc = ebos_simulator.model().numGridDof();
+        BenchmarkWellModel::BVector x(nc);
+        BenchmarkWellModel::BVector Ax(nc);
+        x = 1e-8;
+        Ax = 0.0;
+        const auto frozen_state = well_model.wellState();
+
+        for (int rep = 0; rep < repetitions; ++rep) {
+            Dune::Timer timer;
+            well_model.assemble(/*iterationIdx=*/1, dt);
+            timings["assemble"]["all"].add(timer.elapsed());
+        }
+        for (int rep = 0; rep < repetitions; ++rep) {
+            Dune::Timer timer;
+            well_model.apply(x, Ax);
+            timings["apply"]["all"].add(timer.elapsed());
+        }
+        for (int rep = 0; rep < repetitions; ++rep) {
+            Dune::Timer timer;
+            well_model.recoverWellSolutionAndUpdateWellState(x);
+            timings["recoverWellSolutionAndUpdateWellState"]["all"].add(timer.elapsed());
+            well_model.setWellState(frozen_state);
+        }
+        // the well model reuses the potentials of the wells whose state has
+        // not changed, so the potentials are timed both with an empty cache,
+        // as at the first time step of a report step, and with the cache of
+        // the previous repetition
+        std::vector<double> potentials;
+        for (int rep = 0; rep < repetitions; ++rep) {
+            well_model.clearWellPotentialsCache();
+            Dune::Timer timer;
+            well_model.computeWellPotentials(potentials);
+            timings["computeWellPotentials (cold cache)"]["all"].add(timer.elapsed());
+        }
+        for (int rep = 0; rep < repetitions; ++rep) {
+            Dune::Timer timer;
+            well_model.computeWellPotentials(potentials);
+            timings["computeWellPotentials (warm cache)"]["all"].add(timer.elapsed());
+        }
+        well_model.setWellState(frozen_state);
+    }
+
+    // the wells one by one
+    well_model.timeWells(repetitions, dt, timings);
+    well_model.timeVFP(repetitions, timings);
+
+    printTimings(timings);
+    return EXIT_SUCCESS;
+}
+catch (const std::exception& e)
+{
+    std::cerr << "Program threw an exception: " << e.what() << "\n";
+    return EXIT_FAILURE;
+}
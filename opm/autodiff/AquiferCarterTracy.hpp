@@ -70,32 +70,68 @@ namespace Opm
 
             inline void assembleAquiferEq(const SimulatorTimerInterface& timer)
             {
-                auto& ebosJac = ebos_simulator_.model().linearizer().matrix();
-                auto& ebosResid = ebos_simulator_.model().linearizer().residual();
+                calculateInflowRates(timer);
+                addInflowRates();
+            }
+
+            // Compute the inflow rates of all the connections at the
+            // current reservoir state, without touching the linear system.
+            // Different aquifers may do this concurrently.
+            inline void calculateInflowRates(const SimulatorTimerInterface& timer)
+            {
+                // The influence function only depends on the time, so it
+                // is evaluated once for all the connections.
+                const InfluenceCoefficients coeff = calculateInfluenceCoefficients(timer);
 
-                size_t cellID;
-                for ( size_t idx = 0; idx < cell_idx_.size(); ++idx )
+                const size_t numConnections = cell_idx_.size();
+                for ( size_t idx = 0; idx < numConnections; ++idx )
                 {
-                    Eval qinflow = 0.0;
-                    cellID = cell_idx_.at(idx);
-                    // We are dereferencing the value of IntensiveQuantities because cachedIntensiveQuantities return a const pointer to
+                    // cachedIntensiveQuantities returns a const pointer to the
                     // IntensiveQuantities of that particular cell_id
-                    const IntensiveQuantities intQuants = *(ebos_simulator_.model().cachedIntensiveQuantities(cellID, /*timeIdx=*/ 0));
+                    const auto& fs = ebos_simulator_.model().cachedIntensiveQuantities(cell_idx_[idx], /*timeIdx=*/ 0)->fluidState();
                     // This is the pressure at td + dt
-                    updateCellPressure(pressure_current_,idx,intQuants);
-                    updateCellDensity(idx,intQuants);
-                    calculateInflowRate(idx, timer);
-                    qinflow = Qai_.at(idx);
+                    pressure_current_[idx] = fs.pressure(waterPhaseIdx);
+                    rhow_[idx] = fs.density(waterPhaseIdx);
+                    calculateInflowRate(idx, coeff);
+                }
+            }
+
+            // Add the inflow rates of calculateInflowRates() to the
+            // residual and Jacobian of the connected cells.
+            inline void addInflowRates()
+            {
+                auto& ebosJac = ebos_simulator_.model().linearizer().matrix();
+                auto& ebosResid = ebos_simulator_.model().linearizer().residual();
+
+                const size_t numConnections = cell_idx_.size();
+                for ( size_t idx = 0; idx < numConnections; ++idx )
+                {
+                    const size_t cellID = cell_idx_[idx];
+                    const Eval& qinflow = Qai_[idx];
                     ebosResid[cellID][waterCompIdx] -= qinflow.value();
 
+                    // The diagonal block is looked up once, not per derivative.
+                    auto& diagBlock = ebosJac[cellID][cellID];
                     for (int pvIdx = 0; pvIdx < numEq; ++pvIdx) 
                     {
                         // also need to consider the efficiency factor when manipulating the jacobians.
-                        ebosJac[cellID][cellID][waterCompIdx][pvIdx] -= qinflow.derivative(pvIdx);
+                        diagBlock[waterCompIdx][pvIdx] -= qinflow.derivative(pvIdx);
                     }
                 }
             }
 
+            // Add the inflow rates of calculateInflowRates() to a residual
+            // of the reservoir only.
+            template <class Vector>
+            void addInflowResidual(Vector& residual) const
+            {
+                const size_t numConnections = cell_idx_.size();
+                for ( size_t idx = 0; idx < numConnections; ++idx )
+                {
+                    residual[cell_idx_[idx]][waterCompIdx] -= Qai_[idx].value();
+                }
+            }
+
             inline void beforeTimeStep(const SimulatorTimerInterface& timer)
             {
                 auto cellID = cell_idx_.begin();
@@ -107,6 +143,12 @@ namespace Opm
                 }
             }
 
+            // The cells connected to the aquifer.
+            const std::vector<size_t>& cells() const
+            {
+                return cell_idx_;
+            }
+
             inline void afterTimeStep(const SimulatorTimerInterface& timer)
             {
                 for (auto Qai = Qai_.begin(); Qai != Qai_.end(); ++Qai)
@@ -167,48 +209,46 @@ namespace Opm
                 Qai_.resize(cell_idx_.size(), 0.0);
             }
 
-            inline void updateCellPressure(std::vector<Eval>& pressure_water, const int idx, const IntensiveQuantities& intQuants)
-            {
-                const auto& fs = intQuants.fluidState();
-                pressure_water.at(idx) = fs.pressure(waterPhaseIdx);
-            }
-
             inline void updateCellPressure(std::vector<Scalar>& pressure_water, const int idx, const IntensiveQuantities& intQuants)
             {
                 const auto& fs = intQuants.fluidState();
                 pressure_water.at(idx) = fs.pressure(waterPhaseIdx).value();
             }
 
-            inline void updateCellDensity(const int idx, const IntensiveQuantities& intQuants)
+            inline Scalar dpai(const size_t idx) const
             {
-                const auto& fs = intQuants.fluidState();
-                rhow_.at(idx) = fs.density(waterPhaseIdx);
+                Scalar dp = pa0_ + rhow_[idx].value()*gravity_*(cell_depth_[idx] - aquct_data_.d0) - pressure_previous_[idx];
+                return dp;
             }
 
-            inline Scalar dpai(int idx)
+            // The parts of Eqs 5.8 and 5.9 of the EclipseTechnicalDescription
+            // that are the same for all the connections.
+            struct InfluenceCoefficients
             {
-                Scalar dp = pa0_ + rhow_.at(idx).value()*gravity_*(cell_depth_.at(idx) - aquct_data_.d0) - pressure_previous_.at(idx);
-                return dp;
-            }
+                Scalar PItd;
+                Scalar PItdprime;
+                Scalar denom; // PItd - td*PItdprime
+                Scalar b;
+            };
 
-            // This function implements Eqs 5.8 and 5.9 of the EclipseTechnicalDescription
-            inline void calculateEqnConstants(Scalar& a, Scalar& b, const int idx, const SimulatorTimerInterface& timer)
+            inline InfluenceCoefficients calculateInfluenceCoefficients(const SimulatorTimerInterface& timer)
             {
                 const Scalar td_plus_dt = (timer.currentStepLength() + timer.simulationTimeElapsed()) / Tc_;
                 const Scalar td = timer.simulationTimeElapsed() / Tc_;
-                Scalar PItdprime = 0.;
-                Scalar PItd = 0.;
-                getInfluenceTableValues(PItd, PItdprime, td_plus_dt);
-                a = 1.0/Tc_ * ( (beta_ * dpai(idx)) - (W_flux_.value() * PItdprime) ) / ( PItd - td*PItdprime );
-                b = beta_ / (Tc_ * ( PItd - td*PItdprime));
+                InfluenceCoefficients coeff;
+                coeff.PItdprime = 0.;
+                coeff.PItd = 0.;
+                getInfluenceTableValues(coeff.PItd, coeff.PItdprime, td_plus_dt);
+                coeff.denom = coeff.PItd - td*coeff.PItdprime;
+                coeff.b = beta_ / (Tc_ * coeff.denom);
+                return coeff;
             }
 
-            // This function implements Eq 5.7 of the EclipseTechnicalDescription       
-            inline void calculateInflowRate(int idx, const SimulatorTimerInterface& timer)
+            // This function implements Eqs 5.7 and 5.8 of the EclipseTechnicalDescription
+            inline void calculateInflowRate(const size_t idx, const InfluenceCoefficients& coeff)
             {
-                Scalar a, b;
-                calculateEqnConstants(a,b,idx,timer);
-                Qai_.at(idx) = alphai_.at(idx)*( a - b * ( pressure_current_.at(idx) - pressure_previous_.at(idx) ) );
+                const Scalar a = 1.0/Tc_ * ( (beta_ * dpai(idx)) - (W_flux_.value() * coeff.PItdprime) ) / coeff.denom;
+                Qai_[idx] = alphai_[idx]*( a - coeff.b * ( pressure_current_[idx] - pressure_previous_[idx] ) );
             }
 
             inline void calculateAquiferConstants()
@@ -338,7 +378,7 @@ namespace Opm
             inline Scalar calculateReservoirEquilibrium()
             {
                 // Since the global_indices are the reservoir index, we just need to extract the fluidstate at those indices
-                std::vector<Scalar> pw_aquifer;
+                Scalar pw_aquifer_sum = 0.;
                 Scalar water_pressure_reservoir;
 
                 for (size_t idx = 0; idx < cell_idx_.size(); ++idx)
@@ -349,11 +389,11 @@ namespace Opm
                     
                     water_pressure_reservoir = fs.pressure(waterPhaseIdx).value();
                     rhow_.at(idx) = fs.density(waterPhaseIdx);
-                    pw_aquifer.push_back( (water_pressure_reservoir - rhow_.at(idx).value()*gravity_*(cell_depth_.at(idx) - aquct_data_.d0))*alphai_.at(idx) );
+                    pw_aquifer_sum += (water_pressure_reservoir - rhow_.at(idx).value()*gravity_*(cell_depth_.at(idx) - aquct_data_.d0))*alphai_.at(idx);
                 }
 
                 // We take the average of the calculated equilibrium pressures.
-                Scalar aquifer_pres_avg = std::accumulate(pw_aquifer.begin(), pw_aquifer.end(), 0.)/pw_aquifer.size();
+                Scalar aquifer_pres_avg = pw_aquifer_sum/cell_idx_.size();
                 return aquifer_pres_avg;
             }
 
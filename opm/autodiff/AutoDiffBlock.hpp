@@ -539,7 +539,28 @@ namespace Opm
     AutoDiffBlock<Scalar> operator*(const typename AutoDiffBlock<Scalar>::V& lhs,
                                     const AutoDiffBlock<Scalar>& rhs)
     {
-        return AutoDiffBlock<Scalar>::constant(lhs, rhs.blockPattern()) * rhs;
+        typedef typename AutoDiffBlock<Scalar>::M M;
+        if (rhs.derivative().empty()) {
+            return AutoDiffBlock<Scalar>::constant(lhs * rhs.value());
+        }
+        // Scale the jacobians directly instead of multiplying with a constant
+        // whose (zero) jacobians would have to be created first.
+        const int num_blocks = rhs.numBlocks();
+        std::vector<M> jac(num_blocks);
+        const M D(lhs.matrix().asDiagonal());
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif // HAVE_OPENMP
+        for (int block = 0; block < num_blocks; ++block) {
+            const M& J = rhs.derivative()[block];
+            if (J.nonZeros() == 0) {
+                jac[block] = M(J.rows(), J.cols());
+            }
+            else {
+                jac[block] = D * J;
+            }
+        }
+        return AutoDiffBlock<Scalar>::function(lhs * rhs.value(), std::move(jac));
     }
 
 
@@ -557,7 +578,9 @@ namespace Opm
     AutoDiffBlock<Scalar> operator+(const typename AutoDiffBlock<Scalar>::V& lhs,
                                     const AutoDiffBlock<Scalar>& rhs)
     {
-        return AutoDiffBlock<Scalar>::constant(lhs, rhs.blockPattern()) + rhs;
+        // adding a constant does not change the jacobians
+        typename AutoDiffBlock<Scalar>::V val = lhs + rhs.value();
+        return AutoDiffBlock<Scalar>::function(std::move(val), rhs.derivative());
     }
 
 
@@ -584,7 +607,83 @@ namespace Opm
     AutoDiffBlock<Scalar> operator-(const AutoDiffBlock<Scalar>& lhs,
                                     const typename AutoDiffBlock<Scalar>::V& rhs)
     {
-        return lhs - AutoDiffBlock<Scalar>::constant(rhs, lhs.blockPattern());
+        // subtracting a constant does not change the jacobians
+        typename AutoDiffBlock<Scalar>::V val = lhs.value() - rhs;
+        return AutoDiffBlock<Scalar>::function(std::move(val), lhs.derivative());
+    }
+
+
+    // The following overloads take a temporary operand and store the result
+    // in it, such that chains like a + b + c do not allocate new values and
+    // jacobians for every intermediate result.
+
+    /// Elementwise operator + with a temporary on the left.
+    template <typename Scalar>
+    AutoDiffBlock<Scalar> operator+(AutoDiffBlock<Scalar>&& lhs,
+                                    const AutoDiffBlock<Scalar>& rhs)
+    {
+        lhs += rhs;
+        return std::move(lhs);
+    }
+
+
+    /// Elementwise operator + with a temporary on the right.
+    template <typename Scalar>
+    AutoDiffBlock<Scalar> operator+(const AutoDiffBlock<Scalar>& lhs,
+                                    AutoDiffBlock<Scalar>&& rhs)
+    {
+        rhs += lhs; // Commutative operation.
+        return std::move(rhs);
+    }
+
+
+    /// Elementwise operator + of two temporaries.
+    template <typename Scalar>
+    AutoDiffBlock<Scalar> operator+(AutoDiffBlock<Scalar>&& lhs,
+                                    AutoDiffBlock<Scalar>&& rhs)
+    {
+        lhs += rhs;
+        return std::move(lhs);
+    }
+
+
+    /// Elementwise operator - with a temporary on the left.
+    template <typename Scalar>
+    AutoDiffBlock<Scalar> operator-(AutoDiffBlock<Scalar>&& lhs,
+                                    const AutoDiffBlock<Scalar>& rhs)
+    {
+        lhs -= rhs;
+        return std::move(lhs);
+    }
+
+
+    /// Elementwise addition of a constant to a temporary.
+    template <typename Scalar>
+    AutoDiffBlock<Scalar> operator+(AutoDiffBlock<Scalar>&& lhs,
+                                    const typename AutoDiffBlock<Scalar>::V& rhs)
+    {
+        lhs += AutoDiffBlock<Scalar>::constant(rhs);
+        return std::move(lhs);
+    }
+
+
+    /// Elementwise addition of a temporary to a constant.
+    template <typename Scalar>
+    AutoDiffBlock<Scalar> operator+(const typename AutoDiffBlock<Scalar>::V& lhs,
+                                    AutoDiffBlock<Scalar>&& rhs)
+    {
+        rhs += AutoDiffBlock<Scalar>::constant(lhs); // Commutative operation.
+        return std::move(rhs);
+    }
+
+
+    /// Elementwise subtraction of a constant from a temporary.
+    template <typename Scalar>
+    AutoDiffBlock<Scalar> operator-(AutoDiffBlock<Scalar>&& lhs,
+                                    const typename AutoDiffBlock<Scalar>::V& rhs)
+    {
+        lhs -= AutoDiffBlock<Scalar>::constant(rhs);
+        return std::move(lhs);
     }
 
 
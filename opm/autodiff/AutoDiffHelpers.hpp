@@ -31,7 +31,10 @@
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace Opm
@@ -171,6 +174,54 @@ struct HelperOps
             connection_cells = nbi;
         }
     }
+
+    /// Returns the helper operators of a grid, shared with all other users
+    /// of the same grid object and non-neighboring connections that are
+    /// still alive, such that they are only built once.
+    template<class Grid>
+    static std::shared_ptr<const HelperOps> shared(const Grid& grid, const NNC& nnc = NNC())
+    {
+        using namespace AutoDiffGrid;
+        const int nc = numCells(grid);
+        const int nf = numFaces(grid);
+        const std::vector<NNCdata>& nncdata = nnc.nncdata();
+        auto sameNNC = [&nncdata](const std::vector<NNCdata>& other) {
+            return nncdata.size() == other.size()
+                && std::equal(nncdata.begin(), nncdata.end(), other.begin(),
+                              [](const NNCdata& a, const NNCdata& b) {
+                                  return a.cell1 == b.cell1 && a.cell2 == b.cell2 && a.trans == b.trans;
+                              });
+        };
+
+        struct Entry
+        {
+            const void* grid;
+            int numCells;
+            int numFaces;
+            std::vector<NNCdata> nnc;
+            std::weak_ptr<const HelperOps> ops;
+        };
+        static std::mutex mutex;
+        static std::vector<Entry> cache;
+        std::lock_guard<std::mutex> lock(mutex);
+        cache.erase(std::remove_if(cache.begin(), cache.end(),
+                                   [](const Entry& entry) { return entry.ops.expired(); }),
+                    cache.end());
+        for (const Entry& entry : cache) {
+            // the cell and face counts guard against a new grid at the
+            // address of a destroyed one
+            if (entry.grid == &grid && entry.numCells == nc && entry.numFaces == nf
+                && sameNNC(entry.nnc)) {
+                std::shared_ptr<const HelperOps> ops = entry.ops.lock();
+                if (ops) {
+                    return ops;
+                }
+            }
+        }
+        std::shared_ptr<const HelperOps> ops = std::make_shared<const HelperOps>(grid, nnc);
+        cache.push_back(Entry{ &grid, nc, nf, nncdata, ops });
+        return ops;
+    }
 };
 // -------------------- upwinding helper class --------------------
 
@@ -332,7 +383,13 @@ superset(const Eigen::Array<Scalar, Eigen::Dynamic, 1>& x,
          const IntVec& indices,
          const int n)
 {
-    return constructSupersetSparseMatrix<Scalar>(n, indices) * x.matrix();
+    typedef typename Eigen::Array<Scalar, Eigen::Dynamic, 1>::Index Index;
+    const Index size = indices.size();
+    Eigen::Array<Scalar, Eigen::Dynamic, 1> ret = Eigen::Array<Scalar, Eigen::Dynamic, 1>::Zero(n);
+    for( Index i=0; i<size; ++i )
+        ret[ indices[ i ] ] += x[ i ];
+
+    return ret;
 }
 
 
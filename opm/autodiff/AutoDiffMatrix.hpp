@@ -264,11 +264,24 @@ namespace Opm
 
         AutoDiffMatrix& operator+=(const AutoDiffMatrix& rhs)
         {
+            // update in place where the structure of the result does not change
             if( type_ == Sparse && rhs.type_ == Sparse )
             {
                 fastSparseAdd( sparse_, rhs.sparse_ );
             }
-            else {
+            else if( type_ == Diagonal && rhs.type_ == Diagonal )
+            {
+                for (int r = 0; r < rows_; ++r) {
+                    diag_[r] += rhs.diag_[r];
+                }
+            }
+            else if( type_ == Sparse && rhs.type_ == Diagonal )
+            {
+                if( ! fastSparseAddDiagonal( sparse_, rhs.diag_ ) ) {
+                    *this = *this + rhs;
+                }
+            }
+            else if( rhs.type_ != Zero ) {
                 *this = *this + rhs;
             }
             return *this;
@@ -285,7 +298,19 @@ namespace Opm
             {
                 fastSparseSubstract( sparse_, rhs.sparse_ );
             }
-            else {
+            else if( type_ == Diagonal && rhs.type_ == Diagonal )
+            {
+                for (int r = 0; r < rows_; ++r) {
+                    diag_[r] -= rhs.diag_[r];
+                }
+            }
+            else if( type_ == Sparse && rhs.type_ == Diagonal )
+            {
+                if( ! fastSparseAddDiagonal( sparse_, rhs.diag_, -1.0 ) ) {
+                    *this = *this + (rhs * -1.0);
+                }
+            }
+            else if( rhs.type_ != Zero ) {
                 *this = *this + (rhs * -1.0);
             }
             return *this;
@@ -452,7 +477,9 @@ namespace Opm
             assert(lhs.type_ == Sparse);
             assert(rhs.type_ == Identity);
             AutoDiffMatrix retval = lhs;
-            retval.sparse_ += spdiag(Eigen::VectorXd::Ones(lhs.rows_));;
+            if (!fastSparseAddDiagonal(retval.sparse_, std::vector<double>(lhs.rows_, 1.0))) {
+                retval.sparse_ += spdiag(Eigen::VectorXd::Ones(lhs.rows_));
+            }
             return retval;
         }
 
@@ -462,7 +489,9 @@ namespace Opm
             assert(lhs.type_ == Sparse);
             assert(rhs.type_ == Diagonal);
             AutoDiffMatrix retval = lhs;
-            retval.sparse_ += spdiag(rhs.diag_);
+            if (!fastSparseAddDiagonal(retval.sparse_, rhs.diag_)) {
+                retval.sparse_ += spdiag(rhs.diag_);
+            }
             return retval;
         }
 
@@ -626,6 +655,42 @@ namespace Opm
 
 
 
+        /**
+         * Calls visit(row, col, value) for all stored elements of the matrix,
+         * without converting it to a sparse representation first. For sparse
+         * matrices the elements are visited column by column.
+         */
+        template <class Visitor>
+        void visitNonZeros(Visitor&& visit) const
+        {
+            switch (type_) {
+            case Zero:
+                return;
+            case Identity:
+                for (int i = 0; i < rows_; ++i) {
+                    visit(i, i, 1.0);
+                }
+                return;
+            case Diagonal:
+                for (int i = 0; i < rows_; ++i) {
+                    visit(i, i, diag_[i]);
+                }
+                return;
+            case Sparse:
+                for (int col = 0; col < sparse_.outerSize(); ++col) {
+                    for (SparseRep::InnerIterator it(sparse_, col); it; ++it) {
+                        visit(int(it.row()), int(it.col()), it.value());
+                    }
+                }
+                return;
+            default:
+                OPM_THROW(std::logic_error, "Invalid AutoDiffMatrix type encountered: " << type_);
+            }
+        }
+
+
+
+
 
         /**
          * Returns the sparse representation of this matrix. Note that this might
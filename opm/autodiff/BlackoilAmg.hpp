@@ -21,6 +21,8 @@
 
 #include <opm/autodiff/ParallelOverlappingILU0.hpp>
 #include <opm/autodiff/CPRPreconditioner.hpp>
+#include <opm/autodiff/SparsityPattern.hpp>
+#include <opm/simulators/MemoryAccounting.hpp>
 #include <dune/istl/paamg/twolevelmethod.hh>
 #include <dune/istl/paamg/aggregates.hh>
 #include <dune/istl/bvector.hh>
@@ -85,35 +87,51 @@ Dune::OverlappingSchwarzOperator<M,X,Y,T> createOperator(const Dune::Overlapping
 //! See section 3.2.3 of Scheichl, Masson: Decoupling and Block Preconditioning for
 //! Sedimentary Basin Simulations, 2003.
 //! \param op The operator that stems from the discretization.
-//! \param comm The communication objecte describing the data distribution.
+//! \param scaled The scaled matrix of a previous call (might be null). It is refilled
+//!               in place if it has the sparsity pattern of the matrix of op,
+//!               otherwise a new matrix is allocated.
 //! \param pressureIndex The index of the pressure in the matrix block
-//! \retun A pair of the scaled matrix and the associated operator-
-template<class Operator, class Communication>
-std::tuple<std::unique_ptr<typename Operator::matrix_type>, Operator>
-scaleMatrixQuasiImpes(const Operator& op, const Communication& comm,
+//! \return The scaled matrix.
+template<class Operator>
+std::shared_ptr<typename Operator::matrix_type>
+scaleMatrixQuasiImpes(const Operator& op,
+                      std::shared_ptr<typename Operator::matrix_type> scaled,
                       std::size_t pressureIndex)
 {
     using Matrix = typename Operator::matrix_type;
     using Block = typename Matrix::block_type;
-    std::unique_ptr<Matrix> matrix(new Matrix(op.getmat()));
+    const Matrix& matrix = op.getmat();
+    if ( !scaled || !detail::samePattern(*scaled, matrix) )
+    {
+        scaled = std::make_shared<Matrix>(matrix);
+    }
 
-    for ( auto& row : *matrix )
+    // Copy and scale in one pass, the blocks may alias for a new matrix.
+    auto row = matrix.begin();
+    for ( auto& scaledRow : *scaled )
     {
-        for ( auto& block : row )
+        auto block = row->begin();
+        for ( auto& scaledBlock : scaledRow )
         {
+            if ( &scaledBlock != &*block )
+            {
+                scaledBlock = *block;
+            }
             for ( std::size_t i = 0; i < Block::rows; i++ )
             {
                 if ( i != pressureIndex )
                 {
                     for(std::size_t j=0; j < Block::cols; j++)
                     {
-                        block[pressureIndex][j] += block[i][j];
+                        scaledBlock[pressureIndex][j] += (*block)[i][j];
                     }
                 }
             }
+            ++block;
         }
+        ++row;
     }
-    return std::make_tuple(std::move(matrix), createOperator(op, *matrix, comm));
+    return scaled;
 }
 
 //! \brief Applies diagonal scaling to the discretization Matrix (Scheichl, 2003)
@@ -139,6 +157,31 @@ void scaleVectorQuasiImpes(Vector& vector, std::size_t pressureIndex)
     }
 }
 
+//! \brief Stores the scaled vector in another vector of the same size,
+//!        copying and scaling in one pass.
+//! \param vector The vector to scale
+//! \param scaled The scaled vector
+//! \param pressureIndex The index of the pressure in the matrix block
+template<class Vector>
+void scaleVectorQuasiImpes(const Vector& vector, Vector& scaled, std::size_t pressureIndex)
+{
+    using Block = typename Vector::block_type;
+
+    auto block = vector.begin();
+    for ( auto& scaledBlock: scaled)
+    {
+        scaledBlock = *block;
+        for ( std::size_t i = 0; i < Block::dimension; i++ )
+        {
+            if ( i != pressureIndex )
+            {
+                scaledBlock[pressureIndex] += (*block)[i];
+            }
+        }
+        ++block;
+    }
+}
+
 //! \brief TMP to create the scalar pendant to a real block matrix, vector, smoother, etc.
 //!
 //! \code
@@ -256,8 +299,11 @@ struct ScalarType<Dune::BlockPreconditioner<X,Y,C,T> >
                                       typename ScalarType<T>::value> value;
 };
 
-template<class M, class X, class Y, class C>
-struct ScalarType<ParallelOverlappingILU0<M,X,Y,C> >
+/// The storage field of the fine level smoother is not passed on, the
+/// smoothers of the coarse (pressure) levels store their factors in the
+/// field type of the matrix.
+template<class M, class X, class Y, class C, class F>
+struct ScalarType<ParallelOverlappingILU0<M,X,Y,C,F> >
 {
     typedef ParallelOverlappingILU0<typename ScalarType<M>::value,
                                     typename ScalarType<X>::value,
@@ -293,6 +339,64 @@ struct OneComponentCriterionType<Dune::Amg::CoarsenCriterion<Dune::Amg::UnSymmet
     using value = Dune::Amg::CoarsenCriterion<Dune::Amg::UnSymmetricCriterion<Dune::BCRSMatrix<B>, Dune::Amg::Diagonal<COMPONENT_INDEX> > >;
 };
 
+/**
+ * @brief The setup of the coarse levels of BlackoilAmg kept between linear solves.
+ *
+ * Computing the aggregates and the sparsity pattern of the coarse levels
+ * dominates the setup cost of CPR. As the pressure coupling hardly changes
+ * during a report step we keep them as long as the sparsity pattern of the
+ * fine level matrix does not change and only recompute the entries of the
+ * coarse matrices by Galerkin products. Calling reset forces a complete
+ * coarsening in the next setup.
+ * @tparam Operator The type of the fine level operator.
+ * @tparam Communication The class that describes the communication pattern.
+ */
+template<class Operator, class Communication>
+struct AmgSetupCache
+{
+    using Matrix = typename Operator::matrix_type;
+    using AggregatesMap = Dune::Amg::AggregatesMap<typename Operator::matrix_type::size_type>;
+    using CoarseOperator = typename ScalarType<Operator>::value;
+    using CoarseMatrix = typename CoarseOperator::matrix_type;
+
+    /** @brief Whether the cached coarse levels can be used for the fine level matrix. */
+    template<class M>
+    bool matches(const M& fineMatrix) const
+    {
+        return coarseLevelMatrix_ && finePattern_.matches(fineMatrix);
+    }
+
+    /** @brief Forget the coarsening. */
+    void reset()
+    {
+        finePattern_.clear();
+        aggregatesMap_.reset();
+        coarseLevelCommunication_.reset();
+        coarseLevelMatrix_.reset();
+        coarseOperator_.reset();
+        coarseSolver_.reset();
+    }
+
+    /**
+     * @brief The sparsity pattern of the fine level matrix of the coarsening.
+     *
+     * The fine level matrix is refilled in place by the next setup, hence
+     * its pattern is kept.
+     */
+    detail::SparsityPattern finePattern_;
+    std::shared_ptr<AggregatesMap> aggregatesMap_;
+    std::shared_ptr<Communication> coarseLevelCommunication_;
+    std::shared_ptr<CoarseMatrix> coarseLevelMatrix_;
+    std::shared_ptr<CoarseOperator> coarseOperator_;
+    /** @brief The AMG used on the coarse level (type erased, it depends on the smoother). */
+    std::shared_ptr<void> coarseSolver_;
+    /**
+     * @brief The quasi-IMPES scaled fine level matrix. It is refilled in place
+     * by the next setup and hence not cleared by reset().
+     */
+    std::shared_ptr<Matrix> scaledMatrix_;
+};
+
 template<class Operator, class Criterion, class Communication, std::size_t COMPONENT_INDEX>
 class OneComponentAggregationLevelTransferPolicy;
 
@@ -324,18 +428,22 @@ public:
     typedef typename Dune::Amg::SmootherTraits<S>::Arguments SmootherArgs;
     /** @brief The type of the AMG construct on the coarse level.*/
     typedef Dune::Amg::AMG<Operator,X,Smoother,Communication> AMGType;
+    /** @brief The type of the setup kept between linear solves. */
+    typedef typename P::SetupCache SetupCache;
     /**
      * @brief Constructs the coarse solver policy.
      * @param args The arguments used for constructing the smoother.
      * @param c The crition used for the aggregation within AMG.
+     * @param cache The setup to reuse between linear solves (might be null).
      */
-    OneStepAMGCoarseSolverPolicy(const CPRParameter* param, const SmootherArgs& args, const Criterion& c)
-        : param_(param), smootherArgs_(args), criterion_(c)
+    OneStepAMGCoarseSolverPolicy(const CPRParameter* param, const SmootherArgs& args, const Criterion& c,
+                                 const std::shared_ptr<SetupCache>& cache = std::shared_ptr<SetupCache>())
+        : param_(param), smootherArgs_(args), criterion_(c), cache_(cache)
     {}
     /** @brief Copy constructor. */
     OneStepAMGCoarseSolverPolicy(const OneStepAMGCoarseSolverPolicy& other)
         : param_(other.param_), coarseOperator_(other.coarseOperator_), smootherArgs_(other.smootherArgs_),
-          criterion_(other.criterion_)
+          criterion_(other.criterion_), cache_(other.cache_)
     {}
 private:
     /**
@@ -350,12 +458,16 @@ private:
                            const typename AMGType::Operator& op,
                            const Criterion& crit,
                            const typename AMGType::SmootherArgs& args,
-                           const Communication& comm)
-            : param_(param), amg_(), smoother_(), op_(op), comm_(comm)
+                           const Communication& comm,
+                           const std::shared_ptr<AMGType>& amg = std::shared_ptr<AMGType>())
+            : param_(param), amg_(amg), smoother_(), op_(op), comm_(comm)
         {
             if ( param_->cpr_use_amg_ )
             {
-                amg_.reset(new AMGType(op, crit,args, comm));
+                if ( ! amg_ )
+                {
+                    amg_.reset(new AMGType(op, crit,args, comm));
+                }
             }
             else
             {
@@ -463,10 +575,16 @@ private:
             : x_(other.x_), amg_(other.amg_)
         {
         }
+
+        /** @brief The AMG used (null if only the smoother is used). */
+        const std::shared_ptr<AMGType>& amg() const
+        {
+            return amg_;
+        }
     private:
         const CPRParameter* param_;
         X x_;
-        std::unique_ptr<AMGType> amg_;
+        std::shared_ptr<AMGType> amg_;
         std::unique_ptr<Smoother> smoother_;
         const typename AMGType::Operator& op_;
         const Communication& comm_;
@@ -488,11 +606,31 @@ public:
         coarseOperator_=transferPolicy.getCoarseLevelOperator();
         const LevelTransferPolicy& transfer =
             reinterpret_cast<const LevelTransferPolicy&>(transferPolicy);
+        std::shared_ptr<AMGType> amg;
+#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 6)
+        // The coarse operator is the cached one if the aggregates did not change.
+        const bool cached = param_->cpr_use_amg_ && cache_ &&
+            cache_->coarseOperator_ == coarseOperator_;
+        if ( cached && cache_->coarseSolver_ )
+        {
+            // Keep the hierarchy, only recompute the Galerkin products,
+            // the smoothers and the coarse solver.
+            amg = std::static_pointer_cast<AMGType>(cache_->coarseSolver_);
+            amg->updateSolver(criterion_, *coarseOperator_, transfer.getCoarseLevelCommunication());
+        }
+#endif
         AMGInverseOperator* inv = new AMGInverseOperator(param_,
                                                          *coarseOperator_,
                                                          criterion_,
                                                          smootherArgs_,
-                                                         transfer.getCoarseLevelCommunication());
+                                                         transfer.getCoarseLevelCommunication(),
+                                                         amg);
+#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 6)
+        if ( cached )
+        {
+            cache_->coarseSolver_ = inv->amg();
+        }
+#endif
 
         return inv; //std::shared_ptr<InverseOperator<X,X> >(inv);
 
@@ -507,8 +645,28 @@ private:
     SmootherArgs smootherArgs_;
     /** @brief The coarsening criterion. */
     Criterion criterion_;
+    /** @brief The setup kept between linear solves. */
+    std::shared_ptr<SetupCache> cache_;
 };
 
+/**
+ * @brief Shares the fine level communication with the coarse level.
+ *
+ * The sequential information is stateless, a new one is used such that
+ * the coarse level does not depend on the lifetime of the fine level.
+ */
+template<class Communication>
+std::shared_ptr<Communication> shareCommunication(Communication* comm)
+{
+    return std::shared_ptr<Communication>(comm, [](Communication*){});
+}
+
+inline std::shared_ptr<Dune::Amg::SequentialInformation>
+shareCommunication(Dune::Amg::SequentialInformation*)
+{
+    return std::make_shared<Dune::Amg::SequentialInformation>();
+}
+
 template<class Smoother, class Operator, class Communication>
 Smoother* constructSmoother(const Operator& op,
                             const typename Dune::Amg::SmootherTraits<Smoother>::Arguments& smargs,
@@ -647,18 +805,41 @@ public:
     using CoarseOperator = typename Detail::ScalarType<Operator>::value;
     typedef Dune::Amg::LevelTransferPolicy<Operator,CoarseOperator> FatherType;
     typedef Communication ParallelInformation;
+    typedef Detail::AmgSetupCache<Operator, Communication> SetupCache;
 
 public:
     OneComponentAggregationLevelTransferPolicy(const Criterion& crit, const Communication& comm,
-                                               bool cpr_pressure_aggregation)
+                                               bool cpr_pressure_aggregation,
+                                               const std::shared_ptr<SetupCache>& cache = std::shared_ptr<SetupCache>())
         : criterion_(crit), communication_(&const_cast<Communication&>(comm)),
-          cpr_pressure_aggregation_(cpr_pressure_aggregation)
+          cpr_pressure_aggregation_(cpr_pressure_aggregation), cache_(cache)
     {}
 
     void createCoarseLevelSystem(const Operator& fineOperator)
     {
         prolongDamp_ = 1;
 
+        if ( cache_ && cache_->matches(fineOperator.getmat()) )
+        {
+            // Same sparsity pattern as before, keep the coarsening.
+            aggregatesMap_ = cache_->aggregatesMap_;
+            coarseLevelCommunication_ = cache_->coarseLevelCommunication_;
+            coarseLevelMatrix_ = cache_->coarseLevelMatrix_;
+            if ( cpr_pressure_aggregation_ )
+            {
+                calculateCoarseEntries(fineOperator.getmat());
+            }
+            else
+            {
+                extractCoarseEntries(fineOperator.getmat());
+            }
+            this->lhs_.resize(this->coarseLevelMatrix_->M());
+            this->rhs_.resize(this->coarseLevelMatrix_->N());
+            this->operator_ = cache_->coarseOperator_;
+            accountMemory();
+            return;
+        }
+
         if ( cpr_pressure_aggregation_ )
         {
 #if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 6)
@@ -741,19 +922,8 @@ public:
                 ++createIter;
             }
 
-            auto coarseRow = coarseLevelMatrix_->begin();
-            for ( const auto& row: fineLevelMatrix )
-            {
-                auto coarseCol = coarseRow->begin();
-
-                for ( auto col = row.begin(), cend = row.end(); col != cend; ++col, ++coarseCol )
-                {
-                    assert( col.index() == coarseCol.index() );
-                    *coarseCol = (*col)[COMPONENT_INDEX][COMPONENT_INDEX];
-                }
-                ++coarseRow;
-            }
-            coarseLevelCommunication_.reset(communication_, [](Communication*){});
+            extractCoarseEntries(fineLevelMatrix);
+            coarseLevelCommunication_ = Detail::shareCommunication(communication_);
         }
 
         this->lhs_.resize(this->coarseLevelMatrix_->M());
@@ -761,6 +931,39 @@ public:
         using OperatorArgs = typename Dune::Amg::ConstructionTraits<CoarseOperator>::Arguments;
         OperatorArgs oargs(*coarseLevelMatrix_, *coarseLevelCommunication_);
         this->operator_.reset(Dune::Amg::ConstructionTraits<CoarseOperator>::construct(oargs));
+        accountMemory();
+
+        // Without aggregation the coarse level uses the fine level communication,
+        // which does not outlive the linear solve in parallel runs.
+        const bool cacheable = cpr_pressure_aggregation_ ||
+            std::is_same<Communication, Dune::Amg::SequentialInformation>::value;
+        if ( cache_ && cacheable )
+        {
+            cache_->reset();
+            cache_->finePattern_.assign(fineOperator.getmat());
+            cache_->aggregatesMap_ = aggregatesMap_;
+            cache_->coarseLevelCommunication_ = coarseLevelCommunication_;
+            cache_->coarseLevelMatrix_ = coarseLevelMatrix_;
+            cache_->coarseOperator_ = this->operator_;
+        }
+    }
+
+    /** @brief Copies the pressure entries of the fine matrix without aggregation. */
+    template<class M>
+    void extractCoarseEntries(const M& fineMatrix)
+    {
+        auto coarseRow = coarseLevelMatrix_->begin();
+        for ( const auto& row: fineMatrix )
+        {
+            auto coarseCol = coarseRow->begin();
+
+            for ( auto col = row.begin(), cend = row.end(); col != cend; ++col, ++coarseCol )
+            {
+                assert( col.index() == coarseCol.index() );
+                *coarseCol = (*col)[COMPONENT_INDEX][COMPONENT_INDEX];
+            }
+            ++coarseRow;
+        }
     }
 
     template<class M>
@@ -853,6 +1056,19 @@ public:
         return *coarseLevelCommunication_;
     }
 private:
+    /** @brief Account the bytes of the coarse level, also if it is kept by the cache. */
+    void accountMemory()
+    {
+        using CoarseVector = typename FatherType::CoarseDomainType;
+        std::size_t bytes = MemoryAccounting::matrixBytes(*coarseLevelMatrix_)
+            + (this->lhs_.capacity() + this->rhs_.capacity()) * sizeof(typename CoarseVector::block_type);
+        if ( aggregatesMap_ )
+        {
+            bytes += aggregatesMap_->noVertices() * sizeof(typename AggregatesMap::AggregateDescriptor);
+        }
+        memory_.set(bytes);
+    }
+
     typename Operator::matrix_type::field_type prolongDamp_;
     std::shared_ptr<AggregatesMap> aggregatesMap_;
     Criterion criterion_;
@@ -860,6 +1076,8 @@ private:
     std::shared_ptr<Communication> coarseLevelCommunication_;
     std::shared_ptr<typename CoarseOperator::matrix_type> coarseLevelMatrix_;
     bool cpr_pressure_aggregation_;
+    std::shared_ptr<SetupCache> cache_;
+    MemoryAccounting::Account memory_{ MemoryAccounting::AmgLevels };
 };
 
 /**
@@ -915,6 +1133,9 @@ protected:
                                   CoarseSolverPolicy,
                                   Smoother>;
 public:
+    /** \brief The type of the coarse level setup that can be kept between linear solves. */
+    using SetupCache = typename LevelTransferPolicy::SetupCache;
+
 #if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 6)
     Dune::SolverCategory::Category category() const override
     {
@@ -935,21 +1156,30 @@ public:
      * \param criterion The criterion describing the coarsening approach.
      * \param smargs The arguments for constructing the smoother.
      * \param comm The information about the parallelization.
+     * \param cache The coarsening of a previous setup to reuse (might be null).
      */
     BlackoilAmg(const CPRParameter& param,
                 const Operator& fineOperator, const Criterion& criterion,
-                const SmootherArgs& smargs, const Communication& comm)
+                const SmootherArgs& smargs, const Communication& comm,
+                const std::shared_ptr<SetupCache>& cache = std::shared_ptr<SetupCache>())
         : param_(param),
-          scaledMatrixOperator_(Detail::scaleMatrixQuasiImpes(fineOperator, comm,
-                                                              COMPONENT_INDEX)),
-          smoother_(Detail::constructSmoother<Smoother>(std::get<1>(scaledMatrixOperator_),
-                                                        smargs, comm)),
-          levelTransferPolicy_(criterion, comm, param.cpr_pressure_aggregation_),
-          coarseSolverPolicy_(&param, smargs, criterion),
-          twoLevelMethod_(std::get<1>(scaledMatrixOperator_), smoother_,
+          scaledMatrix_(Detail::scaleMatrixQuasiImpes(fineOperator,
+                                                      cache ? cache->scaledMatrix_ : nullptr,
+                                                      COMPONENT_INDEX)),
+          scaledOperator_(Detail::createOperator(fineOperator, *scaledMatrix_, comm)),
+          smoother_(Detail::constructSmoother<Smoother>(scaledOperator_, smargs, comm)),
+          levelTransferPolicy_(criterion, comm, param.cpr_pressure_aggregation_, cache),
+          coarseSolverPolicy_(&param, smargs, criterion, cache),
+          twoLevelMethod_(scaledOperator_, smoother_,
                           levelTransferPolicy_,
                           coarseSolverPolicy_, 0, 1)
-    {}
+    {
+        if ( cache )
+        {
+            cache->scaledMatrix_ = scaledMatrix_;
+        }
+        memory_.set(MemoryAccounting::matrixBytes(*scaledMatrix_));
+    }
 
     void pre(typename TwoLevelMethod::FineDomainType& x,
              typename TwoLevelMethod::FineRangeType& b)
@@ -965,17 +1195,21 @@ public:
     void apply(typename TwoLevelMethod::FineDomainType& v,
                const typename TwoLevelMethod::FineRangeType& d)
     {
-        auto scaledD = d;
-        Detail::scaleVectorQuasiImpes(scaledD, COMPONENT_INDEX);
-        twoLevelMethod_.apply(v, scaledD);
+        // reuse the storage of the scaled defect between applications
+        scaledD_.resize(d.size());
+        Detail::scaleVectorQuasiImpes(d, scaledD_, COMPONENT_INDEX);
+        twoLevelMethod_.apply(v, scaledD_);
     }
 private:
     const CPRParameter& param_;
-    std::tuple<std::unique_ptr<Matrix>, Operator> scaledMatrixOperator_;
+    std::shared_ptr<Matrix> scaledMatrix_;
+    Operator scaledOperator_;
     std::shared_ptr<Smoother> smoother_;
     LevelTransferPolicy levelTransferPolicy_;
     CoarseSolverPolicy coarseSolverPolicy_;
     TwoLevelMethod twoLevelMethod_;
+    typename TwoLevelMethod::FineRangeType scaledD_;
+    MemoryAccounting::Account memory_{ MemoryAccounting::AmgLevels };
 };
 
 namespace ISTLUtility
@@ -989,15 +1223,17 @@ namespace ISTLUtility
 /// \tparam P The type of the parallel information.
 /// \tparam C The type of the coarsening criterion to use.
 /// \tparam index The pressure index.
+/// \tparam StorageField The field type used to store the smoother.
 ////
-template<class M, class X, class Y, class P, class C, std::size_t index>
+template<class M, class X, class Y, class P, class C, std::size_t index,
+         class StorageField = typename M::field_type>
 struct BlackoilAmgSelector
 {
     using Criterion = C;
     using Selector = CPRSelector<M,X,Y,P>;
     using ParallelInformation = typename Selector::ParallelInformation;
     using Operator = typename Selector::Operator;
-    using Smoother = typename Selector::EllipticPreconditioner;
+    using Smoother = ParallelOverlappingILU0<M, X, X, ParallelInformation, StorageField>;
     using AMG = BlackoilAmg<Operator,Smoother,Criterion,ParallelInformation,index>;
 };
 } // end namespace ISTLUtility
@@ -28,8 +28,10 @@
 #include <opm/parser/eclipse/EclipseState/Aquancon.hpp>
 #include <opm/simulators/timestepping/SimulatorTimer.hpp>
 #include <opm/autodiff/AquiferCarterTracy.hpp>
+#include <opm/core/utility/OmpExceptionGuard.hpp>
 #include <opm/material/densead/Math.hpp>
 
+
 namespace Opm {
 
         /// Class for handling the blackoil well model.
@@ -55,6 +57,18 @@ namespace Opm {
             // called at the end of a time step
             void timeStepSucceeded(const SimulatorTimerInterface& timer);
 
+            // subtract the inflow of the aquifers from the reservoir residual at the
+            // current state, as assemble() does, without touching the Jacobian; the
+            // intensive quantities of the connected cells must be cached
+            template <class Vector>
+            void addReservoirResidual(const SimulatorTimerInterface& timer, Vector& residual)
+            {
+                for (auto& aquifer : aquifers_) {
+                    aquifer.calculateInflowRates(timer);
+                    aquifer.addInflowResidual(residual);
+                }
+            }
+
         protected:
 
             Simulator& ebosSimulator_;
@@ -66,6 +80,9 @@ namespace Opm {
 
             void updateConnectionIntensiveQuantities() const;
 
+            // whether the model caches valid intensive quantities of all connected cells
+            bool connectionIntensiveQuantitiesCached() const;
+
             void assembleAquiferEq(const SimulatorTimerInterface& timer);
 
             // at the beginning of each time step (Not report step)
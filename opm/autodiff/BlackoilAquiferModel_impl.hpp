@@ -35,8 +35,11 @@ namespace Opm {
             return;
         }
 
-        // We need to update the reservoir pressures connected to the aquifer
-        updateConnectionIntensiveQuantities();
+        // We need to update the reservoir pressures connected to the aquifer,
+        // unless the linearization has just cached them
+        if ( !connectionIntensiveQuantitiesCached() ) {
+            updateConnectionIntensiveQuantities();
+        }
 
         if (iterationIdx == 0) {
             // We can do the Table check and coefficients update in this function
@@ -64,14 +67,50 @@ namespace Opm {
         }
     }
 
+    template<typename TypeTag>
+    bool
+    BlackoilAquiferModel<TypeTag>:: connectionIntensiveQuantitiesCached() const
+    {
+        const auto& model = ebosSimulator_.model();
+        for (const auto& aquifer : aquifers_)
+        {
+            for (const auto cell : aquifer.cells())
+            {
+                if ( !model.cachedIntensiveQuantities(cell, /*timeIdx=*/0) ) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
     // Protected function which calls the individual aquifer models
     template<typename TypeTag>
     void
     BlackoilAquiferModel<TypeTag>:: assembleAquiferEq(const SimulatorTimerInterface& timer)
     {
+        // The inflow rates of the aquifers are independent and computed
+        // concurrently. Aquifers may share cells, so they are added to
+        // the system one aquifer at a time, in order.
+        const int numAquifers = aquifers_.size();
+        detail::OmpExceptionGuard guard;
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif // HAVE_OPENMP
+        for (int i = 0; i < numAquifers; ++i)
+        {
+            try {
+                aquifers_[i].calculateInflowRates(timer);
+            }
+            catch (...) {
+                guard.capture();
+            }
+        }
+        guard.rethrow();
+
         for (auto aquifer = aquifers_.begin(); aquifer != aquifers_.end(); ++aquifer)
         {
-            aquifer->assembleAquiferEq(timer);
+            aquifer->addInflowRates();
         }
     }
 
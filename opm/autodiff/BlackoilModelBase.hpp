@@ -42,6 +42,7 @@
 #include <opm/common/data/SimulationDataContainer.hpp>
 
 #include <array>
+#include <memory>
 
 struct Wells;
 
@@ -331,7 +332,9 @@ namespace Opm {
         // Size = # active phases. Maps active -> canonical phase indices.
         const std::vector<int>          canph_;
         const std::vector<int>          cells_;  // All grid cells
-        HelperOps                       ops_;
+        // Shared with the other models on the same grid.
+        std::shared_ptr<const HelperOps> ops_ptr_;
+        const HelperOps&                ops_;
         const bool has_disgas_;
         const bool has_vapoil_;
 
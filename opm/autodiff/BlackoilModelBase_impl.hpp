@@ -122,7 +122,8 @@ typedef Eigen::Array<double,
         , active_(detail::activePhases(fluid.phaseUsage()))
         , canph_ (detail::active2Canonical(fluid.phaseUsage()))
         , cells_ (detail::buildAllCells(Opm::AutoDiffGrid::numCells(grid)))
-        , ops_   (grid, geo.nnc())
+        , ops_ptr_(HelperOps::shared(grid, geo.nnc()))
+        , ops_   (*ops_ptr_)
         , has_disgas_(has_disgas)
         , has_vapoil_(has_vapoil)
         , param_( param )
@@ -1654,38 +1655,42 @@ typedef Eigen::Array<double,
             const ParallelISTLInformation& info =
                 boost::any_cast<const ParallelISTLInformation&>(linsolver_.parallelInformation());
 
-            // Compute the global number of cells and porevolume
-            std::vector<int> v(nc, 1);
-            auto nc_and_pv = std::tuple<int, double>(0, 0.0);
-            auto nc_and_pv_operators = std::make_tuple(Opm::Reduction::makeGlobalSumFunctor<int>(),
-                                                        Opm::Reduction::makeGlobalSumFunctor<double>());
-            auto nc_and_pv_containers  = std::make_tuple(v, geo_.poreVolume());
-            info.computeReduction(nc_and_pv_containers, nc_and_pv_operators, nc_and_pv);
-
+            // All the sums and maxima are computed with one collective call.
+            DeferredReduction reduction(info);
+            const std::vector<double> ones(nc, 1.0);
+            const std::size_t ncIndex = reduction.addSum(ones);
+            const std::size_t pvIndex = reduction.addSum(geo_.poreVolume());
+            std::vector<std::size_t> indices(3 * nm);
             for ( int idx = 0; idx < nm; ++idx )
             {
-                auto values     = std::tuple<double,double,double>(0.0 ,0.0 ,0.0);
-                auto containers = std::make_tuple(B.col(idx),
-                                                  tempV.col(idx),
-                                                  R.col(idx));
-                auto operators  = std::make_tuple(Opm::Reduction::makeGlobalSumFunctor<double>(),
-                                                  Opm::Reduction::makeGlobalMaxFunctor<double>(),
-                                                  Opm::Reduction::makeGlobalSumFunctor<double>());
-                info.computeReduction(containers, operators, values);
-                B_avg[idx]       = std::get<0>(values)/std::get<0>(nc_and_pv);
-                maxCoeff[idx]    = std::get<1>(values);
-                R_sum[idx]       = std::get<2>(values);
-                assert(nm >= np);
-                if (idx < np) {
-                    maxNormWell[idx] = 0.0;
-                    for ( int w = 0; w < nw; ++w ) {
-                        maxNormWell[idx]  = std::max(maxNormWell[idx], std::abs(residual_.well_flux_eq.value()[nw*idx + w]));
-                    }
+                indices[3*idx]     = reduction.addSum(B.col(idx));
+                indices[3*idx + 1] = reduction.addMax(tempV.col(idx));
+                indices[3*idx + 2] = reduction.addSum(R.col(idx));
+            }
+            assert(nm >= np);
+            std::vector<std::size_t> wellIndices(np);
+            for ( int idx = 0; idx < np; ++idx )
+            {
+                double maxNorm = 0.0;
+                for ( int w = 0; w < nw; ++w ) {
+                    maxNorm = std::max(maxNorm, std::abs(residual_.well_flux_eq.value()[nw*idx + w]));
                 }
+                wellIndices[idx] = reduction.addLocalMax(maxNorm);
+            }
+            reduction.flush(nc);
+
+            for ( int idx = 0; idx < nm; ++idx )
+            {
+                B_avg[idx]       = reduction.value(indices[3*idx]) / reduction.value(ncIndex);
+                maxCoeff[idx]    = reduction.value(indices[3*idx + 1]);
+                R_sum[idx]       = reduction.value(indices[3*idx + 2]);
+            }
+            for ( int idx = 0; idx < np; ++idx )
+            {
+                maxNormWell[idx] = reduction.value(wellIndices[idx]);
             }
-            info.communicator().max(maxNormWell.data(), np);
             // Compute pore volume
-            return std::get<1>(nc_and_pv);
+            return reduction.value(pvIndex);
         }
         else
 #endif
@@ -32,12 +32,14 @@
 #include <opm/autodiff/BlackoilAquiferModel.hpp>
 #include <opm/autodiff/WellConnectionAuxiliaryModule.hpp>
 #include <opm/autodiff/BlackoilDetails.hpp>
+#include <opm/autodiff/BlackoilModelEnums.hpp>
 #include <opm/autodiff/NewtonIterationBlackoilInterface.hpp>
 
 #include <opm/grid/UnstructuredGrid.h>
 #include <opm/core/simulator/SimulatorReport.hpp>
 #include <opm/core/linalg/ParallelIstlInformation.hpp>
 #include <opm/core/props/phaseUsageFromDeck.hpp>
+#include <opm/core/utility/OmpExceptionGuard.hpp>
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/common/Exceptions.hpp>
 #include <opm/common/OpmLog/OpmLog.hpp>
@@ -47,7 +49,16 @@
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
 
+#include <opm/autodiff/FusedReduction.hpp>
 #include <opm/autodiff/ISTLSolver.hpp>
+#include <opm/autodiff/LinearSolverTelemetry.hpp>
+#include <opm/autodiff/MatrixBlockKernels.hpp>
+#include <opm/autodiff/RegionFluidInPlace.hpp>
+#include <opm/autodiff/ReproducibleSum.hpp>
+#include <opm/autodiff/SparsityPattern.hpp>
+#include <opm/simulators/DeferredLogger.hpp>
+#include <opm/simulators/MemoryAccounting.hpp>
+#include <opm/simulators/ProfileScope.hpp>
 #include <opm/common/data/SimulationDataContainer.hpp>
 
 #include <dune/istl/owneroverlapcopy.hh>
@@ -57,11 +68,13 @@
 
 #include <cassert>
 #include <cmath>
+#include <deque>
 #include <iostream>
 #include <iomanip>
 #include <limits>
 #include <vector>
 #include <algorithm>
+#include <utility>
 //#include <fstream>
 
 
@@ -103,6 +116,7 @@ namespace Opm {
         typedef typename GET_PROP_TYPE(TypeTag, Simulator)         Simulator;
         typedef typename GET_PROP_TYPE(TypeTag, Grid)              Grid;
         typedef typename GET_PROP_TYPE(TypeTag, ElementContext)    ElementContext;
+        typedef typename GET_PROP_TYPE(TypeTag, IntensiveQuantities) IntensiveQuantities;
         typedef typename GET_PROP_TYPE(TypeTag, SolutionVector)    SolutionVector ;
         typedef typename GET_PROP_TYPE(TypeTag, PrimaryVariables)  PrimaryVariables ;
         typedef typename GET_PROP_TYPE(TypeTag, FluidSystem)       FluidSystem;
@@ -151,15 +165,16 @@ namespace Opm {
         , phaseUsage_(phaseUsageFromDeck(eclState()))
         , has_disgas_(FluidSystem::enableDissolvedGas())
         , has_vapoil_(FluidSystem::enableVaporizedOil())
-        , has_solvent_(GET_PROP_VALUE(TypeTag, EnableSolvent))
-        , has_polymer_(GET_PROP_VALUE(TypeTag, EnablePolymer))
-        , has_energy_(GET_PROP_VALUE(TypeTag, EnableEnergy))
         , param_( param )
         , well_model_ (well_model)
         , aquifer_model_(aquifer_model)
         , terminal_output_ (terminal_output)
+        , linear_solver_reduction_(param.linear_solver_reduction_max_)
         , current_relaxation_(1.0)
         , dx_old_(UgGridHelpers::numCells(grid_))
+        , newton_update_(UgGridHelpers::numCells(grid_))
+        , relative_change_state_(RelativeChangeState::Invalid)
+        , linear_solutions_kept_(0)
         {
             // compute global sum of number of cells
             global_nc_ = detail::countGlobalCells(grid_);
@@ -179,6 +194,8 @@ namespace Opm {
         /// \param[in] timer                  simulation timer
         void prepareStep(const SimulatorTimerInterface& timer)
         {
+            // the solution is reset or extrapolated below
+            relative_change_state_ = RelativeChangeState::Invalid;
 
             // update the solution variables in ebos
             if ( timer.lastStepFailed() ) {
@@ -200,12 +217,25 @@ namespace Opm {
 
             ebosSimulator_.problem().beginTimeStep();
 
+            // the retried step starts from the solution of the previous time level,
+            // whose intensive quantities are still cached
+            if ( timer.lastStepFailed() && param_.reuse_intensive_quantities_after_chop_ ) {
+                restoreIntensiveQuantities();
+            }
+
+            if ( param_.solution_extrapolation_order_ > 0 ) {
+                extrapolateSolution(timer);
+            }
+
             unsigned numDof = ebosSimulator_.model().numGridDof();
             wasSwitched_.resize(numDof);
             std::fill(wasSwitched_.begin(), wasSwitched_.end(), false);
 
             wellModel().beginTimeStep(timer.reportStepNum(), timer.simulationTimeElapsed());
 
+            // a fresh preconditioner might be requested at the start of a time step
+            istlSolver().beginTimeStep();
+
             if (param_.update_equations_scaling_) {
                 std::cout << "equation scaling not suported yet" << std::endl;
                 //updateEquationsScaling();
@@ -213,6 +243,182 @@ namespace Opm {
         }
 
 
+        /// Copy the cached intensive quantities of the previous time level to the
+        /// current one, such that the first linearization of a retried time step
+        /// does not need to recompute them.
+        void restoreIntensiveQuantities()
+        {
+            auto& model = ebosSimulator_.model();
+            const unsigned numDof = model.numGridDof();
+            for (unsigned globalIdx = 0; globalIdx < numDof; ++globalIdx) {
+                const auto* intQuants = model.cachedIntensiveQuantities(globalIdx, /*timeIdx=*/1);
+                if (intQuants) {
+                    model.updateCachedIntensiveQuantities(*intQuants, globalIdx, /*timeIdx=*/0);
+                }
+            }
+        }
+
+
+        /// Use the extrapolation in time of the solutions of the last converged time
+        /// steps as the initial guess of the time step. Cells whose primary variables
+        /// were switched recently are left alone, and the extrapolated changes are
+        /// limited like the Newton updates.
+        void extrapolateSolution(const SimulatorTimerInterface& timer)
+        {
+            auto& model = ebosSimulator_.model();
+            SolutionVector& solution = model.solution( 0 /* timeIdx */ );
+
+            // a retried time step starts from the last converged solution, as the
+            // extrapolated one may have been the reason for the failure
+            if ( timer.lastStepFailed() ) {
+                return;
+            }
+
+            const double time = timer.simulationTimeElapsed();
+            if ( !solution_history_.empty() && solution_history_.back().first >= time ) {
+                solution_history_.clear();
+            }
+            solution_history_.emplace_back(time, solution);
+            const std::size_t maxPoints = param_.solution_extrapolation_order_ + 1;
+            while ( solution_history_.size() > std::min(maxPoints, std::size_t(3)) ) {
+                solution_history_.pop_front();
+            }
+            const int numPoints = solution_history_.size();
+            if ( numPoints < 2 ) {
+                return;
+            }
+
+            // the Lagrange polynomial through the last solutions evaluated at the end of the time step
+            const double endTime = time + timer.currentStepLength();
+            std::vector<double> weights(numPoints, 1.0);
+            for (int k = 0; k < numPoints; ++k) {
+                for (int j = 0; j < numPoints; ++j) {
+                    if (j != k) {
+                        weights[k] *= (endTime - solution_history_[j].first)
+                            / (solution_history_[k].first - solution_history_[j].first);
+                    }
+                }
+            }
+
+            const unsigned numDof = model.numGridDof();
+            for (unsigned cell_idx = 0; cell_idx < numDof; ++cell_idx) {
+                if ( cell_idx < wasSwitched_.size() && wasSwitched_[cell_idx] ) {
+                    continue;
+                }
+
+                PrimaryVariables& priVars = solution[ cell_idx ];
+                bool sameMeaning = true;
+                for (const auto& entry : solution_history_) {
+                    sameMeaning = sameMeaning && entry.second[ cell_idx ].primaryVarsMeaning() == priVars.primaryVarsMeaning();
+                }
+                if ( !sameMeaning ) {
+                    continue;
+                }
+
+                VectorBlockType dx(0.0);
+                for (int eqIdx = 0; eqIdx < numEq; ++eqIdx) {
+                    double value = 0.0;
+                    for (int k = 0; k < numPoints; ++k) {
+                        value += weights[k] * solution_history_[k].second[ cell_idx ][ eqIdx ];
+                    }
+                    dx[eqIdx] = value - priVars[eqIdx];
+                }
+
+                double& p = priVars[Indices::pressureSwitchIdx];
+                const double dp = dx[Indices::pressureSwitchIdx];
+                p += (dp > 0 ? 1 : -1) * std::min(std::abs(dp), std::abs(p)*dpMaxRel());
+                p = std::max(p, 0.0);
+
+                // the saturations are scaled together as in the Newton update
+                const bool hasSg = FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)
+                    && priVars.primaryVarsMeaning() == PrimaryVariables::Sw_po_Sg;
+                const double dsw = FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx) ? dx[Indices::waterSaturationIdx] : 0.0;
+                const double dsg = hasSg ? dx[Indices::compositionSwitchIdx] : 0.0;
+                const double dss = has_solvent_ ? dx[Indices::solventSaturationIdx] : 0.0;
+                const double dso = - (dsw + dsg + dss);
+
+                double maxVal = 0.0;
+                maxVal = std::max(std::abs(dsw),maxVal);
+                maxVal = std::max(std::abs(dsg),maxVal);
+                maxVal = std::max(std::abs(dso),maxVal);
+                maxVal = std::max(std::abs(dss),maxVal);
+
+                double satScaleFactor = 1.0;
+                if (maxVal > dsMax()) {
+                    satScaleFactor = dsMax()/maxVal;
+                }
+
+                if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+                    double& sw = priVars[Indices::waterSaturationIdx];
+                    sw = std::min(std::max(sw + satScaleFactor * dsw, 0.0), 1.0);
+                }
+                if (hasSg) {
+                    double& sg = priVars[Indices::compositionSwitchIdx];
+                    sg = std::min(std::max(sg + satScaleFactor * dsg, 0.0), 1.0);
+                }
+                if (has_solvent_) {
+                    double& ss = priVars[Indices::solventSaturationIdx];
+                    ss = std::min(std::max(ss + satScaleFactor * dss, 0.0), 1.0);
+                }
+                if (has_polymer_) {
+                    double& c = priVars[Indices::polymerConcentrationIdx];
+                    c = std::max(c + satScaleFactor * dx[Indices::polymerConcentrationIdx], 0.0);
+                }
+                if (has_energy_) {
+                    priVars[Indices::temperatureIdx] += dx[Indices::temperatureIdx];
+                }
+
+                // rs or rv are limited relative to their value
+                if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx) && !hasSg) {
+                    double& r = priVars[Indices::compositionSwitchIdx];
+                    const double dr = dx[Indices::compositionSwitchIdx];
+                    r += (dr > 0 ? 1 : -1) * std::min(std::abs(dr), std::abs(r)*drMaxRel());
+                    r = std::max(r, 0.0);
+                }
+            }
+
+            // the intensive quantities need to be recalculated for the new solution
+            model.invalidateIntensiveQuantitiesCache(/*timeIdx=*/0);
+        }
+
+
+        /// The relative reduction of the linear residual for the current Newton
+        /// iteration, following choice 2 of Eisenstat and Walker: the linear system
+        /// is solved loosely while the nonlinear residual decreases slowly, and more
+        /// accurately when it converges fast.
+        ///
+        ///   S. C. Eisenstat and H. F. Walker. Choosing the forcing terms in an inexact
+        ///   Newton method. SIAM J. Sci. Comput. 17(1), 1996.
+        double adaptiveLinearSolverReduction()
+        {
+            const double gamma = 0.9;
+            const double alpha = 2.0;
+            const auto& history = scaled_residual_history_;
+
+            double reduction = param_.linear_solver_reduction_max_;
+            const int numIter = history.size();
+            if (numIter >= 2 && history[numIter - 2] > 0.0) {
+                reduction = gamma * std::pow(history[numIter - 1] / history[numIter - 2], alpha);
+
+                // do not tighten the tolerance much faster than in the previous iteration
+                const double safeguard = gamma * std::pow(linear_solver_reduction_, alpha);
+                if (safeguard > 0.1) {
+                    reduction = std::max(reduction, safeguard);
+                }
+            }
+
+            // do not solve more accurately than needed to reach the nonlinear tolerances
+            if (numIter >= 1 && history[numIter - 1] > 0.0) {
+                reduction = std::max(reduction, 0.5 / history[numIter - 1]);
+            }
+
+            reduction = std::min(std::max(reduction, param_.linear_solver_reduction_min_),
+                                 param_.linear_solver_reduction_max_);
+            linear_solver_reduction_ = reduction;
+            return reduction;
+        }
+
+
         /// Called once per nonlinear iteration.
         /// This model will perform a Newton-Raphson update, changing reservoir_state
         /// and well_state. It will also use the nonlinear_solver to do relaxation of
@@ -236,14 +442,22 @@ namespace Opm {
                 // For each iteration we store in a vector the norms of the residual of
                 // the mass balance for each active phase, the well flux and the well equations.
                 residual_norms_history_.clear();
+                scaled_residual_history_.clear();
+                linear_solver_reduction_ = param_.linear_solver_reduction_max_;
                 current_relaxation_ = 1.0;
                 dx_old_ = 0.0;
+                linear_solutions_kept_ = 0;
             }
 
             report.total_linearizations = 1;
 
+            const bool reuse_jacobian = useModifiedNewton(iteration);
+            const bool localized = !reuse_jacobian && useLocalizedAssembly(iteration);
             try {
-                report += assemble(timer, iteration);
+                if (iteration == 0 && param_.sequential_sweeps_ > 0) {
+                    report += sequentialSweeps(timer);
+                }
+                report += assemble(timer, iteration, localized, reuse_jacobian);
                 report.assemble_time += perfTimer.stop();
             }
             catch (...) {
@@ -259,6 +473,34 @@ namespace Opm {
             // the step is not considered converged until at least minIter iterations is done
             report.converged = getConvergence(timer, iteration,residual_norms) && iteration > nonlinear_solver.minIter();
 
+            // the residual of the cells that were not linearized is only estimated,
+            // hence convergence needs to be confirmed by a full linearization
+            if (localized && report.converged) {
+                report.update_time += perfTimer.stop();
+                perfTimer.reset();
+                perfTimer.start();
+                report.total_linearizations += 1;
+                try {
+                    report += assemble(timer, iteration, /*localized=*/false);
+                    report.assemble_time += perfTimer.stop();
+                }
+                catch (...) {
+                    report.assemble_time += perfTimer.stop();
+                    failureReport_ += report;
+                    throw;
+                }
+
+                perfTimer.reset();
+                perfTimer.start();
+                residual_norms.clear();
+                scaled_residual_history_.pop_back();
+                report.converged = getConvergence(timer, iteration,residual_norms) && iteration > nonlinear_solver.minIter();
+            }
+
+            if (param_.localized_assembly_) {
+                markUnconvergedCells(timer);
+            }
+
              // checking whether the group targets are converged
              if (wellModel().wellCollection().groupControlActive()) {
                   report.converged = report.converged && wellModel().wellCollection().groupTargetConverged(wellModel().wellState().wellRates());
@@ -275,8 +517,25 @@ namespace Opm {
                 //residual_.singlePrecision = (unit::convert::to(dt, unit::day) < 20.) ;
 
                 // Compute the nonlinear update.
+                // The update vector is kept between Newton iterations to avoid
+                // reallocating it every time.
                 const int nc = UgGridHelpers::numCells(grid_);
-                BVector x(nc);
+                BVector& x = newton_update_;
+                if ( static_cast<int>(x.size()) != nc ) {
+                    x.resize(nc, false);
+                }
+
+                if (param_.linear_solver_adaptive_reduction_) {
+                    istlSolver().setLinearSolverReduction(adaptiveLinearSolverReduction());
+                }
+
+                // The residual is modified by the linear solve, its norm is
+                // kept for the line search. It is the residual of the reservoir
+                // with the inflow of the wells and aquifers, as evaluated by
+                // evaluateResidual().
+                const bool useLineSearch = param_.line_search_max_iter_ > 0;
+                const double residualNormOld = useLineSearch
+                    ? residualNorm(ebosSimulator_.model().linearizer().residual()) : 0.0;
 
                 try {
                     solveJacobianSystem(x);
@@ -291,6 +550,14 @@ namespace Opm {
                     throw; // re-throw up
                 }
 
+                if (param_.linear_solver_initial_guess_ > 0) {
+                    // the linear solution before the stabilization, as initial
+                    // guess of the next linear solve
+                    std::swap(linear_solution_before_last_, linear_solution_last_);
+                    linear_solution_last_ = x;
+                    linear_solutions_kept_ = std::min(linear_solutions_kept_ + 1, 2);
+                }
+
                 perfTimer.reset();
                 perfTimer.start();
 
@@ -299,6 +566,11 @@ namespace Opm {
                 // there is no theorectical explanation which way is better for sure.
                 wellModel().recoverWellSolutionAndUpdateWellState(x);
 
+                if (useLineSearch) {
+                    solution_before_update_ = ebosSimulator_.model().solution( 0 /* timeIdx */ );
+                    was_switched_before_update_ = wasSwitched_;
+                }
+
                 if (param_.use_update_stabilization_) {
                     // Stabilize the nonlinear update.
                     bool isOscillate = false;
@@ -313,12 +585,26 @@ namespace Opm {
                             OpmLog::info(msg);
                         }
                     }
-                    nonlinear_solver.stabilizeNonlinearUpdate(x, dx_old_, current_relaxation_);
+                    // The stabilization is applied cell by cell in the same
+                    // pass as the update.
+                    const double omega = current_relaxation_;
+                    updateState(x, [&](const unsigned cell_idx) {
+                        nonlinear_solver.stabilizeNonlinearUpdateBlock(x[cell_idx], dx_old_[cell_idx], omega);
+                    });
+                }
+                else {
+                    // Apply the update, with considering model-dependent limitations and
+                    // chopping of the update.
+                    updateState(x);
                 }
 
-                // Apply the update, with considering model-dependent limitations and
-                // chopping of the update.
-                updateState(x);
+                if (useLineSearch) {
+                    lineSearch(timer, x, residualNormOld);
+                }
+
+                if (param_.localized_assembly_) {
+                    updateActiveCells();
+                }
 
                 report.update_time += perfTimer.stop();
             }
@@ -326,6 +612,96 @@ namespace Opm {
             return report;
         }
 
+        /// Evaluate the residual of the reservoir equations, with the inflow of the
+        /// wells and aquifers, at the current solution without assembling the
+        /// Jacobian, i.e. the residual of assemble() without the Jacobian. The
+        /// intensive quantities are updated and cached for the next linearization.
+        /// \param[in]  timer     The simulation timer.
+        /// \param[out] residual  The residual of all cells.
+        /// \return False if some well of some process does not support the
+        ///         evaluation, e.g. a multisegment well.
+        bool evaluateResidual(const SimulatorTimerInterface& timer, BVector& residual)
+        {
+            ProfileScope scope("residual evaluation");
+
+            auto& ebosModel = ebosSimulator_.model();
+            const std::size_t nc = UgGridHelpers::numCells(grid_);
+            if (residual.size() != nc) {
+                residual.resize(nc, false);
+            }
+            ebosModel.invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+            ebosModel.globalResidual(residual);
+            aquiferModel().addReservoirResidual(timer, residual);
+            bool supported = wellModel().addReservoirResidual(residual);
+            if (isParallel()) {
+                // all processes take part in the norm of the residual
+                supported = grid_.comm().min(static_cast<int>(supported));
+            }
+            return supported;
+        }
+
+        /// The two norm of the residual of the interior cells, with the components
+        /// scaled by the average formation volume factors of the last convergence
+        /// check.
+        double residualNorm(const BVector& residual) const
+        {
+            double norm2 = 0.0;
+            const int numCells = convergence_cells_.size();
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static) reduction(+:norm2)
+#endif // HAVE_OPENMP
+            for (int i = 0; i < numCells; ++i) {
+                const auto& r = residual[convergence_cells_[i]];
+                for (int compIdx = 0; compIdx < numEq; ++compIdx) {
+                    const double scaled = convergence_B_avg_[compIdx] * r[compIdx];
+                    norm2 += scaled * scaled;
+                }
+            }
+            if (isParallel()) {
+                norm2 = grid_.comm().sum(norm2);
+            }
+            return std::sqrt(norm2);
+        }
+
+        /// Backtrack the update dx applied by updateState() until the residual,
+        /// evaluated without linearization, decreases sufficiently compared to the
+        /// norm residualNormOld of the residual before the update. The well state
+        /// keeps the full update. Without effect if some well cannot evaluate its
+        /// inflow without assembly, which is logged once.
+        void lineSearch(const SimulatorTimerInterface& timer, BVector& dx, const double residualNormOld)
+        {
+            ProfileScope scope("line search");
+
+            auto& solution = ebosSimulator_.model().solution( 0 /* timeIdx */ );
+            double alpha = 1.0;
+            for (int it = 0; it < param_.line_search_max_iter_; ++it) {
+                if (!evaluateResidual(timer, line_search_residual_)) {
+                    if (!line_search_unsupported_logged_ && terminal_output_) {
+                        deferred_logger_.warning("The line search is disabled since some well, e.g. "
+                                                 "a multisegment well, cannot evaluate its inflow "
+                                                 "without assembly.");
+                    }
+                    line_search_unsupported_logged_ = true;
+                    return;
+                }
+                const double norm = residualNorm(line_search_residual_);
+                if (norm <= (1.0 - 1e-4 * alpha) * residualNormOld) {
+                    return;
+                }
+
+                alpha *= 0.5;
+                if (terminal_output_) {
+                    OpmLog::debug("    Line search: residual norm " + std::to_string(norm)
+                                  + " not below " + std::to_string(residualNormOld)
+                                  + ", update scaled by " + std::to_string(alpha));
+                }
+                dx *= 0.5;
+                solution = solution_before_update_;
+                wasSwitched_ = was_switched_before_update_;
+                updateState(dx);
+            }
+        }
+
         void printIf(int c, double x, double y, double eps, std::string type) {
             if (std::abs(x-y) > eps) {
                 std::cout << type << " " <<c << ": "<<x << " " << y << std::endl;
@@ -336,11 +712,14 @@ namespace Opm {
         /// Called once after each time step.
         /// In this class, this function does nothing.
         /// \param[in] timer                  simulation timer
-        void afterStep(const SimulatorTimerInterface& OPM_UNUSED timer)
+        void afterStep(const SimulatorTimerInterface& timer)
         {
             wellModel().timeStepSucceeded(timer.simulationTimeElapsed());
             aquiferModel().timeStepSucceeded(timer);
             ebosSimulator_.problem().endTimeStep();
+            istlSolver().writeTelemetry(timer.reportStepNum(), timer.simulationTimeElapsed(),
+                                        timer.currentStepLength());
+            deferred_logger_.logMessages();
 
         }
 
@@ -348,14 +727,40 @@ namespace Opm {
         /// \param[in]      reservoir_state   reservoir state variables
         /// \param[in, out] well_state        well state variables
         /// \param[in]      initial_assembly  pass true if this is the first call to assemble() in this timestep
+        /// \param[in]      localized         only relinearize the active cells, see linearizeActiveCells()
+        /// \param[in]      reuse_jacobian    only evaluate the residual of the reservoir and keep
+        ///                                   its last Jacobian, see reuseReservoirJacobian()
         SimulatorReport assemble(const SimulatorTimerInterface& timer,
-                                 const int iterationIdx)
+                                 const int iterationIdx,
+                                 const bool localized = false,
+                                 const bool reuse_jacobian = false)
         {
+            ProfileScope scope("assemble");
+
             // -------- Mass balance equations --------
             ebosSimulator_.model().newtonMethod().setIterationIndex(iterationIdx);
             ebosSimulator_.problem().beginIteration();
-            ebosSimulator_.model().linearizer().linearize();
+            if (reuse_jacobian) {
+                reuseReservoirJacobian();
+            }
+            else if (localized) {
+                linearizeActiveCells();
+            }
+            else {
+                ebosSimulator_.model().linearizer().linearize();
+            }
             ebosSimulator_.problem().endIteration();
+            jacobian_reuses_ = reuse_jacobian ? jacobian_reuses_ + 1 : 0;
+
+            // keep the linearization of the reservoir for the next localized assembly
+            // or modified Newton iteration, a localized assembly already updated it;
+            // the residual is refreshed if the Jacobian was reused
+            if ((param_.localized_assembly_ || param_.modified_newton_) && !localized) {
+                if (!reuse_jacobian) {
+                    copyMatrix(ebosSimulator_.model().linearizer().matrix(), reservoir_jacobian_);
+                }
+                reservoir_residual_ = ebosSimulator_.model().linearizer().residual();
+            }
 
             // -------- Aquifer models ----------
             try
@@ -390,88 +795,277 @@ namespace Opm {
             }
             if ( param_.preconditioner_add_well_contributions_ &&
                  ! param_.matrix_add_well_contributions_ ) {
-                matrix_for_preconditioner_ .reset(new Mat(ebosJac));
+                // The storage is kept between the iterations, so the
+                // preconditioner built for it, with the well couplings in its
+                // CPR pressure stage, stays reusable by the linear solver.
+                copyMatrix(ebosJac, matrix_for_preconditioner_);
                 wellModel().addWellContributions(*matrix_for_preconditioner_);
             }
 
+            std::size_t matrixBytes = MemoryAccounting::matrixBytes(ebosJac);
+            for (const Mat* mat : { matrix_for_preconditioner_.get(), reservoir_jacobian_.get(),
+                                    sequential_matrix_.get() }) {
+                if (mat) {
+                    matrixBytes += MemoryAccounting::matrixBytes(*mat);
+                }
+            }
+            matrix_memory_.set(matrixBytes);
+
             return wellModel().lastReport();
         }
 
-        // compute the "relative" change of the solution between time steps
-        double relativeChange() const
+        /// Whether the reservoir equations of a Newton iteration are only relinearized
+        /// for the active cells. The first iteration of a time step is always fully
+        /// linearized, as is every iteration when too many cells are active.
+        bool useLocalizedAssembly(const int iteration) const
         {
-            Scalar resultDelta = 0.0;
-            Scalar resultDenom = 0.0;
+            if (!param_.localized_assembly_ || iteration == 0 || isParallel() || !reservoir_jacobian_) {
+                return false;
+            }
+            const std::size_t nc = active_cells_.size();
+            if (nc == 0 || nc != reservoir_residual_.size() || nc != applied_update_.size()) {
+                return false;
+            }
+            return num_active_cells_ < param_.localized_assembly_max_fraction_ * nc;
+        }
 
-            const auto& elemMapper = ebosSimulator_.model().elementMapper();
+        /// Whether the Newton iteration keeps the Jacobian of the reservoir equations
+        /// of the last linearization (modified Newton). This is only done as long as
+        /// the scaled residual of the previous iteration decreased by at least the
+        /// factor modified_newton_max_ratio, and for at most modified_newton_max_reuse
+        /// consecutive iterations.
+        bool useModifiedNewton(const int iteration) const
+        {
+            if (!param_.modified_newton_ || iteration == 0 || !reservoir_jacobian_ ||
+                jacobian_reuses_ >= param_.modified_newton_max_reuse_) {
+                return false;
+            }
+            const std::size_t n = scaled_residual_history_.size();
+            if (n < 2) {
+                return false;
+            }
+            return scaled_residual_history_[n - 1] < param_.modified_newton_max_ratio_ * scaled_residual_history_[n - 2];
+        }
+
+        /// Restore the Jacobian of the reservoir equations of the last linearization
+        /// and evaluate their residual at the current solution, without assembling
+        /// the Jacobian. The intensive quantities are cached for the wells.
+        void reuseReservoirJacobian()
+        {
+            auto& ebosModel = ebosSimulator_.model();
+            ebosModel.linearizer().matrix() = *reservoir_jacobian_;
+            ebosModel.invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+            ebosModel.globalResidual(ebosModel.linearizer().residual());
+        }
+
+        /// Relinearize the reservoir equations of the active cells only.
+        ///
+        /// The linearization of the other cells is taken from the last assembly,
+        /// with their residual r updated linearly by the update dx applied since,
+        /// i.e. r - J dx. Every element contributes its own residual and the blocks
+        /// of its stencil to the Jacobian, which are recomputed by the local
+        /// linearizer of ebos for the active elements. The kept linearization is
+        /// updated in place and then copied to the linearizer of ebos.
+        void linearizeActiveCells()
+        {
+            auto& ebosModel = ebosSimulator_.model();
+            Mat& jac = *reservoir_jacobian_;
+            BVector& resid = reservoir_residual_;
+
+            // the frozen cells have only frozen or active neighbours, which were
+            // not switched, so that their update is a change of the same variables
+            for (auto row = jac.begin(); row != jac.end(); ++row) {
+                const auto cell_idx = row.index();
+                if (active_cells_[cell_idx]) {
+                    continue;
+                }
+                for (auto col = row->begin(); col != row->end(); ++col) {
+                    col->mmv(applied_update_[col.index()], resid[cell_idx]);
+                }
+            }
+
+            auto& localLinearizer = ebosModel.localLinearizer(/*openMpThreadId=*/0);
+            ElementContext elemCtx( ebosSimulator_ );
+            const auto& elemMapper = ebosModel.elementMapper();
             const auto& gridView = ebosSimulator_.gridView();
-            auto elemIt = gridView.template begin</*codim=*/0>();
             const auto& elemEndIt = gridView.template end</*codim=*/0>();
-            for (; elemIt != elemEndIt; ++elemIt) {
+            for (auto elemIt = gridView.template begin</*codim=*/0>();
+                 elemIt != elemEndIt;
+                 ++elemIt)
+            {
                 const auto& elem = *elemIt;
-                if (elem.partitionType() != Dune::InteriorEntity)
+                if (!active_cells_[elemMapper.index(elem)]) {
                     continue;
+                }
 
-                unsigned globalElemIdx = elemMapper.index(elem);
-                const auto& priVarsNew = ebosSimulator_.model().solution(/*timeIdx=*/0)[globalElemIdx];
+                localLinearizer.linearize(elemCtx, elem);
 
-                Scalar pressureNew;
-                pressureNew = priVarsNew[Indices::pressureSwitchIdx];
+                const unsigned numPrimaryDof = elemCtx.numPrimaryDof(/*timeIdx=*/0);
+                const unsigned numDof = elemCtx.numDof(/*timeIdx=*/0);
+                for (unsigned primaryDofIdx = 0; primaryDofIdx < numPrimaryDof; ++primaryDofIdx) {
+                    const unsigned globI = elemCtx.globalSpaceIndex(/*spaceIdx=*/primaryDofIdx, /*timeIdx=*/0);
+                    resid[globI] = localLinearizer.residual(primaryDofIdx);
+                    for (unsigned dofIdx = 0; dofIdx < numDof; ++dofIdx) {
+                        const unsigned globJ = elemCtx.globalSpaceIndex(/*spaceIdx=*/dofIdx, /*timeIdx=*/0);
+                        jac[globJ][globI] = localLinearizer.jacobian(dofIdx, primaryDofIdx);
+                    }
+                }
+            }
 
-                Scalar saturationsNew[FluidSystem::numPhases] = { 0.0 };
-                Scalar oilSaturationNew = 1.0;
-                if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
-                    saturationsNew[FluidSystem::waterPhaseIdx] = priVarsNew[Indices::waterSaturationIdx];
-                    oilSaturationNew -= saturationsNew[FluidSystem::waterPhaseIdx];
+            // the matrix of ebos has the pattern of the copy
+            copyMatrixValues(jac, ebosModel.linearizer().matrix());
+            ebosModel.linearizer().residual() = resid;
+        }
+
+        /// Mark the cells whose residual is not small compared to the tolerances,
+        /// before the residual is modified by the linear solve. See
+        /// updateActiveCells().
+        void markUnconvergedCells(const SimulatorTimerInterface& timer)
+        {
+            const auto& ebosModel = ebosSimulator_.model();
+            const auto& ebosProblem = ebosSimulator_.problem();
+            const auto& ebosResid = ebosModel.linearizer().residual();
+
+            const double dt = timer.currentStepLength();
+            const double maxResidual = param_.localized_assembly_tolerance_ * param_.tolerance_cnv_;
+
+            const std::size_t nc = ebosResid.size();
+            unconverged_cells_.assign(nc, false);
+            for (std::size_t cell_idx = 0; cell_idx < nc; ++cell_idx) {
+                const double pvValue = ebosProblem.porosity(cell_idx) * ebosModel.dofTotalVolume(cell_idx);
+                bool active = false;
+                for (int compIdx = 0; compIdx < numEq && !active; ++compIdx) {
+                    active = convergence_B_avg_[compIdx] * dt * std::abs(ebosResid[cell_idx][compIdx]) > maxResidual * pvValue;
                 }
+                unconverged_cells_[cell_idx] = active;
+            }
+        }
 
-                if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx) && priVarsNew.primaryVarsMeaning() == PrimaryVariables::Sw_po_Sg) {
-                    saturationsNew[FluidSystem::gasPhaseIdx] = priVarsNew[Indices::compositionSwitchIdx];
-                    oilSaturationNew -= saturationsNew[FluidSystem::gasPhaseIdx];
+        /// Mark the cells to be relinearized by the next localized assembly, after
+        /// the update: the cells marked by markUnconvergedCells(), those whose
+        /// applied update is not small compared to the tolerances or whose
+        /// primary variables were switched, and their neighbours.
+        void updateActiveCells()
+        {
+            const auto& ebosModel = ebosSimulator_.model();
+            const auto& ebosJac = ebosModel.linearizer().matrix();
+            const auto& solution = ebosModel.solution(/*timeIdx=*/0);
+
+            const double factor = param_.localized_assembly_tolerance_;
+            const std::size_t nc = unconverged_cells_.size();
+            for (std::size_t cell_idx = 0; cell_idx < nc; ++cell_idx) {
+                bool active = unconverged_cells_[cell_idx]
+                    || (cell_idx < wasSwitched_.size() && wasSwitched_[cell_idx]);
+                if (!active) {
+                    const auto& dx = applied_update_[cell_idx];
+                    const double p = solution[cell_idx][Indices::pressureSwitchIdx];
+                    active = std::abs(dx[Indices::pressureSwitchIdx]) > factor * dpMaxRel() * std::abs(p);
+                    for (int pvIdx = 0; pvIdx < numEq && !active; ++pvIdx) {
+                        if (pvIdx != Indices::pressureSwitchIdx) {
+                            active = std::abs(dx[pvIdx]) > factor * dsMax();
+                        }
+                    }
+                }
+                unconverged_cells_[cell_idx] = active;
+            }
+
+            active_cells_.assign(nc, false);
+            for (auto row = ebosJac.begin(); row != ebosJac.end(); ++row) {
+                if (!unconverged_cells_[row.index()]) {
+                    continue;
                 }
+                for (auto col = row->begin(); col != row->end(); ++col) {
+                    active_cells_[col.index()] = true;
+                }
+            }
+            num_active_cells_ = std::count(active_cells_.begin(), active_cells_.end(), true);
+        }
 
-                if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx)) {
-                    saturationsNew[FluidSystem::oilPhaseIdx] = oilSaturationNew;
+        // compute the "relative" change of the solution between time steps
+        double relativeChange() const
+        {
+            // The sums of the last update of the state are used if nothing changed
+            // the solution since. Their global reduction is done together with
+            // the convergence check that followed the update.
+            Scalar sums[2] = { relative_change_sums_[0], relative_change_sums_[1] };
+            if (relative_change_state_ == RelativeChangeState::Invalid) {
+                updateConvergenceCells();
+                Scalar resultDelta = 0.0;
+                Scalar resultDenom = 0.0;
+                const int numCells = convergence_cells_.size();
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static) reduction(+:resultDelta,resultDenom)
+#endif // HAVE_OPENMP
+                for (int i = 0; i < numCells; ++i) {
+                    addRelativeChange(convergence_cells_[i], resultDelta, resultDenom);
                 }
+                sums[0] = resultDelta;
+                sums[1] = resultDenom;
+            }
+            if (relative_change_state_ != RelativeChangeState::Global && isParallel()) {
+                grid_.comm().sum(sums, 2);
+            }
 
-                const auto& priVarsOld = ebosSimulator_.model().solution(/*timeIdx=*/1)[globalElemIdx];
+            if (sums[1] > 0.0)
+                return sums[0]/sums[1];
+            return 0.0;
+        }
 
-                Scalar pressureOld;
-                pressureOld = priVarsOld[Indices::pressureSwitchIdx];
+        /// Add the squared change of the pressure and the saturations of a cell
+        /// since the last time step to delta, and their squared values to denom.
+        void addRelativeChange(const unsigned cell_idx, Scalar& delta, Scalar& denom) const
+        {
+            const auto& priVarsNew = ebosSimulator_.model().solution(/*timeIdx=*/0)[cell_idx];
 
-                Scalar saturationsOld[FluidSystem::numPhases] = { 0.0 };
-                Scalar oilSaturationOld = 1.0;
-                if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
-                    saturationsOld[FluidSystem::waterPhaseIdx] = priVarsOld[Indices::waterSaturationIdx];
-                    oilSaturationOld -= saturationsOld[FluidSystem::waterPhaseIdx];
-                }
+            Scalar pressureNew;
+            pressureNew = priVarsNew[Indices::pressureSwitchIdx];
 
-                if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx) && priVarsOld.primaryVarsMeaning() == PrimaryVariables::Sw_po_Sg) {
-                    saturationsOld[FluidSystem::gasPhaseIdx] = priVarsOld[Indices::compositionSwitchIdx];
-                    oilSaturationOld -= saturationsOld[FluidSystem::gasPhaseIdx];
-                }
+            Scalar saturationsNew[FluidSystem::numPhases] = { 0.0 };
+            Scalar oilSaturationNew = 1.0;
+            if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+                saturationsNew[FluidSystem::waterPhaseIdx] = priVarsNew[Indices::waterSaturationIdx];
+                oilSaturationNew -= saturationsNew[FluidSystem::waterPhaseIdx];
+            }
 
-                if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx)) {
-                    saturationsOld[FluidSystem::oilPhaseIdx] = oilSaturationOld;
-                }
+            if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx) && priVarsNew.primaryVarsMeaning() == PrimaryVariables::Sw_po_Sg) {
+                saturationsNew[FluidSystem::gasPhaseIdx] = priVarsNew[Indices::compositionSwitchIdx];
+                oilSaturationNew -= saturationsNew[FluidSystem::gasPhaseIdx];
+            }
+
+            if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx)) {
+                saturationsNew[FluidSystem::oilPhaseIdx] = oilSaturationNew;
+            }
 
-                Scalar tmp = pressureNew - pressureOld;
-                resultDelta += tmp*tmp;
-                resultDenom += pressureNew*pressureNew;
+            const auto& priVarsOld = ebosSimulator_.model().solution(/*timeIdx=*/1)[cell_idx];
 
-                for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++ phaseIdx) {
-                    Scalar tmp = saturationsNew[phaseIdx] - saturationsOld[phaseIdx];
-                    resultDelta += tmp*tmp;
-                    resultDenom += saturationsNew[phaseIdx]*saturationsNew[phaseIdx];
-                }
+            Scalar pressureOld;
+            pressureOld = priVarsOld[Indices::pressureSwitchIdx];
+
+            Scalar saturationsOld[FluidSystem::numPhases] = { 0.0 };
+            Scalar oilSaturationOld = 1.0;
+            if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+                saturationsOld[FluidSystem::waterPhaseIdx] = priVarsOld[Indices::waterSaturationIdx];
+                oilSaturationOld -= saturationsOld[FluidSystem::waterPhaseIdx];
             }
 
-            resultDelta = gridView.comm().sum(resultDelta);
-            resultDenom = gridView.comm().sum(resultDenom);
+            if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx) && priVarsOld.primaryVarsMeaning() == PrimaryVariables::Sw_po_Sg) {
+                saturationsOld[FluidSystem::gasPhaseIdx] = priVarsOld[Indices::compositionSwitchIdx];
+                oilSaturationOld -= saturationsOld[FluidSystem::gasPhaseIdx];
+            }
 
-            if (resultDenom > 0.0)
-                return resultDelta/resultDenom;
-            return 0.0;
+            if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx)) {
+                saturationsOld[FluidSystem::oilPhaseIdx] = oilSaturationOld;
+            }
+
+            Scalar tmp = pressureNew - pressureOld;
+            delta += tmp*tmp;
+            denom += pressureNew*pressureNew;
+
+            for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++ phaseIdx) {
+                Scalar tmp = saturationsNew[phaseIdx] - saturationsOld[phaseIdx];
+                delta += tmp*tmp;
+                denom += saturationsNew[phaseIdx]*saturationsNew[phaseIdx];
+            }
         }
 
 
@@ -485,6 +1079,8 @@ namespace Opm {
         /// r is the residual.
         void solveJacobianSystem(BVector& x) const
         {
+            ProfileScope scope("linear solve");
+
             const auto& ebosJac = ebosSimulator_.model().linearizer().matrix();
             auto& ebosResid = ebosSimulator_.model().linearizer().residual();
 
@@ -501,7 +1097,7 @@ namespace Opm {
             wellModel().apply(ebosResid);
 
             // set initial guess
-            x = 0.0;
+            const bool hasInitialGuess = linearInitialGuess(x);
 
             const Mat& actual_mat_for_prec = matrix_for_preconditioner_ ? *matrix_for_preconditioner_.get() : ebosJac;
             // Solve system.
@@ -509,18 +1105,169 @@ namespace Opm {
             {
                 typedef WellModelMatrixAdapter< Mat, BVector, BVector, BlackoilWellModel<TypeTag>, true > Operator;
                 Operator opA(ebosJac, actual_mat_for_prec, wellModel(),
-                             istlSolver().parallelInformation() );
+                             istlSolver().parallelInformation(), istlSolver().telemetry() );
                 assert( opA.comm() );
+                if (hasInitialGuess) {
+                    safeguardLinearInitialGuess(opA, x, ebosResid);
+                }
                 istlSolver().solve( opA, x, ebosResid, *(opA.comm()) );
             }
             else
             {
                 typedef WellModelMatrixAdapter< Mat, BVector, BVector, BlackoilWellModel<TypeTag>, false > Operator;
-                Operator opA(ebosJac, actual_mat_for_prec, wellModel());
+                Operator opA(ebosJac, actual_mat_for_prec, wellModel(),
+                             boost::any(), istlSolver().telemetry() );
+                if (hasInitialGuess) {
+                    safeguardLinearInitialGuess(opA, x, ebosResid);
+                }
                 istlSolver().solve( opA, x, ebosResid );
             }
         }
 
+        /// Set the initial guess of the linear solve according to
+        /// linear_solver_initial_guess from the linear solutions of the last
+        /// Newton iterations of the time step.
+        /// \return False if the initial guess is zero.
+        bool linearInitialGuess(BVector& x) const
+        {
+            x = 0.0;
+            if (param_.linear_solver_initial_guess_ <= 0 || linear_solutions_kept_ == 0) {
+                return false;
+            }
+            double scale = param_.linear_solver_initial_guess_scale_;
+            if (param_.linear_solver_initial_guess_ > 1 && linear_solutions_kept_ > 1) {
+                // The Newton increments of a converging iteration shrink by roughly
+                // a constant ratio, estimated by the projection of the last solution
+                // onto the one before over the interior cells.
+                double dots[2] = { 0.0, 0.0 };
+                const int numCells = convergence_cells_.size();
+                for (int i = 0; i < numCells; ++i) {
+                    const unsigned cell_idx = convergence_cells_[i];
+                    dots[0] += linear_solution_last_[cell_idx] * linear_solution_before_last_[cell_idx];
+                    dots[1] += linear_solution_before_last_[cell_idx] * linear_solution_before_last_[cell_idx];
+                }
+                if (isParallel()) {
+                    grid_.comm().sum(dots, 2);
+                }
+                scale = dots[1] > 0.0 ? std::max(0.0, std::min(1.0, dots[0] / dots[1])) : 0.0;
+            }
+            if (scale <= 0.0) {
+                return false;
+            }
+            x = linear_solution_last_;
+            x *= scale;
+            return true;
+        }
+
+        /// Reset the initial guess x of the linear solve to zero if its residual
+        /// b - Ax is not below the residual b of the zero guess.
+        template <class Operator>
+        void safeguardLinearInitialGuess(const Operator& opA, BVector& x, const BVector& b) const
+        {
+            BVector r(b);
+            opA.applyscaleadd(-1.0, x, r);
+            if (!(residualNorm(r) < residualNorm(b))) {
+                x = 0.0;
+            }
+        }
+
+        /// Sequential sweeps used as nonlinear preconditioner of the fully implicit
+        /// Newton method. Each sweep solves for the pressure with the saturations and
+        /// compositions fixed, followed by solves for the other primary variables with
+        /// the pressure fixed, and updates the state after each solve.
+        SimulatorReport sequentialSweeps(const SimulatorTimerInterface& timer)
+        {
+            SimulatorReport report;
+            const int nc = UgGridHelpers::numCells(grid_);
+            BVector& x = newton_update_;
+            if ( static_cast<int>(x.size()) != nc ) {
+                x.resize(nc, false);
+            }
+
+            for (int sweep = 0; sweep < param_.sequential_sweeps_; ++sweep) {
+                for (int stage = 0; stage <= param_.sequential_transport_sweeps_; ++stage) {
+                    report += assemble(timer, /*iterationIdx=*/0);
+                    report.total_linearizations += 1;
+
+                    solveSequentialSystem(x, /*pressure=*/stage == 0);
+                    report.total_linear_iterations += linearIterationsLastSolve();
+
+                    wellModel().recoverWellSolutionAndUpdateWellState(x);
+                    updateState(x);
+                }
+            }
+            return report;
+        }
+
+        /// Solve the pressure or the transport part of the Jacobian system with the
+        /// wells eliminated. The pressure equation is the sum of the conservation
+        /// equations, as in the quasi-IMPES decoupling of the CPR preconditioner, the
+        /// transport equations are the conservation equations other than the one at
+        /// the position of the pressure. The unknowns that are fixed get identity rows.
+        void solveSequentialSystem(BVector& x, const bool pressure)
+        {
+            ProfileScope scope("linear solve");
+
+            copyMatrix(ebosSimulator_.model().linearizer().matrix(), sequential_matrix_);
+            Mat& A = *sequential_matrix_;
+            BVector& r = sequential_residual_;
+            r = ebosSimulator_.model().linearizer().residual();
+
+            if (!param_.matrix_add_well_contributions_) {
+                wellModel().addWellContributions(A);
+            }
+            wellModel().apply(r);
+
+            const int pIdx = Indices::pressureSwitchIdx;
+            for (auto row = A.begin(); row != A.end(); ++row) {
+                const auto rowIdx = row.index();
+                for (auto col = row->begin(); col != row->end(); ++col) {
+                    auto& block = *col;
+                    const bool diagonal = col.index() == rowIdx;
+                    if (pressure) {
+                        double sum = 0.0;
+                        for (int eqIdx = 0; eqIdx < numEq; ++eqIdx) {
+                            sum += block[eqIdx][pIdx];
+                        }
+                        block = 0.0;
+                        block[pIdx][pIdx] = sum;
+                        if (diagonal) {
+                            for (int eqIdx = 0; eqIdx < numEq; ++eqIdx) {
+                                if (eqIdx != pIdx) {
+                                    block[eqIdx][eqIdx] = 1.0;
+                                }
+                            }
+                        }
+                    }
+                    else {
+                        for (int i = 0; i < numEq; ++i) {
+                            block[i][pIdx] = 0.0;
+                            block[pIdx][i] = 0.0;
+                        }
+                        if (diagonal) {
+                            block[pIdx][pIdx] = 1.0;
+                        }
+                    }
+                }
+
+                auto& residual = r[rowIdx];
+                if (pressure) {
+                    double sum = 0.0;
+                    for (int eqIdx = 0; eqIdx < numEq; ++eqIdx) {
+                        sum += residual[eqIdx];
+                    }
+                    residual = 0.0;
+                    residual[pIdx] = sum;
+                }
+                else {
+                    residual[pIdx] = 0.0;
+                }
+            }
+
+            x = 0.0;
+            istlSolver().solve(A, x, r);
+        }
+
         //=====================================================================
         // Implementation for ISTL-matrix based operator
         //=====================================================================
@@ -566,25 +1313,42 @@ namespace Opm {
           WellModelMatrixAdapter (const M& A,
                                   const M& A_for_precond,
                                   const WellModel& wellMod,
-                                  const boost::any& parallelInformation = boost::any() )
-              : A_( A ), A_for_precond_(A_for_precond), wellMod_( wellMod ), comm_()
+                                  const boost::any& parallelInformation = boost::any(),
+                                  LinearSolverTelemetry* telemetry = nullptr )
+              : A_( A ), A_for_precond_(A_for_precond), wellMod_( wellMod ), comm_(),
+                telemetry_( telemetry )
           {
 #if HAVE_MPI
             if( parallelInformation.type() == typeid(ParallelISTLInformation) )
             {
               const ParallelISTLInformation& info =
                   boost::any_cast<const ParallelISTLInformation&>( parallelInformation);
-              comm_.reset( new communication_type( info.communicator() ) );
+              // built once and shared by the operators of all Newton iterations
+              comm_ = info.istlCommunication( A_.N() );
+
+              // The rows of copy cells are zeroed by project(), hence they
+              // are not multiplied.
+              computedRows_ = ParallelISTLInformation::nonCopyRows( *comm_, A_.N() );
             }
 #endif
           }
 
           virtual void apply( const X& x, Y& y ) const
           {
-            A_.mv( x, y );
+            ProfileScope scope( KernelCounters::WellMatrixApply );
+            {
+              TelemetryTimer timer( telemetryCounter( telemetry_, &LinearSolverTelemetry::spmv_time ) );
+              if( computedRows_.empty() )
+                detail::bcrsMv( A_, x, y );
+              else
+                detail::bcrsMv( A_, x, y, computedRows_ );
+            }
 
             // add well model modification to y
-            wellMod_.apply(x, y );
+            {
+              TelemetryTimer timer( telemetryCounter( telemetry_, &LinearSolverTelemetry::well_apply_time ) );
+              wellMod_.apply(x, y );
+            }
 
 #if HAVE_MPI
             if( comm_ )
@@ -595,10 +1359,19 @@ namespace Opm {
           // y += \alpha * A * x
           virtual void applyscaleadd (field_type alpha, const X& x, Y& y) const
           {
-            A_.usmv(alpha,x,y);
+            {
+              TelemetryTimer timer( telemetryCounter( telemetry_, &LinearSolverTelemetry::spmv_time ) );
+              if( computedRows_.empty() )
+                detail::bcrsUsmv( alpha, A_, x, y );
+              else
+                detail::bcrsUsmv( alpha, A_, x, y, computedRows_ );
+            }
 
             // add scaled well model modification to y
-            wellMod_.applyScaleAdd( alpha, x, y );
+            {
+              TelemetryTimer timer( telemetryCounter( telemetry_, &LinearSolverTelemetry::well_apply_time ) );
+              wellMod_.applyScaleAdd( alpha, x, y );
+            }
 
 #if HAVE_MPI
             if( comm_ )
@@ -617,155 +1390,207 @@ namespace Opm {
           const matrix_type& A_ ;
           const matrix_type& A_for_precond_ ;
           const WellModel& wellMod_;
-          std::unique_ptr< communication_type > comm_;
+          std::shared_ptr< communication_type > comm_;
+          LinearSolverTelemetry* telemetry_;
+          // the rows that are not zeroed by project(), empty in sequential runs
+          std::vector<bool> computedRows_;
         };
 
         /// Apply an update to the primary variables, chopped if appropriate.
         /// \param[in]      dx                updates to apply to primary variables
-        /// \param[in, out] reservoir_state   reservoir state variables
-        /// \param[in, out] well_state        well state variables
         void updateState(const BVector& dx)
         {
-            const auto& ebosProblem = ebosSimulator_.problem();
-
-            unsigned numSwitched = 0;
-            ElementContext elemCtx( ebosSimulator_ );
-            const auto& gridView = ebosSimulator_.gridView();
-            const auto& elemEndIt = gridView.template end</*codim=*/0>();
-            SolutionVector& solution = ebosSimulator_.model().solution( 0 /* timeIdx */ );
+            updateState(dx, [](const unsigned) {});
+        }
 
-            for (auto elemIt = gridView.template begin</*codim=*/0>();
-                 elemIt != elemEndIt;
-                 ++elemIt)
+        /// Apply an update to the primary variables, chopped if appropriate.
+        /// \param[in]      dx                updates to apply to primary variables
+        /// \param[in]      prepareCell       called with the index of each cell
+        ///                                   before its update is applied, it may
+        ///                                   modify the entry of dx of the cell
+        template <class PrepareCell>
+        void updateState(const BVector& dx, const PrepareCell& prepareCell)
+        {
+            ProfileScope scope("update", KernelCounters::UpdateState);
+
+            // The update of a cell only depends on its own primary variables,
+            // hence the cells are updated concurrently. The chunks are a
+            // multiple of the word size of the bitset wasSwitched_, so that
+            // two threads never write to the same word.
+            const int numDof = ebosSimulator_.model().numGridDof();
+            int numSwitched = 0;
+            detail::OmpExceptionGuard guard;
+            // The sums of relativeChange() are accumulated for the interior cells
+            // in the same pass.
+            const bool sumChange = static_cast<int>(convergence_interior_.size()) == numDof;
+            Scalar changeDelta = 0.0;
+            Scalar changeDenom = 0.0;
+            // the localized assembly estimates the residual of the frozen cells
+            // from the update actually applied
+            const bool recordUpdate = param_.localized_assembly_;
+            auto& solution = ebosSimulator_.model().solution( 0 /* timeIdx */ );
+            if (recordUpdate && static_cast<int>(applied_update_.size()) != numDof) {
+                applied_update_.resize(numDof, false);
+            }
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static, 1024) reduction(+:numSwitched,changeDelta,changeDenom)
+#endif // HAVE_OPENMP
+            for (int cell_idx = 0; cell_idx < numDof; ++cell_idx)
             {
-                const auto& elem = *elemIt;
+                try {
+                    prepareCell(cell_idx);
+                    const PrimaryVariables before = recordUpdate ? solution[cell_idx] : PrimaryVariables();
+                    if (updateCellState(dx, cell_idx)) {
+                        ++numSwitched;
+                    }
+                    if (recordUpdate) {
+                        for (int pvIdx = 0; pvIdx < numEq; ++pvIdx) {
+                            applied_update_[cell_idx][pvIdx] = before[pvIdx] - solution[cell_idx][pvIdx];
+                        }
+                    }
+                    if (sumChange && convergence_interior_[cell_idx]) {
+                        addRelativeChange(cell_idx, changeDelta, changeDenom);
+                    }
+                }
+                catch (...) {
+                    guard.capture();
+                }
+            }
+            if (guard.failed()) {
+                relative_change_state_ = RelativeChangeState::Invalid;
+                guard.rethrow();
+            }
+            relative_change_sums_[0] = changeDelta;
+            relative_change_sums_[1] = changeDenom;
+            relative_change_state_ = sumChange ? RelativeChangeState::Local : RelativeChangeState::Invalid;
 
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-                const unsigned cell_idx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+            // if the solution is updated the intensive Quantities need to be recalculated
+            ebosSimulator_.model().invalidateIntensiveQuantitiesCache(/*timeIdx=*/0);
 
-                PrimaryVariables& priVars = solution[ cell_idx ];
+        }
 
-                const double& dp = dx[cell_idx][Indices::pressureSwitchIdx];
-                double& p = priVars[Indices::pressureSwitchIdx];
-                const double& dp_rel_max = dpMaxRel();
-                const int sign_dp = dp > 0 ? 1: -1;
-                p -= sign_dp * std::min(std::abs(dp), std::abs(p)*dp_rel_max);
-                p = std::max(p, 0.0);
+        /// Apply the update of one cell to its primary variables, chopped if
+        /// appropriate, and switch the primary variables if needed.
+        /// \return Whether the primary variables of the cell were switched.
+        bool updateCellState(const BVector& dx, const unsigned cell_idx)
+        {
+            const auto& ebosProblem = ebosSimulator_.problem();
+            PrimaryVariables& priVars = ebosSimulator_.model().solution( 0 /* timeIdx */ )[ cell_idx ];
+
+            const double& dp = dx[cell_idx][Indices::pressureSwitchIdx];
+            double& p = priVars[Indices::pressureSwitchIdx];
+            const double& dp_rel_max = dpMaxRel();
+            const int sign_dp = dp > 0 ? 1: -1;
+            p -= sign_dp * std::min(std::abs(dp), std::abs(p)*dp_rel_max);
+            p = std::max(p, 0.0);
+
+            // Saturation updates.
+            const double dsw = FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx) ? dx[cell_idx][Indices::waterSaturationIdx] : 0.0;
+            const double dxvar = FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx) ? dx[cell_idx][Indices::compositionSwitchIdx] : 0.0;
+
+            double dso = 0.0;
+            double dsg = 0.0;
+            double drs = 0.0;
+            double drv = 0.0;
+
+            // determine the saturation delta values
+            if (priVars.primaryVarsMeaning() == PrimaryVariables::Sw_po_Sg) {
+                dsg = dxvar;
+            }
+            else if (priVars.primaryVarsMeaning() == PrimaryVariables::Sw_po_Rs) {
+                drs = dxvar;
+            }
+            else {
+                assert(priVars.primaryVarsMeaning() == PrimaryVariables::Sw_pg_Rv);
+                drv = dxvar;
+                dsg = 0.0;
+            }
 
-                // Saturation updates.
-                const double dsw = FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx) ? dx[cell_idx][Indices::waterSaturationIdx] : 0.0;
-                const double dxvar = FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx) ? dx[cell_idx][Indices::compositionSwitchIdx] : 0.0;
+            // solvent
+            const double dss = has_solvent_ ? dx[cell_idx][Indices::solventSaturationIdx] : 0.0;
 
-                double dso = 0.0;
-                double dsg = 0.0;
-                double drs = 0.0;
-                double drv = 0.0;
+            // polymer
+            const double dc = has_polymer_ ? dx[cell_idx][Indices::polymerConcentrationIdx] : 0.0;
 
-                // determine the saturation delta values
-                if (priVars.primaryVarsMeaning() == PrimaryVariables::Sw_po_Sg) {
-                    dsg = dxvar;
-                }
-                else if (priVars.primaryVarsMeaning() == PrimaryVariables::Sw_po_Rs) {
-                    drs = dxvar;
-                }
-                else {
-                    assert(priVars.primaryVarsMeaning() == PrimaryVariables::Sw_pg_Rv);
-                    drv = dxvar;
-                    dsg = 0.0;
-                }
+            // oil
+            dso = - (dsw + dsg + dss);
 
-                // solvent
-                const double dss = has_solvent_ ? dx[cell_idx][Indices::solventSaturationIdx] : 0.0;
+            // compute a scaling factor for the saturation update so that the maximum
+            // allowed change of saturations between iterations is not exceeded
+            double maxVal = 0.0;
+            maxVal = std::max(std::abs(dsw),maxVal);
+            maxVal = std::max(std::abs(dsg),maxVal);
+            maxVal = std::max(std::abs(dso),maxVal);
+            maxVal = std::max(std::abs(dss),maxVal);
 
-                // polymer
-                const double dc = has_polymer_ ? dx[cell_idx][Indices::polymerConcentrationIdx] : 0.0;
+            double satScaleFactor = 1.0;
+            if (maxVal > dsMax()) {
+                satScaleFactor = dsMax()/maxVal;
+            }
 
-                // oil
-                dso = - (dsw + dsg + dss);
+            if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+                double& sw = priVars[Indices::waterSaturationIdx];
+                sw -= satScaleFactor * dsw;
+            }
 
-                // compute a scaling factor for the saturation update so that the maximum
-                // allowed change of saturations between iterations is not exceeded
-                double maxVal = 0.0;
-                maxVal = std::max(std::abs(dsw),maxVal);
-                maxVal = std::max(std::abs(dsg),maxVal);
-                maxVal = std::max(std::abs(dso),maxVal);
-                maxVal = std::max(std::abs(dss),maxVal);
+            if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+                 if (priVars.primaryVarsMeaning() == PrimaryVariables::Sw_po_Sg) {
+                       double& sg = priVars[Indices::compositionSwitchIdx];
+                       sg -= satScaleFactor * dsg;
+                 }
+            }
 
-                double satScaleFactor = 1.0;
-                if (maxVal > dsMax()) {
-                    satScaleFactor = dsMax()/maxVal;
-                }
+            if (has_solvent_) {
+                double& ss = priVars[Indices::solventSaturationIdx];
+                ss -= satScaleFactor * dss;
+                ss = std::min(std::max(ss, 0.0),1.0);
+            }
+            if (has_polymer_) {
+                double& c = priVars[Indices::polymerConcentrationIdx];
+                c -= satScaleFactor * dc;
+                c = std::max(c, 0.0);
+            }
 
-                if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
-                    double& sw = priVars[Indices::waterSaturationIdx];
-                    sw -= satScaleFactor * dsw;
-                }
+            if (has_energy_) {
+                double& T = priVars[Indices::temperatureIdx];
+                const double dT = dx[cell_idx][Indices::temperatureIdx];
+                T -= dT;
+            }
 
-                if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
-                     if (priVars.primaryVarsMeaning() == PrimaryVariables::Sw_po_Sg) {
-                           double& sg = priVars[Indices::compositionSwitchIdx];
-                           sg -= satScaleFactor * dsg;
-                     }
-                }
+            // Update rs and rv
+            if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx) && FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx) ) {
+                unsigned pvtRegionIdx = ebosSimulator_.problem().pvtRegionIndex(cell_idx);
+                const double drmaxrel = drMaxRel();
+                if (has_disgas_) {
+                    if (priVars.primaryVarsMeaning() == PrimaryVariables::Sw_po_Rs) {
+                        Scalar RsSat =
+                            FluidSystem::oilPvt().saturatedGasDissolutionFactor(pvtRegionIdx, 300.0, p);
+
+                        double& rs = priVars[Indices::compositionSwitchIdx];
+                        rs -= ((drs<0)?-1:1)*std::min(std::abs(drs), RsSat*drmaxrel);
+                        rs = std::max(rs, 0.0);
+                    }
 
-                if (has_solvent_) {
-                    double& ss = priVars[Indices::solventSaturationIdx];
-                    ss -= satScaleFactor * dss;
-                    ss = std::min(std::max(ss, 0.0),1.0);
-                }
-                if (has_polymer_) {
-                    double& c = priVars[Indices::polymerConcentrationIdx];
-                    c -= satScaleFactor * dc;
-                    c = std::max(c, 0.0);
                 }
-
-                if (has_energy_) {
-                    double& T = priVars[Indices::temperatureIdx];
-                    const double dT = dx[cell_idx][Indices::temperatureIdx];
-                    T -= dT;
-                }
-
-                // Update rs and rv
-                if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx) && FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx) ) {
-                    unsigned pvtRegionIdx = ebosSimulator_.problem().pvtRegionIndex(cell_idx);
-                    const double drmaxrel = drMaxRel();
-                    if (has_disgas_) {
-                        if (priVars.primaryVarsMeaning() == PrimaryVariables::Sw_po_Rs) {
-                            Scalar RsSat =
-                                FluidSystem::oilPvt().saturatedGasDissolutionFactor(pvtRegionIdx, 300.0, p);
-
-                            double& rs = priVars[Indices::compositionSwitchIdx];
-                            rs -= ((drs<0)?-1:1)*std::min(std::abs(drs), RsSat*drmaxrel);
-                            rs = std::max(rs, 0.0);
-                        }
-
-                    }
-                    if (has_vapoil_) {
-                        if (priVars.primaryVarsMeaning() == PrimaryVariables::Sw_pg_Rv) {
-                            Scalar RvSat =
-                                FluidSystem::gasPvt().saturatedOilVaporizationFactor(pvtRegionIdx, 300.0, p);
-
-                            double& rv = priVars[Indices::compositionSwitchIdx];
-                            rv -= ((drv<0)?-1:1)*std::min(std::abs(drv), RvSat*drmaxrel);
-                            rv = std::max(rv, 0.0);
-                        }
+                if (has_vapoil_) {
+                    if (priVars.primaryVarsMeaning() == PrimaryVariables::Sw_pg_Rv) {
+                        Scalar RvSat =
+                            FluidSystem::gasPvt().saturatedOilVaporizationFactor(pvtRegionIdx, 300.0, p);
+
+                        double& rv = priVars[Indices::compositionSwitchIdx];
+                        rv -= ((drv<0)?-1:1)*std::min(std::abs(drv), RvSat*drmaxrel);
+                        rv = std::max(rv, 0.0);
                     }
                 }
-
-               // Add an epsilon to make it harder to switch back immediately after the primary variable was changed.
-                if (wasSwitched_[cell_idx])
-                    wasSwitched_[cell_idx] = priVars.adaptPrimaryVariables(ebosProblem, cell_idx, 1e-5);
-                else
-                    wasSwitched_[cell_idx] = priVars.adaptPrimaryVariables(ebosProblem, cell_idx);
-
-                if (wasSwitched_[cell_idx])
-                    ++numSwitched;
             }
 
-            // if the solution is updated the intensive Quantities need to be recalculated
-            ebosSimulator_.model().invalidateIntensiveQuantitiesCache(/*timeIdx=*/0);
+            // Add an epsilon to make it harder to switch back immediately after the primary variable was changed.
+            if (wasSwitched_[cell_idx])
+                wasSwitched_[cell_idx] = priVars.adaptPrimaryVariables(ebosProblem, cell_idx, 1e-5);
+            else
+                wasSwitched_[cell_idx] = priVars.adaptPrimaryVariables(ebosProblem, cell_idx);
 
+            return wasSwitched_[cell_idx];
         }
 
         /// Return true if output to cout is wanted.
@@ -786,50 +1611,175 @@ namespace Opm {
 
             if( comm.size() > 1 )
             {
-                // global reduction
-                std::vector< Scalar > sumBuffer;
-                std::vector< Scalar > maxBuffer;
+                // global reduction of the sums followed by the maxima in a single collective
                 const int numComp = B_avg.size();
-                sumBuffer.reserve( 2*numComp + 1 ); // +1 for pvSum
-                maxBuffer.reserve( numComp );
+                std::vector< double > buffer;
+                buffer.reserve( 3*numComp + 3 ); // +1 for pvSum, +2 for the relative change
                 for( int compIdx = 0; compIdx < numComp; ++compIdx )
                 {
-                    sumBuffer.push_back( B_avg[ compIdx ] );
-                    sumBuffer.push_back( R_sum[ compIdx ] );
-                    maxBuffer.push_back( maxCoeff[ compIdx ] );
+                    buffer.push_back( B_avg[ compIdx ] );
+                    buffer.push_back( R_sum[ compIdx ] );
                 }
 
                 // Compute total pore volume
-                sumBuffer.push_back( pvSum );
+                buffer.push_back( pvSum );
 
-                // compute global sum
-                comm.sum( sumBuffer.data(), sumBuffer.size() );
+                // the sums of relativeChange() of the last update
+                const bool sumChange = relative_change_state_ == RelativeChangeState::Local;
+                if( sumChange )
+                {
+                    buffer.push_back( relative_change_sums_[ 0 ] );
+                    buffer.push_back( relative_change_sums_[ 1 ] );
+                }
+                const int numSum = buffer.size();
+
+                buffer.insert( buffer.end(), maxCoeff.begin(), maxCoeff.end() );
 
-                // compute global max
-                comm.max( maxBuffer.data(), maxBuffer.size() );
+                detail::sumAndMax( comm, buffer, numSum );
 
                 // restore values to local variables
                 for( int compIdx = 0, buffIdx = 0; compIdx < numComp; ++compIdx, ++buffIdx )
                 {
-                    B_avg[ compIdx ]    = sumBuffer[ buffIdx ];
+                    B_avg[ compIdx ]    = buffer[ buffIdx ];
                     ++buffIdx;
 
-                    R_sum[ compIdx ]       = sumBuffer[ buffIdx ];
+                    R_sum[ compIdx ]       = buffer[ buffIdx ];
                 }
 
-                for( int compIdx = 0; compIdx < numComp; ++compIdx )
+                // restore global pore volume
+                pvSum = buffer[ 2*numComp ];
+
+                if( sumChange )
                 {
-                    maxCoeff[ compIdx ] = maxBuffer[ compIdx ];
+                    relative_change_sums_[ 0 ] = buffer[ numSum - 2 ];
+                    relative_change_sums_[ 1 ] = buffer[ numSum - 1 ];
+                    relative_change_state_ = RelativeChangeState::Global;
                 }
 
-                // restore global pore volume
-                pvSum = sumBuffer.back();
+                for( int compIdx = 0; compIdx < numComp; ++compIdx )
+                {
+                    maxCoeff[ compIdx ] = buffer[ numSum + compIdx ];
+                }
             }
 
             // return global pore volume
             return pvSum;
         }
 
+        /// Global sums of the residuals, the average inverse formation volume factors
+        /// and the pore volume of the convergence check that do not depend on the
+        /// partitioning, nor on the number of threads, see detail::ReproducibleSum.
+        /// The maxima of maxCoeff are reduced as well.
+        /// \return The global pore volume.
+        double reproducibleConvergenceReduction(std::vector< Scalar >& R_sum,
+                                                std::vector< Scalar >& maxCoeff,
+                                                std::vector< Scalar >& B_avg) const
+        {
+            ProfileScope scope("reproducible reduction");
+
+            typedef detail::ReproducibleSum Sum;
+            const auto& ebosResid = ebosSimulator_.model().linearizer().residual();
+            const int numComp = R_sum.size();
+            const int numCells = convergence_cells_.size();
+            // the residuals and inverse formation volume factors of each
+            // component, followed by the pore volume
+            const int numSums = 2 * numComp + 1;
+
+            // Bounds of the magnitudes of all the summands, reduced with maxCoeff.
+            std::vector< double > maxima(numSums, 0.0);
+            for (int i = 0; i < numCells; ++i) {
+                const unsigned cell_idx = convergence_cells_[i];
+                for (int compIdx = 0; compIdx < numComp; ++compIdx) {
+                    maxima[ compIdx ] = std::max( maxima[ compIdx ], std::abs( ebosResid[cell_idx][compIdx] ) );
+                    maxima[ numComp + compIdx ] = std::max( maxima[ numComp + compIdx ],
+                                                            std::abs( convergence_cell_B_[i * numComp + compIdx] ) );
+                }
+                maxima[ 2 * numComp ] = std::max( maxima[ 2 * numComp ], convergence_pv_[i] );
+            }
+            maxima.insert( maxima.end(), maxCoeff.begin(), maxCoeff.end() );
+            detail::sumAndMax( grid_.comm(), maxima, /*numSum=*/0 );
+            std::copy( maxima.begin() + numSums, maxima.end(), maxCoeff.begin() );
+
+            std::vector< Sum > sums;
+            sums.reserve(numSums);
+            for (int k = 0; k < numSums; ++k) {
+                sums.emplace_back( maxima[k], double( global_nc_ ) );
+            }
+
+#if HAVE_OPENMP
+#pragma omp parallel
+#endif // HAVE_OPENMP
+            {
+                std::vector< Sum > sums_local = sums;
+#if HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif // HAVE_OPENMP
+                for (int i = 0; i < numCells; ++i) {
+                    const unsigned cell_idx = convergence_cells_[i];
+                    for (int compIdx = 0; compIdx < numComp; ++compIdx) {
+                        sums_local[ compIdx ].add( ebosResid[cell_idx][compIdx] );
+                        sums_local[ numComp + compIdx ].add( convergence_cell_B_[i * numComp + compIdx] );
+                    }
+                    sums_local[ 2 * numComp ].add( convergence_pv_[i] );
+                }
+#if HAVE_OPENMP
+#pragma omp critical(reproducibleConvergenceReduction_sum)
+#endif // HAVE_OPENMP
+                for (int k = 0; k < numSums; ++k) {
+                    sums[k].add( sums_local[k] );
+                }
+            }
+
+            // The folds are summed exactly, in any order.
+            if ( isParallel() ) {
+                std::vector< double > buffer;
+                buffer.reserve( numSums * Sum::numFolds );
+                for (auto& sum : sums) {
+                    buffer.insert( buffer.end(), sum.folds().begin(), sum.folds().end() );
+                }
+                detail::sumAndMax( grid_.comm(), buffer, buffer.size() );
+                auto fold = buffer.begin();
+                for (auto& sum : sums) {
+                    std::copy( fold, fold + Sum::numFolds, sum.folds().begin() );
+                    fold += Sum::numFolds;
+                }
+            }
+
+            for (int compIdx = 0; compIdx < numComp; ++compIdx) {
+                R_sum[ compIdx ] = sums[ compIdx ].value();
+                B_avg[ compIdx ] = sums[ numComp + compIdx ].value() / Scalar( global_nc_ );
+            }
+            return sums[ 2 * numComp ].value();
+        }
+
+        /// Collect the interior cells and their pore volumes for the convergence
+        /// check and the fluid in place. The grid and the reference porosities do not change during
+        /// the simulation, so this is only done once.
+        void updateConvergenceCells() const
+        {
+            if (!convergence_cells_.empty()) {
+                return;
+            }
+            const auto& ebosModel = ebosSimulator_.model();
+            const auto& ebosProblem = ebosSimulator_.problem();
+            const auto& elemMapper = ebosModel.elementMapper();
+            const auto& gridView = ebosSimulator().gridView();
+            const auto& elemEndIt = gridView.template end</*codim=*/0, Dune::Interior_Partition>();
+            convergence_pv_sum_ = 0.0;
+            convergence_interior_.assign(ebosModel.numGridDof(), false);
+            for (auto elemIt = gridView.template begin</*codim=*/0, Dune::Interior_Partition>();
+                 elemIt != elemEndIt;
+                 ++elemIt)
+            {
+                const unsigned cell_idx = elemMapper.index(*elemIt);
+                const double pvValue = ebosProblem.porosity(cell_idx) * ebosModel.dofTotalVolume( cell_idx );
+                convergence_cells_.push_back(cell_idx);
+                convergence_pv_.push_back(pvValue);
+                convergence_interior_[cell_idx] = true;
+                convergence_pv_sum_ += pvValue;
+            }
+        }
+
         /// Compute convergence based on total mass balance (tol_mb) and maximum
         /// residual mass balance (tol_cnv).
         /// \param[in]   timer       simulation timer
@@ -837,6 +1787,8 @@ namespace Opm {
         /// \param[in]   iteration   current iteration number
         bool getConvergence(const SimulatorTimerInterface& timer, const int iteration, std::vector<double>& residual_norms)
         {
+            ProfileScope scope("convergence check", KernelCounters::GetConvergence);
+
             typedef std::vector< Scalar > Vector;
 
             const double dt = timer.currentStepLength();
@@ -851,28 +1803,31 @@ namespace Opm {
             Vector maxCoeff(numComp, std::numeric_limits< Scalar >::lowest() );
 
             const auto& ebosModel = ebosSimulator_.model();
-            const auto& ebosProblem = ebosSimulator_.problem();
-
             const auto& ebosResid = ebosSimulator_.model().linearizer().residual();
 
-            ElementContext elemCtx(ebosSimulator_);
-            const auto& gridView = ebosSimulator().gridView();
-            const auto& elemEndIt = gridView.template end</*codim=*/0, Dune::Interior_Partition>();
+            updateConvergenceCells();
 
-            double pvSumLocal = 0.0;
-            for (auto elemIt = gridView.template begin</*codim=*/0, Dune::Interior_Partition>();
-                 elemIt != elemEndIt;
-                 ++elemIt)
-            {
-                const auto& elem = *elemIt;
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-                const unsigned cell_idx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& intQuants = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& fs = intQuants.fluidState();
+            // With reproducible reductions the inverse formation volume factors of
+            // every cell are kept in cellB for the second pass.
+            const bool reproducible = param_.reproducible_reductions_;
+            const int numCells = convergence_cells_.size();
+            if (reproducible) {
+                convergence_cell_B_.resize(numCells * numComp);
+            }
 
-                const double pvValue = ebosProblem.porosity(cell_idx) * ebosModel.dofTotalVolume( cell_idx );
-                pvSumLocal += pvValue;
+            const auto localSum = [&](const unsigned cell_idx, const IntensiveQuantities& intQuants,
+                                      const double pvValue, Vector& R, Vector& B, Vector& M,
+                                      double* cellB) {
+                const auto& fs = intQuants.fluidState();
+                const auto addComponent = [&](const int compIdx, const double b) {
+                    B[ compIdx ] += b;
+                    if (cellB) {
+                        cellB[ compIdx ] = b;
+                    }
+                    const auto R2 = ebosResid[cell_idx][compIdx];
+                    R[ compIdx ] += R2;
+                    M[ compIdx ] = std::max( M[ compIdx ], std::abs( R2 ) / pvValue );
+                };
 
                 for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx)
                 {
@@ -881,68 +1836,126 @@ namespace Opm {
                     }
 
                     const unsigned compIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::solventComponentIndex(phaseIdx));
-
-                    B_avg[ compIdx ] += 1.0 / fs.invB(phaseIdx).value();
-                    const auto R2 = ebosResid[cell_idx][compIdx];
-
-                    R_sum[ compIdx ] += R2;
-                    maxCoeff[ compIdx ] = std::max( maxCoeff[ compIdx ], std::abs( R2 ) / pvValue );
+                    addComponent(compIdx, 1.0 / fs.invB(phaseIdx).value());
                 }
 
                 if ( has_solvent_ ) {
-                    B_avg[ contiSolventEqIdx ] += 1.0 / intQuants.solventInverseFormationVolumeFactor().value();
-                    const auto R2 = ebosResid[cell_idx][contiSolventEqIdx];
-                    R_sum[ contiSolventEqIdx ] += R2;
-                    maxCoeff[ contiSolventEqIdx ] = std::max( maxCoeff[ contiSolventEqIdx ], std::abs( R2 ) / pvValue );
+                    addComponent(contiSolventEqIdx, 1.0 / intQuants.solventInverseFormationVolumeFactor().value());
                 }
                 if (has_polymer_ ) {
-                    B_avg[ contiPolymerEqIdx ] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
-                    const auto R2 = ebosResid[cell_idx][contiPolymerEqIdx];
-                    R_sum[ contiPolymerEqIdx ] += R2;
-                    maxCoeff[ contiPolymerEqIdx ] = std::max( maxCoeff[ contiPolymerEqIdx ], std::abs( R2 ) / pvValue );
+                    addComponent(contiPolymerEqIdx, 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value());
                 }
                 if (has_energy_ ) {
-                    B_avg[ contiEnergyEqIdx ] += 1.0;
-                    const auto R2 = ebosResid[cell_idx][contiEnergyEqIdx];
-                    R_sum[ contiEnergyEqIdx ] += R2;
-                    maxCoeff[ contiEnergyEqIdx ] = std::max( maxCoeff[ contiEnergyEqIdx ], std::abs( R2 ) / pvValue );
+                    addComponent(contiEnergyEqIdx, 1.0);
                 }
+            };
 
-            }
+            const double pvSumLocal = convergence_pv_sum_;
 
-            // compute local average in terms of global number of elements
-            const int bSize = B_avg.size();
-            for ( int i = 0; i<bSize; ++i )
+            // The intensive quantities of the last linearization are cached
+            // by ebos, unless only some cells were relinearized.
+            bool cached = true;
+#if HAVE_OPENMP
+#pragma omp parallel
+#endif // HAVE_OPENMP
             {
-                B_avg[ i ] /= Scalar( global_nc_ );
+                Vector R_local(numComp, 0.0 );
+                Vector B_local(numComp, 0.0 );
+                Vector max_local(numComp, std::numeric_limits< Scalar >::lowest() );
+                bool cached_local = true;
+#if HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif // HAVE_OPENMP
+                for (int i = 0; i < numCells; ++i) {
+                    const unsigned cell_idx = convergence_cells_[i];
+                    const auto* intQuants = ebosModel.cachedIntensiveQuantities(cell_idx, /*timeIdx=*/0);
+                    if (!intQuants) {
+                        cached_local = false;
+                        continue;
+                    }
+                    localSum(cell_idx, *intQuants, convergence_pv_[i], R_local, B_local, max_local,
+                             reproducible ? &convergence_cell_B_[i * numComp] : nullptr);
+                }
+#if HAVE_OPENMP
+#pragma omp critical(getConvergence_sum)
+#endif // HAVE_OPENMP
+                {
+                    cached = cached && cached_local;
+                    for (int compIdx = 0; compIdx < numComp; ++compIdx) {
+                        R_sum[ compIdx ] += R_local[ compIdx ];
+                        B_avg[ compIdx ] += B_local[ compIdx ];
+                        maxCoeff[ compIdx ] = std::max( maxCoeff[ compIdx ], max_local[ compIdx ] );
+                    }
+                }
+            }
+
+            if (!cached) {
+                std::fill(R_sum.begin(), R_sum.end(), 0.0);
+                std::fill(B_avg.begin(), B_avg.end(), 0.0);
+                std::fill(maxCoeff.begin(), maxCoeff.end(), std::numeric_limits< Scalar >::lowest());
+
+                ElementContext elemCtx(ebosSimulator_);
+                const auto& gridView = ebosSimulator().gridView();
+                const auto& elemEndIt = gridView.template end</*codim=*/0, Dune::Interior_Partition>();
+                int i = 0;
+                for (auto elemIt = gridView.template begin</*codim=*/0, Dune::Interior_Partition>();
+                     elemIt != elemEndIt;
+                     ++elemIt, ++i)
+                {
+                    const auto& elem = *elemIt;
+                    elemCtx.updatePrimaryStencil(elem);
+                    elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+                    const unsigned cell_idx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+                    const auto& intQuants = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
+                    localSum(cell_idx, intQuants, convergence_pv_[i], R_sum, B_avg, maxCoeff,
+                             reproducible ? &convergence_cell_B_[i * numComp] : nullptr);
+                }
             }
 
             // TODO: we remove the maxNormWell for now because the convergence of wells are on a individual well basis.
             // Anyway, we need to provide some infromation to help debug the well iteration process.
 
+            double pvSum = 0.0;
+            if (reproducible) {
+                pvSum = reproducibleConvergenceReduction(R_sum, maxCoeff, B_avg);
+            }
+            else {
+                // compute local average in terms of global number of elements
+                const int bSize = B_avg.size();
+                for ( int i = 0; i<bSize; ++i )
+                {
+                    B_avg[ i ] /= Scalar( global_nc_ );
+                }
 
-            // compute global sum and max of quantities
-            const double pvSum = convergenceReduction(grid_.comm(), pvSumLocal,
-                                                      R_sum, maxCoeff, B_avg);
+                // compute global sum and max of quantities
+                pvSum = convergenceReduction(grid_.comm(), pvSumLocal,
+                                             R_sum, maxCoeff, B_avg);
+            }
 
             Vector CNV(numComp);
             Vector mass_balance_residual(numComp);
 
             bool converged_MB = true;
             bool converged_CNV = true;
+            // largest residual relative to its tolerance
+            double scaledResidual = 0.0;
             // Finish computation
             for ( int compIdx = 0; compIdx < numComp; ++compIdx )
             {
                 CNV[compIdx]                    = B_avg[compIdx] * dt * maxCoeff[compIdx];
                 mass_balance_residual[compIdx]  = std::abs(B_avg[compIdx]*R_sum[compIdx]) * dt / pvSum;
                 converged_MB                    = converged_MB && (mass_balance_residual[compIdx] < tol_mb);
-                if (iteration < param_.max_strict_iter_)
-                    converged_CNV = converged_CNV && (CNV[compIdx] < tol_cnv);
-                else
-                    converged_CNV = converged_CNV && (CNV[compIdx] < tol_cnv_relaxed);
+                const double cnvTol = (iteration < param_.max_strict_iter_) ? tol_cnv : tol_cnv_relaxed;
+                converged_CNV = converged_CNV && (CNV[compIdx] < cnvTol);
+
+                scaledResidual = std::max(scaledResidual, mass_balance_residual[compIdx] / tol_mb);
+                scaledResidual = std::max(scaledResidual, CNV[compIdx] / cnvTol);
 
                 residual_norms.push_back(CNV[compIdx]);
             }
+            scaled_residual_history_.push_back(scaledResidual);
+
+            convergence_B_avg_ = B_avg;
 
             const bool converged_Well = wellModel().getWellConvergence(B_avg);
 
@@ -952,54 +1965,57 @@ namespace Opm {
 
             if ( terminal_output_ )
             {
-                // Only rank 0 does print to std::cout
+                // Only rank 0 prints the table, and only formats it if the debug
+                // log is written.
                 if (iteration == 0) {
-                    std::string msg = "Iter";
-
-                    std::vector< std::string > key( numComp );
-                    for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
-                        if (!FluidSystem::phaseIsActive(phaseIdx)) {
-                            continue;
+                    deferred_logger_.lazyDebug([&]() {
+                        std::string msg = "Iter";
+
+                        std::vector< std::string > key( numComp );
+                        for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
+                            if (!FluidSystem::phaseIsActive(phaseIdx)) {
+                                continue;
+                            }
+
+                            const unsigned canonicalCompIdx = FluidSystem::solventComponentIndex(phaseIdx);
+                            const std::string& compName = FluidSystem::componentName(canonicalCompIdx);
+                            const unsigned compIdx = Indices::canonicalToActiveComponentIndex(canonicalCompIdx);
+                            key[ compIdx ] = std::toupper( compName.front() );
+                        }
+                        if (has_solvent_) {
+                            key[ solventSaturationIdx ] = "S";
                         }
 
-                        const unsigned canonicalCompIdx = FluidSystem::solventComponentIndex(phaseIdx);
-                        const std::string& compName = FluidSystem::componentName(canonicalCompIdx);
-                        const unsigned compIdx = Indices::canonicalToActiveComponentIndex(canonicalCompIdx);
-                        key[ compIdx ] = std::toupper( compName.front() );
-                    }
-                    if (has_solvent_) {
-                        key[ solventSaturationIdx ] = "S";
-                    }
-
-                    if (has_polymer_) {
-                        key[ polymerConcentrationIdx ] = "P";
-                    }
+                        if (has_polymer_) {
+                            key[ polymerConcentrationIdx ] = "P";
+                        }
 
-                    if (has_energy_) {
-                        key[ temperatureIdx ] = "E";
-                    }
+                        if (has_energy_) {
+                            key[ temperatureIdx ] = "E";
+                        }
 
+                        for (int compIdx = 0; compIdx < numComp; ++compIdx) {
+                            msg += "    MB(" + key[ compIdx ] + ")  ";
+                        }
+                        for (int compIdx = 0; compIdx < numComp; ++compIdx) {
+                            msg += "    CNV(" + key[ compIdx ] + ") ";
+                        }
+                        return msg;
+                    });
+                }
+                deferred_logger_.lazyDebug([&]() {
+                    std::ostringstream ss;
+                    ss.precision(3);
+                    ss.setf(std::ios::scientific);
+                    ss << std::setw(4) << iteration;
                     for (int compIdx = 0; compIdx < numComp; ++compIdx) {
-                        msg += "    MB(" + key[ compIdx ] + ")  ";
+                        ss << std::setw(11) << mass_balance_residual[compIdx];
                     }
                     for (int compIdx = 0; compIdx < numComp; ++compIdx) {
-                        msg += "    CNV(" + key[ compIdx ] + ") ";
+                        ss << std::setw(11) << CNV[compIdx];
                     }
-                    OpmLog::debug(msg);
-                }
-                std::ostringstream ss;
-                const std::streamsize oprec = ss.precision(3);
-                const std::ios::fmtflags oflags = ss.setf(std::ios::scientific);
-                ss << std::setw(4) << iteration;
-                for (int compIdx = 0; compIdx < numComp; ++compIdx) {
-                    ss << std::setw(11) << mass_balance_residual[compIdx];
-                }
-                for (int compIdx = 0; compIdx < numComp; ++compIdx) {
-                    ss << std::setw(11) << CNV[compIdx];
-                }
-                ss.precision(oprec);
-                ss.flags(oflags);
-                OpmLog::debug(ss.str());
+                    return ss.str();
+                });
             }
 
             for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
@@ -1042,14 +2058,124 @@ namespace Opm {
             return computeFluidInPlace(fipnum);
         }
 
-        /// Should not be called
+        /// Compute the fluid in place of the regions of fipnum.
+        /// \param[in]    fipnum    FIPNUM of the active cells, 0 for no region.
+        /// \return The values of each region, ordered as FIPDataEnums::FipId.
+        ///
+        /// The intensive quantities cached by the last linearization are
+        /// reduced in a thread parallel loop over the interior cells, followed
+        /// by a single global sum of all regions.
         std::vector<std::vector<double> >
-        computeFluidInPlace(const std::vector<int>& /*fipnum*/) const
-        {            
-            //assert(true)
-            //return an empty vector
-            std::vector<std::vector<double> > regionValues(0, std::vector<double>(0,0.0));
-            return regionValues;
+        computeFluidInPlace(const std::vector<int>& fipnum) const
+        {
+            using FIP = FIPDataEnums;
+
+            int dims = fipnum.empty() ? 0 : *std::max_element(fipnum.begin(), fipnum.end());
+            if (isParallel()) {
+                dims = grid_.comm().max(dims);
+            }
+
+            updateConvergenceCells();
+
+            const auto& ebosModel = ebosSimulator_.model();
+            const bool oil = FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx);
+            const bool gas = FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx);
+            const bool water = FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx);
+            const unsigned pressurePhaseIdx = oil ? FluidSystem::oilPhaseIdx
+                : (gas ? FluidSystem::gasPhaseIdx : FluidSystem::waterPhaseIdx);
+
+            // The fluid volumes use the pressure dependent pore volume, the pore
+            // volumes and the average pressures the reference one.
+            const auto addCell = [&](const unsigned cell_idx, const IntensiveQuantities& intQuants,
+                                     const int region, const double pv, detail::RegionFluidInPlace& sums) {
+                const auto& fs = intQuants.fluidState();
+                const double pvMult = intQuants.porosity().value() * ebosModel.dofTotalVolume(cell_idx);
+                double fip[FIP::FIP_PV] = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+                double hydrocarbon = 0.0;
+                if (water) {
+                    fip[FIP::FIP_AQUA] = pvMult * fs.saturation(FluidSystem::waterPhaseIdx).value()
+                        * fs.invB(FluidSystem::waterPhaseIdx).value();
+                }
+                if (oil) {
+                    const double so = fs.saturation(FluidSystem::oilPhaseIdx).value();
+                    fip[FIP::FIP_LIQUID] = pvMult * so * fs.invB(FluidSystem::oilPhaseIdx).value();
+                    hydrocarbon += so;
+                    if (gas) {
+                        fip[FIP::FIP_DISSOLVED_GAS] = fs.Rs().value() * fip[FIP::FIP_LIQUID];
+                    }
+                }
+                if (gas) {
+                    const double sg = fs.saturation(FluidSystem::gasPhaseIdx).value();
+                    fip[FIP::FIP_VAPOUR] = pvMult * sg * fs.invB(FluidSystem::gasPhaseIdx).value();
+                    hydrocarbon += sg;
+                    if (oil) {
+                        fip[FIP::FIP_VAPORIZED_OIL] = fs.Rv().value() * fip[FIP::FIP_VAPOUR];
+                    }
+                }
+                sums.add(region, fip, pv, hydrocarbon, fs.pressure(pressurePhaseIdx).value());
+            };
+
+            detail::RegionFluidInPlace sums(dims);
+            const int numCells = convergence_cells_.size();
+            bool cached = true;
+#if HAVE_OPENMP
+#pragma omp parallel
+#endif // HAVE_OPENMP
+            {
+                detail::RegionFluidInPlace sums_local(dims);
+                bool cached_local = true;
+#if HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif // HAVE_OPENMP
+                for (int i = 0; i < numCells; ++i) {
+                    const unsigned cell_idx = convergence_cells_[i];
+                    const int region = fipnum[cell_idx] - 1;
+                    if (region < 0) {
+                        continue;
+                    }
+                    const auto* intQuants = ebosModel.cachedIntensiveQuantities(cell_idx, /*timeIdx=*/0);
+                    if (!intQuants) {
+                        cached_local = false;
+                        continue;
+                    }
+                    addCell(cell_idx, *intQuants, region, convergence_pv_[i], sums_local);
+                }
+#if HAVE_OPENMP
+#pragma omp critical(computeFluidInPlace_sum)
+#endif // HAVE_OPENMP
+                {
+                    cached = cached && cached_local;
+                    sums.add(sums_local);
+                }
+            }
+
+            if (!cached) {
+                sums.clear();
+                ElementContext elemCtx(ebosSimulator_);
+                const auto& gridView = ebosSimulator_.gridView();
+                const auto& elemEndIt = gridView.template end</*codim=*/0, Dune::Interior_Partition>();
+                int i = 0;
+                for (auto elemIt = gridView.template begin</*codim=*/0, Dune::Interior_Partition>();
+                     elemIt != elemEndIt;
+                     ++elemIt, ++i)
+                {
+                    const unsigned cell_idx = convergence_cells_[i];
+                    const int region = fipnum[cell_idx] - 1;
+                    if (region < 0) {
+                        continue;
+                    }
+                    elemCtx.updatePrimaryStencil(*elemIt);
+                    elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+                    addCell(cell_idx, elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0),
+                            region, convergence_pv_[i], sums);
+                }
+            }
+
+            if (isParallel()) {
+                grid_.comm().sum(sums.sums().data(), sums.sums().size());
+            }
+
+            return sums.values();
         }
 
         const Simulator& ebosSimulator() const
@@ -1077,9 +2203,11 @@ namespace Opm {
         const PhaseUsage phaseUsage_;
         const bool has_disgas_;
         const bool has_vapoil_;
-        const bool has_solvent_;
-        const bool has_polymer_;
-        const bool has_energy_;
+        // known at compile time, such that the branches of the disabled
+        // models vanish from the loops over the cells
+        static const bool has_solvent_ = GET_PROP_VALUE(TypeTag, EnableSolvent);
+        static const bool has_polymer_ = GET_PROP_VALUE(TypeTag, EnablePolymer);
+        static const bool has_energy_ = GET_PROP_VALUE(TypeTag, EnableEnergy);
 
         ModelParameters                 param_;
         SimulatorReport failureReport_;
@@ -1092,15 +2220,78 @@ namespace Opm {
 
         /// \brief Whether we print something to std::cout
         bool terminal_output_;
+        // the messages of the current time step, logged at its end
+        DeferredLogger deferred_logger_{ grid_.comm() };
         /// \brief The number of cells of the global grid.
         long int global_nc_;
 
         std::vector<std::vector<double>> residual_norms_history_;
+        // the largest residual relative to its tolerance for each Newton iteration
+        std::vector<double> scaled_residual_history_;
+        // the relative linear reduction of the last Newton iteration
+        double linear_solver_reduction_;
         double current_relaxation_;
         BVector dx_old_;
-
+        BVector newton_update_;
+        // The sums of relativeChange() over the interior cells, accumulated by the
+        // last updateState() and reduced over the processes by the convergence
+        // check that followed it. Invalid if the solution changed otherwise.
+        enum class RelativeChangeState { Invalid, Local, Global };
+        RelativeChangeState relative_change_state_;
+        Scalar relative_change_sums_[2];
+        // the linear solutions of the last two Newton iterations of the time step,
+        // for linear_solver_initial_guess
+        BVector linear_solution_last_;
+        BVector linear_solution_before_last_;
+        int linear_solutions_kept_;
+
+        // the reservoir matrix with the well contributions C^T D^-1 B added,
+        // for the preconditioner only
         std::unique_ptr<Mat> matrix_for_preconditioner_;
 
+        // the linearization of the reservoir equations of the last assembly and
+        // the cells to relinearize in the next one if the assembly is localized
+        std::unique_ptr<Mat> reservoir_jacobian_;
+        // the number of consecutive assemblies that reused reservoir_jacobian_
+        int jacobian_reuses_ = 0;
+        BVector reservoir_residual_;
+        std::vector<bool> unconverged_cells_;
+        std::vector<bool> active_cells_;
+        std::size_t num_active_cells_ = 0;
+        // the update of the primary variables applied by the last updateState(),
+        // after the chopping, the stabilization and the line search
+        BVector applied_update_;
+        // the average inverse formation volume factors of the last convergence check
+        std::vector<Scalar> convergence_B_avg_;
+        // the interior cells in the order of the grid, their pore volumes and
+        // the sum of these, see updateConvergenceCells(); also used for the
+        // fluid in place
+        mutable std::vector<unsigned> convergence_cells_;
+        mutable std::vector<double> convergence_pv_;
+        // whether a cell is one of the convergence_cells_
+        mutable std::vector<bool> convergence_interior_;
+        mutable double convergence_pv_sum_ = 0.0;
+        // the inverse formation volume factors of the components of the interior
+        // cells, kept by the convergence check with reproducible reductions
+        std::vector<double> convergence_cell_B_;
+
+        // the solution and the switched cells before the last update, and the
+        // residual evaluated by the line search
+        SolutionVector solution_before_update_;
+        std::vector<bool> was_switched_before_update_;
+        BVector line_search_residual_;
+        bool line_search_unsupported_logged_ = false;
+
+        // the pressure or transport system of the last sequential sweep
+        std::unique_ptr<Mat> sequential_matrix_;
+        BVector sequential_residual_;
+
+        // the start times and solutions of the last time steps used by extrapolateSolution()
+        std::deque<std::pair<double, SolutionVector> > solution_history_;
+
+        // the bytes of the Jacobian and of the copies of it kept by the model
+        MemoryAccounting::Account matrix_memory_{ MemoryAccounting::Matrix };
+
     public:
         /// return the StandardWells object
         BlackoilWellModel<TypeTag>&
@@ -1115,15 +2306,40 @@ namespace Opm {
         void beginReportStep()
         {
             ebosSimulator_.problem().beginEpisode();
+            istlSolver().beginReportStep();
         }
 
         void endReportStep()
         {
             ebosSimulator_.problem().endEpisode();
+            // the messages of the failed time steps
+            deferred_logger_.logMessages();
         }
 
     private:
 
+        // Copy a matrix into the storage of a previous copy. Only the values
+        // are copied if the row sizes and column indices of the previous copy
+        // are the same, otherwise the copy is reallocated, since the
+        // assignment of a BCRSMatrix always reallocates.
+        static void copyMatrix(const Mat& from, std::unique_ptr<Mat>& to)
+        {
+            if (!to || !detail::samePattern(from, *to)) {
+                to.reset(new Mat(from));
+                return;
+            }
+            copyMatrixValues(from, *to);
+        }
+
+        // Copy the values of a matrix into a matrix of the same sparsity pattern.
+        static void copyMatrixValues(const Mat& from, Mat& to)
+        {
+            auto toRow = to.begin();
+            for (auto row = from.begin(); row != from.end(); ++row, ++toRow) {
+                std::copy(row->begin(), row->end(), toRow->begin());
+            }
+        }
+
         double dpMaxRel() const { return param_.dp_max_rel_; }
         double dsMax() const { return param_.ds_max_; }
         double drMaxRel() const { return param_.dr_max_rel_; }
@@ -68,6 +68,29 @@ namespace Opm
         deck_file_name_ = param.template get<std::string>("deck_filename");
         matrix_add_well_contributions_ = param.getDefault("matrix_add_well_contributions", matrix_add_well_contributions_);
         preconditioner_add_well_contributions_ = param.getDefault("preconditioner_add_well_contributions", preconditioner_add_well_contributions_);
+        parallel_well_assembly_ = param.getDefault("parallel_well_assembly", parallel_well_assembly_);
+        freeze_converged_wells_ = param.getDefault("freeze_converged_wells", freeze_converged_wells_);
+        tolerance_well_potentials_ = param.getDefault("tolerance_well_potentials", tolerance_well_potentials_);
+        tolerance_well_connection_pressures_ = param.getDefault("tolerance_well_connection_pressures", tolerance_well_connection_pressures_);
+        reuse_intensive_quantities_after_chop_ = param.getDefault("reuse_intensive_quantities_after_chop", reuse_intensive_quantities_after_chop_);
+        solution_extrapolation_order_ = param.getDefault("solution_extrapolation_order", solution_extrapolation_order_);
+        linear_solver_adaptive_reduction_ = param.getDefault("linear_solver_adaptive_reduction", linear_solver_adaptive_reduction_);
+        linear_solver_reduction_min_ = param.getDefault("linear_solver_reduction_min", linear_solver_reduction_min_);
+        linear_solver_reduction_max_ = param.getDefault("linear_solver_reduction_max", linear_solver_reduction_max_);
+        linear_solver_initial_guess_ = param.getDefault("linear_solver_initial_guess", linear_solver_initial_guess_);
+        linear_solver_initial_guess_scale_ = param.getDefault("linear_solver_initial_guess_scale", linear_solver_initial_guess_scale_);
+        localized_assembly_ = param.getDefault("localized_assembly", localized_assembly_);
+        localized_assembly_tolerance_ = param.getDefault("localized_assembly_tolerance", localized_assembly_tolerance_);
+        localized_assembly_max_fraction_ = param.getDefault("localized_assembly_max_fraction", localized_assembly_max_fraction_);
+        sequential_sweeps_ = param.getDefault("sequential_sweeps", sequential_sweeps_);
+        sequential_transport_sweeps_ = param.getDefault("sequential_transport_sweeps", sequential_transport_sweeps_);
+        rate_conversion_well_cells_only_ = param.getDefault("rate_conversion_well_cells_only", rate_conversion_well_cells_only_);
+        reproducible_reductions_ = param.getDefault("reproducible_reductions", reproducible_reductions_);
+        line_search_max_iter_ = param.getDefault("line_search_max_iter", line_search_max_iter_);
+        modified_newton_ = param.getDefault("modified_newton", modified_newton_);
+        modified_newton_max_ratio_ = param.getDefault("modified_newton_max_ratio", modified_newton_max_ratio_);
+        modified_newton_max_reuse_ = param.getDefault("modified_newton_max_reuse", modified_newton_max_reuse_);
+        compact_static_data_ = param.getDefault("compact_static_data", compact_static_data_);
     }
 
 
@@ -99,6 +122,29 @@ namespace Opm
         use_multisegment_well_ = false;
         matrix_add_well_contributions_ = false;
         preconditioner_add_well_contributions_ = false;
+        parallel_well_assembly_ = false;
+        freeze_converged_wells_ = false;
+        tolerance_well_potentials_ = 0.0;
+        tolerance_well_connection_pressures_ = 0.0;
+        reuse_intensive_quantities_after_chop_ = false;
+        solution_extrapolation_order_ = 0;
+        linear_solver_adaptive_reduction_ = false;
+        linear_solver_reduction_min_ = 1e-3;
+        linear_solver_reduction_max_ = 0.1;
+        linear_solver_initial_guess_ = 0;
+        linear_solver_initial_guess_scale_ = 1.0;
+        localized_assembly_ = false;
+        localized_assembly_tolerance_ = 0.1;
+        localized_assembly_max_fraction_ = 0.5;
+        sequential_sweeps_ = 0;
+        sequential_transport_sweeps_ = 1;
+        rate_conversion_well_cells_only_ = false;
+        reproducible_reductions_ = false;
+        line_search_max_iter_ = 0;
+        modified_newton_ = false;
+        modified_newton_max_ratio_ = 0.5;
+        modified_newton_max_reuse_ = 3;
+        compact_static_data_ = false;
     }
 
 
@@ -99,6 +99,97 @@ namespace Opm
         // Whether to add influences of wells between cells to the preconditioner matrix only
         bool preconditioner_add_well_contributions_;
 
+        /// Whether to assemble the well equations of different wells in parallel threads.
+        /// Wells sharing perforated cells are never assembled at the same time.
+        bool parallel_well_assembly_;
+
+        /// Whether to stop assembling and updating the wells that have converged
+        /// while solving the well equations with fixed reservoir state.
+        bool freeze_converged_wells_;
+
+        /// Relative change of the perforation pressures and mobilities of a well
+        /// below which its cached well potentials are reused.
+        double tolerance_well_potentials_;
+
+        /// Relative change of the perforation pressures and rates of a well below
+        /// which its connection densities and pressure differences are reused.
+        double tolerance_well_connection_pressures_;
+
+        /// Whether a time step that is retried after a chop starts from the intensive
+        /// quantities cached for the previous time level instead of recomputing them.
+        /// Changes of the problem made at the end of the failed step (e.g. hysteresis
+        /// or the maximum oil saturation) are then not seen by the first iteration.
+        bool reuse_intensive_quantities_after_chop_;
+
+        /// Order of the extrapolation in time of the primary variables of the last
+        /// converged time steps used as initial guess of a time step: 0 (no
+        /// extrapolation, start from the last solution), 1 (linear) or 2 (quadratic).
+        int solution_extrapolation_order_;
+
+        /// Whether the relative reduction of the linear residual in each Newton
+        /// iteration is chosen from the decrease of the nonlinear residual
+        /// (Eisenstat-Walker), instead of the fixed linear_solver_reduction.
+        bool linear_solver_adaptive_reduction_;
+        /// Smallest relative reduction of the adaptive linear tolerance.
+        double linear_solver_reduction_min_;
+        /// Largest relative reduction of the adaptive linear tolerance, used in the
+        /// first Newton iteration.
+        double linear_solver_reduction_max_;
+
+        /// Initial guess of the linear solves of the later Newton iterations of a
+        /// time step: 0 (zero), 1 (the last linear solution scaled by
+        /// linear_solver_initial_guess_scale) or 2 (the last linear solution scaled
+        /// by the ratio of the last two). A guess is only used if its residual is
+        /// below that of the zero guess.
+        int linear_solver_initial_guess_;
+        /// Scaling of the last linear solution for linear_solver_initial_guess=1.
+        double linear_solver_initial_guess_scale_;
+
+        /// Whether the reservoir equations are only relinearized for the cells that
+        /// have not converged and their neighbours in the later Newton iterations.
+        bool localized_assembly_;
+        /// A cell has converged if its residual is below this fraction of the CNV
+        /// tolerance and its last update below this fraction of dp_max_rel and ds_max.
+        double localized_assembly_tolerance_;
+        /// The assembly is localized only if fewer than this fraction of the cells are active.
+        double localized_assembly_max_fraction_;
+
+        /// Number of sequential pressure and transport sweeps before the fully implicit
+        /// Newton iterations of each time step, zero to solve fully implicitly only.
+        int sequential_sweeps_;
+        /// Number of transport solves following the pressure solve of a sweep.
+        int sequential_transport_sweeps_;
+
+        /// Whether the average hydrocarbon state used to convert between surface
+        /// and reservoir rates is taken over the cells perforated by the wells
+        /// only, instead of all the cells of the (field) region.
+        bool rate_conversion_well_cells_only_;
+
+        /// Whether the global sums of the convergence check are computed such that
+        /// they do not depend on the number of processes and threads, at the cost of
+        /// a second pass over the cells and a larger global reduction.
+        bool reproducible_reductions_;
+
+        /// Maximum number of times the Newton update is halved when the residual,
+        /// evaluated without linearization, does not decrease. Zero for no line search.
+        /// The line search is skipped if some well, e.g. a multisegment well, cannot
+        /// evaluate its inflow without assembly.
+        int line_search_max_iter_;
+
+        /// Whether a Newton iteration may keep the Jacobian of the reservoir equations
+        /// of the last one and only evaluate their residual (modified Newton).
+        bool modified_newton_;
+        /// The Jacobian is only kept if the scaled residual of the last iteration
+        /// decreased by at least this factor.
+        double modified_newton_max_ratio_;
+        /// Maximum number of consecutive iterations that keep the Jacobian.
+        int modified_newton_max_reuse_;
+
+        /// Whether static cell data that does not enter the Jacobian with full
+        /// sensitivity, such as the cell depths used by the wells, is stored in
+        /// single precision to reduce memory.
+        bool compact_static_data_;
+
         /// Construct from user parameters or defaults.
         explicit BlackoilModelParameters( const ParameterGroup& param );
 
@@ -27,6 +27,7 @@
 
 #include <opm/core/props/BlackoilPropertiesInterface.hpp>
 #include <opm/core/props/BlackoilPhases.hpp>
+#include <opm/core/utility/OmpExceptionGuard.hpp>
 #include <opm/parser/eclipse/Units/Units.hpp>
 #include <opm/grid/utility/extractPvtTableIndex.hpp>
 
@@ -38,6 +39,9 @@
 
 #include <opm/common/ErrorMacros.hpp>
 
+#include <cmath>
+#include <limits>
+
 namespace Opm
 {
     // Making these typedef to make the code more readable.
@@ -45,6 +49,93 @@ namespace Opm
     typedef BlackoilPropsAdFromDeck::V V;
     typedef Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> Block;
 
+    namespace {
+        /// Calls f(i) for all cells i in [0, n), on all OpenMP threads if
+        /// available. The evaluations of the cells are independent, and the
+        /// first exception thrown by f is rethrown after the loop.
+        template <class Function>
+        void forEachCell(const int n, const Function& f)
+        {
+            detail::OmpExceptionGuard guard;
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
+            for (int i = 0; i < n; ++i) {
+                try {
+                    f(i);
+                }
+                catch (...) {
+                    guard.capture();
+                }
+            }
+            guard.rethrow();
+        }
+
+        unsigned char phaseBits(const PhasePresence& cond)
+        {
+            return (cond.hasFreeWater() ? 1 : 0) | (cond.hasFreeOil() ? 2 : 0) | (cond.hasFreeGas() ? 4 : 0);
+        }
+    } // anonymous namespace
+
+    template <class Function>
+    void BlackoilPropsAdFromDeck::evaluatePvt(const CachedProperty property,
+                                              const Cells& cells,
+                                              const V& p,
+                                              const V* T,
+                                              const V* r,
+                                              const std::vector<PhasePresence>* cond,
+                                              V& value,
+                                              V& dvaldp,
+                                              V* dvaldr,
+                                              const Function& evaluate) const
+    {
+        const int n = cells.size();
+        if (property_cache_tolerance_ <= 0.0) {
+            forEachCell(n, evaluate);
+            return;
+        }
+
+        PropertyCache& cache = property_cache_[property];
+        if (cache.cells != cells) {
+            // the NaN inputs never match, such that all cells are evaluated
+            cache.cells = cells;
+            cache.inputs.assign(3*n, std::numeric_limits<double>::quiet_NaN());
+            cache.phases.assign(n, 0);
+            cache.results.assign(3*n, 0.0);
+        }
+
+        const double tol = property_cache_tolerance_;
+        auto unchanged = [tol](const double x, const double cached) {
+            return std::abs(x - cached) <= tol * std::abs(cached);
+        };
+        forEachCell(n, [&](const int i) {
+            const double pi = p[i];
+            const double Ti = T ? (*T)[i] : 0.0;
+            const double ri = (r && r->size() > 0) ? (*r)[i] : 0.0;
+            const unsigned char phases = cond ? phaseBits((*cond)[i]) : 0;
+            double* inputs = &cache.inputs[3*i];
+            double* results = &cache.results[3*i];
+            if (cache.phases[i] == phases && unchanged(pi, inputs[0])
+                && unchanged(Ti, inputs[1]) && unchanged(ri, inputs[2])) {
+                value[i] = results[0];
+                dvaldp[i] = results[1];
+                if (dvaldr) {
+                    (*dvaldr)[i] = results[2];
+                }
+                return;
+            }
+
+            evaluate(i);
+            inputs[0] = pi;
+            inputs[1] = Ti;
+            inputs[2] = ri;
+            cache.phases[i] = phases;
+            results[0] = value[i];
+            results[1] = dvaldp[i];
+            results[2] = dvaldr ? (*dvaldr)[i] : 0.0;
+        });
+    }
+
     /// Constructor wrapping an opm-core black oil interface.
     BlackoilPropsAdFromDeck::BlackoilPropsAdFromDeck(const Opm::Deck& deck,
                                                      const Opm::EclipseState& eclState,
@@ -132,6 +223,7 @@ BlackoilPropsAdFromDeck::BlackoilPropsAdFromDeck(const BlackoilPropsAdFromDeck&
     vap1_             = props.vap1_;
     vap2_             = props.vap2_;
     vap_satmax_guard_ = props.vap_satmax_guard_;
+    property_cache_tolerance_ = props.property_cache_tolerance_;
     // For data that is dependant on the subgrid we simply allocate space
     // and initialize with obviously bogus numbers.
     cellPvtRegionIdx_.resize(number_of_cells, std::numeric_limits<int>::min());
@@ -276,21 +368,17 @@ BlackoilPropsAdFromDeck::BlackoilPropsAdFromDeck(const BlackoilPropsAdFromDeck&
 
         typedef Opm::DenseAd::Evaluation<double, /*size=*/1> Eval;
 
-        Eval pEval = 0.0;
-        Eval TEval = 0.0;
-
-        pEval.setDerivative(0, 1.0);
-
-        for (int i = 0; i < n; ++i) {
+        evaluatePvt(MuWat, cells, pw.value(), &T.value(), nullptr, nullptr, mu, dmudp, nullptr, [&](const int i) {
             unsigned pvtRegionIdx = cellPvtRegionIdx_[cells[i]];
-            pEval.setValue(pw.value()[i]);
-            TEval.setValue(T.value()[i]);
+            Eval pEval = pw.value()[i];
+            pEval.setDerivative(0, 1.0);
+            const Eval TEval = T.value()[i];
 
             const Eval& muEval = FluidSystem::waterPvt().viscosity(pvtRegionIdx, TEval, pEval);
 
             mu[i] = muEval.value();
             dmudp[i] = muEval.derivative(0);
-        }
+        });
 
         if (pw.derivative().empty()) {
             return ADB::constant(std::move(mu));
@@ -329,19 +417,16 @@ BlackoilPropsAdFromDeck::BlackoilPropsAdFromDeck(const BlackoilPropsAdFromDeck&
 
         typedef Opm::DenseAd::Evaluation<double, /*size=*/2> Eval;
 
-        Eval pEval = 0.0;
-        Eval TEval = 0.0;
-        Eval RsEval = 0.0;
-
-        pEval.setDerivative(0, 1.0);
-        RsEval.setDerivative(1, 1.0);
-
-        Eval muEval;
-        for (int i = 0; i < n; ++i) {
+        evaluatePvt(MuOil, cells, po.value(), &T.value(), phase_usage_.phase_used[Gas] ? &rs.value() : nullptr,
+                    &cond, mu, dmudp, &dmudr, [&](const int i) {
             unsigned pvtRegionIdx = cellPvtRegionIdx_[cells[i]];
-            pEval.setValue(po.value()[i]);
-            TEval.setValue(T.value()[i]);
+            Eval pEval = po.value()[i];
+            pEval.setDerivative(0, 1.0);
+            const Eval TEval = T.value()[i];
+            Eval RsEval = 0.0;
+            RsEval.setDerivative(1, 1.0);
 
+            Eval muEval;
             if (cond[i].hasFreeGas()) {
                 muEval = FluidSystem::oilPvt().saturatedViscosity(pvtRegionIdx, TEval, pEval);
             }
@@ -355,7 +440,7 @@ BlackoilPropsAdFromDeck::BlackoilPropsAdFromDeck(const BlackoilPropsAdFromDeck&
             mu[i] = muEval.value();
             dmudp[i] = muEval.derivative(0);
             dmudr[i] = muEval.derivative(1);
-        }
+        });
 
         ADB::M dmudp_diag(dmudp.matrix().asDiagonal());
         ADB::M dmudr_diag(dmudr.matrix().asDiagonal());
@@ -396,19 +481,15 @@ BlackoilPropsAdFromDeck::BlackoilPropsAdFromDeck(const BlackoilPropsAdFromDeck&
 
         typedef Opm::DenseAd::Evaluation<double, /*size=*/2> Eval;
 
-        Eval pEval = 0.0;
-        Eval TEval = 0.0;
-        Eval RvEval = 0.0;
-        Eval muEval;
-
-        pEval.setDerivative(0, 1.0);
-        RvEval.setDerivative(1, 1.0);
-
-        for (int i = 0; i < n; ++i) {
+        evaluatePvt(MuGas, cells, pg.value(), &T.value(), &rv.value(), &cond, mu, dmudp, &dmudr, [&](const int i) {
             unsigned pvtRegionIdx = cellPvtRegionIdx_[cells[i]];
-            pEval.setValue(pg.value()[i]);
-            TEval.setValue(T.value()[i]);
+            Eval pEval = pg.value()[i];
+            pEval.setDerivative(0, 1.0);
+            const Eval TEval = T.value()[i];
+            Eval RvEval = 0.0;
+            RvEval.setDerivative(1, 1.0);
 
+            Eval muEval;
             if (cond[i].hasFreeOil()) {
                 muEval = FluidSystem::gasPvt().saturatedViscosity(pvtRegionIdx, TEval, pEval);
             }
@@ -420,7 +501,7 @@ BlackoilPropsAdFromDeck::BlackoilPropsAdFromDeck(const BlackoilPropsAdFromDeck&
             mu[i] = muEval.value();
             dmudp[i] = muEval.derivative(0);
             dmudr[i] = muEval.derivative(1);
-        }
+        });
 
         ADB::M dmudp_diag(dmudp.matrix().asDiagonal());
         ADB::M dmudr_diag(dmudr.matrix().asDiagonal());
@@ -460,20 +541,17 @@ BlackoilPropsAdFromDeck::BlackoilPropsAdFromDeck(const BlackoilPropsAdFromDeck&
 
         typedef Opm::DenseAd::Evaluation<double, /*size=*/1> Eval;
 
-        Eval pEval = 0.0;
-        Eval TEval = 0.0;
-
-        pEval.setDerivative(0, 1.0);
-        for (int i = 0; i < n; ++i) {
+        evaluatePvt(BWat, cells, pw.value(), &T.value(), nullptr, nullptr, b, dbdp, nullptr, [&](const int i) {
             unsigned pvtRegionIdx = cellPvtRegionIdx_[cells[i]];
-            pEval.setValue(pw.value()[i]);
-            TEval.setValue(T.value()[i]);
+            Eval pEval = pw.value()[i];
+            pEval.setDerivative(0, 1.0);
+            const Eval TEval = T.value()[i];
 
             const Eval& bEval = FluidSystem::waterPvt().inverseFormationVolumeFactor(pvtRegionIdx, TEval, pEval);
 
             b[i] = bEval.value();
             dbdp[i] = bEval.derivative(0);
-        }
+        });
 
         ADB::M dbdp_diag(dbdp.matrix().asDiagonal());
         const int num_blocks = pw.numBlocks();
@@ -509,20 +587,16 @@ BlackoilPropsAdFromDeck::BlackoilPropsAdFromDeck(const BlackoilPropsAdFromDeck&
 
         typedef Opm::DenseAd::Evaluation<double, /*size=*/2> Eval;
 
-        Eval pEval = 0.0;
-        Eval TEval = 0.0;
-        Eval RsEval = 0.0;
-        Eval bEval;
-
-        pEval.setDerivative(0, 1.0);
-        RsEval.setDerivative(1, 1.0);
-
-        for (int i = 0; i < n; ++i) {
+        evaluatePvt(BOil, cells, po.value(), &T.value(), &rs.value(), &cond, b, dbdp, &dbdr, [&](const int i) {
             unsigned pvtRegionIdx = cellPvtRegionIdx_[cells[i]];
-            pEval.setValue(po.value()[i]);
-            TEval.setValue(T.value()[i]);
+            Eval pEval = po.value()[i];
+            pEval.setDerivative(0, 1.0);
+            const Eval TEval = T.value()[i];
+            Eval RsEval = 0.0;
+            RsEval.setDerivative(1, 1.0);
 
             //RS/RV only makes sense when gas phase is active
+            Eval bEval;
             if (cond[i].hasFreeGas()) {
                 bEval = FluidSystem::oilPvt().saturatedInverseFormationVolumeFactor(pvtRegionIdx, TEval, pEval);
             }
@@ -539,7 +613,7 @@ BlackoilPropsAdFromDeck::BlackoilPropsAdFromDeck(const BlackoilPropsAdFromDeck&
             b[i] = bEval.value();
             dbdp[i] = bEval.derivative(0);
             dbdr[i] = bEval.derivative(1);
-        }
+        });
 
         ADB::M dbdp_diag(dbdp.matrix().asDiagonal());
         ADB::M dbdr_diag(dbdr.matrix().asDiagonal());
@@ -582,19 +656,15 @@ BlackoilPropsAdFromDeck::BlackoilPropsAdFromDeck(const BlackoilPropsAdFromDeck&
 
         typedef Opm::DenseAd::Evaluation<double, /*size=*/2> Eval;
 
-        Eval pEval = 0.0;
-        Eval TEval = 0.0;
-        Eval RvEval = 0.0;
-        Eval bEval;
-
-        pEval.setDerivative(0, 1.0);
-        RvEval.setDerivative(1, 1.0);
-
-        for (int i = 0; i < n; ++i) {
+        evaluatePvt(BGas, cells, pg.value(), &T.value(), &rv.value(), &cond, b, dbdp, &dbdr, [&](const int i) {
             unsigned pvtRegionIdx = cellPvtRegionIdx_[cells[i]];
-            pEval.setValue(pg.value()[i]);
-            TEval.setValue(T.value()[i]);
+            Eval pEval = pg.value()[i];
+            pEval.setDerivative(0, 1.0);
+            const Eval TEval = T.value()[i];
+            Eval RvEval = 0.0;
+            RvEval.setDerivative(1, 1.0);
 
+            Eval bEval;
             if (cond[i].hasFreeOil()) {
                 bEval = FluidSystem::gasPvt().saturatedInverseFormationVolumeFactor(pvtRegionIdx, TEval, pEval);
             }
@@ -606,7 +676,7 @@ BlackoilPropsAdFromDeck::BlackoilPropsAdFromDeck(const BlackoilPropsAdFromDeck&
             b[i] = bEval.value();
             dbdp[i] = bEval.derivative(0);
             dbdr[i] = bEval.derivative(1);
-        }
+        });
 
         ADB::M dbdp_diag(dbdp.matrix().asDiagonal());
         ADB::M dbdr_diag(dbdr.matrix().asDiagonal());
@@ -642,20 +712,18 @@ BlackoilPropsAdFromDeck::BlackoilPropsAdFromDeck(const BlackoilPropsAdFromDeck&
 
         typedef Opm::DenseAd::Evaluation<double, /*size=*/1> Eval;
 
-        Eval pEval = 0.0;
-        Eval TEval = 293.15; // temperature is not supported by this API!
-
-        pEval.setDerivative(0, 1.0);
+        const Eval TEval = 293.15; // temperature is not supported by this API!
 
-        for (int i = 0; i < n; ++i) {
+        evaluatePvt(RsSat, cells, po.value(), nullptr, nullptr, nullptr, rbub, drbubdp, nullptr, [&](const int i) {
             unsigned pvtRegionIdx = cellPvtRegionIdx_[cells[i]];
-            pEval.setValue(po.value()[i]);
+            Eval pEval = po.value()[i];
+            pEval.setDerivative(0, 1.0);
 
             const Eval& RsEval = FluidSystem::oilPvt().saturatedGasDissolutionFactor(pvtRegionIdx, TEval, pEval);
 
             rbub[i] = RsEval.value();
             drbubdp[i] = RsEval.derivative(0);
-        }
+        });
 
         ADB::M drbubdp_diag(drbubdp.matrix().asDiagonal());
         const int num_blocks = po.numBlocks();
@@ -699,20 +767,18 @@ BlackoilPropsAdFromDeck::BlackoilPropsAdFromDeck(const BlackoilPropsAdFromDeck&
 
         typedef Opm::DenseAd::Evaluation<double, /*size=*/1> Eval;
 
-        Eval pEval = 0.0;
-        Eval TEval = 293.15; // temperature is not supported by this API!
-
-        pEval.setDerivative(0, 1.0);
+        const Eval TEval = 293.15; // temperature is not supported by this API!
 
-        for (int i = 0; i < n; ++i) {
+        evaluatePvt(RvSat, cells, pg.value(), nullptr, nullptr, nullptr, rv, drvdp, nullptr, [&](const int i) {
             unsigned pvtRegionIdx = cellPvtRegionIdx_[cells[i]];
-            pEval.setValue(pg.value()[i]);
+            Eval pEval = pg.value()[i];
+            pEval.setDerivative(0, 1.0);
 
             const Eval& RvEval = FluidSystem::gasPvt().saturatedOilVaporizationFactor(pvtRegionIdx, TEval, pEval);
 
             rv[i] = RvEval.value();
             drvdp[i] = RvEval.derivative(0);
-        }
+        });
 
         ADB::M drvdp_diag(drvdp.matrix().asDiagonal());
         const int num_blocks = pg.numBlocks();
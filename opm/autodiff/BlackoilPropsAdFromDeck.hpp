@@ -457,8 +457,49 @@ namespace Opm
             return cellPvtRegionIdx_;
         }
 
+        /// Reuse the PVT properties and their derivatives for cells whose
+        /// pressure, temperature and rs/rv changed by less than the given
+        /// relative tolerance since their last evaluation, with the same
+        /// phases present. Zero (the default) evaluates all cells every time.
+        void setPropertyCacheTolerance(const double tolerance)
+        {
+            property_cache_tolerance_ = tolerance;
+            for (auto& cache : property_cache_) {
+                cache.cells.clear();
+            }
+        }
+
 
     private:
+        /// The PVT properties that can be cached between evaluations.
+        enum CachedProperty { MuWat, MuOil, MuGas, BWat, BOil, BGas, RsSat, RvSat, NumCachedProperties };
+
+        /// Inputs and results of the last evaluation of a PVT property for a
+        /// set of cells, three values per cell.
+        struct PropertyCache
+        {
+            std::vector<int> cells;
+            std::vector<double> inputs;
+            std::vector<unsigned char> phases;
+            std::vector<double> results;
+        };
+
+        /// Calls evaluate(i) for every cell i whose cached inputs differ from
+        /// (p, T, r, cond) by more than the cache tolerance, which writes
+        /// value[i], dvaldp[i] and (if given) dvaldr[i]. The cached results
+        /// are copied for the other cells. T, r and cond may be null.
+        template <class Function>
+        void evaluatePvt(const CachedProperty property,
+                         const Cells& cells,
+                         const V& p,
+                         const V* T,
+                         const V* r,
+                         const std::vector<PhasePresence>* cond,
+                         V& value,
+                         V& dvaldp,
+                         V* dvaldr,
+                         const Function& evaluate) const;
+
         /// Initializes the properties.
         void init(const Opm::Deck& deck,
                   const Opm::EclipseState& eclState,
@@ -498,6 +539,9 @@ namespace Opm
         double vap2_;
         std::vector<double> satOilMax_;
         double vap_satmax_guard_;  //Threshold value to promote stability
+
+        double property_cache_tolerance_ = 0.0;
+        mutable std::array<PropertyCache, NumCachedProperties> property_cache_;
     };
 } // namespace Opm
 
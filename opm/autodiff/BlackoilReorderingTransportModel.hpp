@@ -23,11 +23,11 @@
 #include <opm/autodiff/BlackoilModelBase.hpp>
 #include <opm/autodiff/WellStateFullyImplicitBlackoil.hpp>
 #include <opm/autodiff/BlackoilModelParameters.hpp>
-#include <opm/autodiff/DebugTimeReport.hpp>
 #include <opm/autodiff/multiPhaseUpwind.hpp>
+#include <opm/simulators/ProfileScope.hpp>
 #include <opm/grid/UnstructuredGrid.h>
-#include <opm/core/transport/reorder/reordersequence.h>
 #include <opm/core/simulator/BlackoilState.hpp>
+#include <opm/core/linalg/ParallelIstlInformation.hpp>
 
 #include <opm/autodiff/BlackoilTransportModel.hpp>
 
@@ -188,6 +188,128 @@ namespace Opm {
 
 
 
+        /// Computes the strongly connected components of the upwind graph
+        /// of a flux field with Tarjan's algorithm, sorted such that every
+        /// component comes after the components upwind of it. Unlike
+        /// compute_sequence(), it works on a ConnectivityGraph and therefore
+        /// for any grid type and with non-neighbouring connections. The
+        /// buffers are kept between calls.
+        class ReorderSequence
+        {
+        public:
+            /// Compute the ordering.
+            /// \param[in] graph   connectivity of the cells
+            /// \param[in] flux    one flux per connection, positive from
+            ///                    the first to the second cell of connectionCells()
+            /// \param[in] num_cells  number of cells
+            /// \param[in] active  if non-null, only the cells with nonzero
+            ///                    active[cell] are ordered. The others, such as
+            ///                    overlap cells owned by another process, are
+            ///                    treated like boundaries.
+            void compute(const ConnectivityGraph& graph,
+                         const double* flux,
+                         const int num_cells,
+                         const double* active = nullptr)
+            {
+                index_.assign(num_cells, -1);
+                lowlink_.resize(num_cells);
+                on_stack_.assign(num_cells, 0);
+                stack_.clear();
+                call_stack_.clear();
+                sequence_.clear();
+                components_.assign(1, 0);
+
+                int counter = 0;
+                for (int root = 0; root < num_cells; ++root) {
+                    if (index_[root] != -1 || (active && active[root] == 0.0)) {
+                        continue;
+                    }
+                    visit(root, counter);
+                    // Iterative depth first search along the upwind connections.
+                    while (!call_stack_.empty()) {
+                        const int cell = call_stack_.back().first;
+                        const Connections connections = graph.cellConnections(cell);
+                        bool descended = false;
+                        while (call_stack_.back().second < connections.size()) {
+                            const Connection conn = *Connections::Iterator(connections, call_stack_.back().second++);
+                            if (conn.sign * flux[conn.index] >= 0.0) {
+                                continue; // Not an inflow connection.
+                            }
+                            const auto cells = graph.connectionCells(conn.index);
+                            const int other = cells[0] == cell ? cells[1] : cells[0];
+                            if (other < 0 || (active && active[other] == 0.0)) {
+                                continue;
+                            }
+                            if (index_[other] == -1) {
+                                visit(other, counter);
+                                descended = true;
+                                break;
+                            } else if (on_stack_[other]) {
+                                lowlink_[cell] = std::min(lowlink_[cell], index_[other]);
+                            }
+                        }
+                        if (descended) {
+                            continue;
+                        }
+
+                        // All upwind cells are done, cell may close a component.
+                        if (lowlink_[cell] == index_[cell]) {
+                            int member;
+                            do {
+                                member = stack_.back();
+                                stack_.pop_back();
+                                on_stack_[member] = 0;
+                                sequence_.push_back(member);
+                            } while (member != cell);
+                            components_.push_back(sequence_.size());
+                        }
+                        call_stack_.pop_back();
+                        if (!call_stack_.empty()) {
+                            const int parent = call_stack_.back().first;
+                            lowlink_[parent] = std::min(lowlink_[parent], lowlink_[cell]);
+                        }
+                    }
+                }
+            }
+
+            /// The ordered cells, component by component.
+            const std::vector<int>& sequence() const
+            {
+                return sequence_;
+            }
+
+            /// Start of each component in sequence(), with one extra
+            /// entry for the end of the last component.
+            const std::vector<int>& components() const
+            {
+                return components_;
+            }
+
+            int numComponents() const
+            {
+                return components_.size() - 1;
+            }
+
+        private:
+            void visit(const int cell, int& counter)
+            {
+                index_[cell] = lowlink_[cell] = counter++;
+                stack_.push_back(cell);
+                on_stack_[cell] = 1;
+                call_stack_.emplace_back(cell, 0);
+            }
+
+            std::vector<int> sequence_;
+            std::vector<int> components_;
+            std::vector<int> index_;
+            std::vector<int> lowlink_;
+            std::vector<char> on_stack_;
+            std::vector<int> stack_;
+            std::vector<std::pair<int, int>> call_stack_;
+        };
+
+
+
     } // namespace detail
 
 
@@ -281,7 +403,9 @@ namespace Opm {
             const int num_cells = p.size();
             cstate0_.resize(num_cells);
             for (int cell = 0; cell < num_cells; ++cell) {
-                computeCellState(cell, state0_, cstate0_[cell]);
+                PressureProps pprops;
+                computePressureProps(cell, state0_, pprops);
+                computeCellState(cell, state0_, pprops, cstate0_[cell]);
             }
             cstate_ = cstate0_;
         }
@@ -299,24 +423,32 @@ namespace Opm {
         {
             // Extract reservoir and well fluxes and state.
             {
-                DebugTimeReport tr("Extracting fluxes");
+                ProfileScope timing("extracting fluxes");
                 extractFluxes(reservoir_state, well_state);
                 extractState(reservoir_state, well_state);
             }
 
             // Compute cell ordering based on total flux.
             {
-                DebugTimeReport tr("Topological sort");
+                ProfileScope timing("topological sort");
                 computeOrdering();
             }
 
             // Solve in every component (cell or block of cells), in order.
             {
-                DebugTimeReport tr("Solving all components");
+                ProfileScope timing("solving all components");
+                solve_counts_ = SolveCounts();
                 for (int ii = 0; ii < 5; ++ii) {
-                    DebugTimeReport tr2("Solving components single sweep.");
+                    ProfileScope sweepTiming("single sweep");
                     solveComponents();
+                    communicateOverlapCells();
                 }
+                std::ostringstream os;
+                os << "Solved " << solve_counts_.single_cells << " single cells, "
+                   << solve_counts_.small_components << " small and "
+                   << solve_counts_.large_components << " large components, with "
+                   << solve_counts_.local_iterations << " local Newton iterations";
+                OpmLog::debug(os.str());
             }
 
             // Update states for output.
@@ -372,6 +504,34 @@ namespace Opm {
 
 
 
+        // The properties of a cell that only depend on the oil pressure,
+        // which is constant during the transport solve. They are computed
+        // once per nonlinear iteration, and reused by all local iterations.
+        struct PressureProps
+        {
+            double rssat;
+            double mu_oil_sat;
+            double b_oil_sat;
+        };
+
+
+
+
+
+        // The number of components solved by each path, and the number of
+        // local Newton iterations, summed over the sweeps of an iteration.
+        struct SolveCounts
+        {
+            int single_cells = 0;
+            int small_components = 0;
+            int large_components = 0;
+            int local_iterations = 0;
+        };
+
+
+
+
+
         template <typename ScalarT>
         struct CellState
         {
@@ -435,6 +595,7 @@ namespace Opm {
 
         std::vector<CellState<double>> cstate0_;
         std::vector<CellState<double>> cstate_;
+        std::vector<PressureProps> pprops_;
 
         V total_flux_;
         V total_wellperf_flux_;
@@ -442,8 +603,7 @@ namespace Opm {
         V total_wellflux_cell_;
         V oil_wellflux_cell_;
         V gas_wellflux_cell_;
-        std::vector<int> sequence_;
-        std::vector<int> components_;
+        detail::ReorderSequence reorder_sequence_;
         V trans_all_;
         V gdz_;
         DataBlock rhos_;
@@ -451,6 +611,11 @@ namespace Opm {
         std::array<double, 2> max_abs_dx_;
         std::array<int, 2> max_abs_dx_cell_;
 
+        SolveCounts solve_counts_;
+
+        // Components with fewer cells are iterated to convergence.
+        static const int max_small_component_size = 10;
+
         // TODO: remove this, for debug only.
         BlackoilTransportModel<Grid, WellModel> tr_model_;
 
@@ -461,8 +626,23 @@ namespace Opm {
 
 
 
+        void computePressureProps(const int cell, const State& state, PressureProps& pprops) const
+        {
+            const double poval = state.reservoir_state.pressure()[cell];
+            const int pvt_region = props_.pvtRegions()[cell];
+            const double temperature = 0.0; // Temperature is not used.
+            const auto& oilpvt = props_.oilProps();
+            pprops.rssat = oilpvt.saturatedGasDissolutionFactor(pvt_region, temperature, poval);
+            pprops.mu_oil_sat = oilpvt.saturatedViscosity(pvt_region, temperature, poval);
+            pprops.b_oil_sat = oilpvt.saturatedInverseFormationVolumeFactor(pvt_region, temperature, poval);
+        }
+
+
+
+
         template <typename Scalar>
-        void computeCellState(const int cell, const State& state, CellState<Scalar>& cstate) const
+        void computeCellState(const int cell, const State& state, const PressureProps& pprops,
+                              CellState<Scalar>& cstate) const
         {
             assert(numPhases() == 3); // I apologize for this to my future self, that will have to fix it.
 
@@ -508,14 +688,14 @@ namespace Opm {
             cstate.temperature = constant(0.0); // Temperature is not used.
             cstate.mu[Water] = waterpvt.viscosity(pvt_region, cstate.temperature, cstate.p[Water]);
             cstate.mu[Oil] = is_sg
-                ? oilpvt.saturatedViscosity(pvt_region, cstate.temperature, cstate.p[Oil])
+                ? constant(pprops.mu_oil_sat)
                 : oilpvt.viscosity(pvt_region, cstate.temperature, cstate.p[Oil], cstate.rs);
             cstate.mu[Gas] = is_sg
                 ? gaspvt.saturatedViscosity(pvt_region, cstate.temperature, cstate.p[Gas])
                 : gaspvt.viscosity(pvt_region, cstate.temperature, cstate.p[Gas], cstate.rv);
             cstate.b[Water] = waterpvt.inverseFormationVolumeFactor(pvt_region, cstate.temperature, cstate.p[Water]);
             cstate.b[Oil] = is_sg
-                ? oilpvt.saturatedInverseFormationVolumeFactor(pvt_region, cstate.temperature, cstate.p[Oil])
+                ? constant(pprops.b_oil_sat)
                 : oilpvt.inverseFormationVolumeFactor(pvt_region, cstate.temperature, cstate.p[Oil], cstate.rs);
             cstate.b[Gas] = is_sg
                 ? gaspvt.saturatedInverseFormationVolumeFactor(pvt_region, cstate.temperature, cstate.p[Gas])
@@ -532,7 +712,7 @@ namespace Opm {
             cstate.rho[Gas] = (rhos_(cell, Gas) + cstate.rv*rhos_(cell, Oil)) * cstate.b[Gas];
 
             // Compute saturated rs and rv factors.
-            cstate.rssat = oilpvt.saturatedGasDissolutionFactor(pvt_region, cstate.temperature, cstate.p[Oil]);
+            cstate.rssat = constant(pprops.rssat);
             cstate.rvsat = gaspvt.saturatedOilVaporizationFactor(pvt_region, cstate.temperature, cstate.p[Gas]);
             // TODO: add vaporization controls such as in BlackoilPropsAdFromDeck::applyVap().
         }
@@ -573,6 +753,11 @@ namespace Opm {
             const std::vector<double>& p = reservoir_state.pressure();
             state_.tr_mult = Base::transMult(ADB::constant(Eigen::Map<const V>(p.data(), p.size()))).value();
             state_.pv_mult = Base::poroMult(ADB::constant(Eigen::Map<const V>(p.data(), p.size()))).value();
+            const int num_cells = p.size();
+            pprops_.resize(num_cells);
+            for (int cell = 0; cell < num_cells; ++cell) {
+                computePressureProps(cell, state_, pprops_[cell]);
+            }
         }
 
 
@@ -581,23 +766,61 @@ namespace Opm {
 
         void computeOrdering()
         {
-            assert(!geo_.nnc().hasNNC()); // TODO: support compute_sequence() with grid + nnc.
-            static_assert(std::is_same<Grid, UnstructuredGrid>::value,
-                          "compute_sequence() is written in C and therefore requires an UnstructuredGrid, "
-                          "it must be rewritten to use other grid classes such as CpGrid");
             using namespace Opm::AutoDiffGrid;
             const int num_cells = numCells(grid_);
-            sequence_.resize(num_cells);
-            components_.resize(num_cells + 1); // max possible size
-            int num_components = -1;
 
+            // In parallel, every process orders the cells it owns. The
+            // overlap cells are updated from their owners between sweeps.
+            const double* owned = nullptr;
+#if HAVE_MPI
+            if (Base::isParallel()) {
+                const ParallelISTLInformation& info =
+                    boost::any_cast<const ParallelISTLInformation&>(Base::linsolver_.parallelInformation());
+                owned = info.updateOwnerMask(state_.reservoir_state.pressure()).data();
+            }
+#endif
+            reorder_sequence_.compute(graph_, total_flux_.data(), num_cells, owned);
+            OpmLog::debug(std::string("Number of components: ") + std::to_string(reorder_sequence_.numComponents()));
+        }
 
-            using namespace Opm::AutoDiffGrid;
-            const int num_faces = numFaces(grid_);
-            V flux_on_all_faces = superset(total_flux_, ops_.internal_faces, num_faces);
-            compute_sequence(&grid_, flux_on_all_faces.data(), sequence_.data(), components_.data(), &num_components);
-            OpmLog::debug(std::string("Number of components: ") + std::to_string(num_components));
-            components_.resize(num_components + 1); // resize to fit actually used part
+
+
+
+        // Copy the solution of the cells owned by other processes from
+        // their owners and update the corresponding cell states.
+        void communicateOverlapCells()
+        {
+#if HAVE_MPI
+            if (!Base::isParallel()) {
+                return;
+            }
+            const ParallelISTLInformation& info =
+                boost::any_cast<const ParallelISTLInformation&>(Base::linsolver_.parallelInformation());
+            auto& rstate = state_.reservoir_state;
+            const int num_cells = rstate.pressure().size();
+            std::vector<double> sw(num_cells), sg(num_cells), hcstate(num_cells);
+            for (int cell = 0; cell < num_cells; ++cell) {
+                sw[cell] = rstate.saturation()[3*cell + Water];
+                sg[cell] = rstate.saturation()[3*cell + Gas];
+                hcstate[cell] = rstate.hydroCarbonState()[cell];
+            }
+            info.copyOwnerToAll(sw, sw);
+            info.copyOwnerToAll(sg, sg);
+            info.copyOwnerToAll(hcstate, hcstate);
+            info.copyOwnerToAll(rstate.gasoilratio(), rstate.gasoilratio());
+            info.copyOwnerToAll(rstate.rv(), rstate.rv());
+            const std::vector<double>& owner_mask = info.updateOwnerMask(sw);
+            for (int cell = 0; cell < num_cells; ++cell) {
+                if (owner_mask[cell] != 0.0) {
+                    continue;
+                }
+                rstate.saturation()[3*cell + Water] = sw[cell];
+                rstate.saturation()[3*cell + Gas] = sg[cell];
+                rstate.saturation()[3*cell + Oil] = 1.0 - sw[cell] - sg[cell];
+                rstate.hydroCarbonState()[cell] = static_cast<HydroCarbonState>(static_cast<int>(hcstate[cell]));
+                computeCellState(cell, state_, pprops_[cell], cstate_[cell]);
+            }
+#endif
         }
 
 
@@ -612,13 +835,20 @@ namespace Opm {
             max_abs_dx_cell_[1] = -1;
 
             // Solve the equations.
-            const int num_components = components_.size() - 1;
+            const std::vector<int>& sequence = reorder_sequence_.sequence();
+            const std::vector<int>& components = reorder_sequence_.components();
+            const int num_components = reorder_sequence_.numComponents();
             for (int comp = 0; comp < num_components; ++comp) {
-                const int comp_size = components_[comp + 1] - components_[comp];
+                const int comp_size = components[comp + 1] - components[comp];
                 if (comp_size == 1) {
-                    solveSingleCell(sequence_[components_[comp]]);
+                    solveSingleCell(sequence[components[comp]]);
+                    ++solve_counts_.single_cells;
+                } else if (comp_size < max_small_component_size) {
+                    solveSmallComponent(comp_size, &sequence[components[comp]]);
+                    ++solve_counts_.small_components;
                 } else {
-                    solveMultiCell(comp_size, &sequence_[components_[comp]]);
+                    solveMultiCell(comp_size, &sequence[components[comp]]);
+                    ++solve_counts_.large_components;
                 }
             }
 
@@ -635,7 +865,8 @@ namespace Opm {
 
 
 
-        void solveSingleCell(const int cell)
+        // Returns the number of Newton iterations.
+        int solveSingleCell(const int cell)
         {
 
             Vec2 res;
@@ -683,6 +914,8 @@ namespace Opm {
                    << " ), rs = " << cstate_[cell].rs << ", rv = " << cstate_[cell].rv << " }";
                 OpmLog::debug(os.str());
             }
+            solve_counts_.local_iterations += iter;
+            return iter;
         }
 
 
@@ -700,6 +933,26 @@ namespace Opm {
 
 
 
+        // Solve a small component by nonlinear Gauss-Seidel, sweeping its
+        // cells until none of them needs a Newton update. The sweeps are
+        // cheap, since the cells of the component stay in cache.
+        void solveSmallComponent(const int comp_size, const int* cell_array)
+        {
+            const int max_sweeps = 20;
+            for (int sweep = 0; sweep < max_sweeps; ++sweep) {
+                int iterations = 0;
+                for (int ii = 0; ii < comp_size; ++ii) {
+                    iterations += solveSingleCell(cell_array[ii]);
+                }
+                if (iterations == 0) {
+                    break;
+                }
+            }
+        }
+
+
+
+
         template <typename Scalar>
         Scalar oilAccumulation(const CellState<Scalar>& cs)
         {
@@ -736,7 +989,7 @@ namespace Opm {
             assert(numPhases() == 3); // I apologize for this to my future self, that will have to fix it.
 
             CellState<Eval> st;
-            computeCellState(cell, state_, st);
+            computeCellState(cell, state_, pprops_[cell], st);
             cstate_[cell] = st.template flatten<double>();
 
             // Accumulation terms.
@@ -782,10 +1035,10 @@ namespace Opm {
                 const double tran = trans_all_[conn.index]; // TODO: include tr_mult effect.
                 const auto& m1 = st.lambda;
                 const auto& m2 = cstate_[other].lambda;
-                const auto upw = connectionMultiPhaseUpwind({{ dh_sat[Water].value(), dh_sat[Oil].value(), dh_sat[Gas].value() }},
-                                                            {{ m1[Water].value(), m1[Oil].value(), m1[Gas].value() }},
-                                                            {{ m2[Water], m2[Oil], m2[Gas] }},
-                                                            tran, vt);
+                const auto upw = connectionMultiPhaseUpwind<3>({{ dh_sat[Water].value(), dh_sat[Oil].value(), dh_sat[Gas].value() }},
+                                                               {{ m1[Water].value(), m1[Oil].value(), m1[Gas].value() }},
+                                                               {{ m2[Water], m2[Oil], m2[Gas] }},
+                                                               tran, vt);
                 // if (upw[0] != upw[1] || upw[1] != upw[2]) {
                 //     OpmLog::debug("Detected countercurrent flow between cells " + std::to_string(from) + " and " + std::to_string(to));
                 // }
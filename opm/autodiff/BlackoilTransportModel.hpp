@@ -386,19 +386,22 @@ namespace Opm {
             assert(numPhases() == 3);
             const int num_connections = head_diff[0].size();
             Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic> upwind(num_connections, numPhases());
+            std::vector<std::array<double, 3>> dh(num_connections), mob1(num_connections), mob2(num_connections);
             for (int conn = 0; conn < num_connections; ++conn) {
-                const double q = total_flux_[conn];
-                const double t = transmissibility[conn];
                 const int a = ops_.connection_cells(conn, 0); // first cell of connection
                 const int b = ops_.connection_cells(conn, 1); // second cell of connection
-                auto up = connectionMultiPhaseUpwind(
-                    {{ head_diff[0].value()[conn], head_diff[1].value()[conn], head_diff[2].value()[conn] }},
-                    {{ sd_.rq[0].mob.value()[a], sd_.rq[1].mob.value()[a], sd_.rq[2].mob.value()[a]}},
-                    {{ sd_.rq[0].mob.value()[b], sd_.rq[1].mob.value()[b], sd_.rq[2].mob.value()[b]}},
-                    t,
-                    q);
+                for (int ii = 0; ii < 3; ++ii) {
+                    dh[conn][ii] = head_diff[ii].value()[conn];
+                    mob1[conn][ii] = sd_.rq[ii].mob.value()[a];
+                    mob2[conn][ii] = sd_.rq[ii].mob.value()[b];
+                }
+            }
+            std::vector<std::array<double, 3>> up(num_connections);
+            connectionMultiPhaseUpwind<3>(num_connections, dh.data(), mob1.data(), mob2.data(),
+                                          transmissibility.data(), total_flux_.data(), up.data());
+            for (int conn = 0; conn < num_connections; ++conn) {
                 for (int ii = 0; ii < numPhases(); ++ii) {
-                    upwind(conn, ii) = up[ii];
+                    upwind(conn, ii) = up[conn][ii];
                 }
             }
             return upwind;
@@ -457,8 +460,8 @@ namespace Opm {
                 const int gaspos = pu.phase_pos[Gas];
                 const ADB cq_s_prod_oil = cq_s_prod[oilpos];
                 const ADB cq_s_prod_gas = cq_s_prod[gaspos];
-                cq_s_prod[gaspos] += subset(state.rs, Base::well_model_.wellOps().well_cells) * cq_s_prod_oil;
-                cq_s_prod[oilpos] += subset(state.rv, Base::well_model_.wellOps().well_cells) * cq_s_prod_gas;
+                cq_s_prod[gaspos] += (Base::well_model_.wellOps().c2p * state.rs) * cq_s_prod_oil;
+                cq_s_prod[oilpos] += (Base::well_model_.wellOps().c2p * state.rv) * cq_s_prod_gas;
             }
 
             // Compute well perforation surface volume fluxes.
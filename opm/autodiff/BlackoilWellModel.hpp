@@ -29,8 +29,13 @@
 #include <opm/common/utility/platform_dependent/disable_warnings.h>
 #include <opm/common/utility/platform_dependent/reenable_warnings.h>
 
+#include <algorithm>
 #include <cassert>
+#include <string>
 #include <tuple>
+#include <utility>
+#include <unordered_map>
+#include <vector>
 
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/WellTestState.hpp>
@@ -39,15 +44,18 @@
 #include <opm/core/wells/DynamicListEconLimited.hpp>
 #include <opm/core/wells/WellCollection.hpp>
 #include <opm/core/simulator/SimulatorReport.hpp>
+#include <opm/core/utility/OmpExceptionGuard.hpp>
 #include <opm/autodiff/VFPProperties.hpp>
 #include <opm/autodiff/WellHelpers.hpp>
 #include <opm/autodiff/WellDensitySegmented.hpp>
 #include <opm/autodiff/BlackoilPropsAdFromDeck.hpp>
 #include <opm/autodiff/BlackoilDetails.hpp>
 #include <opm/autodiff/BlackoilModelParameters.hpp>
+#include <opm/autodiff/CompactStaticArray.hpp>
 #include <opm/autodiff/WellStateFullyImplicitBlackoil.hpp>
 #include <opm/autodiff/RateConverter.hpp>
 #include <opm/autodiff/WellInterface.hpp>
+#include <opm/autodiff/ParallelWellInfo.hpp>
 #include <opm/autodiff/StandardWell.hpp>
 #include <opm/autodiff/MultisegmentWell.hpp>
 #include <opm/autodiff/Compat.hpp>
@@ -58,6 +66,8 @@
 
 #include <opm/material/densead/Math.hpp>
 
+#include <opm/simulators/MemoryAccounting.hpp>
+#include <opm/simulators/ProfileScope.hpp>
 #include <opm/simulators/WellSwitchingLogger.hpp>
 
 
@@ -107,36 +117,38 @@ namespace Opm {
 
             void initFromRestartFile(const RestartValue& restartValues)
             {
-                // gives a dummy dynamic_list_econ_limited
-                DynamicListEconLimited dummyListEconLimited;
-                const auto& defunctWellNames = ebosSimulator_.vanguard().defunctWellNames();
-                WellsManager wellsmanager(eclState(),
-                                          schedule(),
-                                          // The restart step value is used to identify wells present at the given
-                                          // time step. Wells that are added at the same time step as RESTART is initiated
-                                          // will not be present in a restart file. Use the previous time step to retrieve
-                                          // wells that have information written to the restart file.
-                                          std::max(eclState().getInitConfig().getRestartStep() - 1, 0),
-                                          Opm::UgGridHelpers::numCells(grid()),
-                                          Opm::UgGridHelpers::globalCell(grid()),
-                                          Opm::UgGridHelpers::cartDims(grid()),
-                                          Opm::UgGridHelpers::dimensions(grid()),
-                                          Opm::UgGridHelpers::cell2Faces(grid()),
-                                          Opm::UgGridHelpers::beginFaceCentroids(grid()),
-                                          dummyListEconLimited,
-                                          grid().comm().size() > 1,
-                                          defunctWellNames);
+                // The restart step value is used to identify wells present at the given
+                // time step. Wells that are added at the same time step as RESTART is initiated
+                // will not be present in a restart file. Use the previous time step to retrieve
+                // wells that have information written to the restart file.
+                const int step = std::max(eclState().getInitConfig().getRestartStep() - 1, 0);
+                withWellsAtStep(step, [&](const Wells* wells, const PhaseUsage& phaseUsage) {
+                        if (wells->number_of_wells > 0) {
+                            well_state_.resize(wells, Opm::UgGridHelpers::numCells(grid()), phaseUsage); //Resize for restart step
+                            wellsToState(restartValues.wells, phaseUsage, well_state_);
+                            previous_well_state_ = well_state_;
+                            well_state_is_previous_ = true;
+                        }
+                    });
+            }
 
-                const Wells* wells = wellsmanager.c_wells();
+            // restore the well state written by writeSnapshot() at the end of the
+            // report step before reportStep, see SimulatorSnapshot.hpp
+            template <class Reader>
+            void initFromSnapshot(Reader& reader, const int reportStep)
+            {
+                withWellsAtStep(std::max(reportStep - 1, 0), [&](const Wells* wells, const PhaseUsage& phaseUsage) {
+                        well_state_.resize(wells, Opm::UgGridHelpers::numCells(grid()), phaseUsage);
+                        well_state_.readSnapshot(reader);
+                        previous_well_state_ = well_state_;
+                        well_state_is_previous_ = true;
+                    });
+            }
 
-                const int nw = wells->number_of_wells;
-                if (nw > 0) {
-                    auto phaseUsage = phaseUsageFromDeck(eclState());
-                    size_t numCells = Opm::UgGridHelpers::numCells(grid());
-                    well_state_.resize(wells, numCells, phaseUsage); //Resize for restart step
-                    wellsToState(restartValues.wells, phaseUsage, well_state_);
-                    previous_well_state_ = well_state_;
-                }
+            template <class Writer>
+            void writeSnapshot(Writer& writer) const
+            {
+                previous_well_state_.writeSnapshot(writer);
             }
 
             // compute the well fluxes and assemble them in to the reservoir equations as source terms
@@ -172,6 +184,9 @@ namespace Opm {
             // return the internal well state
             const WellState& wellState() const;
 
+            // return the wells of the current report step
+            const Wells* wells() const { return wells_manager_->c_wells(); }
+
             // only use this for restart.
             void setRestartWellState(const WellState& well_state);
 
@@ -186,6 +201,11 @@ namespace Opm {
             // called at the end of a report step
             void endReportStep();
 
+            // replace the target of the control of the given type of a well of this
+            // process and make it the current control, for the rest of the report
+            // step. Returns false if the well or the control does not exist here.
+            bool setWellControl(const std::string& name, const WellControlType type, const double target);
+
             const SimulatorReport& lastReport() const;
 
 
@@ -196,6 +216,18 @@ namespace Opm {
                 }
             }
 
+            /// Subtract the inflow of the wells from the reservoir residual r at the
+            /// current reservoir and well state, without assembling the Jacobian.
+            /// \return False if some well does not support this.
+            bool addReservoirResidual(BVector& r) const
+            {
+                bool supported = true;
+                for ( const auto& well: well_container_ ) {
+                    supported = well->addReservoirResidual(ebosSimulator_, r) && supported;
+                }
+                return supported;
+            }
+
         protected:
             void extractLegacyPressure_(std::vector<double>& cellPressure) const
             {
@@ -226,7 +258,11 @@ namespace Opm {
 
             Simulator& ebosSimulator_;
             std::unique_ptr<WellsManager> wells_manager_;
+            // the report step wells_manager_ was constructed for
+            int wells_manager_step_ = -1;
             std::vector< const Well* > wells_ecl_;
+            // the index in wells_ecl_ of each well by name
+            std::unordered_map<std::string, int> well_ecl_index_;
 
             bool wells_active_;
 
@@ -239,20 +275,59 @@ namespace Opm {
             // create the well container
             std::vector<WellInterfacePtr > createWellContainer(const int time_step);
 
+            // the processes sharing the perforations of the wells by name, only for
+            // the wells with perforations on several processes
+            std::unordered_map<std::string, std::unique_ptr<ParallelWellInfo> > parallel_well_info_;
+
+            // whether any well has perforations on several processes
+            bool has_distributed_wells_ = false;
+
+            // compute parallel_well_info_ for the wells of the current report step,
+            // collective over all processes
+            void setupParallelWellInfo();
+
+            // hand the ParallelWellInfo over to a well if it is distributed
+            void setParallelWellInfo(WellInterface<TypeTag>& well) const;
+
+            // the wells of the well container grouped such that the wells of one group
+            // do not share any perforated cells and can be assembled concurrently.
+            // empty if the wells are assembled serially.
+            std::vector<std::vector<int> > well_assembly_groups_;
+
+            // compute well_assembly_groups_ for the current well container
+            void computeWellAssemblyGroups();
+
+            // the matrices B, C and D^-1 of all the standard wells, stored contiguously
+            // such that they can be applied in one pass in the linear solver
+            typename StandardWell<TypeTag>::WellMatrices standard_well_matrices_;
+
+            // the wells that are not part of standard_well_matrices_
+            std::vector<const WellInterface<TypeTag>* > non_standard_wells_;
+
+            // copy the matrices of the standard wells after the well equations are assembled
+            void updateStandardWellMatrices();
+
             WellState well_state_;
             WellState previous_well_state_;
+            // whether well_state_ is the same as previous_well_state_, i.e. no
+            // time step has been started since they were last synchronized
+            bool well_state_is_previous_ = false;
+            // the well state before the last solve of the well equations
+            WellState well_state_backup_;
+            // the bytes of well_state_, previous_well_state_ and well_state_backup_
+            MemoryAccounting::Account well_state_memory_{ MemoryAccounting::WellState };
 
             const ModelParameters param_;
             bool terminal_output_;
-            bool has_solvent_;
-            bool has_polymer_;
+            static const bool has_solvent_ = GET_PROP_VALUE(TypeTag, EnableSolvent);
+            static const bool has_polymer_ = GET_PROP_VALUE(TypeTag, EnablePolymer);
             std::vector<int> pvt_region_idx_;
             PhaseUsage phase_usage_;
             size_t global_nc_;
             // the number of the cells in the local grid
             size_t number_of_cells_;
             double gravity_;
-            std::vector<double> depth_;
+            CompactStaticArray depth_;
             bool initial_step_;
 
             std::unique_ptr<RateConverterType> rateConverter_;
@@ -265,8 +340,6 @@ namespace Opm {
             // used to better efficiency of calcuation
             mutable BVector scaleAddRes_;
 
-            const Wells* wells() const { return wells_manager_->c_wells(); }
-
             const Grid& grid() const
             { return ebosSimulator_.vanguard().grid(); }
 
@@ -276,6 +349,29 @@ namespace Opm {
             const Schedule& schedule() const
             { return ebosSimulator_.vanguard().schedule(); }
 
+            // call initWellState with the wells present at the given report step
+            template <class InitWellState>
+            void withWellsAtStep(const int step, InitWellState&& initWellState)
+            {
+                // gives a dummy dynamic_list_econ_limited
+                DynamicListEconLimited dummyListEconLimited;
+                const auto& defunctWellNames = ebosSimulator_.vanguard().defunctWellNames();
+                WellsManager wellsmanager(eclState(),
+                                          schedule(),
+                                          step,
+                                          Opm::UgGridHelpers::numCells(grid()),
+                                          Opm::UgGridHelpers::globalCell(grid()),
+                                          Opm::UgGridHelpers::cartDims(grid()),
+                                          Opm::UgGridHelpers::dimensions(grid()),
+                                          Opm::UgGridHelpers::cell2Faces(grid()),
+                                          Opm::UgGridHelpers::beginFaceCentroids(grid()),
+                                          dummyListEconLimited,
+                                          grid().comm().size() > 1,
+                                          defunctWellNames);
+
+                initWellState(wellsmanager.c_wells(), phaseUsageFromDeck(eclState()));
+            }
+
             void updateWellControls();
 
             void updateGroupControls();
@@ -287,6 +383,9 @@ namespace Opm {
 
             void computeRepRadiusPerfLength(const Grid& grid);
 
+            // the compressed index of each cartesian cell, for computeRepRadiusPerfLength()
+            std::map<int, int> cartesian_to_compressed_;
+
 
             void computeAverageFormationFactor(std::vector<double>& B_avg) const;
 
@@ -298,6 +397,23 @@ namespace Opm {
             // Calculating well potentials for each well
             void computeWellPotentials(std::vector<double>& well_potentials);
 
+            // the well potentials of a well and the state of the well they were computed for
+            struct WellPotentialsCache {
+                std::vector<double> potentials;
+                // pressure and total mobility of each perforation
+                std::vector<double> perforation_state;
+                // the current control and the targets of all the controls
+                std::vector<double> controls;
+            };
+
+            // the last computed well potentials of each well by name, reset every report step
+            std::unordered_map<std::string, WellPotentialsCache> well_potentials_cache_;
+
+            // extract the quantities the well potentials of a well depend on
+            void wellPotentialsState(const WellInterface<TypeTag>& well,
+                                     std::vector<double>& perforation_state,
+                                     std::vector<double>& controls) const;
+
             const std::vector<double>& wellPerfEfficiencyFactors() const;
 
             void calculateEfficiencyFactors();
@@ -311,6 +427,12 @@ namespace Opm {
 
             SimulatorReport solveWellEq(const double dt);
 
+            // Check if well equations is converged. if well_converged is not empty,
+            // only the wells of the well container with well_converged[w] == 0 are
+            // checked, and well_converged is set for the wells found to be converged.
+            bool getWellConvergence(const std::vector<Scalar>& B_avg,
+                                    std::vector<char>& well_converged) const;
+
             void initPrimaryVariablesEvaluation() const;
 
             // The number of components in the model.
@@ -333,6 +455,10 @@ namespace Opm {
 
             void computeRESV(const std::size_t step);
 
+            // average hydrocarbon state of the rate converter, over the whole
+            // field or the perforated cells only (rate_conversion_well_cells_only)
+            void defineRateConverterState();
+
             void extractLegacyCellPvtRegionIndex_();
 
             void extractLegacyDepth_();
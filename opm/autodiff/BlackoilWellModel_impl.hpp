@@ -12,8 +12,7 @@ namespace Opm {
         : ebosSimulator_(ebosSimulator)
         , param_(param)
         , terminal_output_(terminal_output)
-        , has_solvent_(GET_PROP_VALUE(TypeTag, EnableSolvent))
-        , has_polymer_(GET_PROP_VALUE(TypeTag, EnablePolymer))
+        , depth_(param.compact_static_data_)
     {
         const auto& eclState = ebosSimulator_.vanguard().eclState();
         phase_usage_ = phaseUsageFromDeck(eclState);
@@ -44,29 +43,51 @@ namespace Opm {
         const auto& eclState = ebosSimulator_.vanguard().eclState();
         wells_ecl_ = schedule().getWells(timeStepIdx);
 
-        // Create wells and well state.
-        // Pass empty dynamicListEconLimited class
-        // The closing of wells due to limites is
-        // handled by the wellTestState class
-        DynamicListEconLimited dynamic_list_econ_limited;
-        wells_manager_.reset( new WellsManager (eclState,
-                                                schedule(),
-                                                timeStepIdx,
-                                                Opm::UgGridHelpers::numCells(grid),
-                                                Opm::UgGridHelpers::globalCell(grid),
-                                                Opm::UgGridHelpers::cartDims(grid),
-                                                Opm::UgGridHelpers::dimensions(grid),
-                                                Opm::UgGridHelpers::cell2Faces(grid),
-                                                Opm::UgGridHelpers::beginFaceCentroids(grid),
-                                                dynamic_list_econ_limited,
-                                                grid.comm().size() > 1,
-                                                defunct_well_names) );
+        // index the wells of the schedule by name for this report step
+        well_ecl_index_.clear();
+        well_ecl_index_.reserve(wells_ecl_.size());
+        for (int index_well = 0; index_well < static_cast<int>(wells_ecl_.size()); ++index_well) {
+            well_ecl_index_.emplace(wells_ecl_[index_well]->name(), index_well);
+        }
+
+        // The wells of the previous report step are reused if the schedule did not
+        // change them since they were created, with the controls reset to those of
+        // the schedule. The group controls modify the well collection during the
+        // simulation, hence the wells are always recreated with group controls.
+        const bool reuseWells = wells_manager_ && wells_manager_step_ >= 0
+            && !WellsManager::scheduleChanged(schedule(), wells_manager_step_, timeStepIdx)
+            && !wellCollection().groupControlActive()
+            && !wellCollection().havingVREPGroups()
+            && wells_manager_->restoreInitialWells();
+
+        if (!reuseWells) {
+            // Create wells and well state.
+            // Pass empty dynamicListEconLimited class
+            // The closing of wells due to limites is
+            // handled by the wellTestState class
+            DynamicListEconLimited dynamic_list_econ_limited;
+            wells_manager_.reset( new WellsManager (eclState,
+                                                    schedule(),
+                                                    timeStepIdx,
+                                                    Opm::UgGridHelpers::numCells(grid),
+                                                    Opm::UgGridHelpers::globalCell(grid),
+                                                    Opm::UgGridHelpers::cartDims(grid),
+                                                    Opm::UgGridHelpers::dimensions(grid),
+                                                    Opm::UgGridHelpers::cell2Faces(grid),
+                                                    Opm::UgGridHelpers::beginFaceCentroids(grid),
+                                                    dynamic_list_econ_limited,
+                                                    grid.comm().size() > 1,
+                                                    defunct_well_names) );
+            wells_manager_step_ = timeStepIdx;
+        }
 
         // Wells are active if they are active wells on at least
         // one process.
         wells_active_ = localWellsActive() ? 1 : 0;
         wells_active_ = grid.comm().max(wells_active_);
 
+        setupParallelWellInfo();
+
         // The well state initialize bhp with the cell pressure in the top cell.
         // We must therefore provide it with updated cell pressures
         size_t nc = number_of_cells_;
@@ -109,12 +130,16 @@ namespace Opm {
 
         // update the previous well state. This is used to restart failed steps.
         previous_well_state_ = well_state_;
+        well_state_is_previous_ = true;
 
         // Compute reservoir volumes for RESV controls.
         rateConverter_.reset(new RateConverterType (phase_usage_,
                                                     std::vector<int>(number_of_cells_, 0)));
         computeRESV(timeStepIdx);
 
+        // the wells and their controls might have changed
+        well_potentials_cache_.clear();
+
         // update VFP properties
         vfp_properties_.reset (new VFPProperties (
                                    schedule().getVFPInjTables(timeStepIdx),
@@ -130,14 +155,20 @@ namespace Opm {
     void
     BlackoilWellModel<TypeTag>::
     beginTimeStep(const int timeStepIdx, const double simulationTime) {
-        well_state_ = previous_well_state_;
-
+        // after a successful time step the well state is still the previous
+        // one, it only needs to be restored after a failed step
+        if (!well_state_is_previous_) {
+            well_state_ = previous_well_state_;
+        }
+        well_state_is_previous_ = false;
 
         // test wells
         wellTesting(timeStepIdx, simulationTime);
 
         // create the well container
         well_container_ = createWellContainer(timeStepIdx);
+        standard_well_matrices_.clear();
+        non_standard_wells_.clear();
 
         // do the initialization for all the wells
         // TODO: to see whether we can postpone of the intialization of the well containers to
@@ -166,6 +197,10 @@ namespace Opm {
             well->closeCompletions(wellTestState_);
         }
 
+        computeWellAssemblyGroups();
+
+        well_state_memory_.set(well_state_.memoryBytes() + previous_well_state_.memoryBytes()
+                               + well_state_backup_.memoryBytes());
     }
 
 
@@ -189,31 +224,20 @@ namespace Opm {
                 OpmLog::info(msg);
 
                 // Finding the location of the well in wells_ecl
-                const int nw_wells_ecl = wells_ecl_.size();
-                int index_well = 0;
-                for (; index_well < nw_wells_ecl; ++index_well) {
-                    if (testWell.first == wells_ecl_[index_well]->name()) {
-                        break;
-                    }
-                }
+                const auto index_well = well_ecl_index_.find(testWell.first);
                 // It should be able to find in wells_ecl.
-                if (index_well == nw_wells_ecl) {
+                if (index_well == well_ecl_index_.end()) {
                     OPM_THROW(std::logic_error, "Could not find well " << testWell.first << " in wells_ecl ");
                 }
-                const Well* well_ecl = wells_ecl_[index_well];
+                const Well* well_ecl = wells_ecl_[index_well->second];
 
                 // Finding the location of the well in wells struct.
-                const int nw = numWells();
-                int wellidx = -999;
-                for (int w = 0; w < nw; ++w) {
-                    if (testWell.first == std::string(wells()->name[w])) {
-                        wellidx = w;
-                        break;
-                    }
-                }                
-                if (wellidx < 0) {
+                const auto& well_map = well_state_.wellMap();
+                const auto well_entry = well_map.find(testWell.first);
+                if (well_entry == well_map.end()) {
                     OPM_THROW(std::logic_error, "Could not find the well  " << testWell.first << " in the well struct ");
                 }
+                const int wellidx = well_entry->second[0];
 
                 // Use the pvtRegionIdx from the top cell
                 const int well_cell_top = wells()->well_cells[wells()->well_connpos[wellidx]];
@@ -226,36 +250,64 @@ namespace Opm {
                     well_container.emplace_back(new MultisegmentWell<TypeTag>(well_ecl, timeStepIdx, wells(),
                                                                               param_, *rateConverter_, pvtreg, numComponents() ) );
                 }
+                setParallelWellInfo(*well_container.back());
             }
 
-            for (auto& well : well_container) {
-                WellTestState wellTestStateForTheWellTest;
-                WellState wellStateCopy = well_state_;
-                well->init(&phase_usage_, depth_, gravity_, number_of_cells_);
-                const std::string& well_name = well->name();
-                const WellNode& well_node = wellCollection().findWellNode(well_name);
-                const double well_efficiency_factor = well_node.getAccumulativeEfficiencyFactor();
-                well->setWellEfficiencyFactor(well_efficiency_factor);
-                well->setVFPProperties(vfp_properties_.get());
-                well->updatePrimaryVariables(wellStateCopy);
-                well->initPrimaryVariablesEvaluation();
-
-                bool testWell = true;
-		// if a well is closed because all completions are closed, we need to check each completion
-		// individually. We first open all completions, then we close one by one by calling updateWellTestState
-		// untill the number of closed completions do not increase anymore. 
-                while (testWell) {
-                    const size_t numberOfClosedCompletions = wellTestStateForTheWellTest.sizeCompletions();
-                    well->solveWellForTesting(ebosSimulator_, wellStateCopy, B_avg, terminal_output_);
-                    well->updateWellTestState(wellStateCopy, simulationTime, wellTestStateForTheWellTest, /*writeMessageToOPMLog=*/ false);
-                    well->closeCompletions(wellTestStateForTheWellTest);
-
-                    // Stop testing if the well is closed or shut due to all completions shut
-                    // Also check if number of completions has increased. If the number of closed completions do not increased
-                    // we stop the testing.  
-                    if (wellTestStateForTheWellTest.sizeWells() > 0 || numberOfClosedCompletions == wellTestStateForTheWellTest.sizeCompletions())
-                        testWell = false;
+            // the tested wells only write to their own entries of the well state, as in
+            // the parallel assembly of the well equations, so they can share one copy and
+            // be tested concurrently.
+            WellState wellStateCopy = well_state_;
+            const int num_tested_wells = well_container.size();
+            std::vector<WellTestState> wellTestStates(num_tested_wells);
+            detail::OmpExceptionGuard guard;
+#if HAVE_OPENMP
+            const bool parallel_testing = param_.parallel_well_assembly_ && !has_distributed_wells_
+                                          && ebosSimulator_.gridView().comm().size() == 1;
+#pragma omp parallel for schedule(dynamic) if (parallel_testing)
+#endif // HAVE_OPENMP
+            for (int i = 0; i < num_tested_wells; ++i) {
+                try {
+                    auto& well = well_container[i];
+                    WellTestState& wellTestStateForTheWellTest = wellTestStates[i];
+                    well->init(&phase_usage_, depth_, gravity_, number_of_cells_);
+                    const std::string& well_name = well->name();
+                    const WellNode& well_node = wellCollection().findWellNode(well_name);
+                    const double well_efficiency_factor = well_node.getAccumulativeEfficiencyFactor();
+                    well->setWellEfficiencyFactor(well_efficiency_factor);
+                    well->setVFPProperties(vfp_properties_.get());
+                    well->updatePrimaryVariables(wellStateCopy);
+                    well->initPrimaryVariablesEvaluation();
+
+                    bool testWell = true;
+                    // if a well is closed because all completions are closed, we need to check each completion
+                    // individually. We first open all completions, then we close one by one by calling updateWellTestState
+                    // untill the number of closed completions do not increase anymore.
+                    while (testWell) {
+                        const size_t numberOfClosedCompletions = wellTestStateForTheWellTest.sizeCompletions();
+                        well->solveWellForTesting(ebosSimulator_, wellStateCopy, B_avg, terminal_output_);
+                        // it may warn about unsupported economic limits
+#if HAVE_OPENMP
+#pragma omp critical(wellTesting_log)
+#endif // HAVE_OPENMP
+                        well->updateWellTestState(wellStateCopy, simulationTime, wellTestStateForTheWellTest, /*writeMessageToOPMLog=*/ false);
+                        well->closeCompletions(wellTestStateForTheWellTest);
+
+                        // Stop testing if the well is closed or shut due to all completions shut
+                        // Also check if number of completions has increased. If the number of closed completions do not increased
+                        // we stop the testing.
+                        if (wellTestStateForTheWellTest.sizeWells() > 0 || numberOfClosedCompletions == wellTestStateForTheWellTest.sizeCompletions())
+                            testWell = false;
+                    }
                 }
+                catch (...) {
+                    guard.capture();
+                }
+            }
+            guard.rethrow();
+
+            for (int i = 0; i < num_tested_wells; ++i) {
+                const auto& well = well_container[i];
+                const WellTestState& wellTestStateForTheWellTest = wellTestStates[i];
 
                 // update wellTestState if the well test succeeds
                 if (!wellTestStateForTheWellTest.hasWell(well->name(), WellTestConfig::Reason::ECONOMIC)) {
@@ -276,7 +328,11 @@ namespace Opm {
     template<typename TypeTag>
     void
     BlackoilWellModel<TypeTag>::
-    setRestartWellState(const WellState& well_state) { previous_well_state_ = well_state; }
+    setRestartWellState(const WellState& well_state)
+    {
+        previous_well_state_ = well_state;
+        well_state_is_previous_ = false;
+    }
 
     // called at the end of a report step
     template<typename TypeTag>
@@ -285,6 +341,38 @@ namespace Opm {
     endReportStep() {
     }
 
+    template<typename TypeTag>
+    bool
+    BlackoilWellModel<TypeTag>::
+    setWellControl(const std::string& name, const WellControlType type, const double target)
+    {
+        if (!wells_manager_) {
+            return false;
+        }
+        const Wells* wells = this->wells();
+        for (int w = 0; w < wells->number_of_wells; ++w) {
+            if (name != wells->name[w]) {
+                continue;
+            }
+            WellControls* wc = wells->ctrls[w];
+            const int num_controls = well_controls_get_num(wc);
+            for (int ctrl_index = 0; ctrl_index < num_controls; ++ctrl_index) {
+                if (well_controls_iget_type(wc, ctrl_index) != type) {
+                    continue;
+                }
+                well_controls_iset_target(wc, ctrl_index, target);
+                well_controls_set_current(wc, ctrl_index);
+                // the time steps start from the previous well state
+                well_state_.currentControls()[w] = ctrl_index;
+                previous_well_state_.currentControls()[w] = ctrl_index;
+                well_potentials_cache_.clear();
+                return true;
+            }
+            return false;
+        }
+        return false;
+    }
+
     // called at the end of a report step
     template<typename TypeTag>
     const SimulatorReport&
@@ -296,13 +384,16 @@ namespace Opm {
     void
     BlackoilWellModel<TypeTag>::
     timeStepSucceeded(const double& simulationTime) {
-        // TODO: when necessary
-        rateConverter_->template defineState<ElementContext>(ebosSimulator_);
+        // The reservoir rates are only needed if there are wells.
+        if (wellsActive()) {
+            defineRateConverterState();
+        }
         for (const auto& well : well_container_) {
             well->calculateReservoirRates(well_state_);
         }
         updateWellTestState(simulationTime, wellTestState_);
         previous_well_state_ = well_state_;
+        well_state_is_previous_ = true;
     }
 
     template<typename TypeTag>
@@ -323,20 +414,14 @@ namespace Opm {
                 const std::string well_name = std::string(wells()->name[w]);
 
                 // finding the location of the well in wells_ecl
-                const int nw_wells_ecl = wells_ecl_.size();
-                int index_well = 0;
-                for (; index_well < nw_wells_ecl; ++index_well) {
-                    if (well_name == wells_ecl_[index_well]->name()) {
-                        break;
-                    }
-                }
+                const auto index_well = well_ecl_index_.find(well_name);
 
                 // It should be able to find in wells_ecl.
-                if (index_well == nw_wells_ecl) {
+                if (index_well == well_ecl_index_.end()) {
                     OPM_THROW(std::logic_error, "Could not find well " << well_name << " in wells_ecl ");
                 }
 
-                const Well* well_ecl = wells_ecl_[index_well];
+                const Well* well_ecl = wells_ecl_[index_well->second];
 
                 // well is closed due to economical reasons
                 if (wellTestState_.hasWell(well_name, WellTestConfig::Reason::ECONOMIC)) { 
@@ -367,6 +452,7 @@ namespace Opm {
                     well_container.emplace_back(new MultisegmentWell<TypeTag>(well_ecl, time_step, wells(),
                                                 param_, *rateConverter_, pvtreg, numComponents() ) );
                 }
+                setParallelWellInfo(*well_container.back());
             }
         }
         return well_container;
@@ -376,12 +462,87 @@ namespace Opm {
 
 
 
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    setupParallelWellInfo()
+    {
+        parallel_well_info_.clear();
+        has_distributed_wells_ = false;
+
+        const auto& comm = ebosSimulator_.vanguard().grid().comm();
+        if (comm.size() < 2 || wells_ecl_.empty()) {
+            return;
+        }
+
+        // whether this process has perforations of each well of the schedule
+        std::vector<int> has_perforations(wells_ecl_.size(), 0);
+        const Wells* local_wells = wells();
+        if (local_wells) {
+            for (int w = 0; w < local_wells->number_of_wells; ++w) {
+                const auto index_well = well_ecl_index_.find(local_wells->name[w]);
+                if (index_well != well_ecl_index_.end()
+                    && local_wells->well_connpos[w + 1] > local_wells->well_connpos[w]) {
+                    has_perforations[index_well->second] = 1;
+                }
+            }
+        }
+
+        // the number of processes having perforations of each well
+        std::vector<int> num_processes = has_perforations;
+        comm.sum(num_processes.data(), num_processes.size());
+
+        // only the wells living on several processes get their own communicator.
+        // the communicators are created for the wells in the order of the schedule,
+        // which is the same on all processes.
+        for (size_t index_well = 0; index_well < wells_ecl_.size(); ++index_well) {
+            if (num_processes[index_well] > 1) {
+#if HAVE_MPI
+                const std::string& name = wells_ecl_[index_well]->name();
+                parallel_well_info_[name].reset(new ParallelWellInfo(name, has_perforations[index_well] > 0, comm));
+                has_distributed_wells_ = true;
+#endif // HAVE_MPI
+            }
+        }
+    }
+
+
+
+
+
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    setParallelWellInfo(WellInterface<TypeTag>& well) const
+    {
+        const auto parallel_info = parallel_well_info_.find(well.name());
+        if (parallel_info == parallel_well_info_.end()) {
+            return;
+        }
+
+        if (dynamic_cast<const MultisegmentWell<TypeTag>* >(&well)) {
+            OPM_THROW(std::runtime_error, "Multisegment well " << well.name()
+                      << " has perforations on several processes, which is not supported");
+        }
+        if (param_.matrix_add_well_contributions_) {
+            OPM_THROW(std::runtime_error, "Well " << well.name() << " has perforations on several processes, "
+                      "which is not supported together with matrix_add_well_contributions");
+        }
+
+        well.setParallelWellInfo(parallel_info->second.get());
+    }
+
+
+
+
+
     template<typename TypeTag>
     void
     BlackoilWellModel<TypeTag>::
     assemble(const int iterationIdx,
              const double dt)
     {
+        ProfileScope scope("well assemble", KernelCounters::WellAssemble);
 
 
         last_report_ = SimulatorReport();
@@ -431,8 +592,93 @@ namespace Opm {
     assembleWellEq(const double dt,
                    bool only_wells)
     {
-        for (auto& well : well_container_) {
-            well->assembleWellEq(ebosSimulator_, dt, well_state_, only_wells);
+        if (well_assembly_groups_.empty()) {
+            for (auto& well : well_container_) {
+                well->assembleWellEq(ebosSimulator_, dt, well_state_, only_wells);
+            }
+        } else {
+            // the wells of one group write to disjoint cells of the reservoir
+            // residual and Jacobian, and to disjoint entries of the well state.
+            for (const auto& group : well_assembly_groups_) {
+                const int num_wells_in_group = group.size();
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif // HAVE_OPENMP
+                for (int i = 0; i < num_wells_in_group; ++i) {
+                    well_container_[group[i]]->assembleWellEq(ebosSimulator_, dt, well_state_, only_wells);
+                }
+            }
+        }
+
+        updateStandardWellMatrices();
+    }
+
+
+
+
+
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    updateStandardWellMatrices()
+    {
+        standard_well_matrices_.clear();
+        non_standard_wells_.clear();
+
+        for (const auto& well : well_container_) {
+            const auto* standard_well = dynamic_cast<const StandardWell<TypeTag>* >(well.get());
+            // distributed wells need to communicate in apply()
+            if (standard_well && !standard_well->isDistributed()) {
+                standard_well->addToWellMatrices(standard_well_matrices_);
+            } else {
+                non_standard_wells_.push_back(well.get());
+            }
+        }
+    }
+
+
+
+
+
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    computeWellAssemblyGroups()
+    {
+        well_assembly_groups_.clear();
+
+        // distributed wells communicate during the assembly
+        if ( !param_.parallel_well_assembly_ || has_distributed_wells_ || well_container_.size() < 2 ) {
+            return;
+        }
+
+        // greedy coloring: every well goes to the first group in which
+        // none of its perforated cells is perforated by another well.
+        std::unordered_map<int, std::vector<int> > groups_of_cell;
+        std::vector<char> group_used;
+        const int nw = well_container_.size();
+        for (int w = 0; w < nw; ++w) {
+            const auto& cells = well_container_[w]->cells();
+
+            group_used.assign(well_assembly_groups_.size(), 0);
+            for (const int cell : cells) {
+                const auto it = groups_of_cell.find(cell);
+                if (it != groups_of_cell.end()) {
+                    for (const int group : it->second) {
+                        group_used[group] = 1;
+                    }
+                }
+            }
+
+            const int group = std::find(group_used.begin(), group_used.end(), 0) - group_used.begin();
+            if (group == static_cast<int>(well_assembly_groups_.size())) {
+                well_assembly_groups_.emplace_back();
+            }
+            well_assembly_groups_[group].push_back(w);
+
+            for (const int cell : cells) {
+                groups_of_cell[cell].push_back(group);
+            }
         }
     }
 
@@ -467,7 +713,9 @@ namespace Opm {
             return;
         }
 
-        for (auto& well : well_container_) {
+        standard_well_matrices_.apply(x, Ax);
+
+        for (const auto* well : non_standard_wells_) {
             well->apply(x, Ax);
         }
     }
@@ -486,13 +734,22 @@ namespace Opm {
             return;
         }
 
+        // Ax = Ax - alpha * C D^-1 B x for the standard wells
+        standard_well_matrices_.applyScaleAdd(alpha, x, Ax);
+
+        if ( non_standard_wells_.empty() ) {
+            return;
+        }
+
         if( scaleAddRes_.size() != Ax.size() ) {
             scaleAddRes_.resize( Ax.size() );
         }
 
         scaleAddRes_ = 0.0;
         // scaleAddRes_  = - C D^-1 B x
-        apply( x, scaleAddRes_ );
+        for (const auto* well : non_standard_wells_) {
+            well->apply(x, scaleAddRes_);
+        }
         // Ax = Ax + alpha * scaleAddRes_
         Ax.axpy( alpha, scaleAddRes_ );
     }
@@ -556,6 +813,30 @@ namespace Opm {
 
 
 
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    defineRateConverterState()
+    {
+        if ( !param_.rate_conversion_well_cells_only_ ) {
+            rateConverter_->template defineState<ElementContext>(ebosSimulator_);
+            return;
+        }
+
+        // Average over the perforated cells of the local wells.
+        std::vector<int> cells;
+        const Wells* local_wells = wells();
+        if ( local_wells ) {
+            cells.assign(local_wells->well_cells,
+                         local_wells->well_cells + local_wells->well_connpos[local_wells->number_of_wells]);
+        }
+        rateConverter_->template defineState<ElementContext>(ebosSimulator_, cells);
+    }
+
+
+
+
+
     template<typename TypeTag>
     bool
     BlackoilWellModel<TypeTag>::
@@ -588,7 +869,9 @@ namespace Opm {
     solveWellEq(const double dt)
     {
         const int nw = numWells();
-        WellState well_state0 = well_state_;
+        // the state to go back to if the well equations do not converge, the
+        // assignment reuses the storage of the backup of the previous call
+        well_state_backup_ = well_state_;
 
         const int numComp = numComponents();
         std::vector< Scalar > B_avg( numComp, Scalar() );
@@ -596,13 +879,43 @@ namespace Opm {
 
         const int max_iter = param_.max_welleq_iter_;
 
+        // with freeze_converged_wells_, the wells that have converged are not assembled
+        // and updated again unless their control changes. this is not done with group
+        // controls, since group controls couple the wells.
+        const bool freeze_converged_wells = param_.freeze_converged_wells_
+                                            && !wellCollection().groupControlActive();
+        std::vector<char> well_converged;
+        std::vector<int> unconverged_wells;
+        if (freeze_converged_wells) {
+            well_converged.assign(well_container_.size(), 0);
+        }
+
         int it  = 0;
         bool converged;
         do {
-            assembleWellEq(dt, true);
+            if (freeze_converged_wells) {
+                unconverged_wells.clear();
+                for (int w = 0; w < static_cast<int>(well_converged.size()); ++w) {
+                    if ( !well_converged[w] ) {
+                        unconverged_wells.push_back(w);
+                    }
+                }
+
+                // only the well equations are assembled, which does not touch the reservoir
+                // equations, so all the wells can be assembled concurrently.
+                const int num_unconverged = unconverged_wells.size();
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic) if (param_.parallel_well_assembly_ && !has_distributed_wells_)
+#endif // HAVE_OPENMP
+                for (int i = 0; i < num_unconverged; ++i) {
+                    well_container_[unconverged_wells[i]]->assembleWellEq(ebosSimulator_, dt, well_state_, true);
+                }
+            } else {
+                assembleWellEq(dt, true);
+            }
 
             //std::cout << "well convergence only wells " << std::endl;
-            converged = getWellConvergence(B_avg);
+            converged = getWellConvergence(B_avg, well_converged);
 
             // checking whether the group targets are converged
             if (wellCollection().groupControlActive()) {
@@ -616,8 +929,21 @@ namespace Opm {
             ++it;
             if( localWellsActive() )
             {
-                for (auto& well : well_container_) {
-                    well->solveEqAndUpdateWellState(well_state_);
+                if (freeze_converged_wells) {
+                    const int num_unconverged = unconverged_wells.size();
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic) if (param_.parallel_well_assembly_ && !has_distributed_wells_)
+#endif // HAVE_OPENMP
+                    for (int i = 0; i < num_unconverged; ++i) {
+                        const int w = unconverged_wells[i];
+                        if ( !well_converged[w] ) {
+                            well_container_[w]->solveEqAndUpdateWellState(well_state_);
+                        }
+                    }
+                } else {
+                    for (auto& well : well_container_) {
+                        well->solveEqAndUpdateWellState(well_state_);
+                    }
                 }
             }
             // updateWellControls uses communication
@@ -625,8 +951,17 @@ namespace Opm {
             // are active wells anywhere in the global domain.
             if( wellsActive() )
             {
+                const std::vector<int> controls_before = well_state_.currentControls();
                 updateWellControls();
                 initPrimaryVariablesEvaluation();
+
+                // a converged well needs to be solved again if its control has changed
+                for (int w = 0; w < static_cast<int>(well_converged.size()); ++w) {
+                    const int index_of_well = well_container_[w]->indexOfWell();
+                    if (well_state_.currentControls()[index_of_well] != controls_before[index_of_well]) {
+                        well_converged[w] = 0;
+                    }
+                }
             }
         } while (it < max_iter);
 
@@ -639,7 +974,7 @@ namespace Opm {
                 OpmLog::debug("Well equation solution failed in getting converged with " + std::to_string(it) + " iterations");
             }
 
-            well_state_ = well_state0;
+            std::swap(well_state_, well_state_backup_);
             updatePrimaryVariables();
             // also recover the old well controls
             for (int w = 0; w < nw; ++w) {
@@ -663,52 +998,61 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     getWellConvergence(const std::vector<Scalar>& B_avg) const
     {
-        ConvergenceReport report;
+        std::vector<char> well_converged;
+        return getWellConvergence(B_avg, well_converged);
+    }
+
+
 
-        for (const auto& well : well_container_) {
-            report += well->getWellConvergence(B_avg);
-        }
 
-        // checking NaN residuals
-        {
-            bool nan_residual_found = report.nan_residual_found;
-            const auto& grid = ebosSimulator_.vanguard().grid();
-            int value = nan_residual_found ? 1 : 0;
 
-            nan_residual_found = grid.comm().max(value);
+    template<typename TypeTag>
+    bool
+    BlackoilWellModel<TypeTag>::
+    getWellConvergence(const std::vector<Scalar>& B_avg,
+                       std::vector<char>& well_converged) const
+    {
+        ConvergenceReport report;
 
-            if (nan_residual_found) {
-                for (const auto& well : report.nan_residual_wells) {
-                    OpmLog::debug("NaN residual found with phase " + well.phase_name + " for well " + well.well_name);
+        if (well_converged.empty()) {
+            for (const auto& well : well_container_) {
+                report += well->getWellConvergence(B_avg);
+            }
+        } else {
+            assert(well_converged.size() == well_container_.size());
+            const int nw = well_container_.size();
+            for (int w = 0; w < nw; ++w) {
+                if (well_converged[w]) {
+                    continue;
                 }
-                OPM_THROW(Opm::NumericalIssue, "NaN residual found!");
+                const ConvergenceReport well_report = well_container_[w]->getWellConvergence(B_avg);
+                well_converged[w] = well_report.converged ? 1 : 0;
+                report += well_report;
             }
         }
 
-        // checking too large residuals
-        {
-            bool too_large_residual_found = report.too_large_residual_found;
-            const auto& grid = ebosSimulator_.vanguard().grid();
-            int value = too_large_residual_found ? 1 : 0;
-
-            too_large_residual_found = grid.comm().max(value);
-            if (too_large_residual_found) {
-                for (const auto& well : report.too_large_residual_wells) {
-                    OpmLog::debug("Too large residual found with phase " + well.phase_name + " fow well " + well.well_name);
-                }
-                OPM_THROW(Opm::NumericalIssue, "Too large residual found!");
+        // checking NaN and too large residuals and the convergence in a single collective
+        int values[3] = { report.nan_residual_found ? 1 : 0,
+                          report.too_large_residual_found ? 1 : 0,
+                          report.converged ? 0 : 1 };
+        ebosSimulator_.vanguard().grid().comm().max(values, 3);
+
+        if (values[0]) {
+            for (const auto& well : report.nan_residual_wells) {
+                OpmLog::debug("NaN residual found with phase " + well.phase_name + " for well " + well.well_name);
             }
+            OPM_THROW(Opm::NumericalIssue, "NaN residual found!");
         }
 
-        // checking convergence
-        bool converged_well = report.converged;
-        {
-            const auto& grid = ebosSimulator_.vanguard().grid();
-            int value = converged_well ? 1 : 0;
-
-            converged_well = grid.comm().min(value);
+        if (values[1]) {
+            for (const auto& well : report.too_large_residual_wells) {
+                OpmLog::debug("Too large residual found with phase " + well.phase_name + " fow well " + well.well_name);
+            }
+            OPM_THROW(Opm::NumericalIssue, "Too large residual found!");
         }
 
+        const bool converged_well = values[2] == 0;
+
         return converged_well;
     }
 
@@ -778,13 +1122,31 @@ namespace Opm {
         const int np = numPhases();
         well_potentials.resize(nw * np, 0.0);
 
+        const double tolerance = param_.tolerance_well_potentials_;
+        std::vector<double> perforation_state;
+        std::vector<double> controls;
         for (const auto& well : well_container_) {
-            std::vector<double> potentials;
-            well->computeWellPotentials(ebosSimulator_, well_state_, potentials);
+            wellPotentialsState(*well, perforation_state, controls);
+
+            // reuse the potentials if the well has hardly changed since they were computed
+            auto& cache = well_potentials_cache_[well->name()];
+            bool reuse = !cache.potentials.empty()
+                         && cache.controls == controls
+                         && cache.perforation_state.size() == perforation_state.size();
+            for (std::size_t i = 0; reuse && i < perforation_state.size(); ++i) {
+                const double change = std::abs(perforation_state[i] - cache.perforation_state[i]);
+                reuse = change <= tolerance * std::abs(cache.perforation_state[i]);
+            }
+
+            if (!reuse) {
+                well->computeWellPotentials(ebosSimulator_, well_state_, cache.potentials);
+                cache.perforation_state = perforation_state;
+                cache.controls = controls;
+            }
 
             // putting the sucessfully calculated potentials to the well_potentials
             for (int p = 0; p < np; ++p) {
-                well_potentials[well->indexOfWell() * np + p] = std::abs(potentials[p]);
+                well_potentials[well->indexOfWell() * np + p] = std::abs(cache.potentials[p]);
             }
         } // end of for (int w = 0; w < nw; ++w)
     }
@@ -793,6 +1155,45 @@ namespace Opm {
 
 
 
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    wellPotentialsState(const WellInterface<TypeTag>& well,
+                        std::vector<double>& perforation_state,
+                        std::vector<double>& controls) const
+    {
+        // the pressure of the phase the reservoir pressure refers to, which is
+        // oil unless the oil phase is not active
+        const unsigned pressurePhaseIdx = FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx)
+            ? FluidSystem::oilPhaseIdx
+            : (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx) ? FluidSystem::gasPhaseIdx
+                                                                      : FluidSystem::waterPhaseIdx);
+        perforation_state.clear();
+        for (const int cell_idx : well.cells()) {
+            const auto& intQuants = *(ebosSimulator_.model().cachedIntensiveQuantities(cell_idx, /*timeIdx=*/ 0));
+            const auto& fs = intQuants.fluidState();
+            double total_mobility = 0.0;
+            for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
+                if (FluidSystem::phaseIsActive(phaseIdx)) {
+                    total_mobility += intQuants.mobility(phaseIdx).value();
+                }
+            }
+            perforation_state.push_back(fs.pressure(pressurePhaseIdx).value());
+            perforation_state.push_back(total_mobility);
+        }
+
+        const WellControls* wc = well.wellControls();
+        const int num_controls = well_controls_get_num(wc);
+        controls.assign(1, well_controls_get_current(wc));
+        for (int ctrl_index = 0; ctrl_index < num_controls; ++ctrl_index) {
+            controls.push_back(well_controls_iget_target(wc, ctrl_index));
+        }
+    }
+
+
+
+
+
     template<typename TypeTag>
     void
     BlackoilWellModel<TypeTag>::
@@ -800,7 +1201,7 @@ namespace Opm {
     {
 
         if ( wellCollection().havingVREPGroups() ) {
-            rateConverter_->template defineState<ElementContext>(ebosSimulator_);
+            defineRateConverterState();
         }
 
         // after restarting, the well_controls can be modified while
@@ -1101,14 +1502,16 @@ namespace Opm {
     {
         // TODO, the function does not work for parallel running
         // to be fixed later.
-        const int* global_cell = Opm::UgGridHelpers::globalCell(grid);
-
-        std::map<int,int> cartesian_to_compressed;
-        setupCompressedToCartesian(global_cell, number_of_cells_,
-                                    cartesian_to_compressed);
+        // the grid does not change, hence the map of all cells is only set up
+        // once instead of at every time step
+        if (cartesian_to_compressed_.empty()) {
+            const int* global_cell = Opm::UgGridHelpers::globalCell(grid);
+            setupCompressedToCartesian(global_cell, number_of_cells_,
+                                       cartesian_to_compressed_);
+        }
 
         for (const auto& well : well_container_) {
-            well->computeRepRadiusPerfLength(grid, cartesian_to_compressed);
+            well->computeRepRadiusPerfLength(grid, cartesian_to_compressed_);
         }
     }
 
@@ -1226,11 +1629,10 @@ namespace Opm {
         const auto& grid = ebosSimulator_.vanguard().grid();
         const unsigned numCells = grid.size(/*codim=*/0);
 
-        depth_.resize(numCells);
-        for (unsigned cellIdx = 0; cellIdx < numCells; ++cellIdx) {
-            depth_[cellIdx] =
-                grid.cellCenterDepth(cellIdx);
-        }
+        depth_.assign(numCells, [&grid](const unsigned cellIdx)
+                      {
+                          return grid.cellCenterDepth(cellIdx);
+                      });
     }
 
     template<typename TypeTag>
@@ -1265,7 +1667,7 @@ namespace Opm {
         global_number_resv_wells = ebosSimulator_.gridView().comm().sum(global_number_resv_wells);
         if ( global_number_resv_wells > 0 )
         {
-            rateConverter_->template defineState<ElementContext>(ebosSimulator_);
+            defineRateConverterState();
         }
 
         if (! resv_wells.empty()) {
@@ -26,6 +26,7 @@
 
 #include <memory>
 #include <type_traits>
+#include <stdexcept>
 
 #include <opm/common/utility/platform_dependent/disable_warnings.h>
 #include <opm/common/utility/parameters/ParameterGroup.hpp>
@@ -73,6 +74,13 @@ struct CPRParameter
     bool cpr_use_bicgstab_;
     bool cpr_solver_verbose_;
     bool cpr_pressure_aggregation_;
+    bool cpr_reuse_setup_;
+    // The AMG of the pressure system stops coarsening below this many unknowns.
+    int cpr_coarsen_target_;
+    // Gather the coarse levels of the pressure AMG on fewer processes, see
+    // Dune::Amg::AccumulationMode: 0 never, 1 onto one process once the level
+    // is below cpr_coarsen_target, 2 successively onto fewer processes.
+    int cpr_coarse_accumulate_;
 
     CPRParameter() { reset(); }
 
@@ -91,6 +99,14 @@ struct CPRParameter
         cpr_use_bicgstab_         = param.getDefault("cpr_use_bicgstab", cpr_use_bicgstab_);
         cpr_solver_verbose_       = param.getDefault("cpr_solver_verbose", cpr_solver_verbose_);
         cpr_pressure_aggregation_ = param.getDefault("cpr_pressure_aggregation", cpr_pressure_aggregation_);
+        cpr_reuse_setup_          = param.getDefault("cpr_reuse_setup", cpr_reuse_setup_);
+        cpr_coarsen_target_       = param.getDefault("cpr_coarsen_target", cpr_coarsen_target_);
+        cpr_coarse_accumulate_    = param.getDefault("cpr_coarse_accumulate", cpr_coarse_accumulate_);
+
+        if ( cpr_coarse_accumulate_ < Dune::Amg::noAccu || cpr_coarse_accumulate_ > Dune::Amg::successiveAccu )
+        {
+            OPM_THROW(std::invalid_argument, "cpr_coarse_accumulate has to be 0, 1 or 2, got " << cpr_coarse_accumulate_);
+        }
 
         std::string milu("ILU");
         cpr_ilu_milu_ = convertString2Milu(param.getDefault("ilu_milu", milu));
@@ -109,6 +125,9 @@ struct CPRParameter
         cpr_use_bicgstab_         = true;
         cpr_solver_verbose_       = false;
         cpr_pressure_aggregation_ = false;
+        cpr_reuse_setup_          = false;
+        cpr_coarsen_target_       = 1200;
+        cpr_coarse_accumulate_    = Dune::Amg::noAccu;
     }
 };
 
@@ -242,17 +261,21 @@ template < class C, class Op, class P, class S, std::size_t index >
 inline void
 createAMGPreconditionerPointer(Op& opA, const double relax, const P& comm,
                                std::unique_ptr< BlackoilAmg<Op,S,C,P,index> >& amgPtr,
-                               const CPRParameter& params)
+                               const CPRParameter& params,
+                               const std::shared_ptr< typename BlackoilAmg<Op,S,C,P,index>::SetupCache >& cache
+                               = std::shared_ptr< typename BlackoilAmg<Op,S,C,P,index>::SetupCache >())
 {
     using AMG = BlackoilAmg<Op,S,C,P,index>;
-    // TODO: revise choice of parameters
-    int coarsenTarget=1200;
     using Criterion = C;
-    Criterion criterion(15, coarsenTarget);
+    Criterion criterion(15, params.cpr_coarsen_target_);
     criterion.setDebugLevel( 0 ); // no debug information, 1 for printing hierarchy information
     criterion.setDefaultValuesIsotropic(2);
     criterion.setNoPostSmoothSteps( 1 );
     criterion.setNoPreSmoothSteps( 1 );
+    // With many processes the coarsest levels only have a few unknowns per
+    // process and are dominated by latency. Gathering them lets the AMG solve
+    // the coarsest level directly on one process.
+    criterion.setAccumulate( static_cast<Dune::Amg::AccumulationMode>( params.cpr_coarse_accumulate_ ) );
 
     // Since DUNE 2.2 we also need to pass the smoother args instead of steps directly
     typedef typename AMG::Smoother Smoother;
@@ -262,7 +285,7 @@ createAMGPreconditionerPointer(Op& opA, const double relax, const P& comm,
     smootherArgs.relaxationFactor = relax;
     setILUParameters(smootherArgs, params);
 
-    amgPtr.reset( new AMG( params, opA, criterion, smootherArgs, comm ) );
+    amgPtr.reset( new AMG( params, opA, criterion, smootherArgs, comm, cache ) );
 }
 
 template < class C, class Op, class P, class AMG >
@@ -0,0 +1,89 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_COMPACTSTATICARRAY_HEADER_INCLUDED
+#define OPM_COMPACTSTATICARRAY_HEADER_INCLUDED
+
+#include <cstddef>
+#include <vector>
+
+namespace Opm
+{
+
+    /// An array of static cell data that is stored either in double or, to
+    /// halve its memory, in single precision. The values are always read as
+    /// double. Single precision has a relative rounding error of at most
+    /// 2^-24. It suits geometric data such as cell depths, but not data
+    /// that enters the Jacobian with full sensitivity, e.g. transmissibilities.
+    class CompactStaticArray
+    {
+    public:
+        /// Construct an empty array.
+        /// \param[in] single_precision  Whether the values are stored as float.
+        explicit CompactStaticArray(const bool single_precision = false)
+            : single_precision_(single_precision)
+        {
+        }
+
+        /// Set the array to size values, the i-th one given by value(i).
+        template <class Value>
+        void assign(const std::size_t size, const Value& value)
+        {
+            values_.clear();
+            compact_values_.clear();
+            if (single_precision_) {
+                compact_values_.resize(size);
+                for (std::size_t i = 0; i < size; ++i) {
+                    compact_values_[i] = static_cast<float>(value(i));
+                }
+            } else {
+                values_.resize(size);
+                for (std::size_t i = 0; i < size; ++i) {
+                    values_[i] = value(i);
+                }
+            }
+        }
+
+        double operator[](const std::size_t i) const
+        {
+            return single_precision_ ? double(compact_values_[i]) : values_[i];
+        }
+
+        std::size_t size() const
+        {
+            return single_precision_ ? compact_values_.size() : values_.size();
+        }
+
+        bool singlePrecision() const { return single_precision_; }
+
+        /// Number of bytes used by the values.
+        std::size_t memoryBytes() const
+        {
+            return values_.capacity() * sizeof(double) + compact_values_.capacity() * sizeof(float);
+        }
+
+    private:
+        bool single_precision_;
+        std::vector<double> values_;
+        std::vector<float> compact_values_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_COMPACTSTATICARRAY_HEADER_INCLUDED
@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <utility>
 
 #include <opm/polymer/PolymerBlackoilState.hpp>
 #include <opm/common/data/SimulationDataContainer.hpp>
@@ -74,9 +75,13 @@ std::vector< double >& stripe( const std::vector< double >& v,
 
 
 
-data::Solution simToSolution( const SimulationDataContainer& reservoir,
-                              const bool use_si_units,
-                              PhaseUsage phases ) {
+namespace {
+
+// The fields are copied from a const container and moved from a non-const one.
+template <class Container>
+data::Solution simToSolutionImpl( Container& reservoir,
+                                  const bool use_si_units,
+                                  PhaseUsage phases ) {
 
     // Set up unit system to use to suppress conversion if use_si_units is true.
     const UnitSystem::measure press_unit = use_si_units ? UnitSystem::measure::identity : UnitSystem::measure::pressure;
@@ -85,8 +90,8 @@ data::Solution simToSolution( const SimulationDataContainer& reservoir,
     const UnitSystem::measure rv_unit = use_si_units ? UnitSystem::measure::identity : UnitSystem::measure::oil_gas_ratio;
 
     data::Solution sol;
-    sol.insert( "PRESSURE", press_unit, reservoir.pressure() , data::TargetType::RESTART_SOLUTION);
-    sol.insert( "TEMP"    , temp_unit, reservoir.temperature() , data::TargetType::RESTART_SOLUTION );
+    sol.insert( "PRESSURE", press_unit, std::move( reservoir.pressure() ) , data::TargetType::RESTART_SOLUTION);
+    sol.insert( "TEMP"    , temp_unit, std::move( reservoir.temperature() ) , data::TargetType::RESTART_SOLUTION );
 
     const auto ph = reservoir.numPhases();
     const auto& sat = reservoir.saturation();
@@ -103,22 +108,22 @@ data::Solution simToSolution( const SimulationDataContainer& reservoir,
     }
 
     if( reservoir.hasCellData( BlackoilState::GASOILRATIO ) ) {
-        sol.insert( "RS", rs_unit, reservoir.getCellData( BlackoilState::GASOILRATIO ) , data::TargetType::RESTART_SOLUTION );
+        sol.insert( "RS", rs_unit, std::move( reservoir.getCellData( BlackoilState::GASOILRATIO ) ) , data::TargetType::RESTART_SOLUTION );
     }
 
     if( reservoir.hasCellData( BlackoilState::RV ) ) {
-        sol.insert( "RV", rv_unit, reservoir.getCellData( BlackoilState::RV ) , data::TargetType::RESTART_SOLUTION );
+        sol.insert( "RV", rv_unit, std::move( reservoir.getCellData( BlackoilState::RV ) ) , data::TargetType::RESTART_SOLUTION );
     }
 
     if (phases.has_solvent) {
-        sol.insert( "SSOL", UnitSystem::measure::identity, reservoir.getCellData( BlackoilState::SSOL ) , data::TargetType::RESTART_SOLUTION );
+        sol.insert( "SSOL", UnitSystem::measure::identity, std::move( reservoir.getCellData( BlackoilState::SSOL ) ) , data::TargetType::RESTART_SOLUTION );
     }
 
     if (phases.has_polymer) {
         if (reservoir.hasCellData( PolymerBlackoilState::CONCENTRATION )) { // compatibility with legacy polymer
-            sol.insert( "POLYMER", UnitSystem::measure::identity, reservoir.getCellData( PolymerBlackoilState::CONCENTRATION ) , data::TargetType::RESTART_SOLUTION );
+            sol.insert( "POLYMER", UnitSystem::measure::identity, std::move( reservoir.getCellData( PolymerBlackoilState::CONCENTRATION ) ) , data::TargetType::RESTART_SOLUTION );
         } else {
-            sol.insert( "POLYMER", UnitSystem::measure::identity, reservoir.getCellData( BlackoilState::POLYMER ) , data::TargetType::RESTART_SOLUTION );
+            sol.insert( "POLYMER", UnitSystem::measure::identity, std::move( reservoir.getCellData( BlackoilState::POLYMER ) ) , data::TargetType::RESTART_SOLUTION );
         }
 
     }
@@ -126,6 +131,20 @@ data::Solution simToSolution( const SimulationDataContainer& reservoir,
     return sol;
 }
 
+} // anonymous namespace
+
+data::Solution simToSolution( const SimulationDataContainer& reservoir,
+                              const bool use_si_units,
+                              PhaseUsage phases ) {
+    return simToSolutionImpl( reservoir, use_si_units, phases );
+}
+
+data::Solution simToSolution( SimulationDataContainer&& reservoir,
+                              const bool use_si_units,
+                              PhaseUsage phases ) {
+    return simToSolutionImpl( reservoir, use_si_units, phases );
+}
+
 
 
 
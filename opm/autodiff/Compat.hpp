@@ -57,6 +57,12 @@ namespace Opm {
                                   const bool use_si_units,
                                   PhaseUsage phases );
 
+    /// As above, but the fields are moved out of reservoir instead of copied,
+    /// hence they are invalid afterwards.
+    data::Solution simToSolution( SimulationDataContainer&& reservoir,
+                                  const bool use_si_units,
+                                  PhaseUsage phases );
+
     /// Copies the following fields from sol into state (all conditionally):
     ///   PRESSURE, TEMP, SWAT, SGAS, RS, RV, SSOL
     /// Also handles extra data such as hysteresis parameters, SOMAX, etc.
@@ -0,0 +1,369 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_FLOWDIAGNOSTICSEBOS_HEADER_INCLUDED
+#define OPM_FLOWDIAGNOSTICSEBOS_HEADER_INCLUDED
+
+#include <opm/autodiff/ThreadHandle.hpp>
+#include <opm/core/flowdiagnostics/FlowDiagnostics.hpp>
+#include <opm/core/flowdiagnostics/TofReorder.hpp>
+#include <opm/core/wells.h>
+#include <opm/core/well_controls.h>
+#include <opm/grid/UnstructuredGrid.h>
+#include <opm/grid/utility/SparseTable.hpp>
+#include <opm/common/ErrorMacros.hpp>
+#include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/common/utility/parameters/ParameterGroup.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+    /// \brief Flow diagnostics computed from the converged state of the simulator.
+    ///
+    /// At the selected report steps the total reservoir volume fluxes of the
+    /// connections between the cells are taken from the ebos model, and the
+    /// forward and backward time-of-flight, the well pair volumes, the F-Phi
+    /// curve and the Lorenz coefficient are computed in a separate thread
+    /// while the simulation continues. The results are appended to the file
+    /// <output_dir>/<CASE>.FLOWDIAG, which is written next to the summary.
+    ///
+    /// The parameters are
+    ///     flow_diagnostics (false)          compute the flow diagnostics?
+    ///     flow_diagnostics_interval (1)     every nth report step
+    ///     flow_diagnostics_fphi_points (11) number of samples of the F-Phi curve
+    ///
+    /// Only runs on a single process are supported.
+    template<class TypeTag>
+    class FlowDiagnosticsEbos
+    {
+    public:
+        typedef typename GET_PROP_TYPE(TypeTag, Simulator) Simulator;
+        typedef typename GET_PROP_TYPE(TypeTag, ElementContext) ElementContext;
+        typedef typename GET_PROP_TYPE(TypeTag, FluidSystem) FluidSystem;
+
+        FlowDiagnosticsEbos(const Simulator& ebosSimulator,
+                            const ParameterGroup& param,
+                            const bool terminalOutput)
+            : ebosSimulator_(ebosSimulator),
+              enabled_(param.getDefault("flow_diagnostics", false)),
+              interval_(std::max(param.getDefault("flow_diagnostics_interval", 1), 1)),
+              numFPhiPoints_(std::max(param.getDefault("flow_diagnostics_fphi_points", 11), 2))
+        {
+            if (!enabled_) {
+                return;
+            }
+            if (ebosSimulator_.vanguard().grid().comm().size() > 1) {
+                if (terminalOutput) {
+                    OpmLog::warning("Flow diagnostics are only supported on a single process and are disabled.");
+                }
+                enabled_ = false;
+                return;
+            }
+
+            const auto& ioConfig = ebosSimulator_.vanguard().eclState().getIOConfig();
+            filename_ = ioConfig.getOutputDir() + "/" + ioConfig.getBaseName() + ".FLOWDIAG";
+            std::ofstream os(filename_, std::ios::trunc);
+            if (!os) {
+                OPM_THROW(std::runtime_error, "Failed to open " << filename_);
+            }
+            thread_.reset(new ThreadHandle(/*createThread=*/true, /*maxObjects=*/1));
+        }
+
+        /// \brief Is the flow diagnostics computed at the given report step?
+        bool active(const int reportStep) const
+        {
+            return enabled_ && reportStep % interval_ == 0;
+        }
+
+        /// \brief Start the computation for the current state of the ebos model.
+        ///
+        /// Copies the fluxes, pore volumes and well cells and returns, the
+        /// diagnostics are computed and written by the background thread.
+        /// Waits while the computation of an earlier report step is running.
+        /// \param[in] wells        the wells of the report step
+        void compute(const int reportStep, const double time, const Wells* wells)
+        {
+            if (!active(reportStep)) {
+                return;
+            }
+
+            Job job;
+            job.filename = filename_;
+            job.reportStep = reportStep;
+            job.time = time;
+            job.numFPhiPoints = numFPhiPoints_;
+            extractFluxes_(job);
+            extractWells_(wells, job);
+
+            thread_->dispatch(std::move(job));
+        }
+
+    private:
+        // The data of one report step, owned by the background thread.
+        struct Job
+        {
+            std::string filename;
+            int reportStep;
+            double time;
+            int numFPhiPoints;
+
+            int numCells;
+            std::vector<int> faceCells;     // two cells per connection
+            std::vector<double> flux;       // from the first to the second cell
+            std::vector<double> porevol;
+            std::vector<double> source;     // (+) inflow, (-) outflow
+
+            std::vector<std::string> wellNames;
+            std::vector<int> wellIsInjector;
+            std::vector<std::vector<int>> wellCells;
+
+            void run()
+            {
+                std::ofstream os(filename, std::ios::app);
+                try {
+                    write(os);
+                }
+                catch (const std::exception& e) {
+                    os << "-- Flow diagnostics of report step " << reportStep
+                       << " failed: " << e.what() << "\n\n";
+                }
+            }
+
+            void write(std::ostream& os)
+            {
+                // Topology of the connections in the layout of an UnstructuredGrid.
+                const int numFaces = flux.size();
+                std::vector<int> cellFacePos(numCells + 1, 0);
+                for (int f = 0; f < numFaces; ++f) {
+                    ++cellFacePos[faceCells[2*f] + 1];
+                    ++cellFacePos[faceCells[2*f + 1] + 1];
+                }
+                std::partial_sum(cellFacePos.begin(), cellFacePos.end(), cellFacePos.begin());
+                std::vector<int> cellFaces(cellFacePos.back());
+                std::vector<int> insertPos(cellFacePos.begin(), cellFacePos.end() - 1);
+                for (int f = 0; f < numFaces; ++f) {
+                    cellFaces[insertPos[faceCells[2*f]]++] = f;
+                    cellFaces[insertPos[faceCells[2*f + 1]]++] = f;
+                }
+                UnstructuredGrid grid = UnstructuredGrid();
+                grid.number_of_cells = numCells;
+                grid.number_of_faces = numFaces;
+                grid.face_cells = faceCells.data();
+                grid.cell_facepos = cellFacePos.data();
+                grid.cell_faces = cellFaces.data();
+
+                // Tracer heads of the injectors and the producers.
+                SparseTable<int> injectorCells;
+                SparseTable<int> producerCells;
+                std::vector<int> injectors;
+                std::vector<int> producers;
+                const int numWells = wellNames.size();
+                for (int w = 0; w < numWells; ++w) {
+                    if (wellIsInjector[w]) {
+                        injectorCells.appendRow(wellCells[w].begin(), wellCells[w].end());
+                        injectors.push_back(w);
+                    }
+                    else {
+                        producerCells.appendRow(wellCells[w].begin(), wellCells[w].end());
+                        producers.push_back(w);
+                    }
+                }
+
+                // Forward time-of-flight from the injectors and backward
+                // time-of-flight to the producers.
+                TofReorder tofSolver(grid);
+                std::vector<double> ftof;
+                std::vector<double> btof;
+                std::vector<double> ftracer;
+                std::vector<double> btracer;
+                tofSolver.solveTofTracer(flux.data(), porevol.data(), source.data(),
+                                         injectorCells, ftof, ftracer);
+                for (auto& q : flux) {
+                    q = -q;
+                }
+                for (auto& q : source) {
+                    q = -q;
+                }
+                tofSolver.solveTofTracer(flux.data(), porevol.data(), source.data(),
+                                         producerCells, btof, btracer);
+
+                // Cells without flow have no tracer values.
+                for (auto& t : ftracer) {
+                    t = std::isfinite(t) ? t : 0.0;
+                }
+                for (auto& t : btracer) {
+                    t = std::isfinite(t) ? t : 0.0;
+                }
+
+                const auto fphi = computeFandPhi(porevol, ftof, btof);
+                const double lorenz = computeLorenz(fphi.first, fphi.second);
+
+                // Pore volumes of the well pairs.
+                const int numInj = injectors.size();
+                const int numProd = producers.size();
+                std::vector<double> pairVolume(numInj * numProd, 0.0);
+                for (int c = 0; c < numCells; ++c) {
+                    for (int i = 0; i < numInj; ++i) {
+                        const double v = porevol[c] * ftracer[numInj*c + i];
+                        for (int p = 0; p < numProd; ++p) {
+                            pairVolume[numProd*i + p] += v * btracer[numProd*c + p];
+                        }
+                    }
+                }
+
+                os << "-- Flow diagnostics of report step " << reportStep << " at day "
+                   << time / 86400.0 << "\n";
+                os << "LORENZ\n  " << std::setprecision(6) << lorenz << "\n";
+
+                // F sampled at equidistant values of Phi.
+                os << "FPHI\n";
+                const auto& F = fphi.first;
+                const auto& Phi = fphi.second;
+                for (int k = 0; k < numFPhiPoints; ++k) {
+                    const double phi = double(k) / (numFPhiPoints - 1);
+                    const auto it = std::lower_bound(Phi.begin(), Phi.end(), phi);
+                    double f = 1.0;
+                    if (it == Phi.begin()) {
+                        f = F.front();
+                    }
+                    else if (it != Phi.end()) {
+                        const auto i = it - Phi.begin();
+                        const double w = (phi - Phi[i-1]) / std::max(Phi[i] - Phi[i-1], 1e-300);
+                        f = (1.0 - w) * F[i-1] + w * F[i];
+                    }
+                    os << "  " << std::setw(12) << phi << std::setw(14) << f << "\n";
+                }
+
+                // Allocation factors: the part of the pore volume swept by an
+                // injector that drains to the producer.
+                os << "WELLPAIRS\n";
+                for (int i = 0; i < numInj; ++i) {
+                    double injectorVolume = 0.0;
+                    for (int p = 0; p < numProd; ++p) {
+                        injectorVolume += pairVolume[numProd*i + p];
+                    }
+                    for (int p = 0; p < numProd; ++p) {
+                        const double v = pairVolume[numProd*i + p];
+                        os << "  " << std::setw(10) << wellNames[injectors[i]]
+                           << std::setw(10) << wellNames[producers[p]]
+                           << std::setw(16) << v
+                           << std::setw(14) << (injectorVolume > 0.0 ? v / injectorVolume : 0.0) << "\n";
+                    }
+                }
+                os << "\n";
+            }
+        };
+
+        // Total reservoir volume flux of each connection of the grid, the pore
+        // volumes and the net volume leaving the perforated cells as source.
+        void extractFluxes_(Job& job) const
+        {
+            const auto& model = ebosSimulator_.model();
+            const auto& problem = ebosSimulator_.problem();
+            const auto& gridView = ebosSimulator_.gridView();
+            const int nc = model.numGridDof();
+
+            job.numCells = nc;
+            job.porevol.resize(nc);
+            for (int cellIdx = 0; cellIdx < nc; ++cellIdx) {
+                job.porevol[cellIdx] = problem.porosity(cellIdx) * model.dofTotalVolume(cellIdx);
+            }
+
+            ElementContext elemCtx(ebosSimulator_);
+            const auto& elemEndIt = gridView.template end</*codim=*/0>();
+            for (auto elemIt = gridView.template begin</*codim=*/0>();
+                 elemIt != elemEndIt;
+                 ++elemIt)
+            {
+                const auto& elem = *elemIt;
+                elemCtx.updateAll(elem);
+                const unsigned globI = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+                const auto& stencil = elemCtx.stencil(/*timeIdx=*/0);
+                const unsigned numFaces = elemCtx.numInteriorFaces(/*timeIdx=*/0);
+                for (unsigned scvfIdx = 0; scvfIdx < numFaces; ++scvfIdx) {
+                    const auto& extQuants = elemCtx.extensiveQuantities(scvfIdx, /*timeIdx=*/0);
+                    const unsigned globJ = elemCtx.globalSpaceIndex(extQuants.exteriorIndex(), /*timeIdx=*/0);
+                    // every connection is seen from both of its cells
+                    if (globJ < globI) {
+                        continue;
+                    }
+                    double flux = 0.0;
+                    for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
+                        if (FluidSystem::phaseIsActive(phaseIdx)) {
+                            flux += extQuants.volumeFlux(phaseIdx).value();
+                        }
+                    }
+                    flux *= extQuants.extrusionFactor() * stencil.interiorFace(scvfIdx).area();
+                    job.faceCells.push_back(globI);
+                    job.faceCells.push_back(globJ);
+                    job.flux.push_back(flux);
+                }
+            }
+        }
+
+        void extractWells_(const Wells* wells, Job& job) const
+        {
+            // net volume leaving each cell through the connections
+            std::vector<double> outflow(job.numCells, 0.0);
+            const int numFaces = job.flux.size();
+            for (int f = 0; f < numFaces; ++f) {
+                outflow[job.faceCells[2*f]] += job.flux[f];
+                outflow[job.faceCells[2*f + 1]] -= job.flux[f];
+            }
+
+            job.source.assign(job.numCells, 0.0);
+            const int numWells = wells ? wells->number_of_wells : 0;
+            for (int w = 0; w < numWells; ++w) {
+                std::vector<int> cells;
+                if (well_controls_well_is_open(wells->ctrls[w])) {
+                    cells.assign(wells->well_cells + wells->well_connpos[w],
+                                 wells->well_cells + wells->well_connpos[w + 1]);
+                    for (const int cell : cells) {
+                        job.source[cell] = outflow[cell];
+                    }
+                }
+                job.wellNames.push_back(wells->name[w]);
+                job.wellIsInjector.push_back(wells->type[w] == INJECTOR);
+                job.wellCells.push_back(std::move(cells));
+            }
+        }
+
+        const Simulator& ebosSimulator_;
+        bool enabled_;
+        const int interval_;
+        const int numFPhiPoints_;
+        std::string filename_;
+        std::unique_ptr<ThreadHandle> thread_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_FLOWDIAGNOSTICSEBOS_HEADER_INCLUDED
@@ -89,10 +89,15 @@
 #include <omp.h>
 #endif
 
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
 #include <memory>
 #include <algorithm>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <vector>
 #include <numeric>
 #include <cstdlib>
@@ -141,6 +146,7 @@ namespace Opm
             if (!ok) {
                 return EXIT_FAILURE;
             }
+            asImpl().setupMemoryAllocation();
             asImpl().readDeckInput();
             asImpl().setupOutput();
             asImpl().setupLogging();
@@ -355,6 +361,33 @@ namespace Opm
 
 
 
+        // Make the allocator keep the memory freed by the temporaries of the
+        // assembly instead of returning it to the system, such that the next
+        // Newton iteration reuses it without page faults.
+        // Reads the parameter retain_freed_memory_mb, 0 keeps the default
+        // behaviour of the C library.
+        void setupMemoryAllocation()
+        {
+            const int retain_mb = param_.getDefault("retain_freed_memory_mb", 0);
+            if (retain_mb <= 0) {
+                return;
+            }
+#ifdef __GLIBC__
+            // Large blocks are otherwise mapped and unmapped for every allocation.
+            mallopt(M_MMAP_MAX, 0);
+            const int max_mb = std::numeric_limits<int>::max() / (1024 * 1024);
+            mallopt(M_TRIM_THRESHOLD, std::min(retain_mb, max_mb) * 1024 * 1024);
+#else
+            if (output_cout_) {
+                std::cerr << "Warning: retain_freed_memory_mb is only supported with the GNU C library.\n";
+            }
+#endif
+        }
+
+
+
+
+
         // Set output_to_files_ and set/create output dir. Write parameter file.
         // Writes to:
         //   output_to_files_
@@ -560,6 +593,7 @@ namespace Opm
 
             // Rock and fluid properties.
             fluidprops_.reset(new BlackoilPropsAdFromDeck(*deck_, *eclipse_state_, material_law_manager_, grid));
+            fluidprops_->setPropertyCacheTolerance(param_.getDefault("property_cache_tolerance", 0.0));
 
             // Rock compressibility.
             rock_comp_.reset(new RockCompressibility(*eclipse_state_, output_cout_));
@@ -734,7 +768,9 @@ namespace Opm
                     distributeGridAndData(grid_init_->grid(), *deck_, *eclipse_state_, *schedule_,
                                           *state_, *fluidprops_, *geoprops_,
                                           material_law_manager_, threshold_pressures_,
-                                          parallel_information_, use_local_perm_);
+                                          parallel_information_, use_local_perm_,
+                                          param_.getDefault("partition_edge_weights", std::string("transmissibility")),
+                                          param_.getDefault("overlap_layers", 1));
             }
         }
 
@@ -813,7 +849,18 @@ namespace Opm
             const std::string solver_approach = param_.getDefault("solver_approach", flowDefaultSolver);
 
             if (solver_approach == cprSolver) {
-                fis_solver_.reset(new NewtonIterationBlackoilCPR(param_, parallel_information_));
+                // Precondition by BlackoilAmg as flow_ebos does, including
+                // the reuse of its setup, unless the older CPRPreconditioner
+                // is asked for or AMG is not built in.
+                const bool blackoil_amg = param_.getDefault("cpr_use_blackoil_amg", true);
+                if (blackoil_amg && NewtonIterationBlackoilInterleaved::supportsCpr()) {
+                    if (!param_.has("solver_approach")) {
+                        param_.insertParameter("solver_approach", cprSolver);
+                    }
+                    fis_solver_.reset(new NewtonIterationBlackoilInterleaved(param_, parallel_information_));
+                } else {
+                    fis_solver_.reset(new NewtonIterationBlackoilCPR(param_, parallel_information_));
+                }
             } else if (solver_approach == interleavedSolver) {
                 fis_solver_.reset(new NewtonIterationBlackoilInterleaved(param_, parallel_information_));
             } else if (solver_approach == directSolver) {
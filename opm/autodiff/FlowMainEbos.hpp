@@ -26,6 +26,10 @@
 
 #include <sys/utsname.h>
 
+#include <future>
+#include <stdexcept>
+
+#include <opm/simulators/DeferredLogger.hpp>
 #include <opm/simulators/ParallelFileMerger.hpp>
 
 #include <opm/autodiff/BlackoilModelEbos.hpp>
@@ -38,6 +42,7 @@
 
 #include <opm/core/props/satfunc/RelpermDiagnostics.hpp>
 
+#include <opm/common/ErrorMacros.hpp>
 #include <opm/common/OpmLog/OpmLog.hpp>
 #include <opm/common/OpmLog/EclipsePRTLog.hpp>
 #include <opm/common/OpmLog/LogUtil.hpp>
@@ -106,6 +111,7 @@ namespace Opm
                 runDiagnostics();
                 setupLinearSolver();
                 createSimulator();
+                finishKeywordCheck();
 
                 // Run.
                 auto ret =  runSimulator();
@@ -166,6 +172,12 @@ namespace Opm
             } else {
                 std::cout << "OpenMP using " << num_omp_threads << " threads on MPI rank " << mpi_rank_ << "." << std::endl;
             }
+            // Without binding, the threads of the ranks on a node migrate
+            // between the cores and compete for them.
+            if (num_omp_threads > 1 && !getenv("OMP_PROC_BIND") && !getenv("OMP_PLACES") && output_cout_) {
+                std::cout << "OpenMP threads are not bound to cores, consider setting "
+                          << "OMP_PROC_BIND=close and OMP_PLACES=cores." << std::endl;
+            }
 #endif
         }
 
@@ -389,6 +401,13 @@ namespace Opm
 
             argv.push_back("flow_ebos");
 
+            // ebos distributes the grid itself, always with a single layer of
+            // overlap cells; overlap_layers is only used by flow
+            if (param_.getDefault("overlap_layers", 1) != 1) {
+                OPM_THROW(std::invalid_argument, "overlap_layers is not supported by flow_ebos, "
+                          "the grid is distributed with one layer of overlap.");
+            }
+
             std::string deckFileParam("--ecl-deck-file-name=");
             const std::string& deckFileName = param_.get<std::string>("deck_filename");
             deckFileParam += deckFileName;
@@ -431,7 +450,13 @@ namespace Opm
 
             try {
                 if (output_cout_) {
-                    MissingFeatures::checkKeywords(deck());
+                    // The check only reads the deck and keeps its warnings, it
+                    // runs while the rest of the setup goes on, see
+                    // finishKeywordCheck().
+                    const Deck& deck = this->deck();
+                    keyword_check_ = std::async(std::launch::async, [this, &deck]() {
+                            MissingFeatures::checkKeywords(deck, keyword_check_logger_);
+                        });
                 }
 
                 // Possible to force initialization only behavior (NOSIM).
@@ -470,6 +495,18 @@ namespace Opm
         { return ebosSimulator_->vanguard().schedule(); }
 
 
+        // Wait for the check of the keywords started by setupEbosSimulator()
+        // and log its warnings. Collective.
+        // Writes to:
+        //   OpmLog singleton.
+        void finishKeywordCheck()
+        {
+            if (keyword_check_.valid()) {
+                keyword_check_.get();
+            }
+            keyword_check_logger_.logMessages();
+        }
+
         // Run diagnostics.
         // Writes to:
         //   OpmLog singleton.
@@ -625,6 +662,10 @@ namespace Opm
         std::unique_ptr<NewtonIterationBlackoilInterface> fis_solver_;
         std::unique_ptr<Simulator> simulator_;
         std::string logFile_;
+        // the warnings of the check of the keywords of the deck and the check,
+        // which has to finish before its logger is destroyed
+        DeferredLogger keyword_check_logger_;
+        std::future<void> keyword_check_;
     };
 } // namespace Opm
 
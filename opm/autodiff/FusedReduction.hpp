@@ -0,0 +1,110 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_FUSEDREDUCTION_HEADER_INCLUDED
+#define OPM_FUSEDREDUCTION_HEADER_INCLUDED
+
+#include <dune/common/parallel/collectivecommunication.hh>
+#if HAVE_MPI
+#include <dune/common/parallel/mpicollectivecommunication.hh>
+#include <mpi.h>
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace Opm
+{
+namespace detail
+{
+
+    /// \brief Sum the first numSum entries of values and take the maximum of
+    ///        the remaining ones over all processes.
+    ///
+    /// The generic version uses one collective for each operation.
+    template <class Communication>
+    void sumAndMax(const Communication& comm, std::vector<double>& values, const int numSum)
+    {
+        assert(numSum <= int(values.size()));
+        if (comm.size() == 1) {
+            return;
+        }
+        if (numSum > 0) {
+            comm.sum(values.data(), numSum);
+        }
+        if (numSum < int(values.size())) {
+            comm.max(values.data() + numSum, values.size() - numSum);
+        }
+    }
+
+#if HAVE_MPI
+    // The buffer is reduced as a single element of a contiguous type, such
+    // that the operation always sees the whole buffer. Its first entry is the
+    // number of summed entries.
+    inline void sumAndMaxOperation(void* in, void* inout, int* len, MPI_Datatype* type)
+    {
+        int bytes = 0;
+        MPI_Type_size(*type, &bytes);
+        const int size = bytes / sizeof(double);
+        for (int k = 0; k < *len; ++k) {
+            const double* a = static_cast<const double*>(in) + k * size;
+            double* b = static_cast<double*>(inout) + k * size;
+            const int numSum = static_cast<int>(a[0]) + 1;
+            for (int i = 1; i < numSum; ++i) {
+                b[i] += a[i];
+            }
+            for (int i = numSum; i < size; ++i) {
+                b[i] = std::max(b[i], a[i]);
+            }
+        }
+    }
+
+    /// \brief Sum and maximum in a single MPI_Allreduce.
+    inline void sumAndMax(const Dune::CollectiveCommunication<MPI_Comm>& comm,
+                          std::vector<double>& values, const int numSum)
+    {
+        assert(numSum <= int(values.size()));
+        if (comm.size() == 1) {
+            return;
+        }
+
+        static MPI_Op operation = MPI_OP_NULL;
+        if (operation == MPI_OP_NULL) {
+            MPI_Op_create(&sumAndMaxOperation, /*commute=*/1, &operation);
+        }
+
+        std::vector<double> buffer(values.size() + 1);
+        buffer[0] = numSum;
+        std::copy(values.begin(), values.end(), buffer.begin() + 1);
+
+        MPI_Datatype type;
+        MPI_Type_contiguous(buffer.size(), MPI_DOUBLE, &type);
+        MPI_Type_commit(&type);
+        MPI_Allreduce(MPI_IN_PLACE, buffer.data(), 1, type, operation, comm);
+        MPI_Type_free(&type);
+
+        std::copy(buffer.begin() + 1, buffer.end(), values.begin());
+    }
+#endif
+
+} // namespace detail
+} // namespace Opm
+
+#endif // OPM_FUSEDREDUCTION_HEADER_INCLUDED
@@ -22,6 +22,7 @@
 
 #include <opm/grid/UnstructuredGrid.h>
 #include <opm/autodiff/GridHelpers.hpp>
+#include <opm/core/utility/OmpExceptionGuard.hpp>
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/grid/transmissibility/TransTpfa.hpp>
 
@@ -46,6 +47,7 @@
 #include <opm/common/utility/platform_dependent/reenable_warnings.h>
 
 #include <cstddef>
+#include <vector>
 
 namespace Opm
 {
@@ -151,15 +153,18 @@ namespace Opm
             // combine the half-face transmissibilites into the final face
             // transmissibilites.
             tpfa_trans_compute(ug, htrans.data(), trans_.data());
+            unmultiplied_trans_ = trans_;
 
             // multiply the face transmissibilities with their appropriate
             // transmissibility multipliers
             for (int faceIdx = 0; faceIdx < numFaces; faceIdx++) {
                 trans_[faceIdx] *= mult[faceIdx];
             }
+            trans_mult_.swap(mult);
 
             // Create the set of noncartesian connections.
             noncartesian_ = nnc_;
+            findNonCartesianFaces_(grid);
             exportNncStructure(grid);
 
             // Compute z coordinates
@@ -197,6 +202,38 @@ namespace Opm
 
 
 
+        /// Update the transmissibilities after a change of the transmissibility
+        /// multipliers (MULTFLT, MULT[XYZ], MULTREGT) only, e.g. by the SCHEDULE
+        /// section. The geometry is not processed again, only the faces whose
+        /// multiplier changed are updated in place.
+        /// \return The number of faces whose transmissibility changed.
+        template <class Grid>
+        int updateTransMultipliers(const Grid&         grid,
+                                   const EclipseState& eclState)
+        {
+            // No half transmissibilities are passed, so NTG is not applied again.
+            Vector noHalfTrans;
+            std::vector<double> mult;
+            multiplyHalfIntersections_(grid, eclState, std::vector<double>(), noHalfTrans, mult);
+
+            int numChanged = 0;
+            const int numFaces = AutoDiffGrid::numFaces(grid);
+            for (int faceIdx = 0; faceIdx < numFaces; ++faceIdx) {
+                if (mult[faceIdx] != trans_mult_[faceIdx]) {
+                    trans_[faceIdx] = unmultiplied_trans_[faceIdx] * mult[faceIdx];
+                    ++numChanged;
+                }
+            }
+            trans_mult_.swap(mult);
+
+            if (numChanged > 0) {
+                // The non-cartesian connections carry the transmissibilities.
+                noncartesian_ = nnc_;
+                exportNncStructure(grid);
+            }
+            return numChanged;
+        }
+
         const Vector& poreVolume()       const { return pvol_   ;}
         const Vector& transmissibility() const { return trans_  ;}
         const Vector& gravityPotential() const { return gpot_   ;}
@@ -283,6 +320,27 @@ namespace Opm
                                      const double* perm,
                                      Vector &hTrans);
 
+        /// The index of the first cell face of each cell, and the number of
+        /// cell faces at the end, such that the cells can be processed in
+        /// parallel.
+        template <class Grid>
+        static std::vector<int> cellFaceOffsets_(const Grid& grid)
+        {
+            const int numCells = Opm::AutoDiffGrid::numCells(grid);
+            auto cell2Faces = Opm::UgGridHelpers::cell2Faces(grid);
+            std::vector<int> offsets(numCells + 1, 0);
+            for (int cellIdx = 0; cellIdx < numCells; ++cellIdx) {
+                auto cellFacesRange = cell2Faces[cellIdx];
+                int numCellFaces = 0;
+                for (auto cellFaceIter = cellFacesRange.begin(), cellFaceEnd = cellFacesRange.end();
+                     cellFaceIter != cellFaceEnd; ++cellFaceIter) {
+                    ++numCellFaces;
+                }
+                offsets[cellIdx + 1] = offsets[cellIdx] + numCellFaces;
+            }
+            return offsets;
+        }
+
         template <class Grid>
         void minPvFillProps_(const Grid &grid,
                              const EclipseState& eclState,
@@ -308,6 +366,9 @@ namespace Opm
                 eclState.get3DProperties().getIntGridProperty("ACTNUM").getData();
 
 
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
             for (int cellIdx = 0; cellIdx < numCells; ++cellIdx) {
                 const int cellCartIdx = globalCell[cellIdx];
 
@@ -348,55 +409,78 @@ namespace Opm
                                  int numCells);
 
 
-        /// checks cartesian adjacency of global indices g1 and g2
+        /// Find the faces of the given grid that are not cartesian adjacencies,
+        /// i.e. whose global cell indices do not differ by 1, nx or nx*ny.
+        ///
+        /// The faces are checked in parallel and stored in increasing order, so
+        /// the NNC structure can be exported again without searching the grid.
         template <typename Grid>
-        bool cartesianAdjacent(const Grid& grid, int g1, int g2) {
-            int diff = std::abs(g1 - g2);
-
-            const int * dimens = UgGridHelpers::cartDims(grid);
-            if (diff == 1)
-               return true;
-            if (diff == dimens[0])
-               return true;
-            if (diff == dimens[0] * dimens[1])
-               return true;
-
-            return false;
+        void findNonCartesianFaces_(const Grid& grid) {
+            // we use numFaces, faceCells, globalCell from UgGridHelpers
+            using namespace UgGridHelpers;
+
+            const int num_faces = numFaces(grid);
+            const int* global_cell = globalCell(grid);
+            const int* dimens = cartDims(grid);
+            const int strideY = dimens[0];
+            const int strideZ = dimens[0] * dimens[1];
+
+            auto fc = faceCells(grid);
+            std::vector<char> nonCartesian(num_faces, 0);
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
+            for (int i = 0; i < num_faces; ++i) {
+                auto c1 = fc(i, 0);
+                auto c2 = fc(i, 1);
+
+                if (c1 == -1 || c2 == -1)
+                    continue; // face on grid boundary
+                // translate from active cell idx (ac1,ac2) to global cell idx
+                c1 = global_cell ? global_cell[c1] : c1;
+                c2 = global_cell ? global_cell[c2] : c2;
+                const int diff = std::abs(c1 - c2);
+                nonCartesian[i] = (diff != 1 && diff != strideY && diff != strideZ);
+            }
+
+            noncartesian_faces_.clear();
+            for (int i = 0; i < num_faces; ++i) {
+                if (nonCartesian[i]) {
+                    noncartesian_faces_.push_back(i);
+                }
+            }
         }
 
 
         /// Write the NNC structure of the given grid to NNC.
         ///
-        /// Write cell adjacencies beyond Cartesian neighborhoods to NNC.
+        /// Write cell adjacencies beyond Cartesian neighborhoods, as found by
+        /// findNonCartesianFaces_(), to NNC.
         ///
         /// The trans vector is indexed by face number as it is in grid.
         template <typename Grid>
         void exportNncStructure(const Grid& grid) {
-            // we use numFaces, numCells, cell2Faces, globalCell from UgGridHelpers
+            // we use faceCells, globalCell from UgGridHelpers
             using namespace UgGridHelpers;
 
-            size_t num_faces = numFaces(grid);
-
+            const int* global_cell = globalCell(grid);
             auto fc = faceCells(grid);
-            for (size_t i = 0; i < num_faces; ++i) {
+            for (const int i : noncartesian_faces_) {
                 auto c1 = fc(i, 0);
                 auto c2 = fc(i, 1);
-
-                if (c1 == -1 || c2 == -1)
-                    continue; // face on grid boundary
-                // translate from active cell idx (ac1,ac2) to global cell idx
-                c1 = globalCell(grid) ? globalCell(grid)[c1] : c1;
-                c2 = globalCell(grid) ? globalCell(grid)[c2] : c2;
-                if (!cartesianAdjacent(grid, c1, c2)) {
-                    // suppose c1,c2 is specified in ECLIPSE input
-                    // we here overwrite its trans by grid's
-                    noncartesian_.addNNC(c1, c2, trans_[i]);
-                }
+                c1 = global_cell ? global_cell[c1] : c1;
+                c2 = global_cell ? global_cell[c2] : c2;
+                // suppose c1,c2 is specified in ECLIPSE input
+                // we here overwrite its trans by grid's
+                noncartesian_.addNNC(c1, c2, trans_[i]);
             }
         }
 
         Vector pvol_ ;
         Vector trans_;
+        // The transmissibilities before and the factors of the multipliers.
+        Vector unmultiplied_trans_;
+        std::vector<double> trans_mult_;
         Vector gpot_ ;
         Vector z_;
         double gravity_[3]; // Size 3 even if grid is 2-dim.
@@ -406,6 +490,8 @@ namespace Opm
         NNC nnc_;
         // Non-cartesian connections
         NNC noncartesian_;
+        // The faces of the grid that are non-cartesian connections.
+        std::vector<int> noncartesian_faces_;
     };
 
     template <class GridType>
@@ -504,74 +590,104 @@ namespace Opm
         auto cell2Faces = Opm::UgGridHelpers::cell2Faces(grid);
         auto faceCells  = Opm::AutoDiffGrid::faceCells(grid);
         const int* global_cell = Opm::UgGridHelpers::globalCell(grid);
-        int cellFaceIdx = 0;
-
+        const std::vector<int> cellFaceOffsets = cellFaceOffsets_(grid);
+        // Only the multipliers are computed if no half transmissibilities are given.
+        const bool applyNtg = halfIntersectTransmissibility.size() > 0;
+
+        // The multipliers of each cell face are computed in parallel. A face
+        // has two cell faces, so they are applied to the faces afterwards, in
+        // the order of the cells.
+        const int numCellFaces = cellFaceOffsets[numCells];
+        std::vector<double> cellFaceMult(numCellFaces, 1.0);
+        std::vector<double> cellFaceRegionMult(numCellFaces, 1.0);
+        detail::OmpExceptionGuard guard;
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
         for (int cellIdx = 0; cellIdx < numCells; ++cellIdx) {
-            // loop over all logically-Cartesian faces of the current cell
-            auto cellFacesRange = cell2Faces[cellIdx];
-
-            for(auto cellFaceIter = cellFacesRange.begin(), cellFaceEnd = cellFacesRange.end();
-                cellFaceIter != cellFaceEnd; ++cellFaceIter, ++cellFaceIdx)
-            {
-                // the index of the current cell in arrays for the logically-Cartesian grid
-                int cartesianCellIdx = global_cell[cellIdx];
-
-                // The index of the face in the compressed grid
-                int faceIdx = *cellFaceIter;
-
-                // the logically-Cartesian direction of the face
-                int faceTag = Opm::UgGridHelpers::faceTag(grid, cellFaceIter);
-
-                // Translate the C face tag into the enum used by opm-parser's TransMult class
-                Opm::FaceDir::DirEnum faceDirection;
-                if (faceTag == 0) // left
-                    faceDirection = Opm::FaceDir::XMinus;
-                else if (faceTag == 1) // right
-                    faceDirection = Opm::FaceDir::XPlus;
-                else if (faceTag == 2) // back
-                    faceDirection = Opm::FaceDir::YMinus;
-                else if (faceTag == 3) // front
-                    faceDirection = Opm::FaceDir::YPlus;
-                else if (faceTag == 4) // bottom
-                    faceDirection = Opm::FaceDir::ZMinus;
-                else if (faceTag == 5) // top
-                    faceDirection = Opm::FaceDir::ZPlus;
-                else
-                    OPM_THROW(std::logic_error, "Unhandled face direction: " << faceTag);
-
-                // Account for NTG in horizontal one-sided transmissibilities
-                switch (faceDirection) {
-                case Opm::FaceDir::XMinus:
-                case Opm::FaceDir::XPlus:
-                case Opm::FaceDir::YMinus:
-                case Opm::FaceDir::YPlus:
-                    halfIntersectTransmissibility[cellFaceIdx] *= ntg[cartesianCellIdx];
-                    break;
-                default:
-                    // do nothing for the top and bottom faces
-                    break;
-                }
+            try {
+                // loop over all logically-Cartesian faces of the current cell
+                auto cellFacesRange = cell2Faces[cellIdx];
+                int cellFaceIdx = cellFaceOffsets[cellIdx];
+
+                for(auto cellFaceIter = cellFacesRange.begin(), cellFaceEnd = cellFacesRange.end();
+                    cellFaceIter != cellFaceEnd; ++cellFaceIter, ++cellFaceIdx)
+                {
+                    // the index of the current cell in arrays for the logically-Cartesian grid
+                    int cartesianCellIdx = global_cell[cellIdx];
+
+                    // The index of the face in the compressed grid
+                    int faceIdx = *cellFaceIter;
+
+                    // the logically-Cartesian direction of the face
+                    int faceTag = Opm::UgGridHelpers::faceTag(grid, cellFaceIter);
+
+                    // Translate the C face tag into the enum used by opm-parser's TransMult class
+                    Opm::FaceDir::DirEnum faceDirection;
+                    if (faceTag == 0) // left
+                        faceDirection = Opm::FaceDir::XMinus;
+                    else if (faceTag == 1) // right
+                        faceDirection = Opm::FaceDir::XPlus;
+                    else if (faceTag == 2) // back
+                        faceDirection = Opm::FaceDir::YMinus;
+                    else if (faceTag == 3) // front
+                        faceDirection = Opm::FaceDir::YPlus;
+                    else if (faceTag == 4) // bottom
+                        faceDirection = Opm::FaceDir::ZMinus;
+                    else if (faceTag == 5) // top
+                        faceDirection = Opm::FaceDir::ZPlus;
+                    else
+                        OPM_THROW(std::logic_error, "Unhandled face direction: " << faceTag);
+
+                    // Account for NTG in horizontal one-sided transmissibilities
+                    switch (faceDirection) {
+                    case Opm::FaceDir::XMinus:
+                    case Opm::FaceDir::XPlus:
+                    case Opm::FaceDir::YMinus:
+                    case Opm::FaceDir::YPlus:
+                        if (applyNtg) {
+                            halfIntersectTransmissibility[cellFaceIdx] *= ntg[cartesianCellIdx];
+                        }
+                        break;
+                    default:
+                        // do nothing for the top and bottom faces
+                        break;
+                    }
 
-                // Multiplier contribution on this face for MULT[XYZ] logical cartesian multipliers
-                intersectionTransMult[faceIdx] *=
-                    multipliers.getMultiplier(cartesianCellIdx, faceDirection);
+                    // Multiplier contribution on this face for MULT[XYZ] logical cartesian multipliers
+                    cellFaceMult[cellFaceIdx] = multipliers.getMultiplier(cartesianCellIdx, faceDirection);
 
-                // Multiplier contribution on this fase for region multipliers
-                const int cellIdxInside  = faceCells(faceIdx, 0);
-                const int cellIdxOutside = faceCells(faceIdx, 1);
+                    // Multiplier contribution on this fase for region multipliers
+                    const int cellIdxInside  = faceCells(faceIdx, 0);
+                    const int cellIdxOutside = faceCells(faceIdx, 1);
 
-                // Do not apply region multipliers in the case of boundary connections
-                if (cellIdxInside < 0 || cellIdxOutside < 0) {
-                    continue;
-                }
-                const int cartesianCellIdxInside = global_cell[cellIdxInside];
-                const int cartesianCellIdxOutside = global_cell[cellIdxOutside];
-                //  Only apply the region multipliers from the inside
-                if (cartesianCellIdx == cartesianCellIdxInside) {
-                    intersectionTransMult[faceIdx] *= multipliers.getRegionMultiplier(cartesianCellIdxInside,cartesianCellIdxOutside,faceDirection);
+                    // Do not apply region multipliers in the case of boundary connections
+                    if (cellIdxInside < 0 || cellIdxOutside < 0) {
+                        continue;
+                    }
+                    const int cartesianCellIdxInside = global_cell[cellIdxInside];
+                    const int cartesianCellIdxOutside = global_cell[cellIdxOutside];
+                    //  Only apply the region multipliers from the inside
+                    if (cartesianCellIdx == cartesianCellIdxInside) {
+                        cellFaceRegionMult[cellFaceIdx] = multipliers.getRegionMultiplier(cartesianCellIdxInside,cartesianCellIdxOutside,faceDirection);
+                    }
                 }
+            }
+            catch (...) {
+                guard.capture();
+            }
+        }
+        guard.rethrow();
 
-
+        for (int cellIdx = 0; cellIdx < numCells; ++cellIdx) {
+            auto cellFacesRange = cell2Faces[cellIdx];
+            int cellFaceIdx = cellFaceOffsets[cellIdx];
+            for(auto cellFaceIter = cellFacesRange.begin(), cellFaceEnd = cellFacesRange.end();
+                cellFaceIter != cellFaceEnd; ++cellFaceIter, ++cellFaceIdx)
+            {
+                const int faceIdx = *cellFaceIter;
+                intersectionTransMult[faceIdx] *= cellFaceMult[cellFaceIdx];
+                intersectionTransMult[faceIdx] *= cellFaceRegionMult[cellFaceIdx];
             }
         }
     }
@@ -588,64 +704,75 @@ namespace Opm
         // to face centroid and N is the normal vector  pointing outwards with norm equal to the face area.
         // Off-diagonal permeability values are ignored without warning
         int numCells = AutoDiffGrid::numCells(grid);
-        int cellFaceIdx = 0;
         auto cell2Faces = Opm::UgGridHelpers::cell2Faces(grid);
         auto faceCells = Opm::UgGridHelpers::faceCells(grid);
+        const std::vector<int> cellFaceOffsets = cellFaceOffsets_(grid);
 
+        detail::OmpExceptionGuard guard;
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
         for (int cellIdx = 0; cellIdx < numCells; ++cellIdx) {
-            // loop over all logically-Cartesian faces of the current cell
-            auto cellFacesRange = cell2Faces[cellIdx];
-
-            for(auto cellFaceIter = cellFacesRange.begin(), cellFaceEnd = cellFacesRange.end();
-                cellFaceIter != cellFaceEnd; ++cellFaceIter, ++cellFaceIdx)
-            {
-                // The index of the face in the compressed grid
-                const int faceIdx = *cellFaceIter;
-
-                // the logically-Cartesian direction of the face
-                const int faceTag = Opm::UgGridHelpers::faceTag(grid, cellFaceIter);
-
-                // d = 0: XPERM d = 4: YPERM d = 8: ZPERM ignores off-diagonal permeability values.
-                const int d = std::floor(faceTag/2) * 4;
-
-                // compute the half transmissibility
-                double dist = 0.0;
-                double cn = 0.0;
-                double sgn = 2.0 * (faceCells(faceIdx, 0) == cellIdx) - 1;
-                const int dim = Opm::UgGridHelpers::dimensions(grid);
-
-                int cartesianCellIdx = AutoDiffGrid::globalCell(grid)[cellIdx];
-                auto cellCenter = eclGrid.getCellCenter(cartesianCellIdx);
-                const auto& faceCenter = Opm::UgGridHelpers::faceCenterEcl(grid, cellIdx, faceTag);
-                const auto& faceAreaNormalEcl = Opm::UgGridHelpers::faceAreaNormalEcl(grid, faceIdx);
-
-                for (int indx = 0; indx < dim; ++indx) {
-                    const double Ci = faceCenter[indx] - cellCenter[indx];
-                    dist += Ci*Ci;
-                    cn += sgn * Ci * faceAreaNormalEcl[ indx ];
-                }
+            try {
+                // loop over all logically-Cartesian faces of the current cell
+                auto cellFacesRange = cell2Faces[cellIdx];
+                int cellFaceIdx = cellFaceOffsets[cellIdx];
+
+                for(auto cellFaceIter = cellFacesRange.begin(), cellFaceEnd = cellFacesRange.end();
+                    cellFaceIter != cellFaceEnd; ++cellFaceIter, ++cellFaceIdx)
+                {
+                    // The index of the face in the compressed grid
+                    const int faceIdx = *cellFaceIter;
+
+                    // the logically-Cartesian direction of the face
+                    const int faceTag = Opm::UgGridHelpers::faceTag(grid, cellFaceIter);
+
+                    // d = 0: XPERM d = 4: YPERM d = 8: ZPERM ignores off-diagonal permeability values.
+                    const int d = std::floor(faceTag/2) * 4;
+
+                    // compute the half transmissibility
+                    double dist = 0.0;
+                    double cn = 0.0;
+                    double sgn = 2.0 * (faceCells(faceIdx, 0) == cellIdx) - 1;
+                    const int dim = Opm::UgGridHelpers::dimensions(grid);
+
+                    int cartesianCellIdx = AutoDiffGrid::globalCell(grid)[cellIdx];
+                    auto cellCenter = eclGrid.getCellCenter(cartesianCellIdx);
+                    const auto& faceCenter = Opm::UgGridHelpers::faceCenterEcl(grid, cellIdx, faceTag);
+                    const auto& faceAreaNormalEcl = Opm::UgGridHelpers::faceAreaNormalEcl(grid, faceIdx);
+
+                    for (int indx = 0; indx < dim; ++indx) {
+                        const double Ci = faceCenter[indx] - cellCenter[indx];
+                        dist += Ci*Ci;
+                        cn += sgn * Ci * faceAreaNormalEcl[ indx ];
+                    }
 
-                if (cn < 0){
-                    switch (d) {
-                    case 0:
-                        OPM_MESSAGE("Warning: negative X-transmissibility value in cell: " << cellIdx << " replace by absolute value") ;
-                                break;
-                    case 4:
-                        OPM_MESSAGE("Warning: negative Y-transmissibility value in cell: " << cellIdx << " replace by absolute value") ;
-                                break;
-                    case 8:
-                        OPM_MESSAGE("Warning: negative Z-transmissibility value in cell: " << cellIdx << " replace by absolute value") ;
-                                break;
-                    default:
-                        OPM_THROW(std::logic_error, "Inconsistency in the faceTag in cell: " << cellIdx);
+                    if (cn < 0){
+                        switch (d) {
+                        case 0:
+                            OPM_MESSAGE("Warning: negative X-transmissibility value in cell: " << cellIdx << " replace by absolute value") ;
+                                    break;
+                        case 4:
+                            OPM_MESSAGE("Warning: negative Y-transmissibility value in cell: " << cellIdx << " replace by absolute value") ;
+                                    break;
+                        case 8:
+                            OPM_MESSAGE("Warning: negative Z-transmissibility value in cell: " << cellIdx << " replace by absolute value") ;
+                                    break;
+                        default:
+                            OPM_THROW(std::logic_error, "Inconsistency in the faceTag in cell: " << cellIdx);
 
+                        }
+                        cn = -cn;
                     }
-                    cn = -cn;
-                }
-                hTrans[cellFaceIdx] = perm[cellIdx*dim*dim + d] * cn / dist;
+                    hTrans[cellFaceIdx] = perm[cellIdx*dim*dim + d] * cn / dist;
 
+                }
+            }
+            catch (...) {
+                guard.capture();
             }
         }
+        guard.rethrow();
 
     }
 
@@ -22,13 +22,19 @@
 
 #include <opm/autodiff/BlackoilAmg.hpp>
 #include <opm/autodiff/CPRPreconditioner.hpp>
+#include <opm/autodiff/KrylovSolvers.hpp>
+#include <opm/autodiff/LinearSolverTelemetry.hpp>
+#include <opm/autodiff/LinearSolverTuner.hpp>
+#include <opm/simulators/ProfileScope.hpp>
 #include <opm/autodiff/NewtonIterationBlackoilInterleaved.hpp>
 #include <opm/autodiff/NewtonIterationUtilities.hpp>
 #include <opm/autodiff/ParallelRestrictedAdditiveSchwarz.hpp>
 #include <opm/autodiff/ParallelOverlappingILU0.hpp>
+#include <opm/autodiff/SubdomainDirectSolver.hpp>
 #include <opm/autodiff/AutoDiffHelpers.hpp>
 
 #include <opm/common/Exceptions.hpp>
+#include <opm/common/OpmLog/OpmLog.hpp>
 #include <opm/core/linalg/ParallelIstlInformation.hpp>
 #include <opm/common/utility/platform_dependent/disable_warnings.h>
 
@@ -41,6 +47,10 @@
 
 #include <opm/common/utility/platform_dependent/reenable_warnings.h>
 
+#include <fstream>
+#include <memory>
+#include <string>
+
 namespace Dune
 {
 namespace FMatrixHelp {
@@ -362,8 +372,16 @@ namespace Detail
         : iterations_( 0 ),
           parallelInformation_(parallelInformation_arg),
           isIORank_(isIORank(parallelInformation_arg)),
-          parameters_( param )
+          parameters_( param ),
+          linearSolverReduction_( parameters_.linear_solver_reduction_ ),
+          reusablePrecondMatrix_( nullptr ),
+          reusablePrecondNnz_( 0 ),
+          solvesSinceRebuild_( 0 ),
+          iterationsAfterRebuild_( 0 ),
+          seqMatrixOperatorMatrix_( nullptr )
         {
+            openTelemetryFile();
+            setupTuner();
         }
 
         /// Construct a system solver.
@@ -375,8 +393,16 @@ namespace Detail
         : iterations_( 0 ),
           parallelInformation_(parallelInformation_arg),
           isIORank_(isIORank(parallelInformation_arg)),
-          parameters_( param )
+          parameters_( param ),
+          linearSolverReduction_( parameters_.linear_solver_reduction_ ),
+          reusablePrecondMatrix_( nullptr ),
+          reusablePrecondNnz_( 0 ),
+          solvesSinceRebuild_( 0 ),
+          iterationsAfterRebuild_( 0 ),
+          seqMatrixOperatorMatrix_( nullptr )
         {
+            openTelemetryFile();
+            setupTuner();
         }
 
         // dummy method that is not implemented for this class
@@ -414,49 +440,72 @@ namespace Detail
                                              Dune::InverseOperatorResult& result) const
         {
             // Construct scalar product.
-#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 6)
-            auto sp = Dune::createScalarProduct<Vector,POrComm>(parallelInformation_arg, category);
-#else
-            typedef Dune::ScalarProductChooser<Vector, POrComm, category> ScalarProductChooser;
-            typedef std::unique_ptr<typename ScalarProductChooser::ScalarProduct> SPPointer;
-            SPPointer sp(ScalarProductChooser::construct(parallelInformation_arg));
-#endif
+            auto sp = scalarProduct<category>( parallelInformation_arg );
 
             // Communicate if parallel.
             parallelInformation_arg.copyOwnerToAll(istlb, istlb);
 
+            // Preconditioners that are reused store pointers to the operator and
+            // the communication. We only keep them in sequential runs, where the
+            // matrix is the only object that has to outlive this call.
+            const bool reuse = parameters_.prec_reuse_ != PreconditionerReuse::NEVER &&
+                std::is_same< POrComm, Dune::Amg::SequentialInformation >::value;
+
+            if ( reuse && ! preconditionerNeedsRebuild( linearOperator.getmat() ) )
+            {
+                // The right hand side might get modified by the solver.
+                rhsCopy_ = istlb;
+                solve(linearOperator, x, istlb, *sp, *reusablePrecond_, parallelInformation_arg, result);
+                ++solvesSinceRebuild_;
+
+                const double allowedIterations = ( 1.0 + parameters_.prec_reuse_iteration_growth_ ) *
+                    std::max( iterationsAfterRebuild_, 1 );
+                if ( parameters_.prec_reuse_iteration_growth_ >= 0.0 &&
+                     result.iterations > allowedIterations )
+                {
+                    // Iteration count degraded, force a fresh build next time.
+                    reusablePrecond_.reset();
+                }
+
+                if ( result.converged )
+                {
+                    return;
+                }
+                // The stale preconditioner failed, retry with a fresh one.
+                reusablePrecond_.reset();
+                istlb = rhsCopy_;
+                x = 0.0;
+            }
+
 #if FLOW_SUPPORT_AMG // activate AMG if either flow_ebos is used or UMFPack is not available
             if( parameters_.linear_solver_use_amg_ || parameters_.use_cpr_)
             {
                 typedef ISTLUtility::CPRSelector< Matrix, Vector, Vector, POrComm>  CPRSelectorType;
                 typedef typename CPRSelectorType::Operator MatrixOperator;
 
-                std::unique_ptr< MatrixOperator > opA;
+                std::shared_ptr< MatrixOperator > opA;
 
                 if( ! std::is_same< LinearOperator, MatrixOperator > :: value )
                 {
                     // create new operator in case linear operator and matrix operator differ
-                    opA.reset( CPRSelectorType::makeOperator( linearOperator.getmat(), parallelInformation_arg ) );
+                    opA = matrixOperator<CPRSelectorType>( linearOperator.getmat(), parallelInformation_arg );
                 }
 
                 const double relax = parameters_.ilu_relaxation_;
                 const MILU_VARIANT ilu_milu  = parameters_.ilu_milu_;
                 if (  parameters_.use_cpr_ )
                 {
-                    using Matrix         = typename MatrixOperator::matrix_type;
-                    using CouplingMetric = Dune::Amg::Diagonal<pressureIndex>;
-                    using CritBase       = Dune::Amg::SymmetricCriterion<Matrix, CouplingMetric>;
-                    using Criterion      = Dune::Amg::CoarsenCriterion<CritBase>;
-                    using AMG = typename ISTLUtility
-                        ::BlackoilAmgSelector< Matrix, Vector, Vector,POrComm, Criterion, pressureIndex >::AMG;
-
-                    std::unique_ptr< AMG > amg;
-                    // Construct preconditioner.
-                    Criterion crit(15, 2000);
-                    constructAMGPrecond<Criterion>( linearOperator, parallelInformation_arg, amg, opA, relax, ilu_milu );
-
-                    // Solve.
-                    solve(linearOperator, x, istlb, *sp, *amg, result);
+                    if ( parameters_.ilu_mixed_precision_ )
+                    {
+                        // fine level smoother stores its factors in single precision
+                        constructCPRAndSolve<float>( linearOperator, x, istlb, *sp, parallelInformation_arg,
+                                                     opA, relax, ilu_milu, reuse, result );
+                    }
+                    else
+                    {
+                        constructCPRAndSolve<Scalar>( linearOperator, x, istlb, *sp, parallelInformation_arg,
+                                                      opA, relax, ilu_milu, reuse, result );
+                    }
                 }
                 else
                 {
@@ -467,20 +516,234 @@ namespace Detail
                     constructAMGPrecond( linearOperator, parallelInformation_arg, amg, opA, relax, ilu_milu );
 
                     // Solve.
-                    solve(linearOperator, x, istlb, *sp, *amg, result);
+                    solve(linearOperator, x, istlb, *sp, *amg, parallelInformation_arg, result);
+
+                    // The AMG references the operator. It can only be kept if we own it.
+                    if ( reuse && opA )
+                    {
+                        storePreconditioner( std::move(amg), std::move(opA), linearOperator.getmat(), result );
+                    }
                 }
             }
             else
 #endif
+#if HAVE_UMFPACK
+            if ( parameters_.linear_solver_subdomain_solver_ == SubdomainSolver::UMFPACK )
+            {
+                // Construct preconditioner solving each subdomain exactly.
+                auto precond = constructDirectSubdomainPrecond(linearOperator, parallelInformation_arg);
+
+                // Solve.
+                solve(linearOperator, x, istlb, *sp, *precond, parallelInformation_arg, result);
+
+                if ( reuse )
+                {
+                    storePreconditioner( std::move(precond), std::shared_ptr<void>(),
+                                         linearOperator.getmat(), result );
+                }
+            }
+            else
+#endif // HAVE_UMFPACK
+            if ( parameters_.ilu_mixed_precision_ )
+            {
+                // Construct preconditioner with factors in single precision.
+                auto precond = constructMixedPrecisionPrecond(linearOperator, parallelInformation_arg);
+
+                // Solve.
+                solve(linearOperator, x, istlb, *sp, *precond, parallelInformation_arg, result);
+
+                if ( reuse )
+                {
+                    storePreconditioner( std::move(precond), std::shared_ptr<void>(),
+                                         linearOperator.getmat(), result );
+                }
+            }
+            else
             {
                 // Construct preconditioner.
                 auto precond = constructPrecond(linearOperator, parallelInformation_arg);
 
                 // Solve.
-                solve(linearOperator, x, istlb, *sp, *precond, result);
+                solve(linearOperator, x, istlb, *sp, *precond, parallelInformation_arg, result);
+
+                if ( reuse )
+                {
+                    storePreconditioner( std::move(precond), std::shared_ptr<void>(),
+                                         linearOperator.getmat(), result );
+                }
             }
         }
 
+#if FLOW_SUPPORT_AMG
+        /// \brief Construct the CPR preconditioner and solve.
+        /// \tparam StorageField The field type used to store the fine level smoother.
+        template<class StorageField, class LinearOperator, class ScalarProd, class POrComm, class MatrixOperator>
+        void constructCPRAndSolve(LinearOperator& linearOperator, Vector& x, Vector& istlb,
+                                  ScalarProd& sp, const POrComm& parallelInformation_arg,
+                                  std::shared_ptr< MatrixOperator >& opA, const double relax,
+                                  const MILU_VARIANT ilu_milu, const bool reuse,
+                                  Dune::InverseOperatorResult& result) const
+        {
+            using Matrix         = typename MatrixOperator::matrix_type;
+            using CouplingMetric = Dune::Amg::Diagonal<pressureIndex>;
+            using CritBase       = Dune::Amg::SymmetricCriterion<Matrix, CouplingMetric>;
+            using Criterion      = Dune::Amg::CoarsenCriterion<CritBase>;
+            using AMG = typename ISTLUtility
+                ::BlackoilAmgSelector< Matrix, Vector, Vector,POrComm, Criterion, pressureIndex, StorageField >::AMG;
+
+            // The coarsening is kept between linear solves until the next report step.
+            std::shared_ptr< typename AMG::SetupCache > cache;
+            if ( parameters_.cpr_reuse_setup_ )
+            {
+                if ( ! cprSetupCache_ )
+                {
+                    cprSetupCache_ = std::make_shared< typename AMG::SetupCache >();
+                }
+                cache = std::static_pointer_cast< typename AMG::SetupCache >( cprSetupCache_ );
+            }
+
+            std::unique_ptr< AMG > amg;
+            // Construct preconditioner.
+            constructAMGPrecond<Criterion>( linearOperator, parallelInformation_arg, amg, opA, relax, ilu_milu, cache );
+
+            // Solve.
+            solve(linearOperator, x, istlb, sp, *amg, parallelInformation_arg, result);
+
+            // The AMG references the operator. It can only be kept if we own it.
+            if ( reuse && opA )
+            {
+                storePreconditioner( std::move(amg), std::move(opA), linearOperator.getmat(), result );
+            }
+        }
+#endif
+
+        /// \brief The scalar product of the linear solves.
+        ///
+        /// The scalar product of sequential runs has no state, it is created once
+        /// and kept. In parallel runs it refers to the communication passed in,
+        /// which is only valid for one solve.
+#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 6)
+        template<Dune::SolverCategory::Category category, class POrComm>
+        std::shared_ptr< Dune::ScalarProduct<Vector> >
+#else
+        template<int category, class POrComm>
+        std::shared_ptr< typename Dune::ScalarProductChooser<Vector, POrComm, category>::ScalarProduct >
+#endif
+        scalarProduct( const POrComm& parallelInformation_arg ) const
+        {
+#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 6)
+            typedef Dune::ScalarProduct<Vector> ScalarProduct;
+#else
+            typedef Dune::ScalarProductChooser<Vector, POrComm, category> ScalarProductChooser;
+            typedef typename ScalarProductChooser::ScalarProduct ScalarProduct;
+#endif
+            const bool sequential = std::is_same< POrComm, Dune::Amg::SequentialInformation >::value;
+            if ( sequential && seqScalarProduct_ )
+            {
+                return std::static_pointer_cast< ScalarProduct >( seqScalarProduct_ );
+            }
+#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 6)
+            std::shared_ptr< ScalarProduct > sp = Dune::createScalarProduct<Vector,POrComm>(parallelInformation_arg, category);
+#else
+            std::shared_ptr< ScalarProduct > sp( ScalarProductChooser::construct(parallelInformation_arg) );
+#endif
+            if ( sequential )
+            {
+                seqScalarProduct_ = sp;
+            }
+            return sp;
+        }
+
+#if FLOW_SUPPORT_AMG
+        /// \brief The matrix operator of the AMG and CPR preconditioners for matrix A.
+        ///
+        /// In sequential runs the operator only refers to the matrix of the
+        /// linearizer, which keeps its address between the linear solves, hence it
+        /// is created once per matrix object and kept. In parallel runs it refers
+        /// to the communication passed in, which is only valid for one solve.
+        template<class CPRSelectorType, class POrComm>
+        std::shared_ptr< typename CPRSelectorType::Operator >
+        matrixOperator( const Matrix& A, const POrComm& parallelInformation_arg ) const
+        {
+            typedef typename CPRSelectorType::Operator MatrixOperator;
+            const bool sequential = std::is_same< POrComm, Dune::Amg::SequentialInformation >::value;
+            if ( sequential && seqMatrixOperator_ && seqMatrixOperatorMatrix_ == &A )
+            {
+                return std::static_pointer_cast< MatrixOperator >( seqMatrixOperator_ );
+            }
+            std::shared_ptr< MatrixOperator > opA( CPRSelectorType::makeOperator( A, parallelInformation_arg ) );
+            if ( sequential )
+            {
+                seqMatrixOperator_ = opA;
+                seqMatrixOperatorMatrix_ = &A;
+            }
+            return opA;
+        }
+#endif
+
+        /// \brief Notify the solver that a new time step starts.
+        ///
+        /// With the timestep reuse policy the preconditioner is rebuilt for the
+        /// next linear solve.
+        void beginTimeStep() const
+        {
+            if ( parameters_.prec_reuse_ == PreconditionerReuse::TIMESTEP )
+            {
+                reusablePrecond_.reset();
+            }
+        }
+
+        /// \brief Set the relative reduction of the residual required by the next linear solves.
+        void setLinearSolverReduction( const double reduction ) const
+        {
+            linearSolverReduction_ = reduction;
+        }
+
+        /// \brief The relative reduction of the residual required by the linear solves.
+        double linearSolverReduction() const
+        {
+            return linearSolverReduction_;
+        }
+
+        /// \brief Notify the solver that a new report step starts.
+        ///
+        /// Wells and schedule might change the coupling of the pressure system,
+        /// hence the kept CPR coarsening is discarded.
+        void beginReportStep() const
+        {
+            cprSetupCache_.reset();
+        }
+
+        /// \brief Whether the stored preconditioner cannot be used for matrix A.
+        bool preconditionerNeedsRebuild( const Matrix& A ) const
+        {
+            if ( ! reusablePrecond_ || reusablePrecondMatrix_ != &A ||
+                 reusablePrecondNnz_ != A.nonzeroes() )
+            {
+                return true;
+            }
+            if ( parameters_.prec_reuse_ == PreconditionerReuse::INTERVAL )
+            {
+                return solvesSinceRebuild_ >= parameters_.prec_reuse_interval_;
+            }
+            return false;
+        }
+
+        /// \brief Keep a freshly built preconditioner for the next linear solves.
+        /// \param precond The preconditioner.
+        /// \param op      Operator referenced by the preconditioner (may be empty).
+        /// \param A       The matrix the preconditioner was built for.
+        void storePreconditioner( std::shared_ptr< Dune::Preconditioner< Vector, Vector > > precond,
+                                  std::shared_ptr< void > op, const Matrix& A,
+                                  const Dune::InverseOperatorResult& result ) const
+        {
+            reusablePrecondOperator_ = op;
+            reusablePrecond_ = precond;
+            reusablePrecondMatrix_ = &A;
+            reusablePrecondNnz_ = A.nonzeroes();
+            solvesSinceRebuild_ = 1;
+            iterationsAfterRebuild_ = result.iterations;
+        }
 
 	// 3x3 matrix block inversion was unstable at least 2.3 until and including
 	// 2.5.0. There may still be some issue with the 4x4 matrix block inversion
@@ -492,17 +755,69 @@ namespace Detail
 
 
         template <class Operator>
-        std::unique_ptr<SeqPreconditioner> constructPrecond(Operator& opA, const Dune::Amg::SequentialInformation&) const
+        std::shared_ptr<SeqPreconditioner> constructPrecond(Operator& opA, const Dune::Amg::SequentialInformation&) const
         {
+            ProfileScope scope( "preconditioner setup" );
             const double relax   = parameters_.ilu_relaxation_;
             const int ilu_fillin = parameters_.ilu_fillin_level_;
             const MILU_VARIANT ilu_milu  = parameters_.ilu_milu_;
             const bool ilu_redblack = parameters_.ilu_redblack_;
             const bool ilu_reorder_spheres = parameters_.ilu_reorder_sphere_;
-            std::unique_ptr<SeqPreconditioner> precond(new SeqPreconditioner(opA.getmat(), ilu_fillin, relax, ilu_milu, ilu_redblack, ilu_reorder_spheres));
+            const bool ilu_level_scheduling = parameters_.ilu_level_scheduling_;
+            const bool ilu_reorder_rcm = parameters_.ilu_reorder_rcm_;
+
+            // For ILU(n) the symbolic factorization is expensive, and so is the
+            // coloring of a reordered ILU(0). Reuse them as long as the sparsity
+            // pattern stays the same.
+            const bool reuse_pattern = ilu_fillin > 0 || ilu_redblack || ilu_reorder_rcm;
+            if ( reuse_pattern && seqIluCache_ && seqIluCache_->update( opA.getmat() ) )
+            {
+                return seqIluCache_;
+            }
+
+            std::shared_ptr<SeqPreconditioner> precond(new SeqPreconditioner(opA.getmat(), ilu_fillin, relax, ilu_milu, ilu_redblack, ilu_reorder_spheres,
+                                                                             ilu_level_scheduling, ilu_reorder_rcm));
+            if ( reuse_pattern )
+            {
+                seqIluCache_ = precond;
+            }
             return precond;
         }
 
+        typedef ParallelOverlappingILU0<Dune::BCRSMatrix<Dune::MatrixBlock<typename Matrix::field_type,
+                                                                           Matrix::block_type::rows,
+                                                                           Matrix::block_type::cols> >,
+                                        Vector, Vector, Dune::Amg::SequentialInformation, float> SeqMixedPrecisionPreconditioner;
+
+        template <class Operator>
+        std::unique_ptr<SeqMixedPrecisionPreconditioner>
+        constructMixedPrecisionPrecond(Operator& opA, const Dune::Amg::SequentialInformation&) const
+        {
+            ProfileScope scope( "preconditioner setup" );
+            typedef std::unique_ptr<SeqMixedPrecisionPreconditioner> Pointer;
+            const double relax   = parameters_.ilu_relaxation_;
+            const int ilu_fillin = parameters_.ilu_fillin_level_;
+            const MILU_VARIANT ilu_milu  = parameters_.ilu_milu_;
+            const bool ilu_redblack = parameters_.ilu_redblack_;
+            const bool ilu_reorder_spheres = parameters_.ilu_reorder_sphere_;
+            const bool ilu_level_scheduling = parameters_.ilu_level_scheduling_;
+            const bool ilu_reorder_rcm = parameters_.ilu_reorder_rcm_;
+            return Pointer(new SeqMixedPrecisionPreconditioner(opA.getmat(), ilu_fillin, relax, ilu_milu, ilu_redblack,
+                                                               ilu_reorder_spheres, ilu_level_scheduling, ilu_reorder_rcm));
+        }
+
+#if HAVE_UMFPACK
+        typedef SubdomainDirectSolver<Matrix, Vector, Vector> SeqDirectPreconditioner;
+
+        template <class Operator>
+        std::unique_ptr<SeqDirectPreconditioner>
+        constructDirectSubdomainPrecond(Operator& opA, const Dune::Amg::SequentialInformation&) const
+        {
+            ProfileScope scope( "preconditioner setup" );
+            return std::unique_ptr<SeqDirectPreconditioner>(new SeqDirectPreconditioner(opA.getmat()));
+        }
+#endif // HAVE_UMFPACK
+
 #if HAVE_MPI
         typedef Dune::OwnerOverlapCopyCommunication<int, int> Comm;
 #if DUNE_VERSION_NEWER_REV(DUNE_ISTL, 2 , 5, 1)
@@ -519,72 +834,141 @@ namespace Detail
         std::unique_ptr<ParPreconditioner>
         constructPrecond(Operator& opA, const Comm& comm) const
         {
+            ProfileScope scope( "preconditioner setup" );
             typedef std::unique_ptr<ParPreconditioner> Pointer;
             const double relax  = parameters_.ilu_relaxation_;
             const MILU_VARIANT ilu_milu  = parameters_.ilu_milu_;
             const bool ilu_redblack = parameters_.ilu_redblack_;
             const bool ilu_reorder_spheres = parameters_.ilu_reorder_sphere_;
-            return Pointer(new ParPreconditioner(opA.getmat(), comm, relax, ilu_milu, ilu_redblack, ilu_reorder_spheres));
+            const bool ilu_level_scheduling = parameters_.ilu_level_scheduling_;
+            const bool ilu_reorder_rcm = parameters_.ilu_reorder_rcm_;
+            return Pointer(new ParPreconditioner(opA.getmat(), comm, relax, ilu_milu, ilu_redblack, ilu_reorder_spheres,
+                                                 ilu_level_scheduling, ilu_reorder_rcm));
+        }
+
+        typedef ParallelOverlappingILU0<typename ParPreconditioner::matrix_type,Vector,Vector,Comm,float> ParMixedPrecisionPreconditioner;
+
+        template <class Operator>
+        std::unique_ptr<ParMixedPrecisionPreconditioner>
+        constructMixedPrecisionPrecond(Operator& opA, const Comm& comm) const
+        {
+            ProfileScope scope( "preconditioner setup" );
+            typedef std::unique_ptr<ParMixedPrecisionPreconditioner> Pointer;
+            const double relax  = parameters_.ilu_relaxation_;
+            const MILU_VARIANT ilu_milu  = parameters_.ilu_milu_;
+            const bool ilu_redblack = parameters_.ilu_redblack_;
+            const bool ilu_reorder_spheres = parameters_.ilu_reorder_sphere_;
+            const bool ilu_level_scheduling = parameters_.ilu_level_scheduling_;
+            const bool ilu_reorder_rcm = parameters_.ilu_reorder_rcm_;
+            return Pointer(new ParMixedPrecisionPreconditioner(opA.getmat(), comm, relax, ilu_milu, ilu_redblack,
+                                                               ilu_reorder_spheres, ilu_level_scheduling, ilu_reorder_rcm));
         }
+
+#if HAVE_UMFPACK
+        typedef ParallelRestrictedOverlappingSchwarz<Vector, Vector, Comm, SeqDirectPreconditioner> ParDirectPreconditioner;
+
+        /// \brief Solve the subdomain of each process including its overlap
+        ///        exactly, combined by restricted additive Schwarz.
+        template <class Operator>
+        std::unique_ptr<ParDirectPreconditioner>
+        constructDirectSubdomainPrecond(Operator& opA, const Comm& comm) const
+        {
+            ProfileScope scope( "preconditioner setup" );
+            std::unique_ptr<SeqDirectPreconditioner> local(new SeqDirectPreconditioner(opA.getmat()));
+            return std::unique_ptr<ParDirectPreconditioner>(new ParDirectPreconditioner(std::move(local), comm));
+        }
+#endif // HAVE_UMFPACK
 #endif
 
         template <class LinearOperator, class MatrixOperator, class POrComm, class AMG >
         void
-        constructAMGPrecond(LinearOperator& /* linearOperator */, const POrComm& comm, std::unique_ptr< AMG >& amg, std::unique_ptr< MatrixOperator >& opA, const double relax, const MILU_VARIANT milu) const
+        constructAMGPrecond(LinearOperator& /* linearOperator */, const POrComm& comm, std::unique_ptr< AMG >& amg, std::shared_ptr< MatrixOperator >& opA, const double relax, const MILU_VARIANT milu) const
         {
+            ProfileScope scope( "preconditioner setup" );
             ISTLUtility::template createAMGPreconditionerPointer<pressureIndex>( *opA, relax, milu, comm, amg );
         }
 
 
         template <class MatrixOperator, class POrComm, class AMG >
         void
-        constructAMGPrecond(MatrixOperator& opA, const POrComm& comm, std::unique_ptr< AMG >& amg, std::unique_ptr< MatrixOperator >&, const double relax,
+        constructAMGPrecond(MatrixOperator& opA, const POrComm& comm, std::unique_ptr< AMG >& amg, std::shared_ptr< MatrixOperator >&, const double relax,
                             const MILU_VARIANT milu) const
         {
+            ProfileScope scope( "preconditioner setup" );
             ISTLUtility::template createAMGPreconditionerPointer<pressureIndex>( opA, relax,
                                                                                  milu, comm, amg );
         }
 
         template <class C, class LinearOperator, class MatrixOperator, class POrComm, class AMG >
         void
-        constructAMGPrecond(LinearOperator& /* linearOperator */, const POrComm& comm, std::unique_ptr< AMG >& amg, std::unique_ptr< MatrixOperator >& opA, const double relax,
-                            const MILU_VARIANT milu ) const
+        constructAMGPrecond(LinearOperator& /* linearOperator */, const POrComm& comm, std::unique_ptr< AMG >& amg, std::shared_ptr< MatrixOperator >& opA, const double relax,
+                            const MILU_VARIANT milu, const std::shared_ptr< typename AMG::SetupCache >& cache ) const
         {
+            ProfileScope scope( "preconditioner setup" );
             ISTLUtility::template createAMGPreconditionerPointer<C>( *opA, relax,
-                                                                     comm, amg, parameters_ );
+                                                                     comm, amg, parameters_, cache );
         }
 
 
         template <class C, class MatrixOperator, class POrComm, class AMG >
         void
-        constructAMGPrecond(MatrixOperator& opA, const POrComm& comm, std::unique_ptr< AMG >& amg, std::unique_ptr< MatrixOperator >&, const double relax, const MILU_VARIANT milu ) const
+        constructAMGPrecond(MatrixOperator& opA, const POrComm& comm, std::unique_ptr< AMG >& amg, std::shared_ptr< MatrixOperator >&, const double relax, const MILU_VARIANT milu,
+                            const std::shared_ptr< typename AMG::SetupCache >& cache ) const
         {
-            ISTLUtility::template createAMGPreconditionerPointer<C>( opA, relax, milu,
-                                                                     comm, amg, parameters_ );
+            ProfileScope scope( "preconditioner setup" );
+            ISTLUtility::template createAMGPreconditionerPointer<C>( opA, relax,
+                                                                     comm, amg, parameters_, cache );
         }
         /// \brief Solve the system using the given preconditioner and scalar product.
-        template <class Operator, class ScalarProd, class Precond>
-        void solve(Operator& opA, Vector& x, Vector& istlb, ScalarProd& sp, Precond& precond, Dune::InverseOperatorResult& result) const
+        template <class Operator, class ScalarProd, class Precond, class POrComm>
+        void solve(Operator& opA, Vector& x, Vector& istlb, ScalarProd& sp, Precond& precond,
+                   const POrComm& parallelInformation_arg, Dune::InverseOperatorResult& result) const
         {
             // TODO: Revise when linear solvers interface opm-core is done
             // Construct linear solver.
             // GMRes solver
             int verbosity = ( isIORank_ ) ? parameters_.linear_solver_verbosity_ : 0;
+            TelemetryTimer solveTimer( telemetryCounter( telemetry(), &LinearSolverTelemetry::solve_time ) );
+            ProfileScope scope( "Krylov solve" );
 
             if ( parameters_.newton_use_gmres_ ) {
                 Dune::RestartedGMResSolver<Vector> linsolve(opA, sp, precond,
-                          parameters_.linear_solver_reduction_,
+                          linearSolverReduction_,
                           parameters_.linear_solver_restart_,
                           parameters_.linear_solver_maxiter_,
                           verbosity);
                 // Solve system.
                 linsolve.apply(x, istlb, result);
             }
+            else if ( parameters_.newton_use_recycling_gcr_ ) {
+                // GCR which deflates the slowest directions of the previous
+                // solves. They are kept across Newton iterations and time steps.
+                krylovRecycleSpace_.setMaxDimension( parameters_.linear_solver_recycle_dim_ );
+                RecyclingGCRSolver<Vector, POrComm> linsolve(opA, sp, precond, parallelInformation_arg,
+                          linearSolverReduction_,
+                          parameters_.linear_solver_restart_,
+                          parameters_.linear_solver_maxiter_,
+                          verbosity, krylovWorkspace_, krylovRecycleSpace_, telemetry());
+                // Solve system.
+                linsolve.apply(x, istlb, result);
+            }
+            else if ( parameters_.newton_use_pipelined_bicgstab_ ) {
+                // Pipelined BiCGstab solver with fewer global reductions,
+                // which are overlapped with the preconditioner and operator
+                PipelinedBiCGSTABSolver<Vector, POrComm> linsolve(opA, precond, parallelInformation_arg,
+                          linearSolverReduction_,
+                          parameters_.linear_solver_maxiter_,
+                          verbosity, krylovWorkspace_, telemetry());
+                // Solve system.
+                linsolve.apply(x, istlb, result);
+            }
             else { // BiCGstab solver
-                Dune::BiCGSTABSolver<Vector> linsolve(opA, sp, precond,
-                          parameters_.linear_solver_reduction_,
+                // Uses the persistent workspace to avoid allocating the
+                // Krylov vectors in every Newton iteration.
+                BiCGSTABSolverWithWorkspace<Vector> linsolve(opA, sp, precond,
+                          linearSolverReduction_,
                           parameters_.linear_solver_maxiter_,
-                          verbosity);
+                          verbosity, krylovWorkspace_, telemetry());
                 // Solve system.
                 linsolve.apply(x, istlb, result);
             }
@@ -606,12 +990,12 @@ namespace Detail
                 typedef Dune::OwnerOverlapCopyCommunication<int,int> Comm;
                 const ParallelISTLInformation& info =
                     boost::any_cast<const ParallelISTLInformation&>( parallelInformation_);
-                Comm istlComm(info.communicator());
+                const std::shared_ptr<Comm> istlComm = info.istlCommunication( A.N() );
 
                 // Construct operator, scalar product and vectors needed.
                 typedef Dune::OverlappingSchwarzOperator<Matrix, Vector, Vector,Comm> Operator;
-                Operator opA(A, istlComm);
-                solve( opA, x, b, istlComm  );
+                Operator opA(A, *istlComm);
+                solve( opA, x, b, *istlComm  );
             }
             else
 #endif
@@ -641,11 +1025,24 @@ namespace Detail
                     boost::any_cast<const ParallelISTLInformation&>( parallelInformation_);
 
                 // As we use a dune-istl with block size np the number of components
-                // per parallel is only one.
-                info.copyValuesTo(comm.indexSet(), comm.remoteIndices(),
-                                  size, 1);
+                // per parallel is only one. The communication objects of
+                // ParallelISTLInformation::istlCommunication() are complete already.
+                if ( comm.indexSet().size() != size )
+                {
+                    info.copyValuesTo(comm.indexSet(), comm.remoteIndices(),
+                                      size, 1);
+                }
                 // Construct operator, scalar product and vectors needed.
-                constructPreconditionerAndSolve<Dune::SolverCategory::overlapping>(opA, x, b, comm, result);
+                Dune::Timer timer;
+                const double solveTime = telemetry_.solve_time;
+                auto solveOnce = [&]( Vector& xx, Vector& bb, Dune::InverseOperatorResult& res ) {
+                    constructPreconditionerAndSolve<Dune::SolverCategory::overlapping>(opA, xx, bb, comm, res);
+                };
+                auto maxOverProcesses = [&comm]( const double seconds ) {
+                    return comm.communicator().max( seconds );
+                };
+                tunedSolve( solveOnce, maxOverProcesses, x, b, result );
+                recordTelemetry( timer.elapsed(), solveTime, result );
             }
             else
 #endif
@@ -668,10 +1065,165 @@ namespace Detail
             Dune::InverseOperatorResult result;
             // Construct operator, scalar product and vectors needed.
             Dune::Amg::SequentialInformation info;
-            constructPreconditionerAndSolve(opA, x, b, info, result);
+            Dune::Timer timer;
+            const double solveTime = telemetry_.solve_time;
+            auto solveOnce = [&]( Vector& xx, Vector& bb, Dune::InverseOperatorResult& res ) {
+                constructPreconditionerAndSolve(opA, xx, bb, info, res);
+            };
+            auto maxOverProcesses = []( const double seconds ) {
+                return seconds;
+            };
+            tunedSolve( solveOnce, maxOverProcesses, x, b, result );
+            recordTelemetry( timer.elapsed(), solveTime, result );
             checkConvergence( result );
         }
 
+        /// \brief Solve with the configuration chosen by the tuner or, while it
+        ///        tunes, with its next candidate.
+        ///
+        /// A candidate that fails is not used again, and the system is solved
+        /// once more with the configuration of the user, see
+        /// LinearSolverTuner::solve().
+        /// \param solveOnce         Constructs the preconditioner and solves.
+        /// \param maxOverProcesses  The largest value of all processes.
+        template <class SolveOnce, class Reduction>
+        void tunedSolve( const SolveOnce& solveOnce, const Reduction& maxOverProcesses,
+                         Vector& x, Vector& b, Dune::InverseOperatorResult& result ) const
+        {
+            if ( ! tuner_.tuning() )
+            {
+                solveOnce( x, b, result );
+                return;
+            }
+
+            // The right hand side might get modified by the solver.
+            tunerRhs_ = b;
+            bool first = true;
+            auto solve = [&]( const NewtonIterationBlackoilInterleavedParameters& param ) {
+                useTunerParameters( param );
+                if ( ! first )
+                {
+                    b = tunerRhs_;
+                    x = 0.0;
+                }
+                first = false;
+                solveOnce( x, b, result );
+                return bool( result.converged );
+            };
+            try
+            {
+                tuner_.solve( solve, maxOverProcesses );
+            }
+            catch ( ... )
+            {
+                // the next solve uses the next candidate or the chosen one
+                useTunerParameters( tuner_.parameters() );
+                throw;
+            }
+
+            useTunerParameters( tuner_.parameters() );
+            if ( ! tuner_.tuning() && isIORank_ )
+            {
+                OpmLog::info( tuner_.summary() );
+            }
+        }
+
+        /// \brief Use a candidate of the tuner, unless it is used already.
+        void useTunerParameters( const NewtonIterationBlackoilInterleavedParameters& param ) const
+        {
+            if ( &param != tunerParameters_ )
+            {
+                useParameters( param );
+                tunerParameters_ = &param;
+            }
+        }
+
+        /// \brief Set up the tuner if linear_solver_autotune is given.
+        void setupTuner()
+        {
+            if ( parameters_.linear_solver_autotune_ )
+            {
+#if FLOW_SUPPORT_AMG
+                const bool withAmg = true;
+#else
+                const bool withAmg = false;
+#endif
+                tuner_ = LinearSolverTuner( parameters_, withAmg, parameters_.linear_solver_autotune_rounds_ );
+            }
+        }
+
+        /// \brief Use another configuration for the next linear solves.
+        ///
+        /// The kept preconditioners might be of another type, they are discarded.
+        void useParameters( const NewtonIterationBlackoilInterleavedParameters& param ) const
+        {
+            parameters_ = param;
+            reusablePrecond_.reset();
+            reusablePrecondOperator_.reset();
+            seqIluCache_.reset();
+            cprSetupCache_.reset();
+        }
+
+        /// \brief The timings of the linear solves, null if telemetry is disabled.
+        LinearSolverTelemetry* telemetry() const
+        {
+            return telemetryFile_ ? &telemetry_ : nullptr;
+        }
+
+        /// \brief Write the timings accumulated since the last call and reset them.
+        ///
+        /// Writes one line to the telemetry file of this process. Does nothing
+        /// if telemetry is disabled.
+        void writeTelemetry( const int reportStep, const double time, const double dt ) const
+        {
+            if ( telemetryFile_ )
+            {
+                telemetry_.print( *telemetryFile_, reportStep, time, dt );
+                telemetryFile_->flush();
+                telemetry_.reset();
+            }
+        }
+
+        /// \brief Add the timings of a linear solve to the telemetry.
+        /// \param totalTime       The time spent for setup and solve.
+        /// \param solveTimeBefore The time spent in Krylov solvers before the solve.
+        void recordTelemetry( const double totalTime, const double solveTimeBefore,
+                              const Dune::InverseOperatorResult& result ) const
+        {
+            if ( telemetryFile_ )
+            {
+                telemetry_.setup_time += totalTime - ( telemetry_.solve_time - solveTimeBefore );
+                telemetry_.iterations += result.iterations;
+                ++telemetry_.solves;
+            }
+        }
+
+        /// \brief Open the telemetry file of this process if requested.
+        ///
+        /// The name is the value of linear_solver_telemetry_file with the rank
+        /// and ".csv" appended.
+        void openTelemetryFile()
+        {
+            if ( parameters_.linear_solver_telemetry_file_.empty() )
+            {
+                return;
+            }
+            int rank = 0;
+#if HAVE_MPI
+            if ( parallelInformation_.type() == typeid(ParallelISTLInformation) )
+            {
+                rank = boost::any_cast<const ParallelISTLInformation&>( parallelInformation_ ).communicator().rank();
+            }
+#endif
+            const std::string name = parameters_.linear_solver_telemetry_file_ + "." + std::to_string( rank ) + ".csv";
+            telemetryFile_ = std::make_shared< std::ofstream >( name );
+            if ( ! *telemetryFile_ )
+            {
+                OPM_THROW(std::runtime_error, "Could not open linear solver telemetry file " << name);
+            }
+            LinearSolverTelemetry::printHeader( *telemetryFile_ );
+        }
+
         void checkConvergence( const Dune::InverseOperatorResult& result ) const
         {
             // store number of iterations
@@ -688,7 +1240,41 @@ namespace Detail
         boost::any parallelInformation_;
         bool isIORank_;
 
-        NewtonIterationBlackoilInterleavedParameters parameters_;
+        // changed by the tuner of the configuration
+        mutable NewtonIterationBlackoilInterleavedParameters parameters_;
+        // relative residual reduction of the linear solves, linear_solver_reduction
+        // unless it is adapted to the nonlinear convergence
+        mutable double linearSolverReduction_;
+
+        // state of the preconditioner reuse between linear solves
+        mutable std::shared_ptr< Dune::Preconditioner< Vector, Vector > > reusablePrecond_;
+        mutable std::shared_ptr< void > reusablePrecondOperator_;
+        mutable const Matrix* reusablePrecondMatrix_;
+        mutable std::size_t reusablePrecondNnz_;
+        mutable int solvesSinceRebuild_;
+        mutable int iterationsAfterRebuild_;
+        // ILU(n) preconditioner whose symbolic factorization is reused
+        mutable std::shared_ptr< SeqPreconditioner > seqIluCache_;
+        // vectors of the Krylov solver kept alive between linear solves
+        mutable KrylovWorkspace< Vector > krylovWorkspace_;
+        // search directions recycled between linear solves
+        mutable KrylovRecycleSpace< Vector > krylovRecycleSpace_;
+        mutable Vector rhsCopy_;
+        // scalar product and AMG matrix operator kept between the solves of
+        // sequential runs (types depend on the solve)
+        mutable std::shared_ptr< void > seqScalarProduct_;
+        mutable std::shared_ptr< void > seqMatrixOperator_;
+        mutable const Matrix* seqMatrixOperatorMatrix_;
+        // tries configurations on the first linear solves if linear_solver_autotune
+        mutable LinearSolverTuner tuner_;
+        mutable Vector tunerRhs_;
+        // the candidate of tuner_ that parameters_ is a copy of
+        mutable const NewtonIterationBlackoilInterleavedParameters* tunerParameters_ = nullptr;
+        // coarsening of the CPR preconditioner (type depends on the AMG used)
+        mutable std::shared_ptr< void > cprSetupCache_;
+        // timings of the linear solves, written per time step
+        mutable LinearSolverTelemetry telemetry_;
+        std::shared_ptr< std::ofstream > telemetryFile_;
     }; // end ISTLSolver
 
 } // namespace Opm
@@ -111,6 +111,38 @@ namespace {
         return G;
     }
 
+    // The matrix mapping the values of the wells to their perforations.
+    S wellToPerf(const Wells& wells)
+    {
+        const int nw = wells.number_of_wells;
+        S well_to_perf(wells.well_connpos[nw], nw);
+        typedef Eigen::Triplet<double> Tri;
+        std::vector<Tri> w2p;
+        w2p.reserve(wells.well_connpos[nw]);
+        for (int w = 0; w < nw; ++w) {
+            for (int perf = wells.well_connpos[w]; perf < wells.well_connpos[w+1]; ++perf) {
+                w2p.emplace_back(perf, w, 1.0);
+            }
+        }
+        well_to_perf.setFromTriplets(w2p.begin(), w2p.end());
+        return well_to_perf;
+    }
+
+    // The matrix extracting the values of the perforated cells, as subset().
+    S cellToPerf(const Wells& wells, const int nc)
+    {
+        const int nperf = wells.well_connpos[wells.number_of_wells];
+        S cell_to_perf(nperf, nc);
+        typedef Eigen::Triplet<double> Tri;
+        std::vector<Tri> c2p;
+        c2p.reserve(nperf);
+        for (int perf = 0; perf < nperf; ++perf) {
+            c2p.emplace_back(perf, wells.well_cells[perf], 1.0);
+        }
+        cell_to_perf.setFromTriplets(c2p.begin(), c2p.end());
+        return cell_to_perf;
+    }
+
     V computePerfPress(const UnstructuredGrid& grid, const Wells& wells, const V& rho, const double grav)
     {
         using namespace Opm::AutoDiffGrid;
@@ -161,6 +193,14 @@ namespace {
         , well_residual_ (ADB::null())
         , total_residual_ (ADB::null())
         , qs_ (ADB::null())
+        , cells_ (buildAllCells(AutoDiffGrid::numCells(grid)))
+        , well_cells_ (wells.well_cells, wells.well_cells + wells.well_connpos[wells.number_of_wells])
+        , transi_ (subset(geo.transmissibility(), ops_.internal_faces))
+        , transw_ (Eigen::Map<const V>(wells.WI, wells.well_connpos[wells.number_of_wells], 1))
+        , well_to_perf_ (wellToPerf(wells))
+        , perf_to_well_ (well_to_perf_.transpose())
+        , cell_to_perf_ (cellToPerf(wells, AutoDiffGrid::numCells(grid)))
+        , perf_to_cell_ (cell_to_perf_.transpose())
     {
     }
 
@@ -173,31 +213,13 @@ namespace {
                        BlackoilState& state,
                        WellState& well_state)
     {
-        using namespace Opm::AutoDiffGrid;
-        const int nc = numCells(grid_);
         const int np = state.numPhases();
 
         well_flow_residual_.resize(np, ADB::null());
 
-        // Compute dynamic data that are treated explicitly.
+        // Compute dynamic data that are treated explicitly, including the
+        // relperms (since saturations are explicit).
         computeExplicitData(dt, state, well_state);
-        // Compute relperms once and for all (since saturations are explicit).
-        DataBlock s = Eigen::Map<const DataBlock>(state.saturation().data(), nc, np);
-        assert(np == 2);
-        kr_ = fluidRelperm(s.col(0), s.col(1), V::Zero(nc,1), buildAllCells(nc));
-        // Compute relperms for wells. This must be revisited for crossflow.
-        const int nw = wells_.number_of_wells;
-        const int nperf = wells_.well_connpos[nw];
-        DataBlock well_s(nperf, np);
-        for (int w = 0; w < nw; ++w) {
-            const double* comp_frac = &wells_.comp_frac[np*w];
-            for (int j = wells_.well_connpos[w]; j < wells_.well_connpos[w+1]; ++j) {
-                well_s.row(j) = Eigen::Map<const DataBlock>(comp_frac, 1, np);
-            }
-        }
-        const std::vector<int> well_cells(wells_.well_cells,
-                                          wells_.well_cells + nperf);
-        well_kr_ = fluidRelperm(well_s.col(0), well_s.col(1), V::Zero(nperf,1), well_cells);
 
         const double atol  = 1.0e-10;
         const double rtol  = 5.0e-6;
@@ -254,12 +276,12 @@ namespace {
         const int nperf = wells_.well_connpos[nw];
         const int dim = dimensions(grid_);
 
-        const std::vector<int> cells = buildAllCells(nc);
+        const std::vector<int>& cells = cells_;
 
         // Compute relperms.
         DataBlock s = Eigen::Map<const DataBlock>(state.saturation().data(), nc, np);
         assert(np == 2);
-        kr_ = fluidRelperm(s.col(0), s.col(1), V::Zero(nc,1), buildAllCells(nc));
+        kr_ = fluidRelperm(s.col(0), s.col(1), V::Zero(nc,1), cells);
 
         // Compute relperms for wells. This must be revisited for crossflow.
         DataBlock well_s(nperf, np);
@@ -269,8 +291,7 @@ namespace {
                 well_s.row(j) = Eigen::Map<const DataBlock>(comp_frac, 1, np);
             }
         }
-        const std::vector<int> well_cells(wells_.well_cells,
-                                          wells_.well_cells + nperf);
+        const std::vector<int>& well_cells = well_cells_;
         well_kr_ = fluidRelperm(well_s.col(0), well_s.col(1), V::Zero(nperf,1), well_cells);
 
         // Compute well pressure differentials.
@@ -308,18 +329,15 @@ namespace {
         const int nc = numCells(grid_);              ;
         const int np = state.numPhases();
         const int nw = wells_.number_of_wells;
-        const int nperf = wells_.well_connpos[nw];
 
-        const std::vector<int> cells = buildAllCells(nc);
+        const std::vector<int>& cells = cells_;
 
         const Eigen::Map<const DataBlock> z0all(&state.surfacevol()[0], nc, np);
         const DataBlock qall = DataBlock::Zero(nc, np);
         const V delta_t = dt * V::Ones(nc, 1);
-        const V transi = subset(geo_.transmissibility(),
-                                ops_.internal_faces);
-        const std::vector<int> well_cells(wells_.well_cells,
-                                          wells_.well_cells + nperf);
-        const V transw = Eigen::Map<const V>(wells_.WI, nperf, 1);
+        const V& transi = transi_;
+        const std::vector<int>& well_cells = well_cells_;
+        const V& transw = transw_;
 
         // Initialize AD variables: p (cell pressures) and bhp (well bhp).
         const V p0 = Eigen::Map<const V>(&state.pressure()[0], nc, 1);
@@ -336,21 +354,10 @@ namespace {
 
         // Extract variables for perforation cell pressures
         // and corresponding perforation well pressures.
-        const ADB p_perfcell = subset(p, well_cells);
-        const ADB T_perfcell = subset(T, well_cells);
-        // Construct matrix to map wells->perforations.
-        S well_to_perf(well_cells.size(), nw);
-        typedef Eigen::Triplet<double> Tri;
-        std::vector<Tri> w2p;
-        for (int w = 0; w < nw; ++w) {
-            for (int perf = wells_.well_connpos[w]; perf < wells_.well_connpos[w+1]; ++perf) {
-                w2p.emplace_back(perf, w, 1.0);
-            }
-        }
-        well_to_perf.setFromTriplets(w2p.begin(), w2p.end());
-        const S perf_to_well = well_to_perf.transpose();
+        const ADB p_perfcell = cell_to_perf_ * p;
+        const ADB T_perfcell = cell_to_perf_ * T;
         // Finally construct well perforation pressures and well flows.
-        const ADB p_perfwell = well_to_perf*bhp + well_perf_dp_;
+        const ADB p_perfwell = well_to_perf_*bhp + well_perf_dp_;
         const ADB nkgradp_well = transw * (p_perfcell - p_perfwell);
         const Selector<double> cell_to_well_selector(nkgradp_well.value());
 
@@ -378,17 +385,17 @@ namespace {
             const ADB flux = face_mob * head;
             const ADB perf_flux = perf_mob * (nkgradp_well); // No gravity term for perforations.
             const ADB face_b = upwind.select(cell_b);
-            const ADB perf_b = cell_to_well_selector.select(subset(cell_b, well_cells), well_b);
+            const ADB perf_b = cell_to_well_selector.select(cell_to_perf_ * cell_b, well_b);
             const V z0 = z0all.block(0, phase, nc, 1);
             const V q  = qall .block(0, phase, nc, 1);
-            const ADB well_contrib = superset(perf_flux*perf_b, well_cells, nc);
+            const ADB well_contrib = perf_to_cell_ * (perf_flux*perf_b);
             const ADB divcontrib = delta_t * (ops_.div * (flux * face_b) + well_contrib);
             const V qcontrib = delta_t * q;
             const ADB pvcontrib = ADB::constant(pv*z0);
             const ADB component_contrib = pvcontrib + qcontrib;
             divcontrib_sum = divcontrib_sum - divcontrib/cell_b;
             cell_residual_ = cell_residual_ - (component_contrib/cell_b);
-            const ADB well_rates = perf_to_well * (perf_flux*perf_b);
+            const ADB well_rates = perf_to_well_ * (perf_flux*perf_b);
             qs_ = qs_ +  superset(well_rates, Span(nw, 1, phase*nw), nw*np);
         }
         cell_residual_ = cell_residual_ + divcontrib_sum;
@@ -441,7 +448,7 @@ namespace {
         const int nw = wells_.number_of_wells;
         // const int np = state.numPhases();
 
-        Eigen::SparseMatrix<double, Eigen::RowMajor> matr;
+        Eigen::SparseMatrix<double, Eigen::RowMajor>& matr = jacobian_;
         total_residual_.derivative()[0].toSparse(matr);
 
         V dx(V::Zero(total_residual_.size()));
@@ -489,22 +496,9 @@ namespace {
         const int nw = wells_.number_of_wells;
         const int nperf = wells_.well_connpos[nw];
 
-        // Build cell sets.
-        const std::vector<int> cells = buildAllCells(nc);
-        const std::vector<int> well_cells(wells_.well_cells,
-                                          wells_.well_cells + nperf);
-        // Construct matrix to map wells->perforations.
-        S well_to_perf(well_cells.size(), nw);
-        typedef Eigen::Triplet<double> Tri;
-        std::vector<Tri> w2p;
-        for (int w = 0; w < nw; ++w) {
-            for (int perf = wells_.well_connpos[w]; perf < wells_.well_connpos[w+1]; ++perf) {
-                w2p.emplace_back(perf, w, 1.0);
-            }
-        }
-        well_to_perf.setFromTriplets(w2p.begin(), w2p.end());
-        const S perf_to_well = well_to_perf.transpose();
-        const V transw = Eigen::Map<const V>(wells_.WI, nperf, 1);
+        const std::vector<int>& cells = cells_;
+        const std::vector<int>& well_cells = well_cells_;
+        const V& transw = transw_;
 
         const V p = Eigen::Map<const V>(&state.pressure()[0], nc, 1);
         const V T = Eigen::Map<const V>(&state.temperature()[0], nc, 1);
@@ -513,11 +507,9 @@ namespace {
         const V p_perfcell = subset(p, well_cells);
         const V T_perfcell = subset(T, well_cells);
 
-        const V transi  = subset(geo_.transmissibility(),
-                                 ops_.internal_faces);
-        const V nkgradp = transi * (ops_.ngrad * p.matrix()).array();
+        const V nkgradp = transi_ * (ops_.ngrad * p.matrix()).array();
 
-        const V p_perfwell = (well_to_perf*bhp.matrix()).array() + well_perf_dp_;
+        const V p_perfwell = (well_to_perf_*bhp.matrix()).array() + well_perf_dp_;
         const V nkgradp_well = transw * (p_perfcell - p_perfwell);
         const Selector<double> cell_to_well_selector(nkgradp_well);
 
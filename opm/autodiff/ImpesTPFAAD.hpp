@@ -41,6 +41,11 @@ namespace Opm {
     ///   - pressure solve only
     ///   - no miscibility
     ///   - no gravity in wells or crossflow
+    /// The operators between cells, faces, perforations and wells are built
+    /// once at construction. The pressure systems are passed to the linear
+    /// solver as CSR matrices, so with a LinearSolverIstl using CG_AMG and
+    /// linsolver_amg_rebuild_interval > 1 the AMG hierarchy is reused
+    /// between the Newton iterations.
     class ImpesTPFAAD
     {
     public:
@@ -67,6 +72,7 @@ namespace Opm {
         typedef AutoDiffBlock<double> ADB;
         typedef ADB::V V;
         typedef ADB::M M;
+        typedef Eigen::SparseMatrix<double> S;
         typedef Eigen::Array<double,
                              Eigen::Dynamic,
                              Eigen::Dynamic,
@@ -91,6 +97,17 @@ namespace Opm {
         std::vector<V>               well_kr_;
         ADB                          qs_;
         V                            well_perf_dp_;
+        // Fixed for the lifetime of the solver.
+        const std::vector<int>       cells_;
+        const std::vector<int>       well_cells_;
+        const V                      transi_;
+        const V                      transw_;
+        const S                      well_to_perf_;   // well -> perf (scatter)
+        const S                      perf_to_well_;   // perf -> well (gather)
+        const S                      cell_to_perf_;   // cell -> perf (gather)
+        const S                      perf_to_cell_;   // perf -> cell (scatter)
+        // The storage of the CSR jacobian, kept between iterations.
+        mutable Eigen::SparseMatrix<double, Eigen::RowMajor> jacobian_;
 
         // Methods for assembling and solving.
         void computeExplicitData(const double         dt,
@@ -0,0 +1,1086 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_KRYLOVSOLVERS_HEADER_INCLUDED
+#define OPM_KRYLOVSOLVERS_HEADER_INCLUDED
+
+#include <opm/common/utility/platform_dependent/disable_warnings.h>
+
+#include <dune/common/timer.hh>
+#include <dune/istl/istlexception.hh>
+#include <dune/istl/owneroverlapcopy.hh>
+#include <dune/istl/paamg/pinfo.hh>
+#include <dune/istl/solver.hh>
+
+#include <opm/common/utility/platform_dependent/reenable_warnings.h>
+
+#include <opm/autodiff/LinearSolverTelemetry.hpp>
+#include <opm/simulators/MemoryAccounting.hpp>
+
+#include <Eigen/Eigenvalues>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#if HAVE_MPI
+#include <mpi.h>
+#endif
+
+namespace Opm
+{
+
+/// \brief Vectors that are kept alive between linear solves.
+///
+/// The Krylov solvers of dune-istl allocate their temporary vectors in
+/// every call of apply. For simulations with thousands of Newton
+/// iterations this results in lots of allocations and page faults. The
+/// workspace keeps the vectors and only reallocates if the size changes.
+template<class X>
+class KrylovWorkspace
+{
+public:
+    /// \brief Get the i-th vector of the workspace with the size of shape.
+    ///
+    /// The contents of the vector are unspecified.
+    X& vector(std::size_t i, const X& shape)
+    {
+        if ( vectors_.size() <= i )
+        {
+            vectors_.resize(i + 1);
+        }
+        X& v = vectors_[i];
+        if ( v.size() != shape.size() )
+        {
+            v = shape;
+            std::size_t bytes = 0;
+            for ( const X& w : vectors_ )
+            {
+                bytes += w.size() * sizeof(typename X::block_type);
+            }
+            memory_.set(bytes);
+        }
+        return v;
+    }
+
+    /// \brief Release all memory held by the workspace.
+    void clear()
+    {
+        vectors_.clear();
+        memory_.set(0);
+    }
+
+private:
+    // a deque keeps references to existing vectors valid when growing
+    std::deque<X> vectors_;
+    MemoryAccounting::Account memory_{ MemoryAccounting::Krylov };
+};
+
+/// \brief Bi-conjugate gradient stabilized method using a persistent workspace.
+///
+/// Implements the same algorithm as Dune::BiCGSTABSolver but takes its
+/// temporary vectors from a KrylovWorkspace.
+template<class X>
+class BiCGSTABSolverWithWorkspace
+{
+public:
+    typedef X domain_type;
+    typedef X range_type;
+    typedef typename X::field_type field_type;
+    typedef typename Dune::FieldTraits<field_type>::real_type real_type;
+
+    /// \brief Set up the solver.
+    /// \param op        The operator to solve for.
+    /// \param sp        The scalar product to use.
+    /// \param prec      The preconditioner to use.
+    /// \param reduction The relative defect reduction to achieve.
+    /// \param maxit     The maximum number of iterations.
+    /// \param verbose   The verbosity level.
+    /// \param workspace The storage for the temporary vectors.
+    /// \param telemetry Where to add the timings to (null to disable).
+    template<class Operator, class ScalarProduct, class Preconditioner>
+    BiCGSTABSolverWithWorkspace(Operator& op, ScalarProduct& sp, Preconditioner& prec,
+                                real_type reduction, int maxit, int verbose,
+                                KrylovWorkspace<X>& workspace,
+                                LinearSolverTelemetry* telemetry = nullptr)
+        : op_(op), sp_(sp), prec_(prec),
+          reduction_(reduction), maxit_(maxit), verbose_(verbose),
+          workspace_(workspace), telemetry_(telemetry)
+    {}
+
+    /// \brief Solve Ax = b. b is overwritten by the defect.
+    void apply(X& x, X& b, Dune::InverseOperatorResult& res)
+    {
+        const real_type EPSILON = 1e-80;
+        double it;
+        field_type rho, rho_new, alpha, beta, h, omega;
+        real_type norm, norm_0;
+
+        X& p  = workspace_.vector(0, x);
+        X& v  = workspace_.vector(1, x);
+        X& t  = workspace_.vector(2, x);
+        X& y  = workspace_.vector(3, x);
+        X& rt = workspace_.vector(4, x);
+
+        res.clear();
+        Dune::Timer watch;
+        prec_.pre(x, b);
+        op_.applyscaleadd(-1, x, b);  // overwrite b with defect
+        rt = b;
+        norm = norm_0 = globalNorm(b);
+
+        p = 0;
+        v = 0;
+        rho = 1;
+        alpha = 1;
+        omega = 1;
+
+        if ( verbose_ > 0 )
+        {
+            std::cout << "=== BiCGSTABSolverWithWorkspace" << std::endl;
+            if ( verbose_ > 1 )
+            {
+                printOutput(0, norm_0);
+            }
+        }
+
+        if ( norm < (reduction_ * norm_0) || norm < 1e-30 )
+        {
+            res.converged = 1;
+            prec_.post(x);
+            res.iterations = 0;
+            res.reduction = 0;
+            res.conv_rate = 0;
+            res.elapsed = watch.elapsed();
+            return;
+        }
+
+        for ( it = 0.5; it < maxit_; it += .5 )
+        {
+            // rho_new = < rt , r >
+            rho_new = globalDot(rt, b);
+
+            // look if breakdown occurred
+            if ( std::abs(rho) <= EPSILON )
+            {
+                DUNE_THROW(Dune::ISTLError, "breakdown in BiCGSTAB - rho "
+                           << rho << " <= EPSILON " << EPSILON << " after " << it << " iterations");
+            }
+            if ( std::abs(omega) <= EPSILON )
+            {
+                DUNE_THROW(Dune::ISTLError, "breakdown in BiCGSTAB - omega "
+                           << omega << " <= EPSILON " << EPSILON << " after " << it << " iterations");
+            }
+
+            if ( it < 1 )
+            {
+                p = b;
+            }
+            else
+            {
+                beta = ( rho_new / rho ) * ( alpha / omega );
+                p.axpy(-omega, v); // p = r + beta (p - omega*v)
+                p *= beta;
+                p += b;
+            }
+
+            // y = W^-1 * p
+            y = 0;
+            applyPreconditioner(y, p);
+
+            // v = A * y
+            op_.apply(y, v);
+
+            // alpha = rho_new / < rt, v >
+            h = globalDot(rt, v);
+            if ( std::abs(h) < EPSILON )
+            {
+                DUNE_THROW(Dune::ISTLError, "h=0 in BiCGSTAB");
+            }
+            alpha = rho_new / h;
+
+            // x <- x + alpha y
+            x.axpy(alpha, y);
+            // r = r - alpha*v
+            b.axpy(-alpha, v);
+
+            norm = globalNorm(b);
+            if ( verbose_ > 1 )
+            {
+                printOutput(it, norm);
+            }
+            if ( norm < (reduction_ * norm_0) )
+            {
+                break;
+            }
+            it += .5;
+
+            // y = W^-1 * r
+            y = 0;
+            applyPreconditioner(y, b);
+
+            // t = A * y
+            op_.apply(y, t);
+
+            // omega = < t, r > / < t, t >
+            omega = globalDot(t, b) / globalDot(t, t);
+
+            // x <- x + omega y
+            x.axpy(omega, y);
+            // r = s - omega*t (remember : r = s)
+            b.axpy(-omega, t);
+
+            norm = globalNorm(b);
+            if ( verbose_ > 1 )
+            {
+                printOutput(it, norm);
+            }
+            if ( norm < (reduction_ * norm_0) )
+            {
+                break;
+            }
+            rho = rho_new;
+        }
+
+        // correct it which is wrong if convergence was not achieved.
+        it = std::min(static_cast<double>(maxit_), it);
+
+        prec_.post(x);
+        res.iterations = static_cast<int>(std::ceil(it));
+        res.reduction = static_cast<double>(norm / norm_0);
+        res.converged = (norm < (reduction_ * norm_0));
+        res.conv_rate = std::pow(res.reduction, 1.0 / it);
+        res.elapsed = watch.elapsed();
+
+        if ( verbose_ > 0 )
+        {
+            std::cout << "=== rate=" << res.conv_rate
+                      << ", T=" << res.elapsed
+                      << ", TIT=" << res.elapsed / it
+                      << ", IT=" << it << std::endl;
+        }
+    }
+
+private:
+    void applyPreconditioner(X& v, const X& d)
+    {
+        TelemetryTimer timer(telemetryCounter(telemetry_, &LinearSolverTelemetry::prec_apply_time));
+        prec_.apply(v, d);
+    }
+
+    field_type globalDot(const X& x, const X& y)
+    {
+        TelemetryTimer timer(telemetryCounter(telemetry_, &LinearSolverTelemetry::reduction_time));
+        return sp_.dot(x, y);
+    }
+
+    real_type globalNorm(const X& x)
+    {
+        TelemetryTimer timer(telemetryCounter(telemetry_, &LinearSolverTelemetry::reduction_time));
+        return sp_.norm(x);
+    }
+
+    void printOutput(double it, real_type norm) const
+    {
+        std::cout << std::setw(5) << it << " " << std::scientific
+                  << std::setprecision(5) << norm << std::endl;
+    }
+
+    Dune::LinearOperator<X, X>& op_;
+    Dune::ScalarProduct<X>& sp_;
+    Dune::Preconditioner<X, X>& prec_;
+    real_type reduction_;
+    int maxit_;
+    int verbose_;
+    KrylovWorkspace<X>& workspace_;
+    LinearSolverTelemetry* telemetry_;
+};
+
+/// \brief Search directions kept between the linear solves of RecyclingGCRSolver.
+///
+/// Holds pairs (u_i, c_i) where the c_i = A u_i are orthonormal for the
+/// operator A of the last solve. RecyclingGCRSolver keeps harmonic Ritz
+/// vectors, which approximate the eigenvectors of the eigenvalues of
+/// smallest magnitude. As the linear systems of successive Newton
+/// iterations and time steps are similar, deflating them also speeds up the
+/// next solves.
+template<class X>
+class KrylovRecycleSpace
+{
+public:
+    /// \brief Keep at most maxDimension pairs of directions.
+    explicit KrylovRecycleSpace(std::size_t maxDimension = 8)
+        : maxDimension_(maxDimension)
+    {}
+
+    void setMaxDimension(std::size_t maxDimension)
+    {
+        maxDimension_ = maxDimension;
+        if ( directions_.size() > maxDimension_ )
+        {
+            directions_.resize(maxDimension_);
+            images_.resize(maxDimension_);
+            account();
+        }
+    }
+
+    std::size_t maxDimension() const
+    { return maxDimension_; }
+
+    /// \brief The number of directions currently kept.
+    std::size_t size() const
+    { return directions_.size(); }
+
+    /// \brief The directions u_i in the domain.
+    std::vector<X>& directions()
+    { return directions_; }
+
+    /// \brief The images c_i = A u_i in the range.
+    std::vector<X>& images()
+    { return images_; }
+
+    /// \brief Discard all directions, e.g. after the grid changed.
+    void clear()
+    {
+        directions_.clear();
+        images_.clear();
+        account();
+    }
+
+    /// \brief Update the accounted bytes after directions were added or removed.
+    void account()
+    {
+        std::size_t bytes = 0;
+        for ( const X& v : directions_ )
+        {
+            bytes += 2 * v.size() * sizeof(typename X::block_type);
+        }
+        memory_.set(bytes);
+    }
+
+private:
+    std::size_t maxDimension_;
+    std::vector<X> directions_;
+    std::vector<X> images_;
+    MemoryAccounting::Account memory_{ MemoryAccounting::Krylov };
+};
+
+namespace detail
+{
+
+    /// \brief Computes several global dot products with one reduction.
+    ///
+    /// The local contributions are computed by localDot, then all of them
+    /// are reduced at once with start and wait. In parallel runs the
+    /// reduction is nonblocking, such that work can be done while it is in
+    /// flight.
+    template<class X, class Comm>
+    class MultiDotProduct;
+
+    template<class X>
+    class MultiDotProduct<X, Dune::Amg::SequentialInformation>
+    {
+    public:
+        MultiDotProduct(const Dune::Amg::SequentialInformation&, std::size_t)
+        {}
+
+        double localDot(const X& x, const X& y) const
+        {
+            return x.dot(y);
+        }
+
+        template<std::size_t N>
+        void start(std::array<double, N>&)
+        {}
+
+        void start(std::vector<double>&)
+        {}
+
+        void wait()
+        {}
+    };
+
+#if HAVE_MPI
+    template<class X, class G, class L>
+    class MultiDotProduct<X, Dune::OwnerOverlapCopyCommunication<G, L> >
+    {
+        typedef Dune::OwnerOverlapCopyCommunication<G, L> Comm;
+    public:
+        MultiDotProduct(const Comm& comm, std::size_t size)
+            : comm_(comm), mask_(size, 1.0), request_(MPI_REQUEST_NULL)
+        {
+            // Only entries owned by this process contribute.
+            for ( auto idx = comm.indexSet().begin(), end = comm.indexSet().end(); idx != end; ++idx )
+            {
+                if ( idx->local().attribute() != Dune::OwnerOverlapCopyAttributeSet::owner )
+                {
+                    mask_[idx->local().local()] = 0.0;
+                }
+            }
+        }
+
+        double localDot(const X& x, const X& y) const
+        {
+            double result = 0.0;
+            for ( std::size_t i = 0, n = x.size(); i < n; ++i )
+            {
+                result += mask_[i] * ( x[i] * y[i] );
+            }
+            return result;
+        }
+
+        /// \brief Start the reduction of values. They must stay valid until wait.
+        template<std::size_t N>
+        void start(std::array<double, N>& values)
+        {
+            MPI_Iallreduce(MPI_IN_PLACE, values.data(), N, MPI_DOUBLE, MPI_SUM,
+                           comm_.communicator(), &request_);
+        }
+
+        /// \brief Start the reduction of values. They must stay valid until wait.
+        void start(std::vector<double>& values)
+        {
+            MPI_Iallreduce(MPI_IN_PLACE, values.data(), values.size(), MPI_DOUBLE, MPI_SUM,
+                           comm_.communicator(), &request_);
+        }
+
+        void wait()
+        {
+            MPI_Wait(&request_, MPI_STATUS_IGNORE);
+        }
+
+    private:
+        const Comm& comm_;
+        std::vector<double> mask_;
+        MPI_Request request_;
+    };
+#endif
+
+} // namespace detail
+
+/// \brief Restarted generalized conjugate residual method which recycles
+///        search directions between linear solves.
+///
+/// A variant of GCRO (de Sturler, "Truncation strategies for optimal Krylov
+/// subspace methods", 1999) with a simple selection of the recycled space.
+/// At the start of a solve the directions of the KrylovRecycleSpace are
+/// mapped by the new operator and orthonormalized, and the initial residual
+/// is projected onto them. Every new search direction is orthogonalized
+/// against them, so the recycled space stays deflated during the whole
+/// solve, across restarts. At the end the harmonic Ritz vectors of the
+/// kept and the last directions with the harmonic Ritz values of smallest
+/// magnitude are kept for the next solve.
+///
+/// The preconditioner is applied from the right and may change between
+/// iterations. The number of global reductions per iteration grows with the
+/// number of kept and current directions, the restart length bounds it.
+template<class X, class Comm>
+class RecyclingGCRSolver
+{
+public:
+    typedef X domain_type;
+    typedef X range_type;
+    typedef typename X::field_type field_type;
+    typedef typename Dune::FieldTraits<field_type>::real_type real_type;
+
+    /// \brief Set up the solver.
+    /// \param op        The operator to solve for.
+    /// \param sp        The scalar product to use.
+    /// \param prec      The preconditioner to use.
+    /// \param comm      The information about the parallelization.
+    /// \param reduction The relative defect reduction to achieve.
+    /// \param restart   The number of directions after which to restart.
+    /// \param maxit     The maximum number of iterations.
+    /// \param verbose   The verbosity level.
+    /// \param workspace The storage for the directions of the current cycle.
+    /// \param recycle   The directions kept between solves.
+    /// \param telemetry Where to add the timings to (null to disable).
+    template<class Operator, class ScalarProduct, class Preconditioner>
+    RecyclingGCRSolver(Operator& op, ScalarProduct& sp, Preconditioner& prec, const Comm& comm,
+                       real_type reduction, int restart, int maxit, int verbose,
+                       KrylovWorkspace<X>& workspace, KrylovRecycleSpace<X>& recycle,
+                       LinearSolverTelemetry* telemetry = nullptr)
+        : op_(op), sp_(sp), prec_(prec), comm_(comm),
+          reduction_(reduction), restart_(std::max(restart, 1)), maxit_(maxit), verbose_(verbose),
+          workspace_(workspace), recycle_(recycle), telemetry_(telemetry)
+    {}
+
+    /// \brief Solve Ax = b. b is overwritten by the defect.
+    void apply(X& x, X& b, Dune::InverseOperatorResult& res)
+    {
+        const real_type EPSILON = 1e-80;
+        real_type norm, norm_0;
+
+        res.clear();
+        Dune::Timer watch;
+        prec_.pre(x, b);
+        op_.applyscaleadd(-1, x, b);  // overwrite b with defect
+        norm = norm_0 = globalNorm(b);
+
+        if ( verbose_ > 0 )
+        {
+            std::cout << "=== RecyclingGCRSolver" << std::endl;
+            if ( verbose_ > 1 )
+            {
+                printOutput(0, norm_0);
+            }
+        }
+
+        if ( norm < 1e-30 )
+        {
+            res.converged = 1;
+            prec_.post(x);
+            res.iterations = 0;
+            res.reduction = 0;
+            res.conv_rate = 0;
+            res.elapsed = watch.elapsed();
+            return;
+        }
+
+        std::vector<X>& U = recycle_.directions();
+        std::vector<X>& C = recycle_.images();
+        if ( ! U.empty() && U.front().size() != x.size() )
+        {
+            recycle_.clear();
+        }
+
+        // Map the kept directions with the current operator, orthonormalize
+        // the images and drop those that became linearly dependent.
+        std::size_t noKept = 0;
+        for ( std::size_t i = 0; i < U.size(); ++i )
+        {
+            op_.apply(U[i], C[i]);
+            const real_type original = globalNorm(C[i]);
+            for ( std::size_t j = 0; j < noKept; ++j )
+            {
+                const field_type beta = globalDot(C[j], C[i]);
+                C[i].axpy(-beta, C[j]);
+                U[i].axpy(-beta, U[j]);
+            }
+            const real_type remaining = globalNorm(C[i]);
+            if ( remaining > 1e-10 * original && remaining > EPSILON )
+            {
+                C[i] *= 1.0 / remaining;
+                U[i] *= 1.0 / remaining;
+                if ( i != noKept )
+                {
+                    std::swap(U[i], U[noKept]);
+                    std::swap(C[i], C[noKept]);
+                }
+                ++noKept;
+            }
+        }
+        U.resize(noKept);
+        C.resize(noKept);
+
+        // Deflate the initial residual.
+        for ( std::size_t i = 0; i < noKept; ++i )
+        {
+            const field_type alpha = globalDot(C[i], b);
+            x.axpy(alpha, U[i]);
+            b.axpy(-alpha, C[i]);
+        }
+        if ( noKept > 0 )
+        {
+            norm = globalNorm(b);
+            if ( verbose_ > 1 )
+            {
+                printOutput(0, norm);
+            }
+        }
+
+        int it = 0;
+        // the number of directions of the current cycle
+        std::size_t noCycle = 0;
+        while ( norm >= reduction_ * norm_0 && it < maxit_ )
+        {
+            if ( static_cast<int>(noCycle) == restart_ )
+            {
+                noCycle = 0;
+            }
+            const std::size_t j = noCycle;
+            X& u = workspace_.vector(2 * j, x);
+            X& c = workspace_.vector(2 * j + 1, x);
+
+            // u = W^-1 r, c = A u
+            u = 0;
+            applyPreconditioner(u, b);
+            op_.apply(u, c);
+
+            // orthogonalize c against the kept and the current images
+            for ( std::size_t i = 0; i < noKept; ++i )
+            {
+                const field_type beta = globalDot(C[i], c);
+                c.axpy(-beta, C[i]);
+                u.axpy(-beta, U[i]);
+            }
+            for ( std::size_t i = 0; i < j; ++i )
+            {
+                const X& ci = workspace_.vector(2 * i + 1, x);
+                const field_type beta = globalDot(ci, c);
+                c.axpy(-beta, ci);
+                u.axpy(-beta, workspace_.vector(2 * i, x));
+            }
+            const real_type cNorm = globalNorm(c);
+            if ( cNorm <= EPSILON )
+            {
+                DUNE_THROW(Dune::ISTLError, "breakdown in RecyclingGCR - the new direction is "
+                           "linearly dependent after " << it << " iterations");
+            }
+            c *= 1.0 / cNorm;
+            u *= 1.0 / cNorm;
+
+            // minimize the residual along c
+            const field_type alpha = globalDot(c, b);
+            x.axpy(alpha, u);
+            b.axpy(-alpha, c);
+            ++noCycle;
+            ++it;
+
+            norm = globalNorm(b);
+            if ( verbose_ > 1 )
+            {
+                printOutput(it, norm);
+            }
+        }
+
+        keepDirections(x, noKept, noCycle);
+
+        prec_.post(x);
+        res.iterations = it;
+        res.reduction = static_cast<double>(norm / norm_0);
+        res.converged = (norm < (reduction_ * norm_0));
+        res.conv_rate = it > 0 ? std::pow(res.reduction, 1.0 / it) : 0.0;
+        res.elapsed = watch.elapsed();
+
+        if ( verbose_ > 0 )
+        {
+            std::cout << "=== rate=" << res.conv_rate
+                      << ", T=" << res.elapsed
+                      << ", TIT=" << ( it > 0 ? res.elapsed / it : 0.0 )
+                      << ", IT=" << it << ", recycled=" << noKept << std::endl;
+        }
+    }
+
+private:
+    // Replace the recycled space by the harmonic Ritz vectors of the space
+    // spanned by the kept directions and the last directions of the cycle
+    // with the harmonic Ritz values of smallest magnitude. These approximate
+    // the eigenvectors that slow down the convergence the most.
+    void keepDirections(const X& shape, std::size_t noKept, std::size_t noCycle)
+    {
+        const std::size_t maxDimension = recycle_.maxDimension();
+        std::vector<X>& U = recycle_.directions();
+        std::vector<X>& C = recycle_.images();
+        if ( maxDimension == 0 )
+        {
+            recycle_.clear();
+            return;
+        }
+
+        // Limit the candidates to keep the dot products and the eigenvalue
+        // problem small.
+        const std::size_t first = noCycle > 2 * maxDimension ? noCycle - 2 * maxDimension : 0;
+        const std::size_t n = noKept + noCycle - first;
+        auto direction = [&](std::size_t i) -> X&
+            { return i < noKept ? U[i] : workspace_.vector(2 * (first + i - noKept), shape); };
+        auto image = [&](std::size_t i) -> X&
+            { return i < noKept ? C[i] : workspace_.vector(2 * (first + i - noKept) + 1, shape); };
+
+        Eigen::MatrixXd coefficients;
+        if ( n <= maxDimension )
+        {
+            coefficients = Eigen::MatrixXd::Identity(n, n);
+        }
+        else
+        {
+            // The images are orthonormal, hence the harmonic Ritz values
+            // theta of A on the span of the directions W satisfy
+            // (C^T W) y = y / theta. All of its entries are reduced at once.
+            detail::MultiDotProduct<X, Comm> dots(comm_, shape.size());
+            std::vector<double> products(n * n);
+            for ( std::size_t i = 0; i < n; ++i )
+            {
+                for ( std::size_t j = 0; j < n; ++j )
+                {
+                    products[i * n + j] = dots.localDot(image(i), direction(j));
+                }
+            }
+            {
+                TelemetryTimer timer(telemetryCounter(telemetry_, &LinearSolverTelemetry::reduction_time));
+                dots.start(products);
+                dots.wait();
+            }
+            Eigen::MatrixXd G(n, n);
+            for ( std::size_t i = 0; i < n; ++i )
+            {
+                for ( std::size_t j = 0; j < n; ++j )
+                {
+                    G(i, j) = products[i * n + j];
+                }
+            }
+            Eigen::EigenSolver<Eigen::MatrixXd> eigen(G);
+            if ( eigen.info() != Eigen::Success )
+            {
+                recycle_.clear();
+                return;
+            }
+            const auto values = eigen.eigenvalues();
+            const auto vectors = eigen.eigenvectors();
+            std::vector<std::size_t> order(n);
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&](std::size_t k1, std::size_t k2)
+                             { return std::abs(values[k1]) > std::abs(values[k2]); });
+
+            // A complex pair contributes its real and imaginary part.
+            coefficients.resize(n, maxDimension);
+            std::size_t noColumns = 0;
+            for ( std::size_t k = 0; k < n && noColumns < maxDimension; ++k )
+            {
+                const std::size_t l = order[k];
+                if ( values[l].imag() < 0.0 )
+                {
+                    continue;
+                }
+                coefficients.col(noColumns++) = vectors.col(l).real();
+                if ( values[l].imag() > 0.0 && noColumns < maxDimension )
+                {
+                    coefficients.col(noColumns++) = vectors.col(l).imag();
+                }
+            }
+            coefficients.conservativeResize(n, noColumns);
+        }
+
+        // The images are recomputed for the operator of the next solve.
+        std::vector<X> newU(coefficients.cols(), shape);
+        for ( auto k = 0; k < coefficients.cols(); ++k )
+        {
+            newU[k] = 0;
+            for ( std::size_t i = 0; i < n; ++i )
+            {
+                newU[k].axpy(coefficients(i, k), direction(i));
+            }
+        }
+        U.swap(newU);
+        C.assign(U.size(), shape);
+        recycle_.account();
+    }
+
+    void applyPreconditioner(X& v, const X& d)
+    {
+        TelemetryTimer timer(telemetryCounter(telemetry_, &LinearSolverTelemetry::prec_apply_time));
+        prec_.apply(v, d);
+    }
+
+    field_type globalDot(const X& x, const X& y)
+    {
+        TelemetryTimer timer(telemetryCounter(telemetry_, &LinearSolverTelemetry::reduction_time));
+        return sp_.dot(x, y);
+    }
+
+    real_type globalNorm(const X& x)
+    {
+        TelemetryTimer timer(telemetryCounter(telemetry_, &LinearSolverTelemetry::reduction_time));
+        return sp_.norm(x);
+    }
+
+    void printOutput(int it, real_type norm) const
+    {
+        std::cout << std::setw(5) << it << " " << std::scientific
+                  << std::setprecision(5) << norm << std::endl;
+    }
+
+    Dune::LinearOperator<X, X>& op_;
+    Dune::ScalarProduct<X>& sp_;
+    Dune::Preconditioner<X, X>& prec_;
+    const Comm& comm_;
+    real_type reduction_;
+    int restart_;
+    int maxit_;
+    int verbose_;
+    KrylovWorkspace<X>& workspace_;
+    KrylovRecycleSpace<X>& recycle_;
+    LinearSolverTelemetry* telemetry_;
+};
+
+/// \brief Pipelined bi-conjugate gradient stabilized method.
+///
+/// Implements the right preconditioned pipelined BiCGSTAB method of
+/// Cools and Vanroose, "The communication-hiding pipelined BiCGStab method
+/// for the parallel solution of large unsymmetric linear systems", 2017.
+/// Instead of up to six blocking global reductions per iteration it uses two
+/// nonblocking ones, each of which is overlapped with a preconditioner
+/// application and a matrix vector product. This comes at the cost of more
+/// vector updates and memory, and of slightly less stable recurrences. It
+/// therefore only pays off for runs on many processes.
+template<class X, class Comm>
+class PipelinedBiCGSTABSolver
+{
+public:
+    typedef X domain_type;
+    typedef X range_type;
+    typedef typename X::field_type field_type;
+    typedef typename Dune::FieldTraits<field_type>::real_type real_type;
+
+    /// \brief Set up the solver.
+    /// \param op        The operator to solve for.
+    /// \param prec      The preconditioner to use.
+    /// \param comm      The information about the parallelization.
+    /// \param reduction The relative defect reduction to achieve.
+    /// \param maxit     The maximum number of iterations.
+    /// \param verbose   The verbosity level.
+    /// \param workspace The storage for the temporary vectors.
+    /// \param telemetry Where to add the timings to (null to disable).
+    template<class Operator, class Preconditioner>
+    PipelinedBiCGSTABSolver(Operator& op, Preconditioner& prec, const Comm& comm,
+                            real_type reduction, int maxit, int verbose,
+                            KrylovWorkspace<X>& workspace,
+                            LinearSolverTelemetry* telemetry = nullptr)
+        : op_(op), prec_(prec), comm_(comm),
+          reduction_(reduction), maxit_(maxit), verbose_(verbose),
+          workspace_(workspace), telemetry_(telemetry)
+    {}
+
+    /// \brief Solve Ax = b. b is overwritten by the defect.
+    void apply(X& x, X& b, Dune::InverseOperatorResult& res)
+    {
+        const real_type EPSILON = 1e-80;
+        real_type norm, norm_0;
+
+        // Naming follows the paper, a hat denotes a vector with the
+        // preconditioner applied. b holds the residual r.
+        X& r  = b;
+        X& rt = workspace_.vector(0, x);
+        X& rh = workspace_.vector(1, x);
+        X& w  = workspace_.vector(2, x);
+        X& th = workspace_.vector(3, x);
+        X& t  = workspace_.vector(4, x);
+        X& ph = workspace_.vector(5, x);
+        X& s  = workspace_.vector(6, x);
+        X& sh = workspace_.vector(7, x);
+        X& z  = workspace_.vector(8, x);
+        X& zh = workspace_.vector(9, x);
+        X& v  = workspace_.vector(10, x);
+        X& q  = workspace_.vector(11, x);
+        X& qh = workspace_.vector(12, x);
+        X& y  = workspace_.vector(13, x);
+
+        detail::MultiDotProduct<X, Comm> dots(comm_, x.size());
+
+        res.clear();
+        Dune::Timer watch;
+        prec_.pre(x, b);
+        op_.applyscaleadd(-1, x, r);  // overwrite b with defect
+        rt = r;
+
+        rh = 0;
+        applyPreconditioner(rh, r);
+        op_.apply(rh, w);
+
+        std::array<double, 2> initialDots = {{ dots.localDot(r, r), dots.localDot(r, w) }};
+        dots.start(initialDots);
+        th = 0;
+        applyPreconditioner(th, w);
+        op_.apply(th, t);
+        waitForReduction(dots);
+
+        norm = norm_0 = std::sqrt(initialDots[0]);
+
+        if ( verbose_ > 0 )
+        {
+            std::cout << "=== PipelinedBiCGSTABSolver" << std::endl;
+            if ( verbose_ > 1 )
+            {
+                printOutput(0, norm_0);
+            }
+        }
+
+        if ( norm < 1e-30 )
+        {
+            res.converged = 1;
+            prec_.post(x);
+            res.iterations = 0;
+            res.reduction = 0;
+            res.conv_rate = 0;
+            res.elapsed = watch.elapsed();
+            return;
+        }
+
+        if ( std::abs(initialDots[1]) < EPSILON )
+        {
+            DUNE_THROW(Dune::ISTLError, "h=0 in PipelinedBiCGSTAB");
+        }
+
+        field_type rho = initialDots[0];
+        field_type alpha = rho / initialDots[1];
+        field_type beta = 0;
+        field_type omega = 0;
+
+        int it;
+        for ( it = 1; it <= maxit_; ++it )
+        {
+            if ( it == 1 )
+            {
+                ph = rh;
+                s  = w;
+                sh = th;
+                z  = t;
+            }
+            else
+            {
+                // p = r + beta (p - omega s) etc.
+                ph.axpy(-omega, sh);
+                ph *= beta;
+                ph += rh;
+                s.axpy(-omega, z);
+                s *= beta;
+                s += w;
+                sh.axpy(-omega, zh);
+                sh *= beta;
+                sh += th;
+                z.axpy(-omega, v);
+                z *= beta;
+                z += t;
+            }
+
+            q = r;
+            q.axpy(-alpha, s);
+            qh = rh;
+            qh.axpy(-alpha, sh);
+            y = w;
+            y.axpy(-alpha, z);
+
+            std::array<double, 2> omegaDots = {{ dots.localDot(q, y), dots.localDot(y, y) }};
+            dots.start(omegaDots);
+            zh = 0;
+            applyPreconditioner(zh, z);
+            op_.apply(zh, v);
+            waitForReduction(dots);
+
+            if ( std::abs(omegaDots[1]) <= EPSILON )
+            {
+                DUNE_THROW(Dune::ISTLError, "breakdown in PipelinedBiCGSTAB - (y,y) "
+                           << omegaDots[1] << " <= EPSILON " << EPSILON << " after " << it << " iterations");
+            }
+            omega = omegaDots[0] / omegaDots[1];
+
+            x.axpy(alpha, ph);
+            x.axpy(omega, qh);
+            r = q;
+            r.axpy(-omega, y);
+            // rh = qh - omega (th - alpha zh), w = y - omega (t - alpha v)
+            rh = qh;
+            rh.axpy(-omega, th);
+            rh.axpy(alpha * omega, zh);
+            w = y;
+            w.axpy(-omega, t);
+            w.axpy(alpha * omega, v);
+
+            std::array<double, 5> alphaDots = {{ dots.localDot(rt, r), dots.localDot(rt, w),
+                                                 dots.localDot(rt, s), dots.localDot(rt, z),
+                                                 dots.localDot(r, r) }};
+            dots.start(alphaDots);
+            th = 0;
+            applyPreconditioner(th, w);
+            op_.apply(th, t);
+            waitForReduction(dots);
+
+            norm = std::sqrt(alphaDots[4]);
+            if ( verbose_ > 1 )
+            {
+                printOutput(it, norm);
+            }
+            if ( norm < (reduction_ * norm_0) )
+            {
+                break;
+            }
+
+            if ( std::abs(rho) <= EPSILON || std::abs(omega) <= EPSILON )
+            {
+                DUNE_THROW(Dune::ISTLError, "breakdown in PipelinedBiCGSTAB - rho "
+                           << rho << ", omega " << omega << " after " << it << " iterations");
+            }
+            const field_type rho_new = alphaDots[0];
+            beta = ( alpha / omega ) * ( rho_new / rho );
+            const field_type h = alphaDots[1] + beta * alphaDots[2] - beta * omega * alphaDots[3];
+            if ( std::abs(h) < EPSILON )
+            {
+                DUNE_THROW(Dune::ISTLError, "h=0 in PipelinedBiCGSTAB");
+            }
+            alpha = rho_new / h;
+            rho = rho_new;
+        }
+
+        it = std::min(maxit_, it);
+
+        prec_.post(x);
+        res.iterations = it;
+        res.reduction = static_cast<double>(norm / norm_0);
+        res.converged = (norm < (reduction_ * norm_0));
+        res.conv_rate = std::pow(res.reduction, 1.0 / it);
+        res.elapsed = watch.elapsed();
+
+        if ( verbose_ > 0 )
+        {
+            std::cout << "=== rate=" << res.conv_rate
+                      << ", T=" << res.elapsed
+                      << ", TIT=" << res.elapsed / it
+                      << ", IT=" << it << std::endl;
+        }
+    }
+
+private:
+    void applyPreconditioner(X& v, const X& d)
+    {
+        TelemetryTimer timer(telemetryCounter(telemetry_, &LinearSolverTelemetry::prec_apply_time));
+        prec_.apply(v, d);
+    }
+
+    void waitForReduction(detail::MultiDotProduct<X, Comm>& dots)
+    {
+        TelemetryTimer timer(telemetryCounter(telemetry_, &LinearSolverTelemetry::reduction_time));
+        dots.wait();
+    }
+
+    void printOutput(int it, real_type norm) const
+    {
+        std::cout << std::setw(5) << it << " " << std::scientific
+                  << std::setprecision(5) << norm << std::endl;
+    }
+
+    Dune::LinearOperator<X, X>& op_;
+    Dune::Preconditioner<X, X>& prec_;
+    const Comm& comm_;
+    real_type reduction_;
+    int maxit_;
+    int verbose_;
+    KrylovWorkspace<X>& workspace_;
+    LinearSolverTelemetry* telemetry_;
+};
+
+} // namespace Opm
+
+#endif // OPM_KRYLOVSOLVERS_HEADER_INCLUDED
@@ -0,0 +1,106 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_LINEARSOLVERTELEMETRY_HEADER_INCLUDED
+#define OPM_LINEARSOLVERTELEMETRY_HEADER_INCLUDED
+
+#include <dune/common/timer.hh>
+
+#include <ostream>
+
+namespace Opm
+{
+
+/// \brief Timings of the parts of the linear solves of one process.
+///
+/// All times are wall clock times in seconds.
+struct LinearSolverTelemetry
+{
+    /// \brief Setup of operator and preconditioner.
+    double setup_time = 0.0;
+    /// \brief Application of the preconditioner (including its halo exchange).
+    double prec_apply_time = 0.0;
+    /// \brief Sparse matrix vector products of the reservoir matrix.
+    double spmv_time = 0.0;
+    /// \brief Application of the well contributions to the operator.
+    double well_apply_time = 0.0;
+    /// \brief Global reductions (dot products and norms) of the Krylov solver.
+    double reduction_time = 0.0;
+    /// \brief Total time spent in the Krylov solver.
+    double solve_time = 0.0;
+    /// \brief Number of linear solves.
+    int solves = 0;
+    /// \brief Number of linear iterations.
+    int iterations = 0;
+
+    void reset()
+    {
+        *this = LinearSolverTelemetry();
+    }
+
+    /// \brief Write the names of the columns printed by print.
+    static void printHeader(std::ostream& os)
+    {
+        os << "report_step,time,dt,solves,iterations,setup,prec_apply,spmv,well_apply,reduction,solve\n";
+    }
+
+    /// \brief Write one line with all values in comma separated format.
+    void print(std::ostream& os, int reportStep, double time, double dt) const
+    {
+        os << reportStep << ',' << time << ',' << dt << ','
+           << solves << ',' << iterations << ','
+           << setup_time << ',' << prec_apply_time << ','
+           << spmv_time << ',' << well_apply_time << ','
+           << reduction_time << ',' << solve_time << '\n';
+    }
+};
+
+/// \brief Adds the time of its lifetime to a counter of the telemetry.
+///
+/// Does nothing if the counter is null, i.e. if telemetry is disabled.
+class TelemetryTimer
+{
+public:
+    explicit TelemetryTimer(double* counter)
+        : counter_(counter), timer_(counter != nullptr)
+    {}
+
+    ~TelemetryTimer()
+    {
+        if ( counter_ )
+        {
+            *counter_ += timer_.elapsed();
+        }
+    }
+
+private:
+    double* counter_;
+    Dune::Timer timer_;
+};
+
+/// \brief The counter of telemetry for a member, null if telemetry is disabled.
+inline double* telemetryCounter(LinearSolverTelemetry* telemetry,
+                                double LinearSolverTelemetry::* counter)
+{
+    return telemetry ? &(telemetry->*counter) : nullptr;
+}
+
+} // namespace Opm
+
+#endif // OPM_LINEARSOLVERTELEMETRY_HEADER_INCLUDED
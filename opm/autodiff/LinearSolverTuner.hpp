@@ -0,0 +1,307 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_LINEARSOLVERTUNER_HEADER_INCLUDED
+#define OPM_LINEARSOLVERTUNER_HEADER_INCLUDED
+
+#include <opm/autodiff/NewtonIterationBlackoilInterleaved.hpp>
+
+#include <dune/common/timer.hh>
+#include <dune/istl/istlexception.hh>
+
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Opm
+{
+
+/// \brief Chooses the fastest of a few linear solver configurations on the
+///        linear systems of the first Newton iterations of a run.
+///
+/// The candidates are the configuration of the user and variations of its
+/// preconditioner and Krylov solver. They are used in turn for the linear
+/// solves, each for the given number of rounds, such that all candidates see
+/// systems of the same Newton iterations. The wall time of a solve includes the
+/// setup of the preconditioner. A candidate that fails to converge once is
+/// discarded. Afterwards the candidate with the smallest mean time is used for
+/// the rest of the run.
+class LinearSolverTuner
+{
+public:
+    typedef NewtonIterationBlackoilInterleavedParameters Parameters;
+
+    /// \brief An inactive tuner.
+    LinearSolverTuner()
+        : rounds_( 0 ), solves_( 0 ), current_( 0 ), best_( 0 )
+    {}
+
+    /// \param base      The configuration of the user, the first candidate.
+    /// \param withAmg   Whether the AMG and CPR preconditioners are available.
+    /// \param rounds    The number of solves of each candidate.
+    LinearSolverTuner( const Parameters& base, const bool withAmg, const int rounds )
+        : rounds_( rounds ), solves_( 0 ), current_( 0 ), best_( 0 )
+    {
+        addCandidate( base );
+
+        // ILU(0) with BiCGStab, and variations of its factorization
+        Parameters ilu = base;
+        ilu.ilu_fillin_level_ = 0;
+        ilu.ilu_milu_ = MILU_VARIANT::ILU;
+        ilu.ilu_redblack_ = false;
+        ilu.linear_solver_use_amg_ = false;
+        ilu.use_cpr_ = false;
+        ilu.newton_use_gmres_ = false;
+        ilu.newton_use_pipelined_bicgstab_ = false;
+        ilu.newton_use_recycling_gcr_ = false;
+        addCandidate( ilu );
+
+        Parameters iluFillin = ilu;
+        iluFillin.ilu_fillin_level_ = 1;
+        addCandidate( iluFillin );
+
+        Parameters milu = ilu;
+        milu.ilu_milu_ = MILU_VARIANT::MILU_1;
+        addCandidate( milu );
+
+        Parameters redBlack = ilu;
+        redBlack.ilu_redblack_ = true;
+        addCandidate( redBlack );
+
+        Parameters gmres = ilu;
+        gmres.newton_use_gmres_ = true;
+        addCandidate( gmres );
+
+        if ( withAmg )
+        {
+            Parameters amg = ilu;
+            amg.linear_solver_use_amg_ = true;
+            addCandidate( amg );
+
+            Parameters cpr = ilu;
+            cpr.use_cpr_ = true;
+            addCandidate( cpr );
+        }
+
+        seconds_.assign( candidates_.size(), 0.0 );
+        failed_.assign( candidates_.size(), false );
+    }
+
+    /// \brief Whether the candidates are still being tried.
+    bool tuning() const
+    {
+        return solves_ < rounds_ * static_cast<int>( candidates_.size() );
+    }
+
+    /// \brief The configuration of the next linear solve.
+    const Parameters& parameters() const
+    {
+        return candidates_[ tuning() ? current_ : best_ ];
+    }
+
+    /// \brief The configuration of the user, e.g. to repeat a failed solve.
+    const Parameters& baseParameters() const
+    {
+        return candidates_[ 0 ];
+    }
+
+    /// \brief Record the solve with the configuration of parameters().
+    /// \param seconds    The wall time of the solve including its setup, the
+    ///                   same on all processes.
+    /// \param converged  Whether the solve converged.
+    /// \return Whether parameters() changed.
+    bool record( const double seconds, const bool converged )
+    {
+        if ( !tuning() )
+        {
+            return false;
+        }
+        const std::size_t previous = current_;
+        if ( converged )
+        {
+            seconds_[ current_ ] += seconds;
+        }
+        else
+        {
+            failed_[ current_ ] = true;
+        }
+
+        // the next candidate that has not failed, one round after the other
+        do
+        {
+            ++solves_;
+            current_ = solves_ % candidates_.size();
+        }
+        while ( tuning() && failed_[ current_ ] );
+
+        if ( !tuning() )
+        {
+            best_ = 0;
+            double bestSeconds = std::numeric_limits<double>::max();
+            for ( std::size_t i = 0; i < candidates_.size(); ++i )
+            {
+                if ( !failed_[ i ] && seconds_[ i ] < bestSeconds )
+                {
+                    best_ = i;
+                    bestSeconds = seconds_[ i ];
+                }
+            }
+            return best_ != previous;
+        }
+        return current_ != previous;
+    }
+
+    /// \brief Solve with the configuration of parameters() and record the solve.
+    ///
+    /// A candidate that does not converge, or whose solve throws a
+    /// Dune::ISTLError, e.g. on a breakdown of the Krylov solver, or a
+    /// Dune::MatrixBlockError of a singular block of the preconditioner, is
+    /// discarded and the system is solved once more with the configuration of
+    /// the user. An exception of that solve, or of a failing configuration of
+    /// the user, is passed on.
+    /// \param solveWith         Solves with the given configuration, one of the
+    ///                          candidates, and returns whether it converged.
+    /// \param maxOverProcesses  The largest value of all processes.
+    /// \return Whether the system was solved.
+    template <class Solve, class Reduction>
+    bool solve( const Solve& solveWith, const Reduction& maxOverProcesses )
+    {
+        const Parameters& candidate = parameters();
+        const bool isBase = &candidate == &baseParameters();
+        std::exception_ptr failure;
+        bool converged = false;
+        Dune::Timer timer;
+        try
+        {
+            converged = solveWith( candidate );
+        }
+        catch ( const Dune::ISTLError& )
+        {
+            failure = std::current_exception();
+        }
+        catch ( const Dune::MatrixBlockError& )
+        {
+            failure = std::current_exception();
+        }
+        record( maxOverProcesses( timer.elapsed() ), converged );
+
+        if ( converged || isBase )
+        {
+            if ( failure )
+            {
+                std::rethrow_exception( failure );
+            }
+            return converged;
+        }
+        return solveWith( baseParameters() );
+    }
+
+    /// \brief The number of candidates.
+    std::size_t numCandidates() const
+    {
+        return candidates_.size();
+    }
+
+    /// \brief The chosen candidate, meaningful once tuning() is false.
+    std::size_t best() const
+    {
+        return best_;
+    }
+
+    /// \brief A table of the mean time per solve of the candidates, with the
+    ///        chosen one marked.
+    std::string summary() const
+    {
+        std::ostringstream os;
+        os << "Linear solver tuning, mean time per solve:";
+        for ( std::size_t i = 0; i < candidates_.size(); ++i )
+        {
+            os << "\n  " << ( i == best_ ? "* " : "  " );
+            if ( failed_[ i ] )
+            {
+                os << "      failed";
+            }
+            else
+            {
+                os.precision( 4 );
+                os.width( 12 );
+                os << seconds_[ i ] / rounds_;
+            }
+            os << "  " << describe( candidates_[ i ] );
+        }
+        os << "\nChosen linear solver: " << describe( candidates_[ best_ ] );
+        return os.str();
+    }
+
+    /// \brief The tuned parameters of a configuration as command line
+    ///        arguments, such that the choice can be given for similar decks.
+    static std::string describe( const Parameters& param )
+    {
+        static const char* milu[] = { "ILU", "MILU_1", "MILU_2", "MILU_3", "MILU_4" };
+        std::ostringstream os;
+        os << std::boolalpha
+           << "solver_approach=" << ( param.use_cpr_ ? "cpr" : "interleaved" )
+           << " linear_solver_use_amg=" << param.linear_solver_use_amg_
+           << " ilu_fillin_level=" << param.ilu_fillin_level_
+           << " ilu_milu=" << milu[ static_cast<int>( param.ilu_milu_ ) ]
+           << " ilu_redblack=" << param.ilu_redblack_
+           << " newton_use_gmres=" << param.newton_use_gmres_
+           << " linear_solver_restart=" << param.linear_solver_restart_;
+        if ( param.newton_use_pipelined_bicgstab_ )
+        {
+            os << " newton_use_pipelined_bicgstab=true";
+        }
+        if ( param.newton_use_recycling_gcr_ )
+        {
+            os << " newton_use_recycling_gcr=true";
+        }
+        return os.str();
+    }
+
+private:
+    // add a candidate unless it is the same as one before
+    void addCandidate( const Parameters& param )
+    {
+        const std::string description = describe( param );
+        for ( const Parameters& candidate : candidates_ )
+        {
+            if ( describe( candidate ) == description )
+            {
+                return;
+            }
+        }
+        candidates_.push_back( param );
+    }
+
+    std::vector<Parameters> candidates_;
+    // the total time of the solves of each candidate
+    std::vector<double> seconds_;
+    std::vector<bool> failed_;
+    int rounds_;
+    int solves_;
+    std::size_t current_;
+    std::size_t best_;
+};
+
+} // namespace Opm
+
+#endif // OPM_LINEARSOLVERTUNER_HEADER_INCLUDED
@@ -27,45 +27,197 @@
 #if HAVE_UMFPACK
 #include <dune/istl/umfpack.hh>
 #endif // HAVE_UMFPACK
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
 
 namespace Opm {
 
 namespace mswellhelpers
 {
-    // obtain y = D^-1 * x with a direct solver
+    // Direct solver for the matrix D of a multisegment well.
+    //
+    // The sparsity pattern of D follows the segment tree: the row of a segment has
+    // entries for the segment itself, its outlet segment and its inlet segments.
+    // Eliminating the segments from the leaves towards the top segment therefore does
+    // not create any fill-in, and the factorization only needs the outlet of each segment.
+    // The elimination order is computed once from the segment tree (symbolic part),
+    // while factorize() has to be called whenever the values of D change (numeric part).
+    // The factorization is then reused by all the following solves with the same D.
+    // If a diagonal block becomes singular during the elimination, we fall back to
+    // UMFPACK, which pivots over the whole matrix.
     template <typename MatrixType, typename VectorType>
-    VectorType
-    invDXDirect(const MatrixType& D, VectorType x)
+    class SegmentTreeSolver
     {
+    public:
+        typedef typename MatrixType::block_type BlockType;
+        typedef typename VectorType::block_type VectorBlockType;
+
+        // outlets[seg] is the index of the outlet segment of seg, -1 for the top segment
+        void init(const std::vector<int>& outlets)
+        {
+            outlets_ = outlets;
+            const int nseg = outlets_.size();
+
+            // order the segments such that every segment comes after all its inlets,
+            // by reversing the breadth first order starting from the top segments
+            std::vector<std::vector<int> > inlets(nseg);
+            order_.clear();
+            order_.reserve(nseg);
+            for (int seg = 0; seg < nseg; ++seg) {
+                if (outlets_[seg] < 0) {
+                    order_.push_back(seg);
+                } else {
+                    inlets[outlets_[seg]].push_back(seg);
+                }
+            }
+            for (int i = 0; i < int(order_.size()); ++i) {
+                for (const int inlet : inlets[order_[i]]) {
+                    order_.push_back(inlet);
+                }
+            }
+            if (int(order_.size()) != nseg) {
+                OPM_THROW(std::logic_error, "The segments of a multisegment well do not form a tree");
+            }
+            std::reverse(order_.begin(), order_.end());
+
+            invDiag_.resize(nseg);
+            lower_.resize(nseg);
+            upper_.resize(nseg);
+            factorized_ = false;
+        }
+
+        // compute the numerical factorization of D
+        void factorize(const MatrixType& D)
+        {
+            factorized_ = false;
 #if HAVE_UMFPACK
-        VectorType y(x.size());
-        y = 0.;
+            umfpack_.reset();
+#endif // HAVE_UMFPACK
 
-        Dune::UMFPack<MatrixType> linsolver(D, 0);
+            try {
+                std::vector<BlockType> diag(order_.size());
+                for (size_t seg = 0; seg < order_.size(); ++seg) {
+                    diag[seg] = D[seg][seg];
+                }
+                for (const int seg : order_) {
+                    invDiag_[seg] = diag[seg];
+                    invDiag_[seg].invert();
+                    const int outlet = outlets_[seg];
+                    if (outlet >= 0) {
+                        // L(outlet, seg) = D(outlet, seg) * D(seg, seg)^-1
+                        upper_[seg] = D[seg][outlet];
+                        lower_[seg] = D[outlet][seg];
+                        lower_[seg].rightmultiply(invDiag_[seg]);
+                        // D(outlet, outlet) -= L(outlet, seg) * D(seg, outlet)
+                        BlockType update = lower_[seg];
+                        update.rightmultiply(upper_[seg]);
+                        diag[outlet] -= update;
+                    }
+                }
+                factorized_ = isFinite();
+            } catch (const Dune::FMatrixError&) {
+                factorized_ = false;
+            }
 
-        // Object storing some statistics about the solving process
-        Dune::InverseOperatorResult res;
+            if (!factorized_) {
+#if HAVE_UMFPACK
+                umfpack_.reset(new Dune::UMFPack<MatrixType>(D, 0));
+#else
+                OPM_THROW(Opm::NumericalIssue, "singular diagonal block found in SegmentTreeSolver::factorize(). "
+                          "Reconfigure opm-simulator with SuiteSparse/UMFPACK support to handle it.");
+#endif // HAVE_UMFPACK
+            }
+        }
 
-        // Solve
-        linsolver.apply(y, x, res);
+        // obtain y = D^-1 * x using the latest factorization
+        VectorType solve(const VectorType& x) const
+        {
+            VectorType y(x.size());
+            solve(x, y);
+            return y;
+        }
+
+        // obtain y = D^-1 * x using the latest factorization, without
+        // allocating memory once y has the size of x
+        void solve(const VectorType& x, VectorType& y) const
+        {
+            if (y.size() != x.size()) {
+                y.resize(x.size());
+            }
+
+#if HAVE_UMFPACK
+            if (umfpack_) {
+                rhs_ = x;
+                Dune::InverseOperatorResult res;
+                umfpack_->apply(y, rhs_, res);
+            } else
+#endif // HAVE_UMFPACK
+            {
+                y = x;
+                // forward substitution, from the leaves towards the top segment
+                for (const int seg : order_) {
+                    const int outlet = outlets_[seg];
+                    if (outlet >= 0) {
+                        lower_[seg].mmv(y[seg], y[outlet]);
+                    }
+                }
+                // backward substitution, from the top segment towards the leaves
+                for (auto it = order_.rbegin(); it != order_.rend(); ++it) {
+                    const int seg = *it;
+                    const int outlet = outlets_[seg];
+                    if (outlet >= 0) {
+                        upper_[seg].mmv(y[outlet], y[seg]);
+                    }
+                    const VectorBlockType rhs = y[seg];
+                    invDiag_[seg].mv(rhs, y[seg]);
+                }
+            }
 
-        // Checking if there is any inf or nan in y
-        // it will be the solution before we find a way to catch the singularity of the matrix
-        for (size_t i_block = 0; i_block < y.size(); ++i_block) {
-            for (size_t i_elem = 0; i_elem < y[i_block].size(); ++i_elem) {
-                if (std::isinf(y[i_block][i_elem]) || std::isnan(y[i_block][i_elem]) ) {
-                    OPM_THROW(Opm::NumericalIssue, "nan or inf value found in invDXDirect due to singular matrix");
+            // Checking if there is any inf or nan in y
+            for (size_t i_block = 0; i_block < y.size(); ++i_block) {
+                for (size_t i_elem = 0; i_elem < y[i_block].size(); ++i_elem) {
+                    if (std::isinf(y[i_block][i_elem]) || std::isnan(y[i_block][i_elem]) ) {
+                        OPM_THROW(Opm::NumericalIssue, "nan or inf value found in SegmentTreeSolver::solve() due to singular matrix");
+                    }
                 }
             }
         }
 
-        return y;
-#else
-        OPM_THROW(std::runtime_error, "Cannot use invDXDirect() without UMFPACK. "
-                  "Reconfigure opm-simulator with SuiteSparse/UMFPACK support and recompile.");
+    private:
+        bool isFinite() const
+        {
+            for (const BlockType& block : invDiag_) {
+                for (const auto& row : block) {
+                    for (const auto& value : row) {
+                        if (!std::isfinite(value)) {
+                            return false;
+                        }
+                    }
+                }
+            }
+            return true;
+        }
+
+        // the outlet of each segment, -1 for the top segment
+        std::vector<int> outlets_;
+        // the elimination order, every segment comes after all its inlets
+        std::vector<int> order_;
+        // the inverse of the diagonal blocks after the elimination of the inlets
+        std::vector<BlockType> invDiag_;
+        // L(outlet, seg) and D(seg, outlet) for each segment
+        std::vector<BlockType> lower_;
+        std::vector<BlockType> upper_;
+        bool factorized_ = false;
+#if HAVE_UMFPACK
+        // fallback when the elimination along the segment tree breaks down
+        std::shared_ptr<Dune::UMFPack<MatrixType> > umfpack_;
+        // copy of the right hand side, which UMFPack may modify
+        mutable VectorType rhs_;
 #endif // HAVE_UMFPACK
-    }
+    };
 
 
 
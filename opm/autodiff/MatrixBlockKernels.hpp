@@ -0,0 +1,344 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_MATRIXBLOCKKERNELS_HEADER_INCLUDED
+#define OPM_MATRIXBLOCKKERNELS_HEADER_INCLUDED
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define OPM_BLOCKKERNELS_USE_AVX2 1
+#endif
+
+namespace Opm
+{
+namespace detail
+{
+
+    /// \brief Small dense block kernels used in the linear solver hot paths.
+    ///
+    /// The kernel is selected at compile time from the block size. The generic
+    /// version loops over the entries, the specializations for the block sizes
+    /// used by the flow_ebos_* simulators are fully unrolled, such that the
+    /// compiler can keep the block in registers. For 4x4 blocks of doubles an
+    /// AVX2 version is used if the code is compiled with AVX2 and FMA support.
+    ///
+    /// All kernels work for blocks and vectors with different field types
+    /// (e.g. single precision preconditioner storage and double precision vectors).
+    template<int rows, int cols>
+    struct BlockKernel
+    {
+        //! \brief y = A x
+        template<class Block, class X, class Y>
+        static void mv(const Block& A, const X& x, Y& y)
+        {
+            for ( int i = 0; i < rows; ++i )
+            {
+                typename Y::field_type sum = 0;
+                for ( int j = 0; j < cols; ++j )
+                {
+                    sum += A[i][j] * x[j];
+                }
+                y[i] = sum;
+            }
+        }
+
+        //! \brief y += alpha A x
+        template<class F, class Block, class X, class Y>
+        static void usmv(const F alpha, const Block& A, const X& x, Y& y)
+        {
+            for ( int i = 0; i < rows; ++i )
+            {
+                typename Y::field_type sum = 0;
+                for ( int j = 0; j < cols; ++j )
+                {
+                    sum += A[i][j] * x[j];
+                }
+                y[i] += alpha * sum;
+            }
+        }
+    };
+
+    template<>
+    struct BlockKernel<1, 1>
+    {
+        template<class Block, class X, class Y>
+        static void mv(const Block& A, const X& x, Y& y)
+        {
+            y[0] = A[0][0] * x[0];
+        }
+
+        template<class F, class Block, class X, class Y>
+        static void usmv(const F alpha, const Block& A, const X& x, Y& y)
+        {
+            y[0] += alpha * A[0][0] * x[0];
+        }
+    };
+
+    template<>
+    struct BlockKernel<2, 2>
+    {
+        template<class Block, class X, class Y>
+        static void mv(const Block& A, const X& x, Y& y)
+        {
+            const auto x0 = x[0], x1 = x[1];
+            y[0] = A[0][0] * x0 + A[0][1] * x1;
+            y[1] = A[1][0] * x0 + A[1][1] * x1;
+        }
+
+        template<class F, class Block, class X, class Y>
+        static void usmv(const F alpha, const Block& A, const X& x, Y& y)
+        {
+            const auto x0 = alpha * x[0], x1 = alpha * x[1];
+            y[0] += A[0][0] * x0 + A[0][1] * x1;
+            y[1] += A[1][0] * x0 + A[1][1] * x1;
+        }
+    };
+
+    template<>
+    struct BlockKernel<3, 3>
+    {
+        template<class Block, class X, class Y>
+        static void mv(const Block& A, const X& x, Y& y)
+        {
+            const auto x0 = x[0], x1 = x[1], x2 = x[2];
+            y[0] = A[0][0] * x0 + A[0][1] * x1 + A[0][2] * x2;
+            y[1] = A[1][0] * x0 + A[1][1] * x1 + A[1][2] * x2;
+            y[2] = A[2][0] * x0 + A[2][1] * x1 + A[2][2] * x2;
+        }
+
+        template<class F, class Block, class X, class Y>
+        static void usmv(const F alpha, const Block& A, const X& x, Y& y)
+        {
+            const auto x0 = alpha * x[0], x1 = alpha * x[1], x2 = alpha * x[2];
+            y[0] += A[0][0] * x0 + A[0][1] * x1 + A[0][2] * x2;
+            y[1] += A[1][0] * x0 + A[1][1] * x1 + A[1][2] * x2;
+            y[2] += A[2][0] * x0 + A[2][1] * x1 + A[2][2] * x2;
+        }
+    };
+
+#ifdef OPM_BLOCKKERNELS_USE_AVX2
+    //! \brief Computes the 4x4 product A x with AVX2 from the rows of A.
+    inline __m256d mv4x4Avx2(const double* a0, const double* a1,
+                             const double* a2, const double* a3,
+                             const __m256d x)
+    {
+        const __m256d p0 = _mm256_mul_pd(_mm256_loadu_pd(a0), x);
+        const __m256d p1 = _mm256_mul_pd(_mm256_loadu_pd(a1), x);
+        const __m256d p2 = _mm256_mul_pd(_mm256_loadu_pd(a2), x);
+        const __m256d p3 = _mm256_mul_pd(_mm256_loadu_pd(a3), x);
+        // pairwise sums: [p0_01, p1_01, p0_23, p1_23] and [p2_01, p3_01, p2_23, p3_23]
+        const __m256d s01 = _mm256_hadd_pd(p0, p1);
+        const __m256d s23 = _mm256_hadd_pd(p2, p3);
+        const __m256d lo  = _mm256_permute2f128_pd(s01, s23, 0x20);
+        const __m256d hi  = _mm256_permute2f128_pd(s01, s23, 0x31);
+        return _mm256_add_pd(lo, hi);
+    }
+#endif
+
+    template<>
+    struct BlockKernel<4, 4>
+    {
+        template<class Block, class X, class Y>
+        static void mv(const Block& A, const X& x, Y& y)
+        {
+            mv(A, x, y, UseAvx2<Block, X, Y>());
+        }
+
+        template<class F, class Block, class X, class Y>
+        static void usmv(const F alpha, const Block& A, const X& x, Y& y)
+        {
+            usmv(alpha, A, x, y, UseAvx2<Block, X, Y>());
+        }
+
+    private:
+        //! \brief Whether the AVX2 version can be used for the given types.
+        template<class Block, class X, class Y>
+        struct UseAvx2
+#ifdef OPM_BLOCKKERNELS_USE_AVX2
+            : std::integral_constant<bool,
+                                     std::is_same<typename Block::field_type, double>::value &&
+                                     std::is_same<typename X::field_type, double>::value &&
+                                     std::is_same<typename Y::field_type, double>::value>
+#else
+            : std::false_type
+#endif
+        {};
+
+        template<class Block, class X, class Y>
+        static void mv(const Block& A, const X& x, Y& y, std::false_type)
+        {
+            const auto x0 = x[0], x1 = x[1], x2 = x[2], x3 = x[3];
+            for ( int i = 0; i < 4; ++i )
+            {
+                y[i] = A[i][0] * x0 + A[i][1] * x1 + A[i][2] * x2 + A[i][3] * x3;
+            }
+        }
+
+        template<class F, class Block, class X, class Y>
+        static void usmv(const F alpha, const Block& A, const X& x, Y& y, std::false_type)
+        {
+            const auto x0 = alpha * x[0], x1 = alpha * x[1], x2 = alpha * x[2], x3 = alpha * x[3];
+            for ( int i = 0; i < 4; ++i )
+            {
+                y[i] += A[i][0] * x0 + A[i][1] * x1 + A[i][2] * x2 + A[i][3] * x3;
+            }
+        }
+
+#ifdef OPM_BLOCKKERNELS_USE_AVX2
+        template<class Block, class X, class Y>
+        static void mv(const Block& A, const X& x, Y& y, std::true_type)
+        {
+            const __m256d r = mv4x4Avx2(&A[0][0], &A[1][0], &A[2][0], &A[3][0],
+                                        _mm256_loadu_pd(&x[0]));
+            _mm256_storeu_pd(&y[0], r);
+        }
+
+        template<class F, class Block, class X, class Y>
+        static void usmv(const F alpha, const Block& A, const X& x, Y& y, std::true_type)
+        {
+            const __m256d r = mv4x4Avx2(&A[0][0], &A[1][0], &A[2][0], &A[3][0],
+                                        _mm256_loadu_pd(&x[0]));
+            _mm256_storeu_pd(&y[0], _mm256_fmadd_pd(_mm256_set1_pd(alpha), r,
+                                                    _mm256_loadu_pd(&y[0])));
+        }
+#endif
+    };
+
+    //! \brief y = A x for a small dense block A.
+    template<class Block, class X, class Y>
+    inline void blockMv(const Block& A, const X& x, Y& y)
+    {
+        BlockKernel<Block::rows, Block::cols>::mv(A, x, y);
+    }
+
+    //! \brief y += A x for a small dense block A.
+    template<class Block, class X, class Y>
+    inline void blockUmv(const Block& A, const X& x, Y& y)
+    {
+        BlockKernel<Block::rows, Block::cols>::usmv(1.0, A, x, y);
+    }
+
+    //! \brief y -= A x for a small dense block A.
+    template<class Block, class X, class Y>
+    inline void blockMmv(const Block& A, const X& x, Y& y)
+    {
+        BlockKernel<Block::rows, Block::cols>::usmv(-1.0, A, x, y);
+    }
+
+    //! \brief y += alpha A x for a small dense block A.
+    template<class F, class Block, class X, class Y>
+    inline void blockUsmv(const F alpha, const Block& A, const X& x, Y& y)
+    {
+        BlockKernel<Block::rows, Block::cols>::usmv(alpha, A, x, y);
+    }
+
+    //! \brief y = A x for a BCRSMatrix A using the block kernels.
+    //!
+    //! The rows are independent and distributed over the OpenMP threads.
+    template<class M, class X, class Y>
+    void bcrsMv(const M& A, const X& x, Y& y)
+    {
+        const int numRows = A.N();
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
+        for ( int i = 0; i < numRows; ++i )
+        {
+            const auto& row = A[ i ];
+            auto& yi = y[ i ];
+            yi = 0;
+            for ( auto col = row.begin(), cend = row.end(); col != cend; ++col )
+            {
+                blockUmv( *col, x[ col.index() ], yi );
+            }
+        }
+    }
+
+    //! \brief y += alpha A x for a BCRSMatrix A using the block kernels.
+    template<class F, class M, class X, class Y>
+    void bcrsUsmv(const F alpha, const M& A, const X& x, Y& y)
+    {
+        const int numRows = A.N();
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
+        for ( int i = 0; i < numRows; ++i )
+        {
+            const auto& row = A[ i ];
+            auto& yi = y[ i ];
+            for ( auto col = row.begin(), cend = row.end(); col != cend; ++col )
+            {
+                blockUsmv( alpha, *col, x[ col.index() ], yi );
+            }
+        }
+    }
+
+    //! \brief y = A x for the rows of A with a true entry in rowMask,
+    //!        the other rows of y are set to zero.
+    template<class M, class X, class Y>
+    void bcrsMv(const M& A, const X& x, Y& y, const std::vector<bool>& rowMask)
+    {
+        const int numRows = A.N();
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
+        for ( int i = 0; i < numRows; ++i )
+        {
+            auto& yi = y[ i ];
+            yi = 0;
+            if ( ! rowMask[ i ] )
+                continue;
+            const auto& row = A[ i ];
+            for ( auto col = row.begin(), cend = row.end(); col != cend; ++col )
+            {
+                blockUmv( *col, x[ col.index() ], yi );
+            }
+        }
+    }
+
+    //! \brief y += alpha A x for the rows of A with a true entry in rowMask,
+    //!        the other rows of y are left unchanged.
+    template<class F, class M, class X, class Y>
+    void bcrsUsmv(const F alpha, const M& A, const X& x, Y& y, const std::vector<bool>& rowMask)
+    {
+        const int numRows = A.N();
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
+        for ( int i = 0; i < numRows; ++i )
+        {
+            if ( ! rowMask[ i ] )
+                continue;
+            const auto& row = A[ i ];
+            auto& yi = y[ i ];
+            for ( auto col = row.begin(), cend = row.end(); col != cend; ++col )
+            {
+                blockUsmv( alpha, *col, x[ col.index() ], yi );
+            }
+        }
+    }
+
+} // namespace detail
+} // namespace Opm
+
+#endif // OPM_MATRIXBLOCKKERNELS_HEADER_INCLUDED
@@ -25,6 +25,7 @@
 #include <opm/parser/eclipse/Parser/ParserKeywords/P.hpp>
 
 #include <opm/autodiff/MissingFeatures.hpp>
+#include <opm/simulators/DeferredLogger.hpp>
 
 #include <unordered_set>
 #include <string>
@@ -45,7 +46,8 @@ namespace MissingFeatures {
 
 
     template <typename T>
-    void checkOptions(const DeckKeyword& keyword, std::multimap<std::string , PartiallySupported<T> >& map)
+    void checkOptions(const DeckKeyword& keyword, std::multimap<std::string , PartiallySupported<T> >& map,
+                      DeferredLogger& logger)
     {
         // check for partially supported keywords.
         typename std::multimap<std::string, PartiallySupported<T> >::iterator it, itlow, itup;
@@ -57,12 +59,19 @@ namespace MissingFeatures {
                 std::string msg = "For keyword '" + it->first + "' only value " + boost::lexical_cast<std::string>(it->second.item_value)
                     + " in item " + it->second.item + " is supported by flow.\n"
                     + "In file " + keyword.getFileName() + ", line " + std::to_string(keyword.getLineNumber()) + "\n";
-                OpmLog::warning(msg);
+                logger.warning(msg);
             }
         }
     }
 
     void checkKeywords(const Deck& deck)
+    {
+        DeferredLogger logger(DeferredLogger::Communication(Dune::MPIHelper::getLocalCommunicator()));
+        checkKeywords(deck, logger);
+        logger.logMessages();
+    }
+
+    void checkKeywords(const Deck& deck, DeferredLogger& logger)
     {
         // These keywords are supported by opm-parser, but are not supported
         // by flow. For some of them, only part of the options are supported.
@@ -214,10 +223,10 @@ namespace MissingFeatures {
             if (it != unsupported_keywords.end()) {
                 std::string msg = "Keyword '" + keyword.name() + "' is not supported by flow.\n"
                     + "In file " + keyword.getFileName() + ", line " + std::to_string(keyword.getLineNumber()) + "\n";
-                OpmLog::warning(msg);
+                logger.warning(msg);
             }
-            checkOptions<std::string>(keyword, string_options);
-            checkOptions<int>(keyword, int_options);
+            checkOptions<std::string>(keyword, string_options, logger);
+            checkOptions<int>(keyword, int_options, logger);
         }
     }
 } // namespace MissingFeatures
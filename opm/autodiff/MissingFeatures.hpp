@@ -22,6 +22,8 @@
 
 namespace Opm {
 
+class DeferredLogger;
+
 namespace MissingFeatures {
 
     template <typename T>
@@ -34,10 +36,16 @@ namespace MissingFeatures {
     void addSupported(std::multimap<std::string, PartiallySupported<T> >& map, T itemValue);
 
     template <typename T>
-    void checkOptions(const DeckKeyword& keyword, std::multimap<std::string , PartiallySupported<T> >& map);
+    void checkOptions(const DeckKeyword& keyword, std::multimap<std::string , PartiallySupported<T> >& map,
+                      DeferredLogger& logger);
 
+    /// Warn about the keywords of the deck that are not supported by flow.
     void checkKeywords(const Deck& deck);
 
+    /// As above, but the warnings are kept by the logger, such that the check
+    /// can run on a thread of its own. Only reads the deck.
+    void checkKeywords(const Deck& deck, DeferredLogger& logger);
+
 }
 
 }
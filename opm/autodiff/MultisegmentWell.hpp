@@ -24,6 +24,7 @@
 
 
 #include <opm/autodiff/WellInterface.hpp>
+#include <opm/autodiff/MSWellHelpers.hpp>
 
 namespace Opm
 {
@@ -106,7 +107,7 @@ namespace Opm
                          const int num_components);
 
         virtual void init(const PhaseUsage* phase_usage_arg,
-                          const std::vector<double>& depth_arg,
+                          const CompactStaticArray& depth_arg,
                           const double gravity_arg,
                           const int num_cells);
 
@@ -217,10 +218,18 @@ namespace Opm
         mutable OffDiagMatWell duneC_;
         // diagonal matrix for the well
         mutable DiagMatWell duneD_;
+        // factorization of duneD_, updated after every assembly of the well equations
+        mutable mswellhelpers::SegmentTreeSolver<DiagMatWell, BVectorWell> duneDSolver_;
+        // the bytes of the well matrices
+        mutable MemoryAccounting::Account matrix_memory_{ MemoryAccounting::WellMatrices };
 
         // residuals of the well equations
         mutable BVectorWell resWell_;
 
+        // scratch vectors of the operator apply, sized with the segments
+        mutable BVectorWell Bx_;
+        mutable BVectorWell invDBx_;
+
         // the values for the primary varibles
         // based on different solutioin strategies, the wells can have different primary variables
         mutable std::vector<std::array<double, numWellEq> > primary_variables_;
@@ -254,6 +263,12 @@ namespace Opm
 
         std::vector<double> segment_depth_diffs_;
 
+        // the index of the outlet segment, -1 for the top segment
+        std::vector<int> segment_outlets_;
+
+        // the length between the segment and its outlet segment
+        std::vector<double> segment_lengths_;
+
         void initMatrixAndVectors(const int num_cells) const;
 
         // protected functions
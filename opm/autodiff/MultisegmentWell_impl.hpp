@@ -43,6 +43,8 @@ namespace Opm
     , segment_viscosities_(numberOfSegments(), 0.0)
     , segment_mass_rates_(numberOfSegments(), 0.0)
     , segment_depth_diffs_(numberOfSegments(), 0.0)
+    , segment_outlets_(numberOfSegments(), -1)
+    , segment_lengths_(numberOfSegments(), 0.0)
     {
         // not handling solvent or polymer for now with multisegment well
         if (has_solvent) {
@@ -87,12 +89,17 @@ namespace Opm
 
         // calculating the depth difference between the segment and its oulet_segments
         // for the top segment, we will make its zero unless we find other purpose to use this value
+        // the outlet index and the length to the outlet are also stored, they are used
+        // for every segment in every iteration
         for (int seg = 1; seg < numberOfSegments(); ++seg) {
             const double segment_depth = segmentSet()[seg].depth();
             const int outlet_segment_number = segmentSet()[seg].outletSegment();
-            const Segment& outlet_segment = segmentSet()[segmentNumberToIndex(outlet_segment_number)];
+            const int outlet_segment_index = segmentNumberToIndex(outlet_segment_number);
+            const Segment& outlet_segment = segmentSet()[outlet_segment_index];
             const double outlet_depth = outlet_segment.depth();
             segment_depth_diffs_[seg] = segment_depth - outlet_depth;
+            segment_outlets_[seg] = outlet_segment_index;
+            segment_lengths_[seg] = segmentSet()[seg].totalLength() - outlet_segment.totalLength();
         }
     }
 
@@ -104,7 +111,7 @@ namespace Opm
     void
     MultisegmentWell<TypeTag>::
     init(const PhaseUsage* phase_usage_arg,
-         const std::vector<double>& depth_arg,
+         const CompactStaticArray& depth_arg,
          const double gravity_arg,
          const int num_cells)
     {
@@ -179,6 +186,9 @@ namespace Opm
             }
         }
 
+        // the segment tree for the factorization of duneD_
+        duneDSolver_.init(segment_outlets_);
+
         // make the C matrix
         for (auto row = duneC_.createbegin(), end = duneC_.createend(); row != end; ++row) {
             // the number of the row corresponds to the segment number now.
@@ -198,9 +208,14 @@ namespace Opm
         }
 
         resWell_.resize( numberOfSegments() );
+        Bx_.resize( numberOfSegments() );
+        invDBx_.resize( numberOfSegments() );
 
         primary_variables_.resize(numberOfSegments());
         primary_variables_evaluation_.resize(numberOfSegments());
+
+        matrix_memory_.set(MemoryAccounting::matrixBytes(duneB_) + MemoryAccounting::matrixBytes(duneC_)
+                           + MemoryAccounting::matrixBytes(duneD_));
     }
 
 
@@ -489,15 +504,13 @@ namespace Opm
     MultisegmentWell<TypeTag>::
     apply(const BVector& x, BVector& Ax) const
     {
-        BVectorWell Bx(duneB_.N());
+        duneB_.mv(x, Bx_);
 
-        duneB_.mv(x, Bx);
+        // invDBx_ = duneD^-1 * Bx_
+        duneDSolver_.solve(Bx_, invDBx_);
 
-        // invDBx = duneD^-1 * Bx_
-        const BVectorWell invDBx = mswellhelpers::invDXDirect(duneD_, Bx);
-
-        // Ax = Ax - duneC_^T * invDBx
-        duneC_.mmtv(invDBx,Ax);
+        // Ax = Ax - duneC_^T * invDBx_
+        duneC_.mmtv(invDBx_, Ax);
     }
 
 
@@ -509,10 +522,10 @@ namespace Opm
     MultisegmentWell<TypeTag>::
     apply(BVector& r) const
     {
-        // invDrw_ = duneD^-1 * resWell_
-        const BVectorWell invDrw = mswellhelpers::invDXDirect(duneD_, resWell_);
-        // r = r - duneC_^T * invDrw
-        duneC_.mmtv(invDrw, r);
+        // invDBx_ = duneD^-1 * resWell_
+        duneDSolver_.solve(resWell_, invDBx_);
+        // r = r - duneC_^T * invDBx_
+        duneC_.mmtv(invDBx_, r);
     }
 
 
@@ -628,7 +641,7 @@ namespace Opm
         // resWell = resWell - B * x
         duneB_.mmv(x, resWell);
         // xw = D^-1 * resWell
-        xw = mswellhelpers::invDXDirect(duneD_, resWell);
+        xw = duneDSolver_.solve(resWell);
     }
 
 
@@ -642,7 +655,7 @@ namespace Opm
     {
         // We assemble the well equations, then we check the convergence,
         // which is why we do not put the assembleWellEq here.
-        const BVectorWell dx_well = mswellhelpers::invDXDirect(duneD_, resWell_);
+        const BVectorWell dx_well = duneDSolver_.solve(resWell_);
 
         updateWellState(dx_well, false, well_state);
     }
@@ -1118,16 +1131,20 @@ namespace Opm
             surf_dens[compIdx] = FluidSystem::referenceDensity( phaseIdx, pvt_region_index );
         }
 
+        // the buffers are shared by all the segments
+        std::vector<EvalWell> mix_s(num_components_);
+        std::vector<EvalWell> b(num_components_);
+        std::vector<EvalWell> visc(num_components_);
+        std::vector<EvalWell> mix(num_components_);
+
         for (int seg = 0; seg < numberOfSegments(); ++seg) {
             // the compostion of the components inside wellbore under surface condition
-            std::vector<EvalWell> mix_s(num_components_, 0.0);
             for (int comp_idx = 0; comp_idx < num_components_; ++comp_idx) {
                 mix_s[comp_idx] = surfaceVolumeFraction(seg, comp_idx);
+                b[comp_idx] = 0.0;
+                visc[comp_idx] = 0.0;
             }
 
-            std::vector<EvalWell> b(num_components_, 0.0);
-            std::vector<EvalWell> visc(num_components_, 0.0);
-
             const EvalWell seg_pressure = getSegmentPressure(seg);
             if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
                 const unsigned waterCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::waterCompIdx);
@@ -1205,7 +1222,7 @@ namespace Opm
                 }
             }
 
-            std::vector<EvalWell> mix(mix_s);
+            mix = mix_s;
             if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx) && FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
                 const unsigned gasCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::gasCompIdx);
                 const unsigned oilCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::oilCompIdx);
@@ -1450,7 +1467,7 @@ namespace Opm
         }
 
         // contribution from the outlet segment
-        const int outlet_segment_index = segmentNumberToIndex(segmentSet()[seg].outletSegment());
+        const int outlet_segment_index = segment_outlets_[seg];
         const EvalWell outlet_pressure = getSegmentPressure(outlet_segment_index);
 
         resWell_[seg][SPres] -= outlet_pressure.value();
@@ -1487,12 +1504,12 @@ namespace Opm
         const EvalWell mass_rate = segment_mass_rates_[seg];
         const EvalWell density = segment_densities_[seg];
         const EvalWell visc = segment_viscosities_[seg];
-        const int outlet_segment_index = segmentNumberToIndex(segmentSet()[seg].outletSegment());
-        const double length = segmentSet()[seg].totalLength() - segmentSet()[outlet_segment_index].totalLength();
+        const double length = segment_lengths_[seg];
         assert(length > 0.);
-        const double roughness = segmentSet()[seg].roughness();
-        const double area = segmentSet()[seg].crossArea();
-        const double diameter = segmentSet()[seg].internalDiameter();
+        const Segment& segment = segmentSet()[seg];
+        const double roughness = segment.roughness();
+        const double area = segment.crossArea();
+        const double diameter = segment.internalDiameter();
 
         const double sign = mass_rate < 0. ? 1.0 : - 1.0;
 
@@ -1717,7 +1734,7 @@ namespace Opm
 
             assembleWellEqWithoutIteration(ebosSimulator, dt, well_state, true);
 
-            const BVectorWell dx_well = mswellhelpers::invDXDirect(duneD_, resWell_);
+            const BVectorWell dx_well = duneDSolver_.solve(resWell_);
 
             // TODO: use these small values for now, not intend to reach the convergence
             // in this stage, but, should we?
@@ -1858,6 +1875,8 @@ namespace Opm
                 assemblePressureEq(seg);
             }
         }
+
+        duneDSolver_.factorize(duneD_);
     }
 
 }
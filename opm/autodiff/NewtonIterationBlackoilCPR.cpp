@@ -98,9 +98,9 @@ namespace Opm
             // Eliminate the well-related unknowns, and corresponding equations.
             elim_eqs.reserve(2);
             elim_eqs.push_back(eqs[np]);
-            eqs = eliminateVariable(eqs, np); // Eliminate well flux unknowns.
+            eqs = eliminateVariable(eqs, np, flux_elimination_); // Eliminate well flux unknowns.
             elim_eqs.push_back(eqs[np]);
-            eqs = eliminateVariable(eqs, np); // Eliminate well bhp unknowns.
+            eqs = eliminateVariable(eqs, np, bhp_elimination_); // Eliminate well bhp unknowns.
             assert(int(eqs.size()) == np);
         }
 
@@ -144,11 +144,8 @@ namespace Opm
             typedef Dune::OwnerOverlapCopyCommunication<int,int> Comm;
             const ParallelISTLInformation& info =
                 boost::any_cast<const ParallelISTLInformation&>( parallelInformation_);
-            Comm istlComm(info.communicator());
-            Comm istlAeComm(info.communicator());
-            info.copyValuesTo(istlAeComm.indexSet(), istlAeComm.remoteIndices());
-            info.copyValuesTo(istlComm.indexSet(), istlComm.remoteIndices(),
-                              istlAe.N(), istlA.N()/istlAe.N());
+            Comm& istlComm = *info.istlCommunication(istlAe.N(), istlA.N()/istlAe.N());
+            Comm& istlAeComm = *info.istlCommunication(0);
             // Construct operator, scalar product and vectors needed.
             typedef Dune::OverlappingSchwarzOperator<Mat,Vector,Vector,Comm> Operator;
             Operator opA(istlA, istlComm);
@@ -178,8 +175,8 @@ namespace Opm
         if ( hasWells ) {
             // Compute full solution using the eliminated equations.
             // Recovery in inverse order of elimination.
-            dx = recoverVariable(elim_eqs[1], dx, np);
-            dx = recoverVariable(elim_eqs[0], dx, np);
+            dx = recoverVariable(elim_eqs[1], dx, np, bhp_elimination_);
+            dx = recoverVariable(elim_eqs[0], dx, np, flux_elimination_);
         }
         return dx;
     }
@@ -26,6 +26,7 @@
 
 #include <opm/autodiff/DuneMatrix.hpp>
 #include <opm/autodiff/NewtonIterationBlackoilInterface.hpp>
+#include <opm/autodiff/NewtonIterationUtilities.hpp>
 #include <opm/autodiff/CPRPreconditioner.hpp>
 #include <opm/common/utility/parameters/ParameterGroup.hpp>
 #include <opm/core/linalg/LinearSolverInterface.hpp>
@@ -43,6 +44,8 @@ namespace Opm
     /// The approach is similar to the one described in
     /// "Preconditioning for Efficiently Applying Algebraic Multigrid
     /// in Fully Implicit Reservoir Simulations" by Gries et al (SPE 163608).
+    /// The simulators use the BlackoilAmg of NewtonIterationBlackoilInterleaved
+    /// for solver_approach=cpr instead, unless cpr_use_blackoil_amg=false.
     class NewtonIterationBlackoilCPR : public NewtonIterationBlackoilInterface
     {
         typedef Dune::FieldVector<double, 1   > VectorBlockType;
@@ -130,6 +133,9 @@ namespace Opm
         CPRParameter cpr_param_;
 
         mutable int iterations_;
+        // symbolic work of the well eliminations, kept between calls
+        mutable EliminationCache flux_elimination_;
+        mutable EliminationCache bhp_elimination_;
         boost::any parallelInformation_;
 
         const bool newton_use_gmres_;
@@ -107,10 +107,34 @@ namespace Opm
         const boost::any& parallelInformation() const { return istlSolver_.parallelInformation(); }
 
     public:
+        /// Set up istlA from the jacobians of eqs. The sparsity pattern of the
+        /// previous call is reused as long as all derivatives fit into it, in
+        /// which case the derivatives are scattered directly into the blocks.
         void formInterleavedSystem(const std::vector<LinearisedBlackoilResidual::ADB>& eqs,
                                    Mat& istlA) const
         {
             assert( np == int(eqs.size()) );
+            const int size = eqs[0].size();
+            if (int(istlA.N()) == size && int(istlA.M()) == size
+                && scatterInterleavedSystem(eqs, istlA)) {
+                return;
+            }
+
+            createInterleavedPattern(eqs, parameters_.require_full_sparsity_pattern_, istlA);
+            if (!scatterInterleavedSystem(eqs, istlA)) {
+                // The pressure derivatives did not cover all couplings.
+                createInterleavedPattern(eqs, true, istlA);
+                const bool fits = scatterInterleavedSystem(eqs, istlA);
+                static_cast<void>(fits);
+                assert(fits);
+            }
+        }
+
+        /// Create the block sparsity pattern of istlA from the jacobians of eqs.
+        void createInterleavedPattern(const std::vector<LinearisedBlackoilResidual::ADB>& eqs,
+                                      const bool fullSparsityPattern,
+                                      Mat& istlA) const
+        {
             // Find sparsity structure as union of basic block sparsity structures,
             // corresponding to the jacobians with respect to pressure.
             // Use our custom PointOneOp to get to the union structure.
@@ -124,7 +148,7 @@ namespace Opm
             // For some cases (for instance involving Solvent flow) the reasoning for only adding
             // the pressure derivatives fails. As getting the sparsity pattern is non-trivial, in terms
             // of work, the full sparsity pattern is only added when required.
-            if (parameters_.require_full_sparsity_pattern_) {
+            if (fullSparsityPattern) {
                 for (int p1 = 0; p1 < np; ++p1) {
                     for (int p2 = 1; p2 < np; ++p2) { // pressure is already added
                         const AutoDiffMatrix::SparseRep& mat = eqs[p1].derivative()[p2].getSparse();
@@ -136,33 +160,31 @@ namespace Opm
             // Automatically convert the column major structure to a row-major structure
             Eigen::SparseMatrix<double, Eigen::RowMajor> row_major = col_major;
 
-            const int size = row_major.rows();
-            assert(size == row_major.cols());
+            assert(row_major.rows() == row_major.cols());
 
-            {
-                // Create ISTL matrix with interleaved rows and columns (block structured).
-                istlA.setSize(row_major.rows(), row_major.cols(), row_major.nonZeros());
-                istlA.setBuildMode(Mat::row_wise);
-                const int* ia = row_major.outerIndexPtr();
-                const int* ja = row_major.innerIndexPtr();
-                const typename Mat::CreateIterator endrow = istlA.createend();
-                for (typename Mat::CreateIterator row = istlA.createbegin(); row != endrow; ++row) {
-                    const int ri = row.index();
-                    for (int i = ia[ri]; i < ia[ri + 1]; ++i) {
-                        row.insert(ja[i]);
-                    }
+            // Create ISTL matrix with interleaved rows and columns (block structured).
+            Mat pattern;
+            pattern.setSize(row_major.rows(), row_major.cols(), row_major.nonZeros());
+            pattern.setBuildMode(Mat::row_wise);
+            const int* ia = row_major.outerIndexPtr();
+            const int* ja = row_major.innerIndexPtr();
+            const typename Mat::CreateIterator endrow = pattern.createend();
+            for (typename Mat::CreateIterator row = pattern.createbegin(); row != endrow; ++row) {
+                const int ri = row.index();
+                for (int i = ia[ri]; i < ia[ri + 1]; ++i) {
+                    row.insert(ja[i]);
                 }
             }
+            istlA = pattern;
+        }
 
-            /*
-            // not neeeded since MatrixBlock initially zeros all elements during construction
-            // Set all blocks to zero.
-            for (auto row = istlA.begin(), rowend = istlA.end(); row != rowend; ++row ) {
-                for (auto col = row->begin(), colend = row->end(); col != colend; ++col ) {
-                    *col = 0.0;
-                }
-            }
-            */
+        /// Copy the jacobians of eqs into the blocks of istlA.
+        /// \return false if a non-zero derivative is outside the sparsity pattern
+        ///         of istlA, in which case the content of istlA is incomplete.
+        bool scatterInterleavedSystem(const std::vector<LinearisedBlackoilResidual::ADB>& eqs,
+                                      Mat& istlA) const
+        {
+            istlA = 0.0;
 
             /**
              * Go through all jacobians, and insert in correct spot
@@ -172,28 +194,31 @@ namespace Opm
              * from all "input matrices" (derivatives).
              *
              * A faster alternative is to instead run through each "input matrix" and
-             * insert its elements in the correct spot in the output matrix.
+             * insert its elements in the correct spot in the output matrix. Diagonal
+             * and identity derivatives are visited without converting them to
+             * sparse matrices.
              *
              */
-            for (int p1 = 0; p1 < np; ++p1) {
-                for (int p2 = 0; p2 < np; ++p2) {
-                    // Note that that since these are CSC and not CSR matrices,
-                    // ja contains row numbers instead of column numbers.
-                    const AutoDiffMatrix::SparseRep& s = eqs[p1].derivative()[p2].getSparse();
-                    const int* ia = s.outerIndexPtr();
-                    const int* ja = s.innerIndexPtr();
-                    const double* sa = s.valuePtr();
-                    for (int col = 0; col < size; ++col) {
-                        for (int elem_ix = ia[col]; elem_ix < ia[col + 1]; ++elem_ix) {
-                            const int row = ja[elem_ix];
-                            istlA[row][col][p1][p2] = sa[elem_ix];
-                        }
-                    }
+            bool fits = true;
+            for (int p1 = 0; p1 < np && fits; ++p1) {
+                for (int p2 = 0; p2 < np && fits; ++p2) {
+                    eqs[p1].derivative()[p2].visitNonZeros([&](const int row, const int col, const double value) {
+                            if (!fits || value == 0.0) {
+                                return;
+                            }
+                            auto& istlRow = istlA[row];
+                            const auto block = istlRow.find(col);
+                            if (block == istlRow.end()) {
+                                fits = false;
+                                return;
+                            }
+                            (*block)[p1][p2] = value;
+                        });
                 }
             }
+            return fits;
         }
 
-
         /// Solve the linear system Ax = b, with A being the
         /// combined derivative matrix of the residual and b
         /// being the residual itself.
@@ -224,9 +249,9 @@ namespace Opm
                 // Eliminate the well-related unknowns, and corresponding equations.
                 elim_eqs.reserve(2);
                 elim_eqs.push_back(eqs[np]);
-                eqs = eliminateVariable(eqs, np); // Eliminate well flux unknowns.
+                eqs = eliminateVariable(eqs, np, flux_elimination_); // Eliminate well flux unknowns.
                 elim_eqs.push_back(eqs[np]);
-                eqs = eliminateVariable(eqs, np); // Eliminate well bhp unknowns.
+                eqs = eliminateVariable(eqs, np, bhp_elimination_); // Eliminate well bhp unknowns.
                 assert(int(eqs.size()) == np);
             }
 
@@ -253,7 +278,7 @@ namespace Opm
             assert(pos == size_b);
 
             // Create ISTL matrix with interleaved rows and columns (block structured).
-            Mat istlA;
+            Mat& istlA = istlA_;
             formInterleavedSystem(eqs, istlA);
 
             // Solve reduced system.
@@ -285,8 +310,8 @@ namespace Opm
             if ( hasWells ) {
                 // Compute full solution using the eliminated equations.
                 // Recovery in inverse order of elimination.
-                dx = recoverVariable(elim_eqs[1], dx, np);
-                dx = recoverVariable(elim_eqs[0], dx, np);
+                dx = recoverVariable(elim_eqs[1], dx, np, bhp_elimination_);
+                dx = recoverVariable(elim_eqs[0], dx, np, flux_elimination_);
             }
             return dx;
         }
@@ -294,6 +319,11 @@ namespace Opm
     protected:
         ISTLSolverType istlSolver_;
         NewtonIterationBlackoilInterleavedParameters parameters_;
+        // kept between calls to reuse its sparsity pattern
+        mutable Mat istlA_;
+        // symbolic work of the well eliminations, kept between calls
+        mutable EliminationCache flux_elimination_;
+        mutable EliminationCache bhp_elimination_;
     }; // end NewtonIterationBlackoilInterleavedImpl
 
 
@@ -491,6 +521,15 @@ namespace Opm
         return parallelInformation_;
     }
 
+    bool NewtonIterationBlackoilInterleaved::supportsCpr()
+    {
+#if FLOW_SUPPORT_AMG
+        return true;
+#else
+        return false;
+#endif
+    }
+
 
 
 } // namespace Opm
@@ -27,14 +27,64 @@
 
 #include <opm/autodiff/CPRPreconditioner.hpp>
 #include <opm/autodiff/NewtonIterationBlackoilInterface.hpp>
+#include <opm/common/ErrorMacros.hpp>
 #include <opm/common/utility/parameters/ParameterGroup.hpp>
 #include <opm/autodiff/ParallelOverlappingILU0.hpp>
 
 #include <array>
 #include <memory>
+#include <stdexcept>
+#include <string>
 
 namespace Opm
 {
+    /// \brief Policies for keeping the preconditioner alive between linear solves.
+    enum class PreconditionerReuse {
+        /// \brief Rebuild the preconditioner for every linear solve.
+        NEVER = 0,
+        /// \brief Rebuild the preconditioner every n-th linear solve.
+        INTERVAL = 1,
+        /// \brief Rebuild the preconditioner at the first linear solve of a time step.
+        TIMESTEP = 2
+    };
+
+    inline PreconditionerReuse convertString2PreconditionerReuse(const std::string& reuse)
+    {
+        if ( 0 == reuse.compare("interval") )
+        {
+            return PreconditionerReuse::INTERVAL;
+        }
+        if ( 0 == reuse.compare("timestep") )
+        {
+            return PreconditionerReuse::TIMESTEP;
+        }
+        return PreconditionerReuse::NEVER;
+    }
+
+    /// \brief The solver of the subdomain of a process in the ILU preconditioned solves.
+    enum class SubdomainSolver
+    {
+        /// \brief ILU(n) with n = ilu_fillin_level.
+        ILU = 0,
+        /// \brief Sparse direct solve of the subdomain with UMFPack, the
+        ///        subdomains are combined by restricted additive Schwarz.
+        UMFPACK = 1
+    };
+
+    inline SubdomainSolver convertString2SubdomainSolver(const std::string& solver)
+    {
+        if ( 0 == solver.compare("umfpack") )
+        {
+#if HAVE_UMFPACK
+            return SubdomainSolver::UMFPACK;
+#else
+            OPM_THROW(std::invalid_argument, "linear_solver_subdomain_solver=umfpack needs UMFPack, "
+                      "reconfigure with SuiteSparse.");
+#endif // HAVE_UMFPACK
+        }
+        return SubdomainSolver::ILU;
+    }
+
     /// This class carries all parameters for the NewtonIterationBlackoilInterleaved class
     struct NewtonIterationBlackoilInterleavedParameters
         : public CPRParameter
@@ -48,11 +98,24 @@ namespace Opm
         Opm::MILU_VARIANT   ilu_milu_;
         bool   ilu_redblack_;
         bool   ilu_reorder_sphere_;
+        bool   ilu_level_scheduling_;
+        bool   ilu_reorder_rcm_;
+        bool   ilu_mixed_precision_;
         bool   newton_use_gmres_;
+        bool   newton_use_pipelined_bicgstab_;
+        bool   newton_use_recycling_gcr_;
+        int    linear_solver_recycle_dim_;
         bool   require_full_sparsity_pattern_;
         bool   ignoreConvergenceFailure_;
         bool   linear_solver_use_amg_;
         bool   use_cpr_;
+        PreconditionerReuse prec_reuse_;
+        int    prec_reuse_interval_;
+        double prec_reuse_iteration_growth_;
+        SubdomainSolver linear_solver_subdomain_solver_;
+        std::string linear_solver_telemetry_file_;
+        bool   linear_solver_autotune_;
+        int    linear_solver_autotune_rounds_;
 
         NewtonIterationBlackoilInterleavedParameters() { reset(); }
         // read values from parameter class
@@ -64,6 +127,9 @@ namespace Opm
 
             // read parameters (using previsouly set default values)
             newton_use_gmres_        = param.getDefault("newton_use_gmres", newton_use_gmres_ );
+            newton_use_pipelined_bicgstab_ = param.getDefault("newton_use_pipelined_bicgstab", newton_use_pipelined_bicgstab_ );
+            newton_use_recycling_gcr_ = param.getDefault("newton_use_recycling_gcr", newton_use_recycling_gcr_ );
+            linear_solver_recycle_dim_ = param.getDefault("linear_solver_recycle_dim", linear_solver_recycle_dim_ );
             linear_solver_reduction_ = param.getDefault("linear_solver_reduction", linear_solver_reduction_ );
             linear_solver_maxiter_   = param.getDefault("linear_solver_maxiter", linear_solver_maxiter_);
             linear_solver_restart_   = param.getDefault("linear_solver_restart", linear_solver_restart_);
@@ -75,8 +141,18 @@ namespace Opm
             ilu_fillin_level_         = param.getDefault("ilu_fillin_level",  ilu_fillin_level_ );
             ilu_redblack_             = param.getDefault("ilu_redblack", cpr_ilu_redblack_);
             ilu_reorder_sphere_       = param.getDefault("ilu_reorder_sphere", cpr_ilu_reorder_sphere_);
+            ilu_level_scheduling_     = param.getDefault("ilu_level_scheduling", ilu_level_scheduling_);
+            ilu_reorder_rcm_          = param.getDefault("ilu_reorder_rcm", ilu_reorder_rcm_);
+            ilu_mixed_precision_      = param.getDefault("ilu_mixed_precision", ilu_mixed_precision_);
             std::string milu("ILU");
             ilu_milu_ = convertString2Milu(param.getDefault("ilu_milu", milu));
+            prec_reuse_ = convertString2PreconditionerReuse(param.getDefault("linear_solver_prec_reuse", std::string("never")));
+            prec_reuse_interval_ = param.getDefault("linear_solver_prec_reuse_interval", prec_reuse_interval_);
+            prec_reuse_iteration_growth_ = param.getDefault("linear_solver_prec_reuse_iteration_growth", prec_reuse_iteration_growth_);
+            linear_solver_telemetry_file_ = param.getDefault("linear_solver_telemetry_file", linear_solver_telemetry_file_);
+            linear_solver_subdomain_solver_ = convertString2SubdomainSolver(param.getDefault("linear_solver_subdomain_solver", std::string("ilu")));
+            linear_solver_autotune_ = param.getDefault("linear_solver_autotune", linear_solver_autotune_);
+            linear_solver_autotune_rounds_ = param.getDefault("linear_solver_autotune_rounds", linear_solver_autotune_rounds_);
 
             // Check whether to use cpr approach
             const std::string cprSolver = "cpr";
@@ -88,6 +164,9 @@ namespace Opm
         {
             use_cpr_     = false;
             newton_use_gmres_        = false;
+            newton_use_pipelined_bicgstab_ = false;
+            newton_use_recycling_gcr_ = false;
+            linear_solver_recycle_dim_ = 8;
             linear_solver_reduction_ = 1e-2;
             linear_solver_maxiter_   = 150;
             linear_solver_restart_   = 40;
@@ -100,6 +179,16 @@ namespace Opm
             ilu_milu_                 = MILU_VARIANT::ILU;
             ilu_redblack_             = false;
             ilu_reorder_sphere_       = true;
+            ilu_level_scheduling_     = false;
+            ilu_reorder_rcm_          = false;
+            ilu_mixed_precision_      = false;
+            prec_reuse_               = PreconditionerReuse::NEVER;
+            prec_reuse_interval_      = 3;
+            prec_reuse_iteration_growth_ = 0.5;
+            linear_solver_subdomain_solver_ = SubdomainSolver::ILU;
+            linear_solver_telemetry_file_.clear();
+            linear_solver_autotune_ = false;
+            linear_solver_autotune_rounds_ = 2;
         }
     };
 
@@ -131,6 +220,10 @@ namespace Opm
         /// \copydoc NewtonIterationBlackoilInterface::parallelInformation
         virtual const boost::any& parallelInformation() const;
 
+        /// \brief Whether the BlackoilAmg preconditioner of solver_approach=cpr
+        ///        is built in, otherwise ILU is used instead.
+        static bool supportsCpr();
+
     private:
         // max number of equations supported, increase if necessary
         static const int maxNumberEquations_ = 6 ;
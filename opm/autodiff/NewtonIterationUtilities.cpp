@@ -130,6 +130,166 @@ namespace Opm
 
 
 
+    struct EliminationCache::Data
+    {
+        typedef Eigen::SparseMatrix<double> Sp;
+        // Eliminated block the solver is analyzed and factorized for.
+        Sp pattern;
+#if HAVE_UMFPACK
+        Eigen::UmfPackLU<Sp> solver;
+#else
+        Eigen::SparseLU<Sp> solver;
+#endif
+        // Per variable: inv(D)*C.
+        std::vector<Sp> u;
+        // Per equation and variable: B*inv(D)*C and the new jacobian.
+        std::vector<std::vector<Sp>> Bu;
+        std::vector<std::vector<Sp>> J;
+    };
+
+    EliminationCache::EliminationCache()
+    {
+    }
+
+    EliminationCache::~EliminationCache()
+    {
+    }
+
+
+
+    std::vector<ADB> eliminateVariable(const std::vector<ADB>& eqs, const int n, EliminationCache& cache)
+    {
+        // Check that the variable index to eliminate is within bounds.
+        const int num_eq = eqs.size();
+        const int num_vars = eqs[0].derivative().size();
+        if (num_eq != num_vars) {
+            OPM_THROW(std::logic_error, "eliminateVariable() requires the same number of variables and equations.");
+        }
+        if (n >= num_eq) {
+            OPM_THROW(std::logic_error, "Trying to eliminate variable from too small set of equations.");
+        }
+        if (!cache.data) {
+            cache.data.reset(new EliminationCache::Data());
+        }
+        EliminationCache::Data& data = *cache.data;
+        typedef EliminationCache::Data::Sp Sp;
+
+        // The same computations as in eliminateVariable() above, but the
+        // ordering of the eliminated block is only analyzed when its pattern
+        // changes, and the products are recomputed in the patterns of the
+        // previous call whenever they fit.
+        const std::vector<M>& Jn = eqs[n].derivative();
+        Sp Jnn;
+        Jn[n].toSparse(Jnn);
+        Jnn.makeCompressed();
+        if (!equalSparsityPattern(Jnn, data.pattern)) {
+            data.solver.analyzePattern(Jnn);
+        }
+        data.pattern = Jnn;
+        data.solver.factorize(Jnn);
+        Sp id(Jn[n].rows(), Jn[n].cols());
+        id.setIdentity();
+        const Sp Di = data.solver.solve(id);
+
+        ADB::V eqs_n_v = eqs[n].value();
+        const Eigen::VectorXd& Dibn = data.solver.solve(eqs_n_v.matrix());
+
+        std::vector<V> vals(num_eq);              // Number n will remain empty.
+        std::vector<std::vector<M>> jacs(num_eq); // Number n will remain empty.
+        for (int eq = 0; eq < num_eq; ++eq) {
+            jacs[eq].reserve(num_eq - 1);
+            const M& B = eqs[eq].derivative()[n];
+            vals[eq] = eqs[eq].value().matrix() - B * Dibn;
+        }
+
+        data.u.resize(num_eq);
+        data.Bu.resize(num_eq, std::vector<Sp>(num_eq));
+        data.J.resize(num_eq, std::vector<Sp>(num_eq));
+        for (int var = 0; var < num_eq; ++var) {
+            if (var == n) {
+                continue;
+            }
+            Sp& u = data.u[var];
+            const Sp& C = Jn[var].getSparse();
+            if (!fastSparseProductInPattern(Di, C, u)) {
+                fastSparseProduct(Di, C, u);
+            }
+            for (int eq = 0; eq < num_eq; ++eq) {
+                if (eq == n) {
+                    continue;
+                }
+                const std::vector<M>& Je = eqs[eq].derivative();
+                const Sp& B = Je[n].getSparse();
+                const Sp& A = Je[var].getSparse();
+                Sp& Bu = data.Bu[eq][var];
+                if (!fastSparseProductInPattern(B, u, Bu)) {
+                    fastSparseProduct(B, u, Bu);
+                }
+                // A - Bu (A - B*inv(D)*C)
+                Sp& J = data.J[eq][var];
+                if (!fastSparseAddInPattern(A, -1.0, Bu, J)) {
+                    J = A - Bu;
+                    J.makeCompressed();
+                }
+                jacs[eq].push_back(M(J));
+            }
+        }
+
+        // Create return value.
+        std::vector<ADB> retval;
+        retval.reserve(num_eq - 1);
+        for (int eq = 0; eq < num_eq; ++eq) {
+            if (eq == n) {
+                continue;
+            }
+            retval.push_back(ADB::function(std::move(vals[eq]), std::move(jacs[eq])));
+        }
+        return retval;
+    }
+
+
+
+
+
+    namespace
+    {
+        // Implementation of recoverVariable() for a given solver of the
+        // eliminated block.
+        template <class Solver>
+        V recoverVariableWithSolver(const ADB& equation, const V& partial_solution, const int n,
+                                    const Solver& solver)
+        {
+            // Build C.
+            std::vector<M> C_jacs = equation.derivative();
+            C_jacs.erase(C_jacs.begin() + n);
+            V equation_value = equation.value();
+            ADB eq_coll = collapseJacs(ADB::function(std::move(equation_value), std::move(C_jacs)));
+            const M& C = eq_coll.derivative()[0];
+
+            // Compute value of eliminated variable.
+            const Eigen::VectorXd b = (equation.value().matrix() - C * partial_solution.matrix());
+            const Eigen::VectorXd elim_var = solver.solve(b);
+
+            // Find the relevant sizes to use when reconstructing the full solution.
+            const int nelim = equation.size();
+            const int npart = partial_solution.size();
+            assert(C.cols() == npart);
+            const int full_size = nelim + npart;
+            int start = 0;
+            for (int i = 0; i < n; ++i) {
+                start += equation.derivative()[i].cols();
+            }
+            assert(start < full_size);
+
+            // Reconstruct complete solution vector.
+            V sol(full_size);
+            std::copy_n(partial_solution.data(), start, sol.data());
+            std::copy_n(elim_var.data(), nelim, sol.data() + start);
+            std::copy_n(partial_solution.data() + start, npart - start, sol.data() + start + nelim);
+            return sol;
+        }
+    } // anonymous namespace
+
 
 
     V recoverVariable(const ADB& equation, const V& partial_solution, const int n)
@@ -144,12 +304,6 @@ namespace Opm
         // of the non-eliminated unknowns.
 
         const M& D1 = equation.derivative()[n];
-        // Build C.
-        std::vector<M> C_jacs = equation.derivative();
-        C_jacs.erase(C_jacs.begin() + n);
-        V equation_value = equation.value();
-        ADB eq_coll = collapseJacs(ADB::function(std::move(equation_value), std::move(C_jacs)));
-        const M& C = eq_coll.derivative()[0];
 
         // Use sparse LU to solve the block submatrices
         typedef Eigen::SparseMatrix<double> Sp;
@@ -160,28 +314,20 @@ namespace Opm
 #else
         const Eigen::SparseLU<Sp> solver(D);
 #endif
+        return recoverVariableWithSolver(equation, partial_solution, n, solver);
+    }
+
 
-        // Compute value of eliminated variable.
-        const Eigen::VectorXd b = (equation.value().matrix() - C * partial_solution.matrix());
-        const Eigen::VectorXd elim_var = solver.solve(b);
-
-        // Find the relevant sizes to use when reconstructing the full solution.
-        const int nelim = equation.size();
-        const int npart = partial_solution.size();
-        assert(C.cols() == npart);
-        const int full_size = nelim + npart;
-        int start = 0;
-        for (int i = 0; i < n; ++i) {
-            start += equation.derivative()[i].cols();
+
+    V recoverVariable(const ADB& equation, const V& partial_solution, const int n,
+                      const EliminationCache& cache)
+    {
+        // The eliminated block is the one factorized by the elimination, as
+        // long as the cache has been used to eliminate this equation.
+        if (!cache.data || cache.data->pattern.rows() != equation.derivative()[n].rows()) {
+            return recoverVariable(equation, partial_solution, n);
         }
-        assert(start < full_size);
-
-        // Reconstruct complete solution vector.
-        V sol(full_size);
-        std::copy_n(partial_solution.data(), start, sol.data());
-        std::copy_n(elim_var.data(), nelim, sol.data() + start);
-        std::copy_n(partial_solution.data() + start, npart - start, sol.data() + start + nelim);
-        return sol;
+        return recoverVariableWithSolver(equation, partial_solution, n, cache.data->solver);
     }
 
 
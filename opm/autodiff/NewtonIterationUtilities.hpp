@@ -22,6 +22,7 @@
 
 #include <opm/autodiff/AutoDiffBlock.hpp>
 #include <boost/any.hpp>
+#include <memory>
 #include <vector>
 
 namespace Opm
@@ -37,6 +38,29 @@ namespace Opm
     eliminateVariable(const std::vector< AutoDiffBlock<double> >& eqs,
                       const int n);
 
+    /// The symbolic work of eliminateVariable(), kept between calls: the
+    /// analyzed sparsity pattern of the eliminated block and the sparsity
+    /// patterns of the Schur complement products. Calls with the same
+    /// patterns, e.g. later Newton iterations, only do numeric work.
+    class EliminationCache
+    {
+    public:
+        EliminationCache();
+        ~EliminationCache();
+        struct Data;
+        std::unique_ptr<Data> data;
+    };
+
+    /// Eliminate a variable via Schur complement, reusing and updating cache.
+    /// \param[in]     eqs    set of equations with Jacobians
+    /// \param[in]     n      index of equation/variable to eliminate.
+    /// \param[in,out] cache  symbolic work of previous eliminations.
+    /// \return               new set of equations, one smaller than eqs.
+    std::vector< AutoDiffBlock<double> >
+    eliminateVariable(const std::vector< AutoDiffBlock<double> >& eqs,
+                      const int n,
+                      EliminationCache& cache);
+
     /// Recover that value of a variable previously eliminated.
     /// \param[in]  equation          previously eliminated equation.
     /// \param[in]  partial_solution  solution to the remainder system after elimination.
@@ -46,6 +70,14 @@ namespace Opm
                                              const AutoDiffBlock<double>::V& partial_solution,
                                              const int n);
 
+    /// Recover that value of a variable previously eliminated, using the
+    /// factorization of the eliminated block stored in cache by the
+    /// elimination of equation.
+    AutoDiffBlock<double>::V recoverVariable(const AutoDiffBlock<double>& equation,
+                                             const AutoDiffBlock<double>::V& partial_solution,
+                                             const int n,
+                                             const EliminationCache& cache);
+
     /// Form an elliptic system of equations.
     /// \param[in]       num_phases  the number of fluid phases
     /// \param[in]       eqs         the equations
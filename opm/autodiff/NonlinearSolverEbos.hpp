@@ -267,34 +267,38 @@ namespace Opm {
         /// Implemention for Dune block vectors.
         template <class BVector>
         void stabilizeNonlinearUpdate(BVector& dx, BVector& dxOld, const double omega) const
+        {
+            for (std::size_t i = 0; i < dx.size(); ++i) {
+                stabilizeNonlinearUpdateBlock(dx[i], dxOld[i], omega);
+            }
+        }
+
+        /// Apply the stabilization of stabilizeNonlinearUpdate() to the update of
+        /// one cell, such that it can be fused with the application of the update.
+        template <class Block>
+        void stabilizeNonlinearUpdateBlock(Block& dx, Block& dxOld, const double omega) const
         {
             // The dxOld is updated with dx.
             // If omega is equal to 1., no relaxtion will be appiled.
 
-            BVector tempDxOld = dxOld;
-            dxOld = dx;
-
             switch (relaxType()) {
             case Dampen: {
+                dxOld = dx;
                 if (omega == 1.) {
                     return;
                 }
-                auto i = dx.size();
-                for (i = 0; i < dx.size(); ++i) {
-                    dx[i] *= omega;
-                }
+                dx *= omega;
                 return;
             }
             case SOR: {
                 if (omega == 1.) {
+                    dxOld = dx;
                     return;
                 }
-                auto i = dx.size();
-                for (i = 0; i < dx.size(); ++i) {
-                    dx[i] *= omega;
-                    tempDxOld[i] *= (1.-omega);
-                    dx[i] += tempDxOld[i];
-                }
+                const Block tempDxOld = dxOld;
+                dxOld = dx;
+                dx *= omega;
+                dx.axpy(1.-omega, tempDxOld);
                 return;
             }
             default:
@@ -19,8 +19,15 @@
 #ifndef OPM_PARALLELDEBUGOUTPUT_HEADER_INCLUDED
 #define OPM_PARALLELDEBUGOUTPUT_HEADER_INCLUDED
 
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <fstream>
+#include <numeric>
+#include <sstream>
 #include <unordered_set>
 
+#include <opm/common/ErrorMacros.hpp>
 #include <opm/common/data/SimulationDataContainer.hpp>
 #include <opm/output/eclipse/RestartValue.hpp>
 
@@ -38,6 +45,10 @@
 #include <opm/grid/common/p2pcommunicator.hh>
 #endif
 
+#if HAVE_MPI
+#include <mpi.h>
+#endif
+
 namespace Opm
 {
 
@@ -68,6 +79,74 @@ namespace Opm
         virtual bool isParallel() const = 0;
         virtual int numCells() const = 0 ;
         virtual const int* globalCell() const = 0;
+
+        //! \brief write the cell data to a single file without gathering it
+        //!        on the I/O rank.
+        //!
+        //! The file starts with a header of the number of fields, the number
+        //! of cells of the cartesian grid and the field names padded to eight
+        //! characters. Each field follows as an array of doubles indexed by
+        //! the cartesian cell index, the values of inactive cells are zero.
+        //! In parallel every process writes the values of its interior cells
+        //! to their offsets in the file.
+        //! \param localCellData The cell data of this process
+        //! \param filename      The name of the file (the same on all processes)
+        virtual void writeCellDataCollective( const data::Solution& localCellData,
+                                              const std::string& filename ) const = 0;
+
+    protected:
+        typedef std::array< char, 8 > FieldName;
+
+        static std::vector< FieldName > fieldNames( const data::Solution& cellData )
+        {
+            std::vector< FieldName > names;
+            for (const auto& pair : cellData) {
+                FieldName name;
+                name.fill( ' ' );
+                std::copy_n( pair.first.begin(), std::min( pair.first.size(), name.size() ), name.begin() );
+                names.push_back( name );
+            }
+            return names;
+        }
+
+        static std::size_t headerSize( const std::size_t numFields )
+        {
+            return 2 * sizeof( int ) + numFields * sizeof( FieldName );
+        }
+
+        static void writeHeader( std::ostream& out, const data::Solution& cellData, const int cartesianSize )
+        {
+            const int numFields = cellData.size();
+            out.write( reinterpret_cast< const char* >( &numFields ), sizeof( int ) );
+            out.write( reinterpret_cast< const char* >( &cartesianSize ), sizeof( int ) );
+            for (const auto& name : fieldNames( cellData )) {
+                out.write( name.data(), name.size() );
+            }
+        }
+
+        // write the whole cell data from one process
+        static void writeCellDataSerial( const data::Solution& cellData,
+                                         const std::string& filename,
+                                         const int numCells,
+                                         const int* globalCell,
+                                         const int cartesianSize )
+        {
+            std::ofstream out( filename, std::ios::binary );
+            if( ! out ) {
+                OPM_THROW(std::runtime_error, "Failed to open " << filename);
+            }
+            writeHeader( out, cellData, cartesianSize );
+            // the inactive cells are zero in all fields, hence only the active
+            // cells are overwritten for each field
+            std::vector< double > field( cartesianSize, 0.0 );
+            for (const auto& pair : cellData) {
+                const auto& data = pair.second.data;
+                for( int cell = 0; cell < numCells; ++cell ) {
+                    field[ globalCell ? globalCell[ cell ] : cell ] = data[ cell ];
+                }
+                out.write( reinterpret_cast< const char* >( field.data() ), field.size() * sizeof( double ) );
+            }
+        }
     };
 
     template <class GridImpl>
@@ -110,6 +189,15 @@ namespace Opm
         virtual bool isParallel () const { return false; }
         virtual int numCells() const { return Opm::AutoDiffGrid::numCells(grid_); }
         virtual const int* globalCell() const { return Opm::AutoDiffGrid::globalCell(grid_); }
+
+        virtual void writeCellDataCollective( const data::Solution& localCellData,
+                                              const std::string& filename ) const
+        {
+            const auto& cartDims = Opm::UgGridHelpers::cartDims( grid_ );
+            const int cartesianSize = std::accumulate( cartDims, cartDims + Opm::UgGridHelpers::dimensions( grid_ ),
+                                                       1, std::multiplies< int >() );
+            writeCellDataSerial( localCellData, filename, numCells(), globalCell(), cartesianSize );
+        }
     };
 
 #if HAVE_OPM_GRID
@@ -259,18 +347,23 @@ namespace Opm
               schedule_(schedule),
               globalCellData_(new data::Solution),
               isIORank_(true),
-              phaseUsage_(phaseUsage)
+              phaseUsage_(phaseUsage),
+              comm_(otherGrid.comm())
 
         {
             // Switch to distributed view unconditionally for safety.
             Dune::CpGrid distributed_grid = otherGrid;
 
+            const auto& cartDims = distributed_grid.logicalCartesianSize();
+            cartesianSize_ = cartDims[ 0 ] * cartDims[ 1 ] * cartDims[ 2 ];
+
             const CollectiveCommunication& comm = otherGrid.comm();
             if( comm.size() > 1 )
             {
                 std::set< int > send, recv;
                 distributed_grid.switchToDistributedView();
                 toIORankComm_ = distributed_grid.comm();
+                comm_ = distributed_grid.comm();
                 isIORank_ = (distributed_grid.comm().rank() == ioRank);
 
                 // the I/O rank receives from all other ranks
@@ -340,6 +433,13 @@ namespace Opm
                 // distribute global id's to io rank for later association of dof's
                 DistributeIndexMapping distIndexMapping( globalIndex_, distributed_grid.globalCell(), localIndexMap_, indexMaps_ );
                 toIORankComm_.exchange( distIndexMapping );
+
+                // cartesian index of the interior cells for the collective output
+                localCartesianIndex_.reserve( localIndexMap_.size() );
+                for( const int index : localIndexMap_ )
+                {
+                    localCartesianIndex_.push_back( distributed_grid.globalCell()[ index ] );
+                }
             }
             else // serial run
             {
@@ -379,6 +479,9 @@ namespace Opm
                     // add missing data to global cell data
                     for (const auto& pair : localCellData_) {
                         const std::string& key = pair.first;
+                        if( globalCellData_.has( key ) ) {
+                            continue;
+                        }
                         std::size_t container_size = numGlobalCells;
                         auto ret = globalCellData_.insert(key, pair.second.dim,
                                                 std::vector<double>(container_size),
@@ -602,7 +705,19 @@ namespace Opm
                               const data::Solution& localCellData,
                               const int wellStateStepNumber )
         {
-            if( isIORank() )
+            // The communication pattern only depends on the cell data fields
+            // and the wells, hence the message sizes of the last gather can
+            // be reused as long as both are unchanged.
+            std::vector< std::string > fieldNames;
+            for (const auto& pair : localCellData) {
+                fieldNames.push_back( pair.first );
+            }
+            const bool sameWells = ( wellStateStepNumber == lastWellStateStepNumber_ );
+            const bool sameLayout = sameWells && ( fieldNames == lastFieldNames_ );
+            lastWellStateStepNumber_ = wellStateStepNumber;
+            lastFieldNames_ = std::move( fieldNames );
+
+            if( isIORank() && ! sameWells )
             {
                 Dune::CpGrid& globalGrid = *grid_;
                 // TODO: make a dummy DynamicListEconLimited here for NOW for compilation and development
@@ -629,6 +744,12 @@ namespace Opm
 
                 const Wells* wells = wells_manager.c_wells();
                 globalWellState_.initLegacy(wells, *globalReservoirState_, globalWellState_, phaseUsage_ );
+            }
+
+            // all values are overwritten by the gather, keep the global
+            // arrays if the fields did not change
+            if( isIORank() && ! sameLayout )
+            {
                 globalCellData_->clear();
             }
 
@@ -638,8 +759,14 @@ namespace Opm
                                                           localIndexMap_, indexMaps_,
                                                           isIORank() );
 
-            //toIORankComm_.exchangeCached( packUnpack );
-            toIORankComm_.exchange( packUnpack );
+            if( sameLayout )
+            {
+                toIORankComm_.exchangeCached( packUnpack );
+            }
+            else
+            {
+                toIORankComm_.exchange( packUnpack );
+            }
 #ifndef NDEBUG
             // make sure every process is on the same page
             toIORankComm_.barrier();
@@ -679,6 +806,75 @@ namespace Opm
             return globalIndex_.data();
         }
 
+        void writeCellDataCollective( const data::Solution& localCellData,
+                                      const std::string& filename ) const
+        {
+            if( ! isParallel() )
+            {
+                writeCellDataSerial( localCellData, filename, numCells(), globalCell(), cartesianSize_ );
+                return;
+            }
+
+#if HAVE_MPI
+            // MPI-IO needs increasing displacements, hence sort the interior
+            // cells by their cartesian index
+            const int size = localCartesianIndex_.size();
+            std::vector< int > order( size );
+            std::iota( order.begin(), order.end(), 0 );
+            std::sort( order.begin(), order.end(),
+                       [ this ]( const int a, const int b ) { return localCartesianIndex_[ a ] < localCartesianIndex_[ b ]; } );
+            std::vector< int > displacements( size );
+            for( int i = 0; i < size; ++i )
+            {
+                displacements[ i ] = localCartesianIndex_[ order[ i ] ];
+            }
+
+            MPI_Datatype cells;
+            MPI_Type_create_indexed_block( size, 1, displacements.data(), MPI_DOUBLE, &cells );
+            MPI_Type_commit( &cells );
+
+            MPI_File file;
+            int err = MPI_File_open( comm_, const_cast< char* >( filename.c_str() ),
+                                     MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file );
+            if( err != MPI_SUCCESS )
+            {
+                MPI_Type_free( &cells );
+                OPM_THROW(std::runtime_error, "Failed to open " << filename);
+            }
+            MPI_File_set_size( file, 0 );
+
+            // the header is only written by the I/O rank
+            if( isIORank() )
+            {
+                std::ostringstream header;
+                writeHeader( header, localCellData, cartesianSize_ );
+                const std::string buffer = header.str();
+                MPI_File_write_at( file, 0, const_cast< char* >( buffer.data() ), buffer.size(),
+                                   MPI_CHAR, MPI_STATUS_IGNORE );
+            }
+
+            // the order of the fields is the order of the keys which is the
+            // same on all processes
+            MPI_Offset offset = headerSize( localCellData.size() );
+            std::vector< double > values( size );
+            for (const auto& pair : localCellData) {
+                const auto& data = pair.second.data;
+                for( int i = 0; i < size; ++i )
+                {
+                    values[ i ] = data[ localIndexMap_[ order[ i ] ] ];
+                }
+                MPI_File_set_view( file, offset, MPI_DOUBLE, cells, const_cast< char* >( "native" ), MPI_INFO_NULL );
+                MPI_File_write_all( file, values.data(), size, MPI_DOUBLE, MPI_STATUS_IGNORE );
+                offset += MPI_Offset( cartesianSize_ ) * sizeof( double );
+            }
+
+            MPI_File_close( &file );
+            MPI_Type_free( &cells );
+#else
+            OPM_THROW(std::logic_error, "Collective output in parallel requires MPI");
+#endif
+        }
+
     protected:
         std::unique_ptr< Dune::CpGrid >           grid_;
         const EclipseState&                       eclipseState_;
@@ -695,6 +891,14 @@ namespace Opm
         bool                                      isIORank_;
         // Phase usage needed to convert solution to simulation data container
         Opm::PhaseUsage phaseUsage_;
+        // communicator of the distributed grid for the collective output
+        CollectiveCommunication                   comm_;
+        // cartesian index of the interior cells of this process
+        IndexMapType                              localCartesianIndex_;
+        int                                       cartesianSize_;
+        // layout of the last gather, used to reuse its message sizes
+        int                                       lastWellStateStepNumber_ = -1;
+        std::vector< std::string >                lastFieldNames_;
     };
 #endif // #if HAVE_OPM_GRID
 
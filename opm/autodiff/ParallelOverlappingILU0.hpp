@@ -21,9 +21,14 @@
 #define OPM_PARALLELOVERLAPPINGILU0_HEADER_INCLUDED
 
 #include <opm/autodiff/GraphColoring.hpp>
+#include <opm/autodiff/MatrixBlockKernels.hpp>
+#include <opm/autodiff/SparsityPattern.hpp>
 #include <opm/common/Exceptions.hpp>
 #include <opm/common/ErrorMacros.hpp>
+#include <opm/simulators/ProfileScope.hpp>
+#include <opm/simulators/MemoryAccounting.hpp>
 #include <dune/common/version.hh>
+#include <dune/common/fmatrix.hh>
 #include <dune/istl/preconditioner.hh>
 #include <dune/istl/paamg/smoother.hh>
 #include <dune/istl/paamg/graph.hh>
@@ -32,15 +37,20 @@
 #include <type_traits>
 #include <numeric>
 #include <limits>
+#include <algorithm>
 #include <cstddef>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace Opm
 {
 
 //template<class M, class X, class Y, class C>
 //class ParallelOverlappingILU0;
-template<class Matrix, class Domain, class Range, class ParallelInfo = Dune::Amg::SequentialInformation>
+template<class Matrix, class Domain, class Range, class ParallelInfo = Dune::Amg::SequentialInformation,
+         class StorageField = typename Matrix::field_type>
 class ParallelOverlappingILU0;
 
 enum class MILU_VARIANT{
@@ -110,8 +120,8 @@ namespace Amg
 {
 
 
-template<class M, class X, class Y, class C>
-struct SmootherTraits<Opm::ParallelOverlappingILU0<M,X,Y,C> >
+template<class M, class X, class Y, class C, class F>
+struct SmootherTraits<Opm::ParallelOverlappingILU0<M,X,Y,C,F> >
 {
     using Arguments = Opm::ParallelOverlappingILU0Args<typename M::field_type>;
 };
@@ -122,12 +132,13 @@ struct SmootherTraits<Opm::ParallelOverlappingILU0<M,X,Y,C> >
 /// \tparam Range The type of the Vector representing the range.
 /// \tparam ParallelInfo The type of the parallel information object
 ///         used, e.g. Dune::OwnerOverlapCommunication
-template<class Matrix, class Domain, class Range, class ParallelInfo>
-struct ConstructionTraits<Opm::ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfo> >
+/// \tparam StorageField The field type used to store the decomposition.
+template<class Matrix, class Domain, class Range, class ParallelInfo, class StorageField>
+struct ConstructionTraits<Opm::ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfo,StorageField> >
 {
-    typedef Opm::ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfo> T;
+    typedef Opm::ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfo,StorageField> T;
     typedef DefaultParallelConstructionArgs<T,ParallelInfo> Arguments;
-    static inline Opm::ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfo>* construct(Arguments& args)
+    static inline T* construct(Arguments& args)
     {
         return new T(args.getMatrix(),
                      args.getComm(),
@@ -328,9 +339,13 @@ namespace Opm
                             diagonal);
     }
 
+    /// \brief Symbolic phase of ILU(n): create the sparsity pattern with fill-in.
+    ///
+    /// The pattern only depends on the sparsity pattern of A and can thus be
+    /// reused for matrices with the same pattern, see milun_numeric.
     template<class M>
-    void milun_decomposition(const M& A, int n, MILU_VARIANT milu, M& ILU,
-                             Reorderer& ordering, Reorderer& inverseOrdering)
+    void milun_sparsity_pattern(const M& A, int n, M& ILU,
+                                Reorderer& ordering, Reorderer& inverseOrdering)
     {
         using Map = std::map<std::size_t, int>;
 
@@ -385,23 +400,12 @@ namespace Opm
                 (*col)[0][0] = generationPair->second;
             }
         }
+    }
 
-        // copy Entries from A
-        for(auto iter=A.begin(), iend = A.end(); iter != iend; ++iter)
-        {
-            auto& newRow = ILU[ordering[iter.index()]];
-            // reset stored generation
-            for ( auto& col: newRow)
-            {
-                col = 0;
-            }
-            // copy row.
-            for(auto col = iter->begin(), cend = iter->end(); col != cend; ++col)
-            {
-                newRow[ordering[col.index()]] = *col;
-            }
-        }
-        // call decomposition on pattern        
+    /// \brief Factorize a matrix in place with ILU(0) or one of the MILU variants.
+    template<class M>
+    void milu0_numeric(M& ILU, MILU_VARIANT milu)
+    {
         switch ( milu )
         {
         case MILU_VARIANT::MILU_1:
@@ -425,6 +429,86 @@ namespace Opm
         }
     }
 
+    /// \brief Create the sparsity pattern of A with rows and columns permuted.
+    ///
+    /// ILU has to be created row wise with A.nonzeroes() entries. The values
+    /// are filled in by milun_numeric.
+    template<class M>
+    void reordered_sparsity_pattern(const M& A, M& ILU,
+                                    const std::vector<std::size_t>& ordering,
+                                    const std::vector<std::size_t>& inverseOrdering)
+    {
+        for(auto iter=ILU.createbegin(), iend = ILU.createend(); iter != iend; ++iter)
+        {
+            const auto& row = A[inverseOrdering[iter.index()]];
+            for(auto col = row.begin(), cend = row.end(); col != cend; ++col)
+            {
+                iter.insert(ordering[col.index()]);
+            }
+        }
+    }
+
+    /// \brief Numeric phase of ILU(n): copy the values of A into the
+    ///        pattern created by milun_sparsity_pattern and factorize.
+    template<class M>
+    void milun_numeric(const M& A, MILU_VARIANT milu, M& ILU, Reorderer& ordering)
+    {
+        // copy Entries from A
+        for(auto iter=A.begin(), iend = A.end(); iter != iend; ++iter)
+        {
+            auto& newRow = ILU[ordering[iter.index()]];
+            // reset stored generation
+            for ( auto& col: newRow)
+            {
+                col = 0;
+            }
+            // copy row.
+            for(auto col = iter->begin(), cend = iter->end(); col != cend; ++col)
+            {
+                newRow[ordering[col.index()]] = *col;
+            }
+        }
+        milu0_numeric( ILU, milu );
+    }
+
+    template<class M>
+    void milun_decomposition(const M& A, int n, MILU_VARIANT milu, M& ILU,
+                             Reorderer& ordering, Reorderer& inverseOrdering)
+    {
+        milun_sparsity_pattern(A, n, ILU, ordering, inverseOrdering);
+        milun_numeric(A, milu, ILU, ordering);
+    }
+
+      //! \brief Copy a matrix block, possibly converting the field type.
+      template<class B>
+      void assignBlock(B& dest, const B& source)
+      {
+          dest = source;
+      }
+
+      template<class DestBlock, class SourceBlock>
+      void assignBlock(DestBlock& dest, const SourceBlock& source)
+      {
+          for ( std::size_t i = 0; i < SourceBlock::rows; ++i )
+          {
+              for ( std::size_t j = 0; j < SourceBlock::cols; ++j )
+              {
+                  dest[ i ][ j ] = source[ i ][ j ];
+              }
+          }
+      }
+
+      //! \brief Selects the block type used to store the decomposition.
+      //!
+      //! If the field type is unchanged the block type of the matrix is used.
+      template<class Block, class StorageField>
+      struct StorageBlockType
+      {
+          typedef typename std::conditional< std::is_same< typename Block::field_type, StorageField >::value,
+                                             Block,
+                                             Dune::FieldMatrix< StorageField, Block::rows, Block::cols > >::type type;
+      };
+
       //! compute ILU decomposition of A. A is overwritten by its decomposition
       template<class M, class CRS, class InvVector>
       void convertToCRS(const M& A, CRS& lower, CRS& upper, InvVector& inv )
@@ -442,6 +526,12 @@ namespace Opm
         upper.resize( A.N() );
         inv.resize( A.N() );
 
+        // the CRS storage might be filled by a previous decomposition
+        lower.values_.clear();
+        lower.cols_.clear();
+        upper.values_.clear();
+        upper.cols_.clear();
+
         lower.reserveAdditional( 2*A.N() );
 
         // implement left looking variant with stored inverse
@@ -484,7 +574,7 @@ namespace Opm
             const size_type jIndex = j.index();
             if( j.index() == iIndex )
             {
-              inv[ row ] = (*j);
+              assignBlock( inv[ row ], *j );
 	      break;
             }
             else if ( j.index() >= i.index() )
@@ -496,6 +586,79 @@ namespace Opm
           upper.rows_[ row+1 ] = colcount;
         }
       }
+
+      /// \brief Compute the level sets of a triangular solve stored in CRS format.
+      ///
+      /// A row of level l only depends on rows of levels smaller than l. Hence
+      /// all rows of one level can be processed concurrently.
+      /// \param crs       The lower or upper triangular part in CRS format.
+      /// \param rowToIndex Maps the CRS row number to the index of the unknown
+      ///                  that it computes.
+      /// \param levelStart On exit levelStart[l] is the offset of level l in levelRows.
+      /// \param levelRows  On exit the CRS row numbers sorted by level.
+      template<class CRS, class RowToIndex>
+      void computeLevelSets(const CRS& crs, RowToIndex rowToIndex,
+                            std::vector<std::size_t>& levelStart,
+                            std::vector<std::size_t>& levelRows)
+      {
+          const std::size_t nRows = crs.rows();
+          std::vector<std::size_t> level(nRows, 0);
+          std::size_t noLevels = 0;
+
+          // The rows are stored in the order of the sweep. All dependencies
+          // of a row have therefore been visited before.
+          for ( std::size_t row = 0; row < nRows; ++row )
+          {
+              std::size_t rowLevel = 0;
+              for ( std::size_t col = crs.rows_[ row ]; col < crs.rows_[ row+1 ]; ++col )
+              {
+                  rowLevel = std::max( rowLevel, level[ crs.cols_[ col ] ] + 1 );
+              }
+              level[ rowToIndex( row ) ] = rowLevel;
+              noLevels = std::max( noLevels, rowLevel + 1 );
+          }
+
+          // bucket sort the rows by level
+          levelStart.assign( noLevels + 1, 0 );
+          for ( std::size_t row = 0; row < nRows; ++row )
+          {
+              ++levelStart[ level[ rowToIndex( row ) ] + 1 ];
+          }
+          std::partial_sum( levelStart.begin(), levelStart.end(), levelStart.begin() );
+
+          std::vector<std::size_t> fill( levelStart.begin(), levelStart.end() - 1 );
+          levelRows.resize( nRows );
+          for ( std::size_t row = 0; row < nRows; ++row )
+          {
+              levelRows[ fill[ level[ rowToIndex( row ) ] ]++ ] = row;
+          }
+      }
+
+      /// \brief Use the colors of a red-black ordering as level sets.
+      ///
+      /// The ordering numbers the vertices of each color consecutively and no
+      /// two vertices of one color are coupled. For ILU(0) the rows of a color
+      /// can thus be processed concurrently in both triangular solves, without
+      /// computing the levels from the factors.
+      /// \param verticesPerColor The number of vertices of each color.
+      inline void colorLevelSets(const std::vector<std::size_t>& verticesPerColor,
+                                 std::vector<std::size_t>& lowerLevelStart,
+                                 std::vector<std::size_t>& lowerLevelRows,
+                                 std::vector<std::size_t>& upperLevelStart,
+                                 std::vector<std::size_t>& upperLevelRows)
+      {
+          const std::size_t noColors = verticesPerColor.size();
+          lowerLevelStart.assign( noColors + 1, 0 );
+          upperLevelStart.assign( noColors + 1, 0 );
+          // the upper solve visits the colors backwards (rows reversed in CRS)
+          std::partial_sum( verticesPerColor.begin(), verticesPerColor.end(),
+                            lowerLevelStart.begin() + 1 );
+          std::partial_sum( verticesPerColor.rbegin(), verticesPerColor.rend(),
+                            upperLevelStart.begin() + 1 );
+          lowerLevelRows.resize( lowerLevelStart.back() );
+          std::iota( lowerLevelRows.begin(), lowerLevelRows.end(), 0 );
+          upperLevelRows = lowerLevelRows;
+      }
     } // end namespace detail
 
 
@@ -514,7 +677,10 @@ namespace Opm
 /// \tparam Range The type of the Vector representing the range.
 /// \tparam ParallelInfo The type of the parallel information object
 ///         used, e.g. Dune::OwnerOverlapCommunication
-template<class Matrix, class Domain, class Range, class ParallelInfoT>
+/// \tparam StorageField The field type used to store the factors L, U and the
+///         inverted diagonal. Using float halves the memory traffic of apply
+///         while the Krylov solver still operates in double precision.
+template<class Matrix, class Domain, class Range, class ParallelInfoT, class StorageField>
 class ParallelOverlappingILU0
     : public Dune::Preconditioner<Domain,Range>
 {
@@ -533,6 +699,8 @@ public:
 
     typedef typename matrix_type::block_type  block_type;
     typedef typename matrix_type::size_type   size_type;
+    //! \brief The block type used for storing the decomposition.
+    typedef typename detail::StorageBlockType< block_type, StorageField >::type storage_block_type;
 
 protected:
     struct CRS
@@ -569,12 +737,13 @@ protected:
 
       void push_back( const block_type& value, const size_type index )
       {
-          values_.push_back( value );
+          values_.emplace_back();
+          detail::assignBlock( values_.back(), value );
           cols_.push_back( index );
       }
 
       std::vector< size_type  > rows_;
-      std::vector< block_type > values_;
+      std::vector< storage_block_type > values_;
       std::vector< size_type  > cols_;
       size_type nRows_;
     };
@@ -608,12 +777,20 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param level_scheduling If true, the rows of the triangular solves are grouped
+                              into independent levels that are processed by multiple
+                              threads (needs OpenMP). For ILU(0) with a red-black
+                              ordering the levels are the colors.
+      \param reorder_rcm If true and no red-black ordering is used, the rows are
+                         renumbered with the reverse Cuthill-McKee algorithm.
     */
     template<class BlockType, class Alloc>
     ParallelOverlappingILU0 (const Dune::BCRSMatrix<BlockType,Alloc>& A,
                              const int n, const field_type w,
                              MILU_VARIANT milu, bool redblack=false,
-                             bool reorder_sphere=true)
+                             bool reorder_sphere=true,
+                             bool level_scheduling=false,
+                             bool reorder_rcm=false)
         : lower_(),
           upper_(),
           inv_(),
@@ -623,7 +800,7 @@ public:
         // BlockMatrix is a Subclass of FieldMatrix that just adds
         // methods. Therefore this cast should be safe.
         init( reinterpret_cast<const Matrix&>(A), n, milu, redblack,
-              reorder_sphere  );
+              reorder_sphere, level_scheduling, reorder_rcm );
     }
 
     /*! \brief Constructor gets all parameters to operate the prec.
@@ -637,12 +814,20 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param level_scheduling If true, the rows of the triangular solves are grouped
+                              into independent levels that are processed by multiple
+                              threads (needs OpenMP). For ILU(0) with a red-black
+                              ordering the levels are the colors.
+      \param reorder_rcm If true and no red-black ordering is used, the rows are
+                         renumbered with the reverse Cuthill-McKee algorithm.
     */
     template<class BlockType, class Alloc>
     ParallelOverlappingILU0 (const Dune::BCRSMatrix<BlockType,Alloc>& A,
                              const ParallelInfo& comm, const int n, const field_type w,
                              MILU_VARIANT milu, bool redblack=false,
-                             bool reorder_sphere=true)
+                             bool reorder_sphere=true,
+                             bool level_scheduling=false,
+                             bool reorder_rcm=false)
         : lower_(),
           upper_(),
           inv_(),
@@ -652,7 +837,7 @@ public:
         // BlockMatrix is a Subclass of FieldMatrix that just adds
         // methods. Therefore this cast should be safe.
         init( reinterpret_cast<const Matrix&>(A), n, milu, redblack,
-              reorder_sphere );
+              reorder_sphere, level_scheduling, reorder_rcm );
     }
 
     /*! \brief Constructor.
@@ -666,12 +851,18 @@ public:
                   The vertices on each layer aound it (same distance) are
                   ordered consecutivly. If false, we preserver the order of
                   the vertices with the same color.
+      \param level_scheduling If true, the triangular solves are multithreaded
+                              using level scheduling.
+      \param reorder_rcm If true and no red-black ordering is used, the rows are
+                         renumbered with the reverse Cuthill-McKee algorithm.
     */
     template<class BlockType, class Alloc>
     ParallelOverlappingILU0 (const Dune::BCRSMatrix<BlockType,Alloc>& A,
                              const field_type w, MILU_VARIANT milu, bool redblack=false,
-                             bool reorder_sphere=true)
-        : ParallelOverlappingILU0( A, 0, w, milu, redblack, reorder_sphere )
+                             bool reorder_sphere=true, bool level_scheduling=false,
+                             bool reorder_rcm=false)
+        : ParallelOverlappingILU0( A, 0, w, milu, redblack, reorder_sphere, level_scheduling,
+                                   reorder_rcm )
     {
     }
 
@@ -687,12 +878,17 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param level_scheduling If true, the triangular solves are multithreaded
+                              using level scheduling.
+      \param reorder_rcm If true and no red-black ordering is used, the rows are
+                         renumbered with the reverse Cuthill-McKee algorithm.
     */
     template<class BlockType, class Alloc>
     ParallelOverlappingILU0 (const Dune::BCRSMatrix<BlockType,Alloc>& A,
                              const ParallelInfo& comm, const field_type w,
                              MILU_VARIANT milu, bool redblack=false,
-                             bool reorder_sphere=true)
+                             bool reorder_sphere=true, bool level_scheduling=false,
+                             bool reorder_rcm=false)
         : lower_(),
           upper_(),
           inv_(),
@@ -702,7 +898,7 @@ public:
         // BlockMatrix is a Subclass of FieldMatrix that just adds
         // methods. Therefore this cast should be safe.
         init( reinterpret_cast<const Matrix&>(A), 0, milu, redblack,
-              reorder_sphere );
+              reorder_sphere, level_scheduling, reorder_rcm );
     }
 
     /*!
@@ -723,52 +919,65 @@ public:
     */
     virtual void apply (Domain& v, const Range& d)
     {
+        ProfileScope scope(KernelCounters::IluApply);
         Range& md = reorderD(d);
         Domain& mv = reorderV(v);
         copyOwnerToAll( md );
 
-        // iterator types
-        typedef typename Range ::block_type  dblock;
-        typedef typename Domain::block_type  vblock;
-
         const size_type iEnd = lower_.rows();
-        const size_type lastRow = iEnd - 1;
         if( iEnd != upper_.rows() )
         {
             OPM_THROW(std::logic_error,"ILU: number of lower and upper rows must be the same");
         }
 
         // lower triangular solve
-        for( size_type i=0; i<iEnd; ++ i )
+        if ( lowerLevelStart_.empty() )
         {
-          dblock rhs( md[ i ] );
-          const size_type rowI     = lower_.rows_[ i ];
-          const size_type rowINext = lower_.rows_[ i+1 ];
-
-          for( size_type col = rowI; col < rowINext; ++ col )
-          {
-            lower_.values_[ col ].mmv( mv[ lower_.cols_[ col ] ], rhs );
-          }
-
-          mv[ i ] = rhs;  // Lii = I
+            for( size_type i=0; i<iEnd; ++ i )
+            {
+                lowerSolveRow( i, md, mv );
+            }
+        }
+        else
+        {
+            for( std::size_t level = 0, noLevels = lowerLevelStart_.size() - 1;
+                 level < noLevels; ++level )
+            {
+                const std::size_t levelEnd = lowerLevelStart_[ level+1 ];
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
+                for( std::size_t k = lowerLevelStart_[ level ]; k < levelEnd; ++k )
+                {
+                    lowerSolveRow( lowerLevelRows_[ k ], md, mv );
+                }
+            }
         }
 
         copyOwnerToAll( mv );
 
-        for( size_type i=0; i<iEnd; ++ i )
+        // upper triangular solve
+        if ( upperLevelStart_.empty() )
         {
-            vblock& vBlock = mv[ lastRow - i ];
-            vblock rhs ( vBlock );
-            const size_type rowI     = upper_.rows_[ i ];
-            const size_type rowINext = upper_.rows_[ i+1 ];
-
-            for( size_type col = rowI; col < rowINext; ++ col )
+            for( size_type i=0; i<iEnd; ++ i )
             {
-                upper_.values_[ col ].mmv( mv[ upper_.cols_[ col ] ], rhs );
+                upperSolveRow( i, mv );
+            }
+        }
+        else
+        {
+            for( std::size_t level = 0, noLevels = upperLevelStart_.size() - 1;
+                 level < noLevels; ++level )
+            {
+                const std::size_t levelEnd = upperLevelStart_[ level+1 ];
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
+                for( std::size_t k = upperLevelStart_[ level ]; k < levelEnd; ++k )
+                {
+                    upperSolveRow( upperLevelRows_[ k ], mv );
+                }
             }
-
-            // apply inverse and store result
-            inv_[ i ].mv( rhs, vBlock);
         }
 
         copyOwnerToAll( mv );
@@ -779,6 +988,97 @@ public:
         reorderBack(mv, v);
     }
 
+    /// \brief Solve row i (in CRS numbering) of Ly = d.
+    void lowerSolveRow( const size_type i, const Range& md, Domain& mv ) const
+    {
+        typename Range::block_type rhs( md[ i ] );
+        const size_type rowI     = lower_.rows_[ i ];
+        const size_type rowINext = lower_.rows_[ i+1 ];
+
+        for( size_type col = rowI; col < rowINext; ++ col )
+        {
+            detail::blockMmv( lower_.values_[ col ], mv[ lower_.cols_[ col ] ], rhs );
+        }
+
+        mv[ i ] = rhs;  // Lii = I
+    }
+
+    /// \brief Solve row i (in CRS numbering, i.e. reversed) of Ux = y.
+    void upperSolveRow( const size_type i, Domain& mv ) const
+    {
+        typename Domain::block_type& vBlock = mv[ lower_.rows() - 1 - i ];
+        typename Domain::block_type rhs ( vBlock );
+        const size_type rowI     = upper_.rows_[ i ];
+        const size_type rowINext = upper_.rows_[ i+1 ];
+
+        for( size_type col = rowI; col < rowINext; ++ col )
+        {
+            detail::blockMmv( upper_.values_[ col ], mv[ upper_.cols_[ col ] ], rhs );
+        }
+
+        // apply inverse and store result
+        detail::blockMv( inv_[ i ], rhs, vBlock );
+    }
+
+    /*!
+      \brief Recompute the decomposition for new values of the matrix.
+
+      For ILU(n) with n>0 and for a reordered ILU(0) the sparsity pattern
+      and the ordering computed during construction are reused and only the
+      numeric factorization is redone. In particular the coloring of the
+      red-black ordering is not recomputed.
+      \param A The matrix with the new values.
+      \return false if no pattern is cached or the sparsity pattern of A
+              differs from the cached one. Nothing is changed in that case
+              and a new preconditioner has to be set up.
+    */
+    template<class BlockType, class Alloc>
+    bool update (const Dune::BCRSMatrix<BlockType,Alloc>& A)
+    {
+        // BlockMatrix is a Subclass of FieldMatrix that just adds
+        // methods. Therefore this cast should be safe.
+        const Matrix& mat = reinterpret_cast<const Matrix&>(A);
+        if ( ! iluPattern_ || ! matrixPattern_.matches( mat ) )
+        {
+            return false;
+        }
+
+        int ilu_setup_successful = 1;
+        const int rank = ( comm_ ) ? comm_->communicator().rank() : 0;
+        try
+        {
+            std::unique_ptr<detail::Reorderer> reorderer;
+            if ( ordering_.empty() )
+            {
+                reorderer.reset(new detail::NoReorderer());
+            }
+            else
+            {
+                reorderer.reset(new detail::RealReorderer(ordering_));
+            }
+            detail::milun_numeric( mat, milu_, *iluPattern_, *reorderer );
+        }
+        catch ( Dune::MatrixBlockError error )
+        {
+            std::cerr<<"Exception occured on process " << rank << " during " <<
+                "update of ILU preconditioner with message: " <<
+                error.what()<<std::endl;
+            ilu_setup_successful = 0;
+        }
+
+        // Check whether there was a problem on some process
+        const bool parallel_failure = comm_ && comm_->communicator().min(ilu_setup_successful) == 0;
+        if ( ilu_setup_successful == 0 || parallel_failure )
+        {
+            throw Dune::MatrixBlockError();
+        }
+
+        // The pattern did not change, hence the level sets are still valid.
+        detail::convertToCRS( *iluPattern_, lower_, upper_, inv_ );
+        accountMemory();
+        return true;
+    }
+
     template <class V>
     void copyOwnerToAll( V& v ) const
     {
@@ -798,7 +1098,8 @@ public:
     }
 
 protected:
-    void init( const Matrix& A, const int iluIteration, MILU_VARIANT milu, bool redBlack, bool reorderSpheres )
+    void init( const Matrix& A, const int iluIteration, MILU_VARIANT milu, bool redBlack, bool reorderSpheres,
+               bool levelScheduling, bool reorderRCM )
     {
         // (For older DUNE versions the communicator might be
         // invalid if redistribution in AMG happened on the coarset level.
@@ -822,6 +1123,7 @@ protected:
 
         std::unique_ptr< Matrix > ILU;
 
+        verticesPerColor_.clear();
         if ( redBlack )
         {
             using Graph = Dune::Amg::MatrixGraph<const Matrix>;
@@ -830,6 +1132,7 @@ protected:
             const auto& colors = std::get<0>(colorsTuple);
             const auto& verticesPerColor = std::get<2>(colorsTuple);
             auto noColors = std::get<1>(colorsTuple);
+            verticesPerColor_ = verticesPerColor;
             if ( reorderSpheres )
             {
                 ordering_ = reorderVerticesSpheres(colors, noColors, verticesPerColor,
@@ -841,6 +1144,14 @@ protected:
                                                       graph);
             }
         }
+        else if ( reorderRCM )
+        {
+            // A smaller profile keeps the rows accessed by the triangular
+            // solves close together in memory.
+            using Graph = Dune::Amg::MatrixGraph<const Matrix>;
+            Graph graph(A);
+            ordering_ = reorderVerticesReverseCuthillMcKee(graph);
+        }
 
         std::vector<std::size_t> inverseOrdering(ordering_.size());
         std::size_t index = 0;
@@ -856,51 +1167,16 @@ protected:
                 if ( ordering_.empty() )
                 {
                     ILU.reset( new Matrix( A ) );
+                    detail::milu0_numeric( *ILU, milu );
                 }
                 else
                 {
+                    // The reordered pattern is kept, later setups only
+                    // permute the values into it, see update.
                     ILU.reset( new Matrix(A.N(), A.M(), A.nonzeroes(), Matrix::row_wise));
-                    auto& newA = *ILU;
-                    // Create sparsity pattern
-                    for(auto iter=newA.createbegin(), iend = newA.createend(); iter != iend; ++iter)
-                    {
-                        const auto& row = A[inverseOrdering[iter.index()]];
-                        for(auto col = row.begin(), cend = row.end(); col != cend; ++col)
-                        {
-                            iter.insert(ordering_[col.index()]);
-                        }
-                    }
-                    // Copy values
-                    for(auto iter = A.begin(), iend = A.end(); iter != iend; ++iter)
-                    {
-                        auto& newRow = newA[ordering_[iter.index()]];
-                        for(auto col = iter->begin(), cend = iter->end(); col != cend; ++col)
-                        {
-                            newRow[ordering_[col.index()]] = *col;
-                        }
-                    }
-                }
-
-                switch ( milu )
-                {
-                case MILU_VARIANT::MILU_1:
-                    detail::milu0_decomposition ( *ILU);
-                    break;
-                case MILU_VARIANT::MILU_2:
-                    detail::milu0_decomposition ( *ILU, detail::IdentityFunctor(),
-                                                  detail::SignFunctor() );
-                    break;
-                case MILU_VARIANT::MILU_3:
-                    detail::milu0_decomposition ( *ILU, detail::AbsFunctor(),
-                                                  detail::SignFunctor() );
-                    break;
-                case MILU_VARIANT::MILU_4:
-                    detail::milu0_decomposition ( *ILU, detail::IdentityFunctor(),
-                                                  detail::IsPositiveFunctor() );
-                    break;
-                default:
-                    bilu0_decomposition( *ILU );
-                    break;
+                    detail::reordered_sparsity_pattern( A, *ILU, ordering_, inverseOrdering );
+                    detail::RealReorderer reorderer( ordering_ );
+                    detail::milun_numeric( A, milu, *ILU, reorderer );
                 }
             }
             else {
@@ -940,6 +1216,55 @@ protected:
 
         // store ILU in simple CRS format
         detail::convertToCRS( *ILU, lower_, upper_, inv_ );
+
+        // keep the pattern of ILU(n) and of a reordered ILU(0) for numeric
+        // refactorizations
+        milu_ = milu;
+        if ( iluIteration > 0 || ! ordering_.empty() )
+        {
+            iluPattern_ = std::move( ILU );
+            matrixPattern_.assign( A );
+        }
+        else
+        {
+            iluPattern_.reset();
+            matrixPattern_.clear();
+        }
+
+        lowerLevelStart_.clear();
+        upperLevelStart_.clear();
+        if ( levelScheduling && redBlack && iluIteration == 0 )
+        {
+            detail::colorLevelSets( verticesPerColor_, lowerLevelStart_, lowerLevelRows_,
+                                    upperLevelStart_, upperLevelRows_ );
+        }
+        else if ( levelScheduling && lower_.rows() > 0 )
+        {
+            const size_type lastRow = lower_.rows() - 1;
+            detail::computeLevelSets( lower_, [](std::size_t row) { return row; },
+                                      lowerLevelStart_, lowerLevelRows_ );
+            detail::computeLevelSets( upper_, [lastRow](std::size_t row) { return lastRow - row; },
+                                      upperLevelStart_, upperLevelRows_ );
+        }
+        accountMemory();
+    }
+
+    /// \brief Account the bytes of the factorization.
+    void accountMemory()
+    {
+        typedef MemoryAccounting MA;
+        std::size_t bytes = MA::bytes( inv_ );
+        for ( const CRS* crs : { &lower_, &upper_ } )
+        {
+            bytes += MA::bytes( crs->values_ ) + MA::bytes( crs->cols_ ) + MA::bytes( crs->rows_ );
+        }
+        bytes += MA::bytes( lowerLevelStart_ ) + MA::bytes( lowerLevelRows_ )
+            + MA::bytes( upperLevelStart_ ) + MA::bytes( upperLevelRows_ );
+        if ( iluPattern_ )
+        {
+            bytes += MA::matrixBytes( *iluPattern_ ) + matrixPattern_.bytes();
+        }
+        memory_.set( bytes );
     }
 
     /// \brief Reorder D if needed and return a reference to it.
@@ -999,9 +1324,28 @@ protected:
     //! \brief The ILU0 decomposition of the matrix.
     CRS lower_;
     CRS upper_;
-    std::vector< block_type > inv_;
+    std::vector< storage_block_type > inv_;
+    //! \brief Offsets of the levels in lowerLevelRows_ (empty if level scheduling is not used).
+    std::vector< std::size_t > lowerLevelStart_;
+    //! \brief The rows of lower_ sorted by level.
+    std::vector< std::size_t > lowerLevelRows_;
+    //! \brief Offsets of the levels in upperLevelRows_ (empty if level scheduling is not used).
+    std::vector< std::size_t > upperLevelStart_;
+    //! \brief The rows of upper_ sorted by level.
+    std::vector< std::size_t > upperLevelRows_;
+    //! \brief Sparsity pattern of ILU(n), n>0, or of a reordered ILU(0), kept for
+    //!        numeric refactorizations.
+    std::unique_ptr< Matrix > iluPattern_;
+    //! \brief The bytes held by the factorization.
+    MemoryAccounting::Account memory_{ MemoryAccounting::Preconditioner };
+    //! \brief The sparsity pattern of the matrix iluPattern_ was computed for.
+    detail::SparsityPattern matrixPattern_;
+    //! \brief The modified ILU variant used.
+    MILU_VARIANT milu_;
     //! \brief the reordering of the unknowns
     std::vector< std::size_t > ordering_;
+    //! \brief The number of unknowns of each color of a red-black ordering.
+    std::vector< std::size_t > verticesPerColor_;
     //! \brief The reordered right hand side
     Range reorderedD_;
     //! \brief The reordered left hand side.
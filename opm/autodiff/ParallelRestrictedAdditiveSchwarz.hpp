@@ -21,10 +21,13 @@
 #define OPM_PARALLELRESTRICTEDADDITIVESCHWARZ_HEADER_INCLUDED
 
 #include <opm/common/utility/platform_dependent/disable_warnings.h>
+#include <dune/common/version.hh>
 #include <dune/istl/preconditioner.hh>
 #include <dune/istl/paamg/smoother.hh>
 #include <opm/common/utility/platform_dependent/reenable_warnings.h>
 
+#include <memory>
+
 namespace Opm
 {
 
@@ -138,11 +141,18 @@ public:
     //! \brief The type of the communication object.
     typedef ParallelInfo communication_type;
 
+#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 6)
+    Dune::SolverCategory::Category category() const override
+    {
+        return Dune::SolverCategory::overlapping;
+    }
+#else
     // define the category
     enum {
         //! \brief The category the precondtioner is part of.
         category=Dune::SolverCategory::overlapping
     };
+#endif
 
     /*! \brief Constructor.
 
@@ -155,6 +165,18 @@ public:
         : preconditioner_(p), communication_(c)
     {   }
 
+    /*! \brief Constructor taking ownership of the sequential preconditioner.
+
+      Used when the subdomain solver is set up for this preconditioner only,
+      e.g. a direct solver of the subdomain.
+      \param p The sequential preconditioner.
+      \param c The communication object for syncing overlap and copy
+      data points. (E.~g. OwnerOverlapCommunication )
+    */
+    ParallelRestrictedOverlappingSchwarz (std::unique_ptr<SeqPreconditioner> p, const communication_type& c)
+        : preconditioner_(*p), communication_(c), ownedPreconditioner_(std::move(p))
+    {   }
+
     /*!
       \brief Prepare the preconditioner.
 
@@ -204,6 +226,9 @@ private:
 
     //! \brief the communication object
     const communication_type& communication_;
+
+    //! \brief The sequential preconditioner if owned, null otherwise.
+    std::unique_ptr<SeqPreconditioner> ownedPreconditioner_;
 };
 
 
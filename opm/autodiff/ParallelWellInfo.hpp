@@ -0,0 +1,133 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PARALLELWELLINFO_HEADER_INCLUDED
+#define OPM_PARALLELWELLINFO_HEADER_INCLUDED
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/parallel/collectivecommunication.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include <memory>
+#include <string>
+
+namespace Opm
+{
+
+    /// \brief The processes sharing the perforations of one well.
+    ///
+    /// A well whose perforations are distributed over several processes is
+    /// assembled by every one of them, each using its own perforations only.
+    /// The contributions of the perforations to the well equations then need
+    /// to be summed over the processes of the well, which is what the
+    /// communicator of this class is used for.
+    class ParallelWellInfo
+    {
+    public:
+        typedef Dune::MPIHelper::MPICommunicator MPIComm;
+        typedef Dune::CollectiveCommunication<MPIComm> Communication;
+
+        /// \brief A well that only lives on this process.
+        explicit ParallelWellInfo(const std::string& name)
+            : name_(name),
+              comm_(new Communication(Dune::MPIHelper::getLocalCommunicator()))
+        {}
+
+#if HAVE_MPI
+        /// \brief A well that lives on all processes of globalComm with hasLocalPerforations.
+        ///
+        /// This is collective on globalComm.
+        ParallelWellInfo(const std::string& name,
+                         const bool hasLocalPerforations,
+                         const MPIComm globalComm)
+            : name_(name)
+        {
+            MPI_Comm_split(globalComm, hasLocalPerforations ? 1 : MPI_UNDEFINED, 0, &mpi_comm_);
+            if (mpi_comm_ == MPI_COMM_NULL) {
+                comm_.reset(new Communication(Dune::MPIHelper::getLocalCommunicator()));
+            } else {
+                comm_.reset(new Communication(mpi_comm_));
+            }
+        }
+
+        ~ParallelWellInfo()
+        {
+            if (mpi_comm_ != MPI_COMM_NULL) {
+                MPI_Comm_free(&mpi_comm_);
+            }
+        }
+#endif // HAVE_MPI
+
+        ParallelWellInfo(const ParallelWellInfo&) = delete;
+        ParallelWellInfo& operator=(const ParallelWellInfo&) = delete;
+
+        const std::string& name() const
+        {
+            return name_;
+        }
+
+        /// \brief The communication between the processes of the well.
+        const Communication& communication() const
+        {
+            return *comm_;
+        }
+
+        /// \brief Whether the perforations are distributed over several processes.
+        bool isDistributed() const
+        {
+            return comm_->size() > 1;
+        }
+
+        /// \brief Sum the values of all the processes of the well in place.
+        template<class T>
+        void sum(T* values, const int size) const
+        {
+            if (isDistributed()) {
+                comm_->sum(values, size);
+            }
+        }
+
+        /// \brief Sum a vector block over all the processes of the well in place.
+        template<class K, int n>
+        void sum(Dune::FieldVector<K, n>& values) const
+        {
+            sum(&values[0], n);
+        }
+
+        /// \brief Sum a matrix block over all the processes of the well in place.
+        template<class K, int rows, int cols>
+        void sum(Dune::FieldMatrix<K, rows, cols>& values) const
+        {
+            for (int row = 0; row < rows; ++row) {
+                sum(values[row]);
+            }
+        }
+
+    private:
+        std::string name_;
+        std::unique_ptr<Communication> comm_;
+#if HAVE_MPI
+        MPI_Comm mpi_comm_ = MPI_COMM_NULL;
+#endif // HAVE_MPI
+    };
+
+} // namespace Opm
+
+#endif // OPM_PARALLELWELLINFO_HEADER_INCLUDED
@@ -467,93 +467,43 @@ namespace Opm {
             template <typename ElementContext, class EbosSimulator>
             void defineState(const EbosSimulator& simulator)
             {
+                std::vector<double> sums;
+                sumRegions<ElementContext>(simulator, nullptr, sums);
+                setAverages(sums);
+            }
 
-                // create map from cell to region
-                // and set all attributes to zero
+            /**
+             * Compute the pore volume averaged hydrocarbon state of
+             * the regions over a subset of their cells only, typically
+             * the cells perforated by wells.  The sweep then only reads
+             * the state of these cells.
+             *
+             * A region without hydrocarbon pore volume in the subset on
+             * any process is averaged over all its cells instead, so
+             * this is a collective call in a parallel run.
+             *
+             * \param[in] cells  Local cell indices of the subset.
+             */
+            template <typename ElementContext, class EbosSimulator>
+            void defineState(const EbosSimulator& simulator,
+                             const std::vector<int>& cells)
+            {
                 const auto& grid = simulator.vanguard().grid();
-                const unsigned numCells = grid.size(/*codim=*/0);
-                std::vector<int> cell2region(numCells, -1);
-                for (const auto& reg : rmap_.activeRegions()) {
-                    for (const auto& cell : rmap_.cells(reg)) {
-                        cell2region[cell] = reg;
-                    }
-                    auto& ra = attr_.attributes(reg);
-                    ra.pressure = 0.0;
-                    ra.temperature = 0.0;
-                    ra.rs = 0.0;
-                    ra.rv = 0.0;
-                    ra.pv = 0.0;
-
+                std::vector<char> mask(grid.size(/*codim=*/0), 0);
+                for (const int cell : cells) {
+                    mask[cell] = 1;
                 }
 
-                ElementContext elemCtx( simulator );
-                const auto& gridView = simulator.gridView();
-                const auto& comm = gridView.comm();
-
-                const auto& elemEndIt = gridView.template end</*codim=*/0>();
-                for (auto elemIt = gridView.template begin</*codim=*/0>();
-                     elemIt != elemEndIt;
-                     ++elemIt)
-                {
-
-                    const auto& elem = *elemIt;
-                    if (elem.partitionType() != Dune::InteriorEntity)
-                        continue;
-
-                    elemCtx.updatePrimaryStencil(elem);
-                    elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-                    const unsigned cellIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-                    const auto& intQuants = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-                    const auto& fs = intQuants.fluidState();
-                    // use pore volume weighted averages.
-                    const double pv_cell =
-                            simulator.model().dofTotalVolume(cellIdx)
-                            * intQuants.porosity().value();
-
-                    // only count oil and gas filled parts of the domain
-                    double hydrocarbon = 1.0;
-                    const auto& pu = phaseUsage_;
-                    if (Details::PhaseUsed::water(pu)) {
-                        hydrocarbon -= fs.saturation(FluidSystem::waterPhaseIdx).value();
+                std::vector<double> sums;
+                sumRegions<ElementContext>(simulator, &mask, sums);
+                for (std::size_t reg = 0; reg < regionIds_.size(); ++reg) {
+                    if (!(sums[NumSums*reg + PvIdx] > 0.0)) {
+                        // 'sums' is the same on all processes.
+                        defineState<ElementContext>(simulator);
+                        return;
                     }
-
-                    int reg = cell2region[cellIdx];
-                    assert(reg >= 0);
-                    auto& ra = attr_.attributes(reg);
-                    auto& p  = ra.pressure;
-                    auto& T  = ra.temperature;
-                    auto& rs  = ra.rs;
-                    auto& rv  = ra.rv;
-                    auto& pv  = ra.pv;
-
-                    // sum p, rs, rv, and T.
-                    double hydrocarbonPV = pv_cell*hydrocarbon;
-                    pv += hydrocarbonPV;
-                    p += fs.pressure(FluidSystem::oilPhaseIdx).value()*hydrocarbonPV;
-                    rs += fs.Rs().value()*hydrocarbonPV;
-                    rv += fs.Rv().value()*hydrocarbonPV;
-                    T += fs.temperature(FluidSystem::oilPhaseIdx).value()*hydrocarbonPV;
-                }
-
-                for (const auto& reg : rmap_.activeRegions()) {
-                      auto& ra = attr_.attributes(reg);
-                      auto& p  = ra.pressure;
-                      auto& T  = ra.temperature;
-                      auto& rs  = ra.rs;
-                      auto& rv  = ra.rv;
-                      auto& pv  = ra.pv;
-                      // communicate sums
-                      p = comm.sum(p);
-                      T = comm.sum(T);
-                      rs = comm.sum(rs);
-                      rv = comm.sum(rv);
-                      pv = comm.sum(pv);
-                      // compute average
-                      p /= pv;
-                      T /= pv;
-                      rs /= pv;
-                      rv /= pv;
                 }
+                setAverages(sums);
             }
 
 	    /**
@@ -786,6 +736,128 @@ namespace Opm {
 
             Details::RegionAttributes<RegionId, Attributes> attr_;
 
+            /**
+             * Dense index, into regionIds_, of the region of each cell
+             * and the region of each dense index.  Built on the first
+             * call to the simulator overload of defineState().
+             */
+            std::vector<int> cell2region_;
+            std::vector<RegionId> regionIds_;
+
+            /**
+             * Layout of the per-region sums of sumRegions().
+             */
+            enum { PressureIdx, TemperatureIdx, RsIdx, RvIdx, PvIdx, NumSums };
+
+            /**
+             * Hydrocarbon pore volume weighted sums of p, T, rs and rv,
+             * and the hydrocarbon pore volume, of each region over all
+             * processes, NumSums values per region in the order of
+             * regionIds_.  Only the cells in 'mask' count, if given.
+             */
+            template <typename ElementContext, class EbosSimulator>
+            void sumRegions(const EbosSimulator& simulator,
+                            const std::vector<char>* mask,
+                            std::vector<double>& sums)
+            {
+                // The region mapping does not change, so the map from
+                // cell to (dense) region index is only built once.
+                const auto& grid = simulator.vanguard().grid();
+                const unsigned numCells = grid.size(/*codim=*/0);
+                if (cell2region_.size() != numCells) {
+                    cell2region_.assign(numCells, -1);
+                    regionIds_.clear();
+                    for (const auto& reg : rmap_.activeRegions()) {
+                        for (const auto& cell : rmap_.cells(reg)) {
+                            cell2region_[cell] = regionIds_.size();
+                        }
+                        regionIds_.push_back(reg);
+                    }
+                }
+
+                sums.assign(NumSums * regionIds_.size(), 0.0);
+
+                const auto& model = simulator.model();
+                const auto& elemMapper = model.elementMapper();
+                ElementContext elemCtx( simulator );
+                const auto& gridView = simulator.gridView();
+                const auto& comm = gridView.comm();
+
+                const auto& elemEndIt = gridView.template end</*codim=*/0>();
+                for (auto elemIt = gridView.template begin</*codim=*/0>();
+                     elemIt != elemEndIt;
+                     ++elemIt)
+                {
+
+                    const auto& elem = *elemIt;
+                    if (elem.partitionType() != Dune::InteriorEntity)
+                        continue;
+
+                    const unsigned cellIdx = elemMapper.index(elem);
+                    if (mask && !(*mask)[cellIdx])
+                        continue;
+
+                    // Use the intensive quantities of the last
+                    // linearization, they are only recomputed if the
+                    // model does not cache them.
+                    const auto* cachedIntQuants = model.cachedIntensiveQuantities(cellIdx, /*timeIdx=*/0);
+                    if (!cachedIntQuants) {
+                        elemCtx.updatePrimaryStencil(elem);
+                        elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+                    }
+                    const auto& intQuants = cachedIntQuants
+                        ? *cachedIntQuants
+                        : elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
+                    const auto& fs = intQuants.fluidState();
+                    // use pore volume weighted averages.
+                    const double pv_cell =
+                            model.dofTotalVolume(cellIdx)
+                            * intQuants.porosity().value();
+
+                    // only count oil and gas filled parts of the domain
+                    double hydrocarbon = 1.0;
+                    const auto& pu = phaseUsage_;
+                    if (Details::PhaseUsed::water(pu)) {
+                        hydrocarbon -= fs.saturation(FluidSystem::waterPhaseIdx).value();
+                    }
+
+                    const int reg = cell2region_[cellIdx];
+                    assert(reg >= 0);
+                    double* sum = &sums[NumSums * reg];
+
+                    // sum p, rs, rv, and T.
+                    const double hydrocarbonPV = pv_cell*hydrocarbon;
+                    sum[PvIdx] += hydrocarbonPV;
+                    sum[PressureIdx] += fs.pressure(FluidSystem::oilPhaseIdx).value()*hydrocarbonPV;
+                    sum[RsIdx] += fs.Rs().value()*hydrocarbonPV;
+                    sum[RvIdx] += fs.Rv().value()*hydrocarbonPV;
+                    sum[TemperatureIdx] += fs.temperature(FluidSystem::oilPhaseIdx).value()*hydrocarbonPV;
+                }
+
+                // communicate the sums of all regions at once
+                if (!sums.empty()) {
+                    comm.sum(sums.data(), sums.size());
+                }
+            }
+
+            /**
+             * Set the region attributes from the sums of sumRegions().
+             */
+            void setAverages(const std::vector<double>& sums)
+            {
+                for (std::size_t reg = 0; reg < regionIds_.size(); ++reg) {
+                    const double* sum = &sums[NumSums * reg];
+                    auto& ra = attr_.attributes(regionIds_[reg]);
+                    const double pv = sum[PvIdx];
+                    // compute average
+                    ra.pressure = sum[PressureIdx] / pv;
+                    ra.temperature = sum[TemperatureIdx] / pv;
+                    ra.rs = sum[RsIdx] / pv;
+                    ra.rv = sum[RvIdx] / pv;
+                    ra.pv = pv;
+                }
+            }
+
 
             /**
              * Compute average hydrocarbon pressure and temperatures in all
@@ -26,6 +26,15 @@
 #include <string>
 #include <type_traits>
 #include <iterator>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <opm/common/ErrorMacros.hpp>
+#include <opm/common/OpmLog/OpmLog.hpp>
 
 #include <opm/core/simulator/BlackoilState.hpp>
 
@@ -50,7 +59,9 @@ distributeGridAndData( Grid& ,
                        std::shared_ptr<BlackoilPropsAdFromDeck::MaterialLawManager>&,
                        std::vector<double>&,
                        boost::any& ,
-                       const bool )
+                       const bool ,
+                       const std::string& = "transmissibility",
+                       const int = 1 )
 {
     return std::unordered_set<std::string>();
 }
@@ -537,6 +548,116 @@ private:
     std::size_t size_;
 };
 
+/// \brief Compute the edge weights of the graph partitioning.
+///
+/// \param transmissibility The transmissibilities of the global grid.
+/// \param method "transmissibility" uses the transmissibilities directly,
+///               "log_transmissibility" compresses their range of many
+///               orders of magnitude to 1 + log10(T/T_min) and "uniform"
+///               uses no edge weights at all (empty result).
+inline std::vector<double>
+partitionEdgeWeights(const std::vector<double>& transmissibility,
+                     const std::string& method)
+{
+    if (method == "uniform") {
+        return std::vector<double>();
+    }
+    if (method == "transmissibility") {
+        return transmissibility;
+    }
+    if (method == "log_transmissibility") {
+        double minTrans = std::numeric_limits<double>::max();
+        for (const double t : transmissibility) {
+            if (t > 0.0) {
+                minTrans = std::min(minTrans, t);
+            }
+        }
+        std::vector<double> weights(transmissibility.size(), 1.0);
+        for (std::size_t face = 0; face < weights.size(); ++face) {
+            const double t = transmissibility[face];
+            if (t > 0.0) {
+                weights[face] += std::log10(t / minTrans);
+            }
+        }
+        return weights;
+    }
+    OPM_THROW(std::runtime_error, "Unknown partition edge weights: " << method);
+}
+
+/// \brief Report the predicted load of each process after the partitioning.
+///
+/// The load of an interior cell is estimated by the number of blocks it
+/// contributes to the Jacobian, i.e. numPhases^2 for the cell itself, each
+/// neighbour and each perforation in the cell.
+/// \return max load / average load
+inline double
+reportPredictedLoadImbalance(const Dune::CpGrid& grid,
+                             const Schedule& schedule,
+                             const int numPhases)
+{
+    const auto& globalCell = grid.globalCell();
+    const auto& cartDims = grid.logicalCartesianSize();
+    std::vector<int> perforations(globalCell.size(), 0);
+    {
+        std::vector<int> cartesianToCompressed(cartDims[0] * cartDims[1] * cartDims[2], -1);
+        for (std::size_t cell = 0; cell < globalCell.size(); ++cell) {
+            cartesianToCompressed[globalCell[cell]] = cell;
+        }
+        const int lastTimeStep = schedule.getTimeMap().size() - 1;
+        for (const auto well : schedule.getWells()) {
+            const auto& connections = well->getConnections(lastTimeStep);
+            for (std::size_t c = 0; c < connections.size(); ++c) {
+                const auto& connection = connections.get(c);
+                const int cartIdx = connection.getI()
+                    + cartDims[0] * (connection.getJ() + cartDims[1] * connection.getK());
+                const int cell = cartesianToCompressed[cartIdx];
+                if (cell >= 0) {
+                    ++perforations[cell];
+                }
+            }
+        }
+    }
+
+    double load = 0.0;
+    const auto gridView = grid.leafGridView();
+    int index = 0;
+    for (auto it = gridView.begin<0>(), end = gridView.end<0>(); it != end; ++it, ++index) {
+        const auto& element = *it;
+        if (element.partitionType() != Dune::InteriorEntity) {
+            continue;
+        }
+        int blocks = 1 + perforations[index];
+        for (auto is = gridView.ibegin(element), isEnd = gridView.iend(element); is != isEnd; ++is) {
+            if (is->neighbor()) {
+                ++blocks;
+            }
+        }
+        load += blocks * numPhases * numPhases;
+    }
+
+    const auto& comm = grid.comm();
+    std::vector<double> loads(comm.size());
+    comm.allgather(&load, 1, loads.data());
+    const double maxLoad = *std::max_element(loads.begin(), loads.end());
+    double averageLoad = 0.0;
+    for (const double l : loads) {
+        averageLoad += l;
+    }
+    averageLoad /= comm.size();
+    const double imbalance = averageLoad > 0.0 ? maxLoad / averageLoad : 1.0;
+
+    if (comm.rank() == 0) {
+        std::ostringstream message;
+        message << "Predicted load imbalance (max/average) of the partitioning: " << imbalance << "\n"
+                << "Predicted load per process:";
+        for (int rank = 0; rank < comm.size(); ++rank) {
+            message << "\n  " << rank << ": " << loads[rank];
+        }
+        OpmLog::info(message.str());
+    }
+    return imbalance;
+}
+
 inline
 std::unordered_set<std::string>
 distributeGridAndData( Dune::CpGrid& grid,
@@ -549,7 +670,9 @@ distributeGridAndData( Dune::CpGrid& grid,
                        std::shared_ptr<BlackoilPropsAdFromDeck::MaterialLawManager>& material_law_manager,
                        std::vector<double>& threshold_pressures,
                        boost::any& parallelInformation,
-                       const bool useLocalPerm)
+                       const bool useLocalPerm,
+                       const std::string& edgeWeightsMethod = "transmissibility",
+                       const int overlapLayers = 1)
 {
     Dune::CpGrid global_grid ( grid );
     global_grid.switchToGlobalView();
@@ -557,8 +680,20 @@ distributeGridAndData( Dune::CpGrid& grid,
     // distribute the grid and switch to the distributed view
     using std::get;
     auto wells = schedule.getWells();
-    auto my_defunct_wells = get<1>(grid.loadBalance(&wells, geology.transmissibility().data()));
+    const auto& trans = geology.transmissibility();
+    const std::vector<double> edgeWeights =
+        partitionEdgeWeights(std::vector<double>(trans.data(), trans.data() + trans.size()),
+                             edgeWeightsMethod);
+    // More overlap layers make the subdomains of the ILU and the direct
+    // subdomain solver larger, trading communication for iterations.
+    if ( overlapLayers < 1 || overlapLayers > 3 )
+    {
+        OPM_THROW(std::invalid_argument, "The number of overlap layers has to be between 1 and 3, got " << overlapLayers);
+    }
+    auto my_defunct_wells = get<1>(grid.loadBalance(&wells, edgeWeights.empty() ? nullptr : edgeWeights.data(),
+                                                    overlapLayers));
     grid.switchToDistributedView();
+    reportPredictedLoadImbalance(grid, schedule, state.numPhases());
     std::vector<int> compressedToCartesianIdx;
     Opm::createGlobalCellArray(grid, compressedToCartesianIdx);
     typedef BlackoilPropsAdFromDeck::MaterialLawManager MaterialLawManager;
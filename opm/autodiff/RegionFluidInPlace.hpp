@@ -0,0 +1,118 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_REGIONFLUIDINPLACE_HEADER_INCLUDED
+#define OPM_REGIONFLUIDINPLACE_HEADER_INCLUDED
+
+#include <opm/autodiff/BlackoilModelEnums.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace Opm
+{
+namespace detail
+{
+
+    /// \brief The sums of the fluid in place of the cells of each FIPNUM region.
+    ///
+    /// Per region the fluid in place values of FIPDataEnums are summed, except
+    /// for the weighted pressure, which is computed by values() from the sums
+    /// of the (hydrocarbon) pore volume weighted pressures.
+    class RegionFluidInPlace
+    {
+    public:
+        typedef FIPDataEnums FIP;
+
+        explicit RegionFluidInPlace(const int numRegions)
+            : sums_(numRegions * stride, 0.0)
+        {}
+
+        /// \brief Add a cell to its region.
+        /// \param[in] region       Index of the region, from 0.
+        /// \param[in] fip          The surface volumes of the cell, indexed by
+        ///                         FIP_AQUA to FIP_VAPORIZED_OIL.
+        /// \param[in] pv           Pore volume of the cell.
+        /// \param[in] hydrocarbon  Hydrocarbon saturation of the cell.
+        /// \param[in] pressure     Pressure of the cell.
+        void add(const int region, const double* fip, const double pv,
+                 const double hydrocarbon, const double pressure)
+        {
+            double* v = sums_.data() + region * stride;
+            for (int i = 0; i < FIP::FIP_PV; ++i) {
+                v[i] += fip[i];
+            }
+            v[FIP::FIP_PV] += pv;
+            v[FIP::fipValues + 0] += pv * hydrocarbon;
+            v[FIP::fipValues + 1] += pv * hydrocarbon * pressure;
+            v[FIP::fipValues + 2] += pv * pressure;
+        }
+
+        /// \brief Add the sums of other, e.g. of another thread.
+        void add(const RegionFluidInPlace& other)
+        {
+            for (std::size_t k = 0; k < sums_.size(); ++k) {
+                sums_[k] += other.sums_[k];
+            }
+        }
+
+        /// \brief Forget all cells.
+        void clear()
+        {
+            std::fill(sums_.begin(), sums_.end(), 0.0);
+        }
+
+        /// \brief The sums, to be summed over all processes in place.
+        std::vector<double>& sums()
+        {
+            return sums_;
+        }
+
+        /// \brief The values of each region, ordered as FIPDataEnums::FipId.
+        ///
+        /// The weighted pressure is the hydrocarbon pore volume weighted
+        /// average, or the pore volume weighted one for regions without
+        /// hydrocarbons.
+        std::vector<std::vector<double> > values() const
+        {
+            const int numRegions = sums_.size() / stride;
+            std::vector<std::vector<double> > regionValues(numRegions);
+            for (int region = 0; region < numRegions; ++region) {
+                const double* v = sums_.data() + region * stride;
+                regionValues[region].assign(v, v + FIP::fipValues);
+                const double hcpv = v[FIP::fipValues + 0];
+                const double pv = v[FIP::FIP_PV];
+                regionValues[region][FIP::FIP_WEIGHTED_PRESSURE] =
+                    hcpv > 0.0 ? v[FIP::fipValues + 1] / hcpv
+                    : (pv > 0.0 ? v[FIP::fipValues + 2] / pv : 0.0);
+            }
+            return regionValues;
+        }
+
+    private:
+        // per region: the fip values, followed by the sums of pv*hc, pv*hc*p and pv*p
+        static const int stride = FIP::fipValues + 3;
+        std::vector<double> sums_;
+    };
+
+} // namespace detail
+} // namespace Opm
+
+#endif // OPM_REGIONFLUIDINPLACE_HEADER_INCLUDED
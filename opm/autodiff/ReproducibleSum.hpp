@@ -0,0 +1,115 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_REPRODUCIBLESUM_HEADER_INCLUDED
+#define OPM_REPRODUCIBLESUM_HEADER_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace Opm
+{
+namespace detail
+{
+
+    /// \brief A floating point sum that does not depend on the order of the
+    ///        summands, nor on their distribution over threads and processes.
+    ///
+    /// Each summand is split into parts that are multiples of the unit of
+    /// precision of a fold, with the scales of the folds chosen from bounds of
+    /// the magnitude and the number of all the summands. The parts of a fold
+    /// are summed exactly in any order, so partial sums of threads and
+    /// processes are combined exactly by adding their folds, e.g. by an
+    /// ordinary global sum of folds(). The value is exact up to the
+    /// remainder of the last fold, about 2^(-numFolds*(53-log2(count))) of
+    /// maxAbs.
+    ///
+    /// The splitting (M + x) - M must not be reassociated by the compiler,
+    /// i.e. the code must not be compiled with -ffast-math.
+    ///
+    /// See J. Demmel and H. D. Nguyen, Fast reproducible floating-point
+    /// summation, ARITH 2013.
+    class ReproducibleSum
+    {
+    public:
+        /// Number of folds of the sum.
+        static const int numFolds = 3;
+
+        /// Construct an empty sum.
+        /// \param[in] maxAbs  Upper bound of the magnitude of all summands.
+        /// \param[in] count   Upper bound of the number of all summands.
+        ReproducibleSum(const double maxAbs, const double count)
+        {
+            // |x| < 2^(e-1) for all summands and count*2^e < 2^(e+l).
+            int e = std::ilogb(std::max(maxAbs, std::numeric_limits<double>::min())) + 2;
+            const int l = std::ilogb(std::max(count, 1.0)) + 2;
+            for (int k = 0; k < numFolds; ++k) {
+                // The unit of precision of 1.5*2^(e+l) is 2^(e+l-52), the parts
+                // of a fold sum to less than 2^53 of these units.
+                scale_[k] = std::ldexp(1.5, e + l);
+                sum_[k] = 0.0;
+                e += l - std::numeric_limits<double>::digits + 1;
+            }
+        }
+
+        /// Add a summand.
+        void add(double x)
+        {
+            for (int k = 0; k < numFolds; ++k) {
+                const double part = (scale_[k] + x) - scale_[k];
+                sum_[k] += part;
+                x -= part;
+            }
+        }
+
+        /// Add the summands of another sum with the same bounds.
+        void add(const ReproducibleSum& other)
+        {
+            for (int k = 0; k < numFolds; ++k) {
+                sum_[k] += other.sum_[k];
+            }
+        }
+
+        /// The partial sums of the folds, e.g. for a global sum.
+        std::array<double, numFolds>& folds()
+        {
+            return sum_;
+        }
+
+        /// The value of the sum.
+        double value() const
+        {
+            double value = 0.0;
+            for (int k = numFolds - 1; k >= 0; --k) {
+                value += sum_[k];
+            }
+            return value;
+        }
+
+    private:
+        std::array<double, numFolds> scale_;
+        std::array<double, numFolds> sum_;
+    };
+
+} // namespace detail
+} // namespace Opm
+
+#endif // OPM_REPRODUCIBLESUM_HEADER_INCLUDED
@@ -23,6 +23,8 @@
 #include <functional>
 #include <algorithm>
 #include <locale>
+#include <set>
+#include <string>
 #include <opm/parser/eclipse/EclipseState/Schedule/Events.hpp>
 #include <opm/core/utility/initHydroCarbonState.hpp>
 #include <opm/core/well_controls.h>
@@ -267,7 +269,26 @@ namespace Opm
                 // TODO (?): handle the parallel case (maybe this works out of the box)
                 const auto& miniDeck = schedule_->getModifierDeck(nextTimeStepIdx);
                 eclipse_state_->applyModifierDeck(miniDeck);
-                geo_.update(grid_, props_, *eclipse_state_, gravity_);
+
+                // Changes of the transmissibility multipliers only update the
+                // affected faces, everything else reprocesses the geology.
+                static const std::set<std::string> multiplierKeywords = {
+                    "MULTFLT", "MULTREGT", "MULTX", "MULTX-", "MULTY", "MULTY-", "MULTZ", "MULTZ-"
+                };
+                bool multipliersOnly = true;
+                for (std::size_t kwIdx = 0; kwIdx < miniDeck.size(); ++kwIdx) {
+                    multipliersOnly = multipliersOnly &&
+                        multiplierKeywords.count(miniDeck.getKeyword(kwIdx).name()) > 0;
+                }
+                if (multipliersOnly) {
+                    const int numChanged = geo_.updateTransMultipliers(grid_, *eclipse_state_);
+                    if (terminal_output_) {
+                        OpmLog::debug("Updated the transmissibility of " + std::to_string(numChanged) + " faces.");
+                    }
+                }
+                else {
+                    geo_.update(grid_, props_, *eclipse_state_, gravity_);
+                }
             }
 
             // take time that was used to solve system for this reportStep
@@ -29,6 +29,15 @@
 #include <opm/autodiff/WellStateFullyImplicitBlackoil.hpp>
 #include <opm/autodiff/BlackoilWellModel.hpp>
 #include <opm/autodiff/BlackoilAquiferModel.hpp>
+#include <opm/autodiff/FlowDiagnosticsEbos.hpp>
+#include <opm/autodiff/SimulatorSnapshot.hpp>
+#include <opm/simulators/DeferredLogger.hpp>
+#include <opm/simulators/KernelCounters.hpp>
+#include <opm/simulators/MemoryAccounting.hpp>
+#include <opm/simulators/PerformanceTrace.hpp>
+#include <opm/simulators/ProfileScope.hpp>
+#include <opm/simulators/RunProfile.hpp>
+#include <opm/simulators/TimerRegistry.hpp>
 #include <opm/autodiff/moduleVersion.hpp>
 #include <opm/simulators/timestepping/AdaptiveTimeSteppingEbos.hpp>
 #include <opm/grid/utility/StopWatch.hpp>
@@ -38,6 +47,11 @@
 
 #include <dune/common/unused.hh>
 
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <utility>
+
 namespace Opm {
 
 
@@ -65,6 +79,7 @@ public:
     typedef NonlinearSolverEbos<Model> Solver;
     typedef BlackoilWellModel<TypeTag> WellModel;
     typedef BlackoilAquiferModel<TypeTag> AquiferModel;
+    typedef FlowDiagnosticsEbos<TypeTag> FlowDiagnostics;
 
 
     /// Initialise from parameters and objects to observe.
@@ -118,8 +133,56 @@ public:
     /// \param[in,out] state       state of reservoir: pressure, fluxes
     /// \return                    simulation report, with timing data
     SimulatorReport run(SimulatorTimer& timer)
+    {
+        init(timer);
+        stepTo(timer, timer.totalTime());
+        return finalize();
+    }
+
+    /// Prepare the simulation of the report steps of the timer, e.g. when the
+    /// simulator is embedded in another program that calls stepTo() between
+    /// its own computations. Handles restarts and snapshots like run().
+    /// \param[in,out] timer       governs the requested reporting timesteps
+    void init(SimulatorTimer& timer)
     {
         failureReport_ = SimulatorReport();
+        report_ = SimulatorReport();
+
+        // record a trace of the performance of all processes if requested
+        traceFile_ = param_.getDefault("trace_file", std::string(""));
+        if (!traceFile_.empty()) {
+            PerformanceTrace::start(param_.getDefault("trace_capacity", 1000000),
+                                    param_.getDefault("trace_sample_interval", 1));
+        }
+
+        // count the cycles, instructions and cache misses of the main kernels if requested
+        const std::string kernelCountersFile = param_.getDefault("kernel_counters_file", std::string(""));
+        if (!kernelCountersFile.empty()) {
+            KernelCounters::start(kernelCountersFile);
+        }
+
+        // print the memory held by the subsystems of each process if requested
+        memoryReport_ = param_.getDefault("memory_report", false);
+
+        // print the hierarchical timers at the end of the run if requested
+        timerReport_ = param_.getDefault("timer_report", false);
+        timerReportFile_ = param_.getDefault("timer_report_file", std::string(""));
+        if (timerReport_ || !timerReportFile_.empty()) {
+            TimerRegistry::reset();
+            TimerRegistry::start();
+        }
+
+        // write a summary of where the time of the run went beside the PRT
+        // file if requested
+        runProfile_ = RunProfile();
+        profileSummaryFile_.clear();
+        if (param_.getDefault("profile_summary", false)) {
+            const auto& ioConfig = eclState().getIOConfig();
+            profileSummaryFile_ = param_.getDefault("profile_summary_file",
+                                                    ioConfig.getOutputDir() + "/" + ioConfig.getBaseName()
+                                                    + ".PROFILE.json");
+            profileSummarySteps_ = param_.getDefault("profile_summary_steps", 10);
+        }
 
         // handle restarts
         std::unique_ptr<RestartValue> restartValues;
@@ -132,21 +195,21 @@ public:
             restartValues.reset(new RestartValue(ebosSimulator_.problem().eclIO().loadRestart(solutionKeys, extraKeys)));
         }
 
+        fipnum_ = fipnumOfCells_();
+
         // Create timers and file for writing timing info.
-        Opm::time::StopWatch solverTimer;
-        Opm::time::StopWatch totalTimer;
-        totalTimer.start();
+        totalTimer_ = Opm::time::StopWatch();
+        totalTimer_.start();
 
         // adaptive time stepping
-        const auto& events = schedule().getEvents();
-        std::unique_ptr< AdaptiveTimeSteppingEbos > adaptiveTimeStepping;
-        const bool useTUNING = param_.getDefault("use_TUNING", false);
+        adaptiveTimeStepping_.reset();
+        useTUNING_ = param_.getDefault("use_TUNING", false);
         if (param_.getDefault("timestep.adaptive", true)) {
-            if (useTUNING) {
-                adaptiveTimeStepping.reset(new AdaptiveTimeSteppingEbos(schedule().getTuning(), timer.currentStepNum(), param_, terminalOutput_));
+            if (useTUNING_) {
+                adaptiveTimeStepping_.reset(new AdaptiveTimeSteppingEbos(schedule().getTuning(), timer.currentStepNum(), param_, terminalOutput_));
             }
             else {
-                adaptiveTimeStepping.reset(new AdaptiveTimeSteppingEbos(param_, terminalOutput_));
+                adaptiveTimeStepping_.reset(new AdaptiveTimeSteppingEbos(param_, terminalOutput_));
             }
 
             double suggestedStepSize = -1.0;
@@ -163,157 +226,198 @@ public:
                 }
 
                 if (suggestedStepSize > 0.0) {
-                    adaptiveTimeStepping->setSuggestedNextStep(suggestedStepSize);
+                    adaptiveTimeStepping_->setSuggestedNextStep(suggestedStepSize);
                 }
             }
         }
 
-        SimulatorReport report;
-        SimulatorReport stepReport;
-
-        WellModel wellModel(ebosSimulator_, modelParam_, terminalOutput_);
+        wellModel_.reset(new WellModel(ebosSimulator_, modelParam_, terminalOutput_));
         if (isRestart()) {
-            wellModel.initFromRestartFile(*restartValues);
+            wellModel_->initFromRestartFile(*restartValues);
+        }
+
+        // resume from the snapshot written at the end of an earlier run
+        const std::string resumeFrom = param_.getDefault("resume_from_snapshot", std::string(""));
+        if (!resumeFrom.empty()) {
+            readSnapshot_(resumeFrom, timer, *wellModel_, adaptiveTimeStepping_.get());
         }
+        snapshotFile_ = param_.getDefault("snapshot_file", std::string(""));
+        snapshotInterval_ = std::max(param_.getDefault("snapshot_interval", 1), 1);
+        // measured load imbalance at which a warning is issued (0 disables the check)
+        imbalanceThreshold_ = param_.getDefault("load_imbalance_threshold", 0.0);
 
         if (modelParam_.matrix_add_well_contributions_ ||
-             modelParam_.preconditioner_add_well_contributions_)
+             modelParam_.preconditioner_add_well_contributions_ ||
+             modelParam_.sequential_sweeps_ > 0)
         {
             ebosSimulator_.model().clearAuxiliaryModules();
             wellAuxMod_.reset(new WellConnectionAuxiliaryModule<TypeTag>(schedule(), grid()));
             ebosSimulator_.model().addAuxiliaryModule(wellAuxMod_.get());
         }
 
-        AquiferModel aquifer_model(ebosSimulator_);
-
-        // Main simulation loop.
-        while (!timer.done()) {
-            // Report timestep.
-            if (terminalOutput_) {
-                std::ostringstream ss;
-                timer.report(ss);
-                OpmLog::debug(ss.str());
-            }
-
-            // Run a multiple steps of the solver depending on the time step control.
-            solverTimer.start();
-
-            wellModel.beginReportStep(timer.currentStepNum());
-
-            auto solver = createSolver(wellModel, aquifer_model);
-
-            // write the inital state at the report stage
-            if (timer.initialStep()) {
-                Dune::Timer perfTimer;
-                perfTimer.start();
-
-                // No per cell data is written for initial step, but will be
-                // for subsequent steps, when we have started simulating
-                auto localWellData = wellModel.wellState().report(phaseUsage_, Opm::UgGridHelpers::globalCell(grid()));
-                ebosSimulator_.problem().writeOutput(localWellData,
-                                                     timer.simulationTimeElapsed(),
-                                                     /*isSubstep=*/false,
-                                                     totalTimer.secsSinceStart(),
-                                                     /*nextStepSize=*/-1.0);
-
-                report.output_write_time += perfTimer.stop();
-            }
-
-            if (terminalOutput_) {
-                std::ostringstream stepMsg;
-                boost::posix_time::time_facet* facet = new boost::posix_time::time_facet("%d-%b-%Y");
-                stepMsg.imbue(std::locale(std::locale::classic(), facet));
-                stepMsg << "\nReport step " << std::setw(2) <<timer.currentStepNum()
-                         << "/" << timer.numSteps()
-                         << " at day " << (double)unit::convert::to(timer.simulationTimeElapsed(), unit::day)
-                         << "/" << (double)unit::convert::to(timer.totalTime(), unit::day)
-                         << ", date = " << timer.currentDateTime();
-                OpmLog::info(stepMsg.str());
-            }
-
-            solver->model().beginReportStep();
-
-            // If sub stepping is enabled allow the solver to sub cycle
-            // in case the report steps are too large for the solver to converge
-            //
-            // \Note: The report steps are met in any case
-            // \Note: The sub stepping will require a copy of the state variables
-            if (adaptiveTimeStepping) {
-                if (useTUNING) {
-                    if (events.hasEvent(ScheduleEvents::TUNING_CHANGE,timer.currentStepNum())) {
-                        adaptiveTimeStepping->updateTUNING(schedule().getTuning(), timer.currentStepNum());
-                    }
-                }
+        aquiferModel_.reset(new AquiferModel(ebosSimulator_));
 
-                bool event = events.hasEvent(ScheduleEvents::NEW_WELL, timer.currentStepNum()) ||
-                        events.hasEvent(ScheduleEvents::PRODUCTION_UPDATE, timer.currentStepNum()) ||
-                        events.hasEvent(ScheduleEvents::INJECTION_UPDATE, timer.currentStepNum()) ||
-                        events.hasEvent(ScheduleEvents::WELL_STATUS_CHANGE, timer.currentStepNum());
-                stepReport = adaptiveTimeStepping->step(timer, *solver, event, nullptr);
-                report += stepReport;
-                failureReport_ += adaptiveTimeStepping->failureReport();
-            }
-            else {
-                // solve for complete report step
-                stepReport = solver->step(timer);
-                report += stepReport;
-                failureReport_ += solver->failureReport();
-
-                if (terminalOutput_) {
-                    std::ostringstream ss;
-                    stepReport.reportStep(ss);
-                    OpmLog::info(ss.str());
-                }
-            }
-
-            solver->model().endReportStep();
-            wellModel.endReportStep();
-
-            // take time that was used to solve system for this reportStep
-            solverTimer.stop();
+        // flow diagnostics at the selected report steps, computed in the background
+        flowDiagnostics_.reset(new FlowDiagnostics(ebosSimulator_, param_, terminalOutput_));
+    }
 
-            // update timing.
-            report.solver_time += solverTimer.secsSinceStart();
+    /// Simulate the report steps of the timer until the given time is reached.
+    /// The time is rounded up to the end of a report step, since the report
+    /// steps are always met; embedding programs that need a finer exchange
+    /// refine the schedule accordingly. The output is written at the end of
+    /// each report step unless setOutputEnabled(false) was called.
+    /// \param[in,out] timer       the timer given to init()
+    /// \param[in]     time        the simulation time to reach [s]
+    /// \return                    the report of all steps since init()
+    const SimulatorReport& stepTo(SimulatorTimer& timer, const double time)
+    {
+        // a relative tolerance, such that the end of a report step is not missed
+        // by rounding
+        const double tolerance = 1e-10 * std::max(timer.totalTime(), 1.0);
+        while (!timer.done() && timer.simulationTimeElapsed() < time - tolerance) {
+            runReportStep_(timer);
+        }
+        intensiveQuantitiesUpToDate_ = false;
+        return report_;
+    }
 
-            // Increment timer, remember well state.
-            ++timer;
+    /// Finish the simulation after the last stepTo(), writes the traces and
+    /// reports that were requested.
+    /// \return                    simulation report, with timing data
+    SimulatorReport finalize()
+    {
+        // Stop timer and create timing report
+        totalTimer_.stop();
+        report_.total_time = totalTimer_.secsSinceStart();
+        report_.converged = true;
 
+        if (!traceFile_.empty()) {
+            PerformanceTrace::write(traceFile_);
+            PerformanceTrace::stop();
+        }
+        KernelCounters::stop();
+        if (memoryReport_) {
+            MemoryAccounting::report("Peak memory", true);
+        }
+        if (!profileSummaryFile_.empty()) {
+            runProfile_.write(profileSummaryFile_, std::max(profileSummarySteps_, 0));
+        }
+        if (timerReport_ || !timerReportFile_.empty()) {
+            TimerRegistry::stop();
+            TimerRegistry::write(timerReportFile_);
+        }
 
-            if (terminalOutput_) {
-                if (!timer.initialStep()) {
-                    const std::string version = moduleVersionName();
-                    outputTimestampFIP(timer, version);
-                }
-            }
+        return report_;
+    }
 
-            // write simulation state at the report stage
-            Dune::Timer perfTimer;
-            perfTimer.start();
-            const double nextstep = adaptiveTimeStepping ? adaptiveTimeStepping->suggestedNextStep() : -1.0;
+    /// Whether the state is written to the output files at the end of each
+    /// report step, true by default. An embedding program that reads the state
+    /// with cellField() may disable it.
+    void setOutputEnabled(const bool enabled)
+    { outputEnabled_ = enabled; }
 
-            auto localWellData = wellModel.wellState().report(phaseUsage_, Opm::UgGridHelpers::globalCell(grid()));
-            ebosSimulator_.problem().writeOutput(localWellData,
-                                                 timer.simulationTimeElapsed(),
-                                                 /*isSubstep=*/false,
-                                                 totalTimer.secsSinceStart(),
-                                                 nextstep);
-            report.output_write_time += perfTimer.stop();
+    /// \brief A view of a field of the cells of this process, in the storage of
+    ///        the simulator without copying.
+    ///
+    /// The values are strided, since the fields of a cell are stored together.
+    /// The view stays valid until the next call of stepTo().
+    class CellField
+    {
+    public:
+        CellField()
+            : data_(nullptr), stride_(0), size_(0)
+        {}
+
+        CellField(const double* first, const std::size_t strideBytes, const std::size_t size)
+            : data_(reinterpret_cast<const char*>(first)), stride_(strideBytes), size_(size)
+        {}
+
+        double operator[](const std::size_t cellIdx) const
+        { return *reinterpret_cast<const double*>(data_ + cellIdx * stride_); }
+
+        std::size_t size() const
+        { return size_; }
+
+        /// The distance of the values of two consecutive cells in bytes.
+        std::size_t stride() const
+        { return stride_; }
+
+    private:
+        const char* data_;
+        std::size_t stride_;
+        std::size_t size_;
+    };
+
+    /// The field of the given name, one of the keywords of the ECL output
+    /// PRESSURE (of the oil phase), SWAT, SOIL, SGAS, RS and RV, or PRIMARY_n
+    /// for the n-th primary variable. The fields other than the primary
+    /// variables are those of the intensive quantities, which are updated once
+    /// after stepTo() if the caching of the intensive quantities is enabled.
+    CellField cellField(const std::string& name)
+    {
+        auto& model = ebosSimulator_.model();
+        const std::size_t numCells = model.numGridDof();
+        if (numCells == 0) {
+            return CellField();
+        }
 
-            if (terminalOutput_) {
-                std::string msg =
-                    "Time step took " + std::to_string(solverTimer.secsSinceStart()) + " seconds; "
-                    "total solver time " + std::to_string(report.solver_time) + " seconds.";
-                OpmLog::debug(msg);
+        if (name.compare(0, 8, "PRIMARY_") == 0) {
+            const int eqIdx = std::atoi(name.c_str() + 8);
+            if (eqIdx < 0 || eqIdx >= static_cast<int>(PrimaryVariables::dimension)) {
+                OPM_THROW(std::invalid_argument, "No primary variable " << name);
             }
-
+            const auto& solution = model.solution(/*timeIdx=*/0);
+            return CellField(&solution[0][eqIdx], sizeof(PrimaryVariables), numCells);
         }
 
-        // Stop timer and create timing report
-        totalTimer.stop();
-        report.total_time = totalTimer.secsSinceStart();
-        report.converged = true;
+        if (!intensiveQuantitiesUpToDate_) {
+            model.invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+            intensiveQuantitiesUpToDate_ = true;
+        }
+        const auto* firstIntQuants = model.cachedIntensiveQuantities(/*globalIdx=*/0, /*timeIdx=*/0);
+        if (!firstIntQuants) {
+            OPM_THROW(std::logic_error, "The field " << name << " needs the intensive quantities to be cached");
+        }
+        const auto& intQuants = *firstIntQuants;
+        const auto& fs = intQuants.fluidState();
+        const double* first = nullptr;
+        if (name == "PRESSURE") {
+            first = &fs.pressure(FluidSystem::oilPhaseIdx).value();
+        }
+        else if (name == "SWAT" && FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+            first = &fs.saturation(FluidSystem::waterPhaseIdx).value();
+        }
+        else if (name == "SOIL" && FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx)) {
+            first = &fs.saturation(FluidSystem::oilPhaseIdx).value();
+        }
+        else if (name == "SGAS" && FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+            first = &fs.saturation(FluidSystem::gasPhaseIdx).value();
+        }
+        else if (name == "RS" && FluidSystem::enableDissolvedGas()) {
+            first = &fs.Rs().value();
+        }
+        else if (name == "RV" && FluidSystem::enableVaporizedOil()) {
+            first = &fs.Rv().value();
+        }
+        else {
+            OPM_THROW(std::invalid_argument, "No cell field " << name);
+        }
+        // the intensive quantities of all cells are stored in one array
+        return CellField(first, sizeof(intQuants), numCells);
+    }
 
-        return report;
+    /// Override the control of a well for the rest of the simulation, i.e.
+    /// until it is overridden again. The control of the given type of the well
+    /// in the schedule gets the target and becomes the current control.
+    /// \param[in] name     the name of the well
+    /// \param[in] type     the type of the control, e.g. BHP or SURFACE_RATE
+    /// \param[in] target   the target of the control in SI units, with the
+    ///                     signs of the controls of the Wells structure
+    /// \return             whether this process has the well and its control
+    bool setWellControl(const std::string& name, const WellControlType type, const double target)
+    {
+        wellControls_[name] = std::make_pair(type, target);
+        return wellModel_ && wellModel_->setWellControl(name, type, target);
     }
 
     /** \brief Returns the simulator report for the failed substeps of the simulation.
@@ -338,6 +442,166 @@ protected:
         return std::unique_ptr<Solver>(new Solver(solverParam_, std::move(model)));
     }
 
+    // Simulate the current report step of the timer and write its output, the
+    // body of the loop of run().
+    void runReportStep_(SimulatorTimer& timer)
+    {
+        WellModel& wellModel = *wellModel_;
+        const auto& events = schedule().getEvents();
+        SimulatorReport stepReport;
+        const int reportStep = timer.currentStepNum();
+        double outputTime = 0.0;
+
+        // Report timestep.
+        if (terminalOutput_ && DeferredLogger::debugEnabled()) {
+            std::ostringstream ss;
+            timer.report(ss);
+            OpmLog::debug(ss.str());
+        }
+
+        // Run a multiple steps of the solver depending on the time step control.
+        PerformanceTrace::beginReportStep(timer.currentStepNum());
+        ProfileScope reportStepScope("report step");
+
+        wellModel.beginReportStep(timer.currentStepNum());
+        // the controls set by setWellControl() replace those of the schedule
+        for (const auto& control : wellControls_) {
+            wellModel.setWellControl(control.first, control.second.first, control.second.second);
+        }
+
+        auto solver = createSolver(wellModel, *aquiferModel_);
+
+        // write the inital state at the report stage
+        if (timer.initialStep() && outputEnabled_) {
+            ProfileScope outputScope("output");
+
+            // No per cell data is written for initial step, but will be
+            // for subsequent steps, when we have started simulating
+            wellModel.wellState().updateReport(phaseUsage_, Opm::UgGridHelpers::globalCell(grid()), localWellData_);
+            ebosSimulator_.problem().writeOutput(localWellData_,
+                                                 timer.simulationTimeElapsed(),
+                                                 /*isSubstep=*/false,
+                                                 totalTimer_.secsSinceStart(),
+                                                 /*nextStepSize=*/-1.0);
+
+            outputTime = outputScope.stop();
+            report_.output_write_time += outputTime;
+        }
+
+        if (terminalOutput_) {
+            std::ostringstream stepMsg;
+            boost::posix_time::time_facet* facet = new boost::posix_time::time_facet("%d-%b-%Y");
+            stepMsg.imbue(std::locale(std::locale::classic(), facet));
+            stepMsg << "\nReport step " << std::setw(2) <<timer.currentStepNum()
+                     << "/" << timer.numSteps()
+                     << " at day " << (double)unit::convert::to(timer.simulationTimeElapsed(), unit::day)
+                     << "/" << (double)unit::convert::to(timer.totalTime(), unit::day)
+                     << ", date = " << timer.currentDateTime();
+            OpmLog::info(stepMsg.str());
+        }
+
+        solver->model().beginReportStep();
+
+        SimulatorReport stepFailureReport;
+
+        // If sub stepping is enabled allow the solver to sub cycle
+        // in case the report steps are too large for the solver to converge
+        //
+        // \Note: The report steps are met in any case
+        // \Note: The sub stepping will require a copy of the state variables
+        if (adaptiveTimeStepping_) {
+            if (useTUNING_) {
+                if (events.hasEvent(ScheduleEvents::TUNING_CHANGE,timer.currentStepNum())) {
+                    adaptiveTimeStepping_->updateTUNING(schedule().getTuning(), timer.currentStepNum());
+                }
+            }
+
+            bool event = events.hasEvent(ScheduleEvents::NEW_WELL, timer.currentStepNum()) ||
+                    events.hasEvent(ScheduleEvents::PRODUCTION_UPDATE, timer.currentStepNum()) ||
+                    events.hasEvent(ScheduleEvents::INJECTION_UPDATE, timer.currentStepNum()) ||
+                    events.hasEvent(ScheduleEvents::WELL_STATUS_CHANGE, timer.currentStepNum());
+            stepReport = adaptiveTimeStepping_->step(timer, *solver, event,
+                                                     fipnum_.empty() ? nullptr : &fipnum_);
+            stepFailureReport = adaptiveTimeStepping_->failureReport();
+            report_ += stepReport;
+            failureReport_ += stepFailureReport;
+        }
+        else {
+            // solve for complete report step
+            stepReport = solver->step(timer);
+            stepFailureReport = solver->failureReport();
+            report_ += stepReport;
+            failureReport_ += stepFailureReport;
+
+            if (terminalOutput_) {
+                std::ostringstream ss;
+                stepReport.reportStep(ss);
+                OpmLog::info(ss.str());
+            }
+        }
+
+        solver->model().endReportStep();
+        wellModel.endReportStep();
+
+        // take time that was used to solve system for this reportStep
+        const double solverTime = reportStepScope.stop();
+
+        if (imbalanceThreshold_ > 0.0) {
+            checkLoadImbalance_(stepReport, timer.currentStepNum(), imbalanceThreshold_);
+        }
+
+        // update timing.
+        report_.solver_time += solverTime;
+
+        KernelCounters::endReportStep(timer.currentStepNum());
+        if (memoryReport_) {
+            MemoryAccounting::report("Memory at the end of report step "
+                                     + std::to_string(timer.currentStepNum()), false);
+        }
+
+        // Increment timer, remember well state.
+        ++timer;
+
+
+        if (terminalOutput_ && outputEnabled_) {
+            if (!timer.initialStep()) {
+                const std::string version = moduleVersionName();
+                outputTimestampFIP(timer, version);
+            }
+        }
+
+        // write simulation state at the report stage
+        ProfileScope outputScope("output");
+        const double nextstep = adaptiveTimeStepping_ ? adaptiveTimeStepping_->suggestedNextStep() : -1.0;
+
+        if (outputEnabled_) {
+            wellModel.wellState().updateReport(phaseUsage_, Opm::UgGridHelpers::globalCell(grid()), localWellData_);
+            ebosSimulator_.problem().writeOutput(localWellData_,
+                                                 timer.simulationTimeElapsed(),
+                                                 /*isSubstep=*/false,
+                                                 totalTimer_.secsSinceStart(),
+                                                 nextstep);
+            flowDiagnostics_->compute(timer.currentStepNum(), timer.simulationTimeElapsed(), wellModel.wells());
+        }
+        const double finalOutputTime = outputScope.stop();
+        report_.output_write_time += finalOutputTime;
+        if (!profileSummaryFile_.empty()) {
+            runProfile_.addReportStep(reportStep, solverTime + finalOutputTime,
+                                      outputTime + finalOutputTime, stepReport, stepFailureReport);
+        }
+
+        if (!snapshotFile_.empty() && !timer.done() && timer.currentStepNum() % snapshotInterval_ == 0) {
+            writeSnapshot_(snapshotFile_, timer, wellModel, adaptiveTimeStepping_.get());
+        }
+
+        if (terminalOutput_ && DeferredLogger::debugEnabled()) {
+            std::string msg =
+                "Time step took " + std::to_string(solverTime) + " seconds; "
+                "total solver time " + std::to_string(report_.solver_time) + " seconds.";
+            OpmLog::debug(msg);
+        }
+    }
+
     void outputTimestampFIP(const SimulatorTimer& timer, const std::string version)
     {
         std::ostringstream ss;
@@ -365,6 +629,167 @@ protected:
         return initconfig.restartRequested();
     }
 
+    // Compare the assembly and linear solve time of the report step over all
+    // processes and warn if the slowest process exceeds the average by more
+    // than the given factor.
+    double checkLoadImbalance_(const SimulatorReport& stepReport,
+                               const int reportStep,
+                               const double threshold) const
+    {
+        const auto& comm = grid().comm();
+        const double localTime = stepReport.assemble_time + stepReport.linear_solve_time;
+        const double maxTime = comm.max(localTime);
+        const double averageTime = comm.sum(localTime) / comm.size();
+        const double imbalance = averageTime > 0.0 ? maxTime / averageTime : 1.0;
+
+        if (terminalOutput_) {
+            std::ostringstream msg;
+            msg << "Load imbalance (max/average of assembly and linear solve time) of report step "
+                << reportStep << ": " << imbalance;
+            if (imbalance > threshold) {
+                msg << " exceeds " << threshold << ", consider a different partitioning";
+                OpmLog::warning("Load imbalance", msg.str());
+            }
+            else {
+                OpmLog::debug(msg.str());
+            }
+        }
+        return imbalance;
+    }
+
+    // Write the state at the beginning of the current report step of the timer
+    // such that the run can be resumed from it. Every process writes its own
+    // file, the snapshot holds the cartesian indices of the cells of the
+    // process, the primary variables of the reservoir, the well state and the
+    // state of the time stepping.
+    void writeSnapshot_(const std::string& prefix,
+                        const SimulatorTimer& timer,
+                        const WellModel& wellModel,
+                        const AdaptiveTimeSteppingEbos* adaptiveTimeStepping) const
+    {
+        const int numEq = PrimaryVariables::dimension;
+        const auto& solution = ebosSimulator_.model().solution(/*timeIdx=*/0);
+
+        SnapshotWriter writer(SimulatorSnapshot::fileName(prefix, grid().comm().rank()));
+        writer.write(timer.currentStepNum());
+        writer.write(timer.simulationTimeElapsed());
+        writer.write(cartesianCells_());
+
+        std::vector<double> values;
+        std::vector<int> meanings;
+        values.reserve(solution.size() * numEq);
+        meanings.reserve(solution.size());
+        for (const auto& priVars : solution) {
+            for (int eqIdx = 0; eqIdx < numEq; ++eqIdx) {
+                values.push_back(priVars[eqIdx]);
+            }
+            meanings.push_back(static_cast<int>(priVars.primaryVarsMeaning()));
+        }
+        writer.write(values);
+        writer.write(meanings);
+
+        wellModel.writeSnapshot(writer);
+
+        writer.write(adaptiveTimeStepping ? adaptiveTimeStepping->snapshotState() : std::vector<double>());
+
+        if (terminalOutput_) {
+            OpmLog::debug("Wrote the snapshot " + prefix + " at report step " + std::to_string(timer.currentStepNum()));
+        }
+    }
+
+    // Restore the state written by writeSnapshot_(), the simulation continues at
+    // the report step of the snapshot.
+    void readSnapshot_(const std::string& prefix,
+                       SimulatorTimer& timer,
+                       WellModel& wellModel,
+                       AdaptiveTimeSteppingEbos* adaptiveTimeStepping)
+    {
+        const int numEq = PrimaryVariables::dimension;
+        auto& model = ebosSimulator_.model();
+
+        SnapshotReader reader(SimulatorSnapshot::fileName(prefix, grid().comm().rank()));
+        int step = 0;
+        double time = 0.0;
+        reader.read(step);
+        reader.read(time);
+        timer.setCurrentStepNum(step);
+        if (std::abs(timer.simulationTimeElapsed() - time) > 1e-6 * std::max(time, 1.0)) {
+            OPM_THROW(std::runtime_error, "The snapshot " << prefix << " at report step " << step
+                      << " does not match the schedule of the deck");
+        }
+
+        // the cells of this process must be those of the process that wrote the
+        // file, such that every process only reads its own part of the state
+        std::vector<int> cells;
+        reader.read(cells);
+        if (cells != cartesianCells_()) {
+            OPM_THROW(std::runtime_error, "The snapshot " << prefix << " was written with a different distribution"
+                      " of the cells, resume on the same number of processes with the same load balancing");
+        }
+
+        std::vector<double> values;
+        std::vector<int> meanings;
+        reader.read(values);
+        reader.read(meanings);
+        const std::size_t numDof = model.solution(/*timeIdx=*/0).size();
+        if (meanings.size() != numDof || values.size() != numDof * numEq) {
+            OPM_THROW(std::runtime_error, "The snapshot " << prefix << " has " << meanings.size()
+                      << " degrees of freedom, expected " << numDof);
+        }
+        for (int timeIdx = 0; timeIdx < 2; ++timeIdx) {
+            auto& solution = model.solution(timeIdx);
+            for (std::size_t dofIdx = 0; dofIdx < numDof; ++dofIdx) {
+                auto& priVars = solution[dofIdx];
+                for (int eqIdx = 0; eqIdx < numEq; ++eqIdx) {
+                    priVars[eqIdx] = values[dofIdx * numEq + eqIdx];
+                }
+                priVars.setPrimaryVarsMeaning(static_cast<typename PrimaryVariables::PrimaryVarsMeaning>(meanings[dofIdx]));
+            }
+        }
+        model.invalidateIntensiveQuantitiesCache(/*timeIdx=*/0);
+        model.invalidateIntensiveQuantitiesCache(/*timeIdx=*/1);
+
+        wellModel.initFromSnapshot(reader, step);
+
+        std::vector<double> timeSteppingState;
+        reader.read(timeSteppingState);
+        if (adaptiveTimeStepping && !timeSteppingState.empty()) {
+            adaptiveTimeStepping->setSnapshotState(timeSteppingState);
+        }
+
+        if (terminalOutput_) {
+            OpmLog::info("Resuming from the snapshot " + prefix + " at report step " + std::to_string(step));
+        }
+    }
+
+    // The cartesian indices of the cells of this process in their local order.
+    std::vector<int> cartesianCells_() const
+    {
+        const int numCells = Opm::UgGridHelpers::numCells(grid());
+        const int* globalCell = Opm::UgGridHelpers::globalCell(grid());
+        std::vector<int> cells(numCells);
+        for (int cellIdx = 0; cellIdx < numCells; ++cellIdx) {
+            cells[cellIdx] = globalCell ? globalCell[cellIdx] : cellIdx;
+        }
+        return cells;
+    }
+
+    // The FIPNUM regions of the cells of this process, empty if the deck
+    // has no FIPNUM.
+    std::vector<int> fipnumOfCells_() const
+    {
+        const auto& props = eclState().get3DProperties();
+        if (!props.hasDeckIntGridProperty("FIPNUM")) {
+            return std::vector<int>();
+        }
+        const std::vector<int>& fipnumGlobal = props.getIntGridProperty("FIPNUM").getData();
+        std::vector<int> fipnum = cartesianCells_();
+        for (int& cell : fipnum) {
+            cell = fipnumGlobal[cell];
+        }
+        return fipnum;
+    }
+
     // Data.
     Simulator& ebosSimulator_;
 
@@ -382,6 +807,33 @@ protected:
     PhaseUsage phaseUsage_;
     // Misc. data
     bool       terminalOutput_;
+
+    // The state of the simulation between init() and finalize().
+    std::unique_ptr<WellModel> wellModel_;
+    std::unique_ptr<AquiferModel> aquiferModel_;
+    std::unique_ptr<AdaptiveTimeSteppingEbos> adaptiveTimeStepping_;
+    std::unique_ptr<FlowDiagnostics> flowDiagnostics_;
+    // the well data of the output, refreshed in place at every report step
+    data::Wells localWellData_;
+    SimulatorReport report_;
+    Opm::time::StopWatch totalTimer_;
+    bool useTUNING_ = false;
+    bool memoryReport_ = false;
+    bool timerReport_ = false;
+    std::string timerReportFile_;
+    std::string traceFile_;
+    RunProfile runProfile_;
+    // the FIPNUM regions of the cells, for the fluid in place of the substeps
+    std::vector<int> fipnum_;
+    std::string profileSummaryFile_;
+    int profileSummarySteps_ = 10;
+    std::string snapshotFile_;
+    int snapshotInterval_ = 1;
+    double imbalanceThreshold_ = 0.0;
+    bool outputEnabled_ = true;
+    bool intensiveQuantitiesUpToDate_ = false;
+    // the controls set by setWellControl() by well name
+    std::map<std::string, std::pair<WellControlType, double>> wellControls_;
 };
 
 } // namespace Opm
@@ -62,14 +62,16 @@ namespace Opm
     void outputStateVtk(const UnstructuredGrid& grid,
                         const SimulationDataContainer& state,
                         const int step,
-                        const std::string& output_dir)
+                        const std::string& output_dir,
+                        const VtkFormat format)
     {
         // Write data in VTK format.
         std::ostringstream vtkfilename;
         vtkfilename << output_dir << "/vtk_files";
         ensureDirectoryExists(vtkfilename.str());
         vtkfilename << "/output-" << std::setw(3) << std::setfill('0') << step << ".vtu";
-        std::ofstream vtkfile(vtkfilename.str().c_str());
+        const auto mode = format == VtkFormat::Ascii ? std::ios::out : std::ios::out | std::ios::binary;
+        std::ofstream vtkfile(vtkfilename.str().c_str(), mode);
         if (!vtkfile) {
             OPM_THROW(std::runtime_error, "Failed to open " << vtkfilename.str());
         }
@@ -86,7 +88,7 @@ namespace Opm
                                   AutoDiffGrid::dimensions(grid),
                                   state.faceflux(), cell_velocity);
         dm["velocity"] = &cell_velocity;
-        Opm::writeVtkData(grid, dm, vtkfile);
+        Opm::writeVtkData(grid, dm, vtkfile, format);
     }
 
     void outputWellStateMatlab(const Opm::WellState& well_state,
@@ -143,7 +145,8 @@ namespace Opm
     void outputStateVtk(const Dune::CpGrid& grid,
                         const Opm::SimulationDataContainer& state,
                         const int step,
-                        const std::string& output_dir)
+                        const std::string& output_dir,
+                        const VtkFormat format)
     {
         // Write data in VTK format.
         std::ostringstream vtkfilename;
@@ -166,7 +169,9 @@ namespace Opm
                                   AutoDiffGrid::dimensions(grid),
                                   state.faceflux(), cell_velocity);
         writer.addCellData(cell_velocity, "velocity", Dune::CpGrid::dimension);
-        writer.pwrite(vtkfilename.str(), vtkpath.str(), std::string("."), Dune::VTK::ascii);
+        // every process writes its own piece, referenced by the .pvtu file
+        const auto outputType = format == VtkFormat::Ascii ? Dune::VTK::ascii : Dune::VTK::appendedraw;
+        writer.pwrite(vtkfilename.str(), vtkpath.str(), std::string("."), outputType);
     }
 #endif
 
@@ -179,6 +184,8 @@ namespace Opm
         {
             BlackoilOutputWriter& writer_;
             std::unique_ptr< SimulatorTimerInterface > timer_;
+            // only the matlab writer reads the reservoir state,
+            // otherwise an empty container is passed on
             const SimulationDataContainer state_;
             const WellStateFullyImplicitBlackoil wellState_;
             data::Solution simProps_;
@@ -193,10 +200,11 @@ namespace Opm
                                  const data::Solution& simProps,
                                  const std::map<std::string, double>& miscSummaryData,
                                  const RestartValue::ExtraVector& extraRestartData,
-                                 bool substep)
+                                 bool substep,
+                                 bool needState)
                 : writer_( writer ),
                   timer_( timer.clone() ),
-                  state_( state ),
+                  state_( needState ? state : SimulationDataContainer( 0, 0, state.numPhases() ) ),
                   wellState_( wellState ),
                   simProps_( simProps ),
                   miscSummaryData_( miscSummaryData ),
@@ -266,10 +274,25 @@ namespace Opm
             // contain well ..." might be thrown.
             int wellStateStepNumber = ( ! substep && timer.reportStepNum() > 0) ?
                 (timer.reportStepNum() - 1) : timer.reportStepNum();
-            // collect all solutions to I/O rank
-            isIORank = parallelOutput_->collectToIORank( localState, localWellState,
-                                                         localCellData,
-                                                         wellStateStepNumber );
+            if( collectiveOutput_ )
+            {
+                // every process writes its cells, only the wells are collected
+                std::ostringstream filename;
+                filename << outputDir_ << "/" << eclipseState_.getIOConfig().getBaseName()
+                         << "_" << std::setw(4) << std::setfill('0') << timer.reportStepNum()
+                         << (substep ? "_substep" : "") << ".cells";
+                parallelOutput_->writeCellDataCollective( localCellData, filename.str() );
+                isIORank = parallelOutput_->collectToIORank( localState, localWellState,
+                                                             data::Solution(),
+                                                             wellStateStepNumber );
+            }
+            else
+            {
+                // collect all solutions to I/O rank
+                isIORank = parallelOutput_->collectToIORank( localState, localWellState,
+                                                             localCellData,
+                                                             wellStateStepNumber );
+            }
             // Note that at this point the extraData are assumed to be global, i.e. identical across all processes.
         }
 
@@ -284,7 +307,8 @@ namespace Opm
         {
             if( asyncOutput_ ) {
                 // dispatch the write call to the extra thread
-                asyncOutput_->dispatch( detail::WriterCall( *this, timer, state, wellState, cellData, miscSummaryData, extraRestartData, substep ) );
+                asyncOutput_->dispatch( detail::WriterCall( *this, timer, state, wellState, cellData, miscSummaryData, extraRestartData, substep,
+                                                            bool(matlabWriter_) ) );
             }
             else {
                 // just write the data to disk
@@ -328,6 +352,12 @@ namespace Opm
             matlabWriter_->writeTimeStep( timer, state, wellState, substep );
         }
 
+        // Streaming summary output
+        if( summaryStream_ ) {
+            summaryStream_->writeTimeStep( timer.simulationTimeElapsed(), timer.reportStepNum(),
+                                           wellState, miscSummaryData );
+        }
+
         // ECL output
         if ( eclIO_ )
         {
@@ -358,6 +388,21 @@ namespace Opm
     }
 
 
+    BlackoilOutputWriter::~BlackoilOutputWriter()
+    {
+        if( asyncOutput_ ) {
+            const auto stats = asyncOutput_->statistics();
+            if( stats.dispatchWaitTime > 0.0 ) {
+                std::ostringstream ss;
+                ss << "Async output: " << stats.dispatched << " snapshots, at most "
+                   << stats.maxObjectsInFlight << " pending, the simulator waited "
+                   << stats.dispatchWaitTime << " seconds for the output thread";
+                OpmLog::debug(ss.str());
+            }
+        }
+    }
+
+
     bool BlackoilOutputWriter::isRestart() const {
         const auto& initconfig = eclipseState_.getInitConfig();
         return initconfig.restartRequested();
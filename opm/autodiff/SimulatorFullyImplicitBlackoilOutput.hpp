@@ -38,6 +38,7 @@
 
 #include <opm/autodiff/GridHelpers.hpp>
 #include <opm/autodiff/ParallelDebugOutput.hpp>
+#include <opm/autodiff/SummaryStreamWriter.hpp>
 
 #include <opm/autodiff/WellStateFullyImplicitBlackoil.hpp>
 #include <opm/autodiff/ThreadHandle.hpp>
@@ -47,7 +48,10 @@
 #include <opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
 #include <opm/parser/eclipse/EclipseState/InitConfig/InitConfig.hpp>
 #include <opm/simulators/ensureDirectoryExists.hpp>
+#include <opm/simulators/vtk/writeVtkData.hpp>
 
+#include <algorithm>
+#include <set>
 #include <string>
 #include <sstream>
 #include <iomanip>
@@ -69,7 +73,8 @@ namespace Opm
     void outputStateVtk(const UnstructuredGrid& grid,
                         const Opm::SimulationDataContainer& state,
                         const int step,
-                        const std::string& output_dir);
+                        const std::string& output_dir,
+                        const VtkFormat format = VtkFormat::Ascii);
 
     void outputWellStateMatlab(const Opm::WellState& well_state,
                                const int step,
@@ -78,7 +83,8 @@ namespace Opm
     void outputStateVtk(const Dune::CpGrid& grid,
                         const Opm::SimulationDataContainer& state,
                         const int step,
-                        const std::string& output_dir);
+                        const std::string& output_dir,
+                        const VtkFormat format = VtkFormat::Ascii);
 #endif
 
     template<class Grid>
@@ -143,6 +149,8 @@ namespace Opm
                 : outputDir_( outputDir )
         {}
 
+        virtual ~BlackoilSubWriter() {}
+
         virtual void writeTimeStep(const SimulatorTimerInterface& timer,
                            const SimulationDataContainer& state,
                            const WellStateFullyImplicitBlackoil&,
@@ -154,10 +162,19 @@ namespace Opm
     template< class Grid >
     class BlackoilVTKWriter : public BlackoilSubWriter {
         public:
+            /// \param asyncThreads  if positive, every process writes its files from
+            ///                      this many separate threads, using a copy of
+            ///                      the state. The files of the steps are
+            ///                      independent, so they may be written
+            ///                      concurrently.
             BlackoilVTKWriter( const Grid& grid,
-                               const std::string& outputDir )
+                               const std::string& outputDir,
+                               const VtkFormat format = VtkFormat::Ascii,
+                               const int asyncThreads = 0 )
                 : BlackoilSubWriter( outputDir )
                 , grid_( grid )
+                , format_( format )
+                , asyncOutput_( asyncThreads > 0 ? new ThreadHandle( true, 2 * asyncThreads, asyncThreads ) : nullptr )
         {}
 
             void writeTimeStep(const SimulatorTimerInterface& timer,
@@ -165,11 +182,51 @@ namespace Opm
                     const WellStateFullyImplicitBlackoil&,
                     bool /*substep*/ = false) override
             {
-                outputStateVtk(grid_, state, timer.currentStepNum(), outputDir_);
+                if( asyncOutput_ ) {
+                    asyncOutput_->dispatch( WriterCall( *this, state, timer.currentStepNum() ) );
+                }
+                else {
+                    outputStateVtk(grid_, state, timer.currentStepNum(), outputDir_, format_);
+                }
             }
 
         protected:
+            struct WriterCall
+            {
+                const BlackoilVTKWriter& writer_;
+                SimulationDataContainer state_;
+                const int step_;
+
+                // only the fields that are written are copied
+                WriterCall( const BlackoilVTKWriter& writer,
+                            const SimulationDataContainer& state,
+                            const int step )
+                    : writer_( writer ),
+                      state_( state.numCells(), state.numFaces(), state.numPhases() ),
+                      step_( step )
+                {
+                    state_.pressure() = state.pressure();
+                    state_.saturation() = state.saturation();
+                    state_.faceflux() = state.faceflux();
+                }
+
+                void run()
+                {
+                    // an exception must not leave the output thread
+                    try {
+                        outputStateVtk(writer_.grid_, state_, step_, writer_.outputDir_, writer_.format_);
+                    }
+                    catch (const std::exception& e) {
+                        OpmLog::error("VTK output of step " + std::to_string(step_) + " failed: " + e.what());
+                    }
+                }
+            };
+
             const Grid& grid_;
+            const VtkFormat format_;
+            // declared last, so that the pending output is written
+            // before the other members are destroyed
+            std::unique_ptr< ThreadHandle > asyncOutput_;
     };
 
     template< typename Grid >
@@ -218,6 +275,9 @@ namespace Opm
                              std::unique_ptr<EclipseIO>&& eclIO,
                              const Opm::PhaseUsage &phaseUsage);
 
+        // reports how often the solver waited for the async output
+        ~BlackoilOutputWriter();
+
         /** \copydoc Opm::OutputWriter::writeInit */
         void writeInit(const data::Solution& simProps, const NNC& nnc);
 
@@ -307,11 +367,18 @@ namespace Opm
         // Parameters for output.
         const std::string outputDir_;
         const bool restart_double_si_;
+        // write the cell data of parallel runs collectively instead of
+        // gathering it on the I/O rank
+        const bool collectiveOutput_;
+        // auxiliary restart fields (e.g. WAT_VISC) that are not written,
+        // in addition to those disabled by RPTRST
+        std::set<std::string> restartSkipFields_;
 
         Opm::PhaseUsage phaseUsage_;
         std::unique_ptr< BlackoilSubWriter > vtkWriter_;
         std::unique_ptr< BlackoilSubWriter > matlabWriter_;
         std::unique_ptr< EclipseIO > eclIO_;
+        std::unique_ptr< SummaryStreamWriter > summaryStream_;
         const EclipseState& eclipseState_;
         const Schedule& schedule_;
         const SummaryConfig& summaryConfig_;
@@ -345,6 +412,7 @@ namespace Opm
         parallelOutput_( output_ ? new ParallelDebugOutput< Grid >( grid, eclipseState, schedule, phaseUsage.num_phases, phaseUsage ) : 0 ),
         outputDir_( eclipseState.getIOConfig().getOutputDir() ),
         restart_double_si_( output_ ? param.getDefault("restart_double_si", false) : false ),
+        collectiveOutput_( output_ ? param.getDefault("collective_output", false) : false ),
         phaseUsage_( phaseUsage ),
         eclipseState_(eclipseState),
         schedule_(schedule),
@@ -355,10 +423,42 @@ namespace Opm
         // For output.
         if ( output_ )
         {
+            {
+                std::string skipFields = param.getDefault("restart_skip_fields", std::string(""));
+                std::replace(skipFields.begin(), skipFields.end(), ',', ' ');
+                std::istringstream skipStream(skipFields);
+                std::string field;
+                while ( skipStream >> field ) {
+                    restartSkipFields_.insert(field);
+                }
+            }
+
             if ( param.getDefault("output_vtk",false) )
             {
+                const std::string vtkFormat = param.getDefault("output_vtk_format", std::string("ascii"));
+                if ( vtkFormat != "ascii" && vtkFormat != "appendedraw" )
+                {
+                    OPM_THROW(std::runtime_error, "Unknown output_vtk_format " << vtkFormat
+                              << ", use ascii or appendedraw");
+                }
+                // async VTK output is off by default and needs pthreads.
+                // The parallel writer may communicate, which must stay on the
+                // main thread.
+#if HAVE_PTHREAD
+                const bool asyncVtkOutput = param.getDefault("async_vtk_output", false)
+                    && !parallelOutput_->isParallel();
+                const int asyncVtkThreads = asyncVtkOutput ? param.getDefault("async_vtk_output_threads", int(1)) : 0;
+#else
+                if ( param.getDefault("async_vtk_output", false) )
+                {
+                    OPM_THROW(std::runtime_error,"Pthreads were not found, cannot enable async_vtk_output");
+                }
+                const int asyncVtkThreads = 0;
+#endif
                 vtkWriter_
-                    .reset(new BlackoilVTKWriter< Grid >( grid, outputDir_ ));
+                    .reset(new BlackoilVTKWriter< Grid >( grid, outputDir_,
+                                                          vtkFormat == "ascii" ? VtkFormat::Ascii : VtkFormat::AppendedRaw,
+                                                          asyncVtkThreads ));
             }
 
             auto output_matlab = param.getDefault("output_matlab", false );
@@ -381,6 +481,18 @@ namespace Opm
 
                 // Ensure that output dir exists
                 ensureDirectoryExists(outputDir_);
+
+                if ( param.getDefault("output_summary_stream", false) )
+                {
+                    std::vector<std::string> wellNames;
+                    for (const auto well : schedule.getWells()) {
+                        wellNames.push_back(well->name());
+                    }
+                    const std::string filename = outputDir_ + "/"
+                        + eclipseState.getIOConfig().getBaseName() + ".SUMSTREAM";
+                    summaryStream_.reset(new SummaryStreamWriter(filename, wellNames, phaseUsage,
+                                                                 { "TCPU" }));
+                }
             }
 
             // create output thread if enabled and rank is I/O rank
@@ -394,7 +506,9 @@ namespace Opm
             {
                 const bool isIORank = parallelOutput_ ? parallelOutput_->isIORank() : true;
 #if HAVE_PTHREAD
-                asyncOutput_.reset( new ThreadHandle( isIORank ) );
+                // the number of snapshots of the state that may wait for being written
+                const int maxSnapshots = param.getDefault("async_output_max_snapshots", int(2));
+                asyncOutput_.reset( new ThreadHandle( isIORank, maxSnapshots ) );
 #else
                 OPM_THROW(std::runtime_error,"Pthreads were not found, cannot enable async_output");
 #endif
@@ -983,6 +1097,28 @@ namespace Opm
             }
         }
 
+
+
+
+        /**
+         * Removes the auxiliary restart fields whose names are in skipFields.
+         * The solution fields needed to restart and the summary data are
+         * always kept.
+         */
+        inline void removeSkippedRestartFields(data::Solution& output,
+                                               const std::set<std::string>& skipFields)
+        {
+            for (auto it = output.begin(); it != output.end(); ) {
+                if (it->second.target == data::TargetType::RESTART_AUXILIARY
+                    && skipFields.count(it->first) > 0) {
+                    it = output.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+        }
+
     }
 
 
@@ -1016,13 +1152,18 @@ namespace Opm
                 SimulationDataContainer sd =
                     detail::convertToSimulationDataContainer( physicalModel.getSimulatorData(localState), localState, phaseUsage_ );
 
-                localCellData = simToSolution( sd, restart_double_si_, phaseUsage_); // Get "normal" data (SWAT, PRESSURE, ...);
+                // the restart data below does not use the fields moved out of sd here
+                localCellData = simToSolution( std::move(sd), restart_double_si_, phaseUsage_); // Get "normal" data (SWAT, PRESSURE, ...);
 
                 detail::getRestartData( localCellData, std::move(sd), phaseUsage_, physicalModel,
                                         restartConfig, reportStepNum, logMessages );
                 // sd will be invalid after getRestartData has been called
             }
             detail::getSummaryData( localCellData, phaseUsage_, physicalModel, summaryConfig_ );
+            // drop the unwanted fields before they are gathered and written
+            if( !restartSkipFields_.empty() ) {
+                detail::removeSkippedRestartFields( localCellData, restartSkipFields_ );
+            }
             assert(!localCellData.empty());
 
             // Add suggested next timestep to extra data.
@@ -0,0 +1,166 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_SIMULATORSNAPSHOT_HEADER_INCLUDED
+#define OPM_SIMULATORSNAPSHOT_HEADER_INCLUDED
+
+#include <opm/common/ErrorMacros.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Opm
+{
+
+    namespace SimulatorSnapshot
+    {
+        // identifies the files and the version of their layout
+        const char magic[8] = { 'O', 'P', 'M', 'S', 'N', 'A', 'P', '2' };
+
+        /// \brief The file of the snapshot of one process.
+        inline std::string fileName(const std::string& prefix, const int rank)
+        {
+            return prefix + "." + std::to_string(rank);
+        }
+    } // namespace SimulatorSnapshot
+
+    /// \brief Writes the binary snapshot of the simulation on one process.
+    ///
+    /// Values and arrays are written bitwise, arrays preceded by their size,
+    /// such that a snapshot is only meant to be read by the same build of the
+    /// simulator on the same number of processes.
+    class SnapshotWriter
+    {
+    public:
+        explicit SnapshotWriter(const std::string& filename)
+            : filename_(filename),
+              out_(filename, std::ios::binary | std::ios::trunc)
+        {
+            out_.write(SimulatorSnapshot::magic, sizeof(SimulatorSnapshot::magic));
+            check();
+        }
+
+        template<class T>
+        void write(const T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "only plain values can be written bitwise");
+            out_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+            check();
+        }
+
+        template<class T>
+        void write(const std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "only plain values can be written bitwise");
+            write(std::uint64_t(values.size()));
+            out_.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+            check();
+        }
+
+        void write(const std::vector<bool>& values)
+        {
+            write(std::vector<char>(values.begin(), values.end()));
+        }
+
+    private:
+        void check()
+        {
+            if (!out_) {
+                OPM_THROW(std::runtime_error, "Could not write the snapshot file " << filename_);
+            }
+        }
+
+        std::string filename_;
+        std::ofstream out_;
+    };
+
+    /// \brief Reads the binary snapshot written by SnapshotWriter.
+    class SnapshotReader
+    {
+    public:
+        explicit SnapshotReader(const std::string& filename)
+            : filename_(filename),
+              in_(filename, std::ios::binary)
+        {
+            char magic[sizeof(SimulatorSnapshot::magic)];
+            in_.read(magic, sizeof(magic));
+            check();
+            if (std::memcmp(magic, SimulatorSnapshot::magic, sizeof(magic)) != 0) {
+                OPM_THROW(std::runtime_error, "The file " << filename_ << " is not a snapshot of this version");
+            }
+        }
+
+        template<class T>
+        void read(T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "only plain values can be read bitwise");
+            in_.read(reinterpret_cast<char*>(&value), sizeof(T));
+            check();
+        }
+
+        template<class T>
+        void read(std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "only plain values can be read bitwise");
+            std::uint64_t size = 0;
+            read(size);
+            values.resize(size);
+            in_.read(reinterpret_cast<char*>(values.data()), size * sizeof(T));
+            check();
+        }
+
+        void read(std::vector<bool>& values)
+        {
+            std::vector<char> chars;
+            read(chars);
+            values.assign(chars.begin(), chars.end());
+        }
+
+        /// \brief Read an array that is expected to have the size of values.
+        template<class T>
+        void readSameSize(std::vector<T>& values, const char* name)
+        {
+            const std::size_t size = values.size();
+            read(values);
+            if (values.size() != size) {
+                OPM_THROW(std::runtime_error, "The size of " << name << " in the snapshot file " << filename_
+                          << " is " << values.size() << ", expected " << size);
+            }
+        }
+
+    private:
+        void check()
+        {
+            if (!in_) {
+                OPM_THROW(std::runtime_error, "Could not read the snapshot file " << filename_);
+            }
+        }
+
+        std::string filename_;
+        std::ifstream in_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_SIMULATORSNAPSHOT_HEADER_INCLUDED
@@ -0,0 +1,149 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_SPARSITYPATTERN_HEADER_INCLUDED
+#define OPM_SPARSITYPATTERN_HEADER_INCLUDED
+
+#include <cstddef>
+#include <vector>
+
+namespace Opm
+{
+namespace detail
+{
+
+    /// \brief Whether two sparse matrices have the same sparsity pattern.
+    ///
+    /// The sizes of all rows and the column indices of all entries are
+    /// compared, matrices with the same number of rows and nonzeroes might
+    /// still have their entries in different columns.
+    template<class M1, class M2>
+    bool samePattern(const M1& a, const M2& b)
+    {
+        if ( static_cast<const void*>(&a) == static_cast<const void*>(&b) )
+        {
+            return true;
+        }
+        if ( a.N() != b.N() || a.M() != b.M() || a.nonzeroes() != b.nonzeroes() )
+        {
+            return false;
+        }
+        auto rowB = b.begin();
+        for ( auto rowA = a.begin(); rowA != a.end(); ++rowA, ++rowB )
+        {
+            if ( rowA->size() != rowB->size() )
+            {
+                return false;
+            }
+            auto colB = rowB->begin();
+            for ( auto colA = rowA->begin(); colA != rowA->end(); ++colA, ++colB )
+            {
+                if ( colA.index() != colB.index() )
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /// \brief A copy of the sparsity pattern of a matrix.
+    ///
+    /// Used to detect a change of the pattern when the matrix itself is
+    /// refilled in place, such that it cannot be compared with samePattern().
+    class SparsityPattern
+    {
+    public:
+        /// \brief Store the pattern of a matrix.
+        template<class M>
+        void assign(const M& matrix)
+        {
+            rowSizes_.clear();
+            columns_.clear();
+            rowSizes_.reserve(matrix.N());
+            columns_.reserve(matrix.nonzeroes());
+            for ( auto row = matrix.begin(); row != matrix.end(); ++row )
+            {
+                rowSizes_.push_back(row->size());
+                for ( auto col = row->begin(); col != row->end(); ++col )
+                {
+                    columns_.push_back(col.index());
+                }
+            }
+            cols_ = matrix.M();
+        }
+
+        /// \brief Whether the matrix has the stored pattern.
+        template<class M>
+        bool matches(const M& matrix) const
+        {
+            if ( empty() || rowSizes_.size() != matrix.N() || cols_ != matrix.M() ||
+                 columns_.size() != matrix.nonzeroes() )
+            {
+                return false;
+            }
+            auto size = rowSizes_.begin();
+            auto column = columns_.begin();
+            for ( auto row = matrix.begin(); row != matrix.end(); ++row, ++size )
+            {
+                if ( row->size() != *size )
+                {
+                    return false;
+                }
+                for ( auto col = row->begin(); col != row->end(); ++col, ++column )
+                {
+                    if ( col.index() != *column )
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        /// \brief Forget the pattern, no matrix matches afterwards.
+        void clear()
+        {
+            rowSizes_.clear();
+            columns_.clear();
+            cols_ = 0;
+        }
+
+        /// \brief The bytes allocated for the stored pattern.
+        std::size_t bytes() const
+        {
+            return ( rowSizes_.capacity() + columns_.capacity() ) * sizeof( std::size_t );
+        }
+
+        /// \brief Whether no pattern is stored.
+        bool empty() const
+        {
+            return rowSizes_.empty();
+        }
+
+    private:
+        std::vector<std::size_t> rowSizes_;
+        std::vector<std::size_t> columns_;
+        std::size_t cols_ = 0;
+    };
+
+} // namespace detail
+} // namespace Opm
+
+#endif // OPM_SPARSITYPATTERN_HEADER_INCLUDED
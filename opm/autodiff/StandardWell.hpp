@@ -27,6 +27,10 @@
 #include <opm/autodiff/WellInterface.hpp>
 #include <opm/autodiff/ISTLSolver.hpp>
 #include <opm/autodiff/RateConverter.hpp>
+#include <opm/autodiff/StandardWellMatrices.hpp>
+
+#include <cassert>
+#include <limits>
 
 namespace Opm
 {
@@ -85,6 +89,10 @@ namespace Opm
         // TODO: we should have indices for the well equations and well primary variables separately
         static const int Bhp = numWellEq - numWellControlEq;
 
+        // number of the fluid phases, which for the two phase models tells at compile
+        // time which phases are active, see phaseIsActive()
+        static const int numWellPhases = numWellConservationEq - (has_solvent ? 1 : 0);
+
         using typename Base::Scalar;
         using typename Base::ConvergenceReport;
 
@@ -117,6 +125,9 @@ namespace Opm
 
         typedef DenseAd::Evaluation<double, /*size=*/numEq + numWellEq> EvalWell;
 
+        // the matrices B, C and D^-1 of all the standard wells of the well model
+        typedef StandardWellMatrices<Scalar, numWellEq, numEq> WellMatrices;
+
         using Base::contiSolventEqIdx;
         using Base::contiPolymerEqIdx;
         static const int contiEnergyEqIdx = Indices::contiEnergyEqIdx;
@@ -128,7 +139,7 @@ namespace Opm
                      const int num_components);
 
         virtual void init(const PhaseUsage* phase_usage_arg,
-                          const std::vector<double>& depth_arg,
+                          const CompactStaticArray& depth_arg,
                           const double gravity_arg,
                           const int num_cells);
 
@@ -152,6 +163,11 @@ namespace Opm
         /// r = r - C D^-1 Rw
         virtual void apply(BVector& r) const;
 
+        /// append duneB_, duneC_ and invDuneD_ to the matrices
+        /// used for applying all the standard wells at once.
+        /// nothing is added if the contributions are already in the Jacobian.
+        void addToWellMatrices(WellMatrices& matrices) const;
+
         /// using the solution x to recover the solution xw for wells and applying
         /// xw to update Well State
         virtual void recoverWellSolutionAndUpdateWellState(const BVector& x,
@@ -171,6 +187,8 @@ namespace Opm
 
         virtual void  addWellContributions(Mat& mat) const;
 
+        virtual bool addReservoirResidual(const Simulator& ebosSimulator, BVector& r) const;
+
         /// \brief Wether the Jacobian will also have well contributions in it.
         virtual bool jacobianContainsWellContributions() const
         {
@@ -188,11 +206,13 @@ namespace Opm
         using Base::wellHasTHPConstraints;
         using Base::mostStrictBhpFromBhpLimits;
         using Base::scalingFactor;
+        using Base::isDistributed;
 
         // protected member variables from the Base class
         using Base::current_step_;
         using Base::well_ecl_;
         using Base::vfp_properties_;
+        using Base::parallel_well_info_;
         using Base::gravity_;
         using Base::param_;
         using Base::well_efficiency_factor_;
@@ -214,11 +234,31 @@ namespace Opm
         using Base::perf_length_;
         using Base::bore_diameters_;
 
+        // Same as FluidSystem::phaseIsActive(), but constant for the two phase
+        // models, so that the phase checks in the perforation loops are removed
+        // by the compiler there. Oil is always active, and the gas phase is
+        // active if the indices have a composition switch.
+        static bool phaseIsActive(const unsigned phaseIdx)
+        {
+            if (numWellPhases == 2) {
+                const bool gas_active = Indices::compositionSwitchIdx >= 0;
+                const bool active = phaseIdx == FluidSystem::oilPhaseIdx
+                    || phaseIdx == (gas_active ? FluidSystem::gasPhaseIdx : FluidSystem::waterPhaseIdx);
+                assert(active == FluidSystem::phaseIsActive(phaseIdx));
+                return active;
+            }
+            return FluidSystem::phaseIsActive(phaseIdx);
+        }
+
         // densities of the fluid in each perforation
         std::vector<double> perf_densities_;
         // pressure drop between different perforations
         std::vector<double> perf_pressure_diffs_;
 
+        // the state the perforation densities and pressure drops were computed from,
+        // see connectionPressuresState()
+        std::vector<double> connection_pressures_state_;
+
         // residuals of the well equations
         BVectorWell resWell_;
 
@@ -227,6 +267,15 @@ namespace Opm
         OffDiagMatWell duneC_;
         // diagonal matrix for the well
         DiagMatWell invDuneD_;
+        // the bytes of the well matrices
+        MemoryAccounting::Account matrix_memory_{ MemoryAccounting::WellMatrices };
+
+        // positions of the blocks of A -= C^T D^-1 B within their rows, one for
+        // each pair of perforations, and the number of nonzeroes of the matrix
+        // they were found for. The pattern of the Jacobian is fixed for the
+        // lifetime of the well, so the positions are only searched once.
+        mutable std::vector<std::size_t> contribution_positions_;
+        mutable std::size_t contribution_positions_nnz_ = 0;
 
         // several vector used in the matrix calculation
         mutable BVectorWell Bx_;
@@ -242,6 +291,24 @@ namespace Opm
         // the saturations in the well bore under surface conditions at the beginning of the time step
         std::vector<double> F0_;
 
+        // the intervals of the production VFP table found in the last evaluation,
+        // the operating point of the well usually moves little between evaluations
+        mutable detail::VFPProdInterpHint vfp_prod_hint_;
+
+        // the shear factor of each perforation and its derivatives with respect to
+        // the polymer concentration and the water velocity at the last evaluation,
+        // which is repeated at the same state by the residual and the rates
+        struct ShearFactorMemo
+        {
+            double concentration = std::numeric_limits<double>::quiet_NaN();
+            double velocity = std::numeric_limits<double>::quiet_NaN();
+            unsigned pvt_region = 0;
+            double factor = 1.0;
+            double d_concentration = 0.0;
+            double d_velocity = 0.0;
+        };
+        mutable std::vector<ShearFactorMemo> shear_factor_memo_;
+
         const EvalWell& getBhp() const;
 
         EvalWell getQs(const int comp_idx) const;
@@ -296,6 +363,12 @@ namespace Opm
         void computeWellConnectionPressures(const Simulator& ebosSimulator,
                                                     const WellState& well_state);
 
+        // the quantities of the well state and the perforated cells that the
+        // connection densities and pressure drops depend on
+        void connectionPressuresState(const Simulator& ebosSimulator,
+                                      const WellState& well_state,
+                                      std::vector<double>& state) const;
+
         // TODO: to check whether all the paramters are required
         void computePerfRate(const IntensiveQuantities& intQuants,
                              const std::vector<EvalWell>& mob_perfcells_dense,
@@ -327,6 +400,13 @@ namespace Opm
                                             const int perf,
                                             std::vector<EvalWell>& mob_water) const;
 
+        // the shear factor of PLYSHLOG of a perforation, evaluated with the
+        // derivatives with respect to its two arguments only
+        EvalWell computeShearFactor(const int perf,
+                                    const EvalWell& polymer_concentration,
+                                    const unsigned pvt_region,
+                                    const EvalWell& water_velocity) const;
+
         void updatePrimaryVariablesNewton(const BVectorWell& dwells,
                                           const WellState& well_state) const;
 
@@ -0,0 +1,140 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_STANDARDWELLMATRICES_HEADER_INCLUDED
+#define OPM_STANDARDWELLMATRICES_HEADER_INCLUDED
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include <cassert>
+#include <vector>
+
+namespace Opm
+{
+
+    /// \brief The matrices B, C and D^-1 of many standard wells stored contiguously.
+    ///
+    /// The well part of the system
+    ///     [A C^T    [x       =  [ res
+    ///      B  D ]   x_well]      res_well]
+    /// of a standard well consists of one row of blocks of B and C (one block per
+    /// perforated cell) and a single diagonal block D. This class copies these blocks
+    /// of all wells into flat arrays such that the Schur complement
+    /// Ax = Ax - C^T D^-1 B x of all wells can be applied in a single pass.
+    template<class Scalar, int numWellEq, int numEq>
+    class StandardWellMatrices
+    {
+    public:
+        typedef Dune::FieldVector<Scalar, numWellEq> VectorBlockWellType;
+        typedef Dune::FieldMatrix<Scalar, numWellEq, numWellEq> DiagMatrixBlockWellType;
+        typedef Dune::FieldMatrix<Scalar, numWellEq, numEq> OffDiagMatrixBlockWellType;
+
+        StandardWellMatrices()
+            : offsets_(1, 0)
+        {}
+
+        /// \brief Remove all wells, keeping the allocated memory.
+        void clear()
+        {
+            offsets_.resize(1);
+            cells_.clear();
+            duneB_.clear();
+            duneC_.clear();
+            invDuneD_.clear();
+        }
+
+        /// \brief Append the matrices of one well.
+        ///
+        /// \param duneB    The matrix B with one block row.
+        /// \param duneC    The matrix C^T with one block row and the sparsity pattern of B.
+        /// \param invDuneD The 1x1 block matrix D^-1.
+        template<class OffDiagMatWell, class DiagMatWell>
+        void addWell(const OffDiagMatWell& duneB,
+                     const OffDiagMatWell& duneC,
+                     const DiagMatWell& invDuneD)
+        {
+            assert(duneB.N() == 1 && duneC.N() == 1 && invDuneD.N() == 1);
+
+            auto colC = duneC[0].begin();
+            for (auto colB = duneB[0].begin(), endB = duneB[0].end(); colB != endB; ++colB, ++colC) {
+                assert(colC != duneC[0].end() && colC.index() == colB.index());
+                cells_.push_back(colB.index());
+                duneB_.push_back(*colB);
+                duneC_.push_back(*colC);
+            }
+            invDuneD_.push_back(invDuneD[0][0]);
+            offsets_.push_back(cells_.size());
+        }
+
+        /// \brief The number of wells stored.
+        int numWells() const
+        {
+            return invDuneD_.size();
+        }
+
+        /// \brief Ax = Ax - C^T D^-1 B x for all wells.
+        template<class X, class Y>
+        void apply(const X& x, Y& Ax) const
+        {
+            applyScaleAdd(1.0, x, Ax);
+        }
+
+        /// \brief Ax = Ax - alpha * C^T D^-1 B x for all wells.
+        template<class X, class Y>
+        void applyScaleAdd(const Scalar alpha, const X& x, Y& Ax) const
+        {
+            const int nw = numWells();
+            for (int w = 0; w < nw; ++w) {
+                const int begin = offsets_[w];
+                const int end = offsets_[w + 1];
+
+                // Bx = B x
+                VectorBlockWellType Bx(0.0);
+                for (int perf = begin; perf < end; ++perf) {
+                    duneB_[perf].umv(x[cells_[perf]], Bx);
+                }
+
+                // invDBx = alpha * D^-1 Bx
+                VectorBlockWellType invDBx;
+                invDuneD_[w].mv(Bx, invDBx);
+                invDBx *= alpha;
+
+                // Ax = Ax - C^T invDBx
+                for (int perf = begin; perf < end; ++perf) {
+                    duneC_[perf].mmtv(invDBx, Ax[cells_[perf]]);
+                }
+            }
+        }
+
+    private:
+        // the perforations of well w are [offsets_[w], offsets_[w + 1])
+        std::vector<int> offsets_;
+        // the cell of each perforation
+        std::vector<int> cells_;
+        // the blocks of B and C^T of each perforation
+        std::vector<OffDiagMatrixBlockWellType> duneB_;
+        std::vector<OffDiagMatrixBlockWellType> duneC_;
+        // the block D^-1 of each well
+        std::vector<DiagMatrixBlockWellType> invDuneD_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_STANDARDWELLMATRICES_HEADER_INCLUDED
@@ -52,7 +52,7 @@ namespace Opm
     void
     StandardWell<TypeTag>::
     init(const PhaseUsage* phase_usage_arg,
-         const std::vector<double>& depth_arg,
+         const CompactStaticArray& depth_arg,
          const double gravity_arg,
          const int num_cells)
     {
@@ -97,6 +97,9 @@ namespace Opm
         // resize temporary class variables
         Bx_.resize( duneB_.N() );
         invDrw_.resize( invDuneD_.N() );
+
+        matrix_memory_.set(MemoryAccounting::matrixBytes(duneB_) + MemoryAccounting::matrixBytes(duneC_)
+                           + MemoryAccounting::matrixBytes(invDuneD_));
     }
 
 
@@ -205,11 +208,11 @@ namespace Opm
     StandardWell<TypeTag>::
     wellVolumeFraction(const unsigned compIdx) const
     {
-        if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx) && compIdx == Indices::canonicalToActiveComponentIndex(FluidSystem::waterCompIdx)) {
+        if (phaseIsActive(FluidSystem::waterPhaseIdx) && compIdx == Indices::canonicalToActiveComponentIndex(FluidSystem::waterCompIdx)) {
             return primary_variables_evaluation_[WFrac];
         }
 
-        if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx) && compIdx == Indices::canonicalToActiveComponentIndex(FluidSystem::gasCompIdx)) {
+        if (phaseIsActive(FluidSystem::gasPhaseIdx) && compIdx == Indices::canonicalToActiveComponentIndex(FluidSystem::gasCompIdx)) {
             return primary_variables_evaluation_[GFrac];
         }
 
@@ -219,11 +222,11 @@ namespace Opm
 
         // Oil fraction
         EvalWell well_fraction = 1.0;
-        if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+        if (phaseIsActive(FluidSystem::waterPhaseIdx)) {
             well_fraction -= primary_variables_evaluation_[WFrac];
         }
 
-        if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+        if (phaseIsActive(FluidSystem::gasPhaseIdx)) {
             well_fraction -= primary_variables_evaluation_[GFrac];
         }
         if (has_solvent) {
@@ -291,7 +294,7 @@ namespace Opm
         const EvalWell rv = extendEval(fs.Rv());
         std::vector<EvalWell> b_perfcells_dense(num_components_, 0.0);
         for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
-            if (!FluidSystem::phaseIsActive(phaseIdx)) {
+            if (!phaseIsActive(phaseIdx)) {
                 continue;
             }
 
@@ -319,7 +322,7 @@ namespace Opm
                 cq_s[componentIdx] = b_perfcells_dense[componentIdx] * cq_p;
             }
 
-            if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx) && FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+            if (phaseIsActive(FluidSystem::oilPhaseIdx) && phaseIsActive(FluidSystem::gasPhaseIdx)) {
                 const unsigned oilCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::oilCompIdx);
                 const unsigned gasCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::gasCompIdx);
                 const EvalWell cq_sOil = cq_s[oilCompIdx];
@@ -354,7 +357,7 @@ namespace Opm
 
             // compute volume ratio between connection at standard conditions
             EvalWell volumeRatio = 0.0;
-            if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+            if (phaseIsActive(FluidSystem::waterPhaseIdx)) {
                 const unsigned waterCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::waterCompIdx);
                 volumeRatio += cmix_s[waterCompIdx] / b_perfcells_dense[waterCompIdx];
             }
@@ -363,7 +366,7 @@ namespace Opm
                 volumeRatio += cmix_s[contiSolventEqIdx] / b_perfcells_dense[contiSolventEqIdx];
             }
 
-            if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx) && FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+            if (phaseIsActive(FluidSystem::oilPhaseIdx) && phaseIsActive(FluidSystem::gasPhaseIdx)) {
                 const unsigned oilCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::oilCompIdx);
                 const unsigned gasCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::gasCompIdx);
                 // Incorporate RS/RV factors if both oil and gas active
@@ -383,11 +386,11 @@ namespace Opm
                 volumeRatio += tmp_gas / b_perfcells_dense[gasCompIdx];
             }
             else {
-                if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx)) {
+                if (phaseIsActive(FluidSystem::oilPhaseIdx)) {
                     const unsigned oilCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::oilCompIdx);
                     volumeRatio += cmix_s[oilCompIdx] / b_perfcells_dense[oilCompIdx];
                 }
-                if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+                if (phaseIsActive(FluidSystem::gasPhaseIdx)) {
                     const unsigned gasCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::gasCompIdx);
                     volumeRatio += cmix_s[gasCompIdx] / b_perfcells_dense[gasCompIdx];
                 }
@@ -402,7 +405,7 @@ namespace Opm
 
             // calculating the perforation solution gas rate and solution oil rates
             if (well_type_ == PRODUCER) {
-                if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx) && FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+                if (phaseIsActive(FluidSystem::oilPhaseIdx) && phaseIsActive(FluidSystem::gasPhaseIdx)) {
                     const unsigned oilCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::oilCompIdx);
                     const unsigned gasCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::gasCompIdx);
                     // TODO: the formulations here remain to be tested with cases with strong crossflow through production wells
@@ -457,6 +460,11 @@ namespace Opm
 
         const EvalWell& bhp = getBhp();
 
+        // the temperature of the injected fluids, the same for all perforations
+        const double injection_temperature = (has_energy && well_type_ == INJECTOR)
+            ? this->well_ecl_->getInjectionProperties(ebosSimulator.episodeIndex()).temperature
+            : 0.0;
+
         // the solution gas rate and solution oil rate needs to be reset to be zero for well_state.
         well_state.wellVaporizedOilRates()[index_of_well_] = 0.;
         well_state.wellDissolvedGasRates()[index_of_well_] = 0.;
@@ -518,18 +526,18 @@ namespace Opm
             }
             if (has_energy) {
 
-                auto fs = intQuants.fluidState();
-                const int reportStepIdx = ebosSimulator.episodeIndex();
+                // the fluid state of the cell is only copied for the injected fluids
+                const auto& fs = intQuants.fluidState();
 
                 for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
-                    if (!FluidSystem::phaseIsActive(phaseIdx)) {
+                    if (!phaseIsActive(phaseIdx)) {
                         continue;
                     }
 
                     const unsigned activeCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::solventComponentIndex(phaseIdx));
                     // convert to reservoar conditions
                     EvalWell cq_r_thermal = 0.0;
-                    if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx) && FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+                    if (phaseIsActive(FluidSystem::oilPhaseIdx) && phaseIsActive(FluidSystem::gasPhaseIdx)) {
 
                         if(FluidSystem::waterPhaseIdx == phaseIdx)
                              cq_r_thermal = cq_s[activeCompIdx] / extendEval(fs.invB(phaseIdx));
@@ -554,22 +562,26 @@ namespace Opm
 
                     // change temperature for injecting fluids
                     if (well_type_ == INJECTOR && cq_s[activeCompIdx] > 0.0){
-                        const auto& injProps = this->well_ecl_->getInjectionProperties(reportStepIdx);
-                        fs.setTemperature(injProps.temperature);
-                        typedef typename std::decay<decltype(fs)>::type::Scalar FsScalar;
+                        typedef typename std::decay<decltype(fs)>::type InjectionFluidState;
+                        InjectionFluidState injection_fs = fs;
+                        injection_fs.setTemperature(injection_temperature);
+                        typedef typename InjectionFluidState::Scalar FsScalar;
                         typename FluidSystem::template ParameterCache<FsScalar> paramCache;
                         const unsigned pvtRegionIdx = intQuants.pvtRegionIndex();
                         paramCache.setRegionIndex(pvtRegionIdx);
                         paramCache.setMaxOilSat(ebosSimulator.problem().maxOilSaturation(cell_idx));
-                        paramCache.updatePhase(fs, phaseIdx);
+                        paramCache.updatePhase(injection_fs, phaseIdx);
 
-                        const auto& rho = FluidSystem::density(fs, paramCache, phaseIdx);
-                        fs.setDensity(phaseIdx, rho);
-                        const auto& h = FluidSystem::enthalpy(fs, paramCache, phaseIdx);
-                        fs.setEnthalpy(phaseIdx, h);
+                        const auto& rho = FluidSystem::density(injection_fs, paramCache, phaseIdx);
+                        injection_fs.setDensity(phaseIdx, rho);
+                        const auto& h = FluidSystem::enthalpy(injection_fs, paramCache, phaseIdx);
+                        // compute the thermal flux
+                        cq_r_thermal *= extendEval(h) * extendEval(rho);
+                    }
+                    else {
+                        // compute the thermal flux
+                        cq_r_thermal *= extendEval(fs.enthalpy(phaseIdx)) * extendEval(fs.density(phaseIdx));
                     }
-                    // compute the thermal flux
-                    cq_r_thermal *= extendEval(fs.enthalpy(phaseIdx)) * extendEval(fs.density(phaseIdx));
 		    // scale the flux by the scaling factor for the energy equation
                     cq_r_thermal *= GET_PROP_VALUE(TypeTag, BlackOilEnergyScalingFactor);
 
@@ -603,6 +615,15 @@ namespace Opm
             well_state.perfPress()[first_perf_ + perf] = well_state.bhp()[index_of_well_] + perf_pressure_diffs_[perf];
         }
 
+        // the perforations of a distributed well are spread over several processes,
+        // which all need the contributions of all of them.
+        if (isDistributed()) {
+            parallel_well_info_->sum(resWell_[0]);
+            parallel_well_info_->sum(invDuneD_[0][0]);
+            parallel_well_info_->sum(&well_state.wellDissolvedGasRates()[index_of_well_], 1);
+            parallel_well_info_->sum(&well_state.wellVaporizedOilRates()[index_of_well_], 1);
+        }
+
         // add vol * dF/dt + Q to the well equations;
         for (int componentIdx = 0; componentIdx < numWellConservationEq; ++componentIdx) {
             EvalWell resWell_loc = (wellSurfaceVolumeFraction(componentIdx) - F0_[componentIdx]) * volume / dt;
@@ -635,13 +656,13 @@ namespace Opm
             case THP:
             {
                 std::vector<EvalWell> rates(3, 0.);
-                if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+                if (phaseIsActive(FluidSystem::waterPhaseIdx)) {
                     rates[ Water ] = getQs(flowPhaseToEbosCompIdx(Water));
                 }
-                if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx)) {
+                if (phaseIsActive(FluidSystem::oilPhaseIdx)) {
                     rates[ Oil ] = getQs(flowPhaseToEbosCompIdx(Oil));
                 }
-                if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+                if (phaseIsActive(FluidSystem::gasPhaseIdx)) {
                     rates[ Gas ] = getQs(flowPhaseToEbosCompIdx(Gas));
                 }
                 const int current = well_controls_get_current(well_controls_);
@@ -683,6 +704,10 @@ namespace Opm
                             const std::string msg = " Setting all rates to be zero for well " + name()
                                                   + " due to un-solvable situation. There is non-zero target for the phase "
                                                   + " that does not exist in the wellbore for the situation";
+                            // the wells might be assembled in parallel
+#if HAVE_OPENMP
+#pragma omp critical
+#endif // HAVE_OPENMP
                             OpmLog::warning("NON_SOLVABLE_WELL_SOLUTION", msg);
 
                             control_eq = getWQTotal() - target_rate;
@@ -796,7 +821,7 @@ namespace Opm
         if( satid == satid_elem ) { // the same saturation number is used. i.e. just use the mobilty from the cell
 
             for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
-                if (!FluidSystem::phaseIsActive(phaseIdx)) {
+                if (!phaseIsActive(phaseIdx)) {
                     continue;
                 }
 
@@ -817,7 +842,7 @@ namespace Opm
 
             // compute the mobility
             for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
-                if (!FluidSystem::phaseIsActive(phaseIdx)) {
+                if (!phaseIsActive(phaseIdx)) {
                     continue;
                 }
 
@@ -833,7 +858,7 @@ namespace Opm
 
         // modify the water mobility if polymer is present
         if (has_polymer) {
-            if (!FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+            if (!phaseIsActive(FluidSystem::waterPhaseIdx)) {
                 OPM_THROW(std::runtime_error, "Water is required when polymer is active");
             }
 
@@ -871,13 +896,13 @@ namespace Opm
         const std::vector<double> old_primary_variables = primary_variables_;
 
         // update the second and third well variable (The flux fractions)
-        if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+        if (phaseIsActive(FluidSystem::waterPhaseIdx)) {
             const int sign2 = dwells[0][WFrac] > 0 ? 1: -1;
             const double dx2_limited = sign2 * std::min(std::abs(dwells[0][WFrac]),dFLimit);
             primary_variables_[WFrac] = old_primary_variables[WFrac] - dx2_limited;
         }
 
-        if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+        if (phaseIsActive(FluidSystem::gasPhaseIdx)) {
             const int sign3 = dwells[0][GFrac] > 0 ? 1: -1;
             const double dx3_limited = sign3 * std::min(std::abs(dwells[0][GFrac]),dFLimit);
             primary_variables_[GFrac] = old_primary_variables[GFrac] - dx3_limited;
@@ -913,17 +938,17 @@ namespace Opm
     StandardWell<TypeTag>::
     processFractions() const
     {
-        assert(FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx));
+        assert(phaseIsActive(FluidSystem::oilPhaseIdx));
         const auto pu = phaseUsage();
         std::vector<double> F(number_of_phases_, 0.0);
         F[pu.phase_pos[Oil]] = 1.0;
 
-        if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+        if (phaseIsActive(FluidSystem::waterPhaseIdx)) {
             F[pu.phase_pos[Water]] = primary_variables_[WFrac];
             F[pu.phase_pos[Oil]] -= F[pu.phase_pos[Water]];
         }
 
-        if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+        if (phaseIsActive(FluidSystem::gasPhaseIdx)) {
             F[pu.phase_pos[Gas]] = primary_variables_[GFrac];
             F[pu.phase_pos[Oil]] -= F[pu.phase_pos[Gas]];
         }
@@ -934,9 +959,9 @@ namespace Opm
             F[pu.phase_pos[Oil]] -= F_solvent;
         }
 
-        if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+        if (phaseIsActive(FluidSystem::waterPhaseIdx)) {
             if (F[Water] < 0.0) {
-                if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+                if (phaseIsActive(FluidSystem::gasPhaseIdx)) {
                         F[pu.phase_pos[Gas]] /= (1.0 - F[pu.phase_pos[Water]]);
                 }
                 if (has_solvent) {
@@ -947,9 +972,9 @@ namespace Opm
             }
         }
 
-        if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+        if (phaseIsActive(FluidSystem::gasPhaseIdx)) {
             if (F[pu.phase_pos[Gas]] < 0.0) {
-                if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+                if (phaseIsActive(FluidSystem::waterPhaseIdx)) {
                     F[pu.phase_pos[Water]] /= (1.0 - F[pu.phase_pos[Gas]]);
                 }
                 if (has_solvent) {
@@ -961,10 +986,10 @@ namespace Opm
         }
 
         if (F[pu.phase_pos[Oil]] < 0.0) {
-            if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+            if (phaseIsActive(FluidSystem::waterPhaseIdx)) {
                 F[pu.phase_pos[Water]] /= (1.0 - F[pu.phase_pos[Oil]]);
             }
-            if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+            if (phaseIsActive(FluidSystem::gasPhaseIdx)) {
                 F[pu.phase_pos[Gas]] /= (1.0 - F[pu.phase_pos[Oil]]);
             }
             if (has_solvent) {
@@ -973,10 +998,10 @@ namespace Opm
             F[pu.phase_pos[Oil]] = 0.0;
         }
 
-        if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+        if (phaseIsActive(FluidSystem::waterPhaseIdx)) {
             primary_variables_[WFrac] = F[pu.phase_pos[Water]];
         }
-        if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+        if (phaseIsActive(FluidSystem::gasPhaseIdx)) {
             primary_variables_[GFrac] = F[pu.phase_pos[Gas]];
         }
         if(has_solvent) {
@@ -994,19 +1019,19 @@ namespace Opm
     updateWellStateFromPrimaryVariables(WellState& well_state) const
     {
         const PhaseUsage& pu = phaseUsage();
-        assert( FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx) );
+        assert( phaseIsActive(FluidSystem::oilPhaseIdx) );
         const int oil_pos = pu.phase_pos[Oil];
 
         std::vector<double> F(number_of_phases_, 0.0);
         F[oil_pos] = 1.0;
 
-        if ( FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx) ) {
+        if ( phaseIsActive(FluidSystem::waterPhaseIdx) ) {
             const int water_pos = pu.phase_pos[Water];
             F[water_pos] = primary_variables_[WFrac];
             F[oil_pos] -= F[water_pos];
         }
 
-        if ( FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx) ) {
+        if ( phaseIsActive(FluidSystem::gasPhaseIdx) ) {
             const int gas_pos = pu.phase_pos[Gas];
             F[gas_pos] = primary_variables_[GFrac];
             F[oil_pos] -= F[gas_pos];
@@ -1088,13 +1113,13 @@ namespace Opm
                     const Opm::PhaseUsage& pu = phaseUsage();
                     std::vector<double> rates(3, 0.0);
 
-                    if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+                    if (phaseIsActive(FluidSystem::waterPhaseIdx)) {
                         rates[ Water ] = well_state.wellRates()[index_of_well_ * number_of_phases_ + pu.phase_pos[ Water ] ];
                     }
-                    if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx)) {
+                    if (phaseIsActive(FluidSystem::oilPhaseIdx)) {
                         rates[ Oil ] = well_state.wellRates()[index_of_well_ * number_of_phases_ + pu.phase_pos[ Oil ] ];
                     }
-                    if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+                    if (phaseIsActive(FluidSystem::gasPhaseIdx)) {
                         rates[ Gas ] = well_state.wellRates()[index_of_well_ * number_of_phases_ + pu.phase_pos[ Gas ] ];
                     }
 
@@ -1141,13 +1166,13 @@ namespace Opm
 
             const Opm::PhaseUsage& pu = phaseUsage();
             std::vector<double> rates(3, 0.0);
-            if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+            if (phaseIsActive(FluidSystem::waterPhaseIdx)) {
                 rates[ Water ] = well_state.wellRates()[well_index*np + pu.phase_pos[ Water ] ];
             }
-            if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx)) {
+            if (phaseIsActive(FluidSystem::oilPhaseIdx)) {
                  rates[ Oil ] = well_state.wellRates()[well_index*np + pu.phase_pos[ Oil ] ];
             }
-            if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+            if (phaseIsActive(FluidSystem::gasPhaseIdx)) {
                 rates[ Gas ] = well_state.wellRates()[well_index*np + pu.phase_pos[ Gas ] ];
             }
 
@@ -1238,9 +1263,9 @@ namespace Opm
         surf_dens_perf.resize(nperf * num_components_);
         const int w = index_of_well_;
 
-        const bool waterPresent = FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx);
-        const bool oilPresent = FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx);
-        const bool gasPresent = FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx);
+        const bool waterPresent = phaseIsActive(FluidSystem::waterPhaseIdx);
+        const bool oilPresent = phaseIsActive(FluidSystem::oilPhaseIdx);
+        const bool gasPresent = phaseIsActive(FluidSystem::gasPhaseIdx);
 
         //rs and rv are only used if both oil and gas is present
         if (oilPresent && gasPresent) {
@@ -1320,7 +1345,7 @@ namespace Opm
 
             // Surface density.
             for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
-                if (!FluidSystem::phaseIsActive(phaseIdx)) {
+                if (!phaseIsActive(phaseIdx)) {
                     continue;
                 }
 
@@ -1405,7 +1430,7 @@ namespace Opm
             x = mix;
 
             // Subtract dissolved gas from oil phase and vapporized oil from gas phase
-            if (FluidSystem::phaseIsActive(FluidSystem::gasCompIdx) && FluidSystem::phaseIsActive(FluidSystem::oilCompIdx)) {
+            if (phaseIsActive(FluidSystem::gasCompIdx) && phaseIsActive(FluidSystem::oilCompIdx)) {
                 const unsigned gaspos = Indices::canonicalToActiveComponentIndex(FluidSystem::gasCompIdx);
                 const unsigned oilpos = Indices::canonicalToActiveComponentIndex(FluidSystem::oilCompIdx);
                 double rs = 0.0;
@@ -1511,7 +1536,7 @@ namespace Opm
         ConvergenceReport report;
         // checking if any NaN or too large residuals found
         for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
-            if (!FluidSystem::phaseIsActive(phaseIdx)) {
+            if (!phaseIsActive(phaseIdx)) {
                 continue;
             }
 
@@ -1621,6 +1646,22 @@ namespace Opm
     computeWellConnectionPressures(const Simulator& ebosSimulator,
                                    const WellState& well_state)
     {
+         // 0. Reuse the densities and pressure differences if the state they were
+         //    computed from has hardly changed. With the default zero tolerance
+         //    this only happens when it has not changed at all.
+         std::vector<double> state;
+         connectionPressuresState(ebosSimulator, well_state, state);
+         const double tolerance = param_.tolerance_well_connection_pressures_;
+         bool reuse = !connection_pressures_state_.empty()
+                      && connection_pressures_state_.size() == state.size();
+         for (std::size_t i = 0; reuse && i < state.size(); ++i) {
+             const double change = std::abs(state[i] - connection_pressures_state_[i]);
+             reuse = change <= tolerance * std::abs(connection_pressures_state_[i]);
+         }
+         if (reuse) {
+             return;
+         }
+
          // 1. Compute properties required by computeConnectionPressureDelta().
          //    Note that some of the complexity of this part is due to the function
          //    taking std::vector<double> arguments, and not Eigen objects.
@@ -1630,6 +1671,47 @@ namespace Opm
          std::vector<double> surf_dens_perf;
          computePropertiesForWellConnectionPressures(ebosSimulator, well_state, b_perf, rsmax_perf, rvmax_perf, surf_dens_perf);
          computeWellConnectionDensitesPressures(well_state, b_perf, rsmax_perf, rvmax_perf, surf_dens_perf);
+         connection_pressures_state_.swap(state);
+    }
+
+
+
+
+
+    template<typename TypeTag>
+    void
+    StandardWell<TypeTag>::
+    connectionPressuresState(const Simulator& ebosSimulator,
+                             const WellState& well_state,
+                             std::vector<double>& state) const
+    {
+        const int nperf = number_of_perforations_;
+        const int np = number_of_phases_;
+        const int w = index_of_well_;
+
+        state.clear();
+        state.reserve(2 + np + nperf * (np + 6));
+        state.push_back(well_state.bhp()[w]);
+        for (int p = 0; p < np; ++p) {
+            state.push_back(well_state.wellRates()[w * np + p]);
+        }
+        state.push_back(well_state.solventWellRate(w));
+        for (int perf = 0; perf < nperf; ++perf) {
+            const int cell_idx = well_cells_[perf];
+            const auto& intQuants = *(ebosSimulator.model().cachedIntensiveQuantities(cell_idx, /*timeIdx=*/0));
+            const auto& fs = intQuants.fluidState();
+            state.push_back(well_state.perfPress()[first_perf_ + perf]);
+            state.push_back(fs.temperature(FluidSystem::oilPhaseIdx).value());
+            state.push_back(fs.pvtRegionIndex());
+            for (int p = 0; p < np; ++p) {
+                state.push_back(well_state.perfPhaseRates()[(first_perf_ + perf) * np + p]);
+            }
+            if (has_solvent) {
+                state.push_back(well_state.perfRateSolvent()[first_perf_ + perf]);
+                state.push_back(intQuants.solventInverseFormationVolumeFactor().value());
+                state.push_back(intQuants.solventRefDensity());
+            }
+        }
     }
 
 
@@ -1696,6 +1778,9 @@ namespace Opm
 
         // Bx_ = duneB_ * x
         duneB_.mv(x, Bx_);
+        if (isDistributed()) {
+            parallel_well_info_->sum(Bx_[0]);
+        }
         // invDBx = invDuneD_ * Bx_
         // TODO: with this, we modified the content of the invDrw_.
         // Is it necessary to do this to save some memory?
@@ -1726,6 +1811,24 @@ namespace Opm
 
 
 
+    template<typename TypeTag>
+    void
+    StandardWell<TypeTag>::
+    addToWellMatrices(WellMatrices& matrices) const
+    {
+        if ( param_.matrix_add_well_contributions_ )
+        {
+            // Contributions are already in the matrix itself
+            return;
+        }
+
+        matrices.addWell(duneB_, duneC_, invDuneD_);
+    }
+
+
+
+
+
     template<typename TypeTag>
     void
     StandardWell<TypeTag>::
@@ -1733,7 +1836,14 @@ namespace Opm
     {
         BVectorWell resWell = resWell_;
         // resWell = resWell - B * x
-        duneB_.mmv(x, resWell);
+        if (isDistributed()) {
+            BVectorWell Bx(duneB_.N());
+            duneB_.mv(x, Bx);
+            parallel_well_info_->sum(Bx[0]);
+            resWell -= Bx;
+        } else {
+            duneB_.mmv(x, resWell);
+        }
         // xw = D^-1 * resWell
         invDuneD_.mv(resWell, xw);
     }
@@ -1831,13 +1941,13 @@ namespace Opm
                     const Opm::PhaseUsage& pu = phaseUsage();
 
                     std::vector<double> rates(3, 0.0);
-                    if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+                    if (phaseIsActive(FluidSystem::waterPhaseIdx)) {
                         rates[ Water ] = potentials[pu.phase_pos[ Water ] ];
                     }
-                    if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx)) {
+                    if (phaseIsActive(FluidSystem::oilPhaseIdx)) {
                         rates[ Oil ] = potentials[pu.phase_pos[ Oil ] ];
                     }
-                    if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+                    if (phaseIsActive(FluidSystem::gasPhaseIdx)) {
                         rates[ Gas ] = potentials[pu.phase_pos[ Gas ] ];
                     }
 
@@ -1982,10 +2092,10 @@ namespace Opm
         const auto pu = phaseUsage();
 
         if(std::abs(total_well_rate) > 0.) {
-            if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+            if (phaseIsActive(FluidSystem::waterPhaseIdx)) {
                 primary_variables_[WFrac] = scalingFactor(pu.phase_pos[Water]) * well_state.wellRates()[np*well_index + pu.phase_pos[Water]] / total_well_rate;
             }
-            if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+            if (phaseIsActive(FluidSystem::gasPhaseIdx)) {
                 primary_variables_[GFrac] = scalingFactor(pu.phase_pos[Gas]) * (well_state.wellRates()[np*well_index + pu.phase_pos[Gas]] - well_state.solventWellRate(well_index)) / total_well_rate ;
             }
             if (has_solvent) {
@@ -1994,7 +2104,7 @@ namespace Opm
         } else { // total_well_rate == 0
             if (well_type_ == INJECTOR) {
                 // only single phase injection handled
-                if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+                if (phaseIsActive(FluidSystem::waterPhaseIdx)) {
                     if (distr[Water] > 0.0) {
                         primary_variables_[WFrac] = 1.0;
                     } else {
@@ -2002,7 +2112,7 @@ namespace Opm
                     }
                 }
 
-                if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+                if (phaseIsActive(FluidSystem::gasPhaseIdx)) {
                     if (distr[pu.phase_pos[Gas]] > 0.0) {
                         primary_variables_[GFrac] = 1.0 - wsolvent();
                         if (has_solvent) {
@@ -2018,10 +2128,10 @@ namespace Opm
                 // this will happen.
             } else if (well_type_ == PRODUCER) { // producers
                 // TODO: the following are not addressed for the solvent case yet
-                if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+                if (phaseIsActive(FluidSystem::waterPhaseIdx)) {
                     primary_variables_[WFrac] = 1.0 / np;
                 }
-                if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+                if (phaseIsActive(FluidSystem::gasPhaseIdx)) {
                     primary_variables_[GFrac] = 1.0 / np;
                 }
             } else {
@@ -2078,7 +2188,7 @@ namespace Opm
 
              const double dp = wellhelpers::computeHydrostaticCorrection(ref_depth_, vfp_ref_depth, rho, gravity_);
 
-             bhp = vfp_properties_->getProd()->bhp(vfp, aqua, liquid, vapour, thp, alq) - dp;
+             bhp = vfp_properties_->getProd()->bhp(vfp, aqua, liquid, vapour, thp, alq, &vfp_prod_hint_) - dp;
          }
          else {
              OPM_THROW(std::logic_error, "Expected INJECTOR or PRODUCER well");
@@ -2123,7 +2233,7 @@ namespace Opm
 
              const double dp = wellhelpers::computeHydrostaticCorrection(ref_depth_, vfp_ref_depth, rho, gravity_);
 
-             thp = vfp_properties_->getProd()->thp(vfp, aqua, liquid, vapour, bhp + dp, alq);
+             thp = vfp_properties_->getProd()->thp(vfp, aqua, liquid, vapour, bhp + dp, alq, &vfp_prod_hint_);
          }
          else {
              OPM_THROW(std::logic_error, "Expected INJECTOR or PRODUCER well");
@@ -2190,14 +2300,99 @@ namespace Opm
                 // of implementation. It can be changed to be more consistent when possible.
                 water_velocity *= PolymerModule::shrate( int_quant.pvtRegionIndex() ) / bore_diameters_[perf];
             }
-            const EvalWell shear_factor = PolymerModule::computeShearFactor(polymer_concentration,
-                                                                int_quant.pvtRegionIndex(),
-                                                                water_velocity);
+            const EvalWell shear_factor = computeShearFactor(perf,
+                                                             polymer_concentration,
+                                                             int_quant.pvtRegionIndex(),
+                                                             water_velocity);
              // modify the mobility with the shear factor.
             mob[waterCompIdx] /= shear_factor;
         }
     }
 
+    template<typename TypeTag>
+    typename StandardWell<TypeTag>::EvalWell
+    StandardWell<TypeTag>::
+    computeShearFactor(const int perf,
+                       const EvalWell& polymer_concentration,
+                       const unsigned pvt_region,
+                       const EvalWell& water_velocity) const
+    {
+        // The fixed point iteration of the shear factor only depends on the two
+        // values, hence it is done with two derivatives instead of those of all
+        // the primary variables, and the chain rule gives the derivatives.
+        if (shear_factor_memo_.size() != static_cast<std::size_t>(number_of_perforations_)) {
+            shear_factor_memo_.assign(number_of_perforations_, ShearFactorMemo());
+        }
+        ShearFactorMemo& memo = shear_factor_memo_[perf];
+        if (memo.concentration != polymer_concentration.value()
+            || memo.velocity != water_velocity.value()
+            || memo.pvt_region != pvt_region) {
+            typedef DenseAd::Evaluation<double, /*size=*/2> EvalShear;
+            const EvalShear concentration = EvalShear::createVariable(polymer_concentration.value(), 0);
+            const EvalShear velocity = EvalShear::createVariable(water_velocity.value(), 1);
+            const EvalShear factor = PolymerModule::computeShearFactor(concentration, pvt_region, velocity);
+            memo.concentration = polymer_concentration.value();
+            memo.velocity = water_velocity.value();
+            memo.pvt_region = pvt_region;
+            memo.factor = factor.value();
+            memo.d_concentration = factor.derivative(0);
+            memo.d_velocity = factor.derivative(1);
+        }
+
+        EvalWell shear_factor = memo.d_concentration * polymer_concentration + memo.d_velocity * water_velocity;
+        shear_factor.setValue(memo.factor);
+        return shear_factor;
+    }
+
+    template<typename TypeTag>
+    bool
+    StandardWell<TypeTag>::
+    addReservoirResidual(const Simulator& ebosSimulator, BVector& r) const
+    {
+        // The energy equation needs the properties of the injected fluids, see
+        // assembleWellEq().
+        if (has_energy) {
+            return false;
+        }
+
+        initPrimaryVariablesEvaluation();
+
+        const bool allow_cf = crossFlowAllowed(ebosSimulator);
+        const EvalWell& bhp = getBhp();
+
+        for (int perf = 0; perf < number_of_perforations_; ++perf) {
+            const int cell_idx = well_cells_[perf];
+            const auto& intQuants = *(ebosSimulator.model().cachedIntensiveQuantities(cell_idx, /*timeIdx=*/ 0));
+            std::vector<EvalWell> cq_s(num_components_, 0.0);
+            std::vector<EvalWell> mob(num_components_, 0.0);
+            getMobility(ebosSimulator, perf, mob);
+            double perf_dis_gas_rate = 0.;
+            double perf_vap_oil_rate = 0.;
+            computePerfRate(intQuants, mob, well_index_[perf], bhp, perf_pressure_diffs_[perf], allow_cf,
+                            cq_s, perf_dis_gas_rate, perf_vap_oil_rate);
+
+            for (int componentIdx = 0; componentIdx < num_components_; ++componentIdx) {
+                r[cell_idx][componentIdx] -= cq_s[componentIdx].value() * well_efficiency_factor_;
+            }
+
+            if (has_polymer) {
+                const unsigned waterCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::waterCompIdx);
+                double cq_s_poly = cq_s[waterCompIdx].value() * well_efficiency_factor_;
+                if (well_type_ == INJECTOR) {
+                    cq_s_poly *= wpolymer();
+                } else {
+                    cq_s_poly *= (intQuants.polymerConcentration() * intQuants.polymerViscosityCorrection()).value();
+                }
+                r[cell_idx][contiPolymerEqIdx] -= cq_s_poly;
+            }
+        }
+        return true;
+    }
+
+
+
+
+
     template<typename TypeTag>
     void
     StandardWell<TypeTag>::addWellContributions(Mat& mat) const
@@ -2208,24 +2403,44 @@ namespace Opm
         // B and C have 1 row, nc colums and nonzero
         // at (0,j) only if this well has a perforation at cell j.
 
-        for ( auto colC = duneC_[0].begin(), endC = duneC_[0].end(); colC != endC; ++colC )
+        if ( contribution_positions_nnz_ != mat.nonzeroes() )
         {
-            const auto row_index = colC.index();
-            auto& row = mat[row_index];
-            auto col = row.begin();
+            contribution_positions_.clear();
+            contribution_positions_.reserve( number_of_perforations_ * number_of_perforations_ );
+            for ( auto colC = duneC_[0].begin(), endC = duneC_[0].end(); colC != endC; ++colC )
+            {
+                const auto& row = mat[colC.index()];
+                auto col = row.begin();
+                for ( auto colB = duneB_[0].begin(), endB = duneB_[0].end(); colB != endB; ++colB )
+                {
+                    const auto col_index = colB.index();
+                    // Move col to index col_index
+                    while ( col != row.end() && col.index() < col_index ) ++col;
+                    assert(col != row.end() && col.index() == col_index);
+                    contribution_positions_.push_back( &(*col) - &(*row.begin()) );
+                }
+            }
+            contribution_positions_nnz_ = mat.nonzeroes();
+        }
+
+        // D^-1 B is shared by all the rows.
+        std::vector<Dune::FieldMatrix<Scalar, numWellEq, numEq> > invDB( duneB_[0].size() );
+        auto invDBj = invDB.begin();
+        for ( auto colB = duneB_[0].begin(), endB = duneB_[0].end(); colB != endB; ++colB, ++invDBj )
+        {
+            Dune::FMatrixHelp::multMatrix(invDuneD_[0][0], (*colB), *invDBj);
+        }
 
-            for ( auto colB = duneB_[0].begin(), endB = duneB_[0].end(); colB != endB; ++colB )
+        auto position = contribution_positions_.begin();
+        typename Mat::block_type tmp;
+        for ( auto colC = duneC_[0].begin(), endC = duneC_[0].end(); colC != endC; ++colC )
+        {
+            // The blocks of a row are stored contiguously.
+            auto* row = &(*mat[colC.index()].begin());
+            for ( const auto& block : invDB )
             {
-                const auto col_index = colB.index();
-                // Move col to index col_index
-                while ( col != row.end() && col.index() < col_index ) ++col;
-                assert(col != row.end() && col.index() == col_index);
-
-                Dune::FieldMatrix<Scalar, numWellEq, numEq> tmp;
-                typename Mat::block_type tmp1;
-                Dune::FMatrixHelp::multMatrix(invDuneD_[0][0],  (*colB), tmp);
-                Detail::multMatrixTransposed((*colC), tmp, tmp1);
-                (*col) -= tmp1;
+                Detail::multMatrixTransposed((*colC), block, tmp);
+                row[*position++] -= tmp;
             }
         }
     }
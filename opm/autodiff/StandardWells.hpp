@@ -52,8 +52,11 @@ namespace Opm {
         public:
             struct WellOps {
                 explicit WellOps(const Wells* wells);
+                /// Set up c2p for the given number of cells.
+                void initCellGather(int number_of_cells);
                 Eigen::SparseMatrix<double> w2p;              // well -> perf (scatter)
                 Eigen::SparseMatrix<double> p2w;              // perf -> well (gather)
+                Eigen::SparseMatrix<double> c2p;              // cell -> perf (gather), set by init()
                 std::vector<int> well_cells;                  // the set of perforated cells
             };
 
@@ -209,7 +212,7 @@ namespace Opm {
         protected:
             bool wells_active_;
             const Wells*   wells_;
-            const WellOps  wops_;
+            WellOps  wops_;
             // It will probably need to be updated during running time.
             WellCollection* well_collection_;
 
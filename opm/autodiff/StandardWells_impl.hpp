@@ -37,6 +37,7 @@ namespace Opm
     WellOps::WellOps(const Wells* wells)
       : w2p(),
         p2w(),
+        c2p(),
         well_cells()
     {
         if( wells )
@@ -71,6 +72,28 @@ namespace Opm
 
 
 
+    void
+    StandardWells::
+    WellOps::initCellGather(const int number_of_cells)
+    {
+        // The same selection as subset(x, well_cells), built once instead
+        // of in every call.
+        const int nperf = well_cells.size();
+        c2p = Eigen::SparseMatrix<double>(nperf, number_of_cells);
+
+        typedef Eigen::Triplet<double> Tri;
+        std::vector<Tri> gather;
+        gather.reserve(nperf);
+        for (int perf = 0; perf < nperf; ++perf) {
+            gather.push_back(Tri(perf, well_cells[perf], 1.0));
+        }
+        c2p.setFromTriplets(gather.begin(), gather.end());
+    }
+
+
+
+
+
     StandardWells::StandardWells(const Wells* wells_arg, WellCollection* well_collection, const int current_step)
       : wells_active_(wells_arg!=nullptr)
       , wells_(wells_arg)
@@ -105,7 +128,8 @@ namespace Opm
         phase_condition_ = pc_arg;
         vfp_properties_ = vfp_properties_arg;
         gravity_ = gravity_arg;
-        perf_cell_depth_ = subset(depth_arg, wellOps().well_cells);;
+        perf_cell_depth_ = subset(depth_arg, wellOps().well_cells);
+        wops_.initCellGather(depth_arg.size());
 
         calculateEfficiencyFactors();
     }
@@ -247,7 +271,7 @@ namespace Opm
         const std::vector<int>& well_cells = wellOps().well_cells;
 
         // Use cell values for the temperature as the wells don't knows its temperature yet.
-        const ADB perf_temp = subset(state.temperature, well_cells);
+        const ADB perf_temp = wellOps().c2p * state.temperature;
 
         // Compute b, rsmax, rvmax values for perforations.
         // Evaluate the properties using average well block pressures
@@ -267,12 +291,12 @@ namespace Opm
         assert((*active_)[Oil]);
         const Vector perf_so =  subset(state.saturation[pu.phase_pos[Oil]].value(), well_cells);
         if (pu.phase_used[BlackoilPhases::Liquid]) {
-            const ADB perf_rs = (state.rs.size() > 0) ? subset(state.rs, well_cells) : ADB::null();
+            const ADB perf_rs = (state.rs.size() > 0) ? wellOps().c2p * state.rs : ADB::null();
             const Vector bo = fluid_->bOil(avg_press_ad, perf_temp, perf_rs, perf_cond, well_cells).value();
             b.col(pu.phase_pos[BlackoilPhases::Liquid]) = bo;
         }
         if (pu.phase_used[BlackoilPhases::Vapour]) {
-            const ADB perf_rv = (state.rv.size() > 0) ? subset(state.rv, well_cells) : ADB::null();
+            const ADB perf_rv = (state.rv.size() > 0) ? wellOps().c2p * state.rv : ADB::null();
             const Vector bg = fluid_->bGas(avg_press_ad, perf_temp, perf_rv, perf_cond, well_cells).value();
             b.col(pu.phase_pos[BlackoilPhases::Vapour]) = bg;
         }
@@ -377,13 +401,13 @@ namespace Opm
             b_perfcells.clear();
             return;
         } else {
-            const std::vector<int>& well_cells = wellOps().well_cells;
+            const Eigen::SparseMatrix<double>& c2p = wellOps().c2p;
             const int num_phases = wells().number_of_phases;
             mob_perfcells.resize(num_phases, ADB::null());
             b_perfcells.resize(num_phases, ADB::null());
             for (int phase = 0; phase < num_phases; ++phase) {
-                mob_perfcells[phase] = subset(rq[phase].mob, well_cells);
-                b_perfcells[phase] = subset(rq[phase].b, well_cells);
+                mob_perfcells[phase] = c2p * rq[phase].mob;
+                b_perfcells[phase] = c2p * rq[phase].b;
             }
         }
     }
@@ -408,12 +432,12 @@ namespace Opm
         const int nw = wells().number_of_wells;
         const int nperf = wells().well_connpos[nw];
         Vector Tw = Eigen::Map<const Vector>(wells().WI, nperf);
-        const std::vector<int>& well_cells = wellOps().well_cells;
+        const Eigen::SparseMatrix<double>& c2p = wellOps().c2p;
 
         // pressure diffs computed already (once per step, not changing per iteration)
         const Vector& cdp = wellPerforationPressureDiffs();
         // Extract needed quantities for the perforation cells
-        const ADB& p_perfcells = subset(state.pressure, well_cells);
+        const ADB p_perfcells = c2p * state.pressure;
 
         // Perforation pressure
         const ADB perfpressure = (wellOps().w2p * state.bhp) + cdp;
@@ -436,8 +460,8 @@ namespace Opm
         }
 
         // Handle cross flow
-        const Vector numInjectingPerforations = (wellOps().p2w * ADB::constant(selectInjectingPerforations)).value();
-        const Vector numProducingPerforations = (wellOps().p2w * ADB::constant(selectProducingPerforations)).value();
+        const Vector numInjectingPerforations = (wellOps().p2w * selectInjectingPerforations.matrix()).array();
+        const Vector numProducingPerforations = (wellOps().p2w * selectProducingPerforations.matrix()).array();
         for (int w = 0; w < nw; ++w) {
             if (!wells().allow_cf[w]) {
                 for (int perf = wells().well_connpos[w] ; perf < wells().well_connpos[w+1]; ++perf) {
@@ -458,18 +482,20 @@ namespace Opm
         // compute phase volumetric rates at standard conditions
         std::vector<ADB> cq_p(np, ADB::null());
         std::vector<ADB> cq_ps(np, ADB::null());
+        const ADB producing_drawdown = -(selectProducingPerforations * Tw) * drawdown;
         for (int phase = 0; phase < np; ++phase) {
-            cq_p[phase] = -(selectProducingPerforations * Tw) * (mob_perfcells[phase] * drawdown);
+            cq_p[phase] = mob_perfcells[phase] * producing_drawdown;
             cq_ps[phase] = b_perfcells[phase] * cq_p[phase];
         }
         const Opm::PhaseUsage& pu = fluid_->phaseUsage();
-        if ((*active_)[Oil] && (*active_)[Gas]) {
+        const bool oil_and_gas = (*active_)[Oil] && (*active_)[Gas];
+        const ADB rv_perfcells = oil_and_gas ? c2p * state.rv : ADB::null();
+        const ADB rs_perfcells = oil_and_gas ? c2p * state.rs : ADB::null();
+        if (oil_and_gas) {
             const int oilpos = pu.phase_pos[Oil];
             const int gaspos = pu.phase_pos[Gas];
             const ADB cq_psOil = cq_ps[oilpos];
             const ADB cq_psGas = cq_ps[gaspos];
-            const ADB& rv_perfcells = subset(state.rv, well_cells);
-            const ADB& rs_perfcells = subset(state.rs, well_cells);
             cq_ps[gaspos] += rs_perfcells * cq_psOil;
             cq_ps[oilpos] += rv_perfcells * cq_psGas;
         }
@@ -525,10 +551,8 @@ namespace Opm
             volumeRatio += cmix_s[watpos] / b_perfcells[watpos];
         }
 
-        if ((*active_)[Oil] && (*active_)[Gas]) {
+        if (oil_and_gas) {
             // Incorporate RS/RV factors if both oil and gas active
-            const ADB& rv_perfcells = subset(state.rv, well_cells);
-            const ADB& rs_perfcells = subset(state.rs, well_cells);
             const ADB d = Vector::Constant(nperf,1.0) - rv_perfcells * rs_perfcells;
 
             const int oilpos = pu.phase_pos[Oil];
@@ -964,9 +988,21 @@ namespace Opm
 
         //Perform hydrostatic correction to computed targets
         const Vector dp_v = wellhelpers::computeHydrostaticCorrection(wells(), vfp_ref_depth_v, wellPerforationDensities(), gravity_);
-        const ADB dp = ADB::constant(dp_v);
-        const ADB dp_inj = superset(subset(dp, thp_inj_elems), thp_inj_elems, nw);
-        const ADB dp_prod = superset(subset(dp, thp_prod_elems), thp_prod_elems, nw);
+        // Select the wells of each kind of control by masks, which unlike
+        // superset(subset()) need no selection matrices.
+        const auto selection = [nw](const std::vector<int>& elems) {
+            Vector mask = Vector::Zero(nw);
+            for (const int w : elems) {
+                mask[w] = 1.0;
+            }
+            return mask;
+        };
+        const Vector bhp_mask = selection(bhp_elems);
+        const Vector thp_inj_mask = selection(thp_inj_elems);
+        const Vector thp_prod_mask = selection(thp_prod_elems);
+        const Vector rate_mask = selection(rate_elems);
+        const ADB dp_inj = ADB::constant(thp_inj_mask * dp_v);
+        const ADB dp_prod = ADB::constant(thp_prod_mask * dp_v);
 
         //Calculate residuals
         const ADB thp_inj_residual = state.bhp - bhp_from_thp_inj + dp_inj;
@@ -975,10 +1011,10 @@ namespace Opm
         const ADB rate_residual = rate_distr * state.qs - rate_targets;
 
         //Select the right residual for each well
-        residual.well_eq = superset(subset(bhp_residual, bhp_elems), bhp_elems, nw) +
-                superset(subset(thp_inj_residual, thp_inj_elems), thp_inj_elems, nw) +
-                superset(subset(thp_prod_residual, thp_prod_elems), thp_prod_elems, nw) +
-                superset(subset(rate_residual, rate_elems), rate_elems, nw);
+        residual.well_eq = bhp_mask * bhp_residual +
+                thp_inj_mask * thp_inj_residual +
+                thp_prod_mask * thp_prod_residual +
+                rate_mask * rate_residual;
 
         // For wells that are dead (not flowing), and therefore not communicating
         // with the reservoir, we set the equation to be equal to the well's total
@@ -0,0 +1,135 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_SUBDOMAINDIRECTSOLVER_HEADER_INCLUDED
+#define OPM_SUBDOMAINDIRECTSOLVER_HEADER_INCLUDED
+
+#include <opm/common/utility/platform_dependent/disable_warnings.h>
+#include <dune/common/version.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/preconditioner.hh>
+#include <dune/istl/solver.hh>
+#if HAVE_UMFPACK
+#include <dune/istl/umfpack.hh>
+#endif // HAVE_UMFPACK
+#include <opm/common/utility/platform_dependent/reenable_warnings.h>
+
+#include <opm/common/ErrorMacros.hpp>
+#include <opm/simulators/MemoryAccounting.hpp>
+
+#include <stdexcept>
+
+namespace Opm
+{
+
+/// \brief Sequential preconditioner that solves the local system exactly
+///        with a sparse LU factorization (UMFPack).
+///
+/// Meant as the subdomain solver of ParallelRestrictedOverlappingSchwarz:
+/// each process solves its subdomain including the overlap exactly, which
+/// lowers the number of iterations, and thus of global reductions, compared
+/// to ILU(0) at the price of the factorization.
+///
+/// \tparam M The matrix type, a Dune::BCRSMatrix of FieldMatrix or MatrixBlock.
+/// \tparam X The type of the vector representing the domain.
+/// \tparam Y The type of the vector representing the range.
+template<class M, class X, class Y>
+class SubdomainDirectSolver
+    : public Dune::Preconditioner<X,Y>
+{
+    // UMFPack is only specialized for FieldMatrix blocks. MatrixBlock is a
+    // subclass of FieldMatrix that just adds methods, so the cast is safe.
+    typedef typename M::block_type Block;
+    typedef Dune::BCRSMatrix<Dune::FieldMatrix<typename Block::field_type, Block::rows, Block::cols> > Matrix;
+
+public:
+    typedef M matrix_type;
+    typedef X domain_type;
+    typedef Y range_type;
+    typedef typename X::field_type field_type;
+
+#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 6)
+    Dune::SolverCategory::Category category() const override
+    {
+        return Dune::SolverCategory::sequential;
+    }
+#else
+    enum {
+        //! \brief The category the preconditioner is part of.
+        category = Dune::SolverCategory::sequential
+    };
+#endif
+
+    /// \brief Factorize the matrix.
+    explicit SubdomainDirectSolver(const M& A)
+#if HAVE_UMFPACK
+        : umfpack_( reinterpret_cast<const Matrix&>(A), 0 )
+#endif // HAVE_UMFPACK
+    {
+#if !HAVE_UMFPACK
+        static_cast<void>(A);
+        OPM_THROW(std::logic_error, "The direct subdomain solver needs UMFPack, reconfigure with SuiteSparse.");
+#endif // !HAVE_UMFPACK
+        memory_.set( MemoryAccounting::matrixBytes( A ) );
+    }
+
+    virtual void pre(X& x, Y& b)
+    {
+        static_cast<void>(x);
+        static_cast<void>(b);
+    }
+
+    virtual void apply(X& v, const Y& d)
+    {
+#if HAVE_UMFPACK
+        // UMFPack may modify the right hand side.
+        rhs_ = d;
+        Dune::InverseOperatorResult result;
+        umfpack_.apply( v, rhs_, result );
+#else
+        static_cast<void>(v);
+        static_cast<void>(d);
+#endif // HAVE_UMFPACK
+    }
+
+    /// \brief The direction of the sweeps does not matter for an exact solve.
+    template<bool forward>
+    void apply(X& v, const Y& d)
+    {
+        apply( v, d );
+    }
+
+    virtual void post(X& x)
+    {
+        static_cast<void>(x);
+    }
+
+private:
+#if HAVE_UMFPACK
+    Dune::UMFPack<Matrix> umfpack_;
+    Y rhs_;
+#endif // HAVE_UMFPACK
+    //! \brief A lower bound of the bytes of the factorization, those of the
+    //!        matrix. The wrapper of UMFPack does not report the fill-in of
+    //!        the factors, which are usually several times larger.
+    MemoryAccounting::Account memory_{ MemoryAccounting::Preconditioner };
+};
+
+} // end namespace Opm
+
+#endif // OPM_SUBDOMAINDIRECTSOLVER_HEADER_INCLUDED
@@ -0,0 +1,118 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/autodiff/SummaryStreamWriter.hpp>
+#include <opm/core/simulator/WellState.hpp>
+#include <opm/common/ErrorMacros.hpp>
+
+#include <algorithm>
+#include <cstdio>
+
+namespace Opm
+{
+
+    SummaryStreamWriter::SummaryStreamWriter(const std::string& filename,
+                                             const std::vector<std::string>& wellNames,
+                                             const PhaseUsage& pu,
+                                             const std::vector<std::string>& miscKeys)
+        : os_(filename.c_str()),
+          wellNames_(wellNames),
+          miscKeys_(miscKeys),
+          pu_(pu)
+    {
+        if (!os_) {
+            OPM_THROW(std::runtime_error, "Failed to open " << filename);
+        }
+
+        const char* phaseNames[BlackoilPhases::MaxNumPhases] = { "WATER", "OIL", "GAS" };
+        appendField("TIME");
+        appendField("STEP");
+        for (const auto& key : miscKeys_) {
+            appendField(key);
+        }
+        for (const auto& well : wellNames_) {
+            appendField("BHP:" + well);
+            for (int phase = 0; phase < BlackoilPhases::MaxNumPhases; ++phase) {
+                if (pu_.phase_used[phase]) {
+                    appendField(std::string(phaseNames[phase]) + ":" + well);
+                }
+            }
+        }
+        record_ += '\n';
+        os_ << record_ << std::flush;
+    }
+
+
+
+
+    void SummaryStreamWriter::writeTimeStep(const double time,
+                                            const int reportStep,
+                                            const WellState& wellState,
+                                            const std::map<std::string, double>& misc)
+    {
+        record_.clear();
+        appendField(time);
+        appendField(double(reportStep));
+        for (const auto& key : miscKeys_) {
+            const auto it = misc.find(key);
+            appendField(it == misc.end() ? 0.0 : it->second);
+        }
+
+        const int np = pu_.num_phases;
+        const auto& wellMap = wellState.wellMap();
+        for (const auto& well : wellNames_) {
+            const auto it = wellMap.find(well);
+            const int w = it == wellMap.end() ? -1 : it->second[0];
+            appendField(w < 0 ? 0.0 : wellState.bhp()[w]);
+            for (int phase = 0; phase < BlackoilPhases::MaxNumPhases; ++phase) {
+                if (pu_.phase_used[phase]) {
+                    appendField(w < 0 ? 0.0 : wellState.wellRates()[np*w + pu_.phase_pos[phase]]);
+                }
+            }
+        }
+        record_ += '\n';
+        os_ << record_ << std::flush;
+        if (!os_) {
+            OPM_THROW(std::runtime_error, "Failed to write the summary stream");
+        }
+    }
+
+
+
+
+    void SummaryStreamWriter::appendField(const std::string& name)
+    {
+        // names are cut so that all fields keep their width
+        std::string field(Width, ' ');
+        field.replace(1, std::min(name.size(), std::size_t(Width - 1)), name, 0, Width - 1);
+        record_ += field;
+    }
+
+
+
+
+    void SummaryStreamWriter::appendField(const double value)
+    {
+        char field[Width + 1];
+        std::snprintf(field, sizeof(field), " %16.8e", value);
+        record_.append(field, Width);
+    }
+
+} // namespace Opm
@@ -0,0 +1,84 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_SUMMARYSTREAMWRITER_HEADER_INCLUDED
+#define OPM_SUMMARYSTREAMWRITER_HEADER_INCLUDED
+
+#include <opm/core/props/BlackoilPhases.hpp>
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Opm
+{
+
+    class WellState;
+
+    /// Streaming summary output for monitoring a run while it progresses.
+    ///
+    /// Every written time step appends one record to a text file and
+    /// flushes it, so the file can be followed with e.g. tail -f. The
+    /// columns are fixed at construction: TIME, STEP, the misc quantities
+    /// and, for every well, the bottom hole pressure and the surface rate
+    /// of each active phase (positive for injection). All records have
+    /// the same width, with fields of Width characters, and the first
+    /// line names the columns. All values are in SI units. Wells that are
+    /// not in the well state of a time step get zeros.
+    class SummaryStreamWriter
+    {
+    public:
+        /// Width of a field, including the separating blank.
+        static const int Width = 17;
+
+        /// \param[in] filename   File to write, truncated if it exists.
+        /// \param[in] wellNames  Names of all the wells of the run.
+        /// \param[in] pu         The active phases.
+        /// \param[in] miscKeys   Names of the misc quantities, see writeTimeStep().
+        SummaryStreamWriter(const std::string& filename,
+                            const std::vector<std::string>& wellNames,
+                            const PhaseUsage& pu,
+                            const std::vector<std::string>& miscKeys);
+
+        /// Append and flush the record of one time step.
+        /// \param[in] time        Elapsed simulation time.
+        /// \param[in] reportStep  Report step number.
+        /// \param[in] wellState   The global well state.
+        /// \param[in] misc        Values of the misc quantities, those missing are zero.
+        void writeTimeStep(const double time,
+                           const int reportStep,
+                           const WellState& wellState,
+                           const std::map<std::string, double>& misc);
+
+    private:
+        void appendField(const std::string& name);
+        void appendField(const double value);
+
+        std::ofstream os_;
+        std::vector<std::string> wellNames_;
+        std::vector<std::string> miscKeys_;
+        PhaseUsage pu_;
+        // one record, reused for all time steps
+        std::string record_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_SUMMARYSTREAMWRITER_HEADER_INCLUDED
@@ -27,9 +27,15 @@
 #include <cassert>
 #include <dune/common/exceptions.hh>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
 #include <thread>
 #include <mutex>
 #include <queue>
+#include <stdexcept>
+#include <vector>
 
 namespace Opm
 {
@@ -38,6 +44,17 @@ namespace Opm
   {
   public:
 
+    /// \brief Statistics of the dispatched objects.
+    struct Statistics
+    {
+      //! number of dispatched objects
+      long dispatched = 0;
+      //! largest number of objects queued or executed at the same time
+      int maxObjectsInFlight = 0;
+      //! total time in seconds dispatch waited for room in the queue
+      double dispatchWaitTime = 0.0;
+    };
+
     /// \brief ObjectInterface class
     /// Virtual interface for code to be run in a seperate thread.
     class ObjectInterface
@@ -75,84 +92,98 @@ namespace Opm
 
 
     /// \brief The ThreadHandleQueue class
-    /// Queue of objects to be handled by this thread.
+    /// Queue of objects to be handled by the threads. At most maxObjects
+    /// objects are queued or executed at any time, pushing another object
+    /// waits until the execution of one of them has finished.
     class ThreadHandleQueue
     {
     public:
       //! constructor creating object that is executed by thread
-      ThreadHandleQueue()
-        : objQueue_(), mutex_()
+      explicit ThreadHandleQueue( const int maxObjects )
+        : objQueue_(), statistics_(), mutex_(),
+          maxObjects_( std::max( maxObjects, 1 ) ),
+          objectsInFlight_( 0 )
       {
       }
 
-      ~ThreadHandleQueue()
+      //! insert object into threads queue, waits while the queue is full
+      void push_back( std::unique_ptr< ObjectInterface >&& obj )
       {
-        // wait until all objects have been written.
-        while( ! objQueue_.empty() )
+        std::unique_lock< std::mutex > lock( mutex_ );
+        // the end marker does not hold any data and never waits
+        if( ! obj->isEndMarker() )
         {
-            wait();
+          if( objectsInFlight_ >= maxObjects_ )
+          {
+            const auto start = std::chrono::steady_clock::now();
+            spaceAvailable_.wait( lock, [ this ] () { return objectsInFlight_ < maxObjects_; } );
+            const std::chrono::duration< double > waited = std::chrono::steady_clock::now() - start;
+            statistics_.dispatchWaitTime += waited.count();
+          }
+          ++objectsInFlight_;
+          ++statistics_.dispatched;
+          statistics_.maxObjectsInFlight = std::max( statistics_.maxObjectsInFlight, objectsInFlight_ );
         }
-      }
-
-      //! insert object into threads queue
-      void push_back( std::unique_ptr< ObjectInterface >&& obj )
-      {
-        // lock mutex to make sure objPtr is not used
-        mutex_.lock();
         objQueue_.emplace( std::move(obj) );
-        mutex_.unlock();
+        objectAvailable_.notify_one();
       }
 
       //! do the work until the queue received an end object
       void run()
       {
-        // wait until objects have been pushed to the queue
-        while( objQueue_.empty() )
-        {
-          // sleep one second
-          wait();
-        }
-
+        while( true )
         {
-            // lock mutex for access to objQueue_
-            mutex_.lock();
+          std::unique_ptr< ObjectInterface > obj;
+          {
+            // wait until objects have been pushed to the queue
+            std::unique_lock< std::mutex > lock( mutex_ );
+            objectAvailable_.wait( lock, [ this ] () { return ! objQueue_.empty(); } );
 
             // get next object from queue
-            std::unique_ptr< ObjectInterface > obj( objQueue_.front().release() );
-            // remove object from queue
+            obj = std::move( objQueue_.front() );
             objQueue_.pop();
 
-            // unlock mutex for access to objQueue_
-            mutex_.unlock();
-
-            // if object is end marker terminate thread
+            // if object is end marker terminate thread, the end markers
+            // of the other threads may still be queued
             if( obj->isEndMarker() ){
-                if( ! objQueue_.empty() ) {
+                if( ! objQueue_.empty() && ! objQueue_.front()->isEndMarker() ) {
                     throw std::logic_error("ThreadHandleQueue: not all queued objects were executed");
                 }
                 return;
             }
-
-            // execute object action
-            obj->run();
+          }
+
+          // execute object action, the queue stays accessible meanwhile
+          obj->run();
+          // release the data of the object before making room for the next one
+          obj.reset();
+
+          {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            --objectsInFlight_;
+          }
+          spaceAvailable_.notify_one();
         }
+      }
 
-        // keep thread running
-        run();
+      //! statistics of the objects pushed so far
+      Statistics statistics()
+      {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        return statistics_;
       }
 
     protected:
       std::queue< std::unique_ptr< ObjectInterface > > objQueue_;
+      Statistics statistics_;
       std::mutex  mutex_;
+      std::condition_variable objectAvailable_;
+      std::condition_variable spaceAvailable_;
+      const int maxObjects_;
+      int objectsInFlight_;
 
       // no copying
       ThreadHandleQueue( const ThreadHandleQueue& ) = delete;
-
-      // wait duration of 10 milli seconds
-      void wait() const
-      {
-          std::this_thread::sleep_for( std::chrono::milliseconds(10) );
-      }
     }; // end ThreadHandleQueue
 
     ////////////////////////////////////////////////////
@@ -166,7 +197,7 @@ namespace Opm
     }
 
     ThreadHandleQueue threadObjectQueue_;
-    std::unique_ptr< std::thread > thread_;
+    std::vector< std::thread > threads_;
 
   private:
     // prohibit copying
@@ -174,24 +205,31 @@ namespace Opm
 
   public:
     //! constructor creating ThreadHandle
-    //! \param isIORank  if true thread is created
-    ThreadHandle( const bool createThread )
-      : threadObjectQueue_(),
-        thread_()
+    //! \param isIORank    if true threads are created
+    //! \param maxObjects  number of dispatched objects that may be pending
+    //!                    before dispatch waits for the threads
+    //! \param numThreads  number of threads executing the objects. With more
+    //!                    than one thread, objects may run concurrently and
+    //!                    finish out of order.
+    ThreadHandle( const bool createThread, const int maxObjects = 2, const int numThreads = 1 )
+      : threadObjectQueue_( maxObjects ),
+        threads_()
     {
         if( createThread )
         {
-           thread_.reset( new std::thread( startThread, &threadObjectQueue_ ) );
-           // detach thread into nirvana
-           thread_->detach();
+           for( int i = 0; i < std::max( numThreads, 1 ); ++i )
+           {
+              threads_.emplace_back( startThread, &threadObjectQueue_ );
+           }
         }
     } // end constructor
 
     //! dispatch object to queue of separate thread
+    //! waits while the maximal number of objects is pending
     template <class Object>
     void dispatch( Object&& obj )
     {
-        if( thread_ )
+        if( ! threads_.empty() )
         {
             typedef ObjectWrapper< Object >  ObjectPointer;
             ObjectInterface* objPtr = new ObjectPointer( std::move(obj) );
@@ -205,14 +243,24 @@ namespace Opm
         }
     }
 
-    //! destructor terminating the thread
+    //! statistics of the objects dispatched so far
+    Statistics statistics()
+    {
+        return threadObjectQueue_.statistics();
+    }
+
+    //! destructor terminating the threads after all objects have been executed
     ~ThreadHandle()
     {
-        if( thread_ )
+        // dispatch one end object per thread, each terminates one thread
+        for( std::size_t i = 0; i < threads_.size(); ++i )
         {
-            // dispatch end object which will terminate the thread
             threadObjectQueue_.push_back( std::unique_ptr< ObjectInterface > (new EndObject()) ) ;
         }
+        for( auto& thread : threads_ )
+        {
+            thread.join();
+        }
     }
   };
 
@@ -28,6 +28,9 @@
 #include <opm/material/densead/Math.hpp>
 #include <opm/material/densead/Evaluation.hpp>
 
+#include <algorithm>
+#include <vector>
+
 /**
  * This file contains a set of helper functions used by VFPProd / VFPInj.
  */
@@ -201,6 +204,72 @@ struct InterpData {
 
 
 
+/**
+ * The values of a production table interpolated to a fixed thp and alq,
+ * i.e. the bhp as a function of flo, wfr and gfr only. values_ is ordered
+ * as [wfr][gfr][flo] and is empty until the slice is built.
+ */
+struct VFPProdTHPSlice {
+    VFPProdTHPSlice() : table_(nullptr), thp_(0.0), alq_(0.0) {}
+    const VFPProdTable* table_;
+    double thp_;
+    double alq_;
+    std::vector<double> values_;
+};
+
+
+
+
+
+
+/**
+ * Helper struct holding the intervals found on each axis of a production table
+ * in the last search, as starting guesses for the next search.
+ * An index i denotes the interval [i-1, i], and 0 means no guess.
+ * It also holds the slice of the table at the thp and alq of the last
+ * evaluation of the bhp, see useTHPSlice().
+ */
+struct VFPProdInterpHint {
+    VFPProdInterpHint() : flo_(0), thp_(0), wfr_(0), gfr_(0), alq_(0) {}
+    int flo_;
+    int thp_;
+    int wfr_;
+    int gfr_;
+    int alq_;
+    VFPProdTHPSlice thp_slice_;
+};
+
+
+
+
+
+
+/**
+ * Helper function to compute the interpolation factor once the indices
+ * of the interval are known
+ */
+inline void computeInterpFactor(const double& value, const std::vector<double>& values, InterpData& data) {
+    const double start = values[data.ind_[0]];
+    const double end   = values[data.ind_[1]];
+
+    //Find interpolation ratio
+    if (end > start) {
+        //FIXME: Possible source for floating point error here if value and floor are large,
+        //but very close to each other
+        data.inv_dist_ = 1.0 / (end-start);
+        data.factor_ = (value-start) * data.inv_dist_;
+    }
+    else {
+        data.inv_dist_ = 0.0;
+        data.factor_ = 0.0;
+    }
+}
+
+
+
+
+
+
 /**
  * Helper function to find indices etc. for linear interpolation and extrapolation
  *  @param value Value to find in values
@@ -232,32 +301,42 @@ inline InterpData findInterpData(const double& value, const std::vector<double>&
             retval.ind_[1] = nvalues-1;
         }
         else {
-            //Search internal intervals
-            for (int i=1; i<nvalues; ++i) {
-                if (values[i] >= value) {
-                    retval.ind_[0] = i-1;
-                    retval.ind_[1] = i;
-                    break;
-                }
-            }
+            //Search internal intervals for the first value greater than or equal to value
+            const int i = std::lower_bound(values.begin() + 1, values.end(), value) - values.begin();
+            retval.ind_[0] = i-1;
+            retval.ind_[1] = i;
         }
 
-        const double start = values[retval.ind_[0]];
-        const double end   = values[retval.ind_[1]];
+        computeInterpFactor(value, values, retval);
+    }
 
-        //Find interpolation ratio
-        if (end > start) {
-            //FIXME: Possible source for floating point error here if value and floor are large,
-            //but very close to each other
-            retval.inv_dist_ = 1.0 / (end-start);
-            retval.factor_ = (value-start) * retval.inv_dist_;
-        }
-        else {
-            retval.inv_dist_ = 0.0;
-            retval.factor_ = 0.0;
-        }
+    return retval;
+}
+
+
+
+
+
+
+/**
+ * Same as findInterpData above, but first tries the interval given by hint,
+ * which is then updated to the interval found. When the value moves little
+ * between calls this avoids the search altogether.
+ */
+inline InterpData findInterpData(const double& value, const std::vector<double>& values, int& hint) {
+    const int nvalues = values.size();
+
+    //The interval [hint-1, hint] is the one the search would find if it brackets value
+    if (hint > 0 && hint < nvalues && values[hint-1] < value && value <= values[hint]) {
+        InterpData retval;
+        retval.ind_[0] = hint-1;
+        retval.ind_[1] = hint;
+        computeInterpFactor(value, values, retval);
+        return retval;
     }
 
+    InterpData retval = findInterpData(value, values);
+    hint = retval.ind_[1];
     return retval;
 }
 
@@ -437,6 +516,187 @@ inline VFPEvaluation interpolate(
 
 
 
+/**
+ * Interpolates the values of a production table in the flo, wfr, gfr and alq
+ * directions for every value on the thp axis at once, without derivatives.
+ * Gives the values of interpolate() at each point of the thp axis, up to rounding.
+ */
+inline void interpolateTHPAxis(
+        const VFPProdTable::array_type& array,
+        const InterpData& flo_i,
+        const InterpData& wfr_i,
+        const InterpData& gfr_i,
+        const InterpData& alq_i,
+        std::vector<double>& values) {
+
+    const int nthp = array.shape()[0];
+    values.resize(nthp);
+
+    //Interpolation weights, in the same order of dimensions as in interpolate()
+    const double f2 = flo_i.factor_, f1 = 1.0-f2;
+    const double a2 = alq_i.factor_, a1 = 1.0-a2;
+    const double g2 = gfr_i.factor_, g1 = 1.0-g2;
+    const double w2 = wfr_i.factor_, w1 = 1.0-w2;
+
+    for (int t=0; t<nthp; ++t) {
+        double nn[2][2][2];
+        for (int w=0; w<=1; ++w) {
+            for (int g=0; g<=1; ++g) {
+                for (int a=0; a<=1; ++a) {
+                    const auto& row = array[t][wfr_i.ind_[w]][gfr_i.ind_[g]][alq_i.ind_[a]];
+                    nn[w][g][a] = f1*row[flo_i.ind_[0]] + f2*row[flo_i.ind_[1]];
+                }
+            }
+        }
+        for (int w=0; w<=1; ++w) {
+            for (int g=0; g<=1; ++g) {
+                nn[w][g][0] = a1*nn[w][g][0] + a2*nn[w][g][1];
+            }
+        }
+        for (int w=0; w<=1; ++w) {
+            nn[w][0][0] = g1*nn[w][0][0] + g2*nn[w][1][0];
+        }
+        values[t] = w1*nn[0][0][0] + w2*nn[1][0][0];
+    }
+}
+
+
+
+
+
+/**
+ * Fills the slice with the values of the production table at the given thp and alq.
+ */
+inline void buildTHPSlice(const VFPProdTable* table,
+        const double& thp,
+        const double& alq,
+        VFPProdTHPSlice& slice) {
+    const VFPProdTable::array_type& array = table->getTable();
+    const auto thp_i = findInterpData(thp, table->getTHPAxis());
+    const auto alq_i = findInterpData(alq, table->getALQAxis());
+
+    const int nwfr = array.shape()[1];
+    const int ngfr = array.shape()[2];
+    const int nflo = array.shape()[4];
+
+    //Interpolation weights
+    const double a2 = alq_i.factor_, a1 = 1.0-a2;
+    const double t2 = thp_i.factor_, t1 = 1.0-t2;
+
+    slice.table_ = table;
+    slice.thp_ = thp;
+    slice.alq_ = alq;
+    slice.values_.resize(nwfr*ngfr*nflo);
+    for (int w=0; w<nwfr; ++w) {
+        for (int g=0; g<ngfr; ++g) {
+            const auto& row00 = array[thp_i.ind_[0]][w][g][alq_i.ind_[0]];
+            const auto& row01 = array[thp_i.ind_[0]][w][g][alq_i.ind_[1]];
+            const auto& row10 = array[thp_i.ind_[1]][w][g][alq_i.ind_[0]];
+            const auto& row11 = array[thp_i.ind_[1]][w][g][alq_i.ind_[1]];
+            double* values = &slice.values_[(w*ngfr + g)*nflo];
+            for (int f=0; f<nflo; ++f) {
+                values[f] = t1*(a1*row00[f] + a2*row01[f]) + t2*(a1*row10[f] + a2*row11[f]);
+            }
+        }
+    }
+}
+
+
+
+
+
+/**
+ * Returns true if the bhp at the given thp and alq can be interpolated in the
+ * slice of the hint. The slice is built when the same table, thp and alq are
+ * used twice in a row, which is the case for a well under THP control, so
+ * evaluations at varying thp never pay for it.
+ */
+inline bool useTHPSlice(const VFPProdTable* table,
+        const double& thp,
+        const double& alq,
+        VFPProdTHPSlice& slice) {
+    if (slice.table_ == table && slice.thp_ == thp && slice.alq_ == alq) {
+        if (slice.values_.empty()) {
+            buildTHPSlice(table, thp, alq, slice);
+        }
+        return true;
+    }
+    slice.table_ = table;
+    slice.thp_ = thp;
+    slice.alq_ = alq;
+    slice.values_.clear();
+    return false;
+}
+
+
+
+
+
+/**
+ * Same as interpolate() of the full production table, in the slice at fixed
+ * thp and alq. The derivatives with respect to thp and alq are zero.
+ */
+inline VFPEvaluation interpolate(
+        const VFPProdTHPSlice& slice,
+        const InterpData& flo_i,
+        const InterpData& wfr_i,
+        const InterpData& gfr_i) {
+
+    const int ngfr = slice.table_->getGFRAxis().size();
+    const int nflo = slice.table_->getFloAxis().size();
+
+    //Values and derivatives in a 3D cube
+    VFPEvaluation nn[2][2][2];
+    for (int w=0; w<=1; ++w) {
+        for (int g=0; g<=1; ++g) {
+            for (int f=0; f<=1; ++f) {
+                const int wi = wfr_i.ind_[w];
+                const int gi = gfr_i.ind_[g];
+                const int fi = flo_i.ind_[f];
+                nn[w][g][f].value = slice.values_[(wi*ngfr + gi)*nflo + fi];
+            }
+        }
+    }
+
+    for (int i=0; i<=1; ++i) {
+        for (int j=0; j<=1; ++j) {
+            nn[0][i][j].dwfr = (nn[1][i][j].value - nn[0][i][j].value) * wfr_i.inv_dist_;
+            nn[i][0][j].dgfr = (nn[i][1][j].value - nn[i][0][j].value) * gfr_i.inv_dist_;
+            nn[i][j][0].dflo = (nn[i][j][1].value - nn[i][j][0].value) * flo_i.inv_dist_;
+
+            nn[1][i][j].dwfr = nn[0][i][j].dwfr;
+            nn[i][1][j].dgfr = nn[i][0][j].dgfr;
+            nn[i][j][1].dflo = nn[i][j][0].dflo;
+        }
+    }
+
+    double t1, t2; //interpolation variables, so that t1 = (1-t) and t2 = t.
+
+    t2 = flo_i.factor_;
+    t1 = (1.0-t2);
+    for (int w=0; w<=1; ++w) {
+        for (int g=0; g<=1; ++g) {
+            nn[w][g][0] = t1*nn[w][g][0] + t2*nn[w][g][1];
+        }
+    }
+
+    t2 = gfr_i.factor_;
+    t1 = (1.0-t2);
+    for (int w=0; w<=1; ++w) {
+        nn[w][0][0] = t1*nn[w][0][0] + t2*nn[w][1][0];
+    }
+
+    t2 = wfr_i.factor_;
+    t1 = (1.0-t2);
+    nn[0][0][0] = t1*nn[0][0][0] + t2*nn[1][0][0];
+
+    return nn[0][0][0];
+}
+
+
+
+
+
 /**
  * This basically models interpolate(VFPProdTable::array_type, ...)
  * which performs 5D interpolation, but here for the 2D case only
@@ -501,7 +761,8 @@ inline VFPEvaluation bhp(const VFPProdTable* table,
         const double& liquid,
         const double& vapour,
         const double& thp,
-        const double& alq) {
+        const double& alq,
+        VFPProdInterpHint* hint = nullptr) {
     //Find interpolation variables
     double flo = detail::getFlo(aqua, liquid, vapour, table->getFloType());
     double wfr = detail::getWFR(aqua, liquid, vapour, table->getWFRType());
@@ -509,11 +770,13 @@ inline VFPEvaluation bhp(const VFPProdTable* table,
 
     //First, find the values to interpolate between
     //Recall that flo is negative in Opm, so switch sign.
-    auto flo_i = detail::findInterpData(-flo, table->getFloAxis());
-    auto thp_i = detail::findInterpData( thp, table->getTHPAxis());
-    auto wfr_i = detail::findInterpData( wfr, table->getWFRAxis());
-    auto gfr_i = detail::findInterpData( gfr, table->getGFRAxis());
-    auto alq_i = detail::findInterpData( alq, table->getALQAxis());
+    VFPProdInterpHint no_hint;
+    VFPProdInterpHint& h = hint ? *hint : no_hint;
+    auto flo_i = detail::findInterpData(-flo, table->getFloAxis(), h.flo_);
+    auto thp_i = detail::findInterpData( thp, table->getTHPAxis(), h.thp_);
+    auto wfr_i = detail::findInterpData( wfr, table->getWFRAxis(), h.wfr_);
+    auto gfr_i = detail::findInterpData( gfr, table->getGFRAxis(), h.gfr_);
+    auto alq_i = detail::findInterpData( alq, table->getALQAxis(), h.alq_);
 
     detail::VFPEvaluation retval = detail::interpolate(table->getTable(), flo_i, thp_i, wfr_i, gfr_i, alq_i);
 
@@ -550,17 +813,29 @@ inline VFPEvaluation bhp(const VFPInjTable* table,
 
 
 /**
- * Returns the table from the map if found, or throws an exception
+ * Returns the table with the given number from the tables indexed by their
+ * numbers, or throws an exception if there is none
  */
 template <typename T>
-const T* getTable(const std::map<int, T*> tables, int table_id) {
-    auto entry = tables.find(table_id);
-    if (entry == tables.end()) {
+const T* getTable(const std::vector<const T*>& tables, int table_id) {
+    if (table_id < 0 || table_id >= static_cast<int>(tables.size()) || tables[table_id] == nullptr) {
         OPM_THROW(std::invalid_argument, "Nonexistent table " << table_id << " referenced.");
     }
-    else {
-        return entry->second;
+    return tables[table_id];
+}
+
+/**
+ * Adds a table to the tables indexed by their numbers
+ */
+template <typename T>
+void addTable(std::vector<const T*>& tables, int table_id, const T* table) {
+    if (table_id < 0) {
+        OPM_THROW(std::invalid_argument, "Invalid table number " << table_id << ".");
+    }
+    if (table_id >= static_cast<int>(tables.size())) {
+        tables.resize(table_id + 1, nullptr);
     }
+    tables[table_id] = table;
 }
 
 
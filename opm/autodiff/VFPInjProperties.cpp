@@ -55,7 +55,7 @@ VFPInjProperties::VFPInjProperties() {
 
 
 VFPInjProperties::VFPInjProperties(const VFPInjTable* table){
-    m_tables[table->getTableNum()] = table;
+    detail::addTable(m_tables, table->getTableNum(), table);
 }
 
 
@@ -63,7 +63,7 @@ VFPInjProperties::VFPInjProperties(const VFPInjTable* table){
 
 VFPInjProperties::VFPInjProperties(const std::map<int, std::shared_ptr<const VFPInjTable> >& tables) {
     for (const auto& table : tables) {
-        m_tables[table.first] = table.second.get();
+        detail::addTable(m_tables, table.first, table.second.get());
     }
 }
 
@@ -192,8 +192,8 @@ public:
     }
 
 private:
-    // Map which connects the table number with the table itself
-    std::map<int, const VFPInjTable*> m_tables;
+    // The tables indexed by their numbers, null for the unused numbers
+    std::vector<const VFPInjTable*> m_tables;
 };
 
 
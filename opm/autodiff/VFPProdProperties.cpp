@@ -42,7 +42,7 @@ VFPProdProperties::VFPProdProperties() {
 
 
 VFPProdProperties::VFPProdProperties(const VFPProdTable* table){
-    m_tables[table->getTableNum()] = table;
+    detail::addTable(m_tables, table->getTableNum(), table);
 }
 
 
@@ -50,7 +50,7 @@ VFPProdProperties::VFPProdProperties(const VFPProdTable* table){
 
 VFPProdProperties::VFPProdProperties(const std::map<int, std::shared_ptr<const VFPProdTable> >& tables) {
     for (const auto& table : tables) {
-        m_tables[table.first] = table.second.get();
+        detail::addTable(m_tables, table.first, table.second.get());
     }
 }
 
@@ -179,10 +179,24 @@ double VFPProdProperties::bhp(int table_id,
         const double& liquid,
         const double& vapour,
         const double& thp_arg,
-        const double& alq) const {
+        const double& alq,
+        detail::VFPProdInterpHint* hint) const {
+    ProfileScope scope(KernelCounters::VfpInterpolation);
     const VFPProdTable* table = detail::getTable(m_tables, table_id);
 
-    detail::VFPEvaluation retval = detail::bhp(table, aqua, liquid, vapour, thp_arg, alq);
+    if (hint && detail::useTHPSlice(table, thp_arg, alq, hint->thp_slice_)) {
+        double flo = detail::getFlo(aqua, liquid, vapour, table->getFloType());
+        double wfr = detail::getWFR(aqua, liquid, vapour, table->getWFRType());
+        double gfr = detail::getGFR(aqua, liquid, vapour, table->getGFRType());
+
+        //Recall that flo is negative in Opm, so switch sign.
+        auto flo_i = detail::findInterpData(-flo, table->getFloAxis(), hint->flo_);
+        auto wfr_i = detail::findInterpData( wfr, table->getWFRAxis(), hint->wfr_);
+        auto gfr_i = detail::findInterpData( gfr, table->getGFRAxis(), hint->gfr_);
+        return detail::interpolate(hint->thp_slice_, flo_i, wfr_i, gfr_i).value;
+    }
+
+    detail::VFPEvaluation retval = detail::bhp(table, aqua, liquid, vapour, thp_arg, alq, hint);
     return retval.value;
 }
 
@@ -193,7 +207,8 @@ double VFPProdProperties::thp(int table_id,
         const double& liquid,
         const double& vapour,
         const double& bhp_arg,
-        const double& alq) const {
+        const double& alq,
+        detail::VFPProdInterpHint* hint) const {
     const VFPProdTable* table = detail::getTable(m_tables, table_id);
     const VFPProdTable::array_type& data = table->getTable();
 
@@ -202,24 +217,21 @@ double VFPProdProperties::thp(int table_id,
     double wfr = detail::getWFR(aqua, liquid, vapour, table->getWFRType());
     double gfr = detail::getGFR(aqua, liquid, vapour, table->getGFRType());
 
-    const std::vector<double> thp_array = table->getTHPAxis();
-    int nthp = thp_array.size();
+    const std::vector<double>& thp_array = table->getTHPAxis();
 
     /**
      * Find the function bhp_array(thp) by creating a 1D view of the data
-     * by interpolating for every value of thp. This might be somewhat
-     * expensive, but let us assome that nthp is small
+     * by interpolating for every value of thp in one pass.
      * Recall that flo is negative in Opm, so switch the sign
      */
-    auto flo_i = detail::findInterpData(-flo, table->getFloAxis());
-    auto wfr_i = detail::findInterpData( wfr, table->getWFRAxis());
-    auto gfr_i = detail::findInterpData( gfr, table->getGFRAxis());
-    auto alq_i = detail::findInterpData( alq, table->getALQAxis());
-    std::vector<double> bhp_array(nthp);
-    for (int i=0; i<nthp; ++i) {
-        auto thp_i = detail::findInterpData(thp_array[i], thp_array);
-        bhp_array[i] = detail::interpolate(data, flo_i, thp_i, wfr_i, gfr_i, alq_i).value;
-    }
+    detail::VFPProdInterpHint no_hint;
+    detail::VFPProdInterpHint& h = hint ? *hint : no_hint;
+    auto flo_i = detail::findInterpData(-flo, table->getFloAxis(), h.flo_);
+    auto wfr_i = detail::findInterpData( wfr, table->getWFRAxis(), h.wfr_);
+    auto gfr_i = detail::findInterpData( gfr, table->getGFRAxis(), h.gfr_);
+    auto alq_i = detail::findInterpData( alq, table->getALQAxis(), h.alq_);
+    std::vector<double> bhp_array;
+    detail::interpolateTHPAxis(data, flo_i, wfr_i, gfr_i, alq_i, bhp_array);
 
     double retval = detail::findTHP(bhp_array, thp_array, bhp_arg);
     return retval;
@@ -25,6 +25,7 @@
 #include <opm/material/densead/Math.hpp>
 #include <opm/material/densead/Evaluation.hpp>
 #include <opm/autodiff/VFPHelpers.hpp>
+#include <opm/simulators/ProfileScope.hpp>
 
 #include <vector>
 #include <map>
@@ -116,6 +117,10 @@ public:
      * @param vapour Gas phase
      * @param thp Tubing head pressure
      * @param alq Artificial lift or other parameter
+     * @param hint Optional intervals of the last evaluation of the same well,
+     *             updated with the intervals found. Repeated evaluations at the
+     *             same thp and alq are interpolated in a slice of the table kept
+     *             in the hint.
      *
      * @return The bottom hole pressure, interpolated/extrapolated linearly using
      * the above parameters from the values in the input table, for each entry in the
@@ -127,7 +132,9 @@ public:
                  const EvalWell& liquid,
                  const EvalWell& vapour,
                  const double& thp,
-                 const double& alq) const {
+                 const double& alq,
+                 detail::VFPProdInterpHint* hint = nullptr) const {
+        ProfileScope scope(KernelCounters::VfpInterpolation);
 
         //Get the table
         const VFPProdTable* table = detail::getTable(m_tables, table_id);
@@ -142,13 +149,21 @@ public:
         if (table != nullptr) {
             //First, find the values to interpolate between
             //Value of FLO is negative in OPM for producers, but positive in VFP table
-            auto flo_i = detail::findInterpData(-flo.value(), table->getFloAxis());
-            auto thp_i = detail::findInterpData( thp, table->getTHPAxis()); // assume constant
-            auto wfr_i = detail::findInterpData( wfr.value(), table->getWFRAxis());
-            auto gfr_i = detail::findInterpData( gfr.value(), table->getGFRAxis());
-            auto alq_i = detail::findInterpData( alq, table->getALQAxis()); //assume constant
-
-            detail::VFPEvaluation bhp_val = detail::interpolate(table->getTable(), flo_i, thp_i, wfr_i, gfr_i, alq_i);
+            detail::VFPProdInterpHint no_hint;
+            detail::VFPProdInterpHint& h = hint ? *hint : no_hint;
+            auto flo_i = detail::findInterpData(-flo.value(), table->getFloAxis(), h.flo_);
+            auto wfr_i = detail::findInterpData( wfr.value(), table->getWFRAxis(), h.wfr_);
+            auto gfr_i = detail::findInterpData( gfr.value(), table->getGFRAxis(), h.gfr_);
+
+            detail::VFPEvaluation bhp_val;
+            if (hint && detail::useTHPSlice(table, thp, alq, h.thp_slice_)) {
+                bhp_val = detail::interpolate(h.thp_slice_, flo_i, wfr_i, gfr_i);
+            }
+            else {
+                auto thp_i = detail::findInterpData( thp, table->getTHPAxis(), h.thp_); // assume constant
+                auto alq_i = detail::findInterpData( alq, table->getALQAxis(), h.alq_); //assume constant
+                bhp_val = detail::interpolate(table->getTable(), flo_i, thp_i, wfr_i, gfr_i, alq_i);
+            }
 
             bhp = (bhp_val.dwfr * wfr) + (bhp_val.dgfr * gfr) - (bhp_val.dflo * flo);
             bhp.setValue(bhp_val.value);
@@ -167,6 +182,10 @@ public:
      * @param vapour Gas phase
      * @param thp Tubing head pressure
      * @param alq Artificial lift or other parameter
+     * @param hint Optional intervals of the last evaluation of the same well,
+     *             updated with the intervals found. Repeated evaluations at the
+     *             same thp and alq are interpolated in a slice of the table kept
+     *             in the hint.
      *
      * @return The bottom hole pressure, interpolated/extrapolated linearly using
      * the above parameters from the values in the input table.
@@ -176,7 +195,8 @@ public:
             const double& liquid,
             const double& vapour,
             const double& thp,
-            const double& alq) const;
+            const double& alq,
+            detail::VFPProdInterpHint* hint = nullptr) const;
 
     /**
      * Linear interpolation of thp as a function of the input parameters
@@ -186,6 +206,8 @@ public:
      * @param vapour Gas phase
      * @param bhp Bottom hole pressure
      * @param alq Artificial lift or other parameter
+     * @param hint Optional intervals of the last evaluation of the same well,
+     *             updated with the intervals found.
      *
      * @return The tubing hole pressure, interpolated/extrapolated linearly using
      * the above parameters from the values in the input table.
@@ -195,7 +217,8 @@ public:
             const double& liquid,
             const double& vapour,
             const double& bhp,
-            const double& alq) const;
+            const double& alq,
+            detail::VFPProdInterpHint* hint = nullptr) const;
 
     /**
      * Returns the table associated with the ID, or throws an exception if
@@ -211,8 +234,8 @@ public:
     }
 
 private:
-    // Map which connects the table number with the table itself
-    std::map<int, const VFPProdTable*> m_tables;
+    // The tables indexed by their numbers, null for the unused numbers
+    std::vector<const VFPProdTable*> m_tables;
 };
 
 
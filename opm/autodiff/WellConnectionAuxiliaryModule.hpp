@@ -29,6 +29,10 @@
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 namespace Opm
 {
 template<class TypeTag>
@@ -46,19 +50,21 @@ public:
     WellConnectionAuxiliaryModule(const Schedule& schedule,
                                   const Dune::CpGrid& grid)
     {
-        // Create cartesian to compressed mapping
+        // Create cartesian to compressed mapping of the active cells, sorted
+        // by the cartesian index, which is much smaller than a mapping of all
+        // cartesian cells if most of them are inactive
         const auto& globalCell = grid.globalCell();
         const auto& cartesianSize = grid.logicalCartesianSize();
 
-        auto size = cartesianSize[0]*cartesianSize[1]*cartesianSize[2];
-
-        std::vector<int> cartesianToCompressed(size, -1);
+        std::vector<std::pair<int, int> > cartesianToCompressed;
+        cartesianToCompressed.reserve(globalCell.size());
         auto begin = globalCell.begin();
 
         for ( auto cell = begin, end= globalCell.end(); cell != end; ++cell )
         {
-            cartesianToCompressed[ *cell ] = cell - begin;
+            cartesianToCompressed.emplace_back( *cell, cell - begin );
         }
+        std::sort(cartesianToCompressed.begin(), cartesianToCompressed.end());
 
         int last_time_step = schedule.getTimeMap().size() - 1;
         const auto& schedule_wells = schedule.getWells();
@@ -79,11 +85,14 @@ public:
                 int j = completion.getJ();
                 int k = completion.getK();
                 int cart_grid_idx = i + cartesianSize[0]*(j + cartesianSize[1]*k);
-                int compressed_idx = cartesianToCompressed[cart_grid_idx];
+                const auto entry = std::lower_bound(cartesianToCompressed.begin(),
+                                                    cartesianToCompressed.end(),
+                                                    std::make_pair(cart_grid_idx, 0));
 
-                if ( compressed_idx >= 0 ) // Ignore completions in inactive/remote cells.
+                // Ignore completions in inactive/remote cells.
+                if ( entry != cartesianToCompressed.end() && entry->first == cart_grid_idx )
                 {
-                    compressed_well_perforations.push_back(compressed_idx);
+                    compressed_well_perforations.push_back(entry->second);
                 }
             }
 
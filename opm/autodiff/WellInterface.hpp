@@ -42,8 +42,11 @@
 #include <opm/autodiff/WellHelpers.hpp>
 #include <opm/autodiff/WellStateFullyImplicitBlackoil.hpp>
 #include <opm/autodiff/BlackoilModelParameters.hpp>
+#include <opm/autodiff/CompactStaticArray.hpp>
 #include <opm/autodiff/RateConverter.hpp>
+#include <opm/autodiff/ParallelWellInfo.hpp>
 
+#include <opm/simulators/MemoryAccounting.hpp>
 #include <opm/simulators/WellSwitchingLogger.hpp>
 
 #include<dune/common/fmatrix.hh>
@@ -120,7 +123,7 @@ namespace Opm
         const int indexOfWell() const;
 
         /// Well cells.
-        const std::vector<int>& cells() {return well_cells_; }
+        const std::vector<int>& cells() const {return well_cells_; }
 
         /// Well type, INJECTOR or PRODUCER.
         WellType wellType() const;
@@ -130,8 +133,15 @@ namespace Opm
 
         void setVFPProperties(const VFPProperties* vfp_properties_arg);
 
+        /// The processes sharing the perforations of the well, null if the well
+        /// only lives on this process.
+        void setParallelWellInfo(const ParallelWellInfo* parallel_well_info_arg);
+
+        /// Whether the perforations of the well are distributed over several processes.
+        bool isDistributed() const;
+
         virtual void init(const PhaseUsage* phase_usage_arg,
-                          const std::vector<double>& depth_arg,
+                          const CompactStaticArray& depth_arg,
                           const double gravity_arg,
                           const int num_cells);
 
@@ -225,6 +235,16 @@ namespace Opm
         virtual void addWellContributions(Mat&) const
         {}
 
+        /// \brief Subtract the inflow of the well from the reservoir residual r at
+        ///        the current reservoir and well state, without assembling the
+        ///        Jacobian. The intensive quantities of the perforated cells must
+        ///        be cached.
+        /// \return False if the well does not support this.
+        virtual bool addReservoirResidual(const Simulator&, BVector&) const
+        {
+            return false;
+        }
+
         void solveWellForTesting(Simulator& ebosSimulator, WellState& well_state, const std::vector<double>& B_avg, bool terminal_output);
 
         void closeCompletions(WellTestState& wellTestState);
@@ -300,6 +320,8 @@ namespace Opm
 
         const VFPProperties* vfp_properties_;
 
+        const ParallelWellInfo* parallel_well_info_ = nullptr;
+
         double gravity_;
 
         // For the conversion between the surface volume rate and resrevoir voidage rate
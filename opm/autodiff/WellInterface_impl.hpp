@@ -113,7 +113,7 @@ namespace Opm
     void
     WellInterface<TypeTag>::
     init(const PhaseUsage* phase_usage_arg,
-         const std::vector<double>& /* depth_arg */,
+         const CompactStaticArray& /* depth_arg */,
          const double gravity_arg,
          const int /* num_cells */)
     {
@@ -137,6 +137,30 @@ namespace Opm
 
 
 
+    template<typename TypeTag>
+    void
+    WellInterface<TypeTag>::
+    setParallelWellInfo(const ParallelWellInfo* parallel_well_info_arg)
+    {
+        parallel_well_info_ = parallel_well_info_arg;
+    }
+
+
+
+
+
+    template<typename TypeTag>
+    bool
+    WellInterface<TypeTag>::
+    isDistributed() const
+    {
+        return parallel_well_info_ && parallel_well_info_->isDistributed();
+    }
+
+
+
+
+
     template<typename TypeTag>
     const std::string&
     WellInterface<TypeTag>::
@@ -933,7 +957,6 @@ namespace Opm
         int it = 0;
         const double dt = 1.0; //not used for the well tests
         bool converged;
-        WellState well_state0 = well_state;
         do {
             assembleWellEq(ebosSimulator, dt, well_state, true);
 
@@ -953,12 +976,19 @@ namespace Opm
             initPrimaryVariablesEvaluation();
         } while (it < max_iter);
 
+        // the wells can be tested concurrently, see BlackoilWellModel::wellTesting()
         if (converged) {
             if ( terminal_output ) {
+#if HAVE_OPENMP
+#pragma omp critical(wellTesting_log)
+#endif // HAVE_OPENMP
                 OpmLog::debug("WellTest: Well equation for well " + name() +  " solution gets converged with " + std::to_string(it) + " iterations");
             }
         } else {
             if ( terminal_output ) {
+#if HAVE_OPENMP
+#pragma omp critical(wellTesting_log)
+#endif // HAVE_OPENMP
                 OpmLog::debug("WellTest: Well equation for well" +name() + " solution failed in getting converged with " + std::to_string(it) + " iterations");
             }
         }
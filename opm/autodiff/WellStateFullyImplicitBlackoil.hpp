@@ -34,6 +34,7 @@
 #include <map>
 #include <algorithm>
 #include <array>
+#include <cstring>
 
 namespace Opm
 {
@@ -84,14 +85,16 @@ namespace Opm
             well_dissolved_gas_rates_.resize(nw, 0.0);
             well_vaporized_oil_rates_.resize(nw, 0.0);
 
-            is_new_well_.resize(nw, true);
-            if (prevState && !prevState->wellMap().empty()) {
-                const auto& end = prevState->wellMap().end();
-                for (int w = 0; w < nw; ++w) {
-                    const auto& it = prevState->wellMap().find( wells->name[w]);
-                    if (it != end) {
-                        is_new_well_[w] = false;
-                    }
+            // the index of each well in the previous state, -1 for new wells
+            std::vector<int> prev_index(nw, -1);
+            if (prevState) {
+                prevState->findWells(wells, prev_index);
+            }
+
+            is_new_well_.assign(nw, true);
+            for (int w = 0; w < nw; ++w) {
+                if (prev_index[w] >= 0) {
+                    is_new_well_[w] = false;
                 }
             }
 
@@ -129,16 +132,13 @@ namespace Opm
             perfRateSolvent_.resize(nperf, 0.0);
 
             // intialize wells that have been there before
-            // order may change so the mapping is based on the well name
+            // order may change so the mapping is based on the well name, see findWells()
             if(prevState && !prevState->wellMap().empty()) {
-                typedef typename WellMapType :: const_iterator const_iterator;
-                const_iterator end = prevState->wellMap().end();
+                const Wells* prev_wells = prevState->wells_.get();
                 for (int w = 0; w < nw; ++w) {
-                    std::string name( wells->name[ w ] );
-                    const_iterator it = prevState->wellMap().find( name );
-                    if( it != end )
+                    if( prev_index[ w ] >= 0 )
                     {
-                        const int oldIndex = (*it).second[ 0 ];
+                        const int oldIndex = prev_index[ w ];
                         const int newIndex = w;
 
                         // bhp
@@ -154,19 +154,16 @@ namespace Opm
                         }
 
                         // perfPhaseRates
-                        const int oldPerf_idx_beg = (*it).second[ 1 ];
-                        const int num_perf_old_well = (*it).second[ 2 ];
+                        const int oldPerf_idx_beg = prev_wells->well_connpos[ oldIndex ];
+                        const int num_perf_old_well = prev_wells->well_connpos[ oldIndex + 1 ] - oldPerf_idx_beg;
                         const int num_perf_this_well = wells->well_connpos[newIndex + 1] - wells->well_connpos[newIndex];
                         // copy perforation rates when the number of perforations is equal,
                         // otherwise initialize perfphaserates to well rates divided by the number of perforations.
                         if( num_perf_old_well == num_perf_this_well )
                         {
-                            int old_perf_phase_idx = oldPerf_idx_beg *np;
-                            for (int perf_phase_idx = wells->well_connpos[ newIndex ]*np;
-                                 perf_phase_idx < wells->well_connpos[ newIndex + 1]*np; ++perf_phase_idx, ++old_perf_phase_idx )
-                            {
-                                perfPhaseRates()[ perf_phase_idx ] = prevState->perfPhaseRates()[ old_perf_phase_idx ];
-                            }
+                            std::copy(prevState->perfPhaseRates().begin() + oldPerf_idx_beg*np,
+                                      prevState->perfPhaseRates().begin() + (oldPerf_idx_beg + num_perf_old_well)*np,
+                                      perfPhaseRates().begin() + wells->well_connpos[ newIndex ]*np);
                         } else {
                             for (int perf = wells->well_connpos[newIndex]; perf < wells->well_connpos[newIndex + 1]; ++perf) {
                                 for (int p = 0; p < np; ++p) {
@@ -219,6 +216,7 @@ namespace Opm
             {
                 // we need to create a trival segment related values to avoid there will be some
                 // multi-segment wells added later.
+                top_segment_index_.clear();
                 top_segment_index_.reserve(nw);
                 for (int w = 0; w < nw; ++w) {
                     top_segment_index_.push_back(w);
@@ -424,12 +422,12 @@ namespace Opm
         std::vector<int>& currentControls() { return current_controls_; }
         const std::vector<int>& currentControls() const { return current_controls_; }
 
-        data::Wells report(const PhaseUsage &pu, const int* globalCellIdxMap) const override
+        void updateReport(const PhaseUsage &pu, const int* globalCellIdxMap, data::Wells& res) const override
         {
-            data::Wells res = WellState::report(pu, globalCellIdxMap);
+            WellState::updateReport(pu, globalCellIdxMap, res);
 
             const int nw = this->numWells();
-            if( nw == 0 ) return res;
+            if( nw == 0 ) return;
             const int np = pu.num_phases;
 
 
@@ -496,8 +494,6 @@ namespace Opm
                 }
                 assert(local_comp_index == this->wells_->well_connpos[ w + 1 ] - this->wells_->well_connpos[ w ]);
             }
-
-            return res;
         }
 
 
@@ -700,6 +696,53 @@ namespace Opm
             is_new_well_[w] = is_new_well;
         }
 
+        /// Write the state to a snapshot, see SimulatorSnapshot.hpp.
+        template <class Writer>
+        void writeSnapshot(Writer& writer) const
+        {
+            writer.write(bhp());
+            writer.write(thp());
+            writer.write(temperature());
+            writer.write(wellRates());
+            writer.write(perfRates());
+            writer.write(perfPress());
+            writer.write(perfphaserates_);
+            writer.write(current_controls_);
+            writer.write(perfRateSolvent_);
+            writer.write(well_reservoir_rates_);
+            writer.write(well_dissolved_gas_rates_);
+            writer.write(well_vaporized_oil_rates_);
+            writer.write(is_new_well_);
+            writer.write(segrates_);
+            writer.write(segpress_);
+            writer.write(top_segment_index_);
+            writer.write(nseg_);
+        }
+
+        /// Read the state written by writeSnapshot(). The state needs to be
+        /// resized for the same wells before, the segments are read as written.
+        template <class Reader>
+        void readSnapshot(Reader& reader)
+        {
+            reader.readSameSize(bhp(), "bhp");
+            reader.readSameSize(thp(), "thp");
+            reader.readSameSize(temperature(), "temperature");
+            reader.readSameSize(wellRates(), "wellRates");
+            reader.readSameSize(perfRates(), "perfRates");
+            reader.readSameSize(perfPress(), "perfPress");
+            reader.readSameSize(perfphaserates_, "perfPhaseRates");
+            reader.readSameSize(current_controls_, "currentControls");
+            reader.readSameSize(perfRateSolvent_, "perfRateSolvent");
+            reader.readSameSize(well_reservoir_rates_, "wellReservoirRates");
+            reader.readSameSize(well_dissolved_gas_rates_, "wellDissolvedGasRates");
+            reader.readSameSize(well_vaporized_oil_rates_, "wellVaporizedOilRates");
+            reader.readSameSize(is_new_well_, "isNewWell");
+            reader.read(segrates_);
+            reader.read(segpress_);
+            reader.read(top_segment_index_);
+            reader.read(nseg_);
+        }
+
 
         /// One rate pr well connection.
         std::vector<double>& perfRateSolvent() { return perfRateSolvent_; }
@@ -761,6 +804,22 @@ namespace Opm
             return top_segment_index_[w];
         }
 
+        /// The bytes of the arrays of the state, including their spare capacity.
+        std::size_t memoryBytes() const
+        {
+            std::size_t bytes = 0;
+            for (const std::vector<double>* v : { &bhp(), &thp(), &temperature(), &wellRates(),
+                                                  &perfRates(), &perfPress(), &perfphaserates_,
+                                                  &perfRateSolvent_, &well_reservoir_rates_,
+                                                  &well_dissolved_gas_rates_, &well_vaporized_oil_rates_,
+                                                  &segrates_, &segpress_ }) {
+                bytes += v->capacity() * sizeof(double);
+            }
+            bytes += (current_controls_.capacity() + top_segment_index_.capacity()) * sizeof(int);
+            bytes += is_new_well_.capacity() / 8;
+            return bytes;
+        }
+
     private:
         std::vector<double> perfphaserates_;
         std::vector<int> current_controls_;
@@ -793,6 +852,31 @@ namespace Opm
         std::vector<int> top_segment_index_;
         int nseg_; // total number of the segments
 
+        // find the index of each well of wells in this state, -1 if it is not present.
+        // wells which kept their position, which is mostly the case between report
+        // steps, are found without looking up their name in the well map.
+        void findWells(const Wells* wells, std::vector<int>& indices) const
+        {
+            const int nw = wells->number_of_wells;
+            indices.assign(nw, -1);
+            if (wellMap().empty()) {
+                return;
+            }
+
+            const int own_nw = wells_ ? wells_->number_of_wells : 0;
+            const auto end = wellMap().end();
+            for (int w = 0; w < nw; ++w) {
+                if (w < own_nw && std::strcmp(wells->name[w], wells_->name[w]) == 0) {
+                    indices[w] = w;
+                } else {
+                    const auto it = wellMap().find(wells->name[w]);
+                    if (it != end) {
+                        indices[w] = it->second[0];
+                    }
+                }
+            }
+        }
+
     };
 
 } // namespace Opm
@@ -279,6 +279,162 @@ fastSparseSubstract(Lhs& lhs, const Rhs& rhs)
     }
 }
 
+// this function adds scale times a diagonal to a sparse matrix in place
+// if the sparsity pattern already contains the complete diagonal, otherwise
+// the matrix is left unchanged and false is returned
+inline bool
+fastSparseAddDiagonal(Eigen::SparseMatrix<double>& lhs,
+                      const std::vector<double>& diag,
+                      const double scale = 1.0)
+{
+    if( ! lhs.isCompressed() )
+    {
+        return false;
+    }
+
+    const int n = std::min( lhs.rows(), lhs.cols() );
+    const auto* outer = lhs.outerIndexPtr();
+    const auto* inner = lhs.innerIndexPtr();
+
+    // locate all diagonal entries before changing anything
+    std::vector<int> position( n );
+    for( int i = 0; i < n; ++i )
+    {
+        const auto* begin = inner + outer[ i ];
+        const auto* end = inner + outer[ i + 1 ];
+        const auto* entry = std::lower_bound( begin, end, i );
+        if( entry == end || *entry != i )
+        {
+            return false;
+        }
+        position[ i ] = entry - inner;
+    }
+
+    double* values = lhs.valuePtr();
+    for( int i = 0; i < n; ++i )
+    {
+        values[ position[ i ] ] += scale * diag[ i ];
+    }
+    return true;
+}
+
+// this function computes res = lhs * rhs using only the existing sparsity
+// pattern of res, i.e. without any symbolic work or allocation. If a non zero
+// of the product is not part of the pattern false is returned and the values
+// of res are undefined. Entries of the pattern that are not hit become zero.
+template<typename Lhs, typename Rhs>
+inline bool
+fastSparseProductInPattern(const Lhs& lhs, const Rhs& rhs, Eigen::SparseMatrix<double>& res)
+{
+    if( ! res.isCompressed() || res.rows() != lhs.rows() || res.cols() != rhs.cols() )
+    {
+        return false;
+    }
+
+    const int cols = res.cols();
+    const auto* outer = res.outerIndexPtr();
+    const auto* inner = res.innerIndexPtr();
+    double* values = res.valuePtr();
+    std::fill( values, values + res.nonZeros(), 0.0 );
+
+    // position of each row within the current column of res
+    std::vector<int> position( res.rows(), -1 );
+    for( int j = 0; j < cols; ++j )
+    {
+        for( int k = outer[ j ]; k < outer[ j + 1 ]; ++k )
+        {
+            position[ inner[ k ] ] = k;
+        }
+
+        bool fits = true;
+        for( typename Rhs::InnerIterator rhsIt( rhs, j ); rhsIt && fits; ++rhsIt )
+        {
+            const double y = rhsIt.value();
+            for( typename Lhs::InnerIterator lhsIt( lhs, rhsIt.index() ); lhsIt; ++lhsIt )
+            {
+                const int k = position[ lhsIt.index() ];
+                if( k < 0 )
+                {
+                    fits = false;
+                    break;
+                }
+                values[ k ] += lhsIt.value() * y;
+            }
+        }
+
+        for( int k = outer[ j ]; k < outer[ j + 1 ]; ++k )
+        {
+            position[ inner[ k ] ] = -1;
+        }
+        if( ! fits )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// this function computes res = lhs + scale * rhs using only the existing
+// sparsity pattern of res, see fastSparseProductInPattern
+inline bool
+fastSparseAddInPattern(const Eigen::SparseMatrix<double>& lhs,
+                       const double scale,
+                       const Eigen::SparseMatrix<double>& rhs,
+                       Eigen::SparseMatrix<double>& res)
+{
+    if( ! res.isCompressed() || res.rows() != lhs.rows() || res.cols() != lhs.cols()
+        || rhs.rows() != lhs.rows() || rhs.cols() != lhs.cols() )
+    {
+        return false;
+    }
+
+    typedef Eigen::SparseMatrix<double>::InnerIterator It;
+    const int cols = res.cols();
+    const auto* outer = res.outerIndexPtr();
+    const auto* inner = res.innerIndexPtr();
+    double* values = res.valuePtr();
+    std::fill( values, values + res.nonZeros(), 0.0 );
+
+    std::vector<int> position( res.rows(), -1 );
+    for( int j = 0; j < cols; ++j )
+    {
+        for( int k = outer[ j ]; k < outer[ j + 1 ]; ++k )
+        {
+            position[ inner[ k ] ] = k;
+        }
+
+        bool fits = true;
+        for( It it( lhs, j ); it && fits; ++it )
+        {
+            const int k = position[ it.index() ];
+            fits = ( k >= 0 );
+            if( fits )
+            {
+                values[ k ] += it.value();
+            }
+        }
+        for( It it( rhs, j ); it && fits; ++it )
+        {
+            const int k = position[ it.index() ];
+            fits = ( k >= 0 );
+            if( fits )
+            {
+                values[ k ] += scale * it.value();
+            }
+        }
+
+        for( int k = outer[ j ]; k < outer[ j + 1 ]; ++k )
+        {
+            position[ inner[ k ] ] = -1;
+        }
+        if( ! fits )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // end namespace Opm
 
 #endif // OPM_FASTSPARSEPRODUCT_HEADER_INCLUDED
@@ -20,8 +20,6 @@
 
 
 #include <opm/autodiff/multiPhaseUpwind.hpp>
-#include <algorithm>
-#include <utility>
 
 
 namespace Opm
@@ -34,55 +32,8 @@ namespace Opm
                                                      const double transmissibility,
                                                      const double flux)
     {
-        // Based on the paper "Upstream Differencing for Multiphase Flow in Reservoir Simulation",
-        // by Yann Brenier and Jérôme Jaffré,
-        // SIAM J. Numer. Anal., 28(3), 685–696.
-        // DOI:10.1137/0728036
-        //
-        // Notation is based on this paper, except q -> flux, t -> transmissibility.
-
-        enum { NumPhases = 3 }; // TODO: remove this restriction.
-
-        // Get and sort the g values (also called "weights" in the paper) for this connection.
-        using ValueAndIndex = std::pair<double, int>;
-        std::array<ValueAndIndex, NumPhases> g;
-        for (int phase_idx = 0; phase_idx < NumPhases; ++phase_idx) {
-            g[phase_idx] = ValueAndIndex(head_diff[phase_idx], phase_idx);
-        }
-        std::sort(g.begin(), g.end());
-
-        // Compute theta and r.
-        // Paper notation: subscript l -> ell (for read/searchability)
-        // Note that since we index phases from 0, r is one less than in the paper.
-        std::array<double, NumPhases> theta;
-        int r = -1;
-        for (int ell = 0; ell < NumPhases; ++ell) {
-            theta[ell] = flux;
-            for (int j = 0; j < NumPhases; ++j) {
-                if (j < ell) {
-                    theta[ell] += transmissibility * (g[ell].first - g[j].first) * mob2[g[j].second];
-                }
-                if (j > ell) {
-                    theta[ell] += transmissibility * (g[ell].first - g[j].first) * mob1[g[j].second];
-                }
-            }
-            if (theta[ell] <= 0.0) {
-                r = ell;
-            } else {
-                break; // r is correct, no need to continue
-            }
-        }
-
-        // Set upwind array and return.
-        std::array<double, NumPhases> upwind;
-        for (int ell = 0; ell < NumPhases; ++ell) {
-            const int phase_idx = g[ell].second;
-            upwind[phase_idx] = ell > r ? 1.0 : -1.0;
-        }
-        return upwind;
-
+        return connectionMultiPhaseUpwind<3>(head_diff, mob1, mob2, transmissibility, flux);
     }
 
 
 } // namespace Opm
-
@@ -25,6 +25,112 @@
 
 namespace Opm
 {
+    namespace detail
+    {
+        // Order (g[a], idx[a]) and (g[b], idx[b]) ascending by value, then
+        // by index, without branches.
+        inline void upwindCompareSwap(double* g, int* idx, const int a, const int b)
+        {
+            const bool swap = g[b] < g[a] || (g[b] == g[a] && idx[b] < idx[a]);
+            const double ga = g[a];
+            const int ia = idx[a];
+            g[a] = swap ? g[b] : ga;
+            idx[a] = swap ? idx[b] : ia;
+            g[b] = swap ? ga : g[b];
+            idx[b] = swap ? ia : idx[b];
+        }
+    } // namespace detail
+
+    /// Compute upwind directions for multi-phase flow across a connection.
+    ///
+    /// The phases are ordered by an odd-even transposition sorting network,
+    /// which the compiler unrolls for a fixed number of phases.
+    ///
+    /// @tparam     NumPhases           number of phases
+    /// @param[in]  head_diff           head differences by phase
+    /// @param[in]  mob1                phase mobilities for first cell
+    /// @param[in]  mob2                phase mobilities for second cell
+    /// @param[in]  transmissibility    tranmissibility of connection
+    /// @param[in]  flux                total volume flux across connection
+    /// @return array containing, for each phase, 1.0 if flow in the
+    ///         direction of the connection, -1.0 if flow in the opposite
+    ///         direction.
+    template <int NumPhases>
+    inline std::array<double, NumPhases>
+    connectionMultiPhaseUpwind(const std::array<double, NumPhases>& head_diff,
+                               const std::array<double, NumPhases>& mob1,
+                               const std::array<double, NumPhases>& mob2,
+                               const double transmissibility,
+                               const double flux)
+    {
+        // Based on the paper "Upstream Differencing for Multiphase Flow in Reservoir Simulation",
+        // by Yann Brenier and Jérôme Jaffré,
+        // SIAM J. Numer. Anal., 28(3), 685–696.
+        // DOI:10.1137/0728036
+        //
+        // Notation is based on this paper, except q -> flux, t -> transmissibility.
+
+        // Get and sort the g values (also called "weights" in the paper) for this connection.
+        double g[NumPhases];
+        int idx[NumPhases];
+        for (int phase_idx = 0; phase_idx < NumPhases; ++phase_idx) {
+            g[phase_idx] = head_diff[phase_idx];
+            idx[phase_idx] = phase_idx;
+        }
+        for (int round = 0; round < NumPhases; ++round) {
+            for (int ell = round % 2; ell + 1 < NumPhases; ell += 2) {
+                detail::upwindCompareSwap(g, idx, ell, ell + 1);
+            }
+        }
+
+        // Compute theta and r.
+        // Paper notation: subscript l -> ell (for read/searchability)
+        // Note that since we index phases from 0, r is one less than in the paper.
+        int r = -1;
+        for (int ell = 0; ell < NumPhases; ++ell) {
+            double theta = flux;
+            for (int j = 0; j < ell; ++j) {
+                theta += transmissibility * (g[ell] - g[j]) * mob2[idx[j]];
+            }
+            for (int j = ell + 1; j < NumPhases; ++j) {
+                theta += transmissibility * (g[ell] - g[j]) * mob1[idx[j]];
+            }
+            if (theta <= 0.0) {
+                r = ell;
+            } else {
+                break; // r is correct, no need to continue
+            }
+        }
+
+        // Set upwind array and return.
+        std::array<double, NumPhases> upwind;
+        for (int ell = 0; ell < NumPhases; ++ell) {
+            upwind[idx[ell]] = ell > r ? 1.0 : -1.0;
+        }
+        return upwind;
+    }
+
+    /// Compute upwind directions for multi-phase flow across many connections,
+    /// see the single connection version for the arguments.
+    ///
+    /// @param[in]  num_connections     number of connections
+    /// @param[out] upwind              upwind directions by connection
+    template <int NumPhases>
+    inline void
+    connectionMultiPhaseUpwind(const int num_connections,
+                               const std::array<double, NumPhases>* head_diff,
+                               const std::array<double, NumPhases>* mob1,
+                               const std::array<double, NumPhases>* mob2,
+                               const double* transmissibility,
+                               const double* flux,
+                               std::array<double, NumPhases>* upwind)
+    {
+        for (int conn = 0; conn < num_connections; ++conn) {
+            upwind[conn] = connectionMultiPhaseUpwind<NumPhases>(head_diff[conn], mob1[conn], mob2[conn],
+                                                                 transmissibility[conn], flux[conn]);
+        }
+    }
+
     /// Compute upwind directions for three-phase flow across a connection.
     ///
     /// @param[in]  head_diff           head differences by phase
@@ -109,9 +109,10 @@ namespace Opm
         solution.resize(num_cells, inf);
         is_accepted_.clear();
         is_accepted_.resize(num_cells, false);
-        accepted_front_.clear();
+        is_on_front_.clear();
+        is_on_front_.resize(num_cells, false);
         considered_.clear();
-        considered_handles_.clear();
+        considered_handles_.resize(num_cells);
         is_considered_.clear();
         is_considered_.resize(num_cells, false);
 
@@ -121,7 +122,9 @@ namespace Opm
             is_accepted_[startcells[ii]] = true;
             solution[startcells[ii]] = 0.0;
         }
-        accepted_front_.insert(startcells.begin(), startcells.end());
+        for (int ii = 0; ii < num_startcells; ++ii) {
+            updateFront(startcells[ii]);
+        }
 
         // 3. Move cells adjacent to startcells to Considered, evaluate
         //    U_i = min_{(x_j,x_k) \in NF(x_i)} G_{j,k}
@@ -147,31 +150,23 @@ namespace Opm
             is_accepted_[rcell] = true;
             solution[rcell] = r.first;
             popConsidered();
-            accepted_front_.insert(rcell);
-            for (auto it = accepted_front_.begin(); it != accepted_front_.end();) {
-                // Note that loop increment happens in the body of this loop.
-                const int cell = *it;
-                bool on_front = false;
-                for (auto it2 = cell_neighbours_[cell].begin(); it2 != cell_neighbours_[cell].end(); ++it2) {
-                    if (!is_accepted_[*it2]) {
-                        on_front = true;
-                        break;
-                    }
-                }
-                if (!on_front) {
-                    accepted_front_.erase(it++);
-                } else {
-                    ++it;
+            // Only r and its neighbours may enter or leave the front.
+            updateFront(rcell);
+            for (auto it = cell_neighbours_[rcell].begin(); it != cell_neighbours_[rcell].end(); ++it) {
+                if (is_on_front_[*it]) {
+                    updateFront(*it);
                 }
             }
 
             // 6. Recompute the value for all Considered cells within
             //    distance h * F_2/F1 from x_r. Use min of previous and new.
-            for (auto it = considered_.begin(); it != considered_.end(); ++it) {
-                const int ccell = it->second;
-                if (isClose(rcell, ccell)) {
+            //    The update only involves triangles and lines with r as a
+            //    corner, so only the Considered neighbours of r can change.
+            for (auto it = cell_neighbours_[rcell].begin(); it != cell_neighbours_[rcell].end(); ++it) {
+                const int ccell = *it;
+                if (is_considered_[ccell] && isClose(rcell, ccell)) {
                     const double value = computeValueUpdate(ccell, metric, solution.data(), rcell);
-                    if (value < it->first) {
+                    if (value < (*considered_handles_[ccell]).first) {
                         // Update value for considered cell.
                         // Note that as solution values decrease, their
                         // goodness w.r.t. the heap comparator increase,
@@ -224,7 +219,7 @@ namespace Opm
         double val = inf;
         for (int ii = 0; ii < num_nbs; ++ii) {
             const int n[2] = { nbs[ii], nbs[(ii+1) % num_nbs] };
-            if (accepted_front_.count(n[0]) && accepted_front_.count(n[1])) {
+            if (is_on_front_[n[0]] && is_on_front_[n[1]]) {
                 const double cand_val = computeFromTri(cell, n[0], n[1], metric, solution);
                 val = std::min(val, cand_val);
             }
@@ -233,7 +228,7 @@ namespace Opm
             // Failed to find two accepted front nodes adjacent to this,
             // so we go for a single-neighbour update.
             for (int ii = 0; ii < num_nbs; ++ii) {
-                if (accepted_front_.count(nbs[ii])) {
+                if (is_on_front_[nbs[ii]]) {
                     const double cand_val = computeFromLine(cell, nbs[ii], metric, solution);
                     val = std::min(val, cand_val);
                 }
@@ -261,7 +256,7 @@ namespace Opm
         for (int ii = 0; ii < num_nbs; ++ii) {
             const int n[2] = { nbs[ii], nbs[(ii+1) % num_nbs] };
             if ((n[0] == new_cell || n[1] == new_cell)
-                && accepted_front_.count(n[0]) && accepted_front_.count(n[1])) {
+                && is_on_front_[n[0]] && is_on_front_[n[1]]) {
                 const double cand_val = computeFromTri(cell, n[0], n[1], metric, solution);
                 val = std::min(val, cand_val);
             }
@@ -270,7 +265,7 @@ namespace Opm
             // Failed to find two accepted front nodes adjacent to this,
             // so we go for a single-neighbour update.
             for (int ii = 0; ii < num_nbs; ++ii) {
-                if (nbs[ii] == new_cell && accepted_front_.count(nbs[ii])) {
+                if (nbs[ii] == new_cell && is_on_front_[nbs[ii]]) {
                     const double cand_val = computeFromLine(cell, nbs[ii], metric, solution);
                     val = std::min(val, cand_val);
                 }
@@ -381,13 +376,28 @@ namespace Opm
     void AnisotropicEikonal2d::popConsidered()
     {
         is_considered_[considered_.top().second] = false;
-        considered_handles_.erase(considered_.top().second);
         considered_.pop();
     }
 
 
 
 
+
+    void AnisotropicEikonal2d::updateFront(const int cell)
+    {
+        bool on_front = false;
+        for (auto it = cell_neighbours_[cell].begin(); it != cell_neighbours_[cell].end(); ++it) {
+            if (!is_accepted_[*it]) {
+                on_front = true;
+                break;
+            }
+        }
+        is_on_front_[cell] = on_front;
+    }
+
+
+
+
     void AnisotropicEikonal2d::computeGridRadius()
     {
         const int num_cells = cell_neighbours_.size();
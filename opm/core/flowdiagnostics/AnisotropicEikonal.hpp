@@ -22,8 +22,6 @@
 
 #include <opm/grid/utility/SparseTable.hpp>
 #include <vector>
-#include <set>
-#include <map>
 
 #include <opm/common/utility/platform_dependent/disable_warnings.h>
 
@@ -67,9 +65,10 @@ namespace Opm
         const UnstructuredGrid& grid_;
         SparseTable<int> cell_neighbours_;
 
-        // Keep track of accepted cells.
+        // Keep track of accepted cells. The accepted front are the accepted
+        // cells that have a neighbour that is not accepted.
         std::vector<char> is_accepted_;
-        std::set<int> accepted_front_;
+        std::vector<char> is_on_front_;
 
         // Quantities relating to anisotropy.
         std::vector<double> grid_radius_;
@@ -82,7 +81,7 @@ namespace Opm
         typedef boost::heap::fibonacci_heap<ValueAndCell, Comparator> Heap;
         Heap considered_;
         typedef Heap::handle_type HeapHandle;
-        std::map<int, HeapHandle> considered_handles_;
+        std::vector<HeapHandle> considered_handles_;
         std::vector<char> is_considered_;
 
         bool isClose(const int c1, const int c2) const;
@@ -94,6 +93,7 @@ namespace Opm
         const ValueAndCell& topConsidered() const;
         void pushConsidered(const ValueAndCell& vc);
         void popConsidered();
+        void updateFront(const int cell);
 
         void computeGridRadius();
         void computeAnisoRatio(const double* metric);
@@ -0,0 +1,193 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/core/flowdiagnostics/FlowDiagnosticsEnsemble.hpp>
+#include <opm/core/flowdiagnostics/FlowDiagnostics.hpp>
+#include <opm/core/flowdiagnostics/TofReorder.hpp>
+#include <opm/core/utility/OmpExceptionGuard.hpp>
+#include <opm/core/wells.h>
+#include <opm/grid/UnstructuredGrid.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if HAVE_OPENMP
+#include <omp.h>
+#endif // HAVE_OPENMP
+
+namespace Opm
+{
+
+    namespace
+    {
+        // Values of the piecewise linear curve (x, y) at the samples, with x
+        // ascending. Constant outside the range of x.
+        std::vector<double> sampleCurve(const std::vector<double>& x,
+                                        const std::vector<double>& y,
+                                        const std::vector<double>& samples)
+        {
+            std::vector<double> values(samples.size(), 0.0);
+            if (x.empty()) {
+                return values;
+            }
+            for (std::size_t k = 0; k < samples.size(); ++k) {
+                const double s = samples[k];
+                const auto it = std::lower_bound(x.begin(), x.end(), s);
+                if (it == x.begin()) {
+                    values[k] = y.front();
+                } else if (it == x.end()) {
+                    values[k] = y.back();
+                } else {
+                    const auto i = it - x.begin();
+                    const double w = (s - x[i-1]) / std::max(x[i] - x[i-1], 1e-300);
+                    values[k] = (1.0 - w) * y[i-1] + w * y[i];
+                }
+            }
+            return values;
+        }
+    } // anonymous namespace
+
+
+
+    // Solvers and buffers of one thread.
+    struct FlowDiagnosticsEnsemble::Worker
+    {
+        explicit Worker(const UnstructuredGrid& grid)
+            : forward(grid), backward(grid)
+        {
+        }
+        TofReorder forward;
+        TofReorder backward;
+        std::vector<double> porevol;
+        std::vector<double> reverse_flux;
+        std::vector<double> reverse_source;
+        std::vector<double> ftof;
+        std::vector<double> btof;
+        std::vector<double> ftracer;
+        std::vector<double> btracer;
+    };
+
+
+
+    FlowDiagnosticsEnsemble::FlowDiagnosticsEnsemble(const UnstructuredGrid& grid,
+                                                     const Wells& wells,
+                                                     const std::vector<double>& storage_capacity_samples,
+                                                     const std::vector<double>& time_samples)
+        : grid_(grid),
+          wells_(wells),
+          storage_capacity_samples_(storage_capacity_samples),
+          time_samples_(time_samples)
+    {
+        for (int w = 0; w < wells.number_of_wells; ++w) {
+            const int* begin = wells.well_cells + wells.well_connpos[w];
+            const int* end = wells.well_cells + wells.well_connpos[w + 1];
+            if (wells.type[w] == INJECTOR) {
+                injector_cells_.appendRow(begin, end);
+            } else {
+                producer_cells_.appendRow(begin, end);
+            }
+        }
+    }
+
+
+
+    FlowDiagnosticsEnsemble::~FlowDiagnosticsEnsemble()
+    {
+    }
+
+
+
+    std::vector<FlowDiagnosticsEnsemble::Statistics>
+    FlowDiagnosticsEnsemble::compute(const std::vector<FlowField>& fields)
+    {
+        int num_threads = 1;
+#if HAVE_OPENMP
+        num_threads = omp_get_max_threads();
+#endif // HAVE_OPENMP
+        while (int(workers_.size()) < num_threads) {
+            workers_.emplace_back(new Worker(grid_));
+        }
+
+        const int num_fields = fields.size();
+        std::vector<Statistics> stats(num_fields);
+        detail::OmpExceptionGuard guard;
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif // HAVE_OPENMP
+        for (int i = 0; i < num_fields; ++i) {
+            int thread = 0;
+#if HAVE_OPENMP
+            thread = omp_get_thread_num();
+#endif // HAVE_OPENMP
+            try {
+                computeRealization(fields[i], *workers_[thread], stats[i]);
+            }
+            catch (...) {
+                guard.capture();
+            }
+        }
+        guard.rethrow();
+        return stats;
+    }
+
+
+
+    void FlowDiagnosticsEnsemble::computeRealization(const FlowField& field,
+                                                     Worker& worker,
+                                                     Statistics& stats) const
+    {
+        const int num_cells = grid_.number_of_cells;
+        const int num_faces = grid_.number_of_faces;
+        worker.porevol.assign(field.porevolume, field.porevolume + num_cells);
+
+        // Forward time-of-flight from the injectors.
+        worker.forward.solveTofTracer(field.darcyflux, field.porevolume, field.source,
+                                      injector_cells_, worker.ftof, worker.ftracer);
+
+        // Backward time-of-flight to the producers, in the reversed field.
+        worker.reverse_flux.resize(num_faces);
+        worker.reverse_source.resize(num_cells);
+        for (int f = 0; f < num_faces; ++f) {
+            worker.reverse_flux[f] = -field.darcyflux[f];
+        }
+        for (int c = 0; c < num_cells; ++c) {
+            worker.reverse_source[c] = -field.source[c];
+        }
+        worker.backward.solveTofTracer(worker.reverse_flux.data(), field.porevolume,
+                                       worker.reverse_source.data(),
+                                       producer_cells_, worker.btof, worker.btracer);
+
+        // Cells without flow have no tracer values.
+        for (auto& t : worker.ftracer) {
+            t = std::isfinite(t) ? t : 0.0;
+        }
+        for (auto& t : worker.btracer) {
+            t = std::isfinite(t) ? t : 0.0;
+        }
+
+        const auto fphi = computeFandPhi(worker.porevol, worker.ftof, worker.btof);
+        stats.lorenz = computeLorenz(fphi.first, fphi.second);
+        stats.flow_capacity = sampleCurve(fphi.second, fphi.first, storage_capacity_samples_);
+        const auto sweep = computeSweep(fphi.first, fphi.second);
+        stats.sweep_efficiency = sampleCurve(sweep.second, sweep.first, time_samples_);
+        stats.well_pairs = computeWellPairs(wells_, worker.porevol, worker.ftracer, worker.btracer);
+    }
+
+} // namespace Opm
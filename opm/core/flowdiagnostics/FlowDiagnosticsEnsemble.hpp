@@ -0,0 +1,101 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_FLOWDIAGNOSTICSENSEMBLE_HEADER_INCLUDED
+#define OPM_FLOWDIAGNOSTICSENSEMBLE_HEADER_INCLUDED
+
+#include <opm/grid/utility/SparseTable.hpp>
+
+#include <memory>
+#include <tuple>
+#include <vector>
+
+struct UnstructuredGrid;
+struct Wells;
+
+namespace Opm
+{
+
+    /// Flow diagnostics of many flux fields on the same grid and wells,
+    /// for instance the realizations of a history matching ensemble.
+    ///
+    /// The tracer heads of the wells are set up once. Every thread keeps a
+    /// forward and a backward TofReorder solver, with their buffers, for all
+    /// the realizations it processes. Consecutive realizations with the same
+    /// upwind directions therefore reuse the reordering of the previous one.
+    class FlowDiagnosticsEnsemble
+    {
+    public:
+        /// One realization.
+        struct FlowField
+        {
+            const double* darcyflux;   ///< Signed flux of each face.
+            const double* porevolume;  ///< Pore volume of each cell.
+            const double* source;      ///< Source of each cell, (+) inflow, (-) outflow.
+        };
+
+        /// Compact diagnostics of one realization.
+        struct Statistics
+        {
+            /// Lorenz coefficient, see computeLorenz().
+            double lorenz;
+            /// Flow capacity F at the storage capacity samples.
+            std::vector<double> flow_capacity;
+            /// Sweep efficiency at the dimensionless time samples.
+            std::vector<double> sweep_efficiency;
+            /// Injector, producer and pore volume of each well pair, see computeWellPairs().
+            std::vector<std::tuple<int, int, double> > well_pairs;
+        };
+
+        /// Construct the ensemble solver.
+        /// \param[in] grid                   The grid shared by all realizations.
+        /// \param[in] wells                  The wells shared by all realizations.
+        /// \param[in] storage_capacity_samples  Values of Phi at which F is reported.
+        /// \param[in] time_samples           Dimensionless times (PVI) at which the sweep
+        ///                                   efficiency is reported.
+        FlowDiagnosticsEnsemble(const UnstructuredGrid& grid,
+                                const Wells& wells,
+                                const std::vector<double>& storage_capacity_samples,
+                                const std::vector<double>& time_samples);
+
+        ~FlowDiagnosticsEnsemble();
+
+        /// Compute the diagnostics of all realizations, concurrently if
+        /// OpenMP is available.
+        /// \param[in] fields  The realizations.
+        /// \return            The statistics of each realization, in the order of fields.
+        std::vector<Statistics> compute(const std::vector<FlowField>& fields);
+
+    private:
+        struct Worker;
+
+        void computeRealization(const FlowField& field, Worker& worker, Statistics& stats) const;
+
+        const UnstructuredGrid& grid_;
+        const Wells& wells_;
+        std::vector<double> storage_capacity_samples_;
+        std::vector<double> time_samples_;
+        SparseTable<int> injector_cells_;
+        SparseTable<int> producer_cells_;
+        std::vector<std::unique_ptr<Worker> > workers_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_FLOWDIAGNOSTICSENSEMBLE_HEADER_INCLUDED
@@ -34,6 +34,10 @@
 #include <numeric>
 #include <iostream>
 
+#if HAVE_OPENMP
+#include <omp.h>
+#endif // HAVE_OPENMP
+
 namespace Opm
 {
 
@@ -47,8 +51,7 @@ namespace Opm
           limiter_relative_flux_threshold_(1e-3),
           limiter_method_(MinUpwindAverage),
           limiter_usage_(DuringComputations),
-          coord_(grid.dimensions),
-          velocity_(grid.dimensions),
+          cache_quadrature_(false),
           gauss_seidel_tol_(1e-3)
     {
         const int dg_degree = param.getDefault("dg_degree", 0);
@@ -96,6 +99,20 @@ namespace Opm
         } else {
             velocity_interpolation_.reset(new VelocityInterpolationConstant(grid_));
         }
+
+        // The basis function values in the quadrature points only depend on
+        // the grid, so they may be computed once for all solves.
+        cache_quadrature_ = param.getDefault("cache_quadrature", cache_quadrature_);
+        if (cache_quadrature_) {
+            const int num_cells = grid_.number_of_cells;
+            cell_quadrature_.resize(num_cells);
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
+            for (int cell = 0; cell < num_cells; ++cell) {
+                computeCellQuadrature(cell, cell_quadrature_[cell]);
+            }
+        }
     }
 
 
@@ -122,18 +139,12 @@ namespace Opm
         tof_coeff.resize(num_basis*grid_.number_of_cells);
         std::fill(tof_coeff.begin(), tof_coeff.end(), 0.0);
         tof_coeff_ = &tof_coeff[0];
-        rhs_.resize(num_basis);
-        jac_.resize(num_basis*num_basis);
-        orig_jac_.resize(num_basis*num_basis);
-        basis_.resize(num_basis);
-        basis_nb_.resize(num_basis);
-        grad_basis_.resize(num_basis*grid_.dimensions);
         velocity_interpolation_->setupFluxes(darcyflux);
         num_tracers_ = 0;
+        setupLocalData();
         num_multicell_ = 0;
         max_size_multicell_ = 0;
         max_iter_multicell_ = 0;
-        num_singlesolves_ = 0;
         reorderAndTransport(grid_, darcyflux);
         switch (limiter_usage_) {
         case AsPostProcess:
@@ -149,11 +160,15 @@ namespace Opm
             OPM_THROW(std::runtime_error, "Unknown limiter usage choice: " << limiter_usage_);
         }
         if (num_multicell_ > 0) {
+            int num_singlesolves = 0;
+            for (const auto& ld : local_data_) {
+                num_singlesolves += ld.num_singlesolves;
+            }
             std::cout << num_multicell_ << " multicell blocks with max size "
                       << max_size_multicell_ << " cells in upto "
                       << max_iter_multicell_ << " iterations." << std::endl;
             std::cout << "Average solves per cell (for all cells) was "
-                      << double(num_singlesolves_)/double(grid_.number_of_cells) << std::endl;
+                      << double(num_singlesolves)/double(grid_.number_of_cells) << std::endl;
         }
     }
 
@@ -201,12 +216,6 @@ namespace Opm
         tof_coeff.resize(num_basis*grid_.number_of_cells);
         std::fill(tof_coeff.begin(), tof_coeff.end(), 0.0);
         tof_coeff_ = &tof_coeff[0];
-        rhs_.resize(num_basis*(num_tracers_ + 1));
-        jac_.resize(num_basis*num_basis);
-        orig_jac_.resize(num_basis*num_basis);
-        basis_.resize(num_basis);
-        basis_nb_.resize(num_basis);
-        grad_basis_.resize(num_basis*grid_.dimensions);
         velocity_interpolation_->setupFluxes(darcyflux);
 
         // Set up tracer
@@ -227,10 +236,10 @@ namespace Opm
         }
 
         tracer_coeff_ = &tracer_coeff[0];
+        setupLocalData();
         num_multicell_ = 0;
         max_size_multicell_ = 0;
         max_iter_multicell_ = 0;
-        num_singlesolves_ = 0;
         reorderAndTransport(grid_, darcyflux);
         switch (limiter_usage_) {
         case AsPostProcess:
@@ -246,11 +255,15 @@ namespace Opm
             OPM_THROW(std::runtime_error, "Unknown limiter usage choice: " << limiter_usage_);
         }
         if (num_multicell_ > 0) {
+            int num_singlesolves = 0;
+            for (const auto& ld : local_data_) {
+                num_singlesolves += ld.num_singlesolves;
+            }
             std::cout << num_multicell_ << " multicell blocks with max size "
                       << max_size_multicell_ << " cells in upto "
                       << max_iter_multicell_ << " iterations." << std::endl;
             std::cout << "Average solves per cell (for all cells) was "
-                      << double(num_singlesolves_)/double(grid_.number_of_cells) << std::endl;
+                      << double(num_singlesolves)/double(grid_.number_of_cells) << std::endl;
         }
     }
 
@@ -272,44 +285,45 @@ namespace Opm
         // For tracers, the equation is the same, except for the last
         // term being zero (the one with \phi).
         //
-        // The rhs_ vector contains a (Fortran ordering) matrix of all
-        // right-hand-sides, first for tof and then (optionally) for
-        // all tracers.
+        // The rhs vector of the thread's local data contains a
+        // (Fortran ordering) matrix of all right-hand-sides, first
+        // for tof and then (optionally) for all tracers.
 
         const int num_basis = basis_func_->numBasisFunc();
-        ++num_singlesolves_;
+        LocalData& ld = localData();
+        ++ld.num_singlesolves;
 
-        std::fill(rhs_.begin(), rhs_.end(), 0.0);
-        std::fill(jac_.begin(), jac_.end(), 0.0);
+        std::fill(ld.rhs.begin(), ld.rhs.end(), 0.0);
+        std::fill(ld.jac.begin(), ld.jac.end(), 0.0);
 
-        // Add cell contributions to res_ and jac_.
-        cellContribs(cell);
+        // Add cell contributions to rhs and jac.
+        cellContribs(cell, ld);
 
-        // Add face contributions to res_ and jac_.
-        faceContribs(cell);
+        // Add face contributions to rhs and jac.
+        faceContribs(cell, ld);
 
         // Solve linear equation.
-        solveLinearSystem(cell);
+        solveLinearSystem(cell, ld);
 
-        // The solution ends up in rhs_, so we must copy it.
-        std::copy(rhs_.begin(), rhs_.begin() + num_basis, tof_coeff_ + num_basis*cell);
+        // The solution ends up in rhs, so we must copy it.
+        std::copy(ld.rhs.begin(), ld.rhs.begin() + num_basis, tof_coeff_ + num_basis*cell);
         if (num_tracers_ && tracerhead_by_cell_[cell] == NoTracerHead) {
-            std::copy(rhs_.begin() + num_basis, rhs_.end(), tracer_coeff_ + num_tracers_*num_basis*cell);
+            std::copy(ld.rhs.begin() + num_basis, ld.rhs.end(), tracer_coeff_ + num_tracers_*num_basis*cell);
         }
 
         // Apply limiter.
         if (basis_func_->degree() > 0 && use_limiter_ && limiter_usage_ == DuringComputations) {
-            applyLimiter(cell, tof_coeff_);
+            applyLimiter(cell, tof_coeff_, ld);
             if (num_tracers_ && tracerhead_by_cell_[cell] == NoTracerHead) {
                 for (int tr = 0; tr < num_tracers_; ++tr) {
-                    applyTracerLimiter(cell, tracer_coeff_ + cell*num_tracers_*num_basis + tr*num_basis);
+                    applyTracerLimiter(cell, tracer_coeff_ + cell*num_tracers_*num_basis + tr*num_basis, ld);
                 }
             }
         }
 
         // Ensure that tracer averages sum to 1.
         if (num_tracers_ && tracers_ensure_unity_ && tracerhead_by_cell_[cell] == NoTracerHead) {
-            std::vector<double> tr_aver(num_tracers_);
+            std::vector<double>& tr_aver = ld.tracer_average;
             double tr_sum = 0.0;
             for (int tr = 0; tr < num_tracers_; ++tr) {
                 const double* local_basis = tracer_coeff_ + cell*num_tracers_*num_basis + tr*num_basis;
@@ -331,77 +345,140 @@ namespace Opm
 
 
 
-    void TofDiscGalReorder::cellContribs(const int cell)
+    void TofDiscGalReorder::setupLocalData()
     {
         const int num_basis = basis_func_->numBasisFunc();
         const int dim = grid_.dimensions;
+        int num_threads = 1;
+#if HAVE_OPENMP
+        num_threads = omp_get_max_threads();
+#endif // HAVE_OPENMP
+        local_data_.resize(num_threads);
+        for (auto& ld : local_data_) {
+            ld.rhs.resize(num_basis*(num_tracers_ + 1));
+            ld.jac.resize(num_basis*num_basis);
+            ld.orig_jac.resize(num_basis*num_basis);
+            ld.coord.resize(dim);
+            ld.basis.resize(num_basis);
+            ld.basis_nb.resize(num_basis);
+            ld.velocity.resize(dim);
+            ld.tracer_average.resize(num_tracers_);
+            ld.num_singlesolves = 0;
+        }
+    }
 
-        // Compute cell residual contribution.
-        {
-            const int deg_needed = basis_func_->degree();
-            CellQuadrature quad(grid_, cell, deg_needed);
-            for (int quad_pt = 0; quad_pt < quad.numQuadPts(); ++quad_pt) {
-                // Integral of: b_i \phi
-                quad.quadPtCoord(quad_pt, &coord_[0]);
-                basis_func_->eval(cell, &coord_[0], &basis_[0]);
-                const double w = quad.quadPtWeight(quad_pt);
-                for (int j = 0; j < num_basis; ++j) {
-                    // Only adding to the tof rhs.
-                    rhs_[j] += w * basis_[j] * porevolume_[cell] / grid_.cell_volumes[cell];
-                }
-            }
+
+
+
+    TofDiscGalReorder::LocalData& TofDiscGalReorder::localData()
+    {
+#if HAVE_OPENMP
+        return local_data_[omp_get_thread_num()];
+#else
+        return local_data_[0];
+#endif // HAVE_OPENMP
+    }
+
+
+
+
+    bool TofDiscGalReorder::supportsConcurrentSolves() const
+    {
+        // All scratch data of the single-cell solves is per thread, but the
+        // ECVI velocity interpolation is not safe to use concurrently.
+        return !use_cvi_;
+    }
+
+
+
+
+    void TofDiscGalReorder::computeCellQuadrature(const int cell, CellQuadratureData& data) const
+    {
+        const int num_basis = basis_func_->numBasisFunc();
+        const int dim = grid_.dimensions;
+
+        // Even with ECVI velocity interpolation, degree of precision 1
+        // is sufficient for optimal convergence order for DG1 when we
+        // use linear (total degree 1) basis functions.
+        // With bi(tri)-linear basis functions, it still seems sufficient
+        // for convergence order 2, but the solution looks much better and
+        // has significantly lower error with degree of precision 2.
+        // For now, we err on the side of caution, and use 2*degree, even
+        // though this is wasteful for the pure linear basis functions.
+        // const int deg_needed = 2*basis_func_->degree() - 1;
+        const int deg_needed = 2*basis_func_->degree();
+        CellQuadrature quad(grid_, cell, deg_needed);
+        const int num_quad_pts = quad.numQuadPts();
+        data.weight.resize(num_quad_pts);
+        data.coord.resize(num_quad_pts*dim);
+        data.basis.resize(num_quad_pts*num_basis);
+        data.grad_basis.resize(num_quad_pts*num_basis*dim);
+        for (int quad_pt = 0; quad_pt < num_quad_pts; ++quad_pt) {
+            double* coord = &data.coord[quad_pt*dim];
+            quad.quadPtCoord(quad_pt, coord);
+            data.weight[quad_pt] = quad.quadPtWeight(quad_pt);
+            basis_func_->eval(cell, coord, &data.basis[quad_pt*num_basis]);
+            basis_func_->evalGrad(cell, coord, &data.grad_basis[quad_pt*num_basis*dim]);
         }
+    }
 
-        // Compute cell jacobian contribution. We use Fortran ordering
-        // for jac_, i.e. rows cycling fastest.
-        {
-            // Even with ECVI velocity interpolation, degree of precision 1
-            // is sufficient for optimal convergence order for DG1 when we
-            // use linear (total degree 1) basis functions.
-            // With bi(tri)-linear basis functions, it still seems sufficient
-            // for convergence order 2, but the solution looks much better and
-            // has significantly lower error with degree of precision 2.
-            // For now, we err on the side of caution, and use 2*degree, even
-            // though this is wasteful for the pure linear basis functions.
-            // const int deg_needed = 2*basis_func_->degree() - 1;
-            const int deg_needed = 2*basis_func_->degree();
-            CellQuadrature quad(grid_, cell, deg_needed);
-            for (int quad_pt = 0; quad_pt < quad.numQuadPts(); ++quad_pt) {
-                // b_i (v \cdot \grad b_j)
-                quad.quadPtCoord(quad_pt, &coord_[0]);
-                basis_func_->eval(cell, &coord_[0], &basis_[0]);
-                basis_func_->evalGrad(cell, &coord_[0], &grad_basis_[0]);
-                velocity_interpolation_->interpolate(cell, &coord_[0], &velocity_[0]);
-                const double w = quad.quadPtWeight(quad_pt);
-                for (int j = 0; j < num_basis; ++j) {
-                    for (int i = 0; i < num_basis; ++i) {
-                        for (int dd = 0; dd < dim; ++dd) {
-                            jac_[j*num_basis + i] -= w * basis_[j] * grad_basis_[dim*i + dd] * velocity_[dd];
-                        }
-                    }
-                }
-            }
+
+
+
+    void TofDiscGalReorder::cellContribs(const int cell, LocalData& ld)
+    {
+        const int num_basis = basis_func_->numBasisFunc();
+        const int dim = grid_.dimensions;
+
+        // All cell integrals use the quadrature of computeCellQuadrature(),
+        // which is exact for the rhs integrand of degree basis_func_->degree().
+        const CellQuadratureData* quad = &ld.cell_quadrature;
+        if (cache_quadrature_) {
+            quad = &cell_quadrature_[cell];
+        } else {
+            computeCellQuadrature(cell, ld.cell_quadrature);
         }
 
-        // Compute downstream jacobian contribution from sink terms.
+        // Contribution from sink terms.
         // Contribution from inflow sources would be
         // similar to the contribution from upstream faces, but
         // it is zero since we let all external inflow be associated
         // with a zero tof.
+        double sink_density = 0.0;
         if (source_[cell] < 0.0) {
-            // A sink.
-            const double flux = -source_[cell]; // Sign convention for flux: outflux > 0.
-            const double flux_density = flux / grid_.cell_volumes[cell];
-            // Do quadrature over the cell to compute
+            // A sink. Sign convention for flux: outflux > 0.
+            sink_density = -source_[cell] / grid_.cell_volumes[cell];
+        }
+        const double pv_density = porevolume_[cell] / grid_.cell_volumes[cell];
+
+        // We use Fortran ordering for jac, i.e. rows cycling fastest.
+        const int num_quad_pts = quad->weight.size();
+        for (int quad_pt = 0; quad_pt < num_quad_pts; ++quad_pt) {
+            const double w = quad->weight[quad_pt];
+            const double* basis = &quad->basis[quad_pt*num_basis];
+            const double* grad_basis = &quad->grad_basis[quad_pt*num_basis*dim];
+            velocity_interpolation_->interpolate(cell, &quad->coord[quad_pt*dim], &ld.velocity[0]);
+
+            // Integral of: b_i \phi
+            for (int j = 0; j < num_basis; ++j) {
+                // Only adding to the tof rhs.
+                ld.rhs[j] += w * basis[j] * pv_density;
+            }
+
+            // b_i (v \cdot \grad b_j)
+            for (int j = 0; j < num_basis; ++j) {
+                for (int i = 0; i < num_basis; ++i) {
+                    for (int dd = 0; dd < dim; ++dd) {
+                        ld.jac[j*num_basis + i] -= w * basis[j] * grad_basis[dim*i + dd] * ld.velocity[dd];
+                    }
+                }
+            }
+
             // \int_{K} b_i flux b_j dx
-            CellQuadrature quad(grid_, cell, 2*basis_func_->degree());
-            for (int quad_pt = 0; quad_pt < quad.numQuadPts(); ++quad_pt) {
-                quad.quadPtCoord(quad_pt, &coord_[0]);
-                basis_func_->eval(cell, &coord_[0], &basis_[0]);
-                const double w = quad.quadPtWeight(quad_pt);
+            if (sink_density > 0.0) {
                 for (int j = 0; j < num_basis; ++j) {
                     for (int i = 0; i < num_basis; ++i) {
-                        jac_[j*num_basis + i] += w * basis_[i] * flux_density * basis_[j];
+                        ld.jac[j*num_basis + i] += w * basis[i] * sink_density * basis[j];
                     }
                 }
             }
@@ -411,7 +488,7 @@ namespace Opm
 
 
 
-    void TofDiscGalReorder::faceContribs(const int cell)
+    void TofDiscGalReorder::faceContribs(const int cell, LocalData& ld)
     {
         const int num_basis = basis_func_->numBasisFunc();
 
@@ -448,23 +525,23 @@ namespace Opm
             const int deg_needed = 2*basis_func_->degree();
             FaceQuadrature quad(grid_, face, deg_needed);
             for (int quad_pt = 0; quad_pt < quad.numQuadPts(); ++quad_pt) {
-                quad.quadPtCoord(quad_pt, &coord_[0]);
-                basis_func_->eval(cell, &coord_[0], &basis_[0]);
-                basis_func_->eval(upstream_cell, &coord_[0], &basis_nb_[0]);
+                quad.quadPtCoord(quad_pt, &ld.coord[0]);
+                basis_func_->eval(cell, &ld.coord[0], &ld.basis[0]);
+                basis_func_->eval(upstream_cell, &ld.coord[0], &ld.basis_nb[0]);
                 const double w = quad.quadPtWeight(quad_pt);
                 // Modify tof rhs
-                const double tof_upstream = std::inner_product(basis_nb_.begin(), basis_nb_.end(),
+                const double tof_upstream = std::inner_product(ld.basis_nb.begin(), ld.basis_nb.end(),
                                                                tof_coeff_ + num_basis*upstream_cell, 0.0);
                 for (int j = 0; j < num_basis; ++j) {
-                    rhs_[j] -= w * tof_upstream * normal_velocity * basis_[j];
+                    ld.rhs[j] -= w * tof_upstream * normal_velocity * ld.basis[j];
                 }
                 // Modify tracer rhs
                 if (num_tracers_ && tracerhead_by_cell_[cell] == NoTracerHead) {
                     for (int tr = 0; tr < num_tracers_; ++tr) {
                         const double* up_tr_co = tracer_coeff_ + num_tracers_*num_basis*upstream_cell + num_basis*tr;
-                        const double tracer_up = std::inner_product(basis_nb_.begin(), basis_nb_.end(), up_tr_co, 0.0);
+                        const double tracer_up = std::inner_product(ld.basis_nb.begin(), ld.basis_nb.end(), up_tr_co, 0.0);
                         for (int j = 0; j < num_basis; ++j) {
-                            rhs_[num_basis*(tr + 1) + j] -= w * tracer_up * normal_velocity * basis_[j];
+                            ld.rhs[num_basis*(tr + 1) + j] -= w * tracer_up * normal_velocity * ld.basis[j];
                         }
                     }
                 }
@@ -490,12 +567,12 @@ namespace Opm
             FaceQuadrature quad(grid_, face, 2*basis_func_->degree());
             for (int quad_pt = 0; quad_pt < quad.numQuadPts(); ++quad_pt) {
                 // u^ext flux B   (B = {b_j})
-                quad.quadPtCoord(quad_pt, &coord_[0]);
-                basis_func_->eval(cell, &coord_[0], &basis_[0]);
+                quad.quadPtCoord(quad_pt, &ld.coord[0]);
+                basis_func_->eval(cell, &ld.coord[0], &ld.basis[0]);
                 const double w = quad.quadPtWeight(quad_pt);
                 for (int j = 0; j < num_basis; ++j) {
                     for (int i = 0; i < num_basis; ++i) {
-                        jac_[j*num_basis + i] += w * basis_[i] * normal_velocity * basis_[j];
+                        ld.jac[j*num_basis + i] += w * ld.basis[i] * normal_velocity * ld.basis[j];
                     }
                 }
             }
@@ -504,11 +581,11 @@ namespace Opm
 
 
 
-    // This function assumes that jac_ and rhs_ contain the
-    // linear system to be solved. They are stored in orig_jac_
-    // and orig_rhs_, then the system is solved via LAPACK,
-    // overwriting the input data (jac_ and rhs_).
-    void TofDiscGalReorder::solveLinearSystem(const int cell)
+    // This function assumes that ld.jac and ld.rhs contain the
+    // linear system to be solved. They are stored in ld.orig_jac
+    // and ld.orig_rhs, then the system is solved via LAPACK,
+    // overwriting the input data (ld.jac and ld.rhs).
+    void TofDiscGalReorder::solveLinearSystem(const int cell, LocalData& ld)
     {
         MAT_SIZE_T n = basis_func_->numBasisFunc();
         int num_tracer_to_compute = num_tracers_;
@@ -522,22 +599,22 @@ namespace Opm
         std::vector<MAT_SIZE_T> piv(n);
         MAT_SIZE_T ldb = n;
         MAT_SIZE_T info = 0;
-        orig_jac_ = jac_;
-        orig_rhs_ = rhs_;
-        dgesv_(&n, &nrhs, &jac_[0], &lda, &piv[0], &rhs_[0], &ldb, &info);
+        ld.orig_jac = ld.jac;
+        ld.orig_rhs = ld.rhs;
+        dgesv_(&n, &nrhs, &ld.jac[0], &lda, &piv[0], &ld.rhs[0], &ldb, &info);
         if (info != 0) {
             // Print the local matrix and rhs.
             std::cerr << "Failed solving single-cell system Ax = b in cell " << cell
                       << " with A = \n";
             for (int row = 0; row < n; ++row) {
                 for (int col = 0; col < n; ++col) {
-                    std::cerr << "    " << orig_jac_[row + n*col];
+                    std::cerr << "    " << ld.orig_jac[row + n*col];
                 }
                 std::cerr << '\n';
             }
             std::cerr << "and b = \n";
             for (int row = 0; row < n; ++row) {
-                std::cerr << "    " << orig_rhs_[row] << '\n';
+                std::cerr << "    " << ld.orig_rhs[row] << '\n';
             }
             OPM_THROW(std::runtime_error, "Lapack error: " << info << " encountered in cell " << cell);
         }
@@ -548,8 +625,14 @@ namespace Opm
 
     void TofDiscGalReorder::solveMultiCell(const int num_cells, const int* cells)
     {
-        ++num_multicell_;
-        max_size_multicell_ = std::max(max_size_multicell_, num_cells);
+        // Components may be solved concurrently, see supportsConcurrentSolves().
+#if HAVE_OPENMP
+#pragma omp critical(TofDiscGalReorder_multicell_statistics)
+#endif // HAVE_OPENMP
+        {
+            ++num_multicell_;
+            max_size_multicell_ = std::max(max_size_multicell_, num_cells);
+        }
         // std::cout << "Multiblock solve with " << num_cells << " cells." << std::endl;
 
         // Using a Gauss-Seidel approach.
@@ -568,20 +651,23 @@ namespace Opm
             }
             // std::cout << "Max delta = " << max_delta << std::endl;
         }
+#if HAVE_OPENMP
+#pragma omp critical(TofDiscGalReorder_multicell_statistics)
+#endif // HAVE_OPENMP
         max_iter_multicell_ = std::max(max_iter_multicell_, num_iter);
     }
 
 
 
 
-    void TofDiscGalReorder::applyLimiter(const int cell, double* tof)
+    void TofDiscGalReorder::applyLimiter(const int cell, double* tof, LocalData& ld)
     {
         switch (limiter_method_) {
         case MinUpwindFace:
-            applyMinUpwindLimiter(cell, true, tof);
+            applyMinUpwindLimiter(cell, true, tof, ld);
             break;
         case MinUpwindAverage:
-            applyMinUpwindLimiter(cell, false, tof);
+            applyMinUpwindLimiter(cell, false, tof, ld);
             break;
         default:
             OPM_THROW(std::runtime_error, "Limiter type not implemented: " << limiter_method_);
@@ -591,7 +677,7 @@ namespace Opm
 
 
 
-    void TofDiscGalReorder::applyMinUpwindLimiter(const int cell, const bool face_min, double* tof)
+    void TofDiscGalReorder::applyMinUpwindLimiter(const int cell, const bool face_min, double* tof, LocalData& ld)
     {
         if (basis_func_->degree() != 1) {
             OPM_THROW(std::runtime_error, "This limiter only makes sense for our DG1 implementation.");
@@ -633,13 +719,13 @@ namespace Opm
 
             // Find minimum tof in this cell and upstream.
             // The meaning of minimum upstream tof depends on method.
-            min_here_tof = std::min(min_here_tof, minCornerVal(cell, face));
+            min_here_tof = std::min(min_here_tof, minCornerVal(cell, face, ld));
             if (upstream) {
                 ++num_upstream_faces;
                 double upstream_tof = 0.0;
                 if (interior) {
                     if (face_min) {
-                        upstream_tof = minCornerVal(upstream_cell, face);
+                        upstream_tof = minCornerVal(upstream_cell, face, ld);
                     } else {
                         upstream_tof = basis_func_->functionAverage(tof_coeff_ + num_basis*upstream_cell);
                     }
@@ -688,9 +774,10 @@ namespace Opm
         const std::vector<int>& seq = ReorderSolverInterface::sequence();
         const int nc = seq.size();
         assert(nc == grid_.number_of_cells);
+        LocalData& ld = localData();
         for (int i = 0; i < nc; ++i) {
             const int cell = seq[i];
-            applyLimiter(cell, tof_coeff_);
+            applyLimiter(cell, tof_coeff_, ld);
         }
     }
 
@@ -705,8 +792,9 @@ namespace Opm
         // Afterwards we copy the results back to tof_coeff_.
         const int num_basis = basis_func_->numBasisFunc();
         std::vector<double> tof_coeffs_new(tof_coeff_, tof_coeff_ + num_basis*grid_.number_of_cells);
+        LocalData& ld = localData();
         for (int c = 0; c < grid_.number_of_cells; ++c) {
-            applyLimiter(c, &tof_coeffs_new[0]);
+            applyLimiter(c, &tof_coeffs_new[0], ld);
         }
         std::copy(tof_coeffs_new.begin(), tof_coeffs_new.end(), tof_coeff_);
     }
@@ -742,7 +830,7 @@ namespace Opm
 
 
 
-    double TofDiscGalReorder::minCornerVal(const int cell, const int face) const
+    double TofDiscGalReorder::minCornerVal(const int cell, const int face, LocalData& ld) const
     {
         // Evaluate the solution in all corners.
         const int dim = grid_.dimensions;
@@ -750,8 +838,8 @@ namespace Opm
         double min_cornerval = 1e100;
         for (int fnode = grid_.face_nodepos[face]; fnode < grid_.face_nodepos[face+1]; ++fnode) {
             const double* nc = grid_.node_coordinates + dim*grid_.face_nodes[fnode];
-            basis_func_->eval(cell, nc, &basis_[0]);
-            const double tof_corner = std::inner_product(basis_.begin(), basis_.end(),
+            basis_func_->eval(cell, nc, &ld.basis[0]);
+            const double tof_corner = std::inner_product(ld.basis.begin(), ld.basis.end(),
                                                          tof_coeff_ + num_basis*cell, 0.0);
             min_cornerval = std::min(min_cornerval, tof_corner);
         }
@@ -760,7 +848,7 @@ namespace Opm
 
 
 
-    void TofDiscGalReorder::applyTracerLimiter(const int cell, double* local_coeff)
+    void TofDiscGalReorder::applyTracerLimiter(const int cell, double* local_coeff, LocalData& ld)
     {
         // Evaluate the solution in all corners of all faces. Extract max and min.
         const int dim = grid_.dimensions;
@@ -771,8 +859,8 @@ namespace Opm
             const int face = grid_.cell_faces[hface];
             for (int fnode = grid_.face_nodepos[face]; fnode < grid_.face_nodepos[face+1]; ++fnode) {
                 const double* nc = grid_.node_coordinates + dim*grid_.face_nodes[fnode];
-                basis_func_->eval(cell, nc, &basis_[0]);
-                const double tracer_corner = std::inner_product(basis_.begin(), basis_.end(),
+                basis_func_->eval(cell, nc, &ld.basis[0]);
+                const double tracer_corner = std::inner_product(ld.basis.begin(), ld.basis.end(),
                                                                 local_coeff, 0.0);
                 min_cornerval = std::min(min_cornerval, tracer_corner);
                 max_cornerval = std::max(min_cornerval, tracer_corner);
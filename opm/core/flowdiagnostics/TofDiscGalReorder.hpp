@@ -57,6 +57,9 @@ namespace Opm
         ///   - \c use_tensorial_basis (false)             -- Use tensor-product basis, interpreting dg_degree as
         ///                                                   bi/tri-degree not total degree.
         ///   - \c use_cvi (false)                         -- Use ECVI velocity interpolation.
+        ///   - \c cache_quadrature (false)                -- Store the basis functions evaluated in the
+        ///                                                   cell quadrature points of all cells, instead
+        ///                                                   of evaluating them in every single-cell solve.
         ///   - \c use_limiter (false)                     -- Use a slope limiter. If true, the next three parameters are used.
         ///   - \c limiter_relative_flux_threshold (1e-3)  -- Ignore upstream fluxes below this threshold,
         ///                                                   relative to total cell flux.
@@ -118,12 +121,41 @@ namespace Opm
                             std::vector<double>& tracer_coeff);
 
     private:
+        // The basis functions evaluated in the cell quadrature points.
+        struct CellQuadratureData
+        {
+            std::vector<double> weight;         // one per quadrature point
+            std::vector<double> coord;          // dim per quadrature point
+            std::vector<double> basis;          // num_basis per quadrature point
+            std::vector<double> grad_basis;     // num_basis*dim per quadrature point
+        };
+
+        // Scratch data of the single-cell solves, one per thread.
+        struct LocalData
+        {
+            std::vector<double> rhs;        // single-cell right-hand-sides
+            std::vector<double> jac;        // single-cell jacobian
+            std::vector<double> orig_rhs;   // single-cell right-hand-sides (copy)
+            std::vector<double> orig_jac;   // single-cell jacobian (copy)
+            std::vector<double> coord;
+            std::vector<double> basis;
+            std::vector<double> basis_nb;
+            std::vector<double> velocity;
+            std::vector<double> tracer_average;
+            CellQuadratureData cell_quadrature;     // if not cache_quadrature_
+            int num_singlesolves;
+        };
+
         virtual void solveSingleCell(const int cell);
         virtual void solveMultiCell(const int num_cells, const int* cells);
+        virtual bool supportsConcurrentSolves() const;
 
-        void cellContribs(const int cell);
-        void faceContribs(const int cell);
-        void solveLinearSystem(const int cell);
+        void setupLocalData();
+        LocalData& localData();
+        void computeCellQuadrature(const int cell, CellQuadratureData& data) const;
+        void cellContribs(const int cell, LocalData& ld);
+        void faceContribs(const int cell, LocalData& ld);
+        void solveLinearSystem(const int cell, LocalData& ld);
 
     private:
         // Disable copying and assignment.
@@ -152,16 +184,9 @@ namespace Opm
         std::vector<int> tracerhead_by_cell_;
         bool tracers_ensure_unity_;
         // Used by solveSingleCell().
-        std::vector<double> rhs_;   // single-cell right-hand-sides
-        std::vector<double> jac_;   // single-cell jacobian
-        std::vector<double> orig_rhs_;   // single-cell right-hand-sides (copy)
-        std::vector<double> orig_jac_;   // single-cell jacobian (copy)
-        std::vector<double> coord_;
-        mutable std::vector<double> basis_;
-        mutable std::vector<double> basis_nb_;
-        std::vector<double> grad_basis_;
-        std::vector<double> velocity_;
-        int num_singlesolves_;
+        std::vector<LocalData> local_data_;
+        bool cache_quadrature_;
+        std::vector<CellQuadratureData> cell_quadrature_;   // if cache_quadrature_
         // Used by solveMultiCell():
         double gauss_seidel_tol_;
         int num_multicell_;
@@ -173,16 +198,16 @@ namespace Opm
         // Apply some limiter, writing to array tof
         // (will read data from tof_coeff_, it is ok to call
         //  with tof_coeff as tof argument.
-        void applyLimiter(const int cell, double* tof);
-        void applyMinUpwindLimiter(const int cell, const bool face_min, double* tof);
+        void applyLimiter(const int cell, double* tof, LocalData& ld);
+        void applyMinUpwindLimiter(const int cell, const bool face_min, double* tof, LocalData& ld);
         void applyLimiterAsPostProcess();
         void applyLimiterAsSimultaneousPostProcess();
         double totalFlux(const int cell) const;
-        double minCornerVal(const int cell, const int face) const;
+        double minCornerVal(const int cell, const int face, LocalData& ld) const;
 
         // Apply a simple (restrict to [0,1]) limiter.
         // Intended for tracers.
-        void applyTracerLimiter(const int cell, double* local_coeff);
+        void applyTracerLimiter(const int cell, double* local_coeff, LocalData& ld);
     };
 
 } // namespace Opm
@@ -42,6 +42,8 @@ namespace Opm
           porevolume_(0),
           source_(0),
           tof_(0),
+          tracer_(0),
+          num_tracers_(0),
           gauss_seidel_tol_(1e-3),
           use_multidim_upwind_(use_multidim_upwind)
     {
@@ -129,10 +131,6 @@ namespace Opm
             std::fill(face_part_tof_.begin(), face_part_tof_.end(), 0.0);
         }
 
-        // Execute solve for tof
-        compute_tracer_ = false;
-        executeSolve();
-
         // Find the tracer heads (injectors).
         const int num_tracers = tracerheads.size();
         tracer.resize(num_cells*num_tracers);
@@ -141,6 +139,30 @@ namespace Opm
             tracerhead_by_cell_.clear();
             tracerhead_by_cell_.resize(num_cells, NoTracerHead);
         }
+
+        if (!use_multidim_upwind_) {
+            // All tracers share the upwind weights of the tof, so a single
+            // sweep computes the tof and all tracers, directly in the
+            // output layout with the tracers of a cell next to each other.
+            for (int tr = 0; tr < num_tracers; ++tr) {
+                for (const int cell : tracerheads[tr]) {
+                    tracer[num_tracers * cell + tr] = 1.0;
+                    tracerhead_by_cell_[cell] = tr;
+                }
+            }
+            compute_tracer_ = false;
+            tracer_ = tracer.data();
+            num_tracers_ = num_tracers;
+            executeSolve();
+            tracer_ = 0;
+            num_tracers_ = 0;
+            return;
+        }
+
+        // Execute solve for tof
+        compute_tracer_ = false;
+        executeSolve();
+
         for (int tr = 0; tr < num_tracers; ++tr) {
             const unsigned int tracerheadsSize = tracerheads[tr].size();
             for (unsigned int i = 0; i < tracerheadsSize; ++i) {
@@ -202,6 +224,14 @@ namespace Opm
             // This is a tracer head cell, already has solution.
             return;
         }
+        // Tracers solved together with the tof, see solveTofTracer().
+        // Tracer head cells keep their tracer values.
+        const int nt = num_tracers_;
+        double* tracer = 0;
+        if (nt > 0 && tracerhead_by_cell_[cell] == NoTracerHead) {
+            tracer = tracer_ + nt*cell;
+            std::fill(tracer, tracer + nt, 0.0);
+        }
         double upwind_term = 0.0;
         double downwind_flux = std::max(-source_[cell], 0.0);
         for (int i = grid_.cell_facepos[cell]; i < grid_.cell_facepos[cell+1]; ++i) {
@@ -223,6 +253,12 @@ namespace Opm
                 // face.
                 if (other != -1) {
                     upwind_term += flux*tof_[other];
+                    if (tracer) {
+                        const double* upwind_tracer = tracer_ + nt*other;
+                        for (int tr = 0; tr < nt; ++tr) {
+                            tracer[tr] += flux*upwind_tracer[tr];
+                        }
+                    }
                 }
             } else {
                 downwind_flux += flux;
@@ -231,6 +267,11 @@ namespace Opm
 
         // Compute tof.
         tof_[cell] = (porevolume_[cell] - upwind_term)/downwind_flux;
+        if (tracer) {
+            for (int tr = 0; tr < nt; ++tr) {
+                tracer[tr] /= -downwind_flux;
+            }
+        }
     }
 
 
@@ -302,14 +343,30 @@ namespace Opm
 
 
 
+
+    bool TofReorder::supportsConcurrentSolves() const
+    {
+        // The multidimensional upwind face values also depend on cells
+        // that only share a vertex, which the level schedule does not see.
+        return !use_multidim_upwind_;
+    }
+
+
     void TofReorder::solveMultiCell(const int num_cells, const int* cells)
     {
-        ++num_multicell_;
-        max_size_multicell_ = std::max(max_size_multicell_, num_cells);
+        // Components may be solved concurrently, see supportsConcurrentSolves().
+#if HAVE_OPENMP
+#pragma omp critical(TofReorder_multicell_statistics)
+#endif // HAVE_OPENMP
+        {
+            ++num_multicell_;
+            max_size_multicell_ = std::max(max_size_multicell_, num_cells);
+        }
         // std::cout << "Multiblock solve with " << num_cells << " cells." << std::endl;
 
         // Using a Gauss-Seidel approach.
         double max_delta = 1e100;
+        std::vector<double> tracer_before(num_tracers_);
         int num_iter = 0;
         while (max_delta > gauss_seidel_tol_) {
             max_delta = 0.0;
@@ -317,11 +374,18 @@ namespace Opm
             for (int ci = 0; ci < num_cells; ++ci) {
                 const int cell = cells[ci];
                 const double tof_before = tof_[cell];
+                tracer_before.assign(tracer_ + num_tracers_*cell, tracer_ + num_tracers_*(cell + 1));
                 solveSingleCell(cell);
                 max_delta = std::max(max_delta, std::fabs(tof_[cell] - tof_before));
+                for (int tr = 0; tr < num_tracers_; ++tr) {
+                    max_delta = std::max(max_delta, std::fabs(tracer_[num_tracers_*cell + tr] - tracer_before[tr]));
+                }
             }
             // std::cout << "Max delta = " << max_delta << std::endl;
         }
+#if HAVE_OPENMP
+#pragma omp critical(TofReorder_multicell_statistics)
+#endif // HAVE_OPENMP
         max_iter_multicell_ = std::max(max_iter_multicell_, num_iter);
     }
 
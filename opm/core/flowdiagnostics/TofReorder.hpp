@@ -88,6 +88,7 @@ namespace Opm
                                 std::vector<double>& local_coefficient,
                                 double& rhs);
         virtual void solveMultiCell(const int num_cells, const int* cells);
+        virtual bool supportsConcurrentSolves() const;
 
         void multidimUpwindTerms(const int face, const int upwind_cell,
                                  double& face_term, double& cell_term_factor) const;
@@ -100,6 +101,8 @@ namespace Opm
         const double* porevolume_;  // one volume per cell
         const double* source_;      // one volumetric source term per cell
         double* tof_;
+        double* tracer_;            // num_tracers_ per cell, if solved with the tof
+        int num_tracers_;
         bool compute_tracer_;
         enum { NoTracerHead = -1 };
         std::vector<int> tracerhead_by_cell_;
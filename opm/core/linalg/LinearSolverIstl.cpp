@@ -51,6 +51,8 @@
 
 #include <opm/common/utility/platform_dependent/reenable_warnings.h>
 
+#include <algorithm>
+#include <memory>
 #include <stdexcept>
 #include <iostream>
 #include <type_traits>
@@ -66,6 +68,17 @@ namespace Opm
         typedef Dune::BlockVector<VectorBlockType>        Vector;
         typedef Dune::MatrixAdapter<Mat,Vector,Vector> Operator;
 
+        // AMG preconditioner shared by consecutive sequential solves with
+        // the same matrix pattern.
+        struct AMGReuse
+        {
+            std::shared_ptr<Dune::Preconditioner<Vector,Vector> > precond;
+            // Number of solves since the hierarchy was built.
+            int uses = 0;
+            int rebuild_interval = 1;
+            bool recalculate = true;
+        };
+
         template<class O, class S, class C>
         LinearSolverInterface::LinearSolverReport
         solveCG_ILU0(O& A, Vector& x, Vector& b, S& sp, const C& comm, double tolerance, int maxit, int verbosity);
@@ -73,7 +86,7 @@ namespace Opm
         template<class O, class S, class C>
         LinearSolverInterface::LinearSolverReport
         solveCG_AMG(O& A, Vector& x, Vector& b, S& sp, const C& comm, double tolerance, int maxit, int verbosity,
-                    double prolongateFactor, int smoothsteps);
+                    double prolongateFactor, int smoothsteps, AMGReuse* reuse);
 
        template<class O, class S, class C>
         LinearSolverInterface::LinearSolverReport
@@ -100,7 +113,9 @@ namespace Opm
           linsolver_save_system_(false),
           linsolver_max_iterations_(0),
           linsolver_smooth_steps_(2),
-          linsolver_prolongate_factor_(1.6)
+          linsolver_prolongate_factor_(1.6),
+          linsolver_amg_rebuild_interval_(1),
+          linsolver_amg_recalculate_(true)
     {
     }
 
@@ -114,7 +129,9 @@ namespace Opm
           linsolver_save_system_(false),
           linsolver_max_iterations_(0),
           linsolver_smooth_steps_(2),
-          linsolver_prolongate_factor_(1.6)
+          linsolver_prolongate_factor_(1.6),
+          linsolver_amg_rebuild_interval_(1),
+          linsolver_amg_recalculate_(true)
     {
         linsolver_residual_tolerance_ = param.getDefault("linsolver_residual_tolerance", linsolver_residual_tolerance_);
         linsolver_verbosity_ = param.getDefault("linsolver_verbosity", linsolver_verbosity_);
@@ -126,35 +143,86 @@ namespace Opm
         linsolver_max_iterations_ = param.getDefault("linsolver_max_iterations", linsolver_max_iterations_);
         linsolver_smooth_steps_ = param.getDefault("linsolver_smooth_steps", linsolver_smooth_steps_);
         linsolver_prolongate_factor_ = param.getDefault("linsolver_prolongate_factor", linsolver_prolongate_factor_);
+        linsolver_amg_rebuild_interval_ = param.getDefault("linsolver_amg_rebuild_interval", linsolver_amg_rebuild_interval_);
+        linsolver_amg_recalculate_ = param.getDefault("linsolver_amg_recalculate", linsolver_amg_recalculate_);
     }
 
     LinearSolverIstl::~LinearSolverIstl()
     {}
 
-    LinearSolverInterface::LinearSolverReport
-    LinearSolverIstl::solve(const int size,
-                            const int nonzeros,
-                            const int* ia,
-                            const int* ja,
-                            const double* sa,
-                            const double* rhs,
-                            double* solution,
-                            const boost::any& comm) const
+
+
+    // System matrix in Istl format, together with the CSR pattern it was
+    // built from.
+    struct LinearSolverIstl::MatrixCache
+    {
+        Mat A;
+        std::unique_ptr<Operator> op;
+        AMGReuse amg;
+        std::vector<int> ia;
+        std::vector<int> ja;
+        // Address in A of each CSR element, so that refilling the values
+        // does not search the rows of A.
+        std::vector<double*> entries;
+    };
+
+
+
+    LinearSolverIstl::MatrixCache&
+    LinearSolverIstl::systemMatrix(const int size,
+                                   const int nonzeros,
+                                   const int* ia,
+                                   const int* ja) const
     {
-        // Build Istl structures from input.
-        // System matrix
-        Mat A(size, size, nonzeros, Mat::row_wise);
+        if (matrix_cache_
+            && int(matrix_cache_->ia.size()) == size + 1
+            && int(matrix_cache_->ja.size()) == nonzeros
+            && std::equal(ia, ia + size + 1, matrix_cache_->ia.begin())
+            && std::equal(ja, ja + nonzeros, matrix_cache_->ja.begin())) {
+            return *matrix_cache_;
+        }
+
+        std::unique_ptr<MatrixCache> cache(new MatrixCache);
+        cache->ia.assign(ia, ia + size + 1);
+        cache->ja.assign(ja, ja + nonzeros);
+        Mat& A = cache->A;
+        A.setBuildMode(Mat::row_wise);
+        A.setSize(size, size, nonzeros);
         for (Mat::CreateIterator row = A.createbegin(); row != A.createend(); ++row) {
             int ri = row.index();
             for (int i = ia[ri]; i < ia[ri + 1]; ++i) {
                 row.insert(ja[i]);
             }
         }
+        A = 0.0;
+        cache->entries.resize(nonzeros);
         for (int ri = 0; ri < size; ++ri) {
             for (int i = ia[ri]; i < ia[ri + 1]; ++i) {
-                A[ri][ja[i]] = sa[i];
+                cache->entries[i] = &A[ri][ja[i]][0][0];
             }
         }
+        cache->op.reset(new Operator(A));
+        matrix_cache_ = std::move(cache);
+        return *matrix_cache_;
+    }
+
+
+
+    LinearSolverInterface::LinearSolverReport
+    LinearSolverIstl::solve(const int size,
+                            const int nonzeros,
+                            const int* ia,
+                            const int* ja,
+                            const double* sa,
+                            const double* rhs,
+                            double* solution,
+                            const boost::any& comm) const
+    {
+        // Fill the persistent Istl matrix from input.
+        MatrixCache& cache = systemMatrix(size, nonzeros, ia, ja);
+        for (int i = 0; i < nonzeros; ++i) {
+            *cache.entries[i] = sa[i];
+        }
 
         int maxit = linsolver_max_iterations_;
         if (maxit == 0) {
@@ -168,7 +236,7 @@ namespace Opm
             Comm istlComm(info.communicator());
             info.copyValuesTo(istlComm.indexSet(), istlComm.remoteIndices());
             Dune::OverlappingSchwarzOperator<Mat,Vector,Vector, Comm>
-                opA(A, istlComm);
+                opA(cache.A, istlComm);
             Dune::OverlappingSchwarzScalarProduct<Vector,Comm> sp(istlComm);
             return solveSystem(opA, solution, rhs, sp, istlComm, maxit);
         }
@@ -178,8 +246,7 @@ namespace Opm
             (void) comm; // Avoid warning for unused argument if no MPI.
             Dune::SeqScalarProduct<Vector> sp;
             Dune::Amg::SequentialInformation seq_comm;
-            Operator opA(A);
-            return solveSystem(opA, solution, rhs, sp, seq_comm, maxit);
+            return solveSystem(*cache.op, solution, rhs, sp, seq_comm, maxit);
         }
     }
 
@@ -215,9 +282,20 @@ namespace Opm
             res = solveCG_ILU0(opA, x, b, sp, comm, linsolver_residual_tolerance_, maxit, linsolver_verbosity_);
             break;
         case CG_AMG:
+        {
+            // The hierarchy refers to the persistent operator of the
+            // cache, so it can only be kept in the sequential case.
+            AMGReuse* reuse = 0;
+            if (linsolver_amg_rebuild_interval_ > 1
+                && std::is_same<C, Dune::Amg::SequentialInformation>::value) {
+                reuse = &matrix_cache_->amg;
+                reuse->rebuild_interval = linsolver_amg_rebuild_interval_;
+                reuse->recalculate = linsolver_amg_recalculate_;
+            }
             res = solveCG_AMG(opA, x, b, sp, comm, linsolver_residual_tolerance_, maxit, linsolver_verbosity_,
-                              linsolver_prolongate_factor_, linsolver_smooth_steps_);
+                              linsolver_prolongate_factor_, linsolver_smooth_steps_, reuse);
             break;
+        }
         case KAMG:
             res = solveKAMG(opA, x, b, sp, comm, linsolver_residual_tolerance_, maxit, linsolver_verbosity_,
                             linsolver_prolongate_factor_, linsolver_smooth_steps_);
@@ -345,7 +423,7 @@ namespace Opm
     template<class O, class S, class C>
     LinearSolverInterface::LinearSolverReport
     solveCG_AMG(O& opA, Vector& x, Vector& b, S& sp, const C& comm, double tolerance, int maxit, int verbosity,
-                double linsolver_prolongate_factor, int linsolver_smooth_steps)
+                double linsolver_prolongate_factor, int linsolver_smooth_steps, AMGReuse* reuse)
     {
         // Solve with AMG solver.
 
@@ -370,15 +448,33 @@ namespace Opm
         typedef Dune::Amg::CoarsenCriterion<CriterionBase> Criterion;
         typedef Dune::Amg::AMG<O,Vector,Smoother,C>   Precond;
 
-        // Construct preconditioner.
-        Criterion criterion;
-        typename Precond::SmootherArgs smootherArgs;
-        setUpCriterion(criterion, linsolver_prolongate_factor, verbosity,
-                       linsolver_smooth_steps);
-        Precond precond(opA, criterion, smootherArgs, comm);
+        // Construct preconditioner, or reuse the one of the previous solve.
+        // The smoothers refer to the matrices of the hierarchy, hence they
+        // see the new values without being rebuilt.
+        std::shared_ptr<Precond> precond;
+        if (reuse && reuse->precond && reuse->uses < reuse->rebuild_interval) {
+            precond = std::static_pointer_cast<Precond>(reuse->precond);
+            if (reuse->recalculate) {
+                // Keep the aggregates, recompute the coarse level matrices.
+                precond->recalculateHierarchy();
+            }
+        } else {
+            Criterion criterion;
+            typename Precond::SmootherArgs smootherArgs;
+            setUpCriterion(criterion, linsolver_prolongate_factor, verbosity,
+                           linsolver_smooth_steps);
+            precond = std::make_shared<Precond>(opA, criterion, smootherArgs, comm);
+            if (reuse) {
+                reuse->precond = precond;
+                reuse->uses = 0;
+            }
+        }
+        if (reuse) {
+            ++reuse->uses;
+        }
 
         // Construct linear solver.
-        Dune::CGSolver<Vector> linsolve(opA, sp, precond, tolerance, maxit, verbosity);
+        Dune::CGSolver<Vector> linsolve(opA, sp, *precond, tolerance, maxit, verbosity);
 
         // Solve system.
         Dune::InverseOperatorResult result;
@@ -23,6 +23,7 @@
 
 #include <opm/core/linalg/LinearSolverInterface.hpp>
 #include <opm/common/utility/parameters/ParameterGroup.hpp>
+#include <memory>
 #include <string>
 #include <boost/any.hpp>
 
@@ -47,6 +48,10 @@ namespace Opm
         ///   linsolver_smooth_steps        2
         ///   linsolver_prolongate_factor   1.6
         ///   linsolver_verbosity           0
+        ///   linsolver_amg_rebuild_interval  1 (number of consecutive CG_AMG solves
+        ///                                 sharing one AMG hierarchy, sequential only)
+        ///   linsolver_amg_recalculate     true (recompute the coarse matrices of a
+        ///                                 reused hierarchy from the new matrix)
         LinearSolverIstl();
 
         /// Construct from parameters
@@ -68,6 +73,9 @@ namespace Opm
         /// \param[in] rhs         array of length size containing the right hand side
         /// \param[inout] solution array of length size to which the solution will be written, may also be used
         ///                        as initial guess by iterative solvers.
+        /// The ISTL matrix is kept between calls, and its sparsity pattern is
+        /// only rebuilt when ia or ja change. Therefore a solver object must
+        /// not be used by several threads at once.
         virtual LinearSolverReport solve(const int size,
                                          const int nonzeros,
                                          const int* ia,
@@ -86,6 +94,13 @@ namespace Opm
         virtual double getTolerance() const;
 
     private:
+        struct MatrixCache;
+
+        /// \brief The system matrix with the given sparsity pattern,
+        /// reusing the previous one if the pattern is unchanged.
+        MatrixCache& systemMatrix(const int size, const int nonzeros,
+                                  const int* ia, const int* ja) const;
+
         /// \brief Solve the linear system using ISTL
         /// \param[in] opA The linear operator of the system to solve.
         /// \param[out]    solution C array for storing the solution vector.
@@ -108,6 +123,12 @@ namespace Opm
         int linsolver_smooth_steps_;
         /** \brief The factor to scale the coarse grid correction with. */
         double linsolver_prolongate_factor_;
+        /** \brief The number of solves that use the same AMG hierarchy. */
+        int linsolver_amg_rebuild_interval_;
+        /** \brief Whether to recompute the coarse matrices of a reused hierarchy. */
+        bool linsolver_amg_recalculate_;
+        /** \brief The matrix of the last solve. */
+        mutable std::unique_ptr<MatrixCache> matrix_cache_;
 
     };
 
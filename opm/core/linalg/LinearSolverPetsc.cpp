@@ -20,9 +20,11 @@
 
 #include "config.h"
 
+#include <algorithm>
 #include <cstring>
 #include <opm/core/linalg/LinearSolverPetsc.hpp>
 #include <unordered_map>
+#include <vector>
 #define PETSC_CLANGUAGE_CXX 1 //enable CHKERRXX macro.
 #include <opm/common/utility/platform_dependent/disable_warnings.h>
 #include <petsc.h>
@@ -127,46 +129,23 @@ namespace{
         Map type_map_;
     };
 
-    struct OEM_DATA {
-        /* Convenience struct to handle automatic (de)allocation of some useful
-         * variables, as well as group them up for easier parameter passing
-         */
-        Vec x;
-        Vec b;
-        Mat A;
-        KSP ksp;
-        PC preconditioner;
-
-        OEM_DATA( const int size ) {
-            VecCreate( PETSC_COMM_WORLD, &b );
-            auto err = VecSetSizes( b, PETSC_DECIDE, size );
-            CHKERRXX( err );
-            VecSetFromOptions( b );
-
-            KSPCreate( PETSC_COMM_WORLD, &ksp );
-        }
-
-        ~OEM_DATA() {
-            VecDestroy( &x );
-            VecDestroy( &b );
-            MatDestroy( &A );
-            KSPDestroy( &ksp );
-        }
-    };
-
-    Vec to_petsc_vec( const double* x, int size ) {
-        PetscScalar* vec;
+    Vec create_petsc_vec( int size ) {
         Vec v;
-
         VecCreate( PETSC_COMM_WORLD, &v );
-        VecSetSizes( v, PETSC_DECIDE, size );
+        auto err = VecSetSizes( v, PETSC_DECIDE, size );
+        CHKERRXX( err );
         VecSetFromOptions( v );
+        return v;
+    }
 
+    void to_petsc_vec( const double* x, Vec v ) {
+        PetscScalar* vec;
+        PetscInt size;
+
+        VecGetLocalSize( v, &size );
         VecGetArray( v, &vec );
         std::memcpy( vec, x,  size * sizeof( double ) );
-
         VecRestoreArray( v, &vec );
-        return v;
     }
 
     void from_petsc_vec( double* x, Vec v ) {
@@ -183,51 +162,81 @@ namespace{
         VecRestoreArray( v, &vec );
     }
 
-    Mat to_petsc_mat( const int size, const int /* nonzeros */,
-            const int* ia, const int* ja, const double* sa ) {
+} // anonymous namespace.
 
+    struct LinearSolverPetsc::PetscSystem {
+        /* Matrix, vectors and solver of one sparsity pattern, kept
+         * between the solves with that pattern.
+         */
+        Vec x;
+        Vec b;
         Mat A;
-        auto err = MatCreateSeqAIJWithArrays( PETSC_COMM_WORLD, size, size, const_cast<int*>(ia), const_cast<int*>(ja), (double*)sa, &A );
-        CHKERRXX( err );
-        return A;
-    }
+        KSP ksp;
+        std::vector<int> ia;
+        std::vector<int> ja;
+
+        PetscSystem( const int size, const int nonzeros,
+                     const int* ia_in, const int* ja_in,
+                     KSPType method, PCType pcname,
+                     double rtol, double atol, double dtol, int maxits )
+            : ia( ia_in, ia_in + size + 1 )
+            , ja( ja_in, ja_in + nonzeros )
+        {
+            // Exact preallocation, the values are inserted into this
+            // layout by every solve.
+            std::vector<PetscInt> row_nnz( size );
+            for( int row = 0; row < size; ++row )
+                row_nnz[ row ] = ia[ row + 1 ] - ia[ row ];
 
+            auto err = MatCreateSeqAIJ( PETSC_COMM_WORLD, size, size, 0, row_nnz.data(), &A );
+            CHKERRXX( err );
+            err = MatSetOption( A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_TRUE );
+            CHKERRXX( err );
 
-    void solve_system( OEM_DATA& t, KSPType method, PCType pcname,
-            double rtol, double atol, double dtol, int maxits, int ksp_view ) {
-        PetscInt its;
-        PetscReal residual;
-        KSPConvergedReason reason;
+            x = create_petsc_vec( size );
+            b = create_petsc_vec( size );
 
-#if PETSC_VERSION_MAJOR <= 3 && PETSC_VERSION_MINOR < 5
-        KSPSetOperators( t.ksp, t.A, t.A, DIFFERENT_NONZERO_PATTERN );
-#else
-        KSPSetOperators( t.ksp, t.A, t.A );
-        KSPSetReusePreconditioner(t.ksp, PETSC_FALSE);
-#endif
-        KSPGetPC( t.ksp, &t.preconditioner );
-        auto err = KSPSetType( t.ksp, method );
-        CHKERRXX( err );
-        err = PCSetType( t.preconditioner, pcname );
-        CHKERRXX( err );
-        err = KSPSetTolerances( t.ksp, rtol, atol, dtol, maxits );
-        CHKERRXX( err );
-        err = KSPSetFromOptions( t.ksp );
-        CHKERRXX( err );
-        KSPSetInitialGuessNonzero( t.ksp, PETSC_FALSE );
-        KSPSolve( t.ksp, t.x, t.b );
-        KSPGetConvergedReason( t.ksp, &reason );
-        KSPGetIterationNumber( t.ksp, &its );
-        KSPGetResidualNorm( t.ksp, &residual );
+            KSPCreate( PETSC_COMM_WORLD, &ksp );
+            PC preconditioner;
+            KSPGetPC( ksp, &preconditioner );
+            err = KSPSetType( ksp, method );
+            CHKERRXX( err );
+            err = PCSetType( preconditioner, pcname );
+            CHKERRXX( err );
+            err = KSPSetTolerances( ksp, rtol, atol, dtol, maxits );
+            CHKERRXX( err );
+            err = KSPSetFromOptions( ksp );
+            CHKERRXX( err );
+            KSPSetInitialGuessNonzero( ksp, PETSC_FALSE );
+        }
 
-        if( ksp_view )
-            KSPView( t.ksp, PETSC_VIEWER_STDOUT_WORLD );
+        ~PetscSystem() {
+            VecDestroy( &x );
+            VecDestroy( &b );
+            MatDestroy( &A );
+            KSPDestroy( &ksp );
+        }
 
-        err = PetscPrintf( PETSC_COMM_WORLD, "KSP Iterations %D, Final Residual %g\n", its, (double)residual );
-        CHKERRXX( err );
-    }
+        bool samePattern( const int size, const int nonzeros,
+                          const int* ia_in, const int* ja_in ) const {
+            return int( ia.size() ) == size + 1 && int( ja.size() ) == nonzeros
+                && std::equal( ia.begin(), ia.end(), ia_in )
+                && std::equal( ja.begin(), ja.end(), ja_in );
+        }
+
+        void setValues( const double* sa ) {
+            const int size = ia.size() - 1;
+            for( int row = 0; row < size; ++row ) {
+                const PetscInt ncols = ia[ row + 1 ] - ia[ row ];
+                auto err = MatSetValues( A, 1, &row, ncols, &ja[ ia[ row ] ],
+                                         &sa[ ia[ row ] ], INSERT_VALUES );
+                CHKERRXX( err );
+            }
+            MatAssemblyBegin( A, MAT_FINAL_ASSEMBLY );
+            MatAssemblyEnd( A, MAT_FINAL_ASSEMBLY );
+        }
+    };
 
-} // anonymous namespace.
 
     LinearSolverPetsc::LinearSolverPetsc(const ParameterGroup& param)
         : ksp_type_( param.getDefault( std::string( "ksp_type" ), std::string( "gmres" ) ) )
@@ -237,6 +246,7 @@ namespace{
         , atol_( param.getDefault( std::string( "ksp_atol" ), 1e-50 ) )
         , dtol_( param.getDefault( std::string( "ksp_dtol" ), 1e5 ) )
         , maxits_( param.getDefault( std::string( "ksp_max_it" ), 1e5 ) )
+        , reuse_pc_( param.getDefault( std::string( "ksp_reuse_pc" ), int( false ) ) )
     {
         int argc = 0;
         char** argv = NULL;
@@ -246,6 +256,7 @@ namespace{
 
     LinearSolverPetsc::~LinearSolverPetsc()
     {
+       system_.reset();
        PetscFinalize();
     }
 
@@ -265,15 +276,41 @@ namespace{
         PCTypeMap pc(pc_type_);
         PCType pc_type = pc.find(pc_type_);
 
-        OEM_DATA t( size );
-        t.A = to_petsc_mat( size, nonzeros, ia, ja, sa );
-        t.x = to_petsc_vec( rhs, size );
+        if( !system_ || !system_->samePattern( size, nonzeros, ia, ja ) ) {
+            system_.reset();
+            system_.reset( new PetscSystem( size, nonzeros, ia, ja, ksp_type, pc_type,
+                                            rtol_, atol_, dtol_, maxits_ ) );
+        }
+        PetscSystem& t = *system_;
+        t.setValues( sa );
+        to_petsc_vec( rhs, t.b );
+
+#if PETSC_VERSION_MAJOR <= 3 && PETSC_VERSION_MINOR < 5
+        KSPSetOperators( t.ksp, t.A, t.A, reuse_pc_ ? SAME_PRECONDITIONER : SAME_NONZERO_PATTERN );
+#else
+        KSPSetOperators( t.ksp, t.A, t.A );
+        KSPSetReusePreconditioner( t.ksp, reuse_pc_ ? PETSC_TRUE : PETSC_FALSE );
+#endif
+        KSPSolve( t.ksp, t.b, t.x );
+
+        PetscInt its;
+        PetscReal residual;
+        KSPConvergedReason reason;
+        KSPGetConvergedReason( t.ksp, &reason );
+        KSPGetIterationNumber( t.ksp, &its );
+        KSPGetResidualNorm( t.ksp, &residual );
+
+        if( ksp_view_ )
+            KSPView( t.ksp, PETSC_VIEWER_STDOUT_WORLD );
+
+        auto err = PetscPrintf( PETSC_COMM_WORLD, "KSP Iterations %D, Final Residual %g\n", its, (double)residual );
+        CHKERRXX( err );
 
-        solve_system( t, ksp_type, pc_type, rtol_, atol_, dtol_, maxits_, ksp_view_ );
-        from_petsc_vec( solution, t.b );
+        from_petsc_vec( solution, t.x );
 
         LinearSolverReport rep = {};
-        rep.converged = true;
+        rep.converged = reason > 0;
+        rep.iterations = its;
         return rep;
     }
 
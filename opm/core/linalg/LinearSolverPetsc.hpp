@@ -27,6 +27,7 @@
 
 #include <opm/core/linalg/LinearSolverInterface.hpp>
 #include <opm/common/utility/parameters/ParameterGroup.hpp>
+#include <memory>
 #include <string>
 
 namespace Opm
@@ -34,6 +35,12 @@ namespace Opm
 
 
     /// Concrete class encapsulating some Petsc linear solvers.
+    ///
+    /// The PETSc matrix, vectors and KSP are kept between solves with the
+    /// same sparsity pattern; the matrix is preallocated exactly from the
+    /// pattern and only its values are updated. With ksp_reuse_pc=1 the
+    /// preconditioner of the first solve with a pattern is reused by the
+    /// later ones, which pays off for expensive setups such as GAMG.
     class LinearSolverPetsc : public LinearSolverInterface
     {
     public:
@@ -87,6 +94,10 @@ namespace Opm
         double          atol_;
         double          dtol_;
         int             maxits_;
+        int             reuse_pc_;
+
+        struct PetscSystem;
+        mutable std::unique_ptr<PetscSystem> system_;
     };
 
 
@@ -56,9 +56,11 @@ namespace Opm
             const_cast<int*>(ja),
             const_cast<double*>(sa)
         };
-        call_UMFPACK(&A, rhs, solution);
+        if (!cache_) {
+            cache_.reset(umfpack_cache_new());
+        }
         LinearSolverReport rep = {};
-        rep.converged = true;
+        rep.converged = cache_ && call_UMFPACK_cached(cache_.get(), &A, rhs, solution);
         return rep;
     }
 
@@ -71,6 +73,11 @@ namespace Opm
         return -1.;
     }
 
+    void LinearSolverUmfpack::CacheDeleter::operator()(UMFPACKCache* cache) const
+    {
+        umfpack_cache_delete(cache);
+    }
+
 
 } // namespace Opm
 
@@ -23,12 +23,19 @@
 
 #include <opm/core/linalg/LinearSolverInterface.hpp>
 
+#include <memory>
+
+struct UMFPACKCache;
 
 namespace Opm
 {
 
 
     /// Concrete class encapsulating the UMFPACK direct linear solver.
+    ///
+    /// The factorisation is kept between calls to solve(). A matrix with
+    /// the sparsity pattern of the previous one is only refactorised
+    /// numerically, and an unchanged matrix is not refactorised at all.
     class LinearSolverUmfpack : public LinearSolverInterface
     {
     public:
@@ -68,7 +75,13 @@ namespace Opm
         /// Not used for UMFPACK solver. Returns -1.
         virtual double getTolerance() const;
 
+    private:
+        struct CacheDeleter
+        {
+            void operator()(UMFPACKCache* cache) const;
+        };
 
+        mutable std::unique_ptr<UMFPACKCache, CacheDeleter> cache_;
     };
 
 
@@ -30,8 +30,13 @@
 #include <algorithm>
 #include <functional>
 #include <limits>
+#include <map>
+#include <memory>
 #include <numeric>
 #include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <vector>
 
 #if HAVE_MPI && HAVE_DUNE_ISTL
 
@@ -67,6 +72,8 @@ public:
     typedef Dune::OwnerOverlapCopyCommunication<int, int>::ParallelIndexSet ParallelIndexSet;
     /// \brief The type of the remote indices information used.
     typedef Dune::OwnerOverlapCopyCommunication<int, int>::RemoteIndices RemoteIndices;
+    /// \brief The type of the communication object of the ISTL solvers.
+    typedef Dune::OwnerOverlapCopyCommunication<int, int> Communication;
 
     /// \brief Constructs an empty parallel information object using MPI_COMM_WORLD
     ParallelISTLInformation()
@@ -95,7 +102,8 @@ public:
     /// The information will be shared by the the two objects.
     ParallelISTLInformation(const ParallelISTLInformation& other)
     : indexSet_(other.indexSet_), remoteIndices_(other.remoteIndices_),
-      communicator_(other.communicator_)
+      communicator_(other.communicator_),
+      istlCommunications_(other.istlCommunications_)
     {}
     /// \brief Get a pointer to the underlying index set.
     std::shared_ptr<ParallelIndexSet> indexSet() const
@@ -137,27 +145,54 @@ public:
         indexSet.endResize();
         remoteIndices.rebuild<false>();
     }
+    /// \brief The communication object of the ISTL solvers for systems of the
+    ///        given sizes, see copyValuesTo().
+    ///
+    /// It is built on the first call for the sizes and shared by all later
+    /// calls, also of copies of this object, since rebuilding the remote
+    /// indices needs communication. Hence it has to be called collectively
+    /// the first time.
+    std::shared_ptr<Communication> istlCommunication(std::size_t local_component_size,
+                                                     std::size_t num_components = 1) const
+    {
+        auto& comm = (*istlCommunications_)[ std::make_pair(local_component_size, num_components) ];
+        if( !comm )
+        {
+            comm = std::make_shared<Communication>(communicator_);
+            copyValuesTo(comm->indexSet(), comm->remoteIndices(),
+                         local_component_size, num_components);
+        }
+        return comm;
+    }
+    /// \brief The rows of a linear operator that are not zeroed by the
+    ///        project() of the communication, i.e. all but the copy rows.
+    ///
+    /// An operator that multiplies only these rows of its matrix before
+    /// project() equals the OverlappingSchwarzOperator.
+    static std::vector<bool> nonCopyRows(const Communication& comm, std::size_t numRows)
+    {
+        std::vector<bool> rows(numRows, true);
+        for( const auto& index : comm.indexSet() )
+        {
+            if( index.local().attribute() == Dune::OwnerOverlapCopyAttributeSet::copy )
+                rows[ index.local() ] = false;
+        }
+        return rows;
+    }
     /// \brief Communcate the dofs owned by us to the other process.
     ///
     /// Afterwards all associated dofs will contain the same data.
     template<class T>
     void copyOwnerToAll (const T& source, T& dest) const
     {
-        typedef Dune::Combine<Dune::EnumItem<Dune::OwnerOverlapCopyAttributeSet::AttributeSet,Dune::OwnerOverlapCopyAttributeSet::owner>,Dune::EnumItem<Dune::OwnerOverlapCopyAttributeSet::AttributeSet,Dune::OwnerOverlapCopyAttributeSet::overlap>,Dune::OwnerOverlapCopyAttributeSet::AttributeSet> OwnerOverlapSet;
-        typedef Dune::EnumItem<Dune::OwnerOverlapCopyAttributeSet::AttributeSet,Dune::OwnerOverlapCopyAttributeSet::owner> OwnerSet;
-        typedef Dune::Combine<OwnerOverlapSet, Dune::EnumItem<Dune::OwnerOverlapCopyAttributeSet::AttributeSet,Dune::OwnerOverlapCopyAttributeSet::copy>,Dune::OwnerOverlapCopyAttributeSet::AttributeSet> AllSet;
-      OwnerSet sourceFlags;
-      AllSet destFlags;
-      Dune::Interface interface(communicator_);
-      if( !remoteIndices_->isSynced() )
+      const Dune::Interface& interface = copyOwnerToAllInterface();
+      auto& communicator = copyOwnerToAllCommunicators_[std::type_index(typeid(T))];
+      if( !communicator )
       {
-          remoteIndices_->rebuild<false>();
+          communicator = std::make_shared<Dune::BufferedCommunicator>();
+          communicator->template build<T>(interface);
       }
-      interface.build(*remoteIndices_,sourceFlags,destFlags);
-      Dune::BufferedCommunicator communicator;
-      communicator.template build<T>(interface);
-      communicator.template forward<CopyGatherScatter<T> >(source,dest);
-      communicator.free();
+      communicator->template forward<CopyGatherScatter<T> >(source,dest);
     }
     template<class T>
     const std::vector<double>& updateOwnerMask(const T& container) const
@@ -325,6 +360,31 @@ private:
         }
         computeLocalReduction<I+1>(containers, operators, values);
     }
+    /// \brief The interface from the owner to all copies.
+    ///
+    /// The interface and the communicators only depend on the remote
+    /// indices. They are built on first use and reused until the remote
+    /// indices have to be rebuilt.
+    const Dune::Interface& copyOwnerToAllInterface() const
+    {
+        typedef Dune::Combine<Dune::EnumItem<Dune::OwnerOverlapCopyAttributeSet::AttributeSet,Dune::OwnerOverlapCopyAttributeSet::owner>,Dune::EnumItem<Dune::OwnerOverlapCopyAttributeSet::AttributeSet,Dune::OwnerOverlapCopyAttributeSet::overlap>,Dune::OwnerOverlapCopyAttributeSet::AttributeSet> OwnerOverlapSet;
+        typedef Dune::EnumItem<Dune::OwnerOverlapCopyAttributeSet::AttributeSet,Dune::OwnerOverlapCopyAttributeSet::owner> OwnerSet;
+        typedef Dune::Combine<OwnerOverlapSet, Dune::EnumItem<Dune::OwnerOverlapCopyAttributeSet::AttributeSet,Dune::OwnerOverlapCopyAttributeSet::copy>,Dune::OwnerOverlapCopyAttributeSet::AttributeSet> AllSet;
+        if( !remoteIndices_->isSynced() )
+        {
+            remoteIndices_->rebuild<false>();
+            copyOwnerToAllCommunicators_.clear();
+            copyOwnerToAllInterface_.reset();
+        }
+        if( !copyOwnerToAllInterface_ )
+        {
+            OwnerSet sourceFlags;
+            AllSet destFlags;
+            copyOwnerToAllInterface_ = std::make_shared<Dune::Interface>(communicator_);
+            copyOwnerToAllInterface_->build(*remoteIndices_,sourceFlags,destFlags);
+        }
+        return *copyOwnerToAllInterface_;
+    }
     /** \brief gather/scatter callback for communcation */
     template<typename T>
     struct CopyGatherScatter
@@ -374,7 +434,151 @@ private:
     std::shared_ptr<ParallelIndexSet> indexSet_;
     std::shared_ptr<RemoteIndices> remoteIndices_;
     Dune::CollectiveCommunication<MPI_Comm> communicator_;
+    /// \brief The communication objects of istlCommunication(), by their sizes.
+    std::shared_ptr<std::map<std::pair<std::size_t, std::size_t>, std::shared_ptr<Communication> > >
+    istlCommunications_ = std::make_shared<std::map<std::pair<std::size_t, std::size_t>, std::shared_ptr<Communication> > >();
     mutable std::vector<double> ownerMask_;
+    /// \brief The interface from the owner to all copies of copyOwnerToAll.
+    mutable std::shared_ptr<Dune::Interface> copyOwnerToAllInterface_;
+    /// \brief The communicators of copyOwnerToAll, one per container type.
+    mutable std::map<std::type_index, std::shared_ptr<Dune::BufferedCommunicator> > copyOwnerToAllCommunicators_;
+};
+
+/// \brief Global sums, maxima and minima that are registered first and then
+/// computed together.
+///
+/// Each registered container is reduced over the dofs that this process owns
+/// in one local pass during flush(), and all the results are exchanged in a
+/// single collective call, instead of one per computeReduction() call.
+/// Containers passed as lvalues are referenced and must stay alive until
+/// flush() is called, temporaries such as Eigen column blocks are copied.
+class DeferredReduction
+{
+public:
+    /// \brief Construct an empty set of reductions.
+    /// \param info The parallel information of the containers.
+    explicit DeferredReduction(const ParallelISTLInformation& info)
+        : info_(info)
+    {}
+    /// \brief Register the global sum of the owned entries of a container.
+    /// \return The index of the result, see value().
+    template<class Container>
+    std::size_t addSum(Container&& container)
+    {
+        return add(Operation::Sum, makeLocal<Operation::Sum>(std::forward<Container>(container)));
+    }
+    /// \brief Register the global maximum of the owned entries of a container.
+    /// \return The index of the result, see value().
+    template<class Container>
+    std::size_t addMax(Container&& container)
+    {
+        return add(Operation::Max, makeLocal<Operation::Max>(std::forward<Container>(container)));
+    }
+    /// \brief Register the global minimum of the owned entries of a container.
+    /// \return The index of the result, see value().
+    template<class Container>
+    std::size_t addMin(Container&& container)
+    {
+        return add(Operation::Min, makeLocal<Operation::Min>(std::forward<Container>(container)));
+    }
+    /// \brief Register the global maximum of a value already reduced locally,
+    /// e.g. over the wells of this process.
+    /// \return The index of the result, see value().
+    std::size_t addLocalMax(const double value)
+    {
+        return add(Operation::Max, [value](const std::vector<double>&) { return value; });
+    }
+    /// \brief Compute all registered reductions and clear the registrations.
+    /// \param size The number of entries of the registered containers, which
+    ///             all have the layout of the index set.
+    void flush(std::size_t size)
+    {
+        if( info_.getOwnerMask().size() != size )
+        {
+            info_.updateOwnerMask(std::vector<double>(size));
+        }
+        const auto& mask = info_.getOwnerMask();
+        const std::size_t n = operations_.size();
+        std::vector<double> local(n);
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            local[i] = locals_[i](mask);
+        }
+        const auto& comm = info_.communicator();
+        std::vector<double> all(n * comm.size());
+        comm.allgather(local.data(), n, all.data());
+        values_.resize(n);
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            double& value = values_[i];
+            value = all[i];
+            for( int rank = 1; rank < comm.size(); ++rank )
+            {
+                const double other = all[rank * n + i];
+                switch( operations_[i] )
+                {
+                case Operation::Sum: value += other; break;
+                case Operation::Max: value = std::max(value, other); break;
+                case Operation::Min: value = std::min(value, other); break;
+                }
+            }
+        }
+        locals_.clear();
+        operations_.clear();
+    }
+    /// \brief The result of a reduction after flush().
+    /// \param index The index returned when registering the reduction.
+    double value(std::size_t index) const
+    {
+        return values_[index];
+    }
+private:
+    enum class Operation { Sum, Max, Min };
+
+    /// \brief The reduction of the owned entries of one container.
+    template<Operation operation, class Stored>
+    struct LocalReduction
+    {
+        double operator()(const std::vector<double>& mask) const
+        {
+            double value = operation == Operation::Sum ? 0.0 :
+                (operation == Operation::Max ? std::numeric_limits<double>::lowest()
+                                             : std::numeric_limits<double>::max());
+            for( std::size_t i = 0, n = mask.size(); i < n; ++i )
+            {
+                const double entry = container[i];
+                switch( operation )
+                {
+                case Operation::Sum: value += mask[i] * entry; break;
+                case Operation::Max: value = mask[i] ? std::max(value, entry) : value; break;
+                case Operation::Min: value = mask[i] ? std::min(value, entry) : value; break;
+                }
+            }
+            return value;
+        }
+        Stored container;
+    };
+
+    template<Operation operation, class Container>
+    static LocalReduction<operation,
+                          typename std::conditional<std::is_lvalue_reference<Container>::value, Container,
+                                                    typename std::decay<Container>::type>::type>
+    makeLocal(Container&& container)
+    {
+        return { std::forward<Container>(container) };
+    }
+
+    std::size_t add(Operation operation, std::function<double(const std::vector<double>&)> local)
+    {
+        operations_.push_back(operation);
+        locals_.push_back(std::move(local));
+        return operations_.size() - 1;
+    }
+
+    const ParallelISTLInformation& info_;
+    std::vector<Operation> operations_;
+    std::vector<std::function<double(const std::vector<double>&)> > locals_;
+    std::vector<double> values_;
 };
 
     namespace Reduction
@@ -38,6 +38,7 @@
 #if HAVE_UMFPACK
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <umfpack.h>
 
@@ -185,6 +186,213 @@ call_UMFPACK(struct CSRMatrix *A, const double *b, double *x)
     csc_deallocate(csc);
 }
 
+
+struct UMFPACKCache {
+    /* Pattern and values of the factorised matrix. */
+    size_t  m;
+    size_t  nnz;
+    int    *ia;
+    int    *ja;
+    double *sa;
+
+    /* Position of each CSR entry in the CSC matrix. */
+    UF_long *csc_pos;
+
+    struct CSCMatrix *csc;
+
+    void   *Symbolic;
+    void   *Numeric;
+    double  Control[UMFPACK_CONTROL];
+};
+
+
+/* ---------------------------------------------------------------------- */
+static void
+umfpack_cache_clear(struct UMFPACKCache *cache)
+/* ---------------------------------------------------------------------- */
+{
+    if (cache->Numeric != NULL) {
+        umfpack_dl_free_numeric(&cache->Numeric);
+    }
+    if (cache->Symbolic != NULL) {
+        umfpack_dl_free_symbolic(&cache->Symbolic);
+    }
+
+    csc_deallocate(cache->csc);
+    free(cache->csc_pos);
+    free(cache->sa);
+    free(cache->ja);
+    free(cache->ia);
+
+    cache->csc      = NULL;
+    cache->csc_pos  = NULL;
+    cache->sa       = NULL;
+    cache->ja       = NULL;
+    cache->ia       = NULL;
+    cache->Numeric  = NULL;
+    cache->Symbolic = NULL;
+    cache->m        = 0;
+    cache->nnz      = 0;
+}
+
+
+/* ---------------------------------------------------------------------- */
+static int
+umfpack_cache_same_pattern(const struct UMFPACKCache *cache,
+                           const struct CSRMatrix    *A)
+/* ---------------------------------------------------------------------- */
+{
+    return (cache->Symbolic != NULL) &&
+        (cache->m == A->m) && (cache->nnz == (size_t) A->ia[A->m]) &&
+        (memcmp(cache->ia, A->ia, (A->m + 1) * sizeof *A->ia) == 0) &&
+        (memcmp(cache->ja, A->ja, cache->nnz * sizeof *A->ja) == 0);
+}
+
+
+/* ---------------------------------------------------------------------- */
+static void
+umfpack_cache_set_values(struct UMFPACKCache *cache, const struct CSRMatrix *A)
+/* ---------------------------------------------------------------------- */
+{
+    size_t i;
+
+    memcpy(cache->sa, A->sa, cache->nnz * sizeof *A->sa);
+
+    for (i = 0; i < cache->nnz; i++) {
+        cache->csc->x[ cache->csc_pos[i] ] = A->sa[i];
+    }
+}
+
+
+/* ---------------------------------------------------------------------- */
+static int
+umfpack_cache_analyse(struct UMFPACKCache *cache, const struct CSRMatrix *A)
+/* ---------------------------------------------------------------------- */
+{
+    size_t  i, nnz;
+    UF_long nz;
+    double  Info[UMFPACK_INFO];
+
+    umfpack_cache_clear(cache);
+
+    nnz = A->ia[A->m];
+
+    cache->ia      = malloc((A->m + 1) * sizeof *cache->ia);
+    cache->ja      = malloc(nnz        * sizeof *cache->ja);
+    cache->sa      = malloc(nnz        * sizeof *cache->sa);
+    cache->csc_pos = malloc(nnz        * sizeof *cache->csc_pos);
+    cache->csc     = csc_allocate(A->m, nnz);
+
+    if ((cache->ia == NULL) || (cache->ja == NULL) || (cache->sa == NULL) ||
+        (cache->csc_pos == NULL) || (cache->csc == NULL)) {
+        umfpack_cache_clear(cache);
+        return 0;
+    }
+
+    cache->m   = A->m;
+    cache->nnz = nnz;
+    memcpy(cache->ia, A->ia, (A->m + 1) * sizeof *A->ia);
+    memcpy(cache->ja, A->ja, nnz        * sizeof *A->ja);
+
+    /* Convert the pattern with the CSR entry numbers as values to
+     * record where each entry goes. */
+    for (i = 0; i < nnz; i++) { cache->sa[i] = (double) i; }
+    csr_to_csc(A->ia, A->ja, cache->sa, cache->csc);
+    for (nz = 0; nz < cache->csc->nnz; nz++) {
+        cache->csc_pos[ (size_t) cache->csc->x[nz] ] = nz;
+    }
+
+    umfpack_cache_set_values(cache, A);
+
+    umfpack_dl_symbolic(cache->csc->n, cache->csc->n,
+                        cache->csc->p, cache->csc->i, cache->csc->x,
+                        &cache->Symbolic, cache->Control, Info);
+
+    if (cache->Symbolic == NULL) {
+        umfpack_cache_clear(cache);
+        return 0;
+    }
+
+    return 1;
+}
+
+
+/* ---------------------------------------------------------------------- */
+struct UMFPACKCache *
+umfpack_cache_new(void)
+/* ---------------------------------------------------------------------- */
+{
+    struct UMFPACKCache *new;
+
+    new = calloc(1, sizeof *new);
+
+    if (new != NULL) {
+        umfpack_dl_defaults(new->Control);
+    }
+
+    return new;
+}
+
+
+/* ---------------------------------------------------------------------- */
+void
+umfpack_cache_delete(struct UMFPACKCache *cache)
+/* ---------------------------------------------------------------------- */
+{
+    if (cache != NULL) {
+        umfpack_cache_clear(cache);
+    }
+
+    free(cache);
+}
+
+
+/* ---------------------------------------------------------------------- */
+int
+call_UMFPACK_cached(struct UMFPACKCache *cache,
+                    struct CSRMatrix   *A,
+                    const double       *b,
+                    double             *x)
+/* ---------------------------------------------------------------------- */
+{
+    double Info[UMFPACK_INFO];
+
+    if (! umfpack_cache_same_pattern(cache, A)) {
+        if (! umfpack_cache_analyse(cache, A)) {
+            return 0;
+        }
+    }
+    else if ((cache->Numeric != NULL) &&
+             (memcmp(cache->sa, A->sa, cache->nnz * sizeof *A->sa) == 0)) {
+        /* Unchanged matrix, solve with the current factors. */
+        umfpack_dl_solve(UMFPACK_A, cache->csc->p, cache->csc->i,
+                         cache->csc->x, x, b,
+                         cache->Numeric, cache->Control, Info);
+        return 1;
+    }
+    else {
+        umfpack_cache_set_values(cache, A);
+    }
+
+    if (cache->Numeric != NULL) {
+        umfpack_dl_free_numeric(&cache->Numeric);
+    }
+
+    umfpack_dl_numeric(cache->csc->p, cache->csc->i, cache->csc->x,
+                       cache->Symbolic, &cache->Numeric,
+                       cache->Control, Info);
+
+    if (cache->Numeric == NULL) {
+        return 0;
+    }
+
+    umfpack_dl_solve(UMFPACK_A, cache->csc->p, cache->csc->i,
+                     cache->csc->x, x, b,
+                     cache->Numeric, cache->Control, Info);
+
+    return 1;
+}
+
 #else
 #include <stdlib.h>
 #include <opm/core/linalg/call_umfpack.h>
@@ -196,4 +404,26 @@ call_UMFPACK(struct CSRMatrix *A, const double *b, double *x)
     abort();
 }
 
+struct UMFPACKCache *
+umfpack_cache_new(void)
+{
+    return NULL;
+}
+
+void
+umfpack_cache_delete(struct UMFPACKCache *cache)
+{
+    (void) cache;
+}
+
+int
+call_UMFPACK_cached(struct UMFPACKCache *cache,
+                    struct CSRMatrix   *A,
+                    const double       *b,
+                    double             *x)
+{
+    /* UMFPACK is not available */
+    abort();
+}
+
 #endif
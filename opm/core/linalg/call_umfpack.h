@@ -43,6 +43,28 @@ struct CSRMatrix;
 
 void call_UMFPACK(struct CSRMatrix *A, const double *b, double *x);
 
+
+/* Factorisation kept between calls to call_UMFPACK_cached(). */
+struct UMFPACKCache;
+
+struct UMFPACKCache *
+umfpack_cache_new(void);
+
+void
+umfpack_cache_delete(struct UMFPACKCache *cache);
+
+/* Solve A x = b as call_UMFPACK(), reusing the factorisation in
+ * 'cache'.  The symbolic factorisation is redone only when the
+ * sparsity pattern of A differs from that of the previous call, and
+ * the numeric factorisation only when the values differ.
+ *
+ * Returns non-zero if the system was solved. */
+int
+call_UMFPACK_cached(struct UMFPACKCache *cache,
+                    struct CSRMatrix   *A,
+                    const double       *b,
+                    double             *x);
+
 #ifdef __cplusplus
 }
 #endif
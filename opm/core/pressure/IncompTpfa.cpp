@@ -221,6 +221,10 @@ namespace Opm
         computePerSolveDynamicData(dt, state, well_state);
         computePerIterationDynamicData(dt, state, well_state);
 
+        // Assemble the pressure independent part of J and F once,
+        // the iterations only update the accumulation terms.
+        assembleStatic();
+
         // Assemble J and F.
         assemble(dt, state, well_state);
 
@@ -395,6 +399,22 @@ namespace Opm
 
 
 
+    /// Assemble and store the part of the system that does not depend
+    /// on pressure, from the data of computePerSolveDynamicData().
+    void IncompTpfa::assembleStatic()
+    {
+        bool ok = ifs_tpfa_assemble_static(const_cast<UnstructuredGrid*>(&grid_),
+                                           &forces_, &trans_[0], &gpress_omegaweighted_[0], h_);
+        if (!ok) {
+            OPM_THROW(std::runtime_error, "Failed assembling pressure system.");
+        }
+    }
+
+
+
+
+
+
     /// Compute the residual in h_->b and Jacobian in h_->A.
     void IncompTpfa::assemble(const double dt,
                               const SimulationDataContainer& state,
@@ -402,10 +422,9 @@ namespace Opm
     {
         const double* pressures = wells_ ? &pressures_[0] : &state.pressure()[0];
 
-        bool ok = ifs_tpfa_assemble_comprock_increment(const_cast<UnstructuredGrid*>(&grid_),
-                                                       &forces_, &trans_[0], &gpress_omegaweighted_[0],
-                                                       &porevol_[0], &rock_comp_[0], dt, pressures,
-                                                       &initial_porevol_[0], h_);
+        bool ok = ifs_tpfa_assemble_comprock_increment_static(const_cast<UnstructuredGrid*>(&grid_),
+                                                              &forces_, &porevol_[0], &rock_comp_[0], dt,
+                                                              pressures, &initial_porevol_[0], h_);
         if (!ok) {
             OPM_THROW(std::runtime_error, "Failed assembling pressure system.");
         }
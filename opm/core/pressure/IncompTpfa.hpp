@@ -137,6 +137,7 @@ namespace Opm
         void computePerIterationDynamicData(const double dt,
                                             const SimulationDataContainer& state,
                                             const WellState& well_state);
+        void assembleStatic();
         void assemble(const double dt,
                       const SimulationDataContainer& state,
                       const WellState& well_state);
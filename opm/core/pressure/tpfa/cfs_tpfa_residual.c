@@ -17,6 +17,10 @@
 
 #include <opm/core/pressure/tpfa/cfs_tpfa_residual.h>
 
+#if HAVE_OPENMP
+#include <omp.h>
+#endif
+
 #if defined(MAX)
 #undef MAX
 #endif
@@ -24,6 +28,18 @@
 #define MAX(a,b) (((a) > (b)) ? (a) : (b))
 
 
+/* Index of the calling thread within the current parallel region */
+static int
+thread_num(void)
+{
+#if HAVE_OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+
 
 struct densrat_util {
     MAT_SIZE_T *ipiv;
@@ -49,12 +65,16 @@ struct cfs_tpfa_res_impl {
     double              *compflux_p;       /* A_{wi} q_{wi} */
     double              *compflux_deriv_p; /* A_{wi} \partial_{p} q_{wi} */
 
+    /* np * (1 + 2) entries per thread */
     double              *flux_work;
 
     /* Scratch array for face pressure calculation */
     double              *scratch_f;
 
-    struct densrat_util *ratio;
+    /* Scratch space of each thread, ratio == thread_ratio[0] */
+    int                   nthreads;
+    struct densrat_util  *ratio;
+    struct densrat_util **thread_ratio;
 
     /* Linear storage */
     double *ddata;
@@ -120,9 +140,18 @@ static void
 impl_deallocate(struct cfs_tpfa_res_impl *pimpl)
 /* ---------------------------------------------------------------------- */
 {
+    int t;
+
     if (pimpl != NULL) {
-        free              (pimpl->ddata);
-        deallocate_densrat(pimpl->ratio);
+        free(pimpl->ddata);
+
+        if (pimpl->thread_ratio != NULL) {
+            for (t = 0; t < pimpl->nthreads; t++) {
+                deallocate_densrat(pimpl->thread_ratio[t]);
+            }
+        }
+
+        free(pimpl->thread_ratio);
     }
 
     free(pimpl);
@@ -137,11 +166,19 @@ impl_allocate(struct UnstructuredGrid   *G       ,
               int                        np      )
 /* ---------------------------------------------------------------------- */
 {
+    int                   t, nthreads;
     size_t                nnu, nwperf;
+
+    t = 0;
     struct cfs_tpfa_res_impl *new;
 
     size_t ddata_sz;
 
+    nthreads = 1;
+#if HAVE_OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+
     nnu    = G->number_of_cells;
     nwperf = 0;
 
@@ -161,17 +198,32 @@ impl_allocate(struct UnstructuredGrid   *G       ,
     ddata_sz += np *      nwperf ;             /* compflux_p */
     ddata_sz += np * (2 * nwperf);             /* compflux_deriv_p */
 
-    ddata_sz += np * (1 + 2)                 ; /* flux_work */
+    ddata_sz += np * (1 + 2) * nthreads      ; /* flux_work */
 
     ddata_sz += 1  *      G->number_of_faces ; /* scratch_f */
 
     new = malloc(1 * sizeof *new);
 
     if (new != NULL) {
-        new->ddata = malloc(ddata_sz * sizeof *new->ddata);
-        new->ratio = allocate_densrat(max_conn, np);
+        new->nthreads     = nthreads;
+        new->ddata        = malloc(ddata_sz * sizeof *new->ddata);
+        new->thread_ratio = calloc(nthreads, sizeof *new->thread_ratio);
+        new->ratio        = NULL;
+
+        if (new->thread_ratio != NULL) {
+            for (t = 0; t < nthreads; t++) {
+                new->thread_ratio[t] = allocate_densrat(max_conn, np);
 
-        if (new->ddata == NULL || new->ratio == NULL) {
+                if (new->thread_ratio[t] == NULL) {
+                    break;
+                }
+            }
+
+            new->ratio = new->thread_ratio[0];
+        }
+
+        if (new->ddata == NULL || new->thread_ratio == NULL ||
+            t < nthreads) {
             impl_deallocate(new);
             new = NULL;
         }
@@ -383,32 +435,35 @@ compute_compflux_and_deriv(struct UnstructuredGrid  *G     ,
 {
     int     c1, c2, f, np2;
     double  dp;
-    double *cflux, *dcflux;
+    double *work, *cflux, *dcflux;
 
     np2    = np * np;
 
-    cflux  = pimpl->compflux_f;
-    dcflux = pimpl->compflux_deriv_f;
-
-    for (f = 0; f < G->number_of_faces;
-         f++, pmobf += np, gcapf += np, Af += np2,
-             cflux += np, dcflux += 2 * np) {
+    /* Each face only writes its own fluxes */
+#if HAVE_OPENMP
+#pragma omp parallel for num_threads(pimpl->nthreads) schedule(static) \
+    private(c1, c2, dp, work, cflux, dcflux)
+#endif
+    for (f = 0; f < G->number_of_faces; f++) {
 
         c1 = G->face_cells[2*f + 0];
         c2 = G->face_cells[2*f + 1];
 
         if ((c1 >= 0) && (c2 >= 0)) {
-            dp = cpress[c1] - cpress[c2];
+            dp     = cpress[c1] - cpress[c2];
+            work   = pimpl->flux_work        + thread_num() * np * (1 + 2);
+            cflux  = pimpl->compflux_f       + f * np;
+            dcflux = pimpl->compflux_deriv_f + f * 2 * np;
 
-            compute_darcyflux_and_deriv(np, trans[f], dp, pmobf, gcapf,
-                                        pimpl->flux_work,
-                                        pimpl->flux_work + np);
+            compute_darcyflux_and_deriv(np, trans[f], dp,
+                                        pmobf + f*np, gcapf + f*np,
+                                        work, work + np);
 
             /* Component flux = Af * v*/
-            matvec(np, np, Af, pimpl->flux_work     , cflux );
+            matvec(np, np, Af + f*np2, work     , cflux );
 
             /* Derivative = Af * (dv/dp) */
-            matmat(np, 2 , Af, pimpl->flux_work + np, dcflux);
+            matmat(np, 2 , Af + f*np2, work + np, dcflux);
         }
 
         /* Boundary connections excluded */
@@ -499,6 +554,7 @@ init_cell_contrib(struct UnstructuredGrid  *G    ,
                   double                    pvol ,
                   double                    dt   ,
                   const double             *z    ,
+                  struct densrat_util      *ratio,
                   struct cfs_tpfa_res_impl *pimpl)
 {
     int     c1, c2, f, i, conn, nconn;
@@ -506,12 +562,12 @@ init_cell_contrib(struct UnstructuredGrid  *G    ,
 
     nconn = count_internal_conn(G, c);
 
-    memcpy(pimpl->ratio->linsolve_buffer, z, np * sizeof *z);
+    memcpy(ratio->linsolve_buffer, z, np * sizeof *z);
 
-    pimpl->ratio->coeff[0] = -pvol;
+    ratio->coeff[0] = -pvol;
     conn = 1;
 
-    cflx  = pimpl->ratio->linsolve_buffer + (1 * np);
+    cflx  = ratio->linsolve_buffer + (1 * np);
     dcflx = cflx + (nconn * np);
 
     for (i = G->cell_facepos[c]; i < G->cell_facepos[c + 1]; i++) {
@@ -529,18 +585,20 @@ init_cell_contrib(struct UnstructuredGrid  *G    ,
             cflx  += 1 * np;
             dcflx += 2 * np;
 
-            pimpl->ratio->coeff[ conn++ ] = dt * (2*(c1 == c) - 1.0);
+            ratio->coeff[ conn++ ] = dt * (2*(c1 == c) - 1.0);
         }
     }
 
     assert (conn == nconn + 1);
-    assert (cflx == pimpl->ratio->linsolve_buffer + (nconn + 1)*np);
+    assert (cflx == ratio->linsolve_buffer + (nconn + 1)*np);
 
     return nconn;
 }
 
 
-static void
+/* Residual and Jacobian row of cell 'c', computed in 'ratio'.  Returns
+ * whether the cell's fluid is incompressible. */
+static int
 compute_cell_contrib(struct UnstructuredGrid  *G    ,
                      int                       c    ,
                      int                       np   ,
@@ -549,49 +607,50 @@ compute_cell_contrib(struct UnstructuredGrid  *G    ,
                      const double             *z    ,
                      const double             *Ac   ,
                      const double             *dAc  ,
+                     struct densrat_util      *ratio,
                      struct cfs_tpfa_res_impl *pimpl)
 {
-    int        c1, c2, f, i, off, nconn, p;
+    int        c1, c2, f, i, off, nconn, p, is_incomp;
     MAT_SIZE_T nrhs;
     double     s, dF1, dF2, *dv, *dv1, *dv2;
 
-    nconn = init_cell_contrib(G, c, np, pvol, dt, z, pimpl);
+    nconn = init_cell_contrib(G, c, np, pvol, dt, z, ratio, pimpl);
     nrhs  = 1 + (1 + 2)*nconn;  /* [z, Af*v, Af*dv] */
 
-    factorise_fluid_matrix(np, Ac, pimpl->ratio);
-    solve_linear_systems  (np, nrhs, pimpl->ratio,
-                           pimpl->ratio->linsolve_buffer);
+    factorise_fluid_matrix(np, Ac, ratio);
+    solve_linear_systems  (np, nrhs, ratio,
+                           ratio->linsolve_buffer);
 
     /* Sum residual contributions over the connections (+ accumulation):
      *   t1 <- (Ac \ [z, Af*v]) * [-pvol; repmat(dt, [nconn, 1])] */
-    matvec(np, nconn + 1, pimpl->ratio->linsolve_buffer,
-           pimpl->ratio->coeff, pimpl->ratio->t1);
+    matvec(np, nconn + 1, ratio->linsolve_buffer,
+           ratio->coeff, ratio->t1);
 
     /* Compute residual in cell 'c' */
-    pimpl->ratio->residual = pvol;
+    ratio->residual = pvol;
     for (p = 0; p < np; p++) {
-        pimpl->ratio->residual += pimpl->ratio->t1[ p ];
+        ratio->residual += ratio->t1[ p ];
     }
 
     /* Jacobian row */
 
     vector_zero(1 + (G->cell_facepos[c + 1] - G->cell_facepos[c]),
-                pimpl->ratio->mat_row);
+                ratio->mat_row);
 
     /* t2 <- A \ ((dA/dp) * t1) */
-    matvec(np, np, dAc, pimpl->ratio->t1, pimpl->ratio->t2);
-    solve_linear_systems(np, 1, pimpl->ratio, pimpl->ratio->t2);
+    matvec(np, np, dAc, ratio->t1, ratio->t2);
+    solve_linear_systems(np, 1, ratio, ratio->t2);
 
     dF2 = 0.0;
     for (p = 0; p < np; p++) {
-        dF2 += pimpl->ratio->t2[ p ];
+        dF2 += ratio->t2[ p ];
     }
 
-    pimpl->is_incomp           = pimpl->is_incomp && (! (fabs(dF2) > 0));
-    pimpl->ratio->mat_row[ 0 ] = - dF2;
+    is_incomp           = ! (fabs(dF2) > 0);
+    ratio->mat_row[ 0 ] = - dF2;
 
     /* Accumulate inter-cell Jacobian contributions */
-    dv  = pimpl->ratio->linsolve_buffer + (1 + nconn)*np;
+    dv  = ratio->linsolve_buffer + (1 + nconn)*np;
     off = 1;
     for (i = G->cell_facepos[c]; i < G->cell_facepos[c + 1]; i++, off++) {
 
@@ -609,12 +668,14 @@ compute_cell_contrib(struct UnstructuredGrid  *G    ,
                 dF2 += dv2[ p ];
             }
 
-            pimpl->ratio->mat_row[  0  ] += s * dt * dF1;
-            pimpl->ratio->mat_row[ off ] += s * dt * dF2;
+            ratio->mat_row[  0  ] += s * dt * dF1;
+            ratio->mat_row[ off ] += s * dt * dF2;
 
             dv += 2 * np;       /* '2' == number of one-sided derivatives. */
         }
     }
+
+    return is_incomp;
 }
 
 
@@ -638,6 +699,7 @@ assemble_sources(double                    dt ,
 static int
 assemble_cell_contrib(struct UnstructuredGrid  *G,
                       int                       c,
+                      const struct densrat_util *ratio,
                       struct cfs_tpfa_res_data *h)
 /* ---------------------------------------------------------------------- */
 {
@@ -645,7 +707,7 @@ assemble_cell_contrib(struct UnstructuredGrid  *G,
 
     j1 = csrmatrix_elm_index(c, c, h->J);
 
-    h->J->sa[j1] += h->pimpl->ratio->mat_row[ 0 ];
+    h->J->sa[j1] += ratio->mat_row[ 0 ];
 
     off = 1;
     for (i = G->cell_facepos[c]; i < G->cell_facepos[c + 1]; i++, off++) {
@@ -659,11 +721,11 @@ assemble_cell_contrib(struct UnstructuredGrid  *G,
         if (c2 >= 0) {
             j2 = csrmatrix_elm_index(c, c2, h->J);
 
-            h->J->sa[j2] += h->pimpl->ratio->mat_row[ off ];
+            h->J->sa[j2] += ratio->mat_row[ off ];
         }
     }
 
-    h->F[ c ] = h->pimpl->ratio->residual;
+    h->F[ c ] = ratio->residual;
 
     return 0;
 }
@@ -1230,29 +1292,41 @@ cfs_tpfa_res_assemble(struct UnstructuredGrid     *G        ,
                       struct cfs_tpfa_res_data    *h        )
 /* ---------------------------------------------------------------------- */
 {
-    int res_is_neumann, well_is_neumann, c, np2, singular;
+    int res_is_neumann, well_is_neumann, c, np, np2, singular, is_incomp;
+
+    struct densrat_util *ratio;
 
     csrmatrix_zero(         h->J);
     vector_zero   (h->J->m, h->F);
 
-    h->pimpl->is_incomp = 1;
-
     compute_compflux_and_deriv(G, cq->nphases, cpress, trans,
                                cq->phasemobf, gravcap_f, cq->Af, h->pimpl);
 
     res_is_neumann  = 1;
     well_is_neumann = 1;
 
-    np2 = cq->nphases * cq->nphases;
-    for (c = 0; c < G->number_of_cells;
-         c++, zc += cq->nphases) {
+    /* Each cell only writes its own equation, so the result does not
+     * depend on the number of threads. */
+    np        = cq->nphases;
+    np2       = np * np;
+    is_incomp = 1;
+#if HAVE_OPENMP
+#pragma omp parallel for num_threads(h->pimpl->nthreads) schedule(static) \
+    private(ratio) reduction(&&:is_incomp)
+#endif
+    for (c = 0; c < G->number_of_cells; c++) {
+        ratio = h->pimpl->thread_ratio[ thread_num() ];
 
-        compute_cell_contrib(G, c, cq->nphases, porevol[c], dt, zc,
-                             cq->Ac + (c * np2), cq->dAc + (c * np2),
-                             h->pimpl);
+        is_incomp = compute_cell_contrib(G, c, np, porevol[c], dt,
+                                         zc + (c * np),
+                                         cq->Ac + (c * np2),
+                                         cq->dAc + (c * np2),
+                                         ratio, h->pimpl)
+            && is_incomp;
 
-        assemble_cell_contrib(G, c, h);
+        assemble_cell_contrib(G, c, ratio, h);
     }
+    h->pimpl->is_incomp = is_incomp;
 
     if ((forces           != NULL) &&
         (forces->wells    != NULL) &&
@@ -39,6 +39,10 @@ struct ifs_tpfa_impl {
 
     /* Linear storage */
     double *ddata;
+
+    /* Pressure independent system, see ifs_tpfa_assemble_static() */
+    double *sa_static;
+    double *b_static;
 };
 
 
@@ -49,6 +53,7 @@ impl_deallocate(struct ifs_tpfa_impl *pimpl)
 {
     if (pimpl != NULL) {
         free(pimpl->ddata);
+        free(pimpl->sa_static);
     }
 
     free(pimpl);
@@ -78,7 +83,9 @@ impl_allocate(struct UnstructuredGrid *G,
     new = malloc(1 * sizeof *new);
 
     if (new != NULL) {
-        new->ddata = malloc(ddata_sz * sizeof *new->ddata);
+        new->ddata     = malloc(ddata_sz * sizeof *new->ddata);
+        new->sa_static = NULL;
+        new->b_static  = NULL;
 
         if (new->ddata == NULL) {
             impl_deallocate(new);
@@ -763,52 +770,118 @@ ifs_tpfa_assemble_comprock(struct UnstructuredGrid      *G        ,
 
 /* ---------------------------------------------------------------------- */
 int
-ifs_tpfa_assemble_comprock_increment(struct UnstructuredGrid      *G        ,
-                                     const struct ifs_tpfa_forces *F        ,
-                                     const double                 *trans    ,
-                                     const double                 *gpress   ,
-                                     const double                 *porevol  ,
-                                     const double                 *rock_comp,
-                                     const double                  dt       ,
-                                     const double                 *prev_pressure,
-                                     const double                 *initial_porevolume,
-                                     struct ifs_tpfa_data         *h        )
+ifs_tpfa_assemble_static(struct UnstructuredGrid      *G     ,
+                         const struct ifs_tpfa_forces *F     ,
+                         const double                 *trans ,
+                         const double                 *gpress,
+                         struct ifs_tpfa_data         *h     )
 /* ---------------------------------------------------------------------- */
 {
-    int     c, w, wdof, system_singular, ok;
-    size_t  j;
-    double *v, dpvdt;
+    int     system_singular, ok;
+    double *sa;
+
+    if (h->pimpl->sa_static == NULL) {
+        /* Matrix values followed by right-hand side */
+        sa = malloc((h->A->nnz + h->A->m) * sizeof *sa);
+
+        if (sa == NULL) {
+            return 0;
+        }
+
+        h->pimpl->sa_static = sa;
+        h->pimpl->b_static  = sa + h->A->nnz;
+    }
 
     ok = 1;
     assemble_incompressible(G, F, trans, gpress, h, &system_singular, &ok);
 
+    if (ok) {
+        memcpy(h->pimpl->sa_static, h->A->sa, h->A->nnz * sizeof *h->A->sa);
+        memcpy(h->pimpl->b_static , h->b    , h->A->m   * sizeof *h->b    );
+    }
+
+    return ok;
+}
+
+
+/* ---------------------------------------------------------------------- */
+int
+ifs_tpfa_assemble_comprock_increment_static(struct UnstructuredGrid      *G        ,
+                                            const struct ifs_tpfa_forces *F        ,
+                                            const double                 *porevol  ,
+                                            const double                 *rock_comp,
+                                            const double                  dt       ,
+                                            const double                 *prev_pressure,
+                                            const double                 *initial_porevolume,
+                                            struct ifs_tpfa_data         *h        )
+/* ---------------------------------------------------------------------- */
+{
+    int     c, w, wdof;
+    size_t  j;
+    double *v, dpvdt;
+
+    if (h->pimpl->sa_static == NULL) {
+        return 0;
+    }
+
+    memcpy(h->A->sa, h->pimpl->sa_static, h->A->nnz * sizeof *h->A->sa);
+    memcpy(h->b    , h->pimpl->b_static , h->A->m   * sizeof *h->b    );
+
     /* We want to solve a Newton step for the residual
      * (porevol(pressure)-porevol(initial_pressure))/dt + residual_for_incompressible
      *
      */
 
-    if (ok) {
-        v = h->pimpl->work;
-        mult_csr_matrix(h->A, prev_pressure, v);
+    v = h->pimpl->work;
+    mult_csr_matrix(h->A, prev_pressure, v);
 
-        for (c = 0; c < G->number_of_cells; c++) {
-            j = csrmatrix_elm_index(c, c, h->A);
+    for (c = 0; c < G->number_of_cells; c++) {
+        j = csrmatrix_elm_index(c, c, h->A);
 
-            dpvdt = (porevol[c] - initial_porevolume[c]) / dt;
+        dpvdt = (porevol[c] - initial_porevolume[c]) / dt;
 
-            h->A->sa[j] += porevol[c] * rock_comp[c] / dt;
-            h->b[c]     -= dpvdt + v[c];
-        }
+        h->A->sa[j] += porevol[c] * rock_comp[c] / dt;
+        h->b[c]     -= dpvdt + v[c];
+    }
 
-        if (F->W != NULL) {
-            wdof = G->number_of_cells;
+    if (F->W != NULL) {
+        wdof = G->number_of_cells;
 
-            for (w = 0; w < F->W->number_of_wells; w++, wdof++) {
-                h->b[wdof] -= v[wdof];
-            }
+        for (w = 0; w < F->W->number_of_wells; w++, wdof++) {
+            h->b[wdof] -= v[wdof];
         }
     }
 
+    return 1;
+}
+
+
+/* ---------------------------------------------------------------------- */
+int
+ifs_tpfa_assemble_comprock_increment(struct UnstructuredGrid      *G        ,
+                                     const struct ifs_tpfa_forces *F        ,
+                                     const double                 *trans    ,
+                                     const double                 *gpress   ,
+                                     const double                 *porevol  ,
+                                     const double                 *rock_comp,
+                                     const double                  dt       ,
+                                     const double                 *prev_pressure,
+                                     const double                 *initial_porevolume,
+                                     struct ifs_tpfa_data         *h        )
+/* ---------------------------------------------------------------------- */
+{
+    int ok;
+
+    ok = ifs_tpfa_assemble_static(G, F, trans, gpress, h);
+
+    if (ok) {
+        ok = ifs_tpfa_assemble_comprock_increment_static(G, F, porevol,
+                                                         rock_comp, dt,
+                                                         prev_pressure,
+                                                         initial_porevolume,
+                                                         h);
+    }
+
     return ok;
 }
 
@@ -130,6 +130,49 @@ ifs_tpfa_assemble_comprock_increment(struct UnstructuredGrid      *G        ,
 				     const double                 *initial_porevolume,
 				     struct ifs_tpfa_data         *h        );
 
+/**
+ * Assemble the part of the system that does not depend on the pressure, that
+ * is, the incompressible flow operator with its gravity, well, boundary and
+ * source terms, and keep a copy of it in @c h for
+ * ifs_tpfa_assemble_comprock_increment_static().
+ *
+ * The result only changes with the arguments, so it can be reused for all
+ * nonlinear iterations of a time step.
+ *
+ * @param[in]     G      Grid.
+ * @param[in]     F      Driving forces.
+ * @param[in]     trans  Face transmissibilities, including total mobility.
+ * @param[in]     gpress Gravity pressure contributions of each cell face.
+ * @param[in,out] h      TPFA management structure.
+ * @return Non-zero if successful, zero in case of allocation failure or
+ * inconsistent well controls.
+ */
+int
+ifs_tpfa_assemble_static(struct UnstructuredGrid      *G     ,
+                         const struct ifs_tpfa_forces *F     ,
+                         const double                 *trans ,
+                         const double                 *gpress,
+                         struct ifs_tpfa_data         *h     );
+
+/**
+ * Same as ifs_tpfa_assemble_comprock_increment(), but starting from the
+ * pressure independent system of the last call to ifs_tpfa_assemble_static()
+ * rather than assembling it again. Only the accumulation terms on the
+ * diagonal and the residual are computed.
+ *
+ * @return Non-zero if successful, zero if ifs_tpfa_assemble_static() has not
+ * been called successfully for @c h.
+ */
+int
+ifs_tpfa_assemble_comprock_increment_static(struct UnstructuredGrid      *G        ,
+                                            const struct ifs_tpfa_forces *F        ,
+                                            const double                 *porevol  ,
+                                            const double                 *rock_comp,
+                                            const double                  dt       ,
+                                            const double                 *prev_pressure,
+                                            const double                 *initial_porevolume,
+                                            struct ifs_tpfa_data         *h        );
+
 
 void
 ifs_tpfa_press_flux(struct UnstructuredGrid      *G    ,
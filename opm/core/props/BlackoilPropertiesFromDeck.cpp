@@ -177,6 +177,10 @@ namespace Opm
         SaturationPropsFromDeck* ptr
             = new SaturationPropsFromDeck();
         ptr->init(phaseUsageFromDeck(deck), materialLawManager);
+        const int satfunc_tabulation_points = param.getDefault("satfunc_tabulation_points", 0);
+        if (satfunc_tabulation_points > 0) {
+            ptr->tabulate(number_of_cells, satfunc_tabulation_points);
+        }
         satprops_.reset(ptr);
     }
 
@@ -288,6 +292,127 @@ namespace Opm
         }
     }
 
+    namespace
+    {
+        void makePressureVariable(double& /* p */)
+        {
+        }
+
+        template <class Eval>
+        void makePressureVariable(Eval& p)
+        {
+            p.setDerivative(0, 1.0);
+        }
+
+        double derivativeOf(const double /* value */)
+        {
+            return 0.0;
+        }
+
+        template <class Eval>
+        double derivativeOf(const Eval& eval)
+        {
+            return eval.derivative(0);
+        }
+    } // anonymous namespace
+
+    template <class Eval>
+    void BlackoilPropertiesFromDeck::compute_BR_(const int n,
+                                                 const double* p,
+                                                 const double* T,
+                                                 const double* z,
+                                                 const int* cells,
+                                                 double* B,
+                                                 double* R,
+                                                 double* dBdp,
+                                                 double* dRdp) const
+    {
+        const auto& pu = phaseUsage();
+        const bool water = pu.phase_used[BlackoilPhases::Aqua];
+        const bool oil = pu.phase_used[BlackoilPhases::Liquid];
+        const bool gas = pu.phase_used[BlackoilPhases::Vapour];
+
+        typedef Opm::MathToolbox<Eval> Toolbox;
+
+        // The points are independent and the PVT evaluations are
+        // const, so they are computed concurrently.
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
+        for (int i = 0; i < n; ++ i) {
+            const int pvtRegionIdx = cellPvtRegionIdx_[cells[i]];
+            Eval pEval = p[i];
+            makePressureVariable(pEval);
+            const Eval TEval = T[i];
+
+            const int oilOffset = pu.num_phases*i + pu.phase_pos[BlackoilPhases::Liquid];
+            const int gasOffset = pu.num_phases*i + pu.phase_pos[BlackoilPhases::Vapour];
+            const int waterOffset = pu.num_phases*i + pu.phase_pos[BlackoilPhases::Aqua];
+
+            if (water) {
+                const Eval BEval = 1.0/waterPvt_.inverseFormationVolumeFactor(pvtRegionIdx, TEval, pEval);
+                B[waterOffset] = Toolbox::value(BEval);
+                R[waterOffset] = 0.0; // water is always immiscible!
+                if (dBdp) {
+                    dBdp[waterOffset] = derivativeOf(BEval);
+                    dRdp[waterOffset] = 0.0;
+                }
+            }
+
+            if (oil) {
+                const Eval RsSat = oilPvt_.saturatedGasDissolutionFactor(pvtRegionIdx, TEval, pEval);
+                double currentRs = 0.0;
+                double maxRs = 0.0;
+                if (gas) {
+                    currentRs = (z[oilOffset] == 0.0) ? 0.0 : z[gasOffset]/z[oilOffset];
+                    maxRs = Toolbox::value(RsSat);
+                }
+                Eval BEval;
+                if (currentRs >= maxRs) {
+                    BEval = 1.0/oilPvt_.saturatedInverseFormationVolumeFactor(pvtRegionIdx, TEval, pEval);
+                }
+                else {
+                    const Eval RsEval = currentRs;
+                    BEval = 1.0/oilPvt_.inverseFormationVolumeFactor(pvtRegionIdx, TEval, pEval, RsEval);
+                }
+                const Eval REval = Toolbox::min(RsSat, Eval(currentRs));
+
+                B[oilOffset] = Toolbox::value(BEval);
+                R[oilOffset] = Toolbox::value(REval);
+                if (dBdp) {
+                    dBdp[oilOffset] = derivativeOf(BEval);
+                    dRdp[oilOffset] = derivativeOf(REval);
+                }
+            }
+
+            if (gas) {
+                const Eval RvSat = gasPvt_.saturatedOilVaporizationFactor(pvtRegionIdx, TEval, pEval);
+                double currentRv = 0.0;
+                double maxRv = 0.0;
+                if (oil) {
+                    currentRv = (z[gasOffset] == 0.0) ? 0.0 : z[oilOffset]/z[gasOffset];
+                    maxRv = Toolbox::value(RvSat);
+                }
+                Eval BEval;
+                if (currentRv >= maxRv) {
+                    BEval = 1.0/gasPvt_.saturatedInverseFormationVolumeFactor(pvtRegionIdx, TEval, pEval);
+                }
+                else {
+                    const Eval RvEval = currentRv;
+                    BEval = 1.0/gasPvt_.inverseFormationVolumeFactor(pvtRegionIdx, TEval, pEval, RvEval);
+                }
+                const Eval REval = Toolbox::min(RvSat, Eval(currentRv));
+
+                B[gasOffset] = Toolbox::value(BEval);
+                R[gasOffset] = Toolbox::value(REval);
+                if (dBdp) {
+                    dBdp[gasOffset] = derivativeOf(BEval);
+                    dRdp[gasOffset] = derivativeOf(REval);
+                }
+            }
+        }
+    }
+
     /// \param[in]  n      Number of data points.
     /// \param[in]  p      Array of n pressure values.
     /// \param[in]  T      Array of n temperature values.
@@ -312,14 +437,13 @@ namespace Opm
         B_.resize(n*np);
         R_.resize(n*np);
         if (dAdp) {
+            typedef Opm::DenseAd::Evaluation<double, /*size=*/1> Eval;
             dB_.resize(n*np);
             dR_.resize(n*np);
 
-            this->compute_dBdp_(n, p, T, z, cells, &B_[0], &dB_[0]);
-            this->compute_dRdp_(n, p, T, z, cells, &R_[0], &dR_[0]);
+            this->compute_BR_<Eval>(n, p, T, z, cells, &B_[0], &R_[0], &dB_[0], &dR_[0]);
         } else {
-            this->compute_B_(n, p, T, z, cells, &B_[0]);
-            this->compute_R_(n, p, T, z, cells, &R_[0]);
+            this->compute_BR_<double>(n, p, T, z, cells, &B_[0], &R_[0], nullptr, nullptr);
         }
         const auto& pu = phaseUsage();
         bool oil_and_gas = pu.phase_used[BlackoilPhases::Liquid] &&
@@ -328,7 +452,9 @@ namespace Opm
         const int g = pu.phase_pos[BlackoilPhases::Vapour];
 
         // Compute A matrix
-// #pragma omp parallel for
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
         for (int i = 0; i < n; ++i) {
             double* m = A + i*np*np;
             std::fill(m, m + np*np, 0.0);
@@ -353,10 +479,12 @@ namespace Opm
         // The B matrix is diagonal and that fact is exploited in the
         // following implementation.
         if (dAdp) {
-// #pragma omp parallel for
             // (1): dA/dp <- A
             std::copy(A, A + n*np*np, dAdp);
 
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
             for (int i = 0; i < n; ++i) {
                 double*       m  = dAdp + i*np*np;
 
@@ -387,156 +515,6 @@ namespace Opm
         }
     }
 
-    void BlackoilPropertiesFromDeck::compute_B_(const int n,
-                                                const double* p,
-                                                const double* T,
-                                                const double* z,
-                                                const int* cells,
-                                                double* B) const
-    {
-        const auto& pu = phaseUsage();
-
-        typedef double Eval;
-
-        Eval pEval = 0.0;
-        Eval TEval = 0.0;
-        Eval RsEval = 0.0;
-        Eval RvEval = 0.0;
-
-        for (int i = 0; i < n; ++ i) {
-            int cellIdx = cells[i];
-            int pvtRegionIdx = cellPvtRegionIdx_[cellIdx];
-            pEval = p[i];
-            TEval = T[i];
-
-            int oilOffset = pu.num_phases*i + pu.phase_pos[BlackoilPhases::Liquid];
-            int gasOffset = pu.num_phases*i + pu.phase_pos[BlackoilPhases::Vapour];
-            int waterOffset = pu.num_phases*i + pu.phase_pos[BlackoilPhases::Aqua];
-
-            if (pu.phase_used[BlackoilPhases::Aqua]) {
-                Eval BEval = 1.0/waterPvt_.inverseFormationVolumeFactor(pvtRegionIdx, TEval, pEval);
-
-                B[waterOffset] = BEval;
-            }
-
-            if (pu.phase_used[BlackoilPhases::Liquid]) {
-                double currentRs = 0.0;
-                double maxRs = 0.0;
-                if (pu.phase_used[BlackoilPhases::Vapour]) {
-                    currentRs = (z[oilOffset] == 0.0) ? 0.0 : z[gasOffset]/z[oilOffset];
-                    maxRs = oilPvt_.saturatedGasDissolutionFactor(pvtRegionIdx, TEval, pEval);
-                }
-                Eval BEval;
-                if (currentRs >= maxRs) {
-                    BEval = 1.0/oilPvt_.saturatedInverseFormationVolumeFactor(pvtRegionIdx, TEval, pEval);
-                }
-                else {
-                    RsEval = currentRs;
-                    BEval = 1.0/oilPvt_.inverseFormationVolumeFactor(pvtRegionIdx, TEval, pEval, RsEval);
-                }
-
-                B[oilOffset] = BEval;
-            }
-
-            if (pu.phase_used[BlackoilPhases::Vapour]) {
-                double currentRv = 0.0;
-                double maxRv = 0.0;
-                if (pu.phase_used[BlackoilPhases::Liquid]) {
-                    currentRv = (z[gasOffset] == 0.0) ? 0.0 : z[oilOffset]/z[gasOffset];
-                    maxRv = gasPvt_.saturatedOilVaporizationFactor(pvtRegionIdx, TEval, pEval);
-                }
-                Eval BEval;
-                if (currentRv >= maxRv) {
-                    BEval = 1.0/gasPvt_.saturatedInverseFormationVolumeFactor(pvtRegionIdx, TEval, pEval);
-                }
-                else {
-                    RvEval = currentRv;
-                    BEval = 1.0/gasPvt_.inverseFormationVolumeFactor(pvtRegionIdx, TEval, pEval, RvEval);
-                }
-
-                B[gasOffset] = BEval;
-            }
-        }
-    }
-
-    void BlackoilPropertiesFromDeck::compute_dBdp_(const int n,
-                                                   const double* p,
-                                                   const double* T,
-                                                   const double* z,
-                                                   const int* cells,
-                                                   double* B,
-                                                   double* dBdp) const
-    {
-        const auto& pu = phaseUsage();
-
-        typedef Opm::DenseAd::Evaluation<double, /*size=*/1> Eval;
-
-        Eval pEval = 0.0;
-        Eval TEval = 0.0;
-        Eval RsEval = 0.0;
-        Eval RvEval = 0.0;
-
-        pEval.setDerivative(0, 1.0);
-
-        for (int i = 0; i < n; ++ i) {
-            int cellIdx = cells[i];
-            int pvtRegionIdx = cellPvtRegionIdx_[cellIdx];
-            pEval.setValue(p[i]);
-            TEval.setValue(T[i]);
-
-            int oilOffset = pu.num_phases*i + pu.phase_pos[BlackoilPhases::Liquid];
-            int gasOffset = pu.num_phases*i + pu.phase_pos[BlackoilPhases::Vapour];
-            int waterOffset = pu.num_phases*i + pu.phase_pos[BlackoilPhases::Aqua];
-
-            if (pu.phase_used[BlackoilPhases::Aqua]) {
-                Eval BEval = 1.0/waterPvt_.inverseFormationVolumeFactor(pvtRegionIdx, TEval, pEval);
-
-                B[waterOffset] = BEval.value();
-                dBdp[waterOffset] = BEval.derivative(0);
-            }
-
-            if (pu.phase_used[BlackoilPhases::Liquid]) {
-                double currentRs = 0.0;
-                double maxRs = 0.0;
-                if (pu.phase_used[BlackoilPhases::Vapour]) {
-                    currentRs = (z[oilOffset] == 0.0) ? 0.0 : z[gasOffset]/z[oilOffset];
-                    maxRs = oilPvt_.saturatedGasDissolutionFactor(pvtRegionIdx, TEval.value(), pEval.value());
-                }
-                Eval BEval;
-                if (currentRs >= maxRs) {
-                    BEval = 1.0/oilPvt_.saturatedInverseFormationVolumeFactor(pvtRegionIdx, TEval, pEval);
-                }
-                else {
-                    RsEval.setValue(currentRs);
-                    BEval = 1.0/oilPvt_.inverseFormationVolumeFactor(pvtRegionIdx, TEval, pEval, RsEval);
-                }
-
-                B[oilOffset] = BEval.value();
-                dBdp[oilOffset] = BEval.derivative(0);
-            }
-
-            if (pu.phase_used[BlackoilPhases::Vapour]) {
-                double currentRv = 0.0;
-                double maxRv = 0.0;
-                if (pu.phase_used[BlackoilPhases::Liquid]) {
-                    currentRv = (z[gasOffset] == 0.0) ? 0.0 : z[oilOffset]/z[gasOffset];
-                    maxRv = gasPvt_.saturatedOilVaporizationFactor(pvtRegionIdx, TEval.value(), pEval.value());
-                }
-                Eval BEval;
-                if (currentRv >= maxRv) {
-                    BEval = 1.0/gasPvt_.saturatedInverseFormationVolumeFactor(pvtRegionIdx, TEval, pEval);
-                }
-                else {
-                    RvEval.setValue(currentRv);
-                    BEval = 1.0/gasPvt_.inverseFormationVolumeFactor(pvtRegionIdx, TEval, pEval, RvEval);
-                }
-
-                B[gasOffset] = BEval.value();
-                dBdp[gasOffset] = BEval.derivative(0);
-            }
-        }
-    }
-
     void BlackoilPropertiesFromDeck::compute_R_(const int n,
                                                 const double* p,
                                                 const double* T,
@@ -593,68 +571,6 @@ namespace Opm
         }
     }
 
-    void BlackoilPropertiesFromDeck::compute_dRdp_(const int n,
-                                                   const double* p,
-                                                   const double* T,
-                                                   const double* z,
-                                                   const int* cells,
-                                                   double* R,
-                                                   double* dRdp) const
-    {
-        const auto& pu = phaseUsage();
-
-        typedef Opm::DenseAd::Evaluation<double, /*size=*/1> Eval;
-        typedef Opm::MathToolbox<Eval> Toolbox;
-
-        Eval pEval = 0.0;
-        Eval TEval = 0.0;
-
-        pEval.setDerivative(0, 1.0);
-
-        for (int i = 0; i < n; ++ i) {
-            int cellIdx = cells[i];
-            int pvtRegionIdx = cellPvtRegionIdx_[cellIdx];
-            pEval.setValue(p[i]);
-            TEval.setValue(T[i]);
-
-            int oilOffset = pu.num_phases*i + pu.phase_pos[BlackoilPhases::Liquid];
-            int gasOffset = pu.num_phases*i + pu.phase_pos[BlackoilPhases::Vapour];
-            int waterOffset = pu.num_phases*i + pu.phase_pos[BlackoilPhases::Aqua];
-
-            if (pu.phase_used[BlackoilPhases::Aqua]) {
-                R[waterOffset] = 0.0; // water is always immiscible!
-            }
-
-            if (pu.phase_used[BlackoilPhases::Liquid]) {
-                Eval RsSatEval = oilPvt_.saturatedGasDissolutionFactor(pvtRegionIdx, TEval, pEval);
-
-                Eval currentRs = 0.0;
-                if (pu.phase_used[BlackoilPhases::Vapour]) {
-                    currentRs = (z[oilOffset] == 0.0) ? 0.0 : z[gasOffset]/z[oilOffset];
-                }
-
-                RsSatEval = Toolbox::min(RsSatEval, currentRs);
-
-                R[oilOffset] = RsSatEval.value();
-                dRdp[oilOffset] = RsSatEval.derivative(0);
-            }
-
-            if (pu.phase_used[BlackoilPhases::Vapour]) {
-                Eval RvSatEval = gasPvt_.saturatedOilVaporizationFactor(pvtRegionIdx, TEval, pEval);
-
-                Eval currentRv = 0.0;
-                if (pu.phase_used[BlackoilPhases::Liquid]) {
-                    currentRv = (z[gasOffset] == 0.0) ? 0.0 : z[oilOffset]/z[gasOffset];
-                }
-
-                RvSatEval = Toolbox::min(RvSatEval, currentRv);
-
-                R[gasOffset] = RvSatEval.value();
-                dRdp[gasOffset] = RvSatEval.derivative(0);
-            }
-        }
-    }
-
     /// \param[in]  n      Number of data points.
     /// \param[in]  A      Array of nP^2 values, where the P^2 values for a cell give the
     ///                    matrix A = RB^{-1} which relates z to u by z = Au. The matrices
@@ -260,21 +260,6 @@ namespace Opm
 
         void initSurfaceDensities_(const Opm::Deck& deck);
 
-        void compute_B_(const int n,
-                        const double* p,
-                        const double* T,
-                        const double* z,
-                        const int* cells,
-                        double* B) const;
-
-        void compute_dBdp_(const int n,
-                           const double* p,
-                           const double* T,
-                           const double* z,
-                           const int* cells,
-                           double* B,
-                           double* dBdp) const;
-
         void compute_R_(const int n,
                         const double* p,
                         const double* T,
@@ -282,13 +267,19 @@ namespace Opm
                         const int* cells,
                         double* R) const;
 
-        void compute_dRdp_(const int n,
-                           const double* p,
-                           const double* T,
-                           const double* z,
-                           const int* cells,
-                           double* R,
-                           double* dRdp) const;
+        // B and R in one pass, evaluating the saturated Rs and Rv of
+        // each point once. Eval is double, or an evaluation with the
+        // pressure derivative if dBdp and dRdp are to be computed.
+        template <class Eval>
+        void compute_BR_(const int n,
+                         const double* p,
+                         const double* T,
+                         const double* z,
+                         const int* cells,
+                         double* B,
+                         double* R,
+                         double* dBdp,
+                         double* dRdp) const;
 
         void init(const Opm::Deck& deck,
                   const Opm::EclipseState& eclState,
@@ -20,6 +20,8 @@
 #ifndef OPM_RELPERMDIAGNOSTICS_IMPL_HEADER_INCLUDED
 #define OPM_RELPERMDIAGNOSTICS_IMPL_HEADER_INCLUDED
 
+#include <array>
+#include <string>
 #include <vector>
 #include <utility>
 
@@ -56,9 +58,49 @@ namespace Opm {
         EclEpsGridProperties epsGridProperties;
         epsGridProperties.initFromDeck(deck, eclState, /*imbibition=*/false);       
         const auto& satnum = eclState.get3DProperties().getIntGridProperty("SATNUM");
-        
+        const bool checkMobility = deck.hasKeyword("SCALECRS") && fluidSystem_ == FluidSystem::BlackOil;
+
+        // Failed checks of each cell, one bit per check.
+        enum { SguCheck = 1, SglCheck = 2, SwcrCheck = 4, SgcrCheck = 8 };
+        std::vector<unsigned char> failed(nc, 0);
+
+        // The end points and checks of a cell are independent of the
+        // other cells, and the messages are only formatted for the
+        // (few) cells that fail.
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
+        for (int c = 0; c < nc; ++c) {
+            auto& eps = scaledEpsInfo_[c];
+            eps.extractScaled(eclState, epsGridProperties, compressedToCartesianIdx[c]);
+
+            // SGU <= 1.0 - SWL
+            if (eps.Sgu > (1.0 - eps.Swl + tolerance)) {
+                failed[c] |= SguCheck;
+            }
+
+            // SGL <= 1.0 - SWU
+            if (eps.Sgl > (1.0 - eps.Swu + tolerance)) {
+                failed[c] |= SglCheck;
+            }
+
+            if (checkMobility) {
+                // Mobilility check.
+                if ((eps.Sowcr + eps.Swcr) >= (1.0 + tolerance)) {
+                    failed[c] |= SwcrCheck;
+                }
+
+                if ((eps.Sogcr + eps.Sgcr + eps.Swl) >= (1.0 + tolerance)) {
+                    failed[c] |= SgcrCheck;
+                }
+            }
+        }
+
         const std::string tag = "Scaled endpoints";
         for (int c = 0; c < nc; ++c) {
+            if (failed[c] == 0) {
+                continue;
+            }
             const int cartIdx = compressedToCartesianIdx[c];
             const std::string satnumIdx = std::to_string(satnum.iget(cartIdx));
             std::array<int, 3> ijk;
@@ -68,31 +110,19 @@ namespace Opm {
             const std::string cellIdx = "(" + std::to_string(ijk[0]) + ", " + 
                                    std::to_string(ijk[1]) + ", " +
                                    std::to_string(ijk[2]) + ")";
-            scaledEpsInfo_[c].extractScaled(eclState, epsGridProperties, cartIdx);
+            const std::string prefix = "For scaled endpoints input, cell" + cellIdx + " SATNUM = " + satnumIdx;
 
-            // SGU <= 1.0 - SWL
-            if (scaledEpsInfo_[c].Sgu > (1.0 - scaledEpsInfo_[c].Swl + tolerance)) {
-                const std::string msg = "For scaled endpoints input, cell" + cellIdx + " SATNUM = " + satnumIdx + ", SGU exceed 1.0 - SWL";
-                OpmLog::warning(tag, msg);
+            if (failed[c] & SguCheck) {
+                OpmLog::warning(tag, prefix + ", SGU exceed 1.0 - SWL");
             }
-            
-            // SGL <= 1.0 - SWU
-            if (scaledEpsInfo_[c].Sgl > (1.0 - scaledEpsInfo_[c].Swu + tolerance)) {
-                const std::string msg = "For scaled endpoints input, cell" + cellIdx + " SATNUM = " + satnumIdx + ", SGL exceed 1.0 - SWU";
-                OpmLog::warning(tag, msg);
+            if (failed[c] & SglCheck) {
+                OpmLog::warning(tag, prefix + ", SGL exceed 1.0 - SWU");
             }
-
-            if (deck.hasKeyword("SCALECRS") && fluidSystem_ == FluidSystem::BlackOil) {
-                // Mobilility check.
-		    if ((scaledEpsInfo_[c].Sowcr + scaledEpsInfo_[c].Swcr) >= (1.0 + tolerance)) {
-                    const std::string msg = "For scaled endpoints input, cell" + cellIdx + " SATNUM = " + satnumIdx + ", SOWCR + SWCR exceed 1.0";
-                    OpmLog::warning(tag, msg);
-                }
-
-            if ((scaledEpsInfo_[c].Sogcr + scaledEpsInfo_[c].Sgcr + scaledEpsInfo_[c].Swl) >= (1.0 + tolerance)) {
-                    const std::string msg = "For scaled endpoints input, cell" + cellIdx + " SATNUM = " + satnumIdx + ", SOGCR + SGCR + SWL exceed 1.0";
-                    OpmLog::warning(tag, msg);
-                }
+            if (failed[c] & SwcrCheck) {
+                OpmLog::warning(tag, prefix + ", SOWCR + SWCR exceed 1.0");
+            }
+            if (failed[c] & SgcrCheck) {
+                OpmLog::warning(tag, prefix + ", SOGCR + SGCR + SWL exceed 1.0");
             }
         } 
     }
@@ -28,6 +28,8 @@
 #include <opm/core/simulator/ExplicitArraysFluidState.hpp>
 #include <opm/core/simulator/ExplicitArraysSatDerivativesFluidState.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <map>
 
@@ -61,6 +63,95 @@ namespace Opm
 
 
 
+    /// Tabulate the saturation functions of two-phase cases.
+    void SaturationPropsFromDeck::tabulate(const int numCells,
+                                           const int numPoints,
+                                           const int minCellsPerTable)
+    {
+        cellTable_.clear();
+        tables_.clear();
+        tablePoints_ = 0;
+
+        const int np = numPhases();
+        if (np != 2 || numPoints < 2 || materialLawManager_->enableHysteresis()) {
+            return;
+        }
+
+        // Group the cells by their values in the sample points.
+        const int numSamples = 16;
+        std::vector<double> samples(np*numSamples);
+        for (int k = 0; k < numSamples; ++k) {
+            samples[np*k] = (k + 0.5)/numSamples;
+            samples[np*k + 1] = 1.0 - samples[np*k];
+        }
+        std::map<std::vector<double>, std::vector<int>> groups;
+        std::vector<int> sampleCells(numSamples);
+        std::vector<double> signature(2*np*numSamples);
+        for (int cell = 0; cell < numCells; ++cell) {
+            std::fill(sampleCells.begin(), sampleCells.end(), cell);
+            relpermFromLaw(numSamples, samples.data(), sampleCells.data(), signature.data(), nullptr);
+            capPressFromLaw(numSamples, samples.data(), sampleCells.data(), signature.data() + np*numSamples, nullptr);
+            groups[signature].push_back(cell);
+        }
+
+        // Evaluate the material law of one cell per group in the table points.
+        const int stride = 2*np + 2*np*np;
+        cellTable_.assign(numCells, -1);
+        tablePoints_ = numPoints;
+        for (const auto& group : groups) {
+            const std::vector<int>& cells = group.second;
+            if (int(cells.size()) < minCellsPerTable) {
+                continue;
+            }
+            std::vector<double> table(stride*numPoints);
+            for (int k = 0; k < numPoints; ++k) {
+                const double sat[2] = { double(k)/(numPoints - 1), 1.0 - double(k)/(numPoints - 1) };
+                double* point = table.data() + stride*k;
+                relpermFromLaw(1, sat, &cells[0], point, point + np);
+                capPressFromLaw(1, sat, &cells[0], point + np + np*np, point + 2*np + np*np);
+            }
+            for (const int cell : cells) {
+                cellTable_[cell] = tables_.size();
+            }
+            tables_.push_back(std::move(table));
+        }
+
+        if (tables_.empty()) {
+            cellTable_.clear();
+            tablePoints_ = 0;
+        }
+    }
+
+
+
+
+    bool SaturationPropsFromDeck::interpolate(const double* s,
+                                              const int cell,
+                                              const int offset,
+                                              const int count,
+                                              double* values) const
+    {
+        const int table = cellTable_[cell];
+        if (table < 0 || std::abs(s[0] + s[1] - 1.0) > 1e-12) {
+            return false;
+        }
+
+        const int np = numPhases();
+        const int stride = 2*np + 2*np*np;
+        const double x = std::min(std::max(s[0], 0.0), 1.0)*(tablePoints_ - 1);
+        const int k = std::min(int(x), tablePoints_ - 2);
+        const double w = x - k;
+        const double* lower = tables_[table].data() + stride*k + offset;
+        const double* upper = lower + stride;
+        for (int j = 0; j < count; ++j) {
+            values[j] = (1.0 - w)*lower[j] + w*upper[j];
+        }
+        return true;
+    }
+
+
+
+
     /// Relative permeability.
     /// \param[in]  n      Number of data points.
     /// \param[in]  s      Array of nP saturation values.
@@ -79,6 +170,31 @@ namespace Opm
     {
         assert(cells != 0);
 
+        if (cellTable_.empty()) {
+            relpermFromLaw(n, s, cells, kr, dkrds);
+            return;
+        }
+
+        const int np = numPhases();
+        for (int i = 0; i < n; ++i) {
+            const bool tabulated = interpolate(s + np*i, cells[i], 0, np, kr + np*i)
+                && (!dkrds || interpolate(s + np*i, cells[i], np, np*np, dkrds + np*np*i));
+            if (!tabulated) {
+                relpermFromLaw(1, s + np*i, cells + i, kr + np*i, dkrds ? dkrds + np*np*i : nullptr);
+            }
+        }
+    }
+
+
+
+
+    void SaturationPropsFromDeck::relpermFromLaw(const int n,
+                                                 const double* s,
+                                                 const int* cells,
+                                                 double* kr,
+                                                 double* dkrds) const
+    {
+
         const int np = numPhases();
         if (dkrds) {
             ExplicitArraysSatDerivativesFluidState fluidState(phaseUsage_);
@@ -139,6 +255,30 @@ namespace Opm
         assert(cells != 0);
         assert(phaseUsage_.phase_used[BlackoilPhases::Liquid]);
 
+        if (cellTable_.empty()) {
+            capPressFromLaw(n, s, cells, pc, dpcds);
+            return;
+        }
+
+        const int np = numPhases();
+        for (int i = 0; i < n; ++i) {
+            const bool tabulated = interpolate(s + np*i, cells[i], np + np*np, np, pc + np*i)
+                && (!dpcds || interpolate(s + np*i, cells[i], 2*np + np*np, np*np, dpcds + np*np*i));
+            if (!tabulated) {
+                capPressFromLaw(1, s + np*i, cells + i, pc + np*i, dpcds ? dpcds + np*np*i : nullptr);
+            }
+        }
+    }
+
+
+
+
+    void SaturationPropsFromDeck::capPressFromLaw(const int n,
+                                                  const double* s,
+                                                  const int* cells,
+                                                  double* pc,
+                                                  double* dpcds) const
+    {
         const int np = numPhases();
 
         if (dpcds) {
@@ -367,5 +507,9 @@ namespace Opm
                                                               double& swat)
     {
         swat = materialLawManager_->applySwatinit(cell, pcow, swat);
+        // the capillary pressure of the cell is scaled individually now
+        if (!cellTable_.empty()) {
+            cellTable_[cell] = -1;
+        }
     }
 } // namespace Opm
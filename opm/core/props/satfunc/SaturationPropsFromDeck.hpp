@@ -75,6 +75,20 @@ namespace Opm
         /// \return   P, the number of phases.
         int numPhases() const;
 
+        /// Tabulate the relative permeabilities and capillary pressures of
+        /// two-phase cases on a uniform grid of the saturation of the first
+        /// phase, such that they are computed by linear interpolation.
+        /// Cells share a table when their saturation functions agree in a
+        /// set of sample points, and groups of less than minCellsPerTable
+        /// cells keep using the material law. Nothing is tabulated for
+        /// three-phase cases or with hysteresis.
+        /// \param[in]  numCells          Number of cells.
+        /// \param[in]  numPoints         Number of points of the tables.
+        /// \param[in]  minCellsPerTable  Minimum number of cells of a table.
+        void tabulate(const int numCells,
+                      const int numPoints,
+                      const int minCellsPerTable = 10);
+
         /// Relative permeability.
         /// \param[in]  n      Number of data points.
         /// \param[in]  s      Array of nP saturation values.
@@ -170,8 +184,35 @@ namespace Opm
 
 
     private:
+        void relpermFromLaw(const int n,
+                            const double* s,
+                            const int* cells,
+                            double* kr,
+                            double* dkrds) const;
+
+        void capPressFromLaw(const int n,
+                             const double* s,
+                             const int* cells,
+                             double* pc,
+                             double* dpcds) const;
+
+        /// Interpolates the entries [offset, offset + count) of the
+        /// tabulated point values and returns false if cell i is not
+        /// tabulated or its saturations do not sum to one.
+        bool interpolate(const double* s,
+                         const int cell,
+                         const int offset,
+                         const int count,
+                         double* values) const;
+
         std::shared_ptr<MaterialLawManager> materialLawManager_;
         PhaseUsage phaseUsage_;
+
+        // Tabulated saturation functions, see tabulate(). Each table point
+        // holds kr, dkrds, pc and dpcds.
+        std::vector<int> cellTable_;
+        std::vector<std::vector<double>> tables_;
+        int tablePoints_ = 0;
     };
 
 
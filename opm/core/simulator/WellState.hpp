@@ -32,6 +32,7 @@
 #include <vector>
 #include <cassert>
 #include <cstddef>
+#include <cstring>
 
 namespace Opm
 {
@@ -55,9 +56,15 @@ namespace Opm
         /// with -1e100.
         void init(const Wells* wells, const std::vector<double>& cellPressures)
         {
-            // clear old name mapping
-            wellMap_.clear();
-            wells_.reset( clone_wells( wells ) );
+            // the name mapping only needs to be rebuilt if the wells have changed,
+            // which is not the case for most report steps
+            const bool same_wells = sameWells(wells, wells_.get());
+            std::shared_ptr<WellMapType> wellMap;
+            if (!same_wells) {
+                wellMap = std::make_shared<WellMapType>();
+                wellMap_ = wellMap;
+            }
+            wells_.reset( clone_wells( wells ), wdel() );
 
             if (wells) {
                 const int nw = wells->number_of_wells;
@@ -72,11 +79,11 @@ namespace Opm
                     const int num_perf_this_well = wells->well_connpos[w + 1] - wells->well_connpos[w];
 
                     // setup wellname -> well index mapping
-                    {
+                    if (!same_wells) {
                         assert( wells->name[ w ] );
                         std::string name( wells->name[ w ] );
                         assert( name.size() > 0 );
-                        mapentry_t& wellMapEntry = wellMap_[name];
+                        mapentry_t& wellMapEntry = (*wellMap)[name];
                         wellMapEntry[ 0 ] = w;
                         wellMapEntry[ 1 ] = wells->well_connpos[w];
                         // also store the number of perforations in this well
@@ -209,8 +216,7 @@ namespace Opm
             return getRestartTemperatureOffset() + temperature_.size();
         }
 
-        const WellMapType& wellMap() const { return wellMap_; }
-        WellMapType& wellMap() { return wellMap_; }
+        const WellMapType& wellMap() const { return *wellMap_; }
 
         /// The number of wells present.
         int numWells() const
@@ -225,14 +231,35 @@ namespace Opm
         }
 
         virtual data::Wells report(const PhaseUsage& pu, const int* globalCellIdxMap) const
+        {
+            data::Wells dw;
+            updateReport( pu, globalCellIdxMap, dw );
+            return dw;
+        }
+
+        /// Refresh a report of the well state in place. The wells and
+        /// connections already in the report are overwritten, such that a
+        /// report kept between report steps is only reallocated if the wells
+        /// or their connections change.
+        virtual void updateReport(const PhaseUsage& pu, const int* globalCellIdxMap, data::Wells& dw) const
         {
             using rt = data::Rates::opt;
 
-            data::Wells dw;
-            for( const auto& itr : this->wellMap_ ) {
+            // remove the wells that are not part of the well state any more
+            for( auto it = dw.begin(); it != dw.end(); ) {
+                if( this->wellMap_->count( it->first ) == 0 ) {
+                    it = dw.erase( it );
+                }
+                else {
+                    ++it;
+                }
+            }
+
+            for( const auto& itr : *this->wellMap_ ) {
                 const auto well_index = itr.second[ 0 ];
 
                 auto& well = dw[ itr.first ];
+                well.rates = data::Rates();
                 well.bhp = this->bhp().at( well_index );
                 well.thp = this->thp().at( well_index );
                 well.temperature = this->temperature().at( well_index );
@@ -260,43 +287,26 @@ namespace Opm
                     const auto active_index = this->wells_->well_cells[ wi ];
 
                     auto& connection = well.connections[ i ];
+                    connection.rates = data::Rates();
                     connection.index = globalCellIdxMap[active_index];
                     connection.pressure = this->perfPress()[ itr.second[1] + i ];
                     connection.reservoir_rate = this->perfRates()[ itr.second[1] + i ];
                 }
                 assert(num_perf_well == int(well.connections.size()));
             }
-
-            return dw;
-
         }
 
         virtual ~WellState() {}
 
+        // The wells and the well map are not modified after init(), hence the
+        // copies of a state share them, and copying a state, e.g. to restart a
+        // time step, only copies the arrays of the state, whose storage is
+        // reused if the sizes match.
         WellState() = default;
-        WellState( const WellState& rhs ) :
-            bhp_( rhs.bhp_ ),
-            thp_( rhs.thp_ ),
-            temperature_( rhs.temperature_ ),
-            wellrates_( rhs.wellrates_ ),
-            perfrates_( rhs.perfrates_ ),
-            perfpress_( rhs.perfpress_ ),
-            wellMap_( rhs.wellMap_ ),
-            wells_( clone_wells( rhs.wells_.get() ) )
-        {}
-
-        WellState& operator=( const WellState& rhs ) {
-            this->bhp_ = rhs.bhp_;
-            this->thp_ = rhs.thp_;
-            this->temperature_ = rhs.temperature_;
-            this->wellrates_ = rhs.wellrates_;
-            this->perfrates_ = rhs.perfrates_;
-            this->perfpress_ = rhs.perfpress_;
-            this->wellMap_ = rhs.wellMap_;
-            this->wells_.reset( clone_wells( rhs.wells_.get() ) );
-
-            return *this;
-        }
+        WellState( const WellState& rhs ) = default;
+        WellState& operator=( const WellState& rhs ) = default;
+        WellState( WellState&& rhs ) = default;
+        WellState& operator=( WellState&& rhs ) = default;
 
     private:
         std::vector<double> bhp_;
@@ -306,13 +316,33 @@ namespace Opm
         std::vector<double> perfrates_;
         std::vector<double> perfpress_;
 
-        WellMapType wellMap_;
+        std::shared_ptr<const WellMapType> wellMap_ = std::make_shared<WellMapType>();
 
     protected:
+        /// Whether two sets of wells consist of the same wells in the same
+        /// order with the same number of perforations each.
+        static bool sameWells(const Wells* wells1, const Wells* wells2)
+        {
+            if (wells1 == nullptr || wells2 == nullptr) {
+                return wells1 == wells2;
+            }
+            const int nw = wells1->number_of_wells;
+            if (nw != wells2->number_of_wells) {
+                return false;
+            }
+            for (int w = 0; w < nw; ++w) {
+                if (wells1->well_connpos[w + 1] != wells2->well_connpos[w + 1]
+                    || std::strcmp(wells1->name[w], wells2->name[w]) != 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
         struct wdel {
             void operator()( Wells* w ) { destroy_wells( w ); }
         };
-        std::unique_ptr< Wells, wdel > wells_;
+        std::shared_ptr< const Wells > wells_;
     };
 
 } // namespace Opm
@@ -46,6 +46,7 @@
 
 #include <array>
 #include <cassert>
+#include <limits>
 #include <utility>
 #include <vector>
 
@@ -115,6 +116,51 @@ namespace Opm
                        const double            grav = unit::gravity);
 
 
+        /**
+         * Vertical extent of a set of cells.
+         *
+         * \param[in] G     Grid.
+         * \param[in] cells Range of cells.
+         *
+         * \return Minimum and maximum depth of the vertices of the
+         * cells, or [max, -max] if the range is empty.
+         */
+        template <class Grid, class CellRange>
+        std::array<double,2>
+        verticalSpan(const Grid&      G,
+                     const CellRange& cells);
+
+
+        /**
+         * Compute initial phase pressures by means of equilibration,
+         * integrating the phase pressure ODEs over a given vertical
+         * span rather than the span of 'cells'.
+         *
+         * Ranks of a distributed run use this with the span of the
+         * whole region, so that all of them integrate the same
+         * pressure tables and agree on the pressures of the cells they
+         * share.
+         *
+         * \param[in] G     Grid.
+         * \param[in] reg   Current equilibration region.
+         * \param[in] cells Range that spans the cells of the current
+         *                  equilibration region.
+         * \param[in] span  Vertical span of the integration, must
+         *                  contain the vertices of 'cells'.
+         * \param[in] grav  Acceleration of gravity.
+         *
+         * \return Phase pressures, one vector for each active phase,
+         * of pressure values in each cell in 'cells'.
+         */
+        template <class FluidSystem, class Grid, class Region, class CellRange>
+        std::vector< std::vector<double> >
+        phasePressures(const Grid&             G,
+                       const Region&           reg,
+                       const CellRange&        cells,
+                       std::array<double,2>    span,
+                       const double            grav);
+
+
 
         /**
          * Compute initial phase saturations by means of equilibration.
@@ -229,6 +275,16 @@ namespace Opm
                 return eqlnum;
             }
 
+            /// Collective communication of a serial run, a stand-in
+            /// for the communicator of a distributed grid.
+            struct SerialCommunication
+            {
+                template <class T>
+                int min(T* /* inout */, int /* len */) const { return 0; }
+                template <class T>
+                int max(T* /* inout */, int /* len */) const { return 0; }
+            };
+
             template<class FluidSystem>
             class InitialStateComputer {
             public:
@@ -245,6 +301,54 @@ namespace Opm
                           std::vector<double>(UgGridHelpers::numCells(G))),
                       rs_(UgGridHelpers::numCells(G)),
                       rv_(UgGridHelpers::numCells(G))
+                {
+                    init(materialLawManager, eclipseState, G, SerialCommunication(), grav, applySwatInit);
+                }
+
+                /// Equilibrate the local partition of a distributed grid.
+                ///
+                /// G is the grid of this rank, with its global cell
+                /// mapping, and the state is only computed for its
+                /// cells. The vertical span of each equilibration region
+                /// is reduced over comm, which is a collective call, so
+                /// all ranks integrate the same pressure tables.
+                /// \param[in] comm  Collective communication of the ranks,
+                ///                  e.g. grid.comm() of a Dune grid; must
+                ///                  provide min(T*, int) and max(T*, int).
+                template<class MaterialLawManager, class Grid, class Comm>
+                InitialStateComputer(MaterialLawManager& materialLawManager,
+                                     const Opm::EclipseState& eclipseState,
+                                     const Grid&                        G    ,
+                                     const Comm&                        comm ,
+                                     const double grav,
+                                     const bool applySwatInit = true
+                                     )
+                    : pp_(FluidSystem::numPhases,
+                          std::vector<double>(UgGridHelpers::numCells(G))),
+                      sat_(FluidSystem::numPhases,
+                          std::vector<double>(UgGridHelpers::numCells(G))),
+                      rs_(UgGridHelpers::numCells(G)),
+                      rv_(UgGridHelpers::numCells(G))
+                {
+                    init(materialLawManager, eclipseState, G, comm, grav, applySwatInit);
+                }
+
+                typedef std::vector<double> Vec;
+                typedef std::vector<Vec>    PVec; // One per phase.
+
+                const PVec& press() const { return pp_; }
+                const PVec& saturation() const { return sat_; }
+                const Vec& rs() const { return rs_; }
+                const Vec& rv() const { return rv_; }
+
+            private:
+                template<class MaterialLawManager, class Grid, class Comm>
+                void init(MaterialLawManager& materialLawManager,
+                          const Opm::EclipseState& eclipseState,
+                          const Grid&                        G    ,
+                          const Comm&                        comm ,
+                          const double grav,
+                          const bool applySwatInit)
                 {
                     //Check for presence of kw SWATINIT
                     if (eclipseState.get3DProperties().hasDeckDoubleGridProperty("SWATINIT") && applySwatInit) {
@@ -345,21 +449,12 @@ namespace Opm
                     }
                     
                     // Compute pressures, saturations, rs and rv factors.
-                    calcPressSatRsRv(eqlmap, rec, materialLawManager, G, grav);
+                    calcPressSatRsRv(eqlmap, rec, materialLawManager, G, comm, grav);
 
                     // Modify oil pressure in no-oil regions so that the pressures of present phases can
                     // be recovered from the oil pressure and capillary relations.
                 }
 
-                typedef std::vector<double> Vec;
-                typedef std::vector<Vec>    PVec; // One per phase.
-
-                const PVec& press() const { return pp_; }
-                const PVec& saturation() const { return sat_; }
-                const Vec& rs() const { return rs_; }
-                const Vec& rv() const { return rv_; }
-
-            private:
                 typedef EquilReg EqReg;
                 std::vector< std::shared_ptr<Miscibility::RsFunction> > rs_func_;
                 std::vector< std::shared_ptr<Miscibility::RsFunction> > rv_func_;
@@ -382,14 +477,27 @@ namespace Opm
                     }
                 }
 
-                template <class RMap, class MaterialLawManager, class Grid>
+                template <class RMap, class MaterialLawManager, class Grid, class Comm>
                 void
                 calcPressSatRsRv(const RMap&                       reg  ,
                                  const std::vector< EquilRecord >& rec  ,
                                  MaterialLawManager& materialLawManager,
                                  const Grid&                       G    ,
+                                 const Comm&                       comm ,
                                  const double grav)
                 {
+                    // Vertical span of each region over all ranks.
+                    const int nreg = rec.size();
+                    std::vector<double> span_min(nreg,  std::numeric_limits<double>::max());
+                    std::vector<double> span_max(nreg, -std::numeric_limits<double>::max());
+                    for (const auto& r : reg.activeRegions()) {
+                        const auto span = verticalSpan(G, reg.cells(r));
+                        span_min[r] = span[0];
+                        span_max[r] = span[1];
+                    }
+                    comm.min(span_min.data(), nreg);
+                    comm.max(span_max.data(), nreg);
+
                     for (const auto& r : reg.activeRegions()) {
                         const auto& cells = reg.cells(r);
                         if (cells.empty())
@@ -401,7 +509,8 @@ namespace Opm
 
                         const EqReg eqreg(rec[r], rs_func_[r], rv_func_[r], regionPvtIdx_[r]);
                    
-                        PVec pressures = phasePressures<FluidSystem>(G, eqreg, cells, grav);
+                        const std::array<double,2> span = {{ span_min[r], span_max[r] }};
+                        PVec pressures = phasePressures<FluidSystem>(G, eqreg, cells, span, grav);
                         const std::vector<double>& temp = temperature(G, eqreg, cells);
                         const PVec sat = phaseSaturations<FluidSystem>(G, eqreg, cells, materialLawManager, swat_init_, pressures);
 
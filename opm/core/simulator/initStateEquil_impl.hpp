@@ -25,6 +25,7 @@
 
 #include <opm/grid/UnstructuredGrid.h>
 #include <opm/grid/GridHelpers.hpp>
+#include <opm/core/utility/OmpExceptionGuard.hpp>
 
 #include <opm/material/fluidsystems/BlackOilFluidSystem.hpp>
 
@@ -502,63 +503,72 @@ namespace Opm
     namespace EQUIL {
 
 
-        template <class FluidSystem,
-                  class Grid,
-                  class Region,
-                  class CellRange>
-        std::vector< std::vector<double> >
-        phasePressures(const Grid&             G,
-                       const Region&           reg,
-                       const CellRange&        cells,
-                       const double            grav)
+        template <class Grid, class CellRange>
+        std::array<double,2>
+        verticalSpan(const Grid&      G,
+                     const CellRange& cells)
         {
             std::array<double,2> span =
                 {{  std::numeric_limits<double>::max() ,
                    -std::numeric_limits<double>::max() }}; // Symm. about 0.
 
-            int ncell = 0;
+            // This code is only supported in three space dimensions
+            assert (UgGridHelpers::dimensions(G) == 3);
+
+            const int nd = UgGridHelpers::dimensions(G);
+
+            // Define vertical span as
+            //
+            //   [minimum(node depth(cells)), maximum(node depth(cells))]
+            //
+            // Note: We use a sledgehammer approach--looping all
+            // the nodes of all the faces of all the 'cells'--to
+            // compute those bounds.  This necessarily entails
+            // visiting some nodes (and faces) multiple times.
+            //
+            // Note: The implementation of 'RK4IVP<>' implicitly
+            // imposes the requirement that cell centroids are all
+            // within this vertical span.  That requirement is not
+            // checked.
+            auto cell2Faces = UgGridHelpers::cell2Faces(G);
+            auto faceVertices = UgGridHelpers::face2Vertices(G);
+
+            for (typename CellRange::const_iterator
+                     ci = cells.begin(), ce = cells.end();
+                 ci != ce; ++ci)
             {
-                // This code is only supported in three space dimensions
-                assert (UgGridHelpers::dimensions(G) == 3);
-
-                const int nd = UgGridHelpers::dimensions(G);
-
-                // Define vertical span as
-                //
-                //   [minimum(node depth(cells)), maximum(node depth(cells))]
-                //
-                // Note: We use a sledgehammer approach--looping all
-                // the nodes of all the faces of all the 'cells'--to
-                // compute those bounds.  This necessarily entails
-                // visiting some nodes (and faces) multiple times.
-                //
-                // Note: The implementation of 'RK4IVP<>' implicitly
-                // imposes the requirement that cell centroids are all
-                // within this vertical span.  That requirement is not
-                // checked.
-                auto cell2Faces = UgGridHelpers::cell2Faces(G);
-                auto faceVertices = UgGridHelpers::face2Vertices(G);
-
-                for (typename CellRange::const_iterator
-                         ci = cells.begin(), ce = cells.end();
-                     ci != ce; ++ci, ++ncell)
+                for (auto fi=cell2Faces[*ci].begin(),
+                          fe=cell2Faces[*ci].end();
+                     fi != fe;
+                     ++fi)
                 {
-                    for (auto fi=cell2Faces[*ci].begin(),
-                              fe=cell2Faces[*ci].end();
-                         fi != fe;
-                         ++fi)
+                    for (auto i = faceVertices[*fi].begin(), e = faceVertices[*fi].end();
+                         i != e; ++i)
                     {
-                        for (auto i = faceVertices[*fi].begin(), e = faceVertices[*fi].end();
-                             i != e; ++i)
-                        {
-                            const double z = UgGridHelpers::vertexCoordinates(G, *i)[nd-1];
+                        const double z = UgGridHelpers::vertexCoordinates(G, *i)[nd-1];
 
-                            if (z < span[0]) { span[0] = z; }
-                            if (z > span[1]) { span[1] = z; }
-                        }
+                        if (z < span[0]) { span[0] = z; }
+                        if (z > span[1]) { span[1] = z; }
                     }
                 }
             }
+
+            return span;
+        }
+
+
+        template <class FluidSystem,
+                  class Grid,
+                  class Region,
+                  class CellRange>
+        std::vector< std::vector<double> >
+        phasePressures(const Grid&             G,
+                       const Region&           reg,
+                       const CellRange&        cells,
+                       std::array<double,2>    span,
+                       const double            grav)
+        {
+            const int ncell = cells.size();
             const int np = FluidSystem::numPhases;  //reg.phaseUsage().num_phases;
 
             typedef std::vector<double> pval;
@@ -576,6 +586,20 @@ namespace Opm
             return press;
         }
 
+
+        template <class FluidSystem,
+                  class Grid,
+                  class Region,
+                  class CellRange>
+        std::vector< std::vector<double> >
+        phasePressures(const Grid&             G,
+                       const Region&           reg,
+                       const CellRange&        cells,
+                       const double            grav)
+        {
+            return phasePressures<FluidSystem>(G, reg, cells, verticalSpan(G, cells), grav);
+        }
+
         template <class Grid,
                   class Region,
                   class CellRange>
@@ -617,7 +641,6 @@ namespace Opm
                     /*storeViscosity=*/false,
                     /*storeEnthalpy=*/false> SatOnlyFluidState;
 
-            SatOnlyFluidState fluidState;
             typedef typename MaterialLawManager::MaterialLaw MaterialLaw;
 
             const bool water = FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx);
@@ -625,124 +648,140 @@ namespace Opm
             const int oilpos = FluidSystem::oilPhaseIdx;
             const int waterpos = FluidSystem::waterPhaseIdx;
             const int gaspos = FluidSystem::gasPhaseIdx;
-            std::vector<double>::size_type local_index = 0;
-            for (typename CellRange::const_iterator ci = cells.begin(); ci != cells.end(); ++ci, ++local_index) {
-                const int cell = *ci;
-                const auto& scaledDrainageInfo =
-                    materialLawManager.oilWaterScaledEpsInfoDrainage(cell);
-                const auto& matParams = materialLawManager.materialLawParams(cell);
-
-                // Find saturations from pressure differences by
-                // inverting capillary pressure functions.
-                double sw = 0.0;
-                if (water) {
-                    if (isConstPc<FluidSystem, MaterialLaw, MaterialLawManager>(materialLawManager,FluidSystem::waterPhaseIdx, cell)){
-                        const double cellDepth  =  UgGridHelpers::cellCenterDepth(G,
-                                                                            cell);
-                        sw = satFromDepth<FluidSystem, MaterialLaw, MaterialLawManager>(materialLawManager,cellDepth,reg.zwoc(),waterpos,cell,false);
-                        phase_saturations[waterpos][local_index] = sw;
-                    }
-                    else{
-                        const double pcov = phase_pressures[oilpos][local_index] - phase_pressures[waterpos][local_index];
-                        if (swat_init.empty()) { // Invert Pc to find sw
-                            sw = satFromPc<FluidSystem, MaterialLaw, MaterialLawManager>(materialLawManager, waterpos, cell, pcov);
-                            phase_saturations[waterpos][local_index] = sw;
-                        } else { // Scale Pc to reflect imposed sw
-                            sw = swat_init[cell];
-                            sw = materialLawManager.applySwatinit(cell, pcov, sw);
+
+            // The cells are independent: each one only reads and writes its
+            // own entries, and applySwatinit() only modifies the scaling of
+            // its own cell.
+            const std::vector<int> cell_list(cells.begin(), cells.end());
+            const int num_cells = cell_list.size();
+            detail::OmpExceptionGuard guard;
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
+            for (int local_index = 0; local_index < num_cells; ++local_index) {
+                try {
+                    const int cell = cell_list[local_index];
+                    SatOnlyFluidState fluidState;
+                    const auto& scaledDrainageInfo =
+                        materialLawManager.oilWaterScaledEpsInfoDrainage(cell);
+                    const auto& matParams = materialLawManager.materialLawParams(cell);
+
+                    // Find saturations from pressure differences by
+                    // inverting capillary pressure functions.
+                    double sw = 0.0;
+                    if (water) {
+                        if (isConstPc<FluidSystem, MaterialLaw, MaterialLawManager>(materialLawManager,FluidSystem::waterPhaseIdx, cell)){
+                            const double cellDepth  =  UgGridHelpers::cellCenterDepth(G,
+                                                                                cell);
+                            sw = satFromDepth<FluidSystem, MaterialLaw, MaterialLawManager>(materialLawManager,cellDepth,reg.zwoc(),waterpos,cell,false);
                             phase_saturations[waterpos][local_index] = sw;
                         }
+                        else{
+                            const double pcov = phase_pressures[oilpos][local_index] - phase_pressures[waterpos][local_index];
+                            if (swat_init.empty()) { // Invert Pc to find sw
+                                sw = satFromPc<FluidSystem, MaterialLaw, MaterialLawManager>(materialLawManager, waterpos, cell, pcov);
+                                phase_saturations[waterpos][local_index] = sw;
+                            } else { // Scale Pc to reflect imposed sw
+                                sw = swat_init[cell];
+                                sw = materialLawManager.applySwatinit(cell, pcov, sw);
+                                phase_saturations[waterpos][local_index] = sw;
+                            }
+                        }
                     }
-                }
-                double sg = 0.0;
-                if (gas) {
-                    if (isConstPc<FluidSystem, MaterialLaw, MaterialLawManager>(materialLawManager,FluidSystem::gasPhaseIdx,cell)){
-                        const double cellDepth  = UgGridHelpers::cellCenterDepth(G,
-                                                                                        cell);
-                        sg = satFromDepth<FluidSystem, MaterialLaw, MaterialLawManager>(materialLawManager,cellDepth,reg.zgoc(),gaspos,cell,true);
-                        phase_saturations[gaspos][local_index] = sg;
+                    double sg = 0.0;
+                    if (gas) {
+                        if (isConstPc<FluidSystem, MaterialLaw, MaterialLawManager>(materialLawManager,FluidSystem::gasPhaseIdx,cell)){
+                            const double cellDepth  = UgGridHelpers::cellCenterDepth(G,
+                                                                                            cell);
+                            sg = satFromDepth<FluidSystem, MaterialLaw, MaterialLawManager>(materialLawManager,cellDepth,reg.zgoc(),gaspos,cell,true);
+                            phase_saturations[gaspos][local_index] = sg;
+                        }
+                        else{
+                            // Note that pcog is defined to be (pg - po), not (po - pg).
+                            const double pcog = phase_pressures[gaspos][local_index] - phase_pressures[oilpos][local_index];
+                            const double increasing = true; // pcog(sg) expected to be increasing function
+                            sg = satFromPc<FluidSystem, MaterialLaw, MaterialLawManager>(materialLawManager, gaspos, cell, pcog, increasing);
+                            phase_saturations[gaspos][local_index] = sg;
+                        }
                     }
-                    else{
-                        // Note that pcog is defined to be (pg - po), not (po - pg).
-                        const double pcog = phase_pressures[gaspos][local_index] - phase_pressures[oilpos][local_index];
-                        const double increasing = true; // pcog(sg) expected to be increasing function
-                        sg = satFromPc<FluidSystem, MaterialLaw, MaterialLawManager>(materialLawManager, gaspos, cell, pcog, increasing);
+                    if (gas && water && (sg + sw > 1.0)) {
+                        // Overlapping gas-oil and oil-water transition
+                        // zones can lead to unphysical saturations when
+                        // treated as above. Must recalculate using gas-water
+                        // capillary pressure.
+                        const double pcgw = phase_pressures[gaspos][local_index] - phase_pressures[waterpos][local_index];
+                        if (! swat_init.empty()) { 
+                            // Re-scale Pc to reflect imposed sw for vanishing oil phase.
+                            // This seems consistent with ecl, and fails to honour 
+                            // swat_init in case of non-trivial gas-oil cap pressure.
+                            sw = materialLawManager.applySwatinit(cell, pcgw, sw);
+                        }
+                        sw = satFromSumOfPcs<FluidSystem, MaterialLaw, MaterialLawManager>(materialLawManager, waterpos, gaspos, cell, pcgw);
+                        sg = 1.0 - sw;
+                        phase_saturations[waterpos][local_index] = sw;
                         phase_saturations[gaspos][local_index] = sg;
+                        if ( water ) {
+                            fluidState.setSaturation(FluidSystem::waterPhaseIdx, sw);
+                        }
+                        else {
+                            fluidState.setSaturation(FluidSystem::waterPhaseIdx, 0.0);
+                        }
+                        fluidState.setSaturation(FluidSystem::oilPhaseIdx, 1.0 - sw - sg);
+                        fluidState.setSaturation(FluidSystem::gasPhaseIdx, sg);
+
+                        double pC[/*numPhases=*/3] = { 0.0, 0.0, 0.0 };
+                        MaterialLaw::capillaryPressures(pC, matParams, fluidState);
+                        double pcGas = pC[FluidSystem::oilPhaseIdx] + pC[FluidSystem::gasPhaseIdx];
+                        phase_pressures[oilpos][local_index] = phase_pressures[gaspos][local_index] - pcGas;
                     }
-                }
-                if (gas && water && (sg + sw > 1.0)) {
-                    // Overlapping gas-oil and oil-water transition
-                    // zones can lead to unphysical saturations when
-                    // treated as above. Must recalculate using gas-water
-                    // capillary pressure.
-                    const double pcgw = phase_pressures[gaspos][local_index] - phase_pressures[waterpos][local_index];
-                    if (! swat_init.empty()) { 
-                        // Re-scale Pc to reflect imposed sw for vanishing oil phase.
-                        // This seems consistent with ecl, and fails to honour 
-                        // swat_init in case of non-trivial gas-oil cap pressure.
-                        sw = materialLawManager.applySwatinit(cell, pcgw, sw);
+                    phase_saturations[oilpos][local_index] = 1.0 - sw - sg;
+                
+                    // Adjust phase pressures for max and min saturation ...
+                    double threshold_sat = 1.0e-6;
+
+                    double so = 1.0;
+                    double pC[FluidSystem::numPhases] = { 0.0, 0.0, 0.0 };
+                    if (water) {
+                        double swu = scaledDrainageInfo.Swu;
+                        fluidState.setSaturation(FluidSystem::waterPhaseIdx, swu);
+                        so -= swu;
                     }
-                    sw = satFromSumOfPcs<FluidSystem, MaterialLaw, MaterialLawManager>(materialLawManager, waterpos, gaspos, cell, pcgw);
-                    sg = 1.0 - sw;
-                    phase_saturations[waterpos][local_index] = sw;
-                    phase_saturations[gaspos][local_index] = sg;
-                    if ( water ) {
-                        fluidState.setSaturation(FluidSystem::waterPhaseIdx, sw);
+                    if (gas) {
+                        double sgu = scaledDrainageInfo.Sgu;
+                        fluidState.setSaturation(FluidSystem::gasPhaseIdx, sgu);
+                        so-= sgu;
                     }
-                    else {
-                        fluidState.setSaturation(FluidSystem::waterPhaseIdx, 0.0);
+                    fluidState.setSaturation(FluidSystem::oilPhaseIdx, so);
+
+                    if (water && sw > scaledDrainageInfo.Swu-threshold_sat ) {
+                        fluidState.setSaturation(FluidSystem::waterPhaseIdx, scaledDrainageInfo.Swu);
+                        MaterialLaw::capillaryPressures(pC, matParams, fluidState);
+                        double pcWat = pC[FluidSystem::oilPhaseIdx] - pC[FluidSystem::waterPhaseIdx];
+                        phase_pressures[oilpos][local_index] = phase_pressures[waterpos][local_index] + pcWat;
+                    } else if (gas && sg > scaledDrainageInfo.Sgu-threshold_sat) {
+                        fluidState.setSaturation(FluidSystem::gasPhaseIdx, scaledDrainageInfo.Sgu);
+                        MaterialLaw::capillaryPressures(pC, matParams, fluidState);
+                        double pcGas = pC[FluidSystem::oilPhaseIdx] + pC[FluidSystem::gasPhaseIdx];
+                        phase_pressures[oilpos][local_index] = phase_pressures[gaspos][local_index] - pcGas;
+                    }
+                    if (gas && sg < scaledDrainageInfo.Sgl+threshold_sat) {
+                        fluidState.setSaturation(FluidSystem::gasPhaseIdx, scaledDrainageInfo.Sgl);
+                        MaterialLaw::capillaryPressures(pC, matParams, fluidState);
+                        double pcGas = pC[FluidSystem::oilPhaseIdx] + pC[FluidSystem::gasPhaseIdx];
+                        phase_pressures[gaspos][local_index] = phase_pressures[oilpos][local_index] + pcGas;
+                    }
+                    if (water && sw < scaledDrainageInfo.Swl+threshold_sat) {
+                        fluidState.setSaturation(FluidSystem::waterPhaseIdx, scaledDrainageInfo.Swl);
+                        MaterialLaw::capillaryPressures(pC, matParams, fluidState);
+                        double pcWat = pC[FluidSystem::oilPhaseIdx] - pC[FluidSystem::waterPhaseIdx];
+                        phase_pressures[waterpos][local_index] = phase_pressures[oilpos][local_index] - pcWat;
                     }
-                    fluidState.setSaturation(FluidSystem::oilPhaseIdx, 1.0 - sw - sg);
-                    fluidState.setSaturation(FluidSystem::gasPhaseIdx, sg);
-
-                    double pC[/*numPhases=*/3] = { 0.0, 0.0, 0.0 };
-                    MaterialLaw::capillaryPressures(pC, matParams, fluidState);
-                    double pcGas = pC[FluidSystem::oilPhaseIdx] + pC[FluidSystem::gasPhaseIdx];
-                    phase_pressures[oilpos][local_index] = phase_pressures[gaspos][local_index] - pcGas;
-                }
-                phase_saturations[oilpos][local_index] = 1.0 - sw - sg;
-                
-                // Adjust phase pressures for max and min saturation ...
-                double threshold_sat = 1.0e-6;
-
-                double so = 1.0;
-                double pC[FluidSystem::numPhases] = { 0.0, 0.0, 0.0 };
-                if (water) {
-                    double swu = scaledDrainageInfo.Swu;
-                    fluidState.setSaturation(FluidSystem::waterPhaseIdx, swu);
-                    so -= swu;
-                }
-                if (gas) {
-                    double sgu = scaledDrainageInfo.Sgu;
-                    fluidState.setSaturation(FluidSystem::gasPhaseIdx, sgu);
-                    so-= sgu;
-                }
-                fluidState.setSaturation(FluidSystem::oilPhaseIdx, so);
-
-                if (water && sw > scaledDrainageInfo.Swu-threshold_sat ) {
-                    fluidState.setSaturation(FluidSystem::waterPhaseIdx, scaledDrainageInfo.Swu);
-                    MaterialLaw::capillaryPressures(pC, matParams, fluidState);
-                    double pcWat = pC[FluidSystem::oilPhaseIdx] - pC[FluidSystem::waterPhaseIdx];
-                    phase_pressures[oilpos][local_index] = phase_pressures[waterpos][local_index] + pcWat;
-                } else if (gas && sg > scaledDrainageInfo.Sgu-threshold_sat) {
-                    fluidState.setSaturation(FluidSystem::gasPhaseIdx, scaledDrainageInfo.Sgu);
-                    MaterialLaw::capillaryPressures(pC, matParams, fluidState);
-                    double pcGas = pC[FluidSystem::oilPhaseIdx] + pC[FluidSystem::gasPhaseIdx];
-                    phase_pressures[oilpos][local_index] = phase_pressures[gaspos][local_index] - pcGas;
-                }
-                if (gas && sg < scaledDrainageInfo.Sgl+threshold_sat) {
-                    fluidState.setSaturation(FluidSystem::gasPhaseIdx, scaledDrainageInfo.Sgl);
-                    MaterialLaw::capillaryPressures(pC, matParams, fluidState);
-                    double pcGas = pC[FluidSystem::oilPhaseIdx] + pC[FluidSystem::gasPhaseIdx];
-                    phase_pressures[gaspos][local_index] = phase_pressures[oilpos][local_index] + pcGas;
                 }
-                if (water && sw < scaledDrainageInfo.Swl+threshold_sat) {
-                    fluidState.setSaturation(FluidSystem::waterPhaseIdx, scaledDrainageInfo.Swl);
-                    MaterialLaw::capillaryPressures(pC, matParams, fluidState);
-                    double pcWat = pC[FluidSystem::oilPhaseIdx] - pC[FluidSystem::waterPhaseIdx];
-                    phase_pressures[waterpos][local_index] = phase_pressures[oilpos][local_index] - pcWat;
+                catch (...) {
+                    guard.capture();
                 }
             }
+            guard.rethrow();
             return phase_saturations;
         }
 
@@ -774,12 +813,23 @@ namespace Opm
                                       const std::vector<double> gas_saturation)
         {
             assert(UgGridHelpers::dimensions(grid) == 3);
-            std::vector<double> rs(cells.size());
-            int count = 0;
-            for (auto it = cells.begin(); it != cells.end(); ++it, ++count) {
-                const double depth = UgGridHelpers::cellCenterDepth(grid, *it);
-                rs[count] = rs_func(depth, oil_pressure[count], temperature[count], gas_saturation[count]);
+            const std::vector<int> cell_list(cells.begin(), cells.end());
+            const int num_cells = cell_list.size();
+            std::vector<double> rs(num_cells);
+            detail::OmpExceptionGuard guard;
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
+            for (int count = 0; count < num_cells; ++count) {
+                try {
+                    const double depth = UgGridHelpers::cellCenterDepth(grid, cell_list[count]);
+                    rs[count] = rs_func(depth, oil_pressure[count], temperature[count], gas_saturation[count]);
+                }
+                catch (...) {
+                    guard.capture();
+                }
             }
+            guard.rethrow();
             return rs;
         }
 
@@ -778,6 +778,9 @@ namespace Opm
         // the outcome. This is not guaranteed unless we have only a single phase
         // per cell.
         props.matrix(nc, &state.pressure()[0], &state.temperature()[0], &state.surfacevol()[0], &allcells[0], &allA[0], 0);
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
         for (int c = 0; c < nc; ++c) {
             // Using z = As
             double* z = &state.surfacevol()[c*np];
@@ -831,15 +834,17 @@ namespace Opm
             allcells[c] = c;
         }
 
-        std::vector<double> capPressures(number_of_cells*np);
-        props.capPress(number_of_cells,&state.saturation()[0],&allcells[0],&capPressures[0],NULL);
-
-        double z_tmp;
+        // The cells are independent in the loops below: each one only reads
+        // and writes its own entries.
 
         // Water phase
-        if(pu.phase_used[BlackoilPhases::Aqua])
+        if(pu.phase_used[BlackoilPhases::Aqua]){
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
            for (int c = 0; c <  number_of_cells ; ++c){
                for (int p = 0; p < np ; ++p){
+                   double z_tmp;
                    if (p == BlackoilPhases::Aqua)
                        z_tmp = 1;
                    else
@@ -848,12 +853,17 @@ namespace Opm
                    z_init[c*np + p] = z_tmp;
                }
            }
+        }
         props.matrix(number_of_cells, &state.pressure()[0], &state.temperature()[0], &z_init[0], &allcells[0], &allA_a[0], 0);
 
         // Liquid phase
         if(pu.phase_used[BlackoilPhases::Liquid]){
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
             for (int c = 0; c <  number_of_cells ; ++c){
                 for (int p = 0; p < np ; ++p){
+                     double z_tmp;
                      if(p == BlackoilPhases::Vapour){
                          if(state.saturation()[np*c + p] > 0)
                              z_tmp = 1e10;
@@ -873,8 +883,12 @@ namespace Opm
         props.matrix(number_of_cells, &state.pressure()[0], &state.temperature()[0], &z_init[0], &allcells[0], &allA_l[0], 0);
 
         if(pu.phase_used[BlackoilPhases::Vapour]){
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
             for (int c = 0; c <  number_of_cells ; ++c){
                 for (int p = 0; p < np ; ++p){
+                     double z_tmp;
                      if(p == BlackoilPhases::Liquid){
                          if(state.saturation()[np*c + p] > 0)
                              z_tmp = 1e10;
@@ -893,6 +907,9 @@ namespace Opm
         }
         props.matrix(number_of_cells, &state.pressure()[0], &state.temperature()[0], &z_init[0], &allcells[0], &allA_v[0], 0);
 
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
         for (int c = 0; c < number_of_cells; ++c) {
             // Using z = As
             double* z = &state.surfacevol()[c*np];
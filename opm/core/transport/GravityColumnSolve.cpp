@@ -0,0 +1,49 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/core/transport/GravityColumnSolve.hpp>
+#include <opm/grid/UnstructuredGrid.h>
+
+namespace Opm
+{
+
+    void extractColumnGravityFlux(const UnstructuredGrid& grid,
+                                  const double* gravflux,
+                                  const std::vector<int>& column,
+                                  std::vector<double>& col_gravflux)
+    {
+        const int nc = column.size();
+        col_gravflux.assign(nc > 0 ? nc - 1 : 0, 0.0);
+        for (int ci = 0; ci < nc - 1; ++ci) {
+            const int cell = column[ci];
+            const int next_cell = column[ci + 1];
+            for (int j = grid.cell_facepos[cell]; j < grid.cell_facepos[cell+1]; ++j) {
+                const int face = grid.cell_faces[j];
+                const int c1 = grid.face_cells[2*face + 0];
+                const int c2 = grid.face_cells[2*face + 1];
+                if (c1 == next_cell || c2 == next_cell) {
+                    const double gf = gravflux[face];
+                    col_gravflux[ci] = (c1 == cell) ? gf : -gf;
+                }
+            }
+        }
+    }
+
+} // namespace Opm
@@ -0,0 +1,94 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_GRAVITYCOLUMNSOLVE_HEADER_INCLUDED
+#define OPM_GRAVITYCOLUMNSOLVE_HEADER_INCLUDED
+
+#include <opm/core/utility/OmpExceptionGuard.hpp>
+
+#include <vector>
+
+struct UnstructuredGrid;
+
+namespace Opm
+{
+
+    /// Scratch space of the Gauss-Seidel column solves in the gravity
+    /// segregation of the reordering transport solvers.
+    struct GravityColumnWorkspace
+    {
+        /// Gravity flux from each cell of the column to the next one.
+        std::vector<double> gravflux;
+        /// Saturations of the column at the start of the solve.
+        std::vector<double> s0;
+        /// Polymer concentrations of the column at the start of the solve.
+        std::vector<double> c0;
+    };
+
+    /// Extract the gravity fluxes between consecutive cells of a column.
+    /// \param[in]  grid          The grid.
+    /// \param[in]  gravflux      Gravity flux per face, oriented from the first
+    ///                           to the second cell of the face.
+    /// \param[in]  column        Cells of a vertical column, connected and ordered.
+    /// \param[out] col_gravflux  Gravity flux from each cell of the column to the
+    ///                           next one, size column.size() - 1.
+    void extractColumnGravityFlux(const UnstructuredGrid& grid,
+                                  const double* gravflux,
+                                  const std::vector<int>& column,
+                                  std::vector<double>& col_gravflux);
+
+    /// Solve the gravity segregation problem of every column, concurrently
+    /// if OpenMP is available. Each thread constructs one Workspace and
+    /// reuses it for all the columns it solves.
+    ///
+    /// The columns must be disjoint and solve_column(column, workspace) may
+    /// only modify the state of the cells of its column. An exception thrown
+    /// by a column solve is rethrown once all threads are done.
+    /// \return The sum of the values returned by solve_column.
+    template <class Workspace, class SolveColumn>
+    int solveColumnsConcurrently(const std::vector<std::vector<int> >& columns,
+                                 SolveColumn&& solve_column)
+    {
+        const int num_columns = columns.size();
+        int sum = 0;
+        detail::OmpExceptionGuard guard;
+#if HAVE_OPENMP
+#pragma omp parallel reduction(+:sum)
+#endif // HAVE_OPENMP
+        {
+            Workspace workspace;
+#if HAVE_OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif // HAVE_OPENMP
+            for (int col = 0; col < num_columns; ++col) {
+                try {
+                    sum += solve_column(columns[col], workspace);
+                }
+                catch (...) {
+                    guard.capture();
+                }
+            }
+        }
+        guard.rethrow();
+        return sum;
+    }
+
+} // namespace Opm
+
+#endif // OPM_GRAVITYCOLUMNSOLVE_HEADER_INCLUDED
@@ -20,28 +20,42 @@
 #include "config.h"
 #include <opm/core/transport/reorder/ReorderSolverInterface.hpp>
 #include <opm/core/transport/reorder/reordersequence.h>
+#include <opm/core/utility/OmpExceptionGuard.hpp>
 #include <opm/grid/UnstructuredGrid.h>
 #include <opm/grid/utility/StopWatch.hpp>
 
 #include <vector>
+#include <algorithm>
+#include <numeric>
 #include <cassert>
 #include <iostream>
 
+#if HAVE_OPENMP
+#include <omp.h>
+#endif // HAVE_OPENMP
+
 
 void Opm::ReorderSolverInterface::reorderAndTransport(const UnstructuredGrid& grid, const double* darcyflux)
 {
-    // Compute reordered sequence of single-cell problems
-    sequence_.resize(grid.number_of_cells);
-    components_.resize(grid.number_of_cells + 1);
-    int ncomponents;
+    // Compute reordered sequence of single-cell problems, unless the
+    // previous one is still valid.
     time::StopWatch clock;
     clock.start();
-    compute_sequence(&grid, darcyflux, &sequence_[0], &components_[0], &ncomponents);
+    const bool reused = updateUpwindFaces(grid, darcyflux);
+    if (!reused) {
+        computeSequence(grid, darcyflux);
+    }
     clock.stop();
-    std::cout << "Topological sort took: " << clock.secsSinceStart() << " seconds." << std::endl;
+    std::cout << (reused ? "Topological sort reused, check took: " : "Topological sort took: ")
+              << clock.secsSinceStart() << " seconds." << std::endl;
+    const int ncomponents = components_.size() - 1;
 
-    // Make vector's size match actual used data.
-    components_.resize(ncomponents + 1);
+#if HAVE_OPENMP
+    if (supportsConcurrentSolves() && ncomponents > 1 && omp_get_max_threads() > 1) {
+        solveLevelScheduled(grid, darcyflux);
+        return;
+    }
+#endif // HAVE_OPENMP
 
     // Invoke appropriate solve method for each interdependent component.
     for (int comp = 0; comp < ncomponents; ++comp) {
@@ -55,13 +69,164 @@ void Opm::ReorderSolverInterface::reorderAndTransport(const UnstructuredGrid& gr
         }
 #endif
 #endif
-	const int comp_size = components_[comp + 1] - components_[comp];
-	if (comp_size == 1) {
-	    solveSingleCell(sequence_[components_[comp]]);
-	} else {
-	    solveMultiCell(comp_size, &sequence_[components_[comp]]);
-	}
+        solveComponent(comp);
+    }
+}
+
+
+void Opm::ReorderSolverInterface::computeSequence(const UnstructuredGrid& grid, const double* darcyflux)
+{
+    sequence_.resize(grid.number_of_cells);
+    components_.resize(grid.number_of_cells + 1);
+    // The graph and scratch arrays are kept, such that repeated calls
+    // do not allocate.
+    graph_ia_.resize(grid.number_of_cells + 1);
+    graph_ja_.resize(grid.number_of_faces);
+    work_.resize(reorder_work_size(&grid));
+    int ncomponents;
+    compute_sequence_graph_work(&grid, darcyflux, sequence_.data(), components_.data(), &ncomponents,
+                                graph_ia_.data(), graph_ja_.data(), work_.data());
+
+    // Make vector's size match actual used data.
+    components_.resize(ncomponents + 1);
+
+    component_of_cell_.resize(grid.number_of_cells);
+    for (int comp = 0; comp < ncomponents; ++comp) {
+        for (int i = components_[comp]; i < components_[comp + 1]; ++i) {
+            component_of_cell_[sequence_[i]] = comp;
+        }
+    }
+    num_changed_faces_ = 0;
+}
+
+
+// Update upwind_cell_ for the new fluxes. Return true if the last ordering
+// is still valid: every new upwind relation goes from an earlier or the
+// same component, and not too many faces changed since the last full
+// computation. Upwind relations that disappeared do not invalidate it.
+bool Opm::ReorderSolverInterface::updateUpwindFaces(const UnstructuredGrid& grid, const double* darcyflux)
+{
+    const int nf = grid.number_of_faces;
+    bool valid = int(upwind_cell_.size()) == nf
+        && int(component_of_cell_.size()) == grid.number_of_cells
+        && update_threshold_ > 0.0;
+    if (!valid) {
+        upwind_cell_.assign(nf, -1);
+    }
+    for (int f = 0; f < nf; ++f) {
+        const int c0 = grid.face_cells[2*f];
+        const int c1 = grid.face_cells[2*f + 1];
+        int upwind = -1;
+        if (c0 != -1 && c1 != -1) {
+            if (darcyflux[f] > 0.0) {
+                upwind = c0;
+            } else if (darcyflux[f] < 0.0) {
+                upwind = c1;
+            }
+        }
+        if (upwind == upwind_cell_[f]) {
+            continue;
+        }
+        if (valid) {
+            ++num_changed_faces_;
+            if (upwind != -1) {
+                const int downwind = upwind == c0 ? c1 : c0;
+                valid = component_of_cell_[upwind] <= component_of_cell_[downwind];
+            }
+        }
+        upwind_cell_[f] = upwind;
+    }
+    return valid && num_changed_faces_ <= update_threshold_ * nf;
+}
+
+
+void Opm::ReorderSolverInterface::setReorderUpdateThreshold(const double fraction)
+{
+    update_threshold_ = fraction;
+}
+
+
+void Opm::ReorderSolverInterface::solveComponent(const int comp)
+{
+    const int comp_size = components_[comp + 1] - components_[comp];
+    if (comp_size == 1) {
+        solveSingleCell(sequence_[components_[comp]]);
+    } else {
+        solveMultiCell(comp_size, &sequence_[components_[comp]]);
+    }
+}
+
+
+void Opm::ReorderSolverInterface::solveLevelScheduled(const UnstructuredGrid& grid, const double* darcyflux)
+{
+    const int ncomponents = components_.size() - 1;
+
+    const std::vector<int>& comp_of_cell = component_of_cell_;
+
+    // Level of each component: one more than the highest level of its
+    // upwind components. The sequence has upwind components first, so a
+    // single sweep computes all levels.
+    std::vector<int> level(ncomponents, 0);
+    int num_levels = 0;
+    for (int comp = 0; comp < ncomponents; ++comp) {
+        int comp_level = 0;
+        for (int i = components_[comp]; i < components_[comp + 1]; ++i) {
+            const int cell = sequence_[i];
+            for (int hf = grid.cell_facepos[cell]; hf < grid.cell_facepos[cell + 1]; ++hf) {
+                const int f = grid.cell_faces[hf];
+                int other;
+                double influx;
+                if (cell == grid.face_cells[2*f]) {
+                    other = grid.face_cells[2*f + 1];
+                    influx = -darcyflux[f];
+                } else {
+                    other = grid.face_cells[2*f];
+                    influx = darcyflux[f];
+                }
+                if (other != -1 && influx > 0.0 && comp_of_cell[other] != comp) {
+                    assert(comp_of_cell[other] < comp);
+                    comp_level = std::max(comp_level, level[comp_of_cell[other]] + 1);
+                }
+            }
+        }
+        level[comp] = comp_level;
+        num_levels = std::max(num_levels, comp_level + 1);
+    }
+
+    // Components sorted by level, keeping the sequence order within a level.
+    std::vector<int> level_start(num_levels + 1, 0);
+    for (int comp = 0; comp < ncomponents; ++comp) {
+        ++level_start[level[comp] + 1];
+    }
+    std::partial_sum(level_start.begin(), level_start.end(), level_start.begin());
+    std::vector<int> level_comps(ncomponents);
+    {
+        std::vector<int> pos(level_start.begin(), level_start.end() - 1);
+        for (int comp = 0; comp < ncomponents; ++comp) {
+            level_comps[pos[level[comp]]++] = comp;
+        }
+    }
+
+    // Solve the components of each level concurrently, the levels after a
+    // failure are skipped.
+    Opm::detail::OmpExceptionGuard guard;
+    for (int lev = 0; lev < num_levels && !guard.failed(); ++lev) {
+        const int begin = level_start[lev];
+        const int end = level_start[lev + 1];
+#if HAVE_OPENMP
+        // Narrow levels are not worth the fork and join.
+#pragma omp parallel for schedule(dynamic, 16) if(end - begin > 64)
+#endif // HAVE_OPENMP
+        for (int k = begin; k < end; ++k) {
+            try {
+                solveComponent(level_comps[k]);
+            }
+            catch (...) {
+                guard.capture();
+            }
+        }
     }
+    guard.rethrow();
 }
 
 
@@ -35,6 +35,14 @@ namespace Opm
     /// class.) The reorderAndTransport() method is provided as an aid
     /// to implementing solve() in subclasses, together with the
     /// sequence() and components() methods for accessing the ordering.
+    ///
+    /// Components that do not depend on each other through the upwind
+    /// graph are solved concurrently with OpenMP if the subclass
+    /// declares that this is safe by overriding supportsConcurrentSolves().
+    ///
+    /// The ordering of the previous call is reused as long as it is
+    /// still a valid ordering for the new fluxes, see
+    /// setReorderUpdateThreshold().
     class ReorderSolverInterface
     {
     public:
@@ -42,13 +50,40 @@ namespace Opm
     private:
 	virtual void solveSingleCell(const int cell) = 0;
 	virtual void solveMultiCell(const int num_cells, const int* cells) = 0;
+        /// Return true if solveSingleCell() and solveMultiCell() only
+        /// modify data of the cells they are given and only read data of
+        /// their upwind neighbours, such that independent components may
+        /// be solved at the same time. The default is false.
+        virtual bool supportsConcurrentSolves() const { return false; }
+        void solveComponent(const int comp);
+        void solveLevelScheduled(const UnstructuredGrid& grid, const double* darcyflux);
+        bool updateUpwindFaces(const UnstructuredGrid& grid, const double* darcyflux);
+        void computeSequence(const UnstructuredGrid& grid, const double* darcyflux);
     protected:
 	void reorderAndTransport(const UnstructuredGrid& grid, const double* darcyflux);
         const std::vector<int>& sequence() const;
         const std::vector<int>& components() const;
+        /// Set the fraction of the faces whose upwind direction may change
+        /// before the ordering is recomputed from scratch. Below it, the
+        /// previous ordering is kept if every new upwind relation is
+        /// consistent with it. Since components are then never split, they
+        /// may be larger than necessary, which the threshold bounds. Zero
+        /// recomputes for every call. The default is 0.05.
+        void setReorderUpdateThreshold(const double fraction);
     private:
         std::vector<int> sequence_;
         std::vector<int> components_;
+        // For each face the upwind cell of the last ordering, or -1.
+        std::vector<int> upwind_cell_;
+        // For each cell its component in the last ordering.
+        std::vector<int> component_of_cell_;
+        // The upwind graph and scratch arrays of the ordering.
+        std::vector<int> graph_ia_;
+        std::vector<int> graph_ja_;
+        std::vector<int> work_;
+        // Faces that changed direction since the last full computation.
+        int num_changed_faces_ = 0;
+        double update_threshold_ = 0.05;
     };
 
 
@@ -22,12 +22,15 @@
 #include <opm/core/transport/reorder/TransportSolverCompressibleTwophaseReorder.hpp>
 #include <opm/core/props/BlackoilPropertiesInterface.hpp>
 #include <opm/grid/UnstructuredGrid.h>
+#include <opm/core/transport/GravityColumnSolve.hpp>
 #include <opm/core/transport/reorder/reordersequence.h>
 #include <opm/common/utility/numeric/RootFinders.hpp>
 #include <opm/core/utility/miscUtilities.hpp>
 #include <opm/core/utility/miscUtilitiesBlackoil.hpp>
 #include <opm/grid/transmissibility/trans_tpfa.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <fstream>
 #include <iterator>
@@ -53,12 +56,11 @@ namespace Opm
           darcyflux_(0),
           source_(0),
           dt_(0.0),
+          local_cfl_(0.0),
           saturation_(grid.number_of_cells, -1.0),
           fractionalflow_(grid.number_of_cells, -1.0),
           gravity_(0),
           mob_(2*grid.number_of_cells, -1.0),
-          ia_upw_(grid.number_of_cells + 1, -1),
-          ja_upw_(grid.number_of_faces, -1),
           ia_downw_(grid.number_of_cells + 1, -1),
           ja_downw_(grid.number_of_faces, -1)
     {
@@ -78,6 +80,11 @@ namespace Opm
         props.satRange(props.numCells(), &allcells_[0], &smin_[0], &smax_[0]);
     }
 
+    void TransportSolverCompressibleTwophaseReorder::setLocalCfl(const double cfl)
+    {
+        local_cfl_ = cfl;
+    }
+
     void TransportSolverCompressibleTwophaseReorder::solve(const double* darcyflux,
                                                    const double* pressure,
                                                    const double* temperature,
@@ -104,18 +111,8 @@ namespace Opm
             OPM_THROW(std::runtime_error, "TransportModelCompressibleTwophase requires a property object without miscibility.");
         }
 
-        std::vector<int> seq(grid_.number_of_cells);
-        std::vector<int> comp(grid_.number_of_cells + 1);
-        int ncomp;
-        compute_sequence_graph(&grid_, darcyflux_,
-                               &seq[0], &comp[0], &ncomp,
-                               &ia_upw_[0], &ja_upw_[0]);
-        const int nf = grid_.number_of_faces;
-        std::vector<double> neg_darcyflux(nf);
-        std::transform(darcyflux, darcyflux + nf, neg_darcyflux.begin(), std::negate<double>());
-        compute_sequence_graph(&grid_, &neg_darcyflux[0],
-                               &seq[0], &comp[0], &ncomp,
-                               &ia_downw_[0], &ja_downw_[0]);
+        // The downwind neighbours guide the iterations of solveMultiCell().
+        compute_downwind_graph(&grid_, darcyflux_, ia_downw_.data(), ja_downw_.data());
         reorderAndTransport(grid_, darcyflux);
         toBothSat(saturation_, saturation);
 
@@ -129,6 +126,10 @@ namespace Opm
     //
     //     r(s) = s - B*z0 + s*(poro - poro0)/poro0 + dt/pv*( influx + outflux*f(s) )
     //
+    // For a local substep, B*z0 is replaced by the start saturation times the
+    // relative pore volume at the start of the substep, and the pore volume
+    // change and dt by their parts up to the end of the substep.
+    //
     // @@@ What about the source term
     //
     // where influx is water influx, outflux is total outflux.
@@ -145,6 +146,7 @@ namespace Opm
         // @@@ TODO: figure out change to rock-comp. terms with fluid compr.
         double comp_term; // Now: used to be: q - sum_j v_ij
         double dtpv;    // dt/pv(i)
+        double start;     // B_i*z0, or the start of a local substep
         const TransportSolverCompressibleTwophaseReorder& tm;
         explicit Residual(const TransportSolverCompressibleTwophaseReorder& tmodel, int cell_index)
             : tm(tmodel)
@@ -159,6 +161,7 @@ namespace Opm
             outflux = !src_is_inflow ? src_flux : 0.0;
             comp_term = (tm.porevolume_[cell] - tm.porevolume0_[cell])/tm.porevolume0_[cell];
             dtpv    = tm.dt_/tm.porevolume0_[cell];
+            start   = B_cell*z0;
             for (int i = tm.grid_.cell_facepos[cell]; i < tm.grid_.cell_facepos[cell+1]; ++i) {
                 const int f = tm.grid_.cell_faces[i];
                 double flux;
@@ -185,17 +188,60 @@ namespace Opm
         double operator()(double s) const
         {
             // return s - s0 + dtpv*(outflux*tm.fracFlow(s, cell) + influx + s*comp_term);
-            return s - B_cell*z0 + dtpv*(outflux*tm.fracFlow(s, cell) + influx) + s*comp_term;
+            return s - start + dtpv*(outflux*tm.fracFlow(s, cell) + influx) + s*comp_term;
         }
     };
 
 
     void TransportSolverCompressibleTwophaseReorder::solveSingleCell(const int cell)
+    {
+        solveCell(cell, true);
+    }
+
+
+
+    // Solve a cell, in local substeps if allowed and the throughput of the
+    // cell exceeds the local CFL number. The fractional flow seen by the
+    // downwind cells is then the average over the substeps, so that they
+    // receive the water that left the cell during the step.
+    void TransportSolverCompressibleTwophaseReorder::solveCell(const int cell, const bool allow_substeps)
     {
         Residual res(*this, cell);
         int iters_used;
-        saturation_[cell] = RootFinder::solve(res, saturation_[cell], 0.0, 1.0, maxit_, tol_, iters_used);
-        fractionalflow_[cell] = fracFlow(saturation_[cell], cell);
+        int num_substeps = 1;
+        if (allow_substeps && local_cfl_ > 0.0) {
+            const int max_substeps = 100;
+            const double cfl = res.dtpv*res.outflux;
+            num_substeps = std::min(max_substeps, std::max(1, int(std::ceil(cfl/local_cfl_))));
+        }
+        if (num_substeps == 1) {
+            saturation_[cell] = RootFinder::solve(res, saturation_[cell], 0.0, 1.0, maxit_, tol_, iters_used);
+            fractionalflow_[cell] = fracFlow(saturation_[cell], cell);
+            return;
+        }
+        const double pv_change = res.comp_term;
+        const double dtpv = res.dtpv/num_substeps;
+        double s = saturation_[cell];
+        double fsum = 0.0;
+        for (int step = 0; step < num_substeps; ++step) {
+            if (step > 0) {
+                res.start = s*(1.0 + pv_change*step/num_substeps);
+            }
+            res.comp_term = pv_change*(step + 1)/num_substeps;
+            res.dtpv = dtpv;
+            s = RootFinder::solve(res, s, 0.0, 1.0, maxit_, tol_, iters_used);
+            fsum += fracFlow(s, cell);
+        }
+        saturation_[cell] = s;
+        fractionalflow_[cell] = fsum/num_substeps;
+    }
+
+
+
+    bool TransportSolverCompressibleTwophaseReorder::supportsConcurrentSolves() const
+    {
+        // Only the cell itself is updated, from its upwind neighbours.
+        return true;
     }
 
 
@@ -268,10 +314,10 @@ namespace Opm
                 ++update_count;
                 const int cell = cells[i];
                 const double old_s = saturation_[cell];
-                // solveSingleCell() requires saturation_[cell]
+                // solveCell() requires saturation_[cell]
                 // to be s0.
                 saturation_[cell] = s0[i];
-                solveSingleCell(cell);
+                solveCell(cell, false);
                 const double s_change = std::fabs(saturation_[cell] - old_s);
                 if (s_change > tol) {
                     // Mark downwind cells.
@@ -454,29 +500,17 @@ namespace Opm
 
 
 
-    int TransportSolverCompressibleTwophaseReorder::solveGravityColumn(const std::vector<int>& cells)
+    int TransportSolverCompressibleTwophaseReorder::solveGravityColumn(const std::vector<int>& cells,
+                                                                       GravityColumnWorkspace& workspace)
     {
         // Set up column gravflux.
         const int nc = cells.size();
-        std::vector<double> col_gravflux(nc - 1);
-        for (int ci = 0; ci < nc - 1; ++ci) {
-            const int cell = cells[ci];
-            const int next_cell = cells[ci + 1];
-            for (int j = grid_.cell_facepos[cell]; j < grid_.cell_facepos[cell+1]; ++j) {
-                const int face = grid_.cell_faces[j];
-                const int c1 = grid_.face_cells[2*face + 0];
-                const int c2 = grid_.face_cells[2*face + 1];
-                if (c1 == next_cell || c2 == next_cell) {
-                    const double gf = gravflux_[face];
-                    col_gravflux[ci] = (c1 == cell) ? gf : -gf;
-                }
-            }
-        }
+        extractColumnGravityFlux(grid_, gravflux_.data(), cells, workspace.gravflux);
 
         // Store initial saturation s0
-        s0_.resize(nc);
+        workspace.s0.resize(nc);
         for (int ci = 0; ci < nc; ++ci) {
-            s0_[ci] = saturation_[cells[ci]];
+            workspace.s0[ci] = saturation_[cells[ci]];
         }
 
         // Solve single cell problems, repeating if necessary.
@@ -488,10 +522,10 @@ namespace Opm
                 const int ci2 = nc - ci - 1;
                 double old_s[2] = { saturation_[cells[ci]],
                                     saturation_[cells[ci2]] };
-                saturation_[cells[ci]] = s0_[ci];
-                solveSingleCellGravity(cells, ci, &col_gravflux[0]);
-                saturation_[cells[ci2]] = s0_[ci2];
-                solveSingleCellGravity(cells, ci2, &col_gravflux[0]);
+                saturation_[cells[ci]] = workspace.s0[ci];
+                solveSingleCellGravity(cells, ci, workspace.gravflux.data());
+                saturation_[cells[ci2]] = workspace.s0[ci2];
+                solveSingleCellGravity(cells, ci2, workspace.gravflux.data());
                 max_s_change = std::max(max_s_change, std::max(std::fabs(saturation_[cells[ci]] - old_s[0]),
                                                                std::fabs(saturation_[cells[ci2]] - old_s[1])));
             }
@@ -541,12 +575,12 @@ namespace Opm
         dt_ = dt;
         toWaterSat(saturation, saturation_);
 
-        // Solve on all columns.
-        int num_iters = 0;
-        for (std::vector<std::vector<int> >::size_type i = 0; i < columns.size(); i++) {
-            // std::cout << "==== new column" << std::endl;
-            num_iters += solveGravityColumn(columns[i]);
-        }
+        // Solve on all columns. They are independent, so they are solved
+        // concurrently, each thread with its own workspace.
+        const int num_iters = solveColumnsConcurrently<GravityColumnWorkspace>(columns,
+            [this](const std::vector<int>& column, GravityColumnWorkspace& workspace) {
+                return solveGravityColumn(column, workspace);
+            });
         std::cout << "Gauss-Seidel column solver average iterations: "
                   << double(num_iters)/double(columns.size()) << std::endl;
         toBothSat(saturation_, saturation);
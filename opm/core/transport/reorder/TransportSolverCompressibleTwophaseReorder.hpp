@@ -28,6 +28,7 @@ struct UnstructuredGrid;
 namespace Opm
 {
 
+    struct GravityColumnWorkspace;
     class BlackoilPropertiesInterface;
 
     /// Implements a reordering transport solver for compressible,
@@ -45,6 +46,14 @@ namespace Opm
                                            const double tol,
                                            const int maxit);
 
+        /// Set the local CFL number for local timestepping. Cells that are
+        /// not part of a cycle of the upwind graph and whose outflux during
+        /// the step exceeds this many pore volumes are solved in local
+        /// substeps. Since the cells are solved in upwind order, only the
+        /// high-flux cells pay for the substeps. Zero, the default, turns
+        /// local timestepping off.
+        void setLocalCfl(const double cfl);
+
         /// Solve for saturation at next timestep.
         /// \param[in] darcyflux         Array of signed face fluxes.
         /// \param[in] pressure          Array of cell pressures
@@ -86,11 +95,14 @@ namespace Opm
 
     private:
         virtual void solveSingleCell(const int cell);
+        void solveCell(const int cell, const bool allow_substeps);
         virtual void solveMultiCell(const int num_cells, const int* cells);
+        virtual bool supportsConcurrentSolves() const;
         void solveSingleCellGravity(const std::vector<int>& cells,
                                     const int pos,
                                     const double* gravflux);
-        int solveGravityColumn(const std::vector<int>& cells);
+        int solveGravityColumn(const std::vector<int>& cells,
+                               GravityColumnWorkspace& workspace);
         void initGravityDynamic();
 
     private:
@@ -110,6 +122,7 @@ namespace Opm
         const double* porevolume_;  // one volume per cell
         const double* source_;      // one source per cell
         double dt_;
+        double local_cfl_;
         std::vector<double> saturation_;        // P (= num. phases) per cell
         std::vector<double> fractionalflow_;  // = m[0]/(m[0] + m[1]) per cell
         // For gravity segregation.
@@ -118,11 +131,8 @@ namespace Opm
         std::vector<double> density_;
         std::vector<double> gravflux_;
         std::vector<double> mob_;
-        std::vector<double> s0_;
 
-        // Storing the upwind and downwind graphs for experiments.
-        std::vector<int> ia_upw_;
-        std::vector<int> ja_upw_;
+        // The downwind graph of the current fluxes.
         std::vector<int> ia_downw_;
         std::vector<int> ja_downw_;
 
@@ -21,12 +21,14 @@
 #include <opm/core/transport/reorder/TransportSolverTwophaseReorder.hpp>
 #include <opm/core/props/IncompPropertiesInterface.hpp>
 #include <opm/grid/UnstructuredGrid.h>
+#include <opm/core/transport/GravityColumnSolve.hpp>
 #include <opm/core/transport/reorder/reordersequence.h>
 #include <opm/grid/ColumnExtract.hpp>
 #include <opm/common/utility/numeric/RootFinders.hpp>
 #include <opm/core/utility/miscUtilities.hpp>
 #include <opm/grid/transmissibility/trans_tpfa.h>
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <iterator>
@@ -60,9 +62,7 @@ namespace Opm
           reorder_iterations_(grid.number_of_cells, 0),
           mob_(2*grid.number_of_cells, -1.0)
 #ifdef EXPERIMENT_GAUSS_SEIDEL
-        , ia_upw_(grid.number_of_cells + 1, -1),
-          ja_upw_(grid.number_of_faces, -1),
-          ia_downw_(grid.number_of_cells + 1, -1),
+        , ia_downw_(grid.number_of_cells + 1, -1),
           ja_downw_(grid.number_of_faces, -1)
 #endif
     {
@@ -102,18 +102,8 @@ namespace Opm
         toWaterSat(state.saturation(), saturation_);
 
 #ifdef EXPERIMENT_GAUSS_SEIDEL
-        std::vector<int> seq(grid_.number_of_cells);
-        std::vector<int> comp(grid_.number_of_cells + 1);
-        int ncomp;
-        compute_sequence_graph(&grid_, darcyflux_,
-                               &seq[0], &comp[0], &ncomp,
-                               &ia_upw_[0], &ja_upw_[0]);
-        const int nf = grid_.number_of_faces;
-        std::vector<double> neg_darcyflux(nf);
-        std::transform(darcyflux_, darcyflux_ + nf, neg_darcyflux.begin(), std::negate<double>());
-        compute_sequence_graph(&grid_, &neg_darcyflux[0],
-                               &seq[0], &comp[0], &ncomp,
-                               &ia_downw_[0], &ja_downw_[0]);
+        // The downwind neighbours guide the iterations of solveMultiCell().
+        compute_downwind_graph(&grid_, darcyflux_, ia_downw_.data(), ja_downw_.data());
 #endif
         std::fill(reorder_iterations_.begin(),reorder_iterations_.end(),0);
         reorderAndTransport(grid_, darcyflux_);
@@ -240,6 +230,14 @@ namespace Opm
     // } // anon namespace
 
 
+
+    bool TransportSolverTwophaseReorder::supportsConcurrentSolves() const
+    {
+        // Only the cell itself is updated, from its upwind neighbours.
+        return true;
+    }
+
+
     void TransportSolverTwophaseReorder::solveMultiCell(const int num_cells, const int* cells)
     {
         // std::ofstream os("dump");
@@ -586,29 +584,17 @@ namespace Opm
 
 
 
-    int TransportSolverTwophaseReorder::solveGravityColumn(const std::vector<int>& cells)
+    int TransportSolverTwophaseReorder::solveGravityColumn(const std::vector<int>& cells,
+                                                           GravityColumnWorkspace& workspace)
     {
         // Set up column gravflux.
         const int nc = cells.size();
-        std::vector<double> col_gravflux(nc - 1);
-        for (int ci = 0; ci < nc - 1; ++ci) {
-            const int cell = cells[ci];
-            const int next_cell = cells[ci + 1];
-            for (int j = grid_.cell_facepos[cell]; j < grid_.cell_facepos[cell+1]; ++j) {
-                const int face = grid_.cell_faces[j];
-                const int c1 = grid_.face_cells[2*face + 0];
-                const int c2 = grid_.face_cells[2*face + 1];
-                if (c1 == next_cell || c2 == next_cell) {
-                    const double gf = gravflux_[face];
-                    col_gravflux[ci] = (c1 == cell) ? gf : -gf;
-                }
-            }
-        }
+        extractColumnGravityFlux(grid_, gravflux_.data(), cells, workspace.gravflux);
 
         // Store initial saturation s0
-        s0_.resize(nc);
+        workspace.s0.resize(nc);
         for (int ci = 0; ci < nc; ++ci) {
-            s0_[ci] = saturation_[cells[ci]];
+            workspace.s0[ci] = saturation_[cells[ci]];
         }
 
         // Solve single cell problems, repeating if necessary.
@@ -620,10 +606,10 @@ namespace Opm
                 const int ci2 = nc - ci - 1;
                 double old_s[2] = { saturation_[cells[ci]],
                                     saturation_[cells[ci2]] };
-                saturation_[cells[ci]] = s0_[ci];
-                solveSingleCellGravity(cells, ci, &col_gravflux[0]);
-                saturation_[cells[ci2]] = s0_[ci2];
-                solveSingleCellGravity(cells, ci2, &col_gravflux[0]);
+                saturation_[cells[ci]] = workspace.s0[ci];
+                solveSingleCellGravity(cells, ci, workspace.gravflux.data());
+                saturation_[cells[ci2]] = workspace.s0[ci2];
+                solveSingleCellGravity(cells, ci2, workspace.gravflux.data());
                 max_s_change = std::max(max_s_change, std::max(std::fabs(saturation_[cells[ci]] - old_s[0]),
                                                                std::fabs(saturation_[cells[ci2]] - old_s[1])));
             }
@@ -662,12 +648,12 @@ namespace Opm
         dt_ = dt;
         toWaterSat(state.saturation(), saturation_);
 
-        // Solve on all columns.
-        int num_iters = 0;
-        for (std::vector<std::vector<int> >::size_type i = 0; i < columns_.size(); i++) {
-            // std::cout << "==== new column" << std::endl;
-            num_iters += solveGravityColumn(columns_[i]);
-        }
+        // Solve on all columns. They are independent, so they are solved
+        // concurrently, each thread with its own workspace.
+        const int num_iters = solveColumnsConcurrently<GravityColumnWorkspace>(columns_,
+            [this](const std::vector<int>& column, GravityColumnWorkspace& workspace) {
+                return solveGravityColumn(column, workspace);
+            });
         std::cout << "Gauss-Seidel column solver average iterations: "
                   << double(num_iters)/double(columns_.size()) << std::endl;
 
@@ -30,6 +30,7 @@ struct UnstructuredGrid;
 namespace Opm
 {
 
+    struct GravityColumnWorkspace;
     class IncompPropertiesInterface;
 
     /// Implements a reordering transport solver for incompressible two-phase flow.
@@ -85,11 +86,13 @@ namespace Opm
         void initColumns();
         virtual void solveSingleCell(const int cell);
         virtual void solveMultiCell(const int num_cells, const int* cells);
+        virtual bool supportsConcurrentSolves() const;
 
         void solveSingleCellGravity(const std::vector<int>& cells,
                                     const int pos,
                                     const double* gravflux);
-        int solveGravityColumn(const std::vector<int>& cells);
+        int solveGravityColumn(const std::vector<int>& cells,
+                               GravityColumnWorkspace& workspace);
     private:
         const UnstructuredGrid& grid_;
         const IncompPropertiesInterface& props_;
@@ -110,12 +113,9 @@ namespace Opm
         // For gravity segregation.
         std::vector<double> gravflux_;
         std::vector<double> mob_;
-        std::vector<double> s0_;
         std::vector<std::vector<int> > columns_;
 
-        // Storing the upwind and downwind graphs for experiments.
-        std::vector<int> ia_upw_;
-        std::vector<int> ja_upw_;
+        // The downwind graph of the current fluxes.
         std::vector<int> ia_downw_;
         std::vector<int> ja_downw_;
 
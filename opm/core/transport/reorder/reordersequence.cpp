@@ -130,21 +130,13 @@ compute_sequence(const struct UnstructuredGrid* grid       ,
 {
     const std::size_t nc = grid->number_of_cells;
     const std::size_t nf = grid->number_of_faces;
-    const std::size_t sz = std::max(nf, 3 * nc);
 
-    std::vector<int> work(sz);
+    std::vector<int> work(reorder_work_size(grid));
     std::vector<int> ia  (nc + 1);
     std::vector<int> ja  (nf);  // A bit too much.
 
-    compute_reorder_sequence_graph(grid->number_of_cells,
-                                   grid->cell_faces,
-                                   grid->cell_facepos,
-                                   grid->face_cells,
-                                   flux,
-                                   sequence,
-                                   components,
-                                   ncomponents,
-                                   & ia[0], & ja[0], & work[0]);
+    compute_sequence_graph_work(grid, flux, sequence, components,
+                                ncomponents, & ia[0], & ja[0], & work[0]);
 }
 
 
@@ -159,12 +151,35 @@ compute_sequence_graph(const struct UnstructuredGrid* grid       ,
                        int*                           ja         )
 // ---------------------------------------------------------------------
 {
-    const std::size_t nc = grid->number_of_cells;
-    const std::size_t nf = grid->number_of_faces;
-    const std::size_t sz = std::max(nf, 3 * nc);
+    std::vector<int> work(reorder_work_size(grid));
+
+    compute_sequence_graph_work(grid, flux, sequence, components,
+                                ncomponents, ia, ja, & work[0]);
+}
 
-    std::vector<int> work(sz);
 
+// ---------------------------------------------------------------------
+int
+reorder_work_size(const struct UnstructuredGrid* grid)
+// ---------------------------------------------------------------------
+{
+    /* make_upwind_graph() needs one per face, tarjan() three per cell. */
+    return std::max(grid->number_of_faces, 3 * grid->number_of_cells);
+}
+
+
+// ---------------------------------------------------------------------
+void
+compute_sequence_graph_work(const struct UnstructuredGrid* grid       ,
+                            const double*                  flux       ,
+                            int*                           sequence   ,
+                            int*                           components ,
+                            int*                           ncomponents,
+                            int*                           ia         ,
+                            int*                           ja         ,
+                            int*                           work       )
+// ---------------------------------------------------------------------
+{
     compute_reorder_sequence_graph(grid->number_of_cells,
                                    grid->cell_faces,
                                    grid->cell_facepos,
@@ -173,7 +188,51 @@ compute_sequence_graph(const struct UnstructuredGrid* grid       ,
                                    sequence,
                                    components,
                                    ncomponents,
-                                   ia, ja, & work[0]);
+                                   ia, ja, work);
+}
+
+
+// ---------------------------------------------------------------------
+void
+compute_downwind_graph(const struct UnstructuredGrid* grid,
+                       const double*                  flux,
+                       int*                           ia  ,
+                       int*                           ja  )
+// ---------------------------------------------------------------------
+{
+    const int nc = grid->number_of_cells;
+    const int nf = grid->number_of_faces;
+    const int* face2cell = grid->face_cells;
+
+    /* Count the downwind cells of each cell in ia[c + 1]. */
+    std::fill(ia, ia + nc + 1, 0);
+    for (int f = 0; f < nf; ++f) {
+        const int c0 = face2cell[2*f + 0];
+        const int c1 = face2cell[2*f + 1];
+        if (c0 != -1 && c1 != -1 && flux[f] != 0.0) {
+            ++ia[(flux[f] > 0.0 ? c0 : c1) + 1];
+        }
+    }
+    for (int c = 0; c < nc; ++c) {
+        ia[c + 1] += ia[c];
+    }
+
+    /* Fill ja, using ia[c] as insertion point and shifting it back. */
+    for (int f = 0; f < nf; ++f) {
+        const int c0 = face2cell[2*f + 0];
+        const int c1 = face2cell[2*f + 1];
+        if (c0 != -1 && c1 != -1 && flux[f] != 0.0) {
+            if (flux[f] > 0.0) {
+                ja[ia[c0]++] = c1;
+            } else {
+                ja[ia[c1]++] = c0;
+            }
+        }
+    }
+    for (int c = nc; c > 0; --c) {
+        ia[c] = ia[c - 1];
+    }
+    ia[0] = 0;
 }
 
 
@@ -138,6 +138,59 @@ compute_sequence_graph(const struct UnstructuredGrid *grid       ,
                        int                           *ia         ,
                        int                           *ja         );
 
+
+/**
+ * Number of integers of the scratch array of
+ * compute_sequence_graph_work().
+ *
+ * \param[in] grid Grid structure.
+ */
+int
+reorder_work_size(const struct UnstructuredGrid *grid);
+
+
+/**
+ * Compute causal permutation sequence and upwind graph as
+ * compute_sequence_graph(), using a caller-provided scratch array,
+ * such that repeated calls need not allocate.
+ *
+ * \param[out] work Scratch array of
+ *                  <CODE>reorder_work_size(grid)</CODE> integers.
+ */
+void
+compute_sequence_graph_work(const struct UnstructuredGrid *grid       ,
+                            const double                  *flux       ,
+                            int                           *sequence   ,
+                            int                           *components ,
+                            int                           *ncomponents,
+                            int                           *ia         ,
+                            int                           *ja         ,
+                            int                           *work       );
+
+
+/**
+ * Compute the downwind graph of a Darcy flux field, i.e., for each
+ * cell the neighbouring cells that it flows into.  Unlike
+ * compute_sequence_graph() with the negated flux, this does not
+ * compute an ordering and is a single pass over the faces.
+ *
+ * \param[in] grid Grid structure.
+ *
+ * \param[in] flux Darcy flux field, as for compute_sequence().
+ *
+ * \param[out] ia  Indirection pointers into <CODE>ja</CODE>.  Array
+ *                 of size <CODE>grid->number_of_cells + 1</CODE>.
+ *
+ * \param[out] ja  The downwind cells of cell \f$i\f$ are
+ *                 <CODE>ja[ia[i] .. ia[i+1]-1]</CODE>.  Array of
+ *                 size <CODE>grid->number_of_faces</CODE>.
+ */
+void
+compute_downwind_graph(const struct UnstructuredGrid *grid,
+                       const double                  *flux,
+                       int                           *ia  ,
+                       int                           *ja  );
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
@@ -0,0 +1,84 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_OMPEXCEPTIONGUARD_HEADER_INCLUDED
+#define OPM_OMPEXCEPTIONGUARD_HEADER_INCLUDED
+
+#include <exception>
+
+namespace Opm
+{
+namespace detail
+{
+
+    /// \brief Carries the first exception thrown in an OpenMP parallel region
+    ///        out of it.
+    ///
+    /// An exception must not leave a parallel region, so the body of a
+    /// parallel loop catches everything and stores it in the guard, which
+    /// rethrows the first one once the loop is done:
+    ///
+    ///     detail::OmpExceptionGuard guard;
+    ///     #pragma omp parallel for
+    ///     for (int i = 0; i < n; ++i) {
+    ///         try {
+    ///             f(i);
+    ///         }
+    ///         catch (...) {
+    ///             guard.capture();
+    ///         }
+    ///     }
+    ///     guard.rethrow();
+    class OmpExceptionGuard
+    {
+    public:
+        /// \brief Store the exception being handled, unless an earlier one
+        ///        is stored. Only to be called in a catch block.
+        void capture() noexcept
+        {
+#if HAVE_OPENMP
+#pragma omp critical(OmpExceptionGuard_capture)
+#endif // HAVE_OPENMP
+            if (!failure_) {
+                failure_ = std::current_exception();
+            }
+        }
+
+        /// \brief Whether an exception is stored.
+        bool failed() const
+        {
+            return static_cast<bool>(failure_);
+        }
+
+        /// \brief Rethrow the stored exception, if any.
+        void rethrow() const
+        {
+            if (failure_) {
+                std::rethrow_exception(failure_);
+            }
+        }
+
+    private:
+        std::exception_ptr failure_;
+    };
+
+} // namespace detail
+} // namespace Opm
+
+#endif // OPM_OMPEXCEPTIONGUARD_HEADER_INCLUDED
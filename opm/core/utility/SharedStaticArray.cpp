@@ -0,0 +1,177 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/core/utility/SharedStaticArray.hpp>
+#include <opm/common/ErrorMacros.hpp>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Opm
+{
+
+    namespace
+    {
+        const std::uint64_t cacheFileMagic = 0x4f504d5348415232ull; // "OPMSHAR2"
+
+        // The header is padded to keep the data aligned for any element type.
+        struct CacheFileHeader
+        {
+            std::uint64_t magic;
+            std::uint64_t tag;
+            std::uint64_t key;
+            std::uint64_t size;
+            std::uint64_t padding[4];
+        };
+
+        void writeAll(int fd, const char* buffer, std::size_t size, const std::string& path)
+        {
+            while (size > 0) {
+                const ssize_t written = ::write(fd, buffer, size);
+                if (written < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    OPM_THROW(std::runtime_error, "Could not write the cache file " << path
+                              << ": " << std::strerror(errno));
+                }
+                buffer += written;
+                size -= written;
+            }
+        }
+    } // anonymous namespace
+
+
+
+    MappedCacheFile::MappedCacheFile(const std::string& path, std::uint64_t tag, std::uint64_t key,
+                                     std::size_t size, const std::function<void(void*)>& fill)
+        : map_(MAP_FAILED),
+          map_size_(0),
+          size_(size),
+          created_(false)
+    {
+        if (mapExisting(path, tag, key)) {
+            return;
+        }
+
+        // Write the data to a private file and move it into place, so that
+        // a file at path is always complete.
+        std::vector<char> buffer(sizeof(CacheFileHeader) + size, 0);
+        CacheFileHeader header = { cacheFileMagic, tag, key, size, { 0, 0, 0, 0 } };
+        std::memcpy(buffer.data(), &header, sizeof(header));
+        fill(buffer.data() + sizeof(header));
+
+        const std::string tmp_path = path + ".tmp." + std::to_string(::getpid());
+        const int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            OPM_THROW(std::runtime_error, "Could not create the cache file " << tmp_path
+                      << ": " << std::strerror(errno));
+        }
+        try {
+            writeAll(fd, buffer.data(), buffer.size(), tmp_path);
+        }
+        catch (...) {
+            ::close(fd);
+            std::remove(tmp_path.c_str());
+            throw;
+        }
+        ::close(fd);
+        if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+            std::remove(tmp_path.c_str());
+            OPM_THROW(std::runtime_error, "Could not move the cache file to " << path
+                      << ": " << std::strerror(errno));
+        }
+        created_ = true;
+
+        if (!mapExisting(path, tag, key)) {
+            OPM_THROW(std::runtime_error, "Could not map the cache file " << path);
+        }
+    }
+
+
+
+    MappedCacheFile::~MappedCacheFile()
+    {
+        if (map_ != MAP_FAILED) {
+            ::munmap(map_, map_size_);
+        }
+    }
+
+
+
+    const void* MappedCacheFile::data() const
+    {
+        return static_cast<const char*>(map_) + sizeof(CacheFileHeader);
+    }
+
+
+
+    std::uint64_t MappedCacheFile::checksum(const void* data, std::size_t size, std::uint64_t seed)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        std::uint64_t hash = seed;
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+
+
+    bool MappedCacheFile::mapExisting(const std::string& path, std::uint64_t tag, std::uint64_t key)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat status;
+        const std::size_t file_size = sizeof(CacheFileHeader) + size_;
+        if (::fstat(fd, &status) != 0 || std::size_t(status.st_size) != file_size) {
+            ::close(fd);
+            return false;
+        }
+        void* map = ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+        // The mapping stays valid after the descriptor is closed.
+        ::close(fd);
+        if (map == MAP_FAILED) {
+            return false;
+        }
+        CacheFileHeader header;
+        std::memcpy(&header, map, sizeof(header));
+        if (header.magic != cacheFileMagic || header.tag != tag || header.key != key
+            || header.size != size_) {
+            ::munmap(map, file_size);
+            return false;
+        }
+        map_ = map;
+        map_size_ = file_size;
+        return true;
+    }
+
+} // namespace Opm
@@ -0,0 +1,133 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_SHAREDSTATICARRAY_HEADER_INCLUDED
+#define OPM_SHAREDSTATICARRAY_HEADER_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+
+namespace Opm
+{
+
+    /// A read-only file mapped into memory.
+    ///
+    /// The file is mapped shared, so all the processes on a node that map
+    /// the same file use the same physical pages of the page cache.
+    class MappedCacheFile
+    {
+    public:
+        /// Map the file at path that holds size bytes of data of the given
+        /// tag and key. If the file does not exist, or its header does not
+        /// match, the data is written by fill into a private file that then
+        /// replaces the file at path atomically. Processes that race to
+        /// create it therefore all see complete data.
+        /// \param[in] path  Path of the cache file.
+        /// \param[in] tag   Identifies the kind of data, e.g. its element type.
+        /// \param[in] key   Identifies the inputs the data is computed from,
+        ///                  e.g. a checksum() of them.
+        /// \param[in] size  Number of bytes of data.
+        /// \param[in] fill  Writes size bytes of data to its argument.
+        MappedCacheFile(const std::string& path, std::uint64_t tag, std::uint64_t key,
+                        std::size_t size, const std::function<void(void*)>& fill);
+
+        ~MappedCacheFile();
+
+        MappedCacheFile(const MappedCacheFile&) = delete;
+        MappedCacheFile& operator=(const MappedCacheFile&) = delete;
+
+        /// The data of the file.
+        const void* data() const;
+
+        /// Number of bytes of data.
+        std::size_t size() const { return size_; }
+
+        /// Whether this process created the file.
+        bool created() const { return created_; }
+
+        /// The 64 bit FNV-1a checksum of size bytes, continuing the
+        /// checksum seed, such that keys can be built from several inputs.
+        static std::uint64_t checksum(const void* data, std::size_t size,
+                                      std::uint64_t seed = 0xcbf29ce484222325ull);
+
+        /// The checksum of a string.
+        static std::uint64_t checksum(const std::string& text,
+                                      std::uint64_t seed = 0xcbf29ce484222325ull)
+        { return checksum(text.data(), text.size(), seed); }
+
+    private:
+        bool mapExisting(const std::string& path, std::uint64_t tag, std::uint64_t key);
+
+        void* map_;
+        std::size_t map_size_;
+        std::size_t size_;
+        bool created_;
+    };
+
+
+
+    /// A static, read-only array that is computed once per node and shared
+    /// by all the processes that use the same cache file, for instance the
+    /// members of an ensemble of the same model.
+    ///
+    /// Only arrays of trivially copyable types, in the byte order and
+    /// layout of the machine, can be shared. The file is tagged with the
+    /// element type, and the caller passes a key that identifies the inputs
+    /// of the data, e.g. a checksum of the deck and the partition of the
+    /// grid, such that a stale file is computed again.
+    template <class T>
+    class SharedStaticArray
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "Shared arrays must have trivially copyable elements.");
+    public:
+        /// Map the array of size elements at path, computing it with
+        /// compute(T* values) if the cache file does not exist yet or
+        /// holds the array of another key.
+        template <class Compute>
+        SharedStaticArray(const std::string& path, std::uint64_t key, std::size_t size,
+                          Compute&& compute)
+            : file_(path, MappedCacheFile::checksum(std::string(typeid(T).name())), key,
+                    size * sizeof(T),
+                    [&compute](void* values) { compute(static_cast<T*>(values)); }),
+              size_(size)
+        {
+        }
+
+        const T* data() const { return static_cast<const T*>(file_.data()); }
+        const T* begin() const { return data(); }
+        const T* end() const { return data() + size_; }
+        std::size_t size() const { return size_; }
+        const T& operator[](std::size_t i) const { return data()[i]; }
+
+        /// Whether this process computed the array.
+        bool created() const { return file_.created(); }
+
+    private:
+        MappedCacheFile file_;
+        std::size_t size_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_SHAREDSTATICARRAY_HEADER_INCLUDED
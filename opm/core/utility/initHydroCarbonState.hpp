@@ -23,17 +23,26 @@ inline void initHydroCarbonState(BlackoilState& state, const PhaseUsage& pu, con
     // set hydrocarbon state
     const double epsilon = std::sqrt(std::numeric_limits<double>::epsilon());
     const std::vector<double>& saturation = state.saturation();
+    const bool has_water = pu.phase_used[Water];
+    const int water_pos = pu.phase_pos[ Water ];
+    const int gas_pos = pu.phase_pos[ Gas ];
+    const int oil_pos = pu.phase_pos[ Oil ];
+    // the cells are independent
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // HAVE_OPENMP
     for (int c = 0; c < num_cells; ++c) {
-        if (pu.phase_used[Water]) {
-            if ( saturation[c*np + pu.phase_pos[ Water ]] > (1.0 - epsilon)) {
+        const double* sat = &saturation[c*np];
+        if (has_water) {
+            if ( sat[ water_pos ] > (1.0 - epsilon)) {
                 continue; // cases (almost) filled with water is treated as GasAndOil case;
             }
         }
-        if ( saturation[c*np + pu.phase_pos[ Gas ]] == 0.0 && has_disgas) {
+        if ( sat[ gas_pos ] == 0.0 && has_disgas) {
             hydroCarbonState[c] = HydroCarbonState::OilOnly;
             continue;
         }
-        if ( saturation[c*np + pu.phase_pos[ Oil ]] == 0.0 && has_vapoil) {
+        if ( sat[ oil_pos ] == 0.0 && has_vapoil) {
             hydroCarbonState[c] = HydroCarbonState::GasOnly;
         }
     }
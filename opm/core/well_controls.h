@@ -59,6 +59,17 @@ well_controls_clone(const struct WellControls *ctrl);
 void
 well_controls_destroy(struct WellControls *ctrl);
 
+/**
+ * Ensure room for a given number of controls without reallocation.
+ *
+ * @param[in]     nctrl Number of controls.
+ * @param[in,out] ctrl  Existing set of well controls.
+ *
+ * @return Non-zero (true) if successful and zero (false) otherwise.
+ */
+int
+well_controls_reserve(int nctrl, struct WellControls *ctrl);
+
 
 int 
 well_controls_get_num(const struct WellControls *ctrl);
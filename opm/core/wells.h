@@ -180,6 +180,26 @@ struct Wells *
 create_wells(int nphases, int nwells, int nperf);
 
 
+/**
+ * Ensure room for a given number of wells, well connections and
+ * characters of well names in an existing Wells object.
+ *
+ * Meant for building a Wells object in two passes, first counting the
+ * wells, connections and names and then adding the wells by function
+ * add_well() without reallocation.  Capacities are never reduced.
+ *
+ * \param[in] nwells Total number of wells.
+ * \param[in] nperf  Total number of well connections.
+ * \param[in] nchar  Total length of the well names, including one
+ *                   terminating null character per name.
+ * \param[in,out] W  Existing set of wells.
+ *
+ * \return Non-zero (true) if successful and zero (false) otherwise.
+ */
+int
+reserve_wells(int nwells, int nperf, int nchar, struct Wells *W);
+
+
 /**
  * Append a new well to an existing Wells object.
  *
@@ -245,6 +265,19 @@ append_well_controls(enum WellControlType type  ,
                      struct Wells        *W);
 
 
+/**
+ * Ensure room for a given number of operational constraints of an
+ * existing well, such that append_well_controls() does not reallocate.
+ *
+ * \param[in] nctrl      Number of controls.
+ * \param[in] well_index Index of well.
+ * \param[in,out] W      Existing set of wells.
+ * \return Non-zero (true) if successful and zero (false) otherwise.
+ */
+int
+reserve_well_controls(int nctrl, int well_index, struct Wells *W);
+
+
 /**
  * Set the current/active control for a single well.
  *
@@ -25,10 +25,34 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <utility>
 
 namespace Opm
 {
+    namespace
+    {
+        // The production control modes with a group target rate.
+        const std::array<ProductionSpecification::ControlMode, 4> rate_modes = {{
+            ProductionSpecification::LRAT,
+            ProductionSpecification::ORAT,
+            ProductionSpecification::WRAT,
+            ProductionSpecification::GRAT
+        }};
+
+        int rateModeIndex(const ProductionSpecification::ControlMode mode)
+        {
+            for (size_t m = 0; m < rate_modes.size(); ++m) {
+                if (rate_modes[m] == mode) {
+                    return m;
+                }
+            }
+            return -1;
+        }
+    } // anonymous namespace
+
     void WellCollection::addField(const Group& fieldGroup, size_t timeStep, const PhaseUsage& phaseUsage) {
         WellsGroupInterface* fieldNode = findNode(fieldGroup.name());
         if (fieldNode) {
@@ -36,6 +60,7 @@ namespace Opm
         }
 
         roots_.push_back(createGroupWellsGroup(fieldGroup, timeStep, phaseUsage));
+        addToIndex(roots_.back().get());
     }
 
     void WellCollection::addGroup(const Group& groupChild, std::string parent_name,
@@ -66,6 +91,7 @@ namespace Opm
         }
         parent_as_group->addChild(child);
         child->setParent(parent);
+        addToIndex(child.get());
     }
 
     void WellCollection::addWell(const Well* wellChild, size_t timeStep, const PhaseUsage& phaseUsage) {
@@ -90,6 +116,7 @@ namespace Opm
         leaf_nodes_.push_back(static_cast<WellNode*>(child.get()));
 
         child->setParent(parent);
+        addToIndex(child.get());
     }
 
     const std::vector<WellNode*>& WellCollection::getLeafNodes() const {
@@ -98,7 +125,12 @@ namespace Opm
 
     WellsGroupInterface* WellCollection::findNode(const std::string& name)
     {
+        const auto node = nodes_by_name_.find(name);
+        if (node != nodes_by_name_.end()) {
+            return node->second;
+        }
 
+        // Nodes inside subtrees added with addChild are not in the index.
         for (size_t i = 0; i < roots_.size(); i++) {
             WellsGroupInterface* result = roots_[i]->findGroup(name);
             if (result) {
@@ -110,7 +142,12 @@ namespace Opm
 
     const WellsGroupInterface* WellCollection::findNode(const std::string& name) const
     {
+        const auto node = nodes_by_name_.find(name);
+        if (node != nodes_by_name_.end()) {
+            return node->second;
+        }
 
+        // Nodes inside subtrees added with addChild are not in the index.
         for (size_t i = 0; i < roots_.size(); i++) {
             WellsGroupInterface* result = roots_[i]->findGroup(name);
             if (result) {
@@ -123,17 +160,60 @@ namespace Opm
 
     WellNode& WellCollection::findWellNode(const std::string& name) const
     {
-        auto well_node = std::find_if(leaf_nodes_.begin(), leaf_nodes_.end(),
-                    [&] ( WellNode* w) {
-                    return w->name() == name;
-                    });
+        const auto well_node = leaf_nodes_by_name_.find(name);
 
         // Does not find the well
-        if (well_node == leaf_nodes_.end()) {
+        if (well_node == leaf_nodes_by_name_.end()) {
             OPM_THROW(std::runtime_error, "Could not find well " << name << " in the well collection!\n");
         }
 
-        return *(*well_node);
+        return *(well_node->second);
+    }
+
+    void WellCollection::addToIndex(WellsGroupInterface* node)
+    {
+        // The first node with a given name is the one found by a search of the tree.
+        nodes_by_name_.emplace(node->name(), node);
+        if (node->isLeafNode()) {
+            leaf_nodes_by_name_.emplace(node->name(), static_cast<WellNode*>(node));
+        }
+        flat_nodes_valid_ = false;
+    }
+
+    void WellCollection::buildFlatNodes() const
+    {
+        flat_nodes_.clear();
+        flat_parents_.clear();
+
+        // A pre-order with the children visited last to first, which reversed
+        // is the post-order with the children in the order they were added.
+        std::vector<std::pair<const WellsGroupInterface*, int> > stack;
+        for (const auto& root : roots_) {
+            stack.emplace_back(root.get(), -1);
+        }
+        while (!stack.empty()) {
+            const WellsGroupInterface* node = stack.back().first;
+            const int parent = stack.back().second;
+            stack.pop_back();
+            const int position = flat_nodes_.size();
+            flat_nodes_.push_back(node);
+            flat_parents_.push_back(parent);
+            if (!node->isLeafNode()) {
+                for (const auto& child : static_cast<const WellsGroup*>(node)->children()) {
+                    stack.emplace_back(child.get(), position);
+                }
+            }
+        }
+
+        const int num_nodes = flat_nodes_.size();
+        std::reverse(flat_nodes_.begin(), flat_nodes_.end());
+        std::reverse(flat_parents_.begin(), flat_parents_.end());
+        for (int& parent : flat_parents_) {
+            if (parent >= 0) {
+                parent = num_nodes - 1 - parent;
+            }
+        }
+        flat_nodes_valid_ = true;
     }
 
     /// Adds the child to the collection
@@ -153,6 +233,7 @@ namespace Opm
         if (child_node->isLeafNode()) {
             leaf_nodes_.push_back(static_cast<WellNode*>(child_node.get()));
         }
+        addToIndex(child_node.get());
 
     }
 
@@ -164,6 +245,7 @@ namespace Opm
         if (child_node->isLeafNode()) {
             leaf_nodes_.push_back(static_cast<WellNode*> (child_node.get()));
         }
+        addToIndex(child_node.get());
     }
 
     bool WellCollection::conditionsMet(const std::vector<double>& well_bhp,
@@ -341,9 +423,52 @@ namespace Opm
     {
         // TODO: eventually, there should be only one root node
         // TODO: we also need to check the injection target, while we have not done that.
-        for (const std::shared_ptr<WellsGroupInterface>& root_node : roots_) {
-            if ( !root_node->groupProdTargetConverged(well_rates) ) {
-                return false;
+        // Same as groupProdTargetConverged() of the roots, which check the children
+        // of a group before the group, but with the rates of the groups summed
+        // while walking the post-ordered nodes instead of once per tree level.
+        if (!flat_nodes_valid_) {
+            buildFlatNodes();
+        }
+
+        // Only the rate modes of the groups are evaluated for the wells.
+        std::array<bool, 4> mode_used = {{ false, false, false, false }};
+        for (const WellsGroupInterface* node : flat_nodes_) {
+            if (!node->isLeafNode()) {
+                const int m = rateModeIndex(node->prodSpec().control_mode_);
+                if (m >= 0) {
+                    mode_used[m] = true;
+                }
+            }
+        }
+
+        const int num_nodes = flat_nodes_.size();
+        flat_rates_.assign(num_nodes, {{ 0.0, 0.0, 0.0, 0.0 }});
+        flat_can_produce_more_.assign(num_nodes, false);
+        for (int i = 0; i < num_nodes; ++i) {
+            const WellsGroupInterface* node = flat_nodes_[i];
+            auto& rates = flat_rates_[i];
+            if (node->isLeafNode()) {
+                for (size_t m = 0; m < rate_modes.size(); ++m) {
+                    if (mode_used[m]) {
+                        rates[m] = node->getProductionRate(well_rates, rate_modes[m]);
+                    }
+                }
+                flat_can_produce_more_[i] = node->canProduceMore();
+            } else {
+                const int m = rateModeIndex(node->prodSpec().control_mode_);
+                const double production_rate = (m >= 0) ? std::abs(rates[m]) : 0.0;
+                if ( !static_cast<const WellsGroup*>(node)->productionTargetConverged(production_rate, flat_can_produce_more_[i]) ) {
+                    return false;
+                }
+            }
+
+            const int parent = flat_parents_[i];
+            if (parent >= 0) {
+                const double efficiency_factor = node->efficiencyFactor();
+                for (size_t m = 0; m < rate_modes.size(); ++m) {
+                    flat_rates_[parent][m] += rates[m] * efficiency_factor;
+                }
+                flat_can_produce_more_[parent] = flat_can_produce_more_[parent] || flat_can_produce_more_[i];
             }
         }
         return true;
@@ -19,8 +19,11 @@
 #ifndef OPM_WELLCOLLECTION_HPP
 #define	OPM_WELLCOLLECTION_HPP
 
+#include <array>
 #include <vector>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 #include <opm/core/wells/WellsGroup.hpp>
 #include <opm/grid/UnstructuredGrid.h>
@@ -165,6 +168,30 @@ namespace Opm
         // This will be used to traverse the bottom nodes.
         std::vector<WellNode*> leaf_nodes_;
 
+        // The nodes added to the collection by name, to avoid searching the tree.
+        std::unordered_map<std::string, WellsGroupInterface*> nodes_by_name_;
+
+        // The leaf nodes by name.
+        std::unordered_map<std::string, WellNode*> leaf_nodes_by_name_;
+
+        // Registers a node added to the collection in the maps above.
+        void addToIndex(WellsGroupInterface* node);
+
+        // All the nodes of the trees in post-order, i.e. every node after its
+        // children, and the position of the parent of each node in it (-1 for
+        // the roots). Rebuilt on first use after a node was added, so that the
+        // group rates can be summed in one pass without recursion.
+        mutable std::vector<const WellsGroupInterface*> flat_nodes_;
+        mutable std::vector<int> flat_parents_;
+        mutable bool flat_nodes_valid_ = false;
+
+        // Production rates of the flattened nodes in the group target rate modes,
+        // and whether they can produce more.
+        mutable std::vector<std::array<double, 4> > flat_rates_;
+        mutable std::vector<char> flat_can_produce_more_;
+
+        void buildFlatNodes() const;
+
         bool having_vrep_groups_ = false;
 
         bool group_control_active_ = false;
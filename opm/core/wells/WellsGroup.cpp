@@ -454,6 +454,12 @@ namespace Opm
     }
 
 
+    const std::vector<std::shared_ptr<WellsGroupInterface> >& WellsGroup::children() const
+    {
+        return children_;
+    }
+
+
     int WellsGroup::numberOfLeafNodes() {
         // This could probably use some caching, but seeing as how the number of
         // wells is relatively small, we'll do without for now.
@@ -845,6 +851,26 @@ namespace Opm
             }
         }
 
+        const ProductionSpecification::ControlMode prod_mode = prodSpec().control_mode_;
+        double production_rate = 0.0;
+        switch(prod_mode) {
+            case ProductionSpecification::LRAT :
+            case ProductionSpecification::ORAT :
+            case ProductionSpecification::WRAT :
+            case ProductionSpecification::GRAT :
+                production_rate = std::abs(getProductionRate(well_rates, prod_mode));
+                break;
+            default:
+                break;
+        }
+
+        return productionTargetConverged(production_rate, canProduceMore());
+    }
+
+
+    bool WellsGroup::productionTargetConverged(const double production_rate,
+                                               const bool can_produce_more) const
+    {
         // We need to check whether the current group target is satisfied
         // we need to decide the modes we want to support here.
         const ProductionSpecification::ControlMode prod_mode = prodSpec().control_mode_;
@@ -854,7 +880,6 @@ namespace Opm
             case ProductionSpecification::WRAT :
             case ProductionSpecification::GRAT :
             {
-                const double production_rate = std::abs(getProductionRate(well_rates, prod_mode));
                 const double production_target = std::abs(getTarget(prod_mode));
 
                 // 0.01 is a hard-coded relative tolerance
@@ -866,7 +891,7 @@ namespace Opm
                     if (production_rate < production_target) {
                         // underproducing the target while potentially can produce more
                         // then we should not consider the effort to match the group target is done yet
-                        if (canProduceMore()) {
+                        if (can_produce_more) {
                             return false;
                         } else {
                             // can not produce more to meet the target
@@ -295,6 +295,9 @@ namespace Opm
 
         void addChild(std::shared_ptr<WellsGroupInterface> child);
 
+        /// The children of the group, in the order they were added.
+        const std::vector<std::shared_ptr<WellsGroupInterface> >& children() const;
+
         virtual bool conditionsMet(const std::vector<double>& well_bhp,
                                    const std::vector<double>& well_reservoirrates_phase,
                                    const std::vector<double>& well_surfacerates_phase,
@@ -387,6 +390,13 @@ namespace Opm
 
         virtual bool groupProdTargetConverged(const std::vector<double>& well_rates) const;
 
+        /// Checks the production target of this group only, the children are not checked.
+        /// \param[in] production_rate   absolute production rate of the group in its
+        ///                              control mode, ignored if the mode has no rate target
+        /// \param[in] can_produce_more  whether canProduceMore() is true for the group
+        bool productionTargetConverged(const double production_rate,
+                                       const bool can_produce_more) const;
+
     private:
         std::vector<std::shared_ptr<WellsGroupInterface> > children_;
     };
@@ -30,6 +30,8 @@
 #include <opm/core/wells/WellsGroup.hpp>
 #include <opm/core/props/phaseUsageFromDeck.hpp>
 
+#include <opm/parser/eclipse/EclipseState/Schedule/Events.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/ScheduleEnums.hpp>
 
 #include <algorithm>
@@ -315,13 +317,13 @@ namespace Opm
 
     /// Default constructor.
     WellsManager::WellsManager()
-        : w_(create_wells(0,0,0)), is_parallel_run_(false)
+        : w_(create_wells(0,0,0)), initial_wells_(nullptr), is_parallel_run_(false)
     {
     }
 
     /// Construct from existing wells object.
     WellsManager::WellsManager(struct Wells* W)
-        : w_(clone_wells(W)), is_parallel_run_(false)
+        : w_(clone_wells(W)), initial_wells_(nullptr), is_parallel_run_(false)
     {
     }
 
@@ -330,7 +332,7 @@ namespace Opm
                                const Opm::Schedule& schedule,
                                const size_t timeStep,
                                const UnstructuredGrid& grid)
-        : w_(create_wells(0,0,0)), is_parallel_run_(false)
+        : w_(create_wells(0,0,0)), initial_wells_(nullptr), is_parallel_run_(false)
     {
         // TODO: not sure about the usage of this WellsManager constructor
         // TODO: not sure whether this is the correct thing to do here.
@@ -348,6 +350,68 @@ namespace Opm
     WellsManager::~WellsManager()
     {
         destroy_wells(w_);
+        if (initial_wells_) {
+            destroy_wells(initial_wells_);
+        }
+    }
+
+
+
+    bool WellsManager::scheduleChanged(const Opm::Schedule& schedule,
+                                       const size_t fromStep,
+                                       const size_t toStep)
+    {
+        const auto& events = schedule.getEvents();
+        for (size_t step = fromStep + 1; step <= toStep; ++step) {
+            for (const auto event : { ScheduleEvents::NEW_WELL,
+                                      ScheduleEvents::WELL_STATUS_CHANGE,
+                                      ScheduleEvents::COMPLETION_CHANGE,
+                                      ScheduleEvents::PRODUCTION_UPDATE,
+                                      ScheduleEvents::INJECTION_UPDATE,
+                                      ScheduleEvents::NEW_GROUP,
+                                      ScheduleEvents::GROUP_CHANGE,
+                                      ScheduleEvents::WELLGROUP_EFFICIENCY_UPDATE }) {
+                if (events.hasEvent(event, step)) {
+                    return true;
+                }
+            }
+        }
+        return toStep < fromStep;
+    }
+
+
+
+    bool WellsManager::restoreInitialWells()
+    {
+        if (!initial_wells_ || w_->number_of_wells != initial_wells_->number_of_wells) {
+            return false;
+        }
+        for (int w = 0; w < w_->number_of_wells; ++w) {
+            WellControls* ctrl = w_->ctrls[w];
+            const WellControls* initial = initial_wells_->ctrls[w];
+            if (!well_controls_equal(ctrl, initial, false)) {
+                well_controls_clear(ctrl);
+                for (int c = 0; c < well_controls_get_num(initial); ++c) {
+                    const int ok = well_controls_add_new(well_controls_iget_type(initial, c),
+                                                         well_controls_iget_target(initial, c),
+                                                         well_controls_iget_alq(initial, c),
+                                                         well_controls_iget_vfp(initial, c),
+                                                         well_controls_iget_distr(initial, c),
+                                                         ctrl);
+                    if (!ok) {
+                        return false;
+                    }
+                }
+            }
+            well_controls_set_current(ctrl, well_controls_get_current(initial));
+            if (well_controls_well_is_stopped(initial)) {
+                well_controls_stop_well(ctrl);
+            }
+            else {
+                well_controls_open_well(ctrl);
+            }
+        }
+        return wells_equal(w_, initial_wells_, false);
     }
 
 
@@ -152,6 +152,21 @@ namespace Opm
         void applyExplicitReinjectionControls(const std::vector<double>& well_reservoirrates_phase,
                                               const std::vector<double>& well_surfacerates_phase);
 
+        /// Whether the schedule changes the wells, their controls or the groups
+        /// after fromStep up to and including toStep, i.e. whether the wells
+        /// constructed for toStep differ from those constructed for fromStep.
+        static bool scheduleChanged(const Opm::Schedule& schedule,
+                                    size_t fromStep,
+                                    size_t toStep);
+
+        /// Restore the controls of the wells to those they were constructed with,
+        /// undoing the changes of the simulation, so that the wells can be reused
+        /// for a later report step without changes in the schedule. Only the
+        /// controls that differ are rebuilt.
+        /// \return false if the wells were not constructed from a schedule or
+        ///         could not be restored, in which case they have to be constructed anew.
+        bool restoreInitialWells();
+
 
     private:
         template<class C2F, class FC>
@@ -197,6 +212,8 @@ namespace Opm
 
         // Data
         Wells* w_;
+        // a copy of w_ as constructed, see restoreInitialWells()
+        Wells* initial_wells_;
         WellCollection well_collection_;
         // Whether this is a parallel simulation
         bool is_parallel_run_;
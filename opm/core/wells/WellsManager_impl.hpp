@@ -256,13 +256,20 @@ void WellsManager::createWellsFromSpecs(std::vector<const Well*>& wells, size_t
     const int num_wells = well_data.size();
 
     int num_perfs = 0;
+    int num_name_chars = 0;
     assert (dimensions == 3);
     for (int w = 0; w < num_wells; ++w) {
         num_perfs += wellperf_data[w].size();
+        num_name_chars += well_names[w].size() + 1;
     }
-    // Create the well data structures.
+    // Create the well data structures, allocated once for all wells.
     struct Wells* w = create_wells(phaseUsage.num_phases, num_wells, num_perfs);
 
+    if (w && !reserve_wells(num_wells, num_perfs, num_name_chars, w)) {
+        destroy_wells(w);
+        w = nullptr;
+    }
+
     if (!w) {
         OPM_THROW(std::runtime_error, "Failed creating Wells struct.");
     }
@@ -299,7 +306,9 @@ void WellsManager::createWellsFromSpecs(std::vector<const Well*>& wells, size_t
                      well_data[w].allowCrossFlow,
                      w_);
 
-        if (!ok) {
+        // Room for all controls setupWellControls() may add to the well.
+        const int max_controls = well_data[w].type == INJECTOR ? 4 : 7;
+        if (!ok || !reserve_well_controls(max_controls, w, w_)) {
             OPM_THROW(std::runtime_error,
                       "Failed adding well "
                       << well_names[w]
@@ -322,7 +331,7 @@ WellsManager(const Opm::EclipseState& eclipseState,
              const DynamicListEconLimited&   list_econ_limited,
              bool                            is_parallel_run,
              const std::unordered_set<std::string>&    deactivated_wells)
-    : w_(create_wells(0,0,0)), is_parallel_run_(is_parallel_run)
+    : w_(create_wells(0,0,0)), initial_wells_(nullptr), is_parallel_run_(is_parallel_run)
 {
   init(eclipseState, schedule, timeStep, number_of_cells, global_cell,
          cart_dims, dimensions,
@@ -450,6 +459,8 @@ WellsManager::init(const Opm::EclipseState& eclipseState,
         setupGuideRates(wells, timeStep, well_data, well_names_to_index);
     }
 
+    initial_wells_ = clone_wells(w_);
+
     // Debug output.
 #define EXTRA_OUTPUT
 #ifdef EXTRA_OUTPUT
@@ -163,13 +163,17 @@ well_controls_create(void)
 
 
 /* ---------------------------------------------------------------------- */
-static int
+int
 well_controls_reserve(int nctrl, struct WellControls *ctrl)
 /* ---------------------------------------------------------------------- */
 {
     int   c, p, ok;
     void *type, *target, *alq, *vfp, *distr;
 
+    if (nctrl <= ctrl->cpty) {
+        return 1;
+    }
+
     type   = realloc(ctrl->type  , nctrl * 1                      * sizeof *ctrl->type  );
     target = realloc(ctrl->target, nctrl * 1                      * sizeof *ctrl->target);
     alq    = realloc(ctrl->alq   , nctrl * 1                      * sizeof *ctrl->alq   );
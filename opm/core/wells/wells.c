@@ -48,12 +48,21 @@
 struct WellMgmt {
     int well_cpty;
     int perf_cpty;
+
+    /* Well names, stored consecutively including terminators. */
+    char *names;
+    int   name_size;
+    int   name_cpty;
 };
 
 
 static void
 destroy_well_mgmt(struct WellMgmt *m)
 {
+    if (m != NULL) {
+        free(m->names);
+    }
+
     free(m);
 }
 
@@ -68,6 +77,10 @@ create_well_mgmt(void)
     if (m != NULL) {
         m->well_cpty = 0;
         m->perf_cpty = 0;
+
+        m->names     = NULL;
+        m->name_size = 0;
+        m->name_cpty = 0;
     }
 
     return m;
@@ -233,19 +246,88 @@ wells_reserve(int nwells, int nperf, struct Wells *W)
 }
 
 
+/* ---------------------------------------------------------------------- */
+static int
+names_reserve(int nchar, struct Wells *W)
+/* ---------------------------------------------------------------------- */
+{
+    int   w;
+    char *names;
+
+    struct WellMgmt *m;
+
+    m = W->data;
+
+    if (nchar <= m->name_cpty) {
+        return 1;
+    }
+
+    names = malloc(nchar * sizeof *names);
+
+    if (names == NULL) {
+        return 0;
+    }
+
+    if (m->name_size > 0) {
+        memcpy(names, m->names, m->name_size * sizeof *names);
+    }
+
+    /* Point the existing names of the wells into the new arena. */
+    for (w = 0; w < W->number_of_wells; w++) {
+        if (W->name[w] != NULL) {
+            W->name[w] = names + (W->name[w] - m->names);
+        }
+    }
+
+    free(m->names);
+
+    m->names     = names;
+    m->name_cpty = nchar;
+
+    return 1;
+}
+
+
+/* ---------------------------------------------------------------------- */
+static int
+alloc_size(int n, int a, int cpty)
+/* ---------------------------------------------------------------------- */
+{
+    if (cpty < n + a) {
+        cpty *= 2;              /* log_2(n) allocations */
+
+        if (cpty < n + a) {     /* Typically for the first few allocs */
+            cpty = n + a;
+        }
+    }
+
+    return cpty;
+}
+
+
 /* ---------------------------------------------------------------------- */
 static char *
-dup_string(const char *s)
+add_name(const char *s, struct Wells *W)
 /* ---------------------------------------------------------------------- */
 {
+    int   len, ok;
     char *t;
 
+    struct WellMgmt *m;
+
     assert (s != NULL);
 
-    t = malloc((strlen(s) + 1) * sizeof *t);
+    m   = W->data;
+    len = (int) strlen(s) + 1;
+
+    ok = names_reserve(alloc_size(m->name_size, len, m->name_cpty), W);
 
-    if (t != NULL) {
-        strcpy(t, s);
+    t = NULL;
+    if (ok) {
+        t = m->names + m->name_size;
+        memcpy(t, s, len * sizeof *t);
+
+        m->name_size += len;
     }
 
     return t;
@@ -305,6 +387,48 @@ create_wells(int nphases, int nwells, int nperf)
 }
 
 
+/* ---------------------------------------------------------------------- */
+int
+reserve_wells(int nwells, int nperf, int nchar, struct Wells *W)
+/* ---------------------------------------------------------------------- */
+{
+    int ok;
+
+    struct WellMgmt *m;
+
+    assert (W != NULL);
+
+    m = W->data;
+
+    ok = wells_reserve((nwells > m->well_cpty) ? nwells : m->well_cpty,
+                       (nperf  > m->perf_cpty) ? nperf  : m->perf_cpty, W);
+
+    if (ok) {
+        ok = names_reserve(nchar, W);
+    }
+
+    return ok;
+}
+
+
+/* ---------------------------------------------------------------------- */
+int
+reserve_well_controls(int nctrl, int well_index, struct Wells *W)
+/* ---------------------------------------------------------------------- */
+{
+    struct WellControls *ctrl;
+
+    assert (W != NULL);
+    assert ((0 <= well_index) && (well_index < W->number_of_wells));
+
+    ctrl = W->ctrls[well_index];
+    assert (ctrl != NULL);
+
+    well_controls_assert_number_of_phases(ctrl, W->number_of_phases);
+    return well_controls_reserve(nctrl, ctrl);
+}
+
+
 /* ---------------------------------------------------------------------- */
 void
 destroy_wells(struct Wells *W)
@@ -321,10 +445,6 @@ destroy_wells(struct Wells *W)
             well_controls_destroy(W->ctrls[w]);
         }
 
-        for (w = 0; w < m->well_cpty; w++) {
-            free(W->name[w]);
-        }
-
         destroy_well_mgmt(m);
 
         free(W->name);
@@ -343,23 +463,6 @@ destroy_wells(struct Wells *W)
 }
 
 
-/* ---------------------------------------------------------------------- */
-static int
-alloc_size(int n, int a, int cpty)
-/* ---------------------------------------------------------------------- */
-{
-    if (cpty < n + a) {
-        cpty *= 2;              /* log_2(n) allocations */
-
-        if (cpty < n + a) {     /* Typically for the first few allocs */
-            cpty = n + a;
-        }
-    }
-
-    return cpty;
-}
-
-
 /* ---------------------------------------------------------------------- */
 int
 add_well(enum WellType  type     ,
@@ -419,7 +522,7 @@ add_well(enum WellType  type     ,
         if (name != NULL) {
              /* May return NULL, but that's fine for the current
               * purpose. */
-            W->name [nw] = dup_string(name);
+            W->name [nw] = add_name(name, W);
         }
 
         np = W->number_of_phases;
@@ -509,6 +612,12 @@ clone_wells(const struct Wells *W)
                                 W->well_connpos[ W->number_of_wells ]);
 
         if (newWells != NULL) {
+            if (! reserve_wells(0, 0, ((struct WellMgmt *) W->data)->name_size,
+                                newWells)) {
+                destroy_wells(newWells);
+                return NULL;
+            }
+
             pos = W->well_connpos[ 0 ];
             ok  = 1;
 
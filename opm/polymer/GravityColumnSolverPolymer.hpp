@@ -53,12 +53,22 @@ namespace Opm
 		   std::vector<double>& cmax);
 
     private:
+        // Band matrix, right hand side and pivots of a column system. One
+        // is kept per thread and reused for the columns it solves.
+        struct ColumnWorkspace
+        {
+            std::vector<double> hm;
+            std::vector<double> rhs;
+            std::vector<int> ipiv;
+        };
+
 	void solveSingleColumn(const std::vector<int>& column_cells,
 			       const double dt,
 			       std::vector<double>& s,
 			       std::vector<double>& c,
 			       std::vector<double>& cmax,
-			       std::vector<double>& sol_vec
+			       std::vector<double>& sol_vec,
+			       ColumnWorkspace& workspace
  			       );
 	FluxModel& fmodel_;
         const Model& model_;
@@ -37,6 +37,7 @@
 */
 
 #include <opm/polymer/GravityColumnSolverPolymer.hpp>
+#include <opm/core/transport/GravityColumnSolve.hpp>
 #include <opm/core/linalg/blas_lapack.h>
 #include <opm/common/ErrorMacros.hpp>
 #include <iterator>
@@ -141,10 +142,13 @@ namespace Opm
         const double tol_c_cell = 1e-2*cmax_cell; 
 	while (iter < maxit_) {
 	    fmodel_.initIteration(state, grid_, sys);
-            int size = columns.size();
-            for(int i = 0; i < size; ++i) {
-		solveSingleColumn(columns[i], dt, s, c, cmax, increment);
-	    }
+            // The columns are independent and only write the increments of
+            // their own cells, so they are solved concurrently.
+            solveColumnsConcurrently<ColumnWorkspace>(columns,
+                [&](const std::vector<int>& column, ColumnWorkspace& workspace) {
+                    solveSingleColumn(column, dt, s, c, cmax, increment, workspace);
+                    return 0;
+                });
 	    for (int cell = 0; cell < grid_.number_of_cells; ++cell) {
                 double& s_cell = sys.vector().writableSolution()[2*cell + 0];
                 double& c_cell = sys.vector().writableSolution()[2*cell + 1];
@@ -241,7 +245,8 @@ namespace Opm
                                                               std::vector<double>& s,
                                                               std::vector<double>& c,
                                                               std::vector<double>& cmax,
-                                                              std::vector<double>& sol_vec)
+                                                              std::vector<double>& sol_vec,
+                                                              ColumnWorkspace& workspace)
     {
 	// This is written only to work with SinglePointUpwindTwoPhase,
 	// not with arbitrary problem models.
@@ -260,16 +265,18 @@ namespace Opm
         const int ku = 3;
         const int nrow = 2*kl + ku + 1;
         const int N = 2*col_size; // N unknowns: s and c for each cell.
-	std::vector<double> hm(nrow*N, 0.0); // band matrix with 3 upper and 3 lower diagonals.
-	std::vector<double> rhs(N, 0.0);
+	std::vector<double>& hm = workspace.hm; // band matrix with 3 upper and 3 lower diagonals.
+	std::vector<double>& rhs = workspace.rhs;
+	hm.assign(nrow*N, 0.0);
+	rhs.assign(N, 0.0);
         const BandMatrixCoeff bmc(N, ku, kl);
 
 
 	for (int ci = 0; ci < col_size; ++ci) {
-	    std::vector<double> F(2, 0.);
-	    std::vector<double> dFd1(4, 0.);
-	    std::vector<double> dFd2(4, 0.);
-	    std::vector<double> dF(4, 0.);
+	    double F[2] = { 0. };
+	    double dFd1[4] = { 0. };
+	    double dFd2[4] = { 0. };
+	    double dF[4] = { 0. };
 	    const int cell = column_cells[ci];
 	    const int prev_cell = (ci == 0) ? -999 : column_cells[ci - 1];
 	    const int next_cell = (ci == col_size - 1) ? -999 : column_cells[ci + 1];
@@ -279,10 +286,10 @@ namespace Opm
 		const int c1 = grid_.face_cells[2*face + 0];
                 const int c2 = grid_.face_cells[2*face + 1];
 		if (c1 == prev_cell || c2 == prev_cell || c1 == next_cell || c2 == next_cell) {
-                    F.assign(2, 0.);
-                    dFd1.assign(4, 0.);
-                    dFd2.assign(4, 0.);
-		    fmodel_.fluxConnection(state, grid_, dt, cell, face, &F[0], &dFd1[0], &dFd2[0]);
+                    std::fill(F, F + 2, 0.);
+                    std::fill(dFd1, dFd1 + 4, 0.);
+                    std::fill(dFd2, dFd2 + 4, 0.);
+		    fmodel_.fluxConnection(state, grid_, dt, cell, face, F, dFd1, dFd2);
 		    if (c1 == prev_cell || c2 == prev_cell) {
                         hm[bmc(2*ci + 0, 2*(ci - 1) + 0)] += dFd2[0];
                         hm[bmc(2*ci + 0, 2*(ci - 1) + 1)] += dFd2[1];
@@ -304,9 +311,9 @@ namespace Opm
 		    rhs[2*ci + 1] += F[1];
 		}
 	    }
-	    F.assign(2, 0.);
-            dF.assign(4, 0.);
-	    fmodel_.accumulation(grid_, cell, &F[0], &dF[0]);
+	    std::fill(F, F + 2, 0.);
+            std::fill(dF, dF + 4, 0.);
+	    fmodel_.accumulation(grid_, cell, F, dF);
             hm[bmc(2*ci + 0, 2*ci + 0)] += dF[0];
             hm[bmc(2*ci + 0, 2*ci + 1)] += dF[1];
             hm[bmc(2*ci + 1, 2*ci + 0)] += dF[2];
@@ -324,7 +331,8 @@ namespace Opm
 	// Solve.
 	const int num_rhs = 1;
 	int info = 0;
-        std::vector<int> ipiv(N, 0);
+        std::vector<int>& ipiv = workspace.ipiv;
+        ipiv.assign(N, 0);
 	// Solution will be written to rhs.
         dgbsv_(&N, &kl, &ku, &num_rhs, &hm[0], &nrow, &ipiv[0], &rhs[0], &N, &info);
 	if (info != 0) {
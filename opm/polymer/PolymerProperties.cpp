@@ -28,8 +28,31 @@
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/common/Exceptions.hpp>
 
+namespace
+{
+    // Value and slope of a linear interpolation in the table (xv, yv) with a
+    // single search for the table interval. Extrapolates like
+    // Opm::linearInterpolation().
+    double linearInterpolationWithDer(const std::vector<double>& xv,
+                                      const std::vector<double>& yv,
+                                      const double x, double& der)
+    {
+        const int ix1 = Opm::tableIndex(xv, x);
+        const int ix2 = ix1 + 1;
+        der = (yv[ix2] - yv[ix1])/(xv[ix2] - xv[ix1]);
+        return der*(x - xv[ix1]) + yv[ix1];
+    }
+}
+
 namespace Opm
 {
+    void PolymerProperties::computeViscMultCMax()
+    {
+        const double visc_mult_cmax = viscMult(c_max_);
+        visc_mult_cmax_pow_ = std::pow(visc_mult_cmax, mix_param_ - 1.);
+        mc_factor_ = std::pow(visc_mult_cmax, 1. - mix_param_);
+    }
+
     double PolymerProperties::cMax() const
     {
         return c_max_;
@@ -128,8 +151,7 @@ namespace Opm
     double
     PolymerProperties::shearVrfWithDer(const double velocity, double& der) const
     {
-        der =  Opm::linearInterpolationDerivative(water_vel_vals_, shear_vrf_vals_, velocity);
-        return Opm::linearInterpolation(water_vel_vals_, shear_vrf_vals_, velocity);
+        return linearInterpolationWithDer(water_vel_vals_, shear_vrf_vals_, velocity, der);
     }
 
     double PolymerProperties::viscMult(double c) const
@@ -139,8 +161,7 @@ namespace Opm
 
     double PolymerProperties::viscMultWithDer(double c, double* der) const
     {
-        *der = Opm::linearInterpolationDerivative(c_vals_visc_, visc_mult_vals_, c);
-        return Opm::linearInterpolation(c_vals_visc_, visc_mult_vals_, c);
+        return linearInterpolationWithDer(c_vals_visc_, visc_mult_vals_, c, *der);
     }
 
     void PolymerProperties::simpleAdsorption(double c, double& c_ads) const
@@ -158,10 +179,10 @@ namespace Opm
     void PolymerProperties::simpleAdsorptionBoth(double c, double& c_ads,
                                                  double& dc_ads_dc, bool if_with_der) const
     {
-        c_ads = Opm::linearInterpolation(c_vals_ads_, ads_vals_, c);;
         if (if_with_der) {
-            dc_ads_dc = Opm::linearInterpolationDerivative(c_vals_ads_, ads_vals_, c);
+            c_ads = linearInterpolationWithDer(c_vals_ads_, ads_vals_, c, dc_ads_dc);
         } else {
+            c_ads = Opm::linearInterpolation(c_vals_ads_, ads_vals_, c);
             dc_ads_dc = 0.;
         }
     }
@@ -220,23 +241,25 @@ namespace Opm
                                                  double& dinv_mu_w_eff_dc,
                                                  bool if_with_der) const {
         const double cbar = c/c_max_;
-        double mu_m;
         const double omega = mix_param_;
-        double dmu_m_dc;
+        double visc_mult;
+        double dvisc_mult_dc = 0.0;
         if (if_with_der) {
-            mu_m = viscMultWithDer(c, &dmu_m_dc)*mu_w;
-            dmu_m_dc *= mu_w;
+            visc_mult = viscMultWithDer(c, &dvisc_mult_dc);
         } else {
-            mu_m = viscMult(c)*mu_w;
+            visc_mult = viscMult(c);
         }
-        double mu_p = viscMult(c_max_)*mu_w;
-        double inv_mu_m_omega = std::pow(mu_m, -omega);
-        double inv_mu_w_e   = inv_mu_m_omega*std::pow(mu_w, omega - 1.);
-        double inv_mu_p_eff = inv_mu_m_omega*std::pow(mu_p, omega - 1.);
+        // With mu_m = visc_mult*mu_w and mu_p = viscMult(c_max_)*mu_w,
+        // mu_m^(-omega)*mu_w^(omega - 1) = visc_mult^(-omega)/mu_w and
+        // mu_m^(-omega)*mu_p^(omega - 1) = mu_m^(-omega)*mu_w^(omega - 1)*viscMult(c_max_)^(omega - 1),
+        // which leaves a single std::pow() per evaluation.
+        const double visc_mult_omega = std::pow(visc_mult, -omega);
+        const double inv_mu_w_e   = visc_mult_omega/mu_w;
+        const double inv_mu_p_eff = inv_mu_w_e*visc_mult_cmax_pow_;
         inv_mu_w_eff = (1.0 - cbar)*inv_mu_w_e + cbar*inv_mu_p_eff;
         if (if_with_der) {
-            double dinv_mu_w_e_dc = -omega*dmu_m_dc*std::pow(mu_m, -omega - 1)*std::pow(mu_w, omega - 1);
-            double dinv_mu_p_eff_dc = -omega*dmu_m_dc*std::pow(mu_m, -omega - 1)*std::pow(mu_p, omega - 1);
+            const double dinv_mu_w_e_dc = -omega*dvisc_mult_dc/visc_mult*inv_mu_w_e;
+            const double dinv_mu_p_eff_dc = dinv_mu_w_e_dc*visc_mult_cmax_pow_;
             dinv_mu_w_eff_dc = (1 - cbar)*dinv_mu_w_e_dc + cbar*dinv_mu_p_eff_dc +
                 1/c_max_*(inv_mu_p_eff - inv_mu_w_e);
         }
@@ -268,22 +291,20 @@ namespace Opm
     {
         const double omega = mix_param_;
 
-        double mu_m = 0.0;
-        double dmu_m_dc = 0.0;
+        double visc_mult = 0.0;
+        double dvisc_mult_dc = 0.0;
 
         if (if_with_der) {
-            mu_m = viscMultWithDer(c, &dmu_m_dc)*mu_w;
-            dmu_m_dc *= mu_w;
+            visc_mult = viscMultWithDer(c, &dvisc_mult_dc);
         } else {
-            mu_m = viscMult(c)*mu_w;
+            visc_mult = viscMult(c);
         }
 
-        const double inv_mu_m_omega = std::pow(mu_m, -omega);
-        const double mu_p = viscMult(c_max_) * mu_w;
-        inv_mu_p_eff = inv_mu_m_omega * std::pow(mu_p, omega - 1.);
+        // mu_m^(-omega)*mu_p^(omega - 1), see effectiveInvViscBoth().
+        inv_mu_p_eff = std::pow(visc_mult, -omega) * visc_mult_cmax_pow_ / mu_w;
 
         if (if_with_der) {
-            dinv_mu_p_eff_dc = -omega * dmu_m_dc * std::pow(mu_m, -omega - 1) * std::pow(mu_p, omega - 1);
+            dinv_mu_p_eff_dc = -omega * dvisc_mult_dc / visc_mult * inv_mu_p_eff;
         }
     }
 
@@ -460,12 +481,12 @@ namespace Opm
     void PolymerProperties::computeMcBoth(const double& c, double& mc,
                                           double& dmc_dc, bool if_with_der) const
     {
-        double cbar = c/c_max_;
-        double omega = mix_param_;
-        double r = std::pow(viscMult(c_max_), 1 - omega); // viscMult(c_max_)=mu_p/mu_w
-        mc = c/(cbar + (1 - cbar)*r);
+        const double cbar = c/c_max_;
+        const double r = mc_factor_; // (mu_p/mu_w)^(1 - omega)
+        const double denom = cbar + (1 - cbar)*r;
+        mc = c/denom;
         if (if_with_der) {
-            dmc_dc = r/std::pow(cbar + (1 - cbar)*r, 2);
+            dmc_dc = r/(denom*denom);
         } else {
             dmc_dc = 0.;
         }
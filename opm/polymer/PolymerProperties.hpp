@@ -90,6 +90,7 @@ namespace Opm
               water_vel_vals_(water_vel_vals),
               shear_vrf_vals_(shear_vrf_vals)
         {
+            computeViscMultCMax();
         }
 
         PolymerProperties(const Opm::Deck& deck, const Opm::EclipseState& eclipseState)
@@ -125,6 +126,7 @@ namespace Opm
             ads_index_ = ads_index;
             water_vel_vals_ = water_vel_vals;
             shear_vrf_vals_ = shear_vrf_vals;
+            computeViscMultCMax();
         }
 
         void readFromDeck(const Opm::Deck& deck, const Opm::EclipseState& eclipseState)
@@ -165,6 +167,8 @@ namespace Opm
             c_vals_ads_ = plyadsTable.getPolymerConcentrationColumn().vectorCopy( );
             ads_vals_ = plyadsTable.getAdsorbedPolymerColumn().vectorCopy( );
 
+            computeViscMultCMax();
+
             has_plyshlog_ = deck.hasKeyword("PLYSHLOG");
             has_shrate_ = deck.hasKeyword("SHRATE");
 
@@ -402,6 +406,13 @@ namespace Opm
         bool has_plyshlog_ref_salinity_;
         bool has_plyshlog_ref_temp_;
 
+        // viscMult(c_max_) raised to the powers mix_param_ - 1 and
+        // 1 - mix_param_. They only depend on the tables, but are needed in
+        // every evaluation of the effective viscosities and of computeMc().
+        double visc_mult_cmax_pow_;
+        double mc_factor_;
+
+        void computeViscMultCMax();
 
         void simpleAdsorptionBoth(double c, double& c_ads,
                                   double& dc_ads_dc, bool if_with_der) const;
@@ -22,6 +22,7 @@
 #include <opm/polymer/TransportSolverTwophaseCompressiblePolymer.hpp>
 #include <opm/core/props/BlackoilPropertiesInterface.hpp>
 #include <opm/grid/UnstructuredGrid.h>
+#include <opm/core/transport/GravityColumnSolve.hpp>
 #include <opm/core/transport/reorder/reordersequence.h>
 #include <opm/common/utility/numeric/RootFinders.hpp>
 #include <opm/core/utility/miscUtilities.hpp>
@@ -177,11 +178,7 @@ namespace Opm
           fractionalflow_(grid.number_of_cells, -1.0),
           mc_(grid.number_of_cells, -1.0),
           gravity_(0),
-          mob_(2*grid.number_of_cells, -1.0),
-          ia_upw_(grid.number_of_cells + 1, -1),
-          ja_upw_(grid.number_of_faces, -1),
-          ia_downw_(grid.number_of_cells + 1, -1),
-          ja_downw_(grid.number_of_faces, -1)
+          mob_(2*grid.number_of_cells, -1.0)
 
     {
         const int np = props.numPhases();
@@ -248,18 +245,6 @@ namespace Opm
         if (A_[1] != 0.0 || A_[2] != 0.0) {
             OPM_THROW(std::runtime_error, "TransportCompressibleSolverTwophaseCompressibleTwophase requires a property object without miscibility.");
         }
-        std::vector<int> seq(grid_.number_of_cells);
-        std::vector<int> comp(grid_.number_of_cells + 1);
-        int ncomp;
-        compute_sequence_graph(&grid_, darcyflux_,
-                               &seq[0], &comp[0], &ncomp,
-                               &ia_upw_[0], &ja_upw_[0]);
-        const int nf = grid_.number_of_faces;
-        std::vector<double> neg_darcyflux(nf);
-        std::transform(darcyflux, darcyflux + nf, neg_darcyflux.begin(), std::negate<double>());
-        compute_sequence_graph(&grid_, &neg_darcyflux[0],
-                               &seq[0], &comp[0], &ncomp,
-                               &ia_downw_[0], &ja_downw_[0]);
         reorderAndTransport(grid_, darcyflux);
         toBothSat(saturation_, saturation);
 
@@ -978,6 +963,14 @@ namespace Opm
     }
 
 
+
+    bool TransportSolverTwophaseCompressiblePolymer::supportsConcurrentSolves() const
+    {
+        // Only the cell itself is updated, from its upwind neighbours.
+        return true;
+    }
+
+
     void TransportSolverTwophaseCompressiblePolymer::solveMultiCell(const int num_cells, const int* cells)
     {
         double max_s_change = 0.0;
@@ -1306,31 +1299,19 @@ namespace Opm
         mobility(saturation_[cell], concentration_[cell], cell, &mob_[2*cell]);
     }
 
-    int TransportSolverTwophaseCompressiblePolymer::solveGravityColumn(const std::vector<int>& cells)
+    int TransportSolverTwophaseCompressiblePolymer::solveGravityColumn(const std::vector<int>& cells,
+                                                                       GravityColumnWorkspace& workspace)
     {
         // Set up column gravflux.
         const int nc = cells.size();
-        std::vector<double> col_gravflux(nc - 1);
-        for (int ci = 0; ci < nc - 1; ++ci) {
-            const int cell = cells[ci];
-            const int next_cell = cells[ci + 1];
-            for (int j = grid_.cell_facepos[cell]; j < grid_.cell_facepos[cell+1]; ++j) {
-                const int face = grid_.cell_faces[j];
-                const int c1 = grid_.face_cells[2*face + 0];
-                const int c2 = grid_.face_cells[2*face + 1];
-                if (c1 == next_cell || c2 == next_cell) {
-                    const double gf = gravflux_[face];
-                    col_gravflux[ci] = (c1 == cell) ? gf : -gf;
-                }
-            }
-        }
+        extractColumnGravityFlux(grid_, gravflux_.data(), cells, workspace.gravflux);
 
         // Store initial saturation s0
-        s0_.resize(nc);
-        c0_.resize(nc);
+        workspace.s0.resize(nc);
+        workspace.c0.resize(nc);
         for (int ci = 0; ci < nc; ++ci) {
-            s0_[ci] = saturation_[cells[ci]];
-            c0_[ci] = concentration_[cells[ci]];
+            workspace.s0[ci] = saturation_[cells[ci]];
+            workspace.c0[ci] = concentration_[cells[ci]];
         }
 
         // Solve single cell problems, repeating if necessary.
@@ -1344,12 +1325,12 @@ namespace Opm
                                     saturation_[cells[ci2]] };
                 double old_c[2] = { concentration_[cells[ci]],
                                     concentration_[cells[ci2]] };
-                saturation_[cells[ci]] = s0_[ci];
-                concentration_[cells[ci]] = c0_[ci];
-                solveSingleCellGravity(cells, ci, &col_gravflux[0]);
-                saturation_[cells[ci2]] = s0_[ci2];
-                concentration_[cells[ci2]] = c0_[ci2];
-                solveSingleCellGravity(cells, ci2, &col_gravflux[0]);
+                saturation_[cells[ci]] = workspace.s0[ci];
+                concentration_[cells[ci]] = workspace.c0[ci];
+                solveSingleCellGravity(cells, ci, workspace.gravflux.data());
+                saturation_[cells[ci2]] = workspace.s0[ci2];
+                concentration_[cells[ci2]] = workspace.c0[ci2];
+                solveSingleCellGravity(cells, ci2, workspace.gravflux.data());
                 max_sc_change = std::max(max_sc_change, 0.25*(std::fabs(saturation_[cells[ci]] - old_s[0]) +
                                                               std::fabs(concentration_[cells[ci]] - old_c[0]) +
                                                               std::fabs(saturation_[cells[ci2]] - old_s[1]) +
@@ -1396,13 +1377,12 @@ namespace Opm
         }
 
 
-        // Solve on all columns.
-        int num_iters = 0;
-        // std::cout << "Gauss-Seidel column solver # columns: " << columns.size() << std::endl;
-        for (std::vector<std::vector<int> >::size_type i = 0; i < columns.size(); i++) {
-            // std::cout << "==== new column" << std::endl;
-            num_iters += solveGravityColumn(columns[i]);
-        }
+        // Solve on all columns. They are independent, so they are solved
+        // concurrently, each thread with its own workspace.
+        const int num_iters = solveColumnsConcurrently<GravityColumnWorkspace>(columns,
+            [this](const std::vector<int>& column, GravityColumnWorkspace& workspace) {
+                return solveGravityColumn(column, workspace);
+            });
         std::cout << "Gauss-Seidel column solver average iterations: "
                   << double(num_iters)/double(columns.size()) << std::endl;
 
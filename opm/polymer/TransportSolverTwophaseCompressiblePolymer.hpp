@@ -36,6 +36,7 @@ namespace {
 namespace Opm
 {
 
+    struct GravityColumnWorkspace;
     class BlackoilPropertiesInterface;
 
     /// Implements a reordering transport solver for incompressible two-phase flow
@@ -164,16 +165,6 @@ namespace Opm
         std::vector<double> gravflux_;
         std::vector<double> mob_;
         std::vector<double> cmax0_;
-
-        // For gravity segregation, column variables
-        std::vector<double> s0_;
-        std::vector<double> c0_;
-
-        // Storing the upwind and downwind graphs for experiments.
-        std::vector<int> ia_upw_;
-        std::vector<int> ja_upw_;
-        std::vector<int> ia_downw_;
-        std::vector<int> ja_downw_;
         
 	struct ResidualC;
 	struct ResidualS;
@@ -192,13 +183,15 @@ namespace Opm
 
 	virtual void solveSingleCell(const int cell);
 	virtual void solveMultiCell(const int num_cells, const int* cells);
+	virtual bool supportsConcurrentSolves() const;
 	void solveSingleCellBracketing(int cell);
 	void solveSingleCellNewton(int cell, bool use_sc, bool use_explicit_step = false);
 	void solveSingleCellGradient(int cell);
         void solveSingleCellGravity(const std::vector<int>& cells,
                                     const int pos,
                                     const double* gravflux);
-        int solveGravityColumn(const std::vector<int>& cells);
+        int solveGravityColumn(const std::vector<int>& cells,
+                               GravityColumnWorkspace& workspace);
 
         void initGravityDynamic();
 
@@ -31,6 +31,7 @@ struct UnstructuredGrid;
 namespace Opm
 {
 
+    struct GravityColumnWorkspace;
     class IncompPropertiesInterface;
 
     /// Implements a reordering transport solver for incompressible two-phase flow
@@ -107,6 +108,7 @@ namespace Opm
     public: // But should be made private...
 	virtual void solveSingleCell(const int cell);
 	virtual void solveMultiCell(const int num_cells, const int* cells);
+	virtual bool supportsConcurrentSolves() const;
 	void solveSingleCellBracketing(int cell);
 	void solveSingleCellNewton(int cell);
 	void solveSingleCellGradient(int cell);
@@ -117,7 +119,8 @@ namespace Opm
         void solveSingleCellGravity(const std::vector<int>& cells,
                                     const int pos,
                                     const double* gravflux);
-        int solveGravityColumn(const std::vector<int>& cells);
+        int solveGravityColumn(const std::vector<int>& cells,
+                               GravityColumnWorkspace& workspace);
         void scToc(const double* x, double* x_c) const;
 
         #ifdef PROFILING
@@ -168,9 +171,6 @@ namespace Opm
         std::vector<double> gravflux_;
         std::vector<double> mob_;
         std::vector<double> cmax0_;
-        // For gravity segregation, column variables
-        std::vector<double> s0_;
-        std::vector<double> c0_;
 
 	struct ResidualC;
 	struct ResidualS;
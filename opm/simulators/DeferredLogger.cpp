@@ -0,0 +1,116 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include <opm/simulators/DeferredLogger.hpp>
+
+#include <opm/common/OpmLog/OpmLog.hpp>
+
+#include <cstring>
+#include <numeric>
+
+namespace Opm
+{
+
+bool DeferredLogger::debugEnabled()
+{
+    // see the setup of the backends in FlowMainEbos
+    return OpmLog::hasBackend("DEBUGLOG");
+}
+
+void DeferredLogger::log(const std::int64_t flag, const std::string& text)
+{
+#if HAVE_OPENMP
+#pragma omp critical(DeferredLogger_messages)
+#endif // HAVE_OPENMP
+    messages_.push_back(Message{ flag, text });
+}
+
+void DeferredLogger::logLocal(const std::vector<Message>& messages)
+{
+    for (const auto& message : messages) {
+        OpmLog::addMessage(message.flag, message.text);
+    }
+}
+
+#if HAVE_MPI
+std::vector<DeferredLogger::Message> DeferredLogger::gatherMessages() const
+{
+    // Each message is sent as its flag, the length of its text and the text.
+    std::vector<char> buffer;
+    for (const auto& message : messages_) {
+        const std::int64_t length = message.text.size();
+        const std::size_t offset = buffer.size();
+        buffer.resize(offset + 2 * sizeof(std::int64_t) + length);
+        std::memcpy(buffer.data() + offset, &message.flag, sizeof(std::int64_t));
+        std::memcpy(buffer.data() + offset + sizeof(std::int64_t), &length, sizeof(std::int64_t));
+        std::memcpy(buffer.data() + offset + 2 * sizeof(std::int64_t), message.text.data(), length);
+    }
+
+    const MPI_Comm comm = cc_;
+    int size = buffer.size();
+    std::vector<int> sizes(cc_.size());
+    MPI_Gather(&size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, comm);
+
+    std::vector<int> displ(cc_.size() + 1, 0);
+    std::partial_sum(sizes.begin(), sizes.end(), displ.begin() + 1);
+    std::vector<char> recv_buffer(cc_.rank() == 0 ? displ[cc_.size()] : 0);
+    MPI_Gatherv(buffer.data(), size, MPI_CHAR, recv_buffer.data(), sizes.data(),
+                displ.data(), MPI_CHAR, 0, comm);
+
+    std::vector<Message> messages;
+    std::size_t offset = 0;
+    while (offset < recv_buffer.size()) {
+        Message message;
+        std::int64_t length = 0;
+        std::memcpy(&message.flag, recv_buffer.data() + offset, sizeof(std::int64_t));
+        std::memcpy(&length, recv_buffer.data() + offset + sizeof(std::int64_t), sizeof(std::int64_t));
+        offset += 2 * sizeof(std::int64_t);
+        message.text.assign(recv_buffer.data() + offset, length);
+        offset += length;
+        messages.push_back(message);
+    }
+    return messages;
+}
+#endif // HAVE_MPI
+
+void DeferredLogger::logMessages()
+{
+#if HAVE_MPI
+    if (cc_.size() > 1) {
+        // Usually no process has messages, and then the gathers are skipped.
+        const int any = messages_.empty() ? 0 : 1;
+        if (cc_.max(any) > 0) {
+            const std::vector<Message> messages = gatherMessages();
+            if (cc_.rank() == 0) {
+                logLocal(messages);
+            }
+        }
+        messages_.clear();
+        return;
+    }
+#endif // HAVE_MPI
+    logLocal(messages_);
+    messages_.clear();
+}
+
+} // end namespace Opm
@@ -0,0 +1,123 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_DEFERREDLOGGER_HEADER_INCLUDED
+#define OPM_DEFERREDLOGGER_HEADER_INCLUDED
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <opm/common/OpmLog/LogUtil.hpp>
+
+namespace Opm
+{
+
+/// \brief Collects the log messages of a process until logMessages() is
+///        called, e.g. at the end of a time step.
+///
+/// In parallel, logMessages() gathers the messages of all processes and the
+/// first process logs them with OpmLog in the order of the ranks. If no process
+/// has a message this only costs one reduction of a single integer.
+///
+/// The lazy variants take a function that builds the message, which is only
+/// called if a backend of OpmLog would write the message, such that hot paths
+/// do not format messages that are discarded.
+class DeferredLogger
+{
+public:
+    /// \brief The type of the collective communication used.
+    typedef Dune::CollectiveCommunication<typename Dune::MPIHelper::MPICommunicator>
+    Communication;
+
+    /// \brief A message and its type, one of Log::MessageType.
+    struct Message
+    {
+        std::int64_t flag;
+        std::string text;
+    };
+
+    explicit DeferredLogger(const Communication& cc =
+                            Dune::MPIHelper::getCollectiveCommunication())
+        : cc_(cc)
+    {}
+
+    /// \brief Whether debug messages are written, which is only done by the
+    ///        debug log file of the simulator.
+    static bool debugEnabled();
+
+    /// \brief Keep a message until logMessages().
+    ///
+    /// May be called concurrently from several threads.
+    void log(std::int64_t flag, const std::string& text);
+
+    void debug(const std::string& text)
+    { log(Log::MessageType::Debug, text); }
+
+    void info(const std::string& text)
+    { log(Log::MessageType::Info, text); }
+
+    void note(const std::string& text)
+    { log(Log::MessageType::Note, text); }
+
+    void warning(const std::string& text)
+    { log(Log::MessageType::Warning, text); }
+
+    void problem(const std::string& text)
+    { log(Log::MessageType::Problem, text); }
+
+    void error(const std::string& text)
+    { log(Log::MessageType::Error, text); }
+
+    /// \brief Keep the debug message returned by makeMessage(), which is only
+    ///        called if debug messages are written.
+    template <class MakeMessage>
+    void lazyDebug(const MakeMessage& makeMessage)
+    {
+        if (debugEnabled()) {
+            debug(makeMessage());
+        }
+    }
+
+    /// \brief Log the messages of all processes on the first process and
+    ///        forget them. Collective.
+    void logMessages();
+
+    /// \brief The messages of this process kept so far.
+    const std::vector<Message>& messages() const
+    { return messages_; }
+
+private:
+    // log the messages of one process
+    static void logLocal(const std::vector<Message>& messages);
+
+#if HAVE_MPI
+    // the messages of all processes on the first process
+    std::vector<Message> gatherMessages() const;
+#endif // HAVE_MPI
+
+    std::vector<Message> messages_;
+    Communication cc_;
+};
+
+} // end namespace Opm
+
+#endif // OPM_DEFERREDLOGGER_HEADER_INCLUDED
@@ -0,0 +1,248 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include <opm/simulators/KernelCounters.hpp>
+
+#include <opm/common/ErrorMacros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Opm
+{
+
+namespace
+{
+
+const int numCounts = 5; // calls, seconds, cycles, instructions, cache misses
+
+// the size of a cache line, to estimate the bytes moved from memory
+const double cacheLineBytes = 64.0;
+
+struct CounterData
+{
+    std::mutex mutex;
+    std::array<std::array<double, numCounts>, KernelCounters::NumKernels> counts;
+    std::string filename;
+    bool hardware = true;
+};
+
+CounterData& counterData()
+{
+    static CounterData data;
+    return data;
+}
+
+#if defined(__linux__)
+// The counters of one thread, as a group that is read by a single system call.
+class ThreadCounters
+{
+public:
+    ThreadCounters()
+    {
+        const std::uint64_t configs[3] = { PERF_COUNT_HW_CPU_CYCLES,
+                                           PERF_COUNT_HW_INSTRUCTIONS,
+                                           PERF_COUNT_HW_CACHE_MISSES };
+        for (int i = 0; i < 3; ++i) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[i];
+            attr.read_format = PERF_FORMAT_GROUP;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd_[i] = syscall(__NR_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fd_[0], 0);
+            if (fd_[i] < 0) {
+                close_();
+                return;
+            }
+        }
+    }
+
+    ~ThreadCounters()
+    {
+        close_();
+    }
+
+    bool valid() const
+    { return fd_[0] >= 0; }
+
+    void read(KernelCounters::Sample& sample) const
+    {
+        // the number of counters followed by their values
+        std::uint64_t values[4];
+        if (valid() && ::read(fd_[0], values, sizeof(values)) == sizeof(values)) {
+            sample.cycles = values[1];
+            sample.instructions = values[2];
+            sample.cacheMisses = values[3];
+        }
+    }
+
+private:
+    void close_()
+    {
+        for (int& fd : fd_) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            fd = -1;
+        }
+    }
+
+    int fd_[3] = { -1, -1, -1 };
+};
+
+const ThreadCounters& threadCounters()
+{
+    thread_local const ThreadCounters counters;
+    return counters;
+}
+#endif
+
+} // anonymous namespace
+
+std::atomic<bool> KernelCounters::active_(false);
+
+void KernelCounters::start(const std::string& filename, const Communication& cc)
+{
+    CounterData& data = counterData();
+    {
+        std::lock_guard<std::mutex> lock(data.mutex);
+        for (auto& counts : data.counts) {
+            counts.fill(0.0);
+        }
+        data.filename = filename;
+        data.hardware = hardwareCounters();
+    }
+    data.hardware = cc.min(int(data.hardware)) > 0;
+
+    if (cc.rank() == 0) {
+        std::ofstream out(filename);
+        if (!out) {
+            OPM_THROW(std::runtime_error, "Could not open the kernel counter file " << filename);
+        }
+        out << "report_step,kernel,calls,seconds,cycles,instructions,llc_misses,llc_bytes\n";
+    }
+    active_ = true;
+}
+
+void KernelCounters::stop()
+{
+    active_ = false;
+    CounterData& data = counterData();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    for (auto& counts : data.counts) {
+        counts.fill(0.0);
+    }
+}
+
+bool KernelCounters::hardwareCounters()
+{
+#if defined(__linux__)
+    return threadCounters().valid();
+#else
+    return false;
+#endif
+}
+
+KernelCounters::Sample KernelCounters::read()
+{
+    Sample sample;
+    const auto time = std::chrono::steady_clock::now().time_since_epoch();
+    sample.seconds = std::chrono::duration<double>(time).count();
+#if defined(__linux__)
+    threadCounters().read(sample);
+#endif
+    return sample;
+}
+
+void KernelCounters::record(const Kernel kernel, const Sample& begin, const Sample& end)
+{
+    CounterData& data = counterData();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    auto& counts = data.counts[kernel];
+    counts[0] += 1.0;
+    counts[1] += end.seconds - begin.seconds;
+    counts[2] += double(end.cycles - begin.cycles);
+    counts[3] += double(end.instructions - begin.instructions);
+    counts[4] += double(end.cacheMisses - begin.cacheMisses);
+}
+
+void KernelCounters::endReportStep(const int reportStep, const Communication& cc)
+{
+    if (!active()) {
+        return;
+    }
+
+    CounterData& data = counterData();
+    std::array<double, numCounts * NumKernels> counts;
+    {
+        std::lock_guard<std::mutex> lock(data.mutex);
+        for (int k = 0; k < NumKernels; ++k) {
+            std::copy(data.counts[k].begin(), data.counts[k].end(), counts.begin() + k * numCounts);
+            data.counts[k].fill(0.0);
+        }
+    }
+    cc.sum(counts.data(), counts.size());
+
+    if (cc.rank() == 0) {
+        std::ofstream out(data.filename, std::ios::app);
+        out.precision(15);
+        for (int k = 0; k < NumKernels; ++k) {
+            const double* c = counts.data() + k * numCounts;
+            out << reportStep << ',' << name(Kernel(k)) << ',' << c[0] << ',' << c[1];
+            if (data.hardware) {
+                out << ',' << c[2] << ',' << c[3] << ',' << c[4] << ',' << c[4] * cacheLineBytes;
+            }
+            else {
+                out << ",,,,";
+            }
+            out << '\n';
+        }
+    }
+}
+
+const char* KernelCounters::name(const Kernel kernel)
+{
+    switch (kernel) {
+    case IluApply: return "ilu_apply";
+    case WellMatrixApply: return "well_matrix_apply";
+    case WellAssemble: return "well_assemble";
+    case UpdateState: return "update_state";
+    case GetConvergence: return "get_convergence";
+    case VfpInterpolation: return "vfp_interpolation";
+    default: return "unknown";
+    }
+}
+
+} // namespace Opm
@@ -0,0 +1,109 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_KERNELCOUNTERS_HEADER_INCLUDED
+#define OPM_KERNELCOUNTERS_HEADER_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+namespace Opm
+{
+
+/// \brief Hardware counters of the main kernels of the simulator.
+///
+/// The counters are global to the process and off unless start() is called.
+/// When on, the cycles, instructions and last level cache misses of the calling
+/// thread are read from the Linux perf_event interface at the begin and end of
+/// each kernel, together with the wall time. On other systems, or if the kernel
+/// does not permit the counters, only the calls and the time are recorded. The
+/// kernels are counted by ProfileScope.
+///
+/// The counts of nested kernels are inclusive, e.g. the VFP interpolation is
+/// also part of the well assembly. endReportStep() sums the counts of all
+/// processes and appends one line per kernel to a CSV file, with the report step
+/// in the first column to join the lines with the SimulatorReport of the step.
+class KernelCounters
+{
+public:
+    /// \brief The type of the collective communication used.
+    typedef Dune::CollectiveCommunication<typename Dune::MPIHelper::MPICommunicator>
+    Communication;
+
+    /// \brief The instrumented kernels.
+    enum Kernel {
+        IluApply,
+        WellMatrixApply,
+        WellAssemble,
+        UpdateState,
+        GetConvergence,
+        VfpInterpolation,
+        NumKernels
+    };
+
+    /// \brief The counts of the calling thread.
+    struct Sample
+    {
+        double seconds = 0.0;
+        std::uint64_t cycles = 0;
+        std::uint64_t instructions = 0;
+        std::uint64_t cacheMisses = 0;
+    };
+
+    /// \brief Start counting and write the header of the CSV file.
+    /// \param filename  the file written by the first process
+    /// \param cc        the communication
+    static void start(const std::string& filename,
+                      const Communication& cc = Dune::MPIHelper::getCollectiveCommunication());
+
+    /// \brief Stop counting and discard the counts of the current report step,
+    ///        which are not written to the file.
+    static void stop();
+
+    /// \brief Whether the kernels are currently counted.
+    static bool active()
+    { return active_.load(std::memory_order_relaxed); }
+
+    /// \brief Whether the hardware counters could be opened for the calling thread.
+    static bool hardwareCounters();
+
+    /// \brief Read the counters of the calling thread.
+    static Sample read();
+
+    /// \brief Add the difference of two samples to the counts of a kernel.
+    static void record(Kernel kernel, const Sample& begin, const Sample& end);
+
+    /// \brief Collectively append the counts of the report step to the file and
+    ///        reset them.
+    static void endReportStep(int reportStep,
+                              const Communication& cc = Dune::MPIHelper::getCollectiveCommunication());
+
+    /// \brief The name of a kernel in the CSV file.
+    static const char* name(Kernel kernel);
+
+private:
+    static std::atomic<bool> active_;
+};
+
+} // namespace Opm
+
+#endif // OPM_KERNELCOUNTERS_HEADER_INCLUDED
@@ -0,0 +1,165 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include <opm/simulators/MemoryAccounting.hpp>
+
+#include <opm/common/OpmLog/OpmLog.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace Opm
+{
+
+namespace
+{
+
+struct AccountingData
+{
+    std::atomic<std::size_t> current[MemoryAccounting::NumSubsystems] = {};
+    std::atomic<std::size_t> peak[MemoryAccounting::NumSubsystems] = {};
+    std::atomic<std::size_t> total{0};
+    std::atomic<std::size_t> peakTotal{0};
+};
+
+AccountingData& accountingData()
+{
+    static AccountingData data;
+    return data;
+}
+
+void updatePeak(std::atomic<std::size_t>& peak, const std::size_t value)
+{
+    std::size_t old = peak.load();
+    while (value > old && !peak.compare_exchange_weak(old, value)) {
+    }
+}
+
+// a value in kB of /proc/self/status, zero if not available
+std::size_t procStatusBytes(const std::string& key)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, key.size(), key) == 0) {
+            std::istringstream value(line.substr(key.size()));
+            std::size_t kB = 0;
+            value >> kB;
+            return kB * 1024;
+        }
+    }
+    return 0;
+}
+
+} // anonymous namespace
+
+void MemoryAccounting::Account::set(const std::size_t bytes)
+{
+    if (bytes == bytes_) {
+        return;
+    }
+    AccountingData& data = accountingData();
+    const std::size_t current = (data.current[subsystem_] += bytes - bytes_);
+    const std::size_t total = (data.total += bytes - bytes_);
+    bytes_ = bytes;
+    updatePeak(data.peak[subsystem_], current);
+    updatePeak(data.peakTotal, total);
+}
+
+std::size_t MemoryAccounting::current(const Subsystem subsystem)
+{
+    return accountingData().current[subsystem];
+}
+
+std::size_t MemoryAccounting::peak(const Subsystem subsystem)
+{
+    return accountingData().peak[subsystem];
+}
+
+std::size_t MemoryAccounting::peakTotal()
+{
+    return accountingData().peakTotal;
+}
+
+std::size_t MemoryAccounting::residentBytes()
+{
+    return procStatusBytes("VmRSS:");
+}
+
+std::size_t MemoryAccounting::peakResidentBytes()
+{
+    return procStatusBytes("VmHWM:");
+}
+
+const char* MemoryAccounting::name(const Subsystem subsystem)
+{
+    switch (subsystem) {
+    case Matrix: return "Matrix";
+    case Preconditioner: return "Precond.";
+    case AmgLevels: return "AMGLevels";
+    case Krylov: return "Krylov";
+    case WellState: return "WellState";
+    case WellMatrices: return "WellMat.";
+    default: return "unknown";
+    }
+}
+
+void MemoryAccounting::report(const std::string& title, const bool atPeak, const Communication& cc)
+{
+    // the subsystems, their total and the resident set size in MB
+    const int numValues = NumSubsystems + 2;
+    std::vector<double> local(numValues);
+    double total = 0.0;
+    for (int s = 0; s < NumSubsystems; ++s) {
+        local[s] = (atPeak ? peak(Subsystem(s)) : current(Subsystem(s))) / 1048576.0;
+        total += local[s];
+    }
+    local[NumSubsystems] = atPeak ? peakTotal() / 1048576.0 : total;
+    local[NumSubsystems + 1] = (atPeak ? peakResidentBytes() : residentBytes()) / 1048576.0;
+
+    std::vector<double> all(cc.rank() == 0 ? numValues * cc.size() : 0);
+    cc.gather(local.data(), all.data(), numValues, 0);
+    if (cc.rank() != 0) {
+        return;
+    }
+
+    std::ostringstream table;
+    table << title << " [MB]\n" << std::setw(6) << "Rank";
+    for (int s = 0; s < NumSubsystems; ++s) {
+        table << std::setw(11) << name(Subsystem(s));
+    }
+    table << std::setw(11) << "Total" << std::setw(11) << "RSS" << '\n';
+    table << std::fixed << std::setprecision(1);
+    for (int rank = 0; rank < cc.size(); ++rank) {
+        table << std::setw(6) << rank;
+        for (int k = 0; k < numValues; ++k) {
+            table << std::setw(11) << all[rank * numValues + k];
+        }
+        table << '\n';
+    }
+    OpmLog::info(table.str());
+}
+
+} // namespace Opm
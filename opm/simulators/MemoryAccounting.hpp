@@ -0,0 +1,143 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_MEMORYACCOUNTING_HEADER_INCLUDED
+#define OPM_MEMORYACCOUNTING_HEADER_INCLUDED
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+namespace Opm
+{
+
+/// \brief The bytes held by the subsystems of the simulator on this process.
+///
+/// Each subsystem keeps an Account of the bytes of its large arrays, which it
+/// updates when they are resized, e.g. after the setup of a preconditioner.
+/// The registry sums the accounts of a subsystem and keeps the peak of the sum,
+/// and the peak of the total of all subsystems. Updating an account is a few
+/// atomic operations, hence it is always on.
+///
+/// report() gathers the current bytes of all processes and prints one line per
+/// process, together with the resident set size of the process and its peak.
+class MemoryAccounting
+{
+public:
+    /// \brief The type of the collective communication used.
+    typedef Dune::CollectiveCommunication<typename Dune::MPIHelper::MPICommunicator>
+    Communication;
+
+    /// \brief The accounted subsystems.
+    ///
+    /// AmgLevels holds the quasi-IMPES scaled matrix and the first coarse
+    /// (pressure) level of the CPR preconditioner BlackoilAmg, the smoothers of
+    /// all levels are accounted as Preconditioner. The further levels that the
+    /// AMG of the coarse solver builds inside dune-istl are not accessible and
+    /// are only visible in the resident set size.
+    enum Subsystem {
+        Matrix,
+        Preconditioner,
+        AmgLevels,
+        Krylov,
+        WellState,
+        WellMatrices,
+        NumSubsystems
+    };
+
+    /// \brief The bytes currently held by a subsystem.
+    static std::size_t current(Subsystem subsystem);
+
+    /// \brief The largest number of bytes held by a subsystem so far.
+    static std::size_t peak(Subsystem subsystem);
+
+    /// \brief The largest number of bytes held by all subsystems together so far.
+    static std::size_t peakTotal();
+
+    /// \brief The resident set size of the process and its peak in bytes,
+    ///        zero if unknown.
+    static std::size_t residentBytes();
+    static std::size_t peakResidentBytes();
+
+    /// \brief The name of a subsystem.
+    static const char* name(Subsystem subsystem);
+
+    /// \brief Collectively log the bytes of all processes, by the first process.
+    /// \param title   the first line of the table, e.g. the report step
+    /// \param atPeak  log the peaks instead of the current bytes
+    static void report(const std::string& title, bool atPeak,
+                       const Communication& cc = Dune::MPIHelper::getCollectiveCommunication());
+
+    /// \brief The bytes of an object of a subsystem, removed from the
+    ///        subsystem when the account is destroyed.
+    class Account
+    {
+    public:
+        explicit Account(Subsystem subsystem)
+            : subsystem_(subsystem), bytes_(0)
+        {}
+
+        ~Account()
+        { set(0); }
+
+        /// \brief A copy accounts the bytes of the copied object again.
+        Account(const Account& other)
+            : subsystem_(other.subsystem_), bytes_(0)
+        { set(other.bytes_); }
+
+        Account& operator=(const Account& other)
+        {
+            set(0);
+            subsystem_ = other.subsystem_;
+            set(other.bytes_);
+            return *this;
+        }
+
+        /// \brief Set the bytes held by the object.
+        void set(std::size_t bytes);
+
+        /// \brief The bytes held by the object.
+        std::size_t bytes() const
+        { return bytes_; }
+
+    private:
+        Subsystem subsystem_;
+        std::size_t bytes_;
+    };
+
+    /// \brief The bytes of the elements of a vector, including its spare capacity.
+    template <class T>
+    static std::size_t bytes(const std::vector<T>& v)
+    { return v.capacity() * sizeof(T); }
+
+    /// \brief The bytes of the blocks, column indices and rows of a
+    ///        Dune::BCRSMatrix.
+    template <class M>
+    static std::size_t matrixBytes(const M& m)
+    {
+        return m.nonzeroes() * (sizeof(typename M::block_type) + sizeof(typename M::size_type))
+            + m.N() * sizeof(typename M::row_type);
+    }
+};
+
+} // namespace Opm
+
+#endif // OPM_MEMORYACCOUNTING_HEADER_INCLUDED
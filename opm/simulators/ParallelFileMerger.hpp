@@ -24,6 +24,13 @@
 #include <memory>
 #include <iostream>
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <boost/regex.hpp>
@@ -52,13 +59,13 @@ public:
         : debugFileRegex_(deckname+"\\.\\d+\\.DBG"),
           logFileRegex_(deckname+"\\.\\d+\\.PRT")
     {
-        auto debugPath = output_dir;
-        debugPath /= (deckname + ".DBG");
-        debugStream_.reset(new fs::ofstream(debugPath,
+        debugPath_ = output_dir;
+        debugPath_ /= (deckname + ".DBG");
+        debugStream_.reset(new fs::ofstream(debugPath_,
                                             std::ofstream::app));
-        auto logPath = output_dir;
-        logPath /= ( deckname + ".PRT");
-        logStream_.reset(new fs::ofstream(logPath,
+        logPath_ = output_dir;
+        logPath_ /= ( deckname + ".PRT");
+        logStream_.reset(new fs::ofstream(logPath_,
                                           std::ofstream::app));
     }
 
@@ -74,13 +81,13 @@ public:
 
             if( boost::regex_match(filename, logFileRegex_) )
             {
-                appendFile(*logStream_, file, rank);
+                appendFile(*logStream_, logPath_, file, rank);
             }
             else
             {
                 if (boost::regex_match(filename, debugFileRegex_)  )
                 {
-                    appendFile(*debugStream_, file, rank);
+                    appendFile(*debugStream_, debugPath_, file, rank);
                 }
                 else
                 {
@@ -95,9 +102,11 @@ public:
 private:
     /// \brief Append contents of a file to a stream
     /// \brief of The output stream to use.
+    /// \brief ofPath The path of the file of the output stream.
     /// \brief file The file whose content to append.
     /// \brief rank The rank that wrote the file.
-    void appendFile(fs::ofstream& of, const fs::path& file, const std::string& rank)
+    void appendFile(fs::ofstream& of, const fs::path& ofPath,
+                    const fs::path& file, const std::string& rank)
     {
         if( fs::file_size(file) )
         {
@@ -105,20 +114,82 @@ private:
                       << file.string() <<" by process "
                       << rank << std::endl;
 
-            fs::ifstream in(file);
             of<<std::endl<< std::endl;
             of<<"=======================================================";
             of<<std::endl<<std::endl;
             of << " Output written by rank " << rank << " to file " << file.string();
             of << ":" << std::endl << std::endl;
-            of << in.rdbuf() << std::endl << std::endl;
+            // the data copied in the kernel has to follow the header
+            of.flush();
+            if( ! copyFileContents(ofPath, file) )
+            {
+                fs::ifstream in(file);
+                of << in.rdbuf();
+                in.close();
+            }
+            of << std::endl << std::endl;
             of << "======================== end output =====================";
             of << std::endl;
-            in.close();
         }
         fs::remove(file);
     }
 
+    /// \brief Append the contents of a file to another one in the kernel.
+    ///
+    /// The stream of the target file has to be flushed before, it is opened
+    /// in append mode such that its position follows the copied data. The
+    /// target is not opened with O_APPEND here, since sendfile() fails with
+    /// EINVAL for such a file, but the data is written at its end.
+    /// \return false if the data could not be copied this way.
+    bool copyFileContents(const fs::path& target, const fs::path& source) const
+    {
+#ifdef __linux__
+        const int in = ::open(source.c_str(), O_RDONLY);
+        if( in < 0 )
+        {
+            return false;
+        }
+        const int out = ::open(target.c_str(), O_WRONLY);
+        if( out < 0 )
+        {
+            ::close(in);
+            return false;
+        }
+        if( ::lseek(out, 0, SEEK_END) < 0 )
+        {
+            ::close(out);
+            ::close(in);
+            return false;
+        }
+        struct stat status;
+        bool success = ( ::fstat(in, &status) == 0 );
+        off_t offset = 0;
+        while( success && offset < status.st_size )
+        {
+            const ssize_t copied = ::sendfile(out, in, &offset, status.st_size - offset);
+            // nothing has been copied yet if sendfile fails at once, then the
+            // stream based copy can be used instead
+            if( copied <= 0 )
+            {
+                success = false;
+            }
+        }
+        ::close(out);
+        ::close(in);
+        if( ! success && offset > 0 )
+        {
+            std::cerr << "WARNING: Merging " << source.string() << " stopped after "
+                      << offset << " bytes" << std::endl;
+            return true;
+        }
+        return success;
+#else
+        static_cast<void>(target);
+        static_cast<void>(source);
+        return false;
+#endif
+    }
+
     /// \brief Regex to capture *.DBG
     boost::regex debugFileRegex_;
     /// \brief Regex to capture  *.PRT
@@ -127,6 +198,10 @@ private:
     std::unique_ptr<fs::ofstream> debugStream_;
     /// \brief Stream to *.PRT file
     std::unique_ptr<fs::ofstream> logStream_;
+    /// \brief Path of the *.DBG file
+    fs::path debugPath_;
+    /// \brief Path of the *.PRT file
+    fs::path logPath_;
 };
 } // end namespace detail
 } // end namespace OPM
@@ -0,0 +1,211 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include <opm/simulators/PerformanceTrace.hpp>
+
+#include <opm/common/ErrorMacros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace Opm
+{
+
+namespace
+{
+
+struct Event
+{
+    const char* name;
+    double begin;
+    double duration;
+    int thread;
+    char phase;
+};
+
+struct TraceData
+{
+    std::mutex mutex;
+    std::vector<Event> events;
+    std::size_t capacity = 0;
+    std::size_t next = 0;
+    int sampleInterval = 1;
+    std::chrono::steady_clock::time_point startTime;
+    std::atomic<int> numThreads{0};
+};
+
+TraceData& traceData()
+{
+    static TraceData data;
+    return data;
+}
+
+// a small index per thread, in the order the threads record their first event
+int threadIndex()
+{
+    thread_local const int index = traceData().numThreads++;
+    return index;
+}
+
+void record(const Event& event)
+{
+    TraceData& data = traceData();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    if (data.events.size() < data.capacity) {
+        data.events.push_back(event);
+    }
+    else {
+        data.events[data.next] = event;
+        data.next = (data.next + 1) % data.capacity;
+    }
+}
+
+std::string toJson(const int rank)
+{
+    TraceData& data = traceData();
+    std::lock_guard<std::mutex> lock(data.mutex);
+
+    std::ostringstream json;
+    json.precision(15);
+    json << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+         << ",\"args\":{\"name\":\"rank " << rank << "\"}}";
+
+    // the oldest event is at next once the ring buffer is full
+    const std::size_t size = data.events.size();
+    for (std::size_t i = 0; i < size; ++i) {
+        const Event& event = data.events[(data.next + i) % size];
+        json << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"" << event.phase
+             << "\",\"ts\":" << event.begin;
+        if (event.phase == 'X') {
+            json << ",\"dur\":" << event.duration;
+        }
+        else {
+            json << ",\"s\":\"t\"";
+        }
+        json << ",\"pid\":" << rank << ",\"tid\":" << event.thread << "}";
+    }
+    return json.str();
+}
+
+} // anonymous namespace
+
+bool PerformanceTrace::enabled_ = false;
+std::atomic<bool> PerformanceTrace::active_(false);
+
+void PerformanceTrace::start(const std::size_t capacity, const int sampleInterval,
+                             const Communication& cc)
+{
+    if (capacity == 0) {
+        OPM_THROW(std::runtime_error, "The capacity of the performance trace has to be positive");
+    }
+    TraceData& data = traceData();
+    {
+        std::lock_guard<std::mutex> lock(data.mutex);
+        data.events.clear();
+        data.events.reserve(std::min(capacity, std::size_t(1 << 16)));
+        data.capacity = capacity;
+        data.next = 0;
+        data.sampleInterval = std::max(sampleInterval, 1);
+    }
+    cc.barrier();
+    data.startTime = std::chrono::steady_clock::now();
+    enabled_ = true;
+    active_ = true;
+}
+
+void PerformanceTrace::stop()
+{
+    enabled_ = false;
+    active_ = false;
+    TraceData& data = traceData();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    data.events.clear();
+    data.next = 0;
+}
+
+void PerformanceTrace::beginReportStep(const int reportStep)
+{
+    active_ = enabled_ && reportStep % traceData().sampleInterval == 0;
+}
+
+void PerformanceTrace::complete(const char* name, const double begin, const double duration)
+{
+    record(Event{ name, begin, duration, threadIndex(), 'X' });
+}
+
+void PerformanceTrace::instant(const char* name)
+{
+    if (active()) {
+        record(Event{ name, now(), 0.0, threadIndex(), 'i' });
+    }
+}
+
+double PerformanceTrace::now()
+{
+    const auto elapsed = std::chrono::steady_clock::now() - traceData().startTime;
+    return std::chrono::duration<double, std::micro>(elapsed).count();
+}
+
+std::size_t PerformanceTrace::size()
+{
+    TraceData& data = traceData();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    return data.events.size();
+}
+
+void PerformanceTrace::write(const std::string& filename, const Communication& cc)
+{
+    std::string local = toJson(cc.rank());
+    int localSize = local.size();
+
+    std::vector<int> sizes(cc.size());
+    cc.gather(&localSize, sizes.data(), 1, 0);
+    std::vector<int> displ(cc.size() + 1, 0);
+    std::partial_sum(sizes.begin(), sizes.end(), displ.begin() + 1);
+
+    std::vector<char> all(cc.rank() == 0 ? displ.back() : 0);
+    cc.gatherv(&local[0], localSize, all.data(), sizes.data(), displ.data(), 0);
+
+    if (cc.rank() == 0) {
+        std::ofstream out(filename);
+        if (!out) {
+            OPM_THROW(std::runtime_error, "Could not open the trace file " << filename);
+        }
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        for (int rank = 0; rank < cc.size(); ++rank) {
+            if (rank > 0) {
+                out << ",\n";
+            }
+            out.write(all.data() + displ[rank], sizes[rank]);
+        }
+        out << "\n]}\n";
+    }
+}
+
+} // namespace Opm
@@ -0,0 +1,93 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PERFORMANCETRACE_HEADER_INCLUDED
+#define OPM_PERFORMANCETRACE_HEADER_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+namespace Opm
+{
+
+/// \brief Records timed events of the simulator for the Chrome trace viewer.
+///
+/// The trace is global to the process and off unless start() is called, in which
+/// case the cost of an event is a clock read and a short locked store. The events
+/// are kept in a ring buffer, i.e. only the most recent ones are kept when the
+/// capacity is reached, and can be sampled by recording only every n-th report step.
+/// The names of the events are not copied and have to be string literals. The
+/// events of scopes are recorded by ProfileScope.
+///
+/// write() gathers the events of all processes and writes the trace in the JSON
+/// format of chrome://tracing, with the rank as process and one row per thread.
+class PerformanceTrace
+{
+public:
+    /// \brief The type of the collective communication used.
+    typedef Dune::CollectiveCommunication<typename Dune::MPIHelper::MPICommunicator>
+    Communication;
+
+    /// \brief Start recording.
+    /// \param capacity        the maximum number of events kept on this process
+    /// \param sampleInterval  record every sampleInterval-th report step
+    /// \param cc              the communication, the clocks of the processes
+    ///                        are aligned by a barrier
+    static void start(std::size_t capacity, int sampleInterval,
+                      const Communication& cc = Dune::MPIHelper::getCollectiveCommunication());
+
+    /// \brief Stop recording and discard the events.
+    static void stop();
+
+    /// \brief Whether events are currently recorded.
+    static bool active()
+    { return active_.load(std::memory_order_relaxed); }
+
+    /// \brief Select whether the events of the report step are recorded.
+    static void beginReportStep(int reportStep);
+
+    /// \brief Record an event of the given duration, the times are in
+    ///        microseconds since start().
+    static void complete(const char* name, double begin, double duration);
+
+    /// \brief Record an event without duration, e.g. a time step chop.
+    static void instant(const char* name);
+
+    /// \brief The time since start() in microseconds.
+    static double now();
+
+    /// \brief The number of events kept on this process.
+    static std::size_t size();
+
+    /// \brief Collectively write the events of all processes to a file,
+    ///        the file is written by the first process.
+    static void write(const std::string& filename,
+                      const Communication& cc = Dune::MPIHelper::getCollectiveCommunication());
+
+private:
+    static bool enabled_;
+    static std::atomic<bool> active_;
+};
+
+} // namespace Opm
+
+#endif // OPM_PERFORMANCETRACE_HEADER_INCLUDED
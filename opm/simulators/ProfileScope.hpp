@@ -0,0 +1,124 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PROFILESCOPE_HEADER_INCLUDED
+#define OPM_PROFILESCOPE_HEADER_INCLUDED
+
+#include <opm/simulators/KernelCounters.hpp>
+#include <opm/simulators/PerformanceTrace.hpp>
+#include <opm/simulators/TimerRegistry.hpp>
+
+#include <chrono>
+
+namespace Opm
+{
+
+/// \brief Times the lifetime of a scope with all profiling backends that are on.
+///
+/// The scope is added to the timer of its name in the TimerRegistry, nested in
+/// the enclosing scope of the thread, and recorded as an event of the
+/// PerformanceTrace. The scope of a kernel is also counted as a call of the
+/// kernel by KernelCounters. Backends that are off cost a flag check.
+///
+/// The wall time of the scope is always measured, such that it can replace a
+/// stopwatch whose time is reported, see stop().
+class ProfileScope
+{
+public:
+    /// \brief Time a scope.
+    /// \param name  the name, a string literal that must not contain '/'
+    explicit ProfileScope(const char* name)
+        : ProfileScope(name, KernelCounters::NumKernels)
+    {}
+
+    /// \brief Time a kernel, the timer and the event are named after it.
+    explicit ProfileScope(KernelCounters::Kernel kernel)
+        : ProfileScope(KernelCounters::name(kernel), kernel)
+    {}
+
+    /// \brief Time a scope and count it as a call of a kernel.
+    /// \param name    the name, a string literal that must not contain '/'
+    /// \param kernel  the kernel, KernelCounters::NumKernels for none
+    ProfileScope(const char* name, KernelCounters::Kernel kernel)
+        : name_(name),
+          node_(TimerRegistry::active() ? TimerRegistry::enter_(name) : -1),
+          traceBegin_(PerformanceTrace::active() ? PerformanceTrace::now() : -1.0),
+          kernel_(KernelCounters::active() ? kernel : KernelCounters::NumKernels),
+          begin_(std::chrono::steady_clock::now())
+    {
+        if (kernel_ != KernelCounters::NumKernels) {
+            counters_ = KernelCounters::read();
+        }
+    }
+
+    ~ProfileScope()
+    {
+        stop();
+    }
+
+    /// \brief End the scope before the end of its lifetime.
+    /// \return the wall time of the scope in seconds, also in later calls
+    double stop()
+    {
+        if (!stopped_) {
+            if (kernel_ != KernelCounters::NumKernels) {
+                KernelCounters::record(kernel_, counters_, KernelCounters::read());
+            }
+            seconds_ = elapsed();
+            stopped_ = true;
+            if (traceBegin_ >= 0.0) {
+                PerformanceTrace::complete(name_, traceBegin_, PerformanceTrace::now() - traceBegin_);
+            }
+            if (node_ >= 0) {
+                TimerRegistry::leave_(node_, seconds_);
+            }
+        }
+        return seconds_;
+    }
+
+    /// \brief The wall time since the begin of the scope in seconds, or
+    ///        of the whole scope once it is stopped.
+    double elapsed() const
+    {
+        if (stopped_) {
+            return seconds_;
+        }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin_).count();
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name_;
+    // the timer of the scope, negative if the registry is off
+    int node_;
+    // the begin of the event in the trace, negative if the trace is off
+    double traceBegin_;
+    // the counted kernel, NumKernels if none or if the counters are off
+    KernelCounters::Kernel kernel_;
+    KernelCounters::Sample counters_;
+    std::chrono::steady_clock::time_point begin_;
+    double seconds_ = 0.0;
+    bool stopped_ = false;
+};
+
+} // namespace Opm
+
+#endif // OPM_PROFILESCOPE_HEADER_INCLUDED
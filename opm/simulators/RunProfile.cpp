@@ -0,0 +1,199 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include <opm/simulators/RunProfile.hpp>
+#include <opm/simulators/TimerRegistry.hpp>
+
+#include <opm/common/ErrorMacros.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+
+namespace Opm
+{
+
+namespace
+{
+
+std::string toJson(const std::string& text)
+{
+    std::string json;
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            json += '\\';
+        }
+        json += c;
+    }
+    return json;
+}
+
+} // anonymous namespace
+
+const char* RunProfile::name(const Category category)
+{
+    static const char* names[] = {
+        "assembly",
+        "linear_solve",
+        "update",
+        "output",
+        "other"
+    };
+    return names[category];
+}
+
+void RunProfile::addReportStep(const int reportStep, const double wallTime, const double outputTime,
+                               const SimulatorReport& stepReport,
+                               const SimulatorReport& failedReport)
+{
+    Step step;
+    step.reportStep = reportStep;
+    step.wallTime = wallTime;
+    // the failed time steps are not part of the report of the step
+    step.seconds[Assembly] = stepReport.assemble_time + failedReport.assemble_time;
+    step.seconds[LinearSolve] = stepReport.linear_solve_time + failedReport.linear_solve_time;
+    step.seconds[Update] = stepReport.update_time + failedReport.update_time;
+    // including the output of the substeps
+    step.seconds[Output] = outputTime + stepReport.output_write_time;
+    // the rest, e.g. the setup of the time steps and waiting for other processes
+    const double accounted = std::accumulate(step.seconds.begin(), step.seconds.begin() + Other, 0.0);
+    step.seconds[Other] = std::max(wallTime - accounted, 0.0);
+    step.lostTime = failedReport.assemble_time + failedReport.linear_solve_time + failedReport.update_time;
+    step.lostLinearizations = failedReport.total_linearizations;
+    steps_.push_back(step);
+}
+
+RunProfile::Category RunProfile::dominant(const Step& step)
+{
+    return static_cast<Category>(std::max_element(step.seconds.begin(), step.seconds.end())
+                                 - step.seconds.begin());
+}
+
+void RunProfile::write(const std::string& filename, const std::size_t numSlowest,
+                       const Communication& cc) const
+{
+    // the steps as seen by the slowest process of each step, which all
+    // processes wait for
+    const int numSteps = steps_.size();
+    const int stride = NumCategories + 2;
+    std::vector<double> stepMax(numSteps * stride);
+    for (int i = 0; i < numSteps; ++i) {
+        const Step& step = steps_[i];
+        std::copy(step.seconds.begin(), step.seconds.end(), stepMax.begin() + i * stride);
+        stepMax[i * stride + NumCategories] = step.wallTime;
+        stepMax[i * stride + NumCategories + 1] = step.lostTime;
+    }
+
+    // the totals of this process, the categories followed by the wall and the
+    // lost time
+    std::vector<double> total(stride, 0.0);
+    double lostLinearizations = 0.0;
+    for (int i = 0; i < numSteps; ++i) {
+        for (int k = 0; k < stride; ++k) {
+            total[k] += stepMax[i * stride + k];
+        }
+        lostLinearizations += steps_[i].lostLinearizations;
+    }
+    std::vector<double> totalMin = total;
+    std::vector<double> totalMax = total;
+    std::vector<double> totalSum = total;
+    cc.min(totalMin.data(), stride);
+    cc.max(totalMax.data(), stride);
+    cc.sum(totalSum.data(), stride);
+    lostLinearizations = cc.max(lostLinearizations);
+    if (numSteps > 0) {
+        cc.max(stepMax.data(), stepMax.size());
+    }
+
+    const auto timers = TimerRegistry::statistics(cc);
+    if (cc.rank() != 0) {
+        return;
+    }
+
+    std::ofstream out(filename);
+    if (!out) {
+        OPM_THROW(std::runtime_error, "Could not open the profile file " << filename);
+    }
+    out.precision(6);
+
+    const double wallTime = totalMax[NumCategories];
+    const double averageWallTime = totalSum[NumCategories] / cc.size();
+    out << "{\"processes\":" << cc.size()
+        << ",\"report_steps\":" << numSteps
+        << ",\"wall_time\":" << wallTime;
+
+    out << ",\n\"categories\":[";
+    for (int k = 0; k < NumCategories; ++k) {
+        const double avg = totalSum[k] / cc.size();
+        out << (k > 0 ? ",\n" : "\n")
+            << "{\"name\":\"" << name(static_cast<Category>(k)) << "\""
+            << ",\"min\":" << totalMin[k] << ",\"avg\":" << avg << ",\"max\":" << totalMax[k]
+            << ",\"imbalance\":" << (avg > 0.0 ? totalMax[k] / avg : 1.0)
+            << ",\"fraction\":" << (averageWallTime > 0.0 ? avg / averageWallTime : 0.0) << "}";
+    }
+    out << "\n]";
+
+    const double lostTime = totalMax[NumCategories + 1];
+    out << ",\n\"failed_time_steps\":{\"lost_time\":" << lostTime
+        << ",\"lost_fraction\":" << (wallTime > 0.0 ? lostTime / wallTime : 0.0)
+        << ",\"lost_linearizations\":" << lostLinearizations << "}";
+
+    // the slowest report steps first
+    std::vector<int> order(numSteps);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&stepMax, stride](const int a, const int b) {
+            return stepMax[a * stride + NumCategories] > stepMax[b * stride + NumCategories];
+        });
+    order.resize(std::min(order.size(), numSlowest));
+    out << ",\n\"slowest_report_steps\":[";
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        Step step;
+        const double* values = &stepMax[order[i] * stride];
+        std::copy(values, values + NumCategories, step.seconds.begin());
+        out << (i > 0 ? ",\n" : "\n")
+            << "{\"report_step\":" << steps_[order[i]].reportStep
+            << ",\"wall_time\":" << values[NumCategories]
+            << ",\"lost_time\":" << values[NumCategories + 1]
+            << ",\"dominant\":\"" << name(dominant(step)) << "\"";
+        for (int k = 0; k < NumCategories; ++k) {
+            out << ",\"" << name(static_cast<Category>(k)) << "\":" << values[k];
+        }
+        out << "}";
+    }
+    out << "\n]";
+
+    out << ",\n\"timers\":[";
+    for (std::size_t i = 0; i < timers.size(); ++i) {
+        const TimerRegistry::Statistics& s = timers[i];
+        out << (i > 0 ? ",\n" : "\n") << "{\"path\":[";
+        for (std::size_t k = 0; k < s.path.size(); ++k) {
+            out << (k > 0 ? "," : "") << '"' << toJson(s.path[k]) << '"';
+        }
+        out << "],\"calls\":" << s.calls << ",\"min\":" << s.min << ",\"avg\":" << s.avg
+            << ",\"max\":" << s.max << ",\"imbalance\":" << s.imbalance << "}";
+    }
+    out << "\n]}\n";
+}
+
+} // namespace Opm
@@ -0,0 +1,106 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_RUNPROFILE_HEADER_INCLUDED
+#define OPM_RUNPROFILE_HEADER_INCLUDED
+
+#include <opm/core/simulator/SimulatorReport.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+namespace Opm
+{
+
+/// \brief A summary of the performance of a run, to triage slow runs without
+///        running them again under a profiler.
+///
+/// The simulator adds the timings of each report step of this process. write()
+/// reduces them over the processes and the first process writes a JSON file
+/// with the wall time of the run split into categories, the spread of each
+/// category over the processes, the work lost in failed time steps, the
+/// slowest report steps with their dominant category and, if the TimerRegistry
+/// was started, its timers.
+class RunProfile
+{
+public:
+    /// \brief The type of the collective communication used.
+    typedef Dune::CollectiveCommunication<typename Dune::MPIHelper::MPICommunicator>
+    Communication;
+
+    /// \brief The categories of the wall time of a report step.
+    enum Category {
+        Assembly,
+        LinearSolve,
+        Update,
+        Output,
+        Other,
+        NumCategories
+    };
+
+    /// \brief The timings of a report step on this process.
+    struct Step
+    {
+        int reportStep;
+        double wallTime;
+        std::array<double, NumCategories> seconds;
+        /// The time of the failed time steps, part of the categories.
+        double lostTime;
+        unsigned int lostLinearizations;
+    };
+
+    /// \brief The name of a category in the JSON file.
+    static const char* name(Category category);
+
+    /// \brief Record a report step.
+    /// \param reportStep    the number of the report step
+    /// \param wallTime      the wall time of the step including its output [s]
+    /// \param outputTime    the time of the output of the step, without the
+    ///                      output of the substeps in stepReport [s]
+    /// \param stepReport    the report of the converged time steps of the
+    ///                      report step
+    /// \param failedReport  the report of its failed time steps
+    void addReportStep(int reportStep, double wallTime, double outputTime,
+                       const SimulatorReport& stepReport,
+                       const SimulatorReport& failedReport);
+
+    /// \brief The report steps recorded so far.
+    const std::vector<Step>& steps() const
+    { return steps_; }
+
+    /// \brief The category that took the most time of a step.
+    static Category dominant(const Step& step);
+
+    /// \brief Collectively write the summary, by the first process.
+    /// \param filename    the JSON file
+    /// \param numSlowest  the number of slowest report steps listed
+    void write(const std::string& filename, std::size_t numSlowest,
+               const Communication& cc = Dune::MPIHelper::getCollectiveCommunication()) const;
+
+private:
+    std::vector<Step> steps_;
+};
+
+} // namespace Opm
+
+#endif // OPM_RUNPROFILE_HEADER_INCLUDED
@@ -269,6 +269,7 @@ namespace Opm
         // Transport related init.
         num_transport_substeps_ = param.getDefault("num_transport_substeps", 1);
         use_segregation_split_ = param.getDefault("use_segregation_split", false);
+        tsolver_.setLocalCfl(param.getDefault("transport_local_cfl", 0.0));
         if (gravity != 0 && use_segregation_split_){
             tsolver_.initGravity(gravity);
             extractColumn(grid_, columns_);
@@ -0,0 +1,281 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include <opm/simulators/TimerRegistry.hpp>
+
+#include <opm/common/ErrorMacros.hpp>
+#include <opm/common/OpmLog/OpmLog.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace Opm
+{
+
+namespace
+{
+
+struct Node
+{
+    std::string name;
+    int parent;
+    std::vector<int> children;
+    double calls;
+    double seconds;
+};
+
+// The timers of one thread, only accessed by the thread while timing.
+struct ThreadTimers
+{
+    ThreadTimers()
+        : nodes(1, Node{ std::string(), -1, {}, 0.0, 0.0 }),
+          current(0)
+    {}
+
+    std::vector<Node> nodes;
+    int current;
+};
+
+struct RegistryData
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadTimers> > threads;
+};
+
+RegistryData& registryData()
+{
+    static RegistryData data;
+    return data;
+}
+
+// The timers of the calling thread, registered on first use. They are owned by
+// the registry, so that the timers of finished threads are kept.
+ThreadTimers& threadTimers()
+{
+    thread_local ThreadTimers* timers = nullptr;
+    if (!timers) {
+        RegistryData& data = registryData();
+        std::lock_guard<std::mutex> lock(data.mutex);
+        data.threads.emplace_back(new ThreadTimers);
+        timers = data.threads.back().get();
+    }
+    return *timers;
+}
+
+typedef std::map<std::vector<std::string>, std::pair<double, double> > TimerMap;
+
+// the calls and seconds of the timers of this process by path
+TimerMap localTimers()
+{
+    TimerMap timers;
+    RegistryData& data = registryData();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    for (const auto& thread : data.threads) {
+        const std::vector<Node>& nodes = thread->nodes;
+        std::vector<std::vector<std::string> > paths(nodes.size());
+        // the parents are created before their children
+        for (std::size_t i = 1; i < nodes.size(); ++i) {
+            paths[i] = paths[nodes[i].parent];
+            paths[i].push_back(nodes[i].name);
+            auto& timer = timers[paths[i]];
+            timer.first += nodes[i].calls;
+            timer.second += nodes[i].seconds;
+        }
+    }
+    return timers;
+}
+
+std::string toJson(const std::string& text)
+{
+    std::string json;
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            json += '\\';
+        }
+        json += c;
+    }
+    return json;
+}
+
+} // anonymous namespace
+
+std::atomic<bool> TimerRegistry::active_(false);
+
+void TimerRegistry::start()
+{
+    active_ = true;
+}
+
+void TimerRegistry::stop()
+{
+    active_ = false;
+}
+
+void TimerRegistry::reset()
+{
+    RegistryData& data = registryData();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    for (const auto& thread : data.threads) {
+        *thread = ThreadTimers();
+    }
+}
+
+int TimerRegistry::enter_(const char* name)
+{
+    ThreadTimers& timers = threadTimers();
+    std::vector<Node>& nodes = timers.nodes;
+    for (const int child : nodes[timers.current].children) {
+        if (nodes[child].name == name) {
+            timers.current = child;
+            return child;
+        }
+    }
+    const int node = nodes.size();
+    nodes.push_back(Node{ name, timers.current, {}, 0.0, 0.0 });
+    nodes[timers.current].children.push_back(node);
+    timers.current = node;
+    return node;
+}
+
+void TimerRegistry::leave_(const int node, const double seconds)
+{
+    ThreadTimers& timers = threadTimers();
+    Node& timer = timers.nodes[node];
+    timer.calls += 1.0;
+    timer.seconds += seconds;
+    timers.current = timer.parent;
+}
+
+std::vector<TimerRegistry::Statistics> TimerRegistry::statistics(const Communication& cc)
+{
+    // one line of path, calls and seconds per timer
+    std::ostringstream local;
+    local.precision(17);
+    for (const auto& timer : localTimers()) {
+        for (std::size_t k = 0; k < timer.first.size(); ++k) {
+            local << (k > 0 ? "/" : "") << timer.first[k];
+        }
+        local << '\t' << timer.second.first << '\t' << timer.second.second << '\n';
+    }
+    std::string text = local.str();
+    int localSize = text.size();
+
+    std::vector<int> sizes(cc.size());
+    cc.gather(&localSize, sizes.data(), 1, 0);
+    std::vector<int> displ(cc.size() + 1, 0);
+    std::partial_sum(sizes.begin(), sizes.end(), displ.begin() + 1);
+
+    std::vector<char> all(cc.rank() == 0 ? displ.back() : 0);
+    cc.gatherv(&text[0], localSize, all.data(), sizes.data(), displ.data(), 0);
+
+    std::vector<Statistics> stats;
+    if (cc.rank() != 0) {
+        return stats;
+    }
+
+    // the calls and the seconds of each process by path
+    std::map<std::vector<std::string>, std::pair<double, std::vector<double> > > timers;
+    for (int rank = 0; rank < cc.size(); ++rank) {
+        std::istringstream in(std::string(all.data() + displ[rank], sizes[rank]));
+        std::string path;
+        double calls, seconds;
+        while (std::getline(in, path, '\t') && in >> calls >> seconds) {
+            in.ignore(1);
+            std::vector<std::string> names;
+            std::istringstream parts(path);
+            for (std::string name; std::getline(parts, name, '/'); ) {
+                names.push_back(name);
+            }
+            auto& timer = timers[names];
+            timer.second.resize(cc.size(), 0.0);
+            timer.first += calls;
+            timer.second[rank] += seconds;
+        }
+    }
+
+    for (const auto& timer : timers) {
+        const std::vector<double>& seconds = timer.second.second;
+        Statistics s;
+        s.path = timer.first;
+        s.calls = timer.second.first;
+        s.min = *std::min_element(seconds.begin(), seconds.end());
+        s.max = *std::max_element(seconds.begin(), seconds.end());
+        s.avg = std::accumulate(seconds.begin(), seconds.end(), 0.0) / seconds.size();
+        s.imbalance = s.avg > 0.0 ? s.max / s.avg : 1.0;
+        stats.push_back(s);
+    }
+    return stats;
+}
+
+void TimerRegistry::write(const std::string& filename, const Communication& cc)
+{
+    const std::vector<Statistics> stats = statistics(cc);
+    if (cc.rank() != 0) {
+        return;
+    }
+
+    std::ostringstream table;
+    table << std::left << std::setw(48) << "Timer" << std::right
+          << std::setw(12) << "Calls" << std::setw(12) << "Min [s]"
+          << std::setw(12) << "Avg [s]" << std::setw(12) << "Max [s]"
+          << std::setw(10) << "Imbal." << '\n';
+    table << std::fixed;
+    for (const Statistics& s : stats) {
+        const std::string name = std::string(2 * (s.path.size() - 1), ' ') + s.path.back();
+        table << std::left << std::setw(48) << name << std::right
+              << std::setw(12) << std::setprecision(0) << s.calls
+              << std::setprecision(3) << std::setw(12) << s.min
+              << std::setw(12) << s.avg << std::setw(12) << s.max
+              << std::setprecision(2) << std::setw(10) << s.imbalance << '\n';
+    }
+    OpmLog::info(table.str());
+
+    if (filename.empty()) {
+        return;
+    }
+    std::ofstream out(filename);
+    if (!out) {
+        OPM_THROW(std::runtime_error, "Could not open the timer file " << filename);
+    }
+    out.precision(15);
+    out << "{\"timers\":[";
+    for (std::size_t i = 0; i < stats.size(); ++i) {
+        const Statistics& s = stats[i];
+        out << (i > 0 ? ",\n" : "\n") << "{\"path\":[";
+        for (std::size_t k = 0; k < s.path.size(); ++k) {
+            out << (k > 0 ? "," : "") << '"' << toJson(s.path[k]) << '"';
+        }
+        out << "],\"calls\":" << s.calls << ",\"min\":" << s.min << ",\"avg\":" << s.avg
+            << ",\"max\":" << s.max << ",\"imbalance\":" << s.imbalance << "}";
+    }
+    out << "\n]}\n";
+}
+
+} // namespace Opm
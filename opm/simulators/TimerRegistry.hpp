@@ -0,0 +1,103 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_TIMERREGISTRY_HEADER_INCLUDED
+#define OPM_TIMERREGISTRY_HEADER_INCLUDED
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+namespace Opm
+{
+
+/// \brief Hierarchical timers of the simulator, aggregated over threads and processes.
+///
+/// The registry is global to the process and off unless start() is called. Each
+/// thread keeps its own tree of timers, indexed by the nesting of the scopes, so
+/// timing a scope needs two clock reads and no lock. The timers of a scope opened
+/// by a worker thread start at the root of the tree of that thread. The scopes
+/// are timed by ProfileScope.
+///
+/// statistics() merges the trees of all threads by path, so the time of a timer
+/// is the sum over the threads, and gathers the timers of all processes on the
+/// first process. It and reset() may only be called when no thread is timing.
+class TimerRegistry
+{
+public:
+    /// \brief The type of the collective communication used.
+    typedef Dune::CollectiveCommunication<typename Dune::MPIHelper::MPICommunicator>
+    Communication;
+
+    /// \brief A timer aggregated over the processes.
+    struct Statistics
+    {
+        /// The names of the enclosing timers and of the timer.
+        std::vector<std::string> path;
+        /// The number of calls, summed over the processes.
+        double calls;
+        /// The minimum, average and maximum time of a process in seconds,
+        /// processes without the timer count as zero.
+        double min;
+        double avg;
+        double max;
+        /// The ratio of the maximum and average time, one if balanced.
+        double imbalance;
+    };
+
+    /// \brief Start timing.
+    static void start();
+
+    /// \brief Stop timing, the timers are kept.
+    static void stop();
+
+    /// \brief Whether the scopes are currently timed.
+    static bool active()
+    { return active_.load(std::memory_order_relaxed); }
+
+    /// \brief Discard the timers of all threads.
+    static void reset();
+
+    /// \brief Collectively aggregate the timers of all processes.
+    /// \return the timers with each enclosing timer before the timers it
+    ///         encloses on the first process, an empty list on the others
+    static std::vector<Statistics> statistics(const Communication& cc = Dune::MPIHelper::getCollectiveCommunication());
+
+    /// \brief Collectively print the timers to the log and optionally write them
+    ///        as JSON, by the first process.
+    /// \param filename  the JSON file, not written if empty
+    static void write(const std::string& filename,
+                      const Communication& cc = Dune::MPIHelper::getCollectiveCommunication());
+
+private:
+    friend class ProfileScope;
+
+    // open the timer of the name in the current timer of the thread
+    static int enter_(const char* name);
+    // close the timer and make its parent the current timer of the thread
+    static void leave_(int node, double seconds);
+
+    static std::atomic<bool> active_;
+};
+
+} // namespace Opm
+
+#endif // OPM_TIMERREGISTRY_HEADER_INCLUDED
@@ -154,6 +154,14 @@ void WellSwitchingLogger::gatherDataAndLog()
         return;
     }
 
+    // Usually no well switched anywhere, and then the gathers below
+    // are skipped.
+    const int switched = switchMap_.empty() ? 0 : 1;
+    if ( cc_.max(switched) == 0 )
+    {
+        return;
+    }
+
     std::vector<int> message_sizes;
     std::vector<int> well_name_lengths;
     int message_size = calculateMessageSize(well_name_lengths);
@@ -59,6 +59,8 @@ public:
     {}
 
     /// \brief Log that a well switched.
+    ///
+    /// May be called concurrently from several threads.
     /// \param name The name of the well.
     /// \param from The control of the well before the switch.
     /// \param to The control of the well after the switch.
@@ -69,6 +71,9 @@ public:
         if( cc_.size() > 1 )
         {
             using Pair = typename SwitchMap::value_type;
+#if HAVE_OPENMP
+#pragma omp critical(WellSwitchingLogger_switchMap)
+#endif // HAVE_OPENMP
             switchMap_.insert(Pair(name, {{char(from), char(to)}}));
         }
         else
@@ -77,11 +82,17 @@ public:
             ss << "    Switching control mode for well " << name
                << " from " << modestring[from]
                << " to " <<  modestring[to];
+#if HAVE_OPENMP
+#pragma omp critical(WellSwitchingLogger_log)
+#endif // HAVE_OPENMP
             OpmLog::info(ss.str());
         }
     }
 
     /// \brief Destructor send does the actual logging.
+    ///
+    /// If no process has a switch to log, this only costs one
+    /// reduction of a single integer.
     ~WellSwitchingLogger();
 
 private:
@@ -23,6 +23,9 @@
 #include <opm/core/props/BlackoilPropertiesFromDeck.hpp>
 #include <opm/core/props/BlackoilPhases.hpp>
 
+#include <algorithm>
+#include <map>
+#include <numeric>
 #include <vector>
 #include <opm/parser/eclipse/EclipseState/SimulationConfig/SimulationConfig.hpp>
 #include <opm/parser/eclipse/EclipseState/SimulationConfig/ThresholdPressure.hpp>
@@ -66,9 +69,7 @@ void computeMaxDp(std::map<std::pair<int, int>, double>& maxDp,
     std::vector<double> minSat(numPhases*numCells);
     std::vector<double> maxSat(numPhases*numCells);
     std::vector<int> allCells(numCells);
-    for (int cellIdx = 0; cellIdx < numCells; ++cellIdx) {
-        allCells[cellIdx] = cellIdx;
-    }
+    std::iota(allCells.begin(), allCells.end(), 0);
     props.satRange(numCells, allCells.data(), minSat.data(), maxSat.data());
 
     // retrieve the surface densities
@@ -140,11 +141,7 @@ void computeMaxDp(std::map<std::pair<int, int>, double>& maxDp,
 
     // compute the capillary pressures of the active phases
     std::vector<double> capPress(numCells*numPhases);
-    std::vector<int> cellIdxArray(numCells);
-    for (int cellIdx = 0; cellIdx < numCells; ++ cellIdx) {
-        cellIdxArray[cellIdx] = cellIdx;
-    }
-    props.capPress(numCells, initialState.saturation().data(), cellIdxArray.data(), capPress.data(), NULL);
+    props.capPress(numCells, initialState.saturation().data(), allCells.data(), capPress.data(), NULL);
 
     // compute the absolute pressure of each active phase: for some reason, E100
     // defines the capillary pressure for the water phase as p_o - p_w while it
@@ -247,52 +244,97 @@ void computeMaxDp(std::map<std::pair<int, int>, double>& maxDp,
         }
     }
 
+    // The equilibration region of each cell, numbered consecutively, and the
+    // cell depths.
+    std::vector<int> regions(numCells);
+    std::vector<double> depth(numCells);
+    for (int cellIdx = 0; cellIdx < numCells; ++cellIdx) {
+        regions[cellIdx] = eqlnumData[gc ? gc[cellIdx] : cellIdx];
+        depth[cellIdx] = UgGridHelpers::cellCenterDepth(grid, cellIdx);
+    }
+    std::vector<int> eqlnumValues(regions);
+    std::sort(eqlnumValues.begin(), eqlnumValues.end());
+    eqlnumValues.erase(std::unique(eqlnumValues.begin(), eqlnumValues.end()), eqlnumValues.end());
+    for (auto& region : regions) {
+        region = std::lower_bound(eqlnumValues.begin(), eqlnumValues.end(), region) - eqlnumValues.begin();
+    }
+    const int numRegions = eqlnumValues.size();
+
     // Calculate the maximum pressure potential difference between all PVT region
-    // transitions of the initial solution.
+    // transitions of the initial solution. The region counts are small, so the
+    // maxima are kept in a dense table of region pairs, where negative entries
+    // mark pairs without a common face.
+    std::vector<double> regionMaxDp(numRegions*numRegions, -1.0);
     const int num_faces = UgGridHelpers::numFaces(grid);
     const auto& fc = UgGridHelpers::faceCells(grid);
-    for (int face = 0; face < num_faces; ++face) {
-        const int c1 = fc(face, 0);
-        const int c2 = fc(face, 1);
-        if (c1 < 0 || c2 < 0) {
-            // Boundary face, skip this.
-            continue;
-        }
-        const int gc1 = (gc == 0) ? c1 : gc[c1];
-        const int gc2 = (gc == 0) ? c2 : gc[c2];
-        const int eq1 = eqlnumData[gc1];
-        const int eq2 = eqlnumData[gc2];
-
-        if (eq1 == eq2) {
-            // not an equilibration region boundary. skip this.
-            continue;
-        }
+#if HAVE_OPENMP
+#pragma omp parallel
+#endif // HAVE_OPENMP
+    {
+        std::vector<double> localMaxDp(numRegions*numRegions, -1.0);
+#if HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif // HAVE_OPENMP
+        for (int face = 0; face < num_faces; ++face) {
+            const int c1 = fc(face, 0);
+            const int c2 = fc(face, 1);
+            if (c1 < 0 || c2 < 0) {
+                // Boundary face, skip this.
+                continue;
+            }
+            const int eq1 = regions[c1];
+            const int eq2 = regions[c2];
 
-        // update the maximum pressure potential difference between the two
-        // regions
-        const auto barrierId = std::make_pair(std::min(eq1, eq2), std::max(eq1, eq2));
-        if (maxDp.count(barrierId) == 0) {
-            maxDp[barrierId] = 0.0;
-        }
+            if (eq1 == eq2) {
+                // not an equilibration region boundary. skip this.
+                continue;
+            }
 
-        for (int phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
-            const double z1 = UgGridHelpers::cellCenterDepth(grid, c1);
-            const double z2 = UgGridHelpers::cellCenterDepth(grid, c2);
+            // update the maximum pressure potential difference between the two
+            // regions
+            double& barrierDp = localMaxDp[std::min(eq1, eq2)*numRegions + std::max(eq1, eq2)];
+            barrierDp = std::max(barrierDp, 0.0);
 
-            const double rhoAvg = (rho[phaseIdx][c1] + rho[phaseIdx][c2])/2;
+            const double z1 = depth[c1];
+            const double z2 = depth[c2];
+            for (int phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+                const double rhoAvg = (rho[phaseIdx][c1] + rho[phaseIdx][c2])/2;
 
-            const double s1 = initialState.saturation()[numPhases*c1 + phaseIdx];
-            const double s2 = initialState.saturation()[numPhases*c2 + phaseIdx];
+                const double s1 = initialState.saturation()[numPhases*c1 + phaseIdx];
+                const double s2 = initialState.saturation()[numPhases*c2 + phaseIdx];
 
-            const double sResid1 = minSat[numPhases*c1 + phaseIdx];
-            const double sResid2 = minSat[numPhases*c2 + phaseIdx];
+                const double sResid1 = minSat[numPhases*c1 + phaseIdx];
+                const double sResid2 = minSat[numPhases*c2 + phaseIdx];
 
-            // compute gravity corrected pressure potentials at the average depth
-            const double p1 = phasePressure[phaseIdx][c1];
-            const double p2 = phasePressure[phaseIdx][c2] + rhoAvg*gravity*(z1 - z2);
+                // compute gravity corrected pressure potentials at the average depth
+                const double p1 = phasePressure[phaseIdx][c1];
+                const double p2 = phasePressure[phaseIdx][c2] + rhoAvg*gravity*(z1 - z2);
+
+                if ((p1 > p2 && s1 > sResid1) || (p2 > p1 && s2 > sResid2))
+                    barrierDp = std::max(barrierDp, std::abs(p1 - p2));
+            }
+        }
+#if HAVE_OPENMP
+#pragma omp critical(computeMaxDp_merge)
+#endif // HAVE_OPENMP
+        for (int pair = 0; pair < numRegions*numRegions; ++pair) {
+            regionMaxDp[pair] = std::max(regionMaxDp[pair], localMaxDp[pair]);
+        }
+    }
 
-            if ((p1 > p2 && s1 > sResid1) || (p2 > p1 && s2 > sResid2))
-                maxDp[barrierId] = std::max(maxDp[barrierId], std::abs(p1 - p2));
+    for (int eq1 = 0; eq1 < numRegions; ++eq1) {
+        for (int eq2 = eq1 + 1; eq2 < numRegions; ++eq2) {
+            const double dp = regionMaxDp[eq1*numRegions + eq2];
+            if (dp < 0.0) {
+                continue;
+            }
+            const auto barrierId = std::make_pair(eqlnumValues[eq1], eqlnumValues[eq2]);
+            auto it = maxDp.find(barrierId);
+            if (it == maxDp.end()) {
+                maxDp[barrierId] = dp;
+            } else {
+                it->second = std::max(it->second, dp);
+            }
         }
     }
 }
@@ -4,12 +4,16 @@
 #define OPM_ADAPTIVE_TIME_STEPPING_EBOS_HPP
 
 #include <iostream>
+#include <sstream>
 #include <utility>
 
-#include <opm/grid/utility/StopWatch.hpp>
 #include <opm/common/OpmLog/OpmLog.hpp>
 #include <opm/common/utility/parameters/ParameterGroup.hpp>
 #include <opm/common/ErrorMacros.hpp>
+#include <opm/output/data/Wells.hpp>
+#include <opm/autodiff/BlackoilModelEnums.hpp>
+#include <opm/simulators/DeferredLogger.hpp>
+#include <opm/simulators/ProfileScope.hpp>
 #include <opm/simulators/timestepping/SimulatorTimer.hpp>
 #include <opm/simulators/timestepping/AdaptiveSimulatorTimer.hpp>
 #include <opm/simulators/timestepping/TimeStepControlInterface.hpp>
@@ -46,6 +50,24 @@ namespace Opm {
             }
         }
 
+        // the fluid in place of the FIPNUM regions of a substep, in SI units
+        void logFluidInPlace_(const std::vector<std::vector<double> >& fip) const
+        {
+            typedef FIPDataEnums FIP;
+            std::ostringstream ss;
+            ss << "Fluid in place of the substep:";
+            for (std::size_t region = 0; region < fip.size(); ++region) {
+                const auto& v = fip[region];
+                ss << "\n  region " << region + 1
+                   << ": pore volume " << v[FIP::FIP_PV]
+                   << ", pressure " << v[FIP::FIP_WEIGHTED_PRESSURE]
+                   << ", oil " << v[FIP::FIP_LIQUID] + v[FIP::FIP_VAPORIZED_OIL]
+                   << ", water " << v[FIP::FIP_AQUA]
+                   << ", gas " << v[FIP::FIP_VAPOUR] + v[FIP::FIP_DISSOLVED_GAS];
+            }
+            OpmLog::debug(ss.str());
+        }
+
     public:
         //! \brief contructor taking parameter object
         AdaptiveTimeSteppingEbos(const ParameterGroup& param,
@@ -146,6 +168,7 @@ namespace Opm {
 
                 SimulatorReport substepReport;
                 std::string causeOfFailure = "";
+                ProfileScope stepScope("time step");
                 try {
                     substepReport = solver.step(substepTimer);
                     report += substepReport;
@@ -195,6 +218,9 @@ namespace Opm {
                     // this can be thrown by ISTL's ILU0 in block mode, yet is not an ISTLError
                 }
 
+                // let the time step control know the cost of the attempt
+                timeStepControl_->recordStep(dt, substepReport.converged, stepScope.stop());
+
                 if (substepReport.converged) {
                     // advance by current dt
                     ++substepTimer;
@@ -230,20 +256,22 @@ namespace Opm {
                     // anyway.
                     if (!substepTimer.done()) {
                         if (fipnum) {
-                            solver.computeFluidInPlace(*fipnum);
+                            const auto fip = solver.computeFluidInPlace(*fipnum);
+                            if (solverVerbose_ && DeferredLogger::debugEnabled()) {
+                                logFluidInPlace_(fip);
+                            }
                         }
-                        Opm::time::StopWatch perfTimer;
-                        perfTimer.start();
+                        ProfileScope outputScope("output");
 
                         // The writeOutput expects a local data::solution vector and a local data::well vector.
-                        auto localWellData = solver.model().wellModel().wellState().report(phaseUsage, Opm::UgGridHelpers::globalCell(ebosSimulator.vanguard().grid()));
-                        ebosProblem.writeOutput(localWellData,
+                        solver.model().wellModel().wellState().updateReport(phaseUsage, Opm::UgGridHelpers::globalCell(ebosSimulator.vanguard().grid()), substepWellData_);
+                        ebosProblem.writeOutput(substepWellData_,
                                                 substepTimer.simulationTimeElapsed(),
                                                 /*isSubstep=*/true,
                                                 substepReport.total_time,
                                                 /*nextStepSize=*/-1.0);
 
-                        report.output_write_time += perfTimer.secsSinceStart();
+                        report.output_write_time += outputScope.stop();
                     }
 
                     // set new time step length
@@ -271,6 +299,7 @@ namespace Opm {
                     const double newTimeStep = restartFactor_ * dt;
                     // we need to revise this
                     substepTimer.provideTimeStepEstimate(newTimeStep);
+                    PerformanceTrace::instant("timestep chop");
                     if (solverVerbose_) {
                         std::string msg;
                         msg = causeOfFailure + "\nTimestep chopped to "
@@ -320,6 +349,37 @@ namespace Opm {
             timestepAfterEvent_ = tuning.getTMAXWC(timeStep);
         }
 
+        /** \brief Returns the state of the time stepping that is not given by the
+         *         input, i.e. the suggested next step, the parameters from TUNING
+         *         and the state of the time step control.
+         */
+        std::vector<double> snapshotState() const
+        {
+            std::vector<double> state = { suggestedNextTimestep_, restartFactor_, growthFactor_,
+                                          maxGrowth_, maxTimeStep_, timestepAfterEvent_ };
+            const std::vector<double> controlState = timeStepControl_->state();
+            state.insert(state.end(), controlState.begin(), controlState.end());
+            return state;
+        }
+
+        /** \brief Restores the state returned by snapshotState().
+         */
+        void setSnapshotState(const std::vector<double>& state)
+        {
+            const std::size_t numOwnValues = 6;
+            if (state.size() < numOwnValues) {
+                OPM_THROW(std::runtime_error, "The state of the time stepping has " << state.size()
+                          << " values, expected at least " << numOwnValues);
+            }
+            suggestedNextTimestep_ = state[0];
+            restartFactor_ = state[1];
+            growthFactor_ = state[2];
+            maxGrowth_ = state[3];
+            maxTimeStep_ = state[4];
+            timestepAfterEvent_ = state[5];
+            timeStepControl_->setState(std::vector<double>(state.begin() + numOwnValues, state.end()));
+        }
+
 
     protected:
         void init_(const ParameterGroup& param)
@@ -349,6 +409,13 @@ namespace Opm {
                 const double growthrate = param.getDefault("timestep.control.growthrate", double(1.25));
                 timeStepControl_ = TimeStepControlType(new SimpleIterationCountTimeStepControl(iterations, decayrate, growthrate));
             }
+            else if (control == "walltime") {
+                const double targetChopRate = param.getDefault("timestep.control.targetchoprate", double(0.1));
+                const double decayrate = param.getDefault("timestep.control.decayrate",  double(0.75));
+                const double growthrate = param.getDefault("timestep.control.growthrate", double(1.25));
+                const int historyLength = param.getDefault("timestep.control.historylength", int(10));
+                timeStepControl_ = TimeStepControlType(new WallTimeTimeStepControl(targetChopRate, decayrate, growthrate, historyLength));
+            }
             else if (control == "hardcoded") {
                 const std::string filename = param.getDefault("timestep.control.filename", std::string("timesteps"));
                 timeStepControl_ = TimeStepControlType(new HardcodedTimeStepControl(filename));
@@ -377,6 +444,7 @@ namespace Opm {
         bool fullTimestepInitially_;        //!< beginning with the size of the time step from data file
         double timestepAfterEvent_;         //!< suggested size of timestep after an event
         bool useNewtonIteration_;           //!< use newton iteration count for adaptive time step control
+        data::Wells substepWellData_;       //!< well data of the substep output, refreshed in place
     };
 }
 
@@ -145,6 +145,14 @@ namespace Opm {
             const double decayrate  = param.getDefault("timestep.control.decayrate",  double(0.75) );
             const double growthrate = param.getDefault("timestep.control.growthrate", double(1.25) );
             timeStepControl_ = TimeStepControlType( new SimpleIterationCountTimeStepControl( iterations, decayrate, growthrate ) );
+        }
+        else if ( control == "walltime" )
+        {
+            const double target_chop_rate = param.getDefault("timestep.control.targetchoprate", double(0.1) );
+            const double decayrate  = param.getDefault("timestep.control.decayrate",  double(0.75) );
+            const double growthrate = param.getDefault("timestep.control.growthrate", double(1.25) );
+            const int history_length = param.getDefault("timestep.control.historylength", int(10) );
+            timeStepControl_ = TimeStepControlType( new WallTimeTimeStepControl( target_chop_rate, decayrate, growthrate, history_length ) );
         } else if ( control == "hardcoded") {
             const std::string filename    = param.getDefault("timestep.control.filename", std::string("timesteps"));
             timeStepControl_ = TimeStepControlType( new HardcodedTimeStepControl( filename ) );
@@ -232,6 +240,8 @@ namespace Opm {
 
             SimulatorReport substepReport;
             std::string cause_of_failure = "";
+            Opm::time::StopWatch step_timer;
+            step_timer.start();
             try {
                 substepReport = solver.step( substepTimer, state, well_state);
                 report += substepReport;
@@ -281,6 +291,9 @@ namespace Opm {
                 // this can be thrown by ISTL's ILU0 in block mode, yet is not an ISTLError
             }
 
+            // let the time step control know the cost of the attempt
+            timeStepControl_->recordStep( dt, substepReport.converged, step_timer.secsSinceStart() );
+
             if( substepReport.converged )
             {
                 // advance by current dt
@@ -20,11 +20,14 @@
 */
 #include <config.h>
 #include <cassert>
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <stdexcept>
 #include <string>
 #include <fstream>
+#include <limits>
+#include <numeric>
 #include <iostream>
 
 #include <opm/common/ErrorMacros.hpp>
@@ -158,6 +161,19 @@ namespace Opm
         }
     }
 
+    std::vector<double> PIDTimeStepControl::state() const
+    {
+        return errors_;
+    }
+
+    void PIDTimeStepControl::setState( const std::vector<double>& state )
+    {
+        if( state.size() != errors_.size() ) {
+            OPM_THROW(std::runtime_error,"PIDTimeStepControl: state of size " << state.size() << ", expected " << errors_.size() );
+        }
+        errors_ = state;
+    }
+
 
 
     ////////////////////////////////////////////////////////////
@@ -193,4 +209,138 @@ namespace Opm
         return std::min(dtEstimatePID, dtEstimateIter);
     }
 
+
+
+    ////////////////////////////////////////////////////////
+    //
+    //  WallTimeTimeStepControl Implementation
+    //
+    ////////////////////////////////////////////////////////
+
+    WallTimeTimeStepControl::
+    WallTimeTimeStepControl( const double target_chop_rate,
+                             const double decayrate,
+                             const double growthrate,
+                             const int history_length,
+                             const bool verbose)
+        : target_chop_rate_( target_chop_rate )
+        , decayrate_( decayrate )
+        , growthrate_( growthrate )
+        , history_length_( std::max( history_length, 2 ) )
+        , verbose_( verbose )
+    {
+        if( decayrate_  > 1.0 ) {
+            OPM_THROW(std::runtime_error,"WallTimeTimeStepControl: decay should be <= 1 " << decayrate_ );
+        }
+        if( growthrate_ < 1.0 ) {
+            OPM_THROW(std::runtime_error,"WallTimeTimeStepControl: growth should be >= 1 " << growthrate_ );
+        }
+    }
+
+    void WallTimeTimeStepControl::
+    recordStep( const double dt, const bool converged, const double wallTime ) const
+    {
+        history_.push_back( Attempt{ dt, wallTime, converged } );
+        while( history_.size() > history_length_ ) {
+            history_.pop_front();
+        }
+    }
+
+    std::vector<double> WallTimeTimeStepControl::state() const
+    {
+        std::vector<double> state;
+        state.reserve( 3 * history_.size() );
+        for( const auto& attempt : history_ ) {
+            state.push_back( attempt.dt );
+            state.push_back( attempt.wallTime );
+            state.push_back( attempt.converged ? 1.0 : 0.0 );
+        }
+        return state;
+    }
+
+    void WallTimeTimeStepControl::setState( const std::vector<double>& state )
+    {
+        if( state.size() % 3 != 0 ) {
+            OPM_THROW(std::runtime_error,"WallTimeTimeStepControl: state of size " << state.size() << " is not a list of attempts" );
+        }
+        history_.clear();
+        for( std::size_t i = 0; i < state.size(); i += 3 ) {
+            recordStep( state[ i ], state[ i + 2 ] != 0.0, state[ i + 1 ] );
+        }
+    }
+
+    double WallTimeTimeStepControl::
+    computeTimeStepSize( const double dt, const int /* iterations */, const RelativeChangeInterface& /* relativeChange */, const double /*simulationTimeElapsed */) const
+    {
+        if( history_.empty() ) {
+            return dt * growthrate_;
+        }
+
+        // the cost of the converged steps including the failed attempts before them
+        std::vector<double> logDt;
+        std::vector<double> logCost;
+        double wasted = 0.0;
+        int failures = 0;
+        double minFailedDt = std::numeric_limits<double>::max();
+        for( const auto& attempt : history_ ) {
+            if( !attempt.converged ) {
+                wasted += attempt.wallTime;
+                minFailedDt = std::min( minFailedDt, attempt.dt );
+                ++failures;
+                continue;
+            }
+            const double cost = attempt.wallTime + wasted;
+            wasted = 0.0;
+            if( attempt.dt > 0.0 && cost > 0.0 ) {
+                logDt.push_back( std::log( attempt.dt ) );
+                logCost.push_back( std::log( cost ) );
+            }
+        }
+        const double chopRate = double( failures ) / history_.size();
+
+        // least squares fit of log(cost) = log(a) + p * log(dt); without enough
+        // variation in the step sizes we keep growing to explore larger steps
+        double exponent = 0.0;
+        const int n = logDt.size();
+        if( n >= 2 ) {
+            const double meanDt = std::accumulate( logDt.begin(), logDt.end(), 0.0 ) / n;
+            const double meanCost = std::accumulate( logCost.begin(), logCost.end(), 0.0 ) / n;
+            double covariance = 0.0;
+            double variance = 0.0;
+            for( int i = 0; i < n; ++i ) {
+                covariance += ( logDt[ i ] - meanDt ) * ( logCost[ i ] - meanCost );
+                variance   += ( logDt[ i ] - meanDt ) * ( logDt[ i ] - meanDt );
+            }
+            // require the step sizes to differ by a few percent
+            if( variance > n * 1e-3 ) {
+                exponent = covariance / variance;
+            }
+        }
+
+        double dtEstimate = dt;
+        if( chopRate > target_chop_rate_ ) {
+            dtEstimate = decayrate_ * std::min( dt, minFailedDt );
+        }
+        else {
+            // simulated time per wall time is dt^(1-p) / a, leave a small dead band against noise
+            const double deadBand = 0.1;
+            if( exponent < 1.0 - deadBand ) {
+                dtEstimate = dt * growthrate_;
+            }
+            else if( exponent > 1.0 + deadBand ) {
+                dtEstimate = dt * decayrate_;
+            }
+            // do not return to a step size that failed recently
+            if( failures > 0 ) {
+                dtEstimate = std::min( dtEstimate, std::max( dt, decayrate_ * minFailedDt ) );
+            }
+        }
+
+        if( verbose_ ) {
+            std::cout << "Computed step size (wall time): " << unit::convert::to( dtEstimate, unit::day ) << " (days)"
+                      << ", cost exponent " << exponent << ", chop rate " << chopRate << std::endl;
+        }
+        return dtEstimate;
+    }
+
 } // end namespace Opm
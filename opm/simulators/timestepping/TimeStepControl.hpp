@@ -21,6 +21,8 @@
 #ifndef OPM_TIMESTEPCONTROL_HEADER_INCLUDED
 #define OPM_TIMESTEPCONTROL_HEADER_INCLUDED
 
+#include <cstddef>
+#include <deque>
 #include <vector>
 
 #include <boost/any.hpp>
@@ -84,6 +86,12 @@ namespace Opm
         /// \brief \copydoc TimeStepControlInterface::computeTimeStepSize
         double computeTimeStepSize( const double dt, const int /* iterations */, const RelativeChangeInterface& relativeChange, const double /*simulationTimeElapsed */ ) const;
 
+        /// \brief \copydoc TimeStepControlInterface::state
+        std::vector<double> state() const;
+
+        /// \brief \copydoc TimeStepControlInterface::setState
+        void setState( const std::vector<double>& state );
+
     protected:
         const double tol_;
         mutable std::vector< double > errors_;
@@ -117,6 +125,61 @@ namespace Opm
         const int     target_iterations_;
     };
 
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    ///
+    ///  Wall time based adaptive time step control.
+    ///
+    ///  The wall time of the recent attempts is fitted to w = a * dt^p, where the wall time of failed
+    ///  attempts is charged to the next converged step. The simulated time per wall time dt/w grows
+    ///  with dt for p < 1 and decreases for p > 1, so the time step is increased or decreased accordingly.
+    ///  The time step is cut below the smallest recently failed step while the fraction of failed
+    ///  attempts exceeds the target chop rate.
+    ///
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    class WallTimeTimeStepControl : public TimeStepControlInterface
+    {
+    public:
+        /// \brief constructor
+        /// \param target_chop_rate   accepted fraction of failed attempts in the history
+        /// \param decayrate          decayrate of time step when it is decreased (should be <= 1)
+        /// \param growthrate         growthrate of time step when it is increased (should be >= 1)
+        /// \param history_length     number of recent attempts used for the estimates
+        /// \param verbose            if true get some output (default = false)
+        WallTimeTimeStepControl( const double target_chop_rate,
+                                 const double decayrate,
+                                 const double growthrate,
+                                 const int history_length,
+                                 const bool verbose = false);
+
+        /// \brief \copydoc TimeStepControlInterface::computeTimeStepSize
+        double computeTimeStepSize( const double dt, const int /* iterations */, const RelativeChangeInterface& /* relativeChange */, const double /*simulationTimeElapsed */ ) const;
+
+        /// \brief \copydoc TimeStepControlInterface::recordStep
+        void recordStep( const double dt, const bool converged, const double wallTime ) const;
+
+        /// \brief \copydoc TimeStepControlInterface::state
+        std::vector<double> state() const;
+
+        /// \brief \copydoc TimeStepControlInterface::setState
+        void setState( const std::vector<double>& state );
+
+    protected:
+        struct Attempt
+        {
+            double dt;
+            double wallTime;
+            bool converged;
+        };
+
+        const double  target_chop_rate_;
+        const double  decayrate_;
+        const double  growthrate_;
+        const std::size_t history_length_;
+        const bool    verbose_;
+
+        mutable std::deque<Attempt> history_;
+    };
+
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
     ///
     ///  HardcodedTimeStepControl
@@ -19,6 +19,7 @@
 #ifndef OPM_TIMESTEPCONTROLINTERFACE_HEADER_INCLUDED
 #define OPM_TIMESTEPCONTROLINTERFACE_HEADER_INCLUDED
 
+#include <vector>
 
 namespace Opm
 {
@@ -58,6 +59,21 @@ namespace Opm
         /// \return suggested time step size for the next step
         virtual double computeTimeStepSize( const double dt, const int iterations, const RelativeChangeInterface& relativeChange , const double simulationTimeElapsed) const = 0;
 
+        /// record the cost of an attempted time step, called for converged and
+        /// failed attempts before the next step size is computed
+        /// (the default implementation ignores it)
+        /// \param dt          time step size of the attempt
+        /// \param converged   whether the attempt converged
+        /// \param wallTime    wall time spent on the attempt in seconds
+        virtual void recordStep( const double /* dt */, const bool /* converged */, const double /* wallTime */ ) const {}
+
+        /// \return the internal state of the controller such that it can be
+        ///         stored in a snapshot (the default controller has no state)
+        virtual std::vector<double> state() const { return std::vector<double>(); }
+
+        /// restore the internal state returned by state()
+        virtual void setState( const std::vector<double>& /* state */ ) {}
+
         /// virtual destructor (empty)
         virtual ~TimeStepControlInterface () {}
     };
@@ -24,6 +24,8 @@
 #include <opm/grid/UnstructuredGrid.h>
 #include <set>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <algorithm>
 #include <iostream>
 #include <iterator>
@@ -130,21 +132,180 @@ namespace Opm
             }
         }
     private:
-        static int indent_;
+        // Per thread, as the output may be written from a background thread.
+        static thread_local int indent_;
         std::string name_;
         std::ostream& os_;
     };
 
-    int Tag::indent_ = 0;
+    thread_local int Tag::indent_ = 0;
+
+
+    namespace
+    {
+        // A binary data array of the appended raw format.
+        struct AppendedArray
+        {
+            const char* data;
+            std::uint64_t bytes;
+        };
+
+        template <typename T>
+        AppendedArray appendedArray(const std::vector<T>& v)
+        {
+            return AppendedArray{ reinterpret_cast<const char*>(v.data()),
+                                  std::uint64_t(v.size() * sizeof(T)) };
+        }
+
+        // Write the header of a DataArray whose values are stored at the
+        // given offset of the AppendedData, and advance the offset past them.
+        void appendedDataArray(PMap pm, const AppendedArray& array,
+                               std::uint64_t& offset, std::ostream& os)
+        {
+            pm["format"] = "appended";
+            pm["offset"] = std::to_string(offset);
+            Tag t("DataArray", pm, os);
+            offset += sizeof(std::uint64_t) + array.bytes;
+        }
+
+        void writeVtkDataAppended(const UnstructuredGrid& grid,
+                                  const std::map< std::string, const std::vector< double >* >& data,
+                                  std::ostream& os)
+        {
+            const int num_pts = grid.number_of_nodes;
+            const int num_cells = grid.number_of_cells;
+
+            // Gather the topology arrays of the polyhedral cells.
+            std::vector<std::int32_t> connectivity;
+            std::vector<std::int32_t> offsets;
+            std::vector<std::int32_t> faces;
+            std::vector<std::int32_t> faceoffsets;
+            offsets.reserve(num_cells);
+            faceoffsets.reserve(num_cells);
+            std::set<int> cell_pts;
+            for (int c = 0; c < num_cells; ++c) {
+                cell_pts.clear();
+                faces.push_back(grid.cell_facepos[c+1] - grid.cell_facepos[c]);
+                for (int hf = grid.cell_facepos[c]; hf < grid.cell_facepos[c+1]; ++hf) {
+                    const int f = grid.cell_faces[hf];
+                    const int* fnbeg = grid.face_nodes + grid.face_nodepos[f];
+                    const int* fnend = grid.face_nodes + grid.face_nodepos[f+1];
+                    cell_pts.insert(fnbeg, fnend);
+                    faces.push_back(fnend - fnbeg);
+                    faces.insert(faces.end(), fnbeg, fnend);
+                }
+                connectivity.insert(connectivity.end(), cell_pts.begin(), cell_pts.end());
+                offsets.push_back(connectivity.size());
+                faceoffsets.push_back(faces.size());
+            }
+            const std::vector<std::uint8_t> types(num_cells, 42);
+
+            // Avoiding denormal numbers to work around bug in Paraview.
+            std::vector<std::vector<double> > fields;
+            fields.reserve(data.size());
+            for (auto dit = data.begin(); dit != data.end(); ++dit) {
+                fields.push_back(*(dit->second));
+                for (auto& value : fields.back()) {
+                    if (std::fabs(value) < std::numeric_limits<double>::min()) {
+                        value = 0.0;
+                    }
+                }
+            }
+
+            std::vector<AppendedArray> arrays;
+            std::uint64_t offset = 0;
+            const std::uint16_t byte_order_probe = 1;
+            const bool little_endian = *reinterpret_cast<const char*>(&byte_order_probe) == 1;
+            PMap pm;
+            pm["type"] = "UnstructuredGrid";
+            pm["version"] = "1.0";
+            pm["byte_order"] = little_endian ? "LittleEndian" : "BigEndian";
+            pm["header_type"] = "UInt64";
+            Tag vtkfiletag("VTKFile", pm, os);
+            {
+                Tag ugtag("UnstructuredGrid", os);
+                pm.clear();
+                pm["NumberOfPoints"] = std::to_string(num_pts);
+                pm["NumberOfCells"] = std::to_string(num_cells);
+                Tag piecetag("Piece", pm, os);
+                {
+                    Tag pointstag("Points", os);
+                    pm.clear();
+                    pm["type"] = "Float64";
+                    pm["Name"] = "Coordinates";
+                    pm["NumberOfComponents"] = "3";
+                    arrays.push_back(AppendedArray{ reinterpret_cast<const char*>(grid.node_coordinates),
+                                                    std::uint64_t(3 * num_pts * sizeof(double)) });
+                    appendedDataArray(pm, arrays.back(), offset, os);
+                }
+                {
+                    Tag cellstag("Cells", os);
+                    pm.clear();
+                    pm["type"] = "Int32";
+                    pm["NumberOfComponents"] = "1";
+                    pm["Name"] = "connectivity";
+                    arrays.push_back(appendedArray(connectivity));
+                    appendedDataArray(pm, arrays.back(), offset, os);
+                    pm["Name"] = "offsets";
+                    arrays.push_back(appendedArray(offsets));
+                    appendedDataArray(pm, arrays.back(), offset, os);
+                    pm["Name"] = "faces";
+                    arrays.push_back(appendedArray(faces));
+                    appendedDataArray(pm, arrays.back(), offset, os);
+                    pm["Name"] = "faceoffsets";
+                    arrays.push_back(appendedArray(faceoffsets));
+                    appendedDataArray(pm, arrays.back(), offset, os);
+                    pm["type"] = "UInt8";
+                    pm["Name"] = "types";
+                    arrays.push_back(appendedArray(types));
+                    appendedDataArray(pm, arrays.back(), offset, os);
+                }
+                {
+                    pm.clear();
+                    if (data.find("saturation") != data.end()) {
+                        pm["Scalars"] = "saturation";
+                    } else if (data.find("pressure") != data.end()) {
+                        pm["Scalars"] = "pressure";
+                    }
+                    Tag celldatatag("CellData", pm, os);
+                    pm.clear();
+                    pm["type"] = "Float64";
+                    int field_index = 0;
+                    for (auto dit = data.begin(); dit != data.end(); ++dit, ++field_index) {
+                        const std::vector<double>& field = fields[field_index];
+                        pm["Name"] = dit->first;
+                        pm["NumberOfComponents"] = std::to_string(field.size()/grid.number_of_cells);
+                        arrays.push_back(appendedArray(field));
+                        appendedDataArray(pm, arrays.back(), offset, os);
+                    }
+                }
+            }
+            pm.clear();
+            pm["encoding"] = "raw";
+            Tag appendedtag("AppendedData", pm, os);
+            os << '_';
+            for (const auto& array : arrays) {
+                os.write(reinterpret_cast<const char*>(&array.bytes), sizeof(array.bytes));
+                os.write(array.data, array.bytes);
+            }
+            os << '\n';
+        }
+    } // anonymous namespace
 
 
     void writeVtkData(const UnstructuredGrid& grid,
                       const std::map< std::string, const std::vector< double >* >& data,
-                      std::ostream& os)
+                      std::ostream& os,
+                      const VtkFormat format)
     {
        if (grid.dimensions != 3) {
            OPM_THROW(std::runtime_error, "Vtk output for 3d grids only");
        }
+       if (format == VtkFormat::AppendedRaw) {
+           os << "<?xml version=\"1.0\"?>\n";
+           writeVtkDataAppended(grid, data, os);
+           return;
+       }
        os.precision(12);
        os << "<?xml version=\"1.0\"?>\n";
        PMap pm;
@@ -38,10 +38,20 @@ namespace Opm
                       const std::map< std::string, const std::vector< double >* >& data,
                       std::ostream& os);
 
+    /// Encoding of the data arrays of the VTU output for general grids.
+    enum class VtkFormat {
+        /// Formatted text inside the DataArray elements.
+        Ascii,
+        /// Raw binary in the AppendedData element, much faster to write
+        /// and read. The stream must be opened in binary mode.
+        AppendedRaw
+    };
+
     /// Vtk output for general grids.
     void writeVtkData(const UnstructuredGrid& ,
                       const std::map< std::string, const std::vector< double >* >& data,
-                      std::ostream& os);
+                      std::ostream& os,
+                      const VtkFormat format = VtkFormat::Ascii);
 } // namespace Opm
 
 #endif // OPM_WRITEVTKDATA_HEADER_INCLUDED
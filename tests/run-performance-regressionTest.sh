@@ -0,0 +1,86 @@
+#!/bin/bash
+
+# This runs a simulator for a deck and compares the wall time, the
+# Newton and linear iterations and the peak memory against a baseline.
+# Meant to catch performance regressions of the simulators.
+#
+# The baseline is BASELINE_PATH/EXE_NAME+FILENAME.perf, with one
+# "key value" line per measure. It is written from the run if it does
+# not exist, or if OPM_UPDATE_PERFORMANCE_BASELINE is set, and the test
+# passes. Otherwise the test fails if a measure exceeds its baseline by
+# more than the relative tolerance.
+
+INPUT_DATA_PATH="$1"
+RESULT_PATH="$2"
+BINPATH="$3"
+FILENAME="$4"
+BASELINE_PATH="$5"
+TIME_TOL="$6"
+ITER_TOL="$7"
+RSS_TOL="$8"
+EXE_NAME="${9}"
+shift 9
+TEST_ARGS="$@"
+
+rm -Rf ${RESULT_PATH}
+mkdir -p ${RESULT_PATH}
+cd ${RESULT_PATH}
+
+# value after the label of the final report in a log file
+report_value()
+{
+  grep "$2" "$1" | tail -n 1 | sed -e "s/.*$2[^0-9]*\([0-9.e+-]*\).*/\1/"
+}
+
+LOG=${RESULT_PATH}/run.log
+TIME_LOG=${RESULT_PATH}/time.log
+if [ -x /usr/bin/time ]
+then
+  /usr/bin/time -v -o ${TIME_LOG} ${BINPATH}/${EXE_NAME} ${TEST_ARGS} output_dir=${RESULT_PATH} > ${LOG} 2>&1
+else
+  ${BINPATH}/${EXE_NAME} ${TEST_ARGS} output_dir=${RESULT_PATH} > ${LOG} 2>&1
+fi
+if [ $? -ne 0 ]
+then
+  echo "The run of ${EXE_NAME} failed, see ${LOG}"
+  exit 1
+fi
+
+RUN=${RESULT_PATH}/${FILENAME}.perf
+echo "total_time $(report_value ${LOG} "Total time (seconds):")" > ${RUN}
+echo "newton_iterations $(report_value ${LOG} "Overall Newton Iterations:")" >> ${RUN}
+echo "linear_iterations $(report_value ${LOG} "Overall Linear Iterations:")" >> ${RUN}
+if [ -f ${TIME_LOG} ]
+then
+  echo "peak_rss_kb $(report_value ${TIME_LOG} "Maximum resident set size (kbytes):")" >> ${RUN}
+fi
+
+BASELINE=${BASELINE_PATH}/${EXE_NAME}+${FILENAME}.perf
+if [ ! -f ${BASELINE} ] || [ -n "${OPM_UPDATE_PERFORMANCE_BASELINE}" ]
+then
+  mkdir -p ${BASELINE_PATH}
+  cp ${RUN} ${BASELINE}
+  echo "=== Wrote the performance baseline ${BASELINE} ==="
+  cat ${RUN}
+  exit 0
+fi
+
+echo "=== Comparing the performance with ${BASELINE} ==="
+awk -v time_tol=${TIME_TOL} -v iter_tol=${ITER_TOL} -v rss_tol=${RSS_TOL} '
+  NR == FNR { base[$1] = $2; next }
+  ($1 in base) && base[$1] > 0 && $2 != "" {
+    tol = ($1 == "total_time") ? time_tol : ($1 == "peak_rss_kb") ? rss_tol : iter_tol
+    change = $2 / base[$1] - 1
+    status = (change > tol) ? "REGRESSION" : "ok"
+    if (change > tol) failed = 1
+    printf "%-20s %14g %14g %+8.1f%%  %s\n", $1, base[$1], $2, 100 * change, status
+  }
+  END { exit failed }' ${BASELINE} ${RUN}
+ecode=$?
+
+if [ $ecode -ne 0 ]
+then
+  echo "Performance regression of ${EXE_NAME} for ${FILENAME}, the run log is ${LOG}"
+fi
+
+exit $ecode
@@ -0,0 +1,87 @@
+#!/bin/bash
+
+# This runs a simulator for a deck with different numbers of MPI
+# processes and OpenMP threads and collects the timings into CSV tables.
+# Meant to track the parallel scaling of the simulators.
+#
+# Writes to RESULT_PATH:
+#   scaling.csv  - one line per run with the timings of the final report,
+#                  the summed linear solver telemetry of rank 0 and the
+#                  speedup / parallel efficiency relative to the first run.
+
+INPUT_DATA_PATH="$1"
+RESULT_PATH="$2"
+BINPATH="$3"
+FILENAME="$4"
+EXE_NAME="$5"
+RANKS="$6"    # comma separated, e.g. 1,2,4,8
+THREADS="$7"  # comma separated, e.g. 1,2
+shift 7
+TEST_ARGS="$@"
+
+rm -Rf ${RESULT_PATH}
+mkdir -p ${RESULT_PATH}
+cd ${RESULT_PATH}
+
+# value after the label of the final report in a log file
+report_value()
+{
+  grep "$2" "$1" | tail -n 1 | sed -e "s/.*$2[^0-9]*\([0-9.e+-]*\).*/\1/"
+}
+
+CSV=${RESULT_PATH}/scaling.csv
+echo "ranks,threads,total,solver,assembly,linear_solve,update,output,linearizations,newton_its,linear_its,prec_setup,prec_apply,spmv,well_apply,reduction,speedup,efficiency" > ${CSV}
+
+base_time=""
+base_cores=""
+ecode=0
+for np in ${RANKS//,/ }
+do
+  for nt in ${THREADS//,/ }
+  do
+    RUN_PATH=${RESULT_PATH}/np${np}_nt${nt}
+    mkdir -p ${RUN_PATH}
+    echo "=== Running ${EXE_NAME} with ${np} processes and ${nt} threads ==="
+    OMP_NUM_THREADS=${nt} mpirun -np ${np} ${BINPATH}/${EXE_NAME} ${TEST_ARGS}.DATA \
+      output_dir=${RUN_PATH} linear_solver_telemetry_file=${RUN_PATH}/telemetry \
+      > ${RUN_PATH}/run.log 2>&1
+    if [ $? -ne 0 ]
+    then
+      echo "Run with ${np} processes and ${nt} threads failed, see ${RUN_PATH}/run.log"
+      ecode=1
+      continue
+    fi
+
+    LOG=${RUN_PATH}/run.log
+    total=$(report_value ${LOG} "Total time (seconds):")
+    solver=$(report_value ${LOG} "Solver time (seconds):")
+    assembly=$(report_value ${LOG} "Assembly time (seconds):")
+    linsolve=$(report_value ${LOG} "Linear solve time (seconds):")
+    update=$(report_value ${LOG} "Update time (seconds):")
+    output=$(report_value ${LOG} "Output write time (seconds):")
+    linearizations=$(report_value ${LOG} "Overall Linearizations:")
+    newton=$(report_value ${LOG} "Overall Newton Iterations:")
+    linear=$(report_value ${LOG} "Overall Linear Iterations:")
+
+    # sum of the per time step telemetry of rank 0
+    telemetry=$(awk -F, 'NR > 1 { s += $6; a += $7; m += $8; w += $9; r += $10 }
+                         END { printf "%g,%g,%g,%g,%g", s, a, m, w, r }' ${RUN_PATH}/telemetry.0.csv 2>/dev/null)
+    test -n "${telemetry}" || telemetry=",,,,"
+
+    cores=$((np * nt))
+    if [ -z "${base_time}" ]
+    then
+      base_time=${total}
+      base_cores=${cores}
+    fi
+    scaling=$(awk -v t0=${base_time} -v c0=${base_cores} -v t=${total} -v c=${cores} \
+                  'BEGIN { s = t0 / t; printf "%g,%g", s, s * c0 / c }')
+
+    echo "${np},${nt},${total},${solver},${assembly},${linsolve},${update},${output},${linearizations},${newton},${linear},${telemetry},${scaling}" >> ${CSV}
+  done
+done
+
+echo "=== Scaling results ==="
+column -s, -t ${CSV} 2>/dev/null || cat ${CSV}
+
+exit $ecode
@@ -169,6 +169,59 @@ BOOST_AUTO_TEST_CASE(AdditionOps)
     BOOST_CHECK(x == ss);
 }
 
+BOOST_AUTO_TEST_CASE(InPlaceAdditionOps)
+{
+    // Setup.
+    Mat z = Mat(3, 3);
+    Mat i = Mat::createIdentity(3);
+
+    Eigen::Array<double, Eigen::Dynamic, 1> d1(3);
+    d1 << 0.2, 1.2, 13.4;
+    Mat d = Mat(d1.matrix().asDiagonal());
+
+    // With and without full main diagonal.
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> s1(3,3);
+    s1 <<
+        1.0, 0.0, 2.0,
+        0.0, 1.0, 0.0,
+        0.0, 0.0, 2.0;
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> s2(3,3);
+    s2 <<
+        1.0, 0.0, 2.0,
+        0.0, 0.0, 3.0,
+        4.0, 0.0, 2.0;
+    const Mat sa = Mat(Sp(s1.sparseView()));
+    const Mat sb = Mat(Sp(s2.sparseView()));
+
+    Sp x;
+    Sp y;
+    for (const Mat& s : { sa, sb }) {
+        for (const Mat& rhs : { z, i, d }) {
+            Mat ps = s;
+            ps += rhs;
+            ps.toSparse(x);
+            (s + rhs).toSparse(y);
+            BOOST_CHECK(x == y);
+
+            Mat ms = s;
+            ms -= rhs;
+            ms.toSparse(x);
+            (s + rhs * -1.0).toSparse(y);
+            BOOST_CHECK(x == y);
+        }
+    }
+
+    Mat dd = d;
+    dd += d;
+    dd.toSparse(x);
+    (d + d).toSparse(y);
+    BOOST_CHECK(x == y);
+    dd -= d;
+    dd.toSparse(x);
+    d.toSparse(y);
+    BOOST_CHECK(x == y);
+}
+
 BOOST_AUTO_TEST_CASE(MultOps)
 {
     // Setup.
@@ -425,3 +478,25 @@ BOOST_AUTO_TEST_CASE(nonZeros)
     BOOST_CHECK_EQUAL(s.nonZeros(), 4);
 }
 
+
+BOOST_AUTO_TEST_CASE(VisitNonZeros)
+{
+    Eigen::Array<double, Eigen::Dynamic, 1> d1(3);
+    d1 << 0.2, 1.2, 13.4;
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> s1(3,3);
+    s1 <<
+        1.0, 0.0, 2.0,
+        0.0, 1.0, 0.0,
+        0.0, 0.0, 2.0;
+
+    for (const Mat& m : { Mat(3, 3), Mat::createIdentity(3),
+                          Mat(d1.matrix().asDiagonal()), Mat(Sp(s1.sparseView())) }) {
+        Eigen::MatrixXd visited = Eigen::MatrixXd::Zero(3, 3);
+        m.visitNonZeros([&](const int row, const int col, const double value) {
+                visited(row, col) += value;
+            });
+        Sp x;
+        m.toSparse(x);
+        BOOST_CHECK(Sp(visited.sparseView()) == x);
+    }
+}
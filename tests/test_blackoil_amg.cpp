@@ -31,6 +31,9 @@
 #include <dune/common/parallel/collectivecommunication.hh>
 #include <dune/istl/bcrsmatrix.hh>
 #include <dune/istl/owneroverlapcopy.hh>
+#include <dune/istl/solvers.hh>
+
+#include <type_traits>
 
 class MPIError {
 public:
@@ -312,6 +315,60 @@ void runBlackoilAmgLaplace()
 
 }
 
+BOOST_AUTO_TEST_CASE(runBlackoilAmgMixedPrecisionSmoother)
+{
+    const int BS=2, N=100;
+    typedef Dune::FieldMatrix<double,BS,BS> MatrixBlock;
+    typedef Dune::BCRSMatrix<MatrixBlock> BCRSMat;
+    typedef Dune::FieldVector<double,BS> VectorBlock;
+    typedef Dune::BlockVector<VectorBlock> Vector;
+    typedef int GlobalId;
+    typedef Dune::OwnerOverlapCopyCommunication<GlobalId> Communication;
+    typedef Dune::Amg::CoarsenCriterion<Dune::Amg::SymmetricCriterion<BCRSMat,Dune::Amg::FirstDiagonal> >
+        Criterion;
+    typedef Opm::ISTLUtility::BlackoilAmgSelector<BCRSMat,Vector,Vector,Communication,
+                                                  Criterion,0,float> Selector;
+    typedef Selector::Operator Operator;
+    typedef Selector::AMG AMG;
+
+    // Only the fine level smoother stores its factors in single precision.
+    typedef Opm::Detail::ScalarType<Selector::Smoother>::value CoarseSmoother;
+    static_assert(std::is_same<Selector::Smoother::storage_block_type::field_type, float>::value,
+                  "The fine level smoother must store its factors in single precision");
+    static_assert(std::is_same<CoarseSmoother::storage_block_type::field_type, double>::value,
+                  "The coarse level smoothers must store their factors in double precision");
+
+    const auto& ccomm = Dune::MPIHelper::getCollectiveCommunication();
+
+    Communication comm(ccomm);
+    int n=0;
+    BCRSMat mat = setupAnisotropic2d<BCRSMat>(N, comm.indexSet(), comm.communicator(), &n, 1);
+
+    comm.remoteIndices().template rebuild<false>();
+
+    Vector b(mat.N()), x(mat.M());
+
+    b=0;
+    x=100;
+    setBoundary(x, b, N, comm.indexSet());
+
+    Operator fop(mat, comm);
+    Dune::OverlappingSchwarzScalarProduct<Vector,Communication> sp(comm);
+
+    Dune::InverseOperatorResult r;
+    AMG::SmootherArgs smootherArgs;
+    smootherArgs.iterations = 1;
+    Criterion criterion;
+    Opm::CPRParameter param;
+
+    AMG amg(param, fop, criterion, smootherArgs, comm);
+    BOOST_CHECK(Opm::MemoryAccounting::current(Opm::MemoryAccounting::AmgLevels) > 0);
+    Dune::BiCGSTABSolver<Vector> solver(fop, sp, amg, 1e-8, 300, 0);
+    solver.apply(x, b, r);
+
+    BOOST_CHECK(r.converged);
+}
+
 bool init_unit_test_func()
 {
     return true;
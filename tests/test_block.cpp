@@ -281,6 +281,45 @@ BOOST_AUTO_TEST_CASE(AssignAddSubtractOperators)
     checkClose(z, yconst, tolerance);
 }
 
+BOOST_AUTO_TEST_CASE(TemporaryOperands)
+{
+    typedef AutoDiffBlock<double> ADB;
+
+    ADB::V vx(3);
+    vx << 0.2, 1.2, 13.4;
+
+    ADB::V vy(3);
+    vy << 1.0, 2.2, 3.4;
+
+    std::vector<ADB::V> vals{ vx, vy };
+    std::vector<ADB> vars = ADB::variables(vals);
+
+    const ADB x = vars[0];
+    const ADB y = vars[1];
+    const ADB c = ADB::constant(vy);
+    const double tolerance = 1e-14;
+
+    // Results computed in a temporary have to equal the ones of the
+    // operators taking constant references.
+    ADB xy = x * y;
+    ADB xpy = x + y;
+    checkClose(x * y + x, xy + x, tolerance);
+    checkClose(x + x * y, x + xy, tolerance);
+    checkClose(x * y + y * x, xy + xy, tolerance);
+    checkClose(x * y - x, xy - x, tolerance);
+    checkClose((x + y) + vx, xpy + vx, tolerance);
+    checkClose(vx + (x + y), vx + xpy, tolerance);
+    checkClose((x + y) - vx, xpy - vx, tolerance);
+    checkClose((c + c) + x, ADB::constant(ADB::V(2 * vy)) + x, tolerance);
+    checkClose((c + c) - x, ADB::constant(ADB::V(2 * vy)) - x, tolerance);
+
+    // Operations with constants on either side.
+    checkClose(vx * y, ADB::constant(vx, y.blockPattern()) * y, tolerance);
+    checkClose(vx + y, ADB::constant(vx, y.blockPattern()) + y, tolerance);
+    checkClose(y - vx, y - ADB::constant(vx, y.blockPattern()), tolerance);
+    checkClose(vx * c, ADB::constant(ADB::V(vx * vy)), tolerance);
+}
+
 BOOST_AUTO_TEST_CASE(Pow)
 {
     typedef AutoDiffBlock<double> ADB;
@@ -0,0 +1,149 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE MatrixBlockKernelsTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/autodiff/MatrixBlockKernels.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <algorithm>
+#include <vector>
+
+template<class Field, int n>
+void checkKernels()
+{
+    Dune::FieldMatrix<Field, n, n> A;
+    Dune::FieldVector<double, n> x, y, yRef;
+    for ( int i = 0; i < n; ++i )
+    {
+        x[i] = 1.0 + i;
+        y[i] = 0.5 * i;
+        for ( int j = 0; j < n; ++j )
+        {
+            A[i][j] = 0.25 + i * n + j;
+        }
+    }
+
+    yRef = y;
+    A.mmv(x, yRef);
+    Opm::detail::blockMmv(A, x, y);
+    for ( int i = 0; i < n; ++i )
+    {
+        BOOST_CHECK_CLOSE(y[i], yRef[i], 1e-12);
+    }
+
+    A.umv(x, yRef);
+    Opm::detail::blockUmv(A, x, y);
+    for ( int i = 0; i < n; ++i )
+    {
+        BOOST_CHECK_CLOSE(y[i], yRef[i], 1e-12);
+    }
+
+    A.usmv(-3.0, x, yRef);
+    Opm::detail::blockUsmv(-3.0, A, x, y);
+    for ( int i = 0; i < n; ++i )
+    {
+        BOOST_CHECK_CLOSE(y[i], yRef[i], 1e-12);
+    }
+
+    A.mv(x, yRef);
+    Opm::detail::blockMv(A, x, y);
+    for ( int i = 0; i < n; ++i )
+    {
+        BOOST_CHECK_CLOSE(y[i], yRef[i], 1e-12);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(BlockKernelsDouble)
+{
+    checkKernels<double, 1>();
+    checkKernels<double, 2>();
+    checkKernels<double, 3>();
+    checkKernels<double, 4>();
+    checkKernels<double, 5>();
+}
+
+BOOST_AUTO_TEST_CASE(BlockKernelsFloatBlocks)
+{
+    checkKernels<float, 3>();
+    checkKernels<float, 4>();
+}
+
+BOOST_AUTO_TEST_CASE(MaskedRows)
+{
+    typedef Dune::FieldMatrix<double, 2, 2> Block;
+    typedef Dune::BCRSMatrix<Block> Matrix;
+    typedef Dune::BlockVector<Dune::FieldVector<double, 2> > Vector;
+
+    // tridiagonal 3x3 block matrix
+    const int n = 3;
+    Matrix A(n, n, Matrix::row_wise);
+    for ( auto row = A.createbegin(); row != A.createend(); ++row )
+    {
+        const int i = row.index();
+        for ( int j = std::max(i - 1, 0); j <= std::min(i + 1, n - 1); ++j )
+        {
+            row.insert(j);
+        }
+    }
+    for ( auto row = A.begin(); row != A.end(); ++row )
+    {
+        for ( auto col = row->begin(); col != row->end(); ++col )
+        {
+            *col = 1.0 + row.index() + 0.5 * col.index();
+        }
+    }
+
+    Vector x(n), y(n), yRef(n);
+    for ( int i = 0; i < n; ++i )
+    {
+        x[i][0] = 1.0 + i;
+        x[i][1] = 2.0 - i;
+    }
+
+    const std::vector<bool> mask = { true, false, true };
+    A.mv(x, yRef);
+    Opm::detail::bcrsMv(A, x, y, mask);
+    for ( int i = 0; i < n; ++i )
+    {
+        for ( int k = 0; k < 2; ++k )
+        {
+            BOOST_CHECK_CLOSE(y[i][k], mask[i] ? yRef[i][k] : 0.0, 1e-12);
+        }
+    }
+
+    y = 1.0;
+    yRef = 1.0;
+    A.usmv(-2.0, x, yRef);
+    Opm::detail::bcrsUsmv(-2.0, A, x, y, mask);
+    for ( int i = 0; i < n; ++i )
+    {
+        for ( int k = 0; k < 2; ++k )
+        {
+            BOOST_CHECK_CLOSE(y[i][k], mask[i] ? yRef[i][k] : 1.0, 1e-12);
+        }
+    }
+}
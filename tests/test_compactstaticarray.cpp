@@ -0,0 +1,67 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE CompactStaticArrayTest
+
+#include <opm/autodiff/CompactStaticArray.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <cstddef>
+
+namespace
+{
+    // Cell depths [m] of a deep reservoir.
+    double depth(const std::size_t cell)
+    {
+        return 3000.0 + 0.37 * cell + 1e-3 * std::sin(double(cell));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(DoublePrecisionIsExact)
+{
+    Opm::CompactStaticArray values;
+    values.assign(1000, depth);
+    BOOST_CHECK(!values.singlePrecision());
+    BOOST_REQUIRE_EQUAL(values.size(), 1000u);
+    for (std::size_t cell = 0; cell < values.size(); ++cell) {
+        BOOST_CHECK_EQUAL(values[cell], depth(cell));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SinglePrecisionIsBounded)
+{
+    Opm::CompactStaticArray values(true);
+    values.assign(1000, depth);
+    BOOST_CHECK(values.singlePrecision());
+    BOOST_REQUIRE_EQUAL(values.size(), 1000u);
+    BOOST_CHECK(values.memoryBytes() < 1000 * sizeof(double));
+
+    // The hydrostatic head between a cell and a perforation of a well,
+    // rho*g*dz, deviates by less than 10 Pa for water.
+    const double rho_g = 1000.0 * 9.80665;
+    for (std::size_t cell = 0; cell < values.size(); ++cell) {
+        const double error = std::abs(values[cell] - depth(cell));
+        BOOST_CHECK(error <= std::ldexp(std::abs(depth(cell)), -24));
+        BOOST_CHECK(rho_g * error < 10.0);
+    }
+}
@@ -0,0 +1,94 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE DeferredLoggerTest
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/DeferredLogger.hpp>
+
+#include <opm/common/OpmLog/CounterLog.hpp>
+#include <opm/common/OpmLog/OpmLog.hpp>
+
+#include <memory>
+#include <string>
+
+bool
+init_unit_test_func()
+{
+    return true;
+}
+
+BOOST_AUTO_TEST_CASE(LazyDebugNeedsDebugLog)
+{
+    Opm::OpmLog::removeAllBackends();
+    Opm::DeferredLogger logger;
+    int calls = 0;
+    const auto makeMessage = [&calls]() {
+        ++calls;
+        return std::string("formatted");
+    };
+
+    logger.lazyDebug(makeMessage);
+    BOOST_CHECK_EQUAL(calls, 0);
+    BOOST_CHECK(logger.messages().empty());
+
+    auto counter = std::make_shared<Opm::CounterLog>();
+    Opm::OpmLog::addBackend("DEBUGLOG", counter);
+    logger.lazyDebug(makeMessage);
+    BOOST_CHECK_EQUAL(calls, 1);
+    BOOST_CHECK_EQUAL(logger.messages().size(), 1u);
+    Opm::OpmLog::removeAllBackends();
+}
+
+BOOST_AUTO_TEST_CASE(MessagesLoggedOnFlush)
+{
+    auto cc = Dune::MPIHelper::getCollectiveCommunication();
+    Opm::OpmLog::removeAllBackends();
+    auto counter = std::make_shared<Opm::CounterLog>();
+    Opm::OpmLog::addBackend("COUNTER", counter);
+
+    Opm::DeferredLogger logger(cc);
+    logger.info("Info on rank " + std::to_string(cc.rank()));
+    if (cc.rank() == cc.size() - 1) {
+        logger.warning("Warning on the last rank");
+    }
+    BOOST_CHECK_EQUAL(counter->numMessages(Opm::Log::MessageType::Info), 0u);
+
+    logger.logMessages();
+    BOOST_CHECK(logger.messages().empty());
+    if (cc.rank() == 0) {
+        BOOST_CHECK_EQUAL(counter->numMessages(Opm::Log::MessageType::Info), static_cast<std::size_t>(cc.size()));
+        BOOST_CHECK_EQUAL(counter->numMessages(Opm::Log::MessageType::Warning), 1u);
+    }
+
+    // nothing to log anywhere
+    logger.logMessages();
+    Opm::OpmLog::removeAllBackends();
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    boost::unit_test::unit_test_main(&init_unit_test_func,
+                                     argc, argv);
+}
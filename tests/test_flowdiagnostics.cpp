@@ -25,6 +25,14 @@
 #define BOOST_TEST_MODULE FlowDiagnosticsTests
 #include <boost/test/unit_test.hpp>
 #include <opm/core/flowdiagnostics/FlowDiagnostics.hpp>
+#include <opm/core/flowdiagnostics/FlowDiagnosticsEnsemble.hpp>
+#include <opm/core/flowdiagnostics/TofReorder.hpp>
+#include <opm/core/wells.h>
+#include <opm/grid/GridManager.hpp>
+#include <opm/grid/UnstructuredGrid.h>
+#include <opm/grid/utility/SparseTable.hpp>
+
+#include <memory>
 
 const std::vector<double> pv(16, 18750.0);
 
@@ -193,3 +201,110 @@ BOOST_AUTO_TEST_CASE(Sweep)
     compareCollections(et.first, Ev);
     compareCollections(et.second, tD);
 }
+
+
+
+
+// Flux field on a 4x2 cartesian grid: flow in the x direction with the
+// velocity v[j] in layer j, from the cells of the left column (injector)
+// to the cells of the right column (producer).
+struct LayeredFlow
+{
+    LayeredFlow(const UnstructuredGrid& g, const double v0, const double v1)
+        : flux(g.number_of_faces, 0.0), source(g.number_of_cells, 0.0), pv(g.number_of_cells, 1.0)
+    {
+        const double v[2] = { v0, v1 };
+        for (int f = 0; f < g.number_of_faces; ++f) {
+            const int c0 = g.face_cells[2*f];
+            const int c1 = g.face_cells[2*f + 1];
+            if (c0 >= 0 && c1 >= 0) {
+                flux[f] = g.face_normals[2*f] * v[c0 / 4];
+            }
+        }
+        for (int j = 0; j < 2; ++j) {
+            source[4*j] = v[j];
+            source[4*j + 3] = -v[j];
+        }
+    }
+
+    FlowDiagnosticsEnsemble::FlowField field() const
+    {
+        return FlowDiagnosticsEnsemble::FlowField{ flux.data(), pv.data(), source.data() };
+    }
+
+    std::vector<double> flux;
+    std::vector<double> source;
+    std::vector<double> pv;
+};
+
+
+
+BOOST_AUTO_TEST_CASE(Ensemble)
+{
+    const GridManager gm(4, 2);
+    const UnstructuredGrid& g = *gm.c_grid();
+
+    std::shared_ptr<Wells> wells(create_wells(1, 2, 4), destroy_wells);
+    const double comp_frac[1] = { 1.0 };
+    const double wi[2] = { 1.0, 1.0 };
+    const int inj_cells[2] = { 0, 4 };
+    const int prod_cells[2] = { 3, 7 };
+    BOOST_REQUIRE(add_well(INJECTOR, 0.0, 2, comp_frac, inj_cells, wi, nullptr, "INJ", 1, wells.get()));
+    BOOST_REQUIRE(add_well(PRODUCER, 0.0, 2, comp_frac, prod_cells, wi, nullptr, "PROD", 1, wells.get()));
+
+    const std::vector<double> phi_samples = { 0.0, 0.25, 0.5, 0.75, 1.0 };
+    const std::vector<double> td_samples = { 0.0, 0.5, 1.0, 2.0 };
+    FlowDiagnosticsEnsemble ensemble(g, *wells, phi_samples, td_samples);
+
+    const std::vector<LayeredFlow> flows = { LayeredFlow(g, 1.0, 1.0),
+                                             LayeredFlow(g, 1.0, 3.0),
+                                             LayeredFlow(g, 2.0, 0.5) };
+    std::vector<FlowDiagnosticsEnsemble::FlowField> fields;
+    for (const auto& flow : flows) {
+        fields.push_back(flow.field());
+    }
+    const auto stats = ensemble.compute(fields);
+    BOOST_REQUIRE_EQUAL(stats.size(), flows.size());
+
+    // Homogeneous flow: piston-like displacement.
+    BOOST_CHECK_SMALL(stats[0].lorenz, 1e-12);
+    compareCollections(stats[0].flow_capacity, phi_samples);
+
+    // Compare with the diagnostics of a direct solve.
+    SparseTable<int> inj_heads;
+    inj_heads.appendRow(inj_cells, inj_cells + 2);
+    SparseTable<int> prod_heads;
+    prod_heads.appendRow(prod_cells, prod_cells + 2);
+    for (std::size_t i = 0; i < flows.size(); ++i) {
+        std::vector<double> ftof, btof, ftracer, btracer;
+        TofReorder tof_solver(g);
+        tof_solver.solveTofTracer(flows[i].flux.data(), flows[i].pv.data(), flows[i].source.data(),
+                                  inj_heads, ftof, ftracer);
+        std::vector<double> rflux(flows[i].flux);
+        std::vector<double> rsource(flows[i].source);
+        for (auto& q : rflux) {
+            q = -q;
+        }
+        for (auto& q : rsource) {
+            q = -q;
+        }
+        tof_solver.solveTofTracer(rflux.data(), flows[i].pv.data(), rsource.data(),
+                                  prod_heads, btof, btracer);
+        const auto fphi = computeFandPhi(flows[i].pv, ftof, btof);
+        BOOST_CHECK_CLOSE(stats[i].lorenz + 1.0, computeLorenz(fphi.first, fphi.second) + 1.0, 1e-10);
+        BOOST_CHECK_EQUAL(stats[i].flow_capacity.size(), phi_samples.size());
+        BOOST_CHECK_EQUAL(stats[i].sweep_efficiency.size(), td_samples.size());
+
+        const auto pairs = computeWellPairs(*wells, flows[i].pv, ftracer, btracer);
+        BOOST_REQUIRE_EQUAL(stats[i].well_pairs.size(), pairs.size());
+        for (std::size_t p = 0; p < pairs.size(); ++p) {
+            BOOST_CHECK_EQUAL(std::get<0>(stats[i].well_pairs[p]), std::get<0>(pairs[p]));
+            BOOST_CHECK_EQUAL(std::get<1>(stats[i].well_pairs[p]), std::get<1>(pairs[p]));
+            BOOST_CHECK_CLOSE(std::get<2>(stats[i].well_pairs[p]), std::get<2>(pairs[p]), 1e-10);
+        }
+    }
+
+    // Heterogeneous layers sweep less than the homogeneous case.
+    BOOST_CHECK(stats[1].lorenz > 0.1);
+    BOOST_CHECK(stats[1].sweep_efficiency[2] < stats[0].sweep_efficiency[2]);
+}
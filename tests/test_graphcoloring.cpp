@@ -6,6 +6,8 @@
 
 #include <opm/autodiff/GraphColoring.hpp>
 
+#include <cstdlib>
+
 #define BOOST_TEST_MODULE GraphColoringTest
 #define BOOST_TEST_MAIN
 
@@ -99,3 +101,42 @@ BOOST_AUTO_TEST_CASE(TestWelschPowell)
                                            graph, 0);
     checkAllIndices(newOrder);
 }
+
+BOOST_AUTO_TEST_CASE(TestReverseCuthillMcKee)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double,1,1>>;
+    using Graph = Dune::Amg::MatrixGraph<Matrix>;
+    // A path 0-1-...-(N-1) numbered with large jumps between neighbours.
+    int N = 16;
+    std::vector<int> cell(N);
+    for( int i = 0; i < N; i++)
+    {
+        cell[i] = (5*i) % N;
+    }
+    Matrix matrix(N, N, 3, 0.4, Matrix::implicit);
+    for( int i = 0; i < N; i++)
+    {
+        matrix.entry(cell[i], cell[i]) = 1;
+        if ( i > 0 )
+        {
+            matrix.entry(cell[i], cell[i-1]) = 1;
+        }
+        if ( i < N - 1 )
+        {
+            matrix.entry(cell[i], cell[i+1]) = 1;
+        }
+    }
+    matrix.compress();
+
+    Graph graph(matrix);
+    auto newOrder = Opm::reorderVerticesReverseCuthillMcKee(graph);
+    checkAllIndices(newOrder);
+
+    // The path has bandwidth one in the new numbering.
+    for( int i = 0; i < N - 1; i++)
+    {
+        auto distance = static_cast<std::ptrdiff_t>(newOrder[cell[i]]) -
+            static_cast<std::ptrdiff_t>(newOrder[cell[i+1]]);
+        BOOST_CHECK(std::abs(distance) == 1);
+    }
+}
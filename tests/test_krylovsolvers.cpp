@@ -0,0 +1,200 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE KrylovSolversTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/autodiff/KrylovSolvers.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioners.hh>
+#include <dune/istl/scalarproducts.hh>
+#include <dune/istl/solvers.hh>
+
+typedef Dune::FieldMatrix<double, 2, 2> Block;
+typedef Dune::BCRSMatrix<Block> Matrix;
+typedef Dune::BlockVector<Dune::FieldVector<double, 2> > Vector;
+
+// Nonsymmetric 1D convection diffusion problem with 2x2 blocks. The smaller
+// the diagonal the worse the conditioning, for 2 the rows sum up to zero
+// except at the boundaries.
+Matrix createMatrix(int n, double diagonal = 4.0)
+{
+    Matrix A(n, n, 3 * n, Matrix::row_wise);
+    for ( auto row = A.createbegin(); row != A.createend(); ++row )
+    {
+        const int i = row.index();
+        if ( i > 0 )
+        {
+            row.insert(i - 1);
+        }
+        row.insert(i);
+        if ( i < n - 1 )
+        {
+            row.insert(i + 1);
+        }
+    }
+    for ( int i = 0; i < n; ++i )
+    {
+        A[i][i] = 0.0;
+        A[i][i][0][0] = diagonal;
+        A[i][i][1][1] = diagonal;
+        A[i][i][0][1] = 0.5;
+        A[i][i][1][0] = -0.25;
+        if ( i > 0 )
+        {
+            A[i][i-1] = 0.0;
+            A[i][i-1][0][0] = -1.5;
+            A[i][i-1][1][1] = -1.5;
+        }
+        if ( i < n - 1 )
+        {
+            A[i][i+1] = 0.0;
+            A[i][i+1][0][0] = -0.5;
+            A[i][i+1][1][1] = -0.5;
+        }
+    }
+    return A;
+}
+
+BOOST_AUTO_TEST_CASE(BiCGSTABWithWorkspace)
+{
+    const int n = 50;
+    Matrix A = createMatrix(n);
+    Dune::MatrixAdapter<Matrix, Vector, Vector> op(A);
+    Dune::SeqScalarProduct<Vector> sp;
+    Dune::SeqJac<Matrix, Vector, Vector> prec(A, 1, 1.0);
+
+    Vector b(n), x(n), xRef(n);
+    for ( int i = 0; i < n; ++i )
+    {
+        b[i][0] = 1.0 + i;
+        b[i][1] = 1.0 - 0.5 * i;
+    }
+
+    Dune::InverseOperatorResult resRef;
+    Vector bRef(b);
+    xRef = 0.0;
+    Dune::BiCGSTABSolver<Vector> dune(op, sp, prec, 1e-10, 200, 0);
+    dune.apply(xRef, bRef, resRef);
+
+    Opm::KrylovWorkspace<Vector> workspace;
+    // Solve twice to check that the reused workspace gives the same results.
+    for ( int solve = 0; solve < 2; ++solve )
+    {
+        Dune::InverseOperatorResult res;
+        Vector rhs(b);
+        x = 0.0;
+        Opm::BiCGSTABSolverWithWorkspace<Vector> linsolve(op, sp, prec, 1e-10, 200, 0, workspace);
+        linsolve.apply(x, rhs, res);
+
+        BOOST_CHECK(res.converged);
+        BOOST_CHECK_EQUAL(res.iterations, resRef.iterations);
+        for ( int i = 0; i < n; ++i )
+        {
+            BOOST_CHECK_CLOSE(x[i][0], xRef[i][0], 1e-8);
+            BOOST_CHECK_CLOSE(x[i][1], xRef[i][1], 1e-8);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(PipelinedBiCGSTAB)
+{
+    const int n = 50;
+    Matrix A = createMatrix(n);
+    Dune::MatrixAdapter<Matrix, Vector, Vector> op(A);
+    Dune::SeqJac<Matrix, Vector, Vector> prec(A, 1, 1.0);
+    Dune::Amg::SequentialInformation info;
+
+    Vector b(n), x(n), rhs(n);
+    for ( int i = 0; i < n; ++i )
+    {
+        b[i][0] = 1.0 + i;
+        b[i][1] = 1.0 - 0.5 * i;
+    }
+
+    const double bNorm = b.two_norm();
+    Dune::InverseOperatorResult res;
+    Opm::KrylovWorkspace<Vector> workspace;
+    rhs = b;
+    x = 0.0;
+    Opm::PipelinedBiCGSTABSolver<Vector, Dune::Amg::SequentialInformation>
+        linsolve(op, prec, info, 1e-10, 200, 0, workspace);
+    linsolve.apply(x, rhs, res);
+    BOOST_CHECK(res.converged);
+
+    // Check the true residual, not only the recursively updated one.
+    A.mmv(x, b);
+    BOOST_CHECK_SMALL(b.two_norm(), 1e-8 * bNorm);
+}
+
+BOOST_AUTO_TEST_CASE(RecyclingGCR)
+{
+    const int n = 50;
+    // an ill conditioned system, the slow modes of which are worth deflating
+    Matrix A = createMatrix(n, 2.0);
+    Dune::MatrixAdapter<Matrix, Vector, Vector> op(A);
+    Dune::SeqScalarProduct<Vector> sp;
+    Dune::SeqJac<Matrix, Vector, Vector> prec(A, 1, 1.0);
+    Dune::Amg::SequentialInformation info;
+
+    Opm::KrylovWorkspace<Vector> workspace;
+    Opm::KrylovRecycleSpace<Vector> recycle(4);
+    // The later solves start with the directions kept from the earlier ones,
+    // which deflate the slowest modes and save iterations.
+    int firstIterations = 0;
+    for ( int solve = 0; solve < 3; ++solve )
+    {
+        Vector b(n), x(n), rhs(n);
+        for ( int i = 0; i < n; ++i )
+        {
+            b[i][0] = 1.0 + i + solve;
+            b[i][1] = 1.0 - 0.5 * i;
+        }
+        const double bNorm = b.two_norm();
+
+        Dune::InverseOperatorResult res;
+        rhs = b;
+        x = 0.0;
+        Opm::RecyclingGCRSolver<Vector, Dune::Amg::SequentialInformation>
+            linsolve(op, sp, prec, info, 1e-10, 10, 1000, 0, workspace, recycle);
+        linsolve.apply(x, rhs, res);
+        BOOST_CHECK(res.converged);
+        BOOST_CHECK(recycle.size() > 0);
+        BOOST_CHECK(recycle.size() <= 4);
+        if ( solve == 0 )
+        {
+            firstIterations = res.iterations;
+        }
+        else
+        {
+            BOOST_CHECK_LT(res.iterations, firstIterations);
+        }
+
+        // Check the true residual, not only the recursively updated one.
+        A.mmv(x, b);
+        BOOST_CHECK_SMALL(b.two_norm(), 1e-8 * bNorm);
+    }
+}
@@ -121,6 +121,41 @@ void run_test(const Opm::ParameterGroup& param)
 }
 
 
+void run_repeated_test(const Opm::ParameterGroup& param)
+{
+    // Same pattern with new values, as in consecutive pressure solves.
+    Opm::LinearSolverFactory ls(param);
+    int N=4;
+    auto mat = createLaplacian(N);
+    for (int k=1; k<=4; ++k)
+    {
+        for (auto& a : mat->data)
+            a *= k;
+        // Two right hand sides for each matrix.
+        for (int rhs=0; rhs<2; ++rhs)
+        {
+            std::vector<double> x, b;
+            createRandomVectors(N*N, x, b, *mat);
+            std::vector<double> exact(x);
+            std::fill(x.begin(), x.end(), 0.0);
+            ls.solve(N*N, mat->data.size(), &(mat->rowStart[0]),
+                     &(mat->colIndex[0]), &(mat->data[0]), &(b[0]),
+                     &(x[0]));
+            for (int i=0; i<N*N; ++i)
+                BOOST_CHECK_CLOSE(x[i], exact[i], 1e-6);
+        }
+    }
+}
+
+#if HAVE_SUITESPARSE_UMFPACK_H
+BOOST_AUTO_TEST_CASE(UmfpackRepeatedSolveTest)
+{
+    Opm::ParameterGroup param;
+    param.insertParameter(std::string("linsolver"), std::string("umfpack"));
+    run_repeated_test(param);
+}
+#endif
+
 BOOST_AUTO_TEST_CASE(DefaultTest)
 {
     Opm::ParameterGroup param;
@@ -140,6 +175,39 @@ BOOST_AUTO_TEST_CASE(CGAMGTest)
     run_test(param);
 }
 
+BOOST_AUTO_TEST_CASE(RepeatedSolveTest)
+{
+    Opm::ParameterGroup param;
+    param.insertParameter(std::string("linsolver"), std::string("istl"));
+    param.insertParameter(std::string("linsolver_type"), std::string("1"));
+    param.insertParameter(std::string("linsolver_residual_tolerance"), std::string("1e-12"));
+    param.insertParameter(std::string("linsolver_max_iterations"), std::string("200"));
+    run_repeated_test(param);
+}
+
+BOOST_AUTO_TEST_CASE(AMGReuseTest)
+{
+    Opm::ParameterGroup param;
+    param.insertParameter(std::string("linsolver"), std::string("istl"));
+    param.insertParameter(std::string("linsolver_type"), std::string("1"));
+    param.insertParameter(std::string("linsolver_residual_tolerance"), std::string("1e-12"));
+    param.insertParameter(std::string("linsolver_max_iterations"), std::string("200"));
+    param.insertParameter(std::string("linsolver_amg_rebuild_interval"), std::string("3"));
+    run_repeated_test(param);
+}
+
+BOOST_AUTO_TEST_CASE(AMGFrozenReuseTest)
+{
+    Opm::ParameterGroup param;
+    param.insertParameter(std::string("linsolver"), std::string("istl"));
+    param.insertParameter(std::string("linsolver_type"), std::string("1"));
+    param.insertParameter(std::string("linsolver_residual_tolerance"), std::string("1e-12"));
+    param.insertParameter(std::string("linsolver_max_iterations"), std::string("200"));
+    param.insertParameter(std::string("linsolver_amg_rebuild_interval"), std::string("3"));
+    param.insertParameter(std::string("linsolver_amg_recalculate"), std::string("false"));
+    run_repeated_test(param);
+}
+
 BOOST_AUTO_TEST_CASE(CGILUTest)
 {
     Opm::ParameterGroup param;
@@ -189,6 +257,8 @@ BOOST_AUTO_TEST_CASE(PETScTest)
     param.insertParameter(std::string("pc_type"), std::string("jacobi"));
     param.insertParameter(std::string("ksp_rtol"), std::string("1e-10"));
     param.insertParameter(std::string("ksp_view"), std::string("0"));
-    run_test(param);
+    // One case only, as every solver object initialises and finalises PETSc.
+    param.insertParameter(std::string("ksp_reuse_pc"), std::string("1"));
+    run_repeated_test(param);
 }
 #endif
@@ -0,0 +1,147 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE LinearSolverTunerTest
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/autodiff/LinearSolverTuner.hpp>
+
+#include <dune/common/exceptions.hh>
+#include <dune/istl/istlexception.hh>
+
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+double noReduction(const double value)
+{
+    return value;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(InactiveByDefault)
+{
+    const Opm::LinearSolverTuner tuner;
+    BOOST_CHECK(!tuner.tuning());
+}
+
+BOOST_AUTO_TEST_CASE(DistinctCandidates)
+{
+    const Opm::NewtonIterationBlackoilInterleavedParameters base;
+    const Opm::LinearSolverTuner tuner(base, /*withAmg=*/true, /*rounds=*/1);
+    const Opm::LinearSolverTuner tunerNoAmg(base, /*withAmg=*/false, /*rounds=*/1);
+    // the default configuration is ILU(0) with BiCGStab, which is one of the
+    // variations, and AMG and CPR are only tried if available
+    BOOST_CHECK_EQUAL(tuner.numCandidates(), 7u);
+    BOOST_CHECK_EQUAL(tunerNoAmg.numCandidates(), 5u);
+    BOOST_CHECK_EQUAL(Opm::LinearSolverTuner::describe(tuner.baseParameters()),
+                      Opm::LinearSolverTuner::describe(base));
+}
+
+BOOST_AUTO_TEST_CASE(ChoosesFastest)
+{
+    Opm::NewtonIterationBlackoilInterleavedParameters base;
+    base.ilu_fillin_level_ = 2;
+    const int rounds = 2;
+    Opm::LinearSolverTuner tuner(base, /*withAmg=*/false, rounds);
+    const std::size_t n = tuner.numCandidates();
+    BOOST_REQUIRE_EQUAL(n, 6u);
+
+    // candidate 2 is the fastest, candidate 3 fails in the first round and is
+    // not tried again
+    std::set<std::string> tried;
+    int solves = 0;
+    for (std::size_t i = 0; tuner.tuning(); ++i) {
+        const std::size_t candidate = i % n;
+        tried.insert(Opm::LinearSolverTuner::describe(tuner.parameters()));
+        const double seconds = candidate == 2 ? 1.0 : 2.0 + candidate;
+        tuner.record(seconds, candidate != 3);
+        ++solves;
+        if (candidate == 2 && i >= n) {
+            // skip the slot of the failed candidate in the second round
+            ++i;
+        }
+    }
+    BOOST_CHECK_EQUAL(solves, rounds * static_cast<int>(n) - 1);
+    BOOST_CHECK_EQUAL(tried.size(), n);
+    BOOST_CHECK_EQUAL(tuner.best(), 2u);
+
+    // the choice is kept
+    const std::string chosen = Opm::LinearSolverTuner::describe(tuner.parameters());
+    BOOST_CHECK(!tuner.record(10.0, true));
+    BOOST_CHECK_EQUAL(Opm::LinearSolverTuner::describe(tuner.parameters()), chosen);
+    BOOST_CHECK(tuner.summary().find("Chosen linear solver: " + chosen) != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(ThrowingCandidateFallsBackToBase)
+{
+    const Opm::NewtonIterationBlackoilInterleavedParameters base;
+    Opm::LinearSolverTuner tuner(base, /*withAmg=*/false, /*rounds=*/2);
+    const std::size_t n = tuner.numCandidates();
+    BOOST_REQUIRE_GT(n, 2u);
+
+    // candidate 1 breaks down, the system is then solved with the
+    // configuration of the user, and candidate 1 is not tried again
+    BOOST_CHECK(tuner.record(1.0, true));
+    const std::string failing = Opm::LinearSolverTuner::describe(tuner.parameters());
+    std::vector<std::string> calls;
+    const auto solve = [&](const Opm::NewtonIterationBlackoilInterleavedParameters& param) {
+        calls.push_back(Opm::LinearSolverTuner::describe(param));
+        if (calls.back() == failing) {
+            DUNE_THROW(Dune::ISTLError, "breakdown");
+        }
+        return true;
+    };
+    BOOST_CHECK(tuner.solve(solve, noReduction));
+    BOOST_REQUIRE_EQUAL(calls.size(), 2u);
+    BOOST_CHECK_EQUAL(calls[0], failing);
+    BOOST_CHECK_EQUAL(calls[1], Opm::LinearSolverTuner::describe(tuner.baseParameters()));
+
+    calls.clear();
+    while (tuner.tuning()) {
+        BOOST_CHECK(tuner.solve(solve, noReduction));
+    }
+    BOOST_CHECK_EQUAL(calls.size(), 2 * n - 3);
+    for (const std::string& call : calls) {
+        BOOST_CHECK(call != failing);
+    }
+    BOOST_CHECK(Opm::LinearSolverTuner::describe(tuner.parameters()) != failing);
+}
+
+BOOST_AUTO_TEST_CASE(ThrowingBaseIsPassedOn)
+{
+    const Opm::NewtonIterationBlackoilInterleavedParameters base;
+    Opm::LinearSolverTuner tuner(base, /*withAmg=*/false, /*rounds=*/1);
+    BOOST_REQUIRE(tuner.tuning());
+
+    int calls = 0;
+    const auto solve = [&calls](const Opm::NewtonIterationBlackoilInterleavedParameters&) -> bool {
+        ++calls;
+        DUNE_THROW(Dune::MatrixBlockError, "singular block");
+    };
+    BOOST_CHECK_THROW(tuner.solve(solve, noReduction), Dune::MatrixBlockError);
+    BOOST_CHECK_EQUAL(calls, 1);
+}
@@ -0,0 +1,85 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE MemoryAccountingTest
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/MemoryAccounting.hpp>
+
+#include <vector>
+
+using Opm::MemoryAccounting;
+
+bool
+init_unit_test_func()
+{
+    return true;
+}
+
+BOOST_AUTO_TEST_CASE(CurrentAndPeak)
+{
+    {
+        MemoryAccounting::Account matrix(MemoryAccounting::Matrix);
+        MemoryAccounting::Account wells(MemoryAccounting::WellMatrices);
+        matrix.set(1000);
+        wells.set(300);
+        {
+            MemoryAccounting::Account other(MemoryAccounting::Matrix);
+            other.set(500);
+            BOOST_CHECK_EQUAL(MemoryAccounting::current(MemoryAccounting::Matrix), 1500u);
+        }
+        BOOST_CHECK_EQUAL(MemoryAccounting::current(MemoryAccounting::Matrix), 1000u);
+        matrix.set(200);
+        BOOST_CHECK_EQUAL(MemoryAccounting::current(MemoryAccounting::Matrix), 200u);
+        BOOST_CHECK_EQUAL(MemoryAccounting::peak(MemoryAccounting::Matrix), 1500u);
+        BOOST_CHECK_EQUAL(MemoryAccounting::peak(MemoryAccounting::WellMatrices), 300u);
+        BOOST_CHECK_EQUAL(MemoryAccounting::peakTotal(), 1800u);
+    }
+    BOOST_CHECK_EQUAL(MemoryAccounting::current(MemoryAccounting::Matrix), 0u);
+    BOOST_CHECK_EQUAL(MemoryAccounting::current(MemoryAccounting::WellMatrices), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(VectorBytes)
+{
+    std::vector<double> v;
+    v.reserve(10);
+    BOOST_CHECK_EQUAL(MemoryAccounting::bytes(v), 10 * sizeof(double));
+}
+
+BOOST_AUTO_TEST_CASE(Report)
+{
+    MemoryAccounting::Account krylov(MemoryAccounting::Krylov);
+    krylov.set(1 << 20);
+    MemoryAccounting::report("Memory at report step 0", false);
+    MemoryAccounting::report("Peak memory", true);
+#ifdef __linux__
+    BOOST_CHECK(MemoryAccounting::residentBytes() > 0);
+    BOOST_CHECK(MemoryAccounting::peakResidentBytes() >= MemoryAccounting::residentBytes());
+#endif
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
@@ -191,3 +191,198 @@ BOOST_AUTO_TEST_CASE(MILULaplace4)
 {
     test<4>();
 }
+
+template<int bsize>
+void testLevelScheduling()
+{
+    typedef Dune::BCRSMatrix<Dune::FieldMatrix<double, bsize, bsize> > Matrix;
+    typedef Dune::BlockVector<Dune::FieldVector<double, bsize> > Vector;
+    std::size_t N = 32;
+    Matrix A;
+    setupLaplacian(A, N);
+
+    Opm::ParallelOverlappingILU0<Matrix, Vector, Vector> serial(A, 0, 1.0, Opm::MILU_VARIANT::ILU,
+                                                                false, true, false);
+    Opm::ParallelOverlappingILU0<Matrix, Vector, Vector> levels(A, 0, 1.0, Opm::MILU_VARIANT::ILU,
+                                                                false, true, true);
+    Vector d(A.N()), v1(A.N()), v2(A.N());
+    for ( std::size_t i = 0; i < A.N(); ++i )
+    {
+        d[i] = static_cast<double>(i % 7) - 3.0;
+    }
+    serial.apply(v1, d);
+    levels.apply(v2, d);
+
+    for ( std::size_t i = 0; i < A.N(); ++i )
+    {
+        auto diff = v1[i];
+        diff -= v2[i];
+        BOOST_CHECK(diff.two_norm() < 1e-14);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ILULevelScheduling1)
+{
+    testLevelScheduling<1>();
+}
+
+BOOST_AUTO_TEST_CASE(ILULevelScheduling3)
+{
+    testLevelScheduling<3>();
+}
+
+BOOST_AUTO_TEST_CASE(ILUColorScheduling)
+{
+    typedef Dune::BCRSMatrix<Dune::FieldMatrix<double, 2, 2> > Matrix;
+    typedef Dune::BlockVector<Dune::FieldVector<double, 2> > Vector;
+    std::size_t N = 32;
+    Matrix A;
+    setupLaplacian(A, N);
+
+    // the colors of the red-black ordering are processed concurrently
+    Opm::ParallelOverlappingILU0<Matrix, Vector, Vector> serial(A, 0, 1.0, Opm::MILU_VARIANT::ILU,
+                                                                true, true, false);
+    Opm::ParallelOverlappingILU0<Matrix, Vector, Vector> colors(A, 0, 1.0, Opm::MILU_VARIANT::ILU,
+                                                                true, true, true);
+    Vector d(A.N()), v1(A.N()), v2(A.N());
+    for ( std::size_t i = 0; i < A.N(); ++i )
+    {
+        d[i] = static_cast<double>(i % 5) - 2.0;
+    }
+    serial.apply(v1, d);
+    colors.apply(v2, d);
+
+    for ( std::size_t i = 0; i < A.N(); ++i )
+    {
+        auto diff = v1[i];
+        diff -= v2[i];
+        BOOST_CHECK(diff.two_norm() < 1e-14);
+    }
+}
+
+// A copy of A whose entry (0,1) is moved to (0,2), i.e. a matrix with the
+// same row sizes and nonzeroes but another sparsity pattern.
+template<class Matrix>
+Matrix moveFirstOffDiagonal(const Matrix& A)
+{
+    Matrix moved(A.N(), A.M(), A.nonzeroes(), Matrix::row_wise);
+    for ( auto row = moved.createbegin(); row != moved.createend(); ++row )
+    {
+        for ( auto col = A[row.index()].begin(); col != A[row.index()].end(); ++col )
+        {
+            const bool isMoved = row.index() == 0 && col.index() == 1;
+            row.insert( isMoved ? 2 : col.index() );
+        }
+    }
+    for ( auto row = moved.begin(); row != moved.end(); ++row )
+    {
+        for ( auto col = row->begin(); col != row->end(); ++col )
+        {
+            const bool isMoved = row.index() == 0 && col.index() == 2;
+            *col = A[row.index()][isMoved ? 1 : col.index()];
+        }
+    }
+    return moved;
+}
+
+BOOST_AUTO_TEST_CASE(ILUNNumericUpdate)
+{
+    typedef Dune::BCRSMatrix<Dune::FieldMatrix<double, 2, 2> > Matrix;
+    typedef Dune::BlockVector<Dune::FieldVector<double, 2> > Vector;
+    std::size_t N = 16;
+    Matrix A;
+    setupLaplacian(A, N);
+
+    Opm::ParallelOverlappingILU0<Matrix, Vector, Vector> updated(A, 1, 1.0, Opm::MILU_VARIANT::ILU);
+
+    // change the values but not the sparsity pattern
+    Matrix B(A);
+    for ( auto row = B.begin(); row != B.end(); ++row )
+    {
+        (*row)[row.index()] *= 2.0;
+    }
+    BOOST_CHECK(updated.update(B));
+    Opm::ParallelOverlappingILU0<Matrix, Vector, Vector> fresh(B, 1, 1.0, Opm::MILU_VARIANT::ILU);
+
+    Vector d(B.N()), v1(B.N()), v2(B.N());
+    d = 1.0;
+    updated.apply(v1, d);
+    fresh.apply(v2, d);
+    for ( std::size_t i = 0; i < B.N(); ++i )
+    {
+        auto diff = v1[i];
+        diff -= v2[i];
+        BOOST_CHECK(diff.two_norm() < 1e-14);
+    }
+
+    // a different pattern has to be rejected, even with the same number of
+    // rows and nonzeroes
+    Matrix C;
+    setupLaplacian(C, N+1);
+    BOOST_CHECK(!updated.update(C));
+    const Matrix D = moveFirstOffDiagonal(A);
+    BOOST_REQUIRE_EQUAL(D.nonzeroes(), A.nonzeroes());
+    BOOST_CHECK(!updated.update(D));
+}
+
+BOOST_AUTO_TEST_CASE(ILU0RedBlackNumericUpdate)
+{
+    typedef Dune::BCRSMatrix<Dune::FieldMatrix<double, 2, 2> > Matrix;
+    typedef Dune::BlockVector<Dune::FieldVector<double, 2> > Vector;
+    std::size_t N = 16;
+    Matrix A;
+    setupLaplacian(A, N);
+
+    // the ordering and the reordered pattern are kept
+    Opm::ParallelOverlappingILU0<Matrix, Vector, Vector> updated(A, 0, 1.0, Opm::MILU_VARIANT::MILU_1,
+                                                                 true, true, true);
+    Matrix B(A);
+    for ( auto row = B.begin(); row != B.end(); ++row )
+    {
+        (*row)[row.index()] *= 2.0;
+    }
+    BOOST_CHECK(updated.update(B));
+    Opm::ParallelOverlappingILU0<Matrix, Vector, Vector> fresh(B, 0, 1.0, Opm::MILU_VARIANT::MILU_1,
+                                                               true, true, true);
+
+    Vector d(B.N()), v1(B.N()), v2(B.N());
+    d = 1.0;
+    updated.apply(v1, d);
+    fresh.apply(v2, d);
+    for ( std::size_t i = 0; i < B.N(); ++i )
+    {
+        auto diff = v1[i];
+        diff -= v2[i];
+        BOOST_CHECK(diff.two_norm() < 1e-14);
+    }
+
+    BOOST_CHECK(!updated.update(moveFirstOffDiagonal(A)));
+
+    // without reordering nothing is kept for ILU(0)
+    Opm::ParallelOverlappingILU0<Matrix, Vector, Vector> plain(A, 0, 1.0, Opm::MILU_VARIANT::ILU);
+    BOOST_CHECK(!plain.update(B));
+}
+
+BOOST_AUTO_TEST_CASE(ILUMixedPrecision)
+{
+    typedef Dune::BCRSMatrix<Dune::FieldMatrix<double, 3, 3> > Matrix;
+    typedef Dune::BlockVector<Dune::FieldVector<double, 3> > Vector;
+    std::size_t N = 16;
+    Matrix A;
+    setupLaplacian(A, N);
+
+    Opm::ParallelOverlappingILU0<Matrix, Vector, Vector> ilu(A, 0, 1.0, Opm::MILU_VARIANT::ILU);
+    Opm::ParallelOverlappingILU0<Matrix, Vector, Vector,
+                                 Dune::Amg::SequentialInformation, float> iluFloat(A, 0, 1.0, Opm::MILU_VARIANT::ILU);
+
+    Vector d(A.N()), v1(A.N()), v2(A.N());
+    d = 1.0;
+    ilu.apply(v1, d);
+    iluFloat.apply(v2, d);
+    for ( std::size_t i = 0; i < A.N(); ++i )
+    {
+        auto diff = v1[i];
+        diff -= v2[i];
+        BOOST_CHECK(diff.two_norm() < 1e-5 * v1[i].two_norm());
+    }
+}
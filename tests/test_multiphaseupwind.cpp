@@ -102,3 +102,47 @@ BOOST_AUTO_TEST_CASE(GravityColumnHighFlux)
     BOOST_CHECK_EQUAL(upw[1], expected_upw[1]);
     BOOST_CHECK_EQUAL(upw[2], expected_upw[2]);
 }
+
+
+BOOST_AUTO_TEST_CASE(TwoPhaseGravityColumn)
+{
+    // Case 4: a two-phase gravity column, (w, o) as in the cases above.
+    // The water flows down if the total flux exceeds 5.0, the oil always.
+
+    const std::array<double, 2> gd = {{ 4.0, -1.0 }};
+    const std::array<double, 2> mob = {{ 1.0, 1.0 }};
+
+    const std::array<double, 2> low = Opm::connectionMultiPhaseUpwind<2>(gd, mob, mob, 1.0, 1.0);
+    BOOST_CHECK_EQUAL(low[0], 1.0);
+    BOOST_CHECK_EQUAL(low[1], -1.0);
+
+    const std::array<double, 2> high = Opm::connectionMultiPhaseUpwind<2>(gd, mob, mob, 1.0, 10.0);
+    BOOST_CHECK_EQUAL(high[0], 1.0);
+    BOOST_CHECK_EQUAL(high[1], 1.0);
+}
+
+
+BOOST_AUTO_TEST_CASE(ManyConnections)
+{
+    // Case 5: the cases above, and equal head differences, in one call.
+
+    const int num_connections = 4;
+    const std::array<double, 3> gd[num_connections] = {
+        {{ 4.0, -1.0, -2.0 }}, {{ 4.0, -1.0, -2.0 }}, {{ 4.0, -1.0, -2.0 }}, {{ 1.0, 1.0, -1.0 }}
+    };
+    const std::array<double, 3> mob[num_connections] = {
+        {{ 1.0, 1.0, 1.0 }}, {{ 1.0, 1.0, 1.0 }}, {{ 1.0, 1.0, 1.0 }}, {{ 1.0, 2.0, 0.5 }}
+    };
+    const double transmissibility[num_connections] = { 1.0, 1.0, 1.0, 2.0 };
+    const double flux[num_connections] = { 1.0, 5.0, 10.0, -1.0 };
+
+    std::array<double, 3> upw[num_connections];
+    Opm::connectionMultiPhaseUpwind<3>(num_connections, gd, mob, mob, transmissibility, flux, upw);
+    for (int conn = 0; conn < num_connections; ++conn) {
+        const std::array<double, 3> expected_upw
+            = Opm::connectionMultiPhaseUpwind(gd[conn], mob[conn], mob[conn], transmissibility[conn], flux[conn]);
+        BOOST_CHECK_EQUAL(upw[conn][0], expected_upw[0]);
+        BOOST_CHECK_EQUAL(upw[conn][1], expected_upw[1]);
+        BOOST_CHECK_EQUAL(upw[conn][2], expected_upw[2]);
+    }
+}
@@ -27,8 +27,14 @@
 #include <boost/test/unit_test.hpp>
 #include "DuneIstlTestHelpers.hpp"
 #include <opm/core/linalg/ParallelIstlInformation.hpp>
+#include <opm/autodiff/MatrixBlockKernels.hpp>
 #include <functional>
 #ifdef HAVE_DUNE_ISTL
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/schwarz.hh>
 
 
 template<typename T>
@@ -100,4 +106,71 @@ BOOST_AUTO_TEST_CASE(singleContainerReductionTest)
     comm.computeReduction(x,Opm::Reduction::makeGlobalSumFunctor<int>(),value);
     BOOST_CHECK(value==oldvalue+((N-1)*N)/2);
 }
+
+BOOST_AUTO_TEST_CASE(nonCopyRowsMatchOverlappingSchwarzOperator)
+{
+    typedef Dune::FieldMatrix<double,1,1> Block;
+    typedef Dune::BCRSMatrix<Block> Matrix;
+    typedef Dune::BlockVector<Dune::FieldVector<double,1> > Vector;
+
+    // a 1D Laplacian with an overlap layer and a copy layer around the
+    // owned indices
+    const int N=100;
+    int start, end, istart, iend;
+    std::tie(start,istart,iend,end) = computeRegions(N);
+    start = std::max(istart-2, 0);
+    end = std::min(iend+2, N);
+    const int n = end-start;
+
+    Opm::ParallelISTLInformation info(MPI_COMM_WORLD);
+    auto& indexSet = *info.indexSet();
+    indexSet.beginResize();
+    for(int row=start; row<end; ++row)
+    {
+        const int distance = row<istart ? istart-row : (row>=iend ? row-iend+1 : 0);
+        const GridFlag flag = distance==0 ? GridAttributes::owner :
+            (distance==1 ? GridAttributes::overlap : GridAttributes::copy);
+        indexSet.add(row, LocalIndex(row-start, flag, true));
+    }
+    indexSet.endResize();
+    auto comm = info.istlCommunication(n);
+
+    Matrix A(n, n, 3*n, Matrix::row_wise);
+    for(auto row=A.createbegin(); row!=A.createend(); ++row)
+    {
+        const int i = row.index();
+        if(i>0)
+            row.insert(i-1);
+        row.insert(i);
+        if(i<n-1)
+            row.insert(i+1);
+    }
+    for(int i=0; i<n; ++i)
+        for(auto col=A[i].begin(); col!=A[i].end(); ++col)
+            *col = col.index()==static_cast<unsigned>(i) ? 2.0 : -1.0;
+
+    // consistent values on all processes
+    Vector x(n);
+    for(int i=0; i<n; ++i)
+        x[i] = 1.0 + (start+i)*(start+i);
+
+    Dune::OverlappingSchwarzOperator<Matrix,Vector,Vector,Opm::ParallelISTLInformation::Communication>
+        op(A, *comm);
+    const auto rows = Opm::ParallelISTLInformation::nonCopyRows(*comm, n);
+
+    Vector expected(n), y(n);
+    op.apply(x, expected);
+    Opm::detail::bcrsMv(A, x, y, rows);
+    comm->project(y);
+    for(int i=0; i<n; ++i)
+        BOOST_CHECK_EQUAL(y[i][0], expected[i][0]);
+
+    expected = 1.0;
+    y = 1.0;
+    op.applyscaleadd(0.5, x, expected);
+    Opm::detail::bcrsUsmv(0.5, A, x, y, rows);
+    comm->project(y);
+    for(int i=0; i<n; ++i)
+        BOOST_CHECK_EQUAL(y[i][0], expected[i][0]);
+}
 #endif
@@ -0,0 +1,108 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE PerformanceTraceTest
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/ProfileScope.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+    std::size_t count(const std::string& text, const std::string& pattern)
+    {
+        std::size_t n = 0;
+        for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+            ++n;
+        }
+        return n;
+    }
+}
+
+bool
+init_unit_test_func()
+{
+    return true;
+}
+
+BOOST_AUTO_TEST_CASE(InactiveByDefault)
+{
+    {
+        Opm::ProfileScope scope("assemble");
+    }
+    BOOST_CHECK(!Opm::PerformanceTrace::active());
+    BOOST_CHECK_EQUAL(Opm::PerformanceTrace::size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(RingBuffer)
+{
+    Opm::PerformanceTrace::start(3, 1);
+    for (int i = 0; i < 5; ++i) {
+        Opm::ProfileScope scope("assemble");
+    }
+    BOOST_CHECK_EQUAL(Opm::PerformanceTrace::size(), 3u);
+    Opm::PerformanceTrace::stop();
+    BOOST_CHECK_EQUAL(Opm::PerformanceTrace::size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(Sampling)
+{
+    Opm::PerformanceTrace::start(100, 2);
+    for (int step = 0; step < 4; ++step) {
+        Opm::PerformanceTrace::beginReportStep(step);
+        Opm::ProfileScope scope("step");
+        Opm::PerformanceTrace::instant("timestep chop");
+    }
+    BOOST_CHECK_EQUAL(Opm::PerformanceTrace::size(), 4u);
+    Opm::PerformanceTrace::stop();
+}
+
+BOOST_AUTO_TEST_CASE(ChromeTraceFormat)
+{
+    auto cc = Dune::MPIHelper::getCollectiveCommunication();
+    Opm::PerformanceTrace::start(100, 1, cc);
+    {
+        Opm::ProfileScope scope("linear solve");
+    }
+    Opm::PerformanceTrace::instant("timestep chop");
+    Opm::PerformanceTrace::write("performance_trace.json", cc);
+    Opm::PerformanceTrace::stop();
+
+    if (cc.rank() == 0) {
+        std::ifstream in("performance_trace.json");
+        const std::string json((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        BOOST_CHECK_EQUAL(json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0u);
+        BOOST_CHECK_EQUAL(count(json, "\"name\":\"linear solve\",\"ph\":\"X\""), std::size_t(cc.size()));
+        BOOST_CHECK_EQUAL(count(json, "\"name\":\"timestep chop\",\"ph\":\"i\""), std::size_t(cc.size()));
+        BOOST_CHECK_EQUAL(count(json, "\"name\":\"process_name\""), std::size_t(cc.size()));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
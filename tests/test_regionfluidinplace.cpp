@@ -0,0 +1,93 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE RegionFluidInPlaceTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/autodiff/RegionFluidInPlace.hpp>
+
+#include <vector>
+
+typedef Opm::FIPDataEnums FIP;
+
+BOOST_AUTO_TEST_CASE(SumsByRegion)
+{
+    Opm::detail::RegionFluidInPlace sums(2);
+    const double fip1[] = { 1.0, 2.0, 3.0, 4.0, 5.0 };
+    const double fip2[] = { 10.0, 20.0, 30.0, 40.0, 50.0 };
+    sums.add(0, fip1, 2.0, 0.5, 100.0);
+    sums.add(0, fip2, 6.0, 1.0, 200.0);
+    sums.add(1, fip1, 4.0, 0.25, 300.0);
+
+    const auto values = sums.values();
+    BOOST_REQUIRE_EQUAL(values.size(), 2u);
+    BOOST_REQUIRE_EQUAL(values[0].size(), std::size_t(FIP::fipValues));
+    for (int i = 0; i < FIP::FIP_PV; ++i) {
+        BOOST_CHECK_EQUAL(values[0][i], fip1[i] + fip2[i]);
+        BOOST_CHECK_EQUAL(values[1][i], fip1[i]);
+    }
+    BOOST_CHECK_EQUAL(values[0][FIP::FIP_PV], 8.0);
+    BOOST_CHECK_EQUAL(values[1][FIP::FIP_PV], 4.0);
+    // weighted by the hydrocarbon pore volumes 1 and 6
+    BOOST_CHECK_CLOSE(values[0][FIP::FIP_WEIGHTED_PRESSURE], (100.0 + 6.0 * 200.0) / 7.0, 1e-12);
+    BOOST_CHECK_CLOSE(values[1][FIP::FIP_WEIGHTED_PRESSURE], 300.0, 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(PressureWithoutHydrocarbons)
+{
+    Opm::detail::RegionFluidInPlace sums(3);
+    const double water[] = { 1.0, 0.0, 0.0, 0.0, 0.0 };
+    sums.add(1, water, 1.0, 0.0, 100.0);
+    sums.add(1, water, 3.0, 0.0, 200.0);
+
+    const auto values = sums.values();
+    BOOST_REQUIRE_EQUAL(values.size(), 3u);
+    // the pore volume weighted pressure, and zero for the empty regions
+    BOOST_CHECK_CLOSE(values[1][FIP::FIP_WEIGHTED_PRESSURE], 175.0, 1e-12);
+    BOOST_CHECK_EQUAL(values[0][FIP::FIP_WEIGHTED_PRESSURE], 0.0);
+    BOOST_CHECK_EQUAL(values[2][FIP::FIP_PV], 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(CombineThreads)
+{
+    const double fip[] = { 1.0, 2.0, 3.0, 4.0, 5.0 };
+    Opm::detail::RegionFluidInPlace first(1);
+    Opm::detail::RegionFluidInPlace second(1);
+    first.add(0, fip, 1.0, 1.0, 100.0);
+    second.add(0, fip, 1.0, 1.0, 300.0);
+    first.add(second);
+
+    auto values = first.values();
+    BOOST_CHECK_EQUAL(values[0][FIP::FIP_VAPORIZED_OIL], 10.0);
+    BOOST_CHECK_EQUAL(values[0][FIP::FIP_PV], 2.0);
+    BOOST_CHECK_CLOSE(values[0][FIP::FIP_WEIGHTED_PRESSURE], 200.0, 1e-12);
+
+    // the sums of all processes are summed in place
+    for (double& s : first.sums()) {
+        s *= 2.0;
+    }
+    values = first.values();
+    BOOST_CHECK_EQUAL(values[0][FIP::FIP_PV], 4.0);
+    BOOST_CHECK_CLOSE(values[0][FIP::FIP_WEIGHTED_PRESSURE], 200.0, 1e-12);
+
+    first.clear();
+    BOOST_CHECK_EQUAL(first.values()[0][FIP::FIP_PV], 0.0);
+}
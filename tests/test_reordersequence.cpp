@@ -0,0 +1,81 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define NVERBOSE // to suppress our messages when throwing
+
+#define BOOST_TEST_MODULE ReorderSequenceTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/transport/reorder/reordersequence.h>
+#include <opm/grid/GridManager.hpp>
+#include <opm/grid/UnstructuredGrid.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+    // The neighbours of each cell in the graph (ia, ja), sorted.
+    std::vector<std::vector<int> > neighbours(const std::vector<int>& ia,
+                                              const std::vector<int>& ja)
+    {
+        std::vector<std::vector<int> > cells(ia.size() - 1);
+        for (std::size_t c = 0; c < cells.size(); ++c) {
+            cells[c].assign(ja.begin() + ia[c], ja.begin() + ia[c + 1]);
+            std::sort(cells[c].begin(), cells[c].end());
+        }
+        return cells;
+    }
+
+} // anonymous namespace
+
+
+BOOST_AUTO_TEST_CASE(DownwindGraphIsUpwindGraphOfNegatedFlux)
+{
+    Opm::GridManager gm(4, 3);
+    const UnstructuredGrid& grid = *gm.c_grid();
+    const int nc = grid.number_of_cells;
+    const int nf = grid.number_of_faces;
+
+    // fluxes of both signs, some faces without flow
+    std::vector<double> flux(nf), negFlux(nf);
+    for (int f = 0; f < nf; ++f) {
+        flux[f] = double((7*f) % 5) - 2.0;
+        negFlux[f] = -flux[f];
+    }
+
+    std::vector<int> ia(nc + 1), ja(nf);
+    compute_downwind_graph(&grid, flux.data(), ia.data(), ja.data());
+
+    std::vector<int> seq(nc), comp(nc + 1), iaRef(nc + 1), jaRef(nf);
+    int ncomp = 0;
+    compute_sequence_graph(&grid, negFlux.data(), seq.data(), comp.data(), &ncomp,
+                           iaRef.data(), jaRef.data());
+
+    BOOST_CHECK_EQUAL(ia.back(), iaRef.back());
+    const auto cells = neighbours(ia, ja);
+    const auto cellsRef = neighbours(iaRef, jaRef);
+    for (int c = 0; c < nc; ++c) {
+        BOOST_CHECK_EQUAL_COLLECTIONS(cells[c].begin(), cells[c].end(),
+                                      cellsRef[c].begin(), cellsRef[c].end());
+    }
+}
@@ -0,0 +1,96 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE ReproducibleSumTest
+
+#include <opm/autodiff/ReproducibleSum.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using Opm::detail::ReproducibleSum;
+
+namespace
+{
+    std::vector<double> summands(const int n, double& maxAbs)
+    {
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+        std::vector<double> x(n);
+        maxAbs = 0.0;
+        for (auto& xi : x) {
+            xi = distribution(generator) * std::pow(10.0, 6.0 * distribution(generator));
+            maxAbs = std::max(maxAbs, std::abs(xi));
+        }
+        return x;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(IndependentOfOrderAndPartition)
+{
+    const int n = 10000;
+    double maxAbs = 0.0;
+    std::vector<double> x = summands(n, maxAbs);
+
+    ReproducibleSum reference(maxAbs, n);
+    for (const double xi : x) {
+        reference.add(xi);
+    }
+
+    std::mt19937 generator(7);
+    for (int parts = 1; parts <= 5; ++parts) {
+        std::shuffle(x.begin(), x.end(), generator);
+        std::vector<ReproducibleSum> partial(parts, ReproducibleSum(maxAbs, n));
+        for (int i = 0; i < n; ++i) {
+            partial[i % parts].add(x[i]);
+        }
+        ReproducibleSum sum(maxAbs, n);
+        for (const auto& p : partial) {
+            sum.add(p);
+        }
+        BOOST_CHECK_EQUAL(sum.value(), reference.value());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Accuracy)
+{
+    const int n = 10000;
+    double maxAbs = 0.0;
+    const std::vector<double> x = summands(n, maxAbs);
+
+    ReproducibleSum sum(maxAbs, n);
+    long double exact = 0.0;
+    for (const double xi : x) {
+        sum.add(xi);
+        exact += xi;
+    }
+    BOOST_CHECK_CLOSE(sum.value(), double(exact), 1e-10);
+
+    // Cancellation to an exact zero.
+    ReproducibleSum zero(1.0, 2);
+    zero.add(0.1);
+    zero.add(-0.1);
+    BOOST_CHECK_EQUAL(zero.value(), 0.0);
+}
@@ -0,0 +1,108 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE RunProfileTest
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/RunProfile.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+bool
+init_unit_test_func()
+{
+    return true;
+}
+
+namespace
+{
+
+Opm::SimulatorReport makeReport(const double assemble, const double solve, const double update)
+{
+    Opm::SimulatorReport report;
+    report.assemble_time = assemble;
+    report.linear_solve_time = solve;
+    report.update_time = update;
+    report.total_linearizations = 2;
+    return report;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(Categories)
+{
+    Opm::RunProfile profile;
+    profile.addReportStep(0, 12.0, 1.0, makeReport(2.0, 5.0, 1.0), makeReport(0.5, 1.0, 0.0));
+    BOOST_REQUIRE_EQUAL(profile.steps().size(), 1u);
+    const auto& step = profile.steps()[0];
+    BOOST_CHECK_EQUAL(step.reportStep, 0);
+    // the failed time steps are part of the categories
+    BOOST_CHECK_CLOSE(step.seconds[Opm::RunProfile::Assembly], 2.5, 1e-10);
+    BOOST_CHECK_CLOSE(step.seconds[Opm::RunProfile::LinearSolve], 6.0, 1e-10);
+    BOOST_CHECK_CLOSE(step.seconds[Opm::RunProfile::Other], 1.5, 1e-10);
+    BOOST_CHECK_CLOSE(step.lostTime, 1.5, 1e-10);
+    BOOST_CHECK_EQUAL(step.lostLinearizations, 2u);
+    BOOST_CHECK_EQUAL(Opm::RunProfile::dominant(step), Opm::RunProfile::LinearSolve);
+
+    // the unaccounted time is never negative
+    profile.addReportStep(1, 1.0, 0.5, makeReport(1.0, 0.0, 0.0), Opm::SimulatorReport());
+    BOOST_CHECK_EQUAL(profile.steps()[1].seconds[Opm::RunProfile::Other], 0.0);
+    BOOST_CHECK_EQUAL(Opm::RunProfile::dominant(profile.steps()[1]), Opm::RunProfile::Assembly);
+}
+
+BOOST_AUTO_TEST_CASE(JsonFormat)
+{
+    auto cc = Dune::MPIHelper::getCollectiveCommunication();
+    Opm::RunProfile profile;
+    // the first process is slower in the second step
+    profile.addReportStep(0, 4.0, 0.0, makeReport(1.0, 2.0, 1.0), Opm::SimulatorReport());
+    profile.addReportStep(1, cc.rank() == 0 ? 20.0 : 8.0, 1.0, makeReport(6.0, 1.0, 0.0),
+                          makeReport(1.0, 0.0, 0.0));
+    profile.addReportStep(2, 6.0, 0.0, makeReport(0.0, 5.0, 1.0), Opm::SimulatorReport());
+    profile.write("profile.json", 2, cc);
+
+    if (cc.rank() == 0) {
+        std::ifstream in("profile.json");
+        const std::string json((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        BOOST_CHECK_EQUAL(json.find("{\"processes\":" + std::to_string(cc.size())
+                                    + ",\"report_steps\":3,\"wall_time\":30"), 0u);
+        BOOST_CHECK(json.find("{\"name\":\"assembly\",\"min\":8,\"avg\":8,\"max\":8,\"imbalance\":1")
+                    != std::string::npos);
+        BOOST_CHECK(json.find("\"failed_time_steps\":{\"lost_time\":1,") != std::string::npos);
+        // the two slowest steps, slowest first, without the first step
+        const auto slowest = json.find("\"slowest_report_steps\":[\n{\"report_step\":1,\"wall_time\":20");
+        BOOST_REQUIRE(slowest != std::string::npos);
+        BOOST_CHECK(json.find("\"dominant\":\"other\"", slowest) != std::string::npos);
+        BOOST_CHECK(json.find("{\"report_step\":2,\"wall_time\":6", slowest) != std::string::npos);
+        BOOST_CHECK(json.find("\"report_step\":0") == std::string::npos);
+        BOOST_CHECK(json.find("\"timers\":[") != std::string::npos);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
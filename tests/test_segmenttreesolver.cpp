@@ -0,0 +1,153 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE SegmentTreeSolverTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/autodiff/MSWellHelpers.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <cmath>
+#include <vector>
+
+const int numWellEq = 4;
+
+typedef Dune::FieldMatrix<double, numWellEq, numWellEq> DiagBlock;
+typedef Dune::BCRSMatrix<DiagBlock> DiagMatWell;
+typedef Dune::BlockVector<Dune::FieldVector<double, numWellEq> > BVectorWell;
+
+// A matrix with the sparsity pattern of the segment tree given by outlets.
+DiagMatWell makeMatrix(const std::vector<int>& outlets)
+{
+    const int nseg = outlets.size();
+    std::vector<std::vector<int> > inlets(nseg);
+    for ( int seg = 0; seg < nseg; ++seg )
+    {
+        if ( outlets[seg] >= 0 )
+        {
+            inlets[outlets[seg]].push_back(seg);
+        }
+    }
+
+    DiagMatWell D;
+    D.setBuildMode(DiagMatWell::row_wise);
+    D.setSize(nseg, nseg, 3 * nseg);
+    for ( auto row = D.createbegin(); row != D.createend(); ++row )
+    {
+        const int seg = row.index();
+        if ( outlets[seg] >= 0 )
+        {
+            row.insert(outlets[seg]);
+        }
+        row.insert(seg);
+        for ( const int inlet : inlets[seg] )
+        {
+            row.insert(inlet);
+        }
+    }
+
+    for ( auto row = D.begin(); row != D.end(); ++row )
+    {
+        for ( auto col = row->begin(); col != row->end(); ++col )
+        {
+            for ( int i = 0; i < numWellEq; ++i )
+            {
+                for ( int j = 0; j < numWellEq; ++j )
+                {
+                    (*col)[i][j] = std::sin(1.0 + row.index() + 3.0 * col.index() + 5.0 * i + 7.0 * j);
+                    if ( row.index() == col.index() && i == j )
+                    {
+                        (*col)[i][j] += 10.0;
+                    }
+                }
+            }
+        }
+    }
+    return D;
+}
+
+void checkSolve(const std::vector<int>& outlets)
+{
+    const DiagMatWell D = makeMatrix(outlets);
+
+    Opm::mswellhelpers::SegmentTreeSolver<DiagMatWell, BVectorWell> solver;
+    solver.init(outlets);
+    solver.factorize(D);
+
+    BVectorWell x(outlets.size());
+    for ( size_t seg = 0; seg < x.size(); ++seg )
+    {
+        for ( int i = 0; i < numWellEq; ++i )
+        {
+            x[seg][i] = std::cos(2.0 * seg + i);
+        }
+    }
+
+    const BVectorWell y = solver.solve(x);
+
+    // D y has to give x back
+    BVectorWell Dy(x.size());
+    D.mv(y, Dy);
+    for ( size_t seg = 0; seg < x.size(); ++seg )
+    {
+        for ( int i = 0; i < numWellEq; ++i )
+        {
+            BOOST_CHECK_SMALL(Dy[seg][i] - x[seg][i], 1e-12);
+        }
+    }
+
+    // the solve into an existing vector gives the same result
+    BVectorWell z(x.size());
+    solver.solve(x, z);
+    for ( size_t seg = 0; seg < x.size(); ++seg )
+    {
+        for ( int i = 0; i < numWellEq; ++i )
+        {
+            BOOST_CHECK_EQUAL(z[seg][i], y[seg][i]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SingleSegment)
+{
+    checkSolve({ -1 });
+}
+
+BOOST_AUTO_TEST_CASE(StraightWell)
+{
+    checkSolve({ -1, 0, 1, 2, 3, 4 });
+}
+
+BOOST_AUTO_TEST_CASE(BranchedWell)
+{
+    // two laterals joining the main bore, listed in arbitrary order
+    checkSolve({ -1, 0, 1, 2, 1, 4, 5, 0, 7, 3 });
+}
+
+BOOST_AUTO_TEST_CASE(NotATree)
+{
+    Opm::mswellhelpers::SegmentTreeSolver<DiagMatWell, BVectorWell> solver;
+    BOOST_CHECK_THROW(solver.init({ -1, 2, 1 }), std::logic_error);
+}
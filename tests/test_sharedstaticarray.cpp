@@ -0,0 +1,144 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE SharedStaticArrayTest
+
+#include <opm/core/utility/SharedStaticArray.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include <unistd.h>
+
+namespace
+{
+    std::string cachePath(const std::string& name)
+    {
+        return "test_sharedstaticarray_" + name + "_" + std::to_string(::getpid()) + ".bin";
+    }
+
+    const std::uint64_t deckKey = Opm::MappedCacheFile::checksum(std::string("DECK"));
+}
+
+BOOST_AUTO_TEST_CASE(ComputedOnce)
+{
+    const std::string path = cachePath("once");
+    int computed = 0;
+    auto compute = [&computed](double* values)
+    {
+        ++computed;
+        for (int i = 0; i < 100; ++i) {
+            values[i] = 0.5 * i;
+        }
+    };
+
+    {
+        Opm::SharedStaticArray<double> first(path, deckKey, 100, compute);
+        BOOST_CHECK(first.created());
+        Opm::SharedStaticArray<double> second(path, deckKey, 100, compute);
+        BOOST_CHECK(!second.created());
+        BOOST_CHECK_EQUAL(computed, 1);
+        BOOST_REQUIRE_EQUAL(second.size(), 100u);
+        for (int i = 0; i < 100; ++i) {
+            BOOST_CHECK_EQUAL(first[i], 0.5 * i);
+            BOOST_CHECK_EQUAL(second[i], 0.5 * i);
+        }
+    }
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(MismatchRecreates)
+{
+    const std::string path = cachePath("mismatch");
+    {
+        Opm::SharedStaticArray<int> ints(path, deckKey, 10, [](int* values)
+                                         {
+                                             for (int i = 0; i < 10; ++i) {
+                                                 values[i] = i;
+                                             }
+                                         });
+        BOOST_CHECK(ints.created());
+
+        // A different size replaces the file, the old mapping stays valid.
+        Opm::SharedStaticArray<int> more(path, deckKey, 20, [](int* values)
+                                         {
+                                             for (int i = 0; i < 20; ++i) {
+                                                 values[i] = -i;
+                                             }
+                                         });
+        BOOST_CHECK(more.created());
+        BOOST_CHECK_EQUAL(ints[9], 9);
+        BOOST_CHECK_EQUAL(more[19], -19);
+
+        // A different element type of the same byte size is recreated too.
+        static_assert(sizeof(float) == sizeof(int), "The test needs elements of the same size.");
+        Opm::SharedStaticArray<float> floats(path, deckKey, 20, [](float* values)
+                                             {
+                                                 for (int i = 0; i < 20; ++i) {
+                                                     values[i] = 1.0f;
+                                                 }
+                                             });
+        BOOST_CHECK(floats.created());
+        BOOST_CHECK_EQUAL(floats[3], 1.0f);
+    }
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(StaleFileRecreates)
+{
+    const std::string path = cachePath("stale");
+    const std::uint64_t changedKey = Opm::MappedCacheFile::checksum(std::string("CHANGED DECK"));
+    BOOST_CHECK(changedKey != deckKey);
+    {
+        Opm::SharedStaticArray<double> old(path, deckKey, 10, [](double* values)
+                                           {
+                                               for (int i = 0; i < 10; ++i) {
+                                                   values[i] = 1.0;
+                                               }
+                                           });
+        BOOST_CHECK(old.created());
+    }
+    {
+        // The file left by a run of other inputs has the same type and size,
+        // only its key tells that it is stale.
+        Opm::SharedStaticArray<double> current(path, changedKey, 10, [](double* values)
+                                               {
+                                                   for (int i = 0; i < 10; ++i) {
+                                                       values[i] = 2.0;
+                                                   }
+                                               });
+        BOOST_CHECK(current.created());
+        BOOST_CHECK_EQUAL(current[7], 2.0);
+
+        int computed = 0;
+        Opm::SharedStaticArray<double> again(path, changedKey, 10, [&computed](double*)
+                                             {
+                                                 ++computed;
+                                             });
+        BOOST_CHECK(!again.created());
+        BOOST_CHECK_EQUAL(computed, 0);
+        BOOST_CHECK_EQUAL(again[7], 2.0);
+    }
+    std::remove(path.c_str());
+}
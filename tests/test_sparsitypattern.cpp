@@ -0,0 +1,86 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE SparsityPatternTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/autodiff/SparsityPattern.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/istl/bcrsmatrix.hh>
+
+#include <set>
+#include <vector>
+
+typedef Dune::BCRSMatrix<Dune::FieldMatrix<double, 2, 2> > Matrix;
+
+// A matrix with a diagonal and one neighbour per row, the neighbour of the
+// last row is given by lastNeighbour.
+Matrix createMatrix(const int n, const int lastNeighbour)
+{
+    std::vector<std::set<int> > rows(n);
+    for ( int i = 0; i < n; ++i )
+    {
+        rows[i].insert(i);
+        rows[i].insert(i + 1 < n ? i + 1 : lastNeighbour);
+    }
+    std::size_t nnz = 0;
+    for ( const auto& row : rows )
+    {
+        nnz += row.size();
+    }
+
+    Matrix matrix(n, n, nnz, Matrix::row_wise);
+    for ( auto row = matrix.createbegin(); row != matrix.createend(); ++row )
+    {
+        for ( const int col : rows[row.index()] )
+        {
+            row.insert(col);
+        }
+    }
+    matrix = 1.0;
+    return matrix;
+}
+
+BOOST_AUTO_TEST_CASE(SameSizesDifferentColumns)
+{
+    const Matrix a = createMatrix(4, 0);
+    const Matrix b = createMatrix(4, 1);
+    Matrix c = createMatrix(4, 0);
+    c = 2.0;
+    BOOST_REQUIRE_EQUAL(a.nonzeroes(), b.nonzeroes());
+
+    BOOST_CHECK(Opm::detail::samePattern(a, a));
+    BOOST_CHECK(Opm::detail::samePattern(a, c));
+    BOOST_CHECK(!Opm::detail::samePattern(a, b));
+
+    Opm::detail::SparsityPattern pattern;
+    BOOST_CHECK(pattern.empty());
+    pattern.assign(a);
+    BOOST_CHECK(!pattern.empty());
+    BOOST_CHECK(pattern.matches(a));
+    BOOST_CHECK(pattern.matches(c));
+    BOOST_CHECK(!pattern.matches(b));
+    BOOST_CHECK(!pattern.matches(createMatrix(5, 0)));
+
+    pattern.clear();
+    BOOST_CHECK(!pattern.matches(a));
+}
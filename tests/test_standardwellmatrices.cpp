@@ -0,0 +1,163 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE StandardWellMatricesTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/autodiff/StandardWellMatrices.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <vector>
+
+const int numEq = 2;
+const int numWellEq = 3;
+
+typedef Dune::FieldMatrix<double, numWellEq, numEq> OffDiagBlock;
+typedef Dune::FieldMatrix<double, numWellEq, numWellEq> DiagBlock;
+typedef Dune::BCRSMatrix<OffDiagBlock> OffDiagMatWell;
+typedef Dune::BCRSMatrix<DiagBlock> DiagMatWell;
+typedef Dune::BlockVector<Dune::FieldVector<double, numEq> > BVector;
+typedef Dune::BlockVector<Dune::FieldVector<double, numWellEq> > BVectorWell;
+
+struct Well
+{
+    OffDiagMatWell duneB;
+    OffDiagMatWell duneC;
+    DiagMatWell invDuneD;
+
+    Well(const std::vector<int>& cells, int numCells, double seed)
+    {
+        invDuneD.setSize(1, 1, 1);
+        for ( auto row = invDuneD.createbegin(); row != invDuneD.createend(); ++row )
+        {
+            row.insert(row.index());
+        }
+        duneB.setSize(1, numCells, cells.size());
+        duneC.setSize(1, numCells, cells.size());
+        for ( auto row = duneB.createbegin(); row != duneB.createend(); ++row )
+        {
+            for ( const int cell : cells )
+            {
+                row.insert(cell);
+            }
+        }
+        for ( auto row = duneC.createbegin(); row != duneC.createend(); ++row )
+        {
+            for ( const int cell : cells )
+            {
+                row.insert(cell);
+            }
+        }
+
+        for ( int i = 0; i < numWellEq; ++i )
+        {
+            for ( int j = 0; j < numWellEq; ++j )
+            {
+                invDuneD[0][0][i][j] = ( i == j ) ? 1.0 + seed : 0.1 * seed * ( i - j );
+            }
+        }
+        for ( const int cell : cells )
+        {
+            for ( int i = 0; i < numWellEq; ++i )
+            {
+                for ( int j = 0; j < numEq; ++j )
+                {
+                    duneB[0][cell][i][j] = seed + 0.1 * cell + i - j;
+                    duneC[0][cell][i][j] = seed - 0.2 * cell + i * j;
+                }
+            }
+        }
+    }
+
+    // Ax = Ax - C^T D^-1 B x, like StandardWell::apply
+    void apply(const BVector& x, BVector& Ax) const
+    {
+        BVectorWell Bx(1), invDBx(1);
+        duneB.mv(x, Bx);
+        invDuneD.mv(Bx, invDBx);
+        duneC.mmtv(invDBx, Ax);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(ApplyAllWells)
+{
+    const int numCells = 10;
+    // the last two wells share perforated cells
+    std::vector<Well> wells;
+    wells.emplace_back(std::vector<int>{0, 1, 2}, numCells, 0.5);
+    wells.emplace_back(std::vector<int>{7, 5}, numCells, 1.5);
+    wells.emplace_back(std::vector<int>{4, 5, 6, 9}, numCells, -0.75);
+
+    Opm::StandardWellMatrices<double, numWellEq, numEq> matrices;
+    for ( const auto& well : wells )
+    {
+        matrices.addWell(well.duneB, well.duneC, well.invDuneD);
+    }
+    BOOST_CHECK_EQUAL(matrices.numWells(), 3);
+
+    BVector x(numCells), Ax(numCells), AxRef(numCells);
+    for ( int i = 0; i < numCells; ++i )
+    {
+        x[i][0] = 1.0 + i;
+        x[i][1] = 2.0 - 0.5 * i;
+        AxRef[i] = 0.25 * i;
+    }
+    Ax = AxRef;
+
+    for ( const auto& well : wells )
+    {
+        well.apply(x, AxRef);
+    }
+    matrices.apply(x, Ax);
+    for ( int i = 0; i < numCells; ++i )
+    {
+        for ( int j = 0; j < numEq; ++j )
+        {
+            BOOST_CHECK_CLOSE(Ax[i][j], AxRef[i][j], 1e-12);
+        }
+    }
+
+    // applyScaleAdd
+    BVector scaled(numCells), scaledRef(numCells), res(numCells);
+    scaled = 1.0;
+    scaledRef = 1.0;
+    res = 0.0;
+    for ( const auto& well : wells )
+    {
+        well.apply(x, res);
+    }
+    scaledRef.axpy(-2.0, res);
+    matrices.applyScaleAdd(-2.0, x, scaled);
+    for ( int i = 0; i < numCells; ++i )
+    {
+        for ( int j = 0; j < numEq; ++j )
+        {
+            BOOST_CHECK_CLOSE(scaled[i][j], scaledRef[i][j], 1e-12);
+        }
+    }
+
+    matrices.clear();
+    BOOST_CHECK_EQUAL(matrices.numWells(), 0);
+}
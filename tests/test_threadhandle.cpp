@@ -0,0 +1,83 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE ThreadHandleTest
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/autodiff/ThreadHandle.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+    struct Increment
+    {
+        std::atomic<int>* counter;
+        void run()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            ++(*counter);
+        }
+    };
+}
+
+BOOST_AUTO_TEST_CASE(SingleThreadRunsAllObjects)
+{
+    std::atomic<int> counter(0);
+    Opm::ThreadHandle::Statistics stats;
+    {
+        Opm::ThreadHandle handle(true, 2);
+        for (int i = 0; i < 20; ++i) {
+            handle.dispatch(Increment{ &counter });
+        }
+        stats = handle.statistics();
+    }
+    BOOST_CHECK_EQUAL(counter, 20);
+    BOOST_CHECK_EQUAL(stats.dispatched, 20);
+    BOOST_CHECK(stats.maxObjectsInFlight <= 2);
+    BOOST_CHECK(stats.dispatchWaitTime >= 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(SeveralThreadsRunAllObjects)
+{
+    std::atomic<int> counter(0);
+    Opm::ThreadHandle::Statistics stats;
+    {
+        Opm::ThreadHandle handle(true, 4, 3);
+        for (int i = 0; i < 30; ++i) {
+            handle.dispatch(Increment{ &counter });
+        }
+        stats = handle.statistics();
+    }
+    BOOST_CHECK_EQUAL(counter, 30);
+    BOOST_CHECK_EQUAL(stats.dispatched, 30);
+    BOOST_CHECK(stats.maxObjectsInFlight <= 4);
+}
+
+BOOST_AUTO_TEST_CASE(NoThreadThrowsOnDispatch)
+{
+    std::atomic<int> counter(0);
+    Opm::ThreadHandle handle(false);
+    BOOST_CHECK_THROW(handle.dispatch(Increment{ &counter }), std::logic_error);
+}
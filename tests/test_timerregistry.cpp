@@ -0,0 +1,149 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TimerRegistryTest
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/ProfileScope.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+bool
+init_unit_test_func()
+{
+    return true;
+}
+
+BOOST_AUTO_TEST_CASE(InactiveByDefault)
+{
+    {
+        Opm::ProfileScope scope("assemble");
+    }
+    BOOST_CHECK(!Opm::TimerRegistry::active());
+    BOOST_CHECK(Opm::TimerRegistry::statistics().empty());
+}
+
+BOOST_AUTO_TEST_CASE(Hierarchy)
+{
+    auto cc = Dune::MPIHelper::getCollectiveCommunication();
+    Opm::TimerRegistry::reset();
+    Opm::TimerRegistry::start();
+    for (int i = 0; i < 3; ++i) {
+        Opm::ProfileScope step("time step");
+        {
+            Opm::ProfileScope assemble("assemble");
+            Opm::ProfileScope wells("well assemble");
+        }
+        Opm::ProfileScope solve("linear solve");
+    }
+    std::thread worker([]() { Opm::ProfileScope scope("assemble"); });
+    worker.join();
+    Opm::TimerRegistry::stop();
+
+    const auto stats = Opm::TimerRegistry::statistics(cc);
+    if (cc.rank() == 0) {
+        BOOST_REQUIRE_EQUAL(stats.size(), 5u);
+        // the enclosing timers come first
+        BOOST_CHECK_EQUAL(stats[0].path.size(), 1u);
+        BOOST_CHECK_EQUAL(stats[0].path[0], "assemble");
+        BOOST_CHECK_EQUAL(stats[0].calls, double(cc.size()));
+        BOOST_CHECK_EQUAL(stats[1].path[0], "time step");
+        BOOST_CHECK_EQUAL(stats[1].calls, 3.0 * cc.size());
+        BOOST_CHECK_EQUAL(stats[2].path.size(), 2u);
+        BOOST_CHECK_EQUAL(stats[2].path[1], "assemble");
+        BOOST_CHECK_EQUAL(stats[3].path.size(), 3u);
+        BOOST_CHECK_EQUAL(stats[3].path[2], "well assemble");
+        BOOST_CHECK_EQUAL(stats[4].path[1], "linear solve");
+        for (const auto& s : stats) {
+            BOOST_CHECK(s.min <= s.avg && s.avg <= s.max);
+            BOOST_CHECK(s.imbalance >= 1.0);
+        }
+    }
+    else {
+        BOOST_CHECK(stats.empty());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(JsonFormat)
+{
+    auto cc = Dune::MPIHelper::getCollectiveCommunication();
+    Opm::TimerRegistry::reset();
+    Opm::TimerRegistry::start();
+    {
+        Opm::ProfileScope scope("output");
+    }
+    Opm::TimerRegistry::stop();
+    Opm::TimerRegistry::write("timers.json", cc);
+
+    if (cc.rank() == 0) {
+        std::ifstream in("timers.json");
+        const std::string json((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        BOOST_CHECK_EQUAL(json.find("{\"timers\":["), 0u);
+        BOOST_CHECK(json.find("{\"path\":[\"output\"],\"calls\":" + std::to_string(cc.size())) != std::string::npos);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ProfileScopeDrivesAllBackends)
+{
+    Opm::TimerRegistry::reset();
+    Opm::TimerRegistry::start();
+    Opm::PerformanceTrace::start(10, 1);
+    double seconds = 0.0;
+    {
+        Opm::ProfileScope scope("linear solve");
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        seconds = scope.stop();
+        // a stopped scope is not recorded again
+        BOOST_CHECK_EQUAL(scope.stop(), seconds);
+        BOOST_CHECK_EQUAL(scope.elapsed(), seconds);
+    }
+    BOOST_CHECK(seconds >= 0.01);
+    BOOST_CHECK_EQUAL(Opm::PerformanceTrace::size(), 1u);
+    Opm::PerformanceTrace::stop();
+    Opm::TimerRegistry::stop();
+
+    const auto stats = Opm::TimerRegistry::statistics();
+    BOOST_REQUIRE_EQUAL(stats.size(), 1u);
+    BOOST_CHECK_EQUAL(stats[0].path[0], "linear solve");
+    BOOST_CHECK_EQUAL(stats[0].calls, 1.0);
+    BOOST_CHECK_CLOSE(stats[0].max, seconds, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(StopWatchWhenInactive)
+{
+    Opm::TimerRegistry::reset();
+    Opm::ProfileScope scope("output");
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    BOOST_CHECK(scope.elapsed() >= 0.01);
+    BOOST_CHECK(Opm::TimerRegistry::statistics().empty());
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
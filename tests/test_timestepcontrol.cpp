@@ -0,0 +1,109 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TimeStepControlTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/timestepping/TimeStepControl.hpp>
+
+#include <cmath>
+
+namespace
+{
+    class NoChange : public Opm::RelativeChangeInterface
+    {
+    public:
+        double relativeChange() const
+        {
+            return 0.0;
+        }
+    };
+
+    // record converged steps of sizes dt, 2 dt, 3 dt, ... with wall time dt^exponent
+    void recordSteps(const Opm::WallTimeTimeStepControl& control, const double dt, const double exponent)
+    {
+        for (int i = 1; i <= 5; ++i) {
+            control.recordStep(i * dt, true, std::pow(i * dt, exponent));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(GrowsWithoutHistory)
+{
+    const Opm::WallTimeTimeStepControl control(0.1, 0.75, 1.25, 10);
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(10.0, 0, NoChange(), 0.0), 12.5, 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(GrowsForSublinearCost)
+{
+    const Opm::WallTimeTimeStepControl control(0.1, 0.75, 1.25, 10);
+    recordSteps(control, 10.0, 0.5);
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(50.0, 0, NoChange(), 0.0), 62.5, 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(ShrinksForSuperlinearCost)
+{
+    const Opm::WallTimeTimeStepControl control(0.1, 0.75, 1.25, 10);
+    recordSteps(control, 10.0, 2.0);
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(50.0, 0, NoChange(), 0.0), 37.5, 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(KeepsForLinearCost)
+{
+    const Opm::WallTimeTimeStepControl control(0.1, 0.75, 1.25, 10);
+    recordSteps(control, 10.0, 1.0);
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(50.0, 0, NoChange(), 0.0), 50.0, 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(CutsBelowFailedSteps)
+{
+    const Opm::WallTimeTimeStepControl control(0.1, 0.75, 1.25, 4);
+    control.recordStep(10.0, true, 1.0);
+    control.recordStep(40.0, false, 4.0);
+    control.recordStep(20.0, true, 1.0);
+    control.recordStep(20.0, true, 1.0);
+    // one failure in four attempts exceeds the target chop rate
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(20.0, 0, NoChange(), 0.0), 15.0, 1e-10);
+
+    // the failure drops out of the history
+    control.recordStep(20.0, true, 1.0);
+    control.recordStep(20.0, true, 1.0);
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(20.0, 0, NoChange(), 0.0), 25.0, 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidRates)
+{
+    BOOST_CHECK_THROW(Opm::WallTimeTimeStepControl(0.1, 1.5, 1.25, 10), std::runtime_error);
+    BOOST_CHECK_THROW(Opm::WallTimeTimeStepControl(0.1, 0.75, 0.5, 10), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(RestoresState)
+{
+    const Opm::WallTimeTimeStepControl control(0.1, 0.75, 1.25, 10);
+    recordSteps(control, 10.0, 2.0);
+    control.recordStep(60.0, false, 100.0);
+
+    Opm::WallTimeTimeStepControl restored(0.1, 0.75, 1.25, 10);
+    restored.setState(control.state());
+    BOOST_CHECK_CLOSE(restored.computeTimeStepSize(50.0, 0, NoChange(), 0.0),
+                      control.computeTimeStepSize(50.0, 0, NoChange(), 0.0), 1e-10);
+    BOOST_CHECK_THROW(restored.setState(std::vector<double>(2, 1.0)), std::runtime_error);
+}
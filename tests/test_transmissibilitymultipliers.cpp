@@ -201,6 +201,44 @@ BOOST_AUTO_TEST_CASE(TransmissibilityMultipliersLegacyGridInterface)
                                 multMinusGeology, ntgGeology);
 }
 
+BOOST_AUTO_TEST_CASE(UpdateTransMultipliers)
+{
+    Opm::Parser parser;
+    Opm::ParseContext parseContext;
+
+    auto origDeck = parser.parseString(origDeckString, parseContext);
+    Opm::EclipseState origEclipseState(origDeck, parseContext);
+    auto multDeck = parser.parseString(multDeckString, parseContext);
+    Opm::EclipseState multEclipseState(multDeck, parseContext);
+
+    auto gridManager = std::make_shared<Opm::GridManager>(origEclipseState.getInputGrid());
+    const auto& grid = *(gridManager->c_grid());
+    auto props = std::make_shared<Opm::BlackoilPropsAdFromDeck>(origDeck, origEclipseState, grid);
+
+    Opm::DerivedGeology origGeology(grid, *props, origEclipseState, false);
+    Opm::DerivedGeology multGeology(grid, *props, multEclipseState, false);
+    Opm::DerivedGeology geology(grid, *props, origEclipseState, false);
+
+    // switching to the multipliers of MULTX/Y/Z gives the transmissibilities
+    // of a geology set up with them
+    BOOST_CHECK(geology.updateTransMultipliers(grid, multEclipseState) > 0);
+    const int numFaces = Opm::UgGridHelpers::numFaces(grid);
+    for (int faceIdx = 0; faceIdx < numFaces; ++faceIdx) {
+        BOOST_CHECK_CLOSE(geology.transmissibility()[faceIdx],
+                          multGeology.transmissibility()[faceIdx], 1e-6);
+    }
+
+    // unchanged multipliers do not change any face
+    BOOST_CHECK_EQUAL(geology.updateTransMultipliers(grid, multEclipseState), 0);
+
+    // and switching back restores the original transmissibilities
+    BOOST_CHECK(geology.updateTransMultipliers(grid, origEclipseState) > 0);
+    for (int faceIdx = 0; faceIdx < numFaces; ++faceIdx) {
+        BOOST_CHECK_CLOSE(geology.transmissibility()[faceIdx],
+                          origGeology.transmissibility()[faceIdx], 1e-6);
+    }
+}
+
 template<class G>
 void checkTransmissibilityValues(const G&                  grid,
                                  const Opm::DerivedGeology& origGeology,
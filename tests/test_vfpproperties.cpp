@@ -104,6 +104,26 @@ BOOST_AUTO_TEST_CASE(findInterpData)
     BOOST_CHECK_EQUAL(eval5.factor_, 1.0);
 }
 
+BOOST_AUTO_TEST_CASE(findInterpDataWithHint)
+{
+    std::vector<double> values = {1, 5, 7, 9, 11, 15};
+    std::vector<double> points = {6.0, 6.5, 9.0, -1.0, 19.0, 1.0, 15.0, 12.0, 5.0};
+
+    // The hinted search must give the same result as the full search
+    // for any sequence of values.
+    int hint = 0;
+    for (const double point : points) {
+        Opm::detail::InterpData ref = Opm::detail::findInterpData(point, values);
+        Opm::detail::InterpData eval = Opm::detail::findInterpData(point, values, hint);
+
+        BOOST_CHECK_EQUAL(eval.ind_[0], ref.ind_[0]);
+        BOOST_CHECK_EQUAL(eval.ind_[1], ref.ind_[1]);
+        BOOST_CHECK_EQUAL(eval.factor_, ref.factor_);
+        BOOST_CHECK_EQUAL(eval.inv_dist_, ref.inv_dist_);
+        BOOST_CHECK_EQUAL(hint, ref.ind_[1]);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // HelperTests
 
 
@@ -973,6 +993,71 @@ BOOST_AUTO_TEST_CASE(THPToBHPAndBackNonTrivial)
 
 
 
+BOOST_AUTO_TEST_CASE(THPToBHPAndBackWithHint)
+{
+    fillDataRandom();
+    initProperties();
+
+    double aqua = -0.5;
+    double liquid = -0.9;
+    double vapour = -0.1;
+    double alq = 32.9;
+
+    // Move the operating point slightly between evaluations, as during
+    // the Newton iterations of a well.
+    Opm::detail::VFPProdInterpHint hint;
+    for (int i=0; i<5; ++i) {
+        const double thp = 50.0 + i;
+        const double bhp_ref = properties->bhp(1, aqua, liquid, vapour, thp, alq);
+        const double bhp_val = properties->bhp(1, aqua, liquid, vapour, thp, alq, &hint);
+        BOOST_CHECK_EQUAL(bhp_val, bhp_ref);
+
+        const double thp_val = properties->thp(1, aqua, liquid, vapour, bhp_val, alq, &hint);
+        BOOST_CHECK_CLOSE(thp_val, thp, max_d_tol);
+
+        aqua *= 1.01;
+        liquid *= 0.99;
+    }
+}
+
+
+
+
+BOOST_AUTO_TEST_CASE(BHPAtFixedTHPWithHint)
+{
+    fillDataRandom();
+    initProperties();
+
+    double aqua = -0.5;
+    double liquid = -0.9;
+    double vapour = -0.1;
+    const double thp = 43.2;
+    const double alq = 32.9;
+
+    // A well under THP control evaluates the bhp at the same thp and alq,
+    // which after the first evaluation uses the slice of the table in the hint.
+    Opm::detail::VFPProdInterpHint hint;
+    for (int i=0; i<5; ++i) {
+        const double bhp_ref = properties->bhp(1, aqua, liquid, vapour, thp, alq);
+        const double bhp_val = properties->bhp(1, aqua, liquid, vapour, thp, alq, &hint);
+        BOOST_CHECK_CLOSE(bhp_val, bhp_ref, max_d_tol);
+
+        aqua *= 1.2;
+        liquid *= 0.9;
+        vapour *= 1.1;
+    }
+    BOOST_CHECK(!hint.thp_slice_.values_.empty());
+
+    // Another thp does not use the slice
+    const double bhp_ref = properties->bhp(1, aqua, liquid, vapour, thp + 1.0, alq);
+    const double bhp_val = properties->bhp(1, aqua, liquid, vapour, thp + 1.0, alq, &hint);
+    BOOST_CHECK_EQUAL(bhp_val, bhp_ref);
+    BOOST_CHECK(hint.thp_slice_.values_.empty());
+}
+
+
+
+
 BOOST_AUTO_TEST_SUITE_END() // Trivial tests
 
 
@@ -28,8 +28,9 @@
 #include <opm/core/well_controls.h>
 
 #include <iostream>
-#include <vector>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace
 {
@@ -222,6 +223,50 @@ BOOST_AUTO_TEST_CASE(Copy)
     }
 }
 
+BOOST_AUTO_TEST_CASE(Reserve)
+{
+    const int nphases = 2;
+    const int nwells  = 100;
+
+    std::shared_ptr<Wells> W(create_wells(nphases, 0, 0), destroy_wells);
+    BOOST_REQUIRE(W);
+
+    // Names are moved when the storage of the names grows.
+    int cells[] = { 0, 1 };
+    for (int w = 0; w < nwells / 2; ++w) {
+        const std::string name = "WELL" + std::to_string(w);
+        BOOST_REQUIRE(add_well(PRODUCER, 0.0, 2, nullptr, &cells[0],
+                               nullptr, nullptr, name.c_str(), true, W.get()));
+    }
+
+    // Bulk reservation keeps the added wells.
+    BOOST_REQUIRE(reserve_wells(nwells, 2 * nwells, 10 * nwells, W.get()));
+    for (int w = nwells / 2; w < nwells; ++w) {
+        const std::string name = "WELL" + std::to_string(w);
+        BOOST_REQUIRE(add_well(PRODUCER, 0.0, 2, nullptr, &cells[0],
+                               nullptr, nullptr, name.c_str(), true, W.get()));
+
+        BOOST_REQUIRE(reserve_well_controls(3, w, W.get()));
+        const double distr[] = { 1.0, 0.0 };
+        for (int c = 0; c < 3; ++c) {
+            BOOST_CHECK(append_well_controls(SURFACE_RATE, c, invalid_alq, invalid_vfp,
+                                             &distr[0], w, W.get()));
+        }
+        BOOST_CHECK_EQUAL(well_controls_get_num(W->ctrls[w]), 3);
+        BOOST_CHECK_EQUAL(well_controls_iget_target(W->ctrls[w], 2), 2.0);
+    }
+
+    BOOST_CHECK_EQUAL(W->number_of_wells, nwells);
+    BOOST_CHECK_EQUAL(W->well_connpos[nwells], 2 * nwells);
+    for (int w = 0; w < nwells; ++w) {
+        BOOST_CHECK_EQUAL(std::string(W->name[w]), "WELL" + std::to_string(w));
+    }
+
+    std::shared_ptr<Wells> W2(clone_wells(W.get()), destroy_wells);
+    BOOST_REQUIRE(W2);
+    BOOST_CHECK_EQUAL(std::string(W2->name[nwells - 1]), std::string(W->name[nwells - 1]));
+}
+
 BOOST_AUTO_TEST_CASE(Equals_WellsEqual_ReturnsTrue) {
     const int nphases = 2;
     const int nwells  = 2;
@@ -263,6 +263,42 @@ BOOST_AUTO_TEST_CASE(ControlsEqual) {
     BOOST_CHECK(!well_controls_equal( wellsManager1.c_wells()->ctrls[1] , wellsManager0.c_wells()->ctrls[1] , false));
 }
 
+BOOST_AUTO_TEST_CASE(RestoreInitialWells) {
+    const std::string filename = "wells_manager_data.data";
+    Opm::ParseContext parseContext;
+    Opm::Parser parser;
+    Opm::Deck deck(parser.parseFile(filename, parseContext));
+    Opm::EclipseState eclipseState(deck, parseContext);
+    Opm::GridManager vanguard(eclipseState.getInputGrid());
+    const auto& grid = eclipseState.getInputGrid();
+    const Opm::TableManager table ( deck );
+    const Opm::Eclipse3DProperties eclipseProperties ( deck , table, grid);
+    const Opm::Schedule sched(deck, grid, eclipseProperties, Opm::Phases(true, true, true), parseContext );
+
+    BOOST_CHECK(!Opm::WellsManager::scheduleChanged(sched, 1, 1));
+    BOOST_CHECK(Opm::WellsManager::scheduleChanged(sched, 0, 1));
+
+    Opm::WellsManager wellsManager(eclipseState, sched, 1, *vanguard.c_grid());
+    Opm::WellsManager reference(eclipseState, sched, 1, *vanguard.c_grid());
+
+    // the changes of the simulation to the controls
+    WellControls* ctrl0 = wellsManager.c_wells()->ctrls[0];
+    WellControls* ctrl1 = wellsManager.c_wells()->ctrls[1];
+    well_controls_stop_well(ctrl0);
+    well_controls_set_current(ctrl1, well_controls_get_num(ctrl1) - 1);
+    well_controls_add_new(BHP, 1e5, -1e100, -1, NULL, ctrl1);
+    BOOST_CHECK(!wells_equal(wellsManager.c_wells(), reference.c_wells(), false));
+
+    BOOST_CHECK(wellsManager.restoreInitialWells());
+    BOOST_CHECK(wells_equal(wellsManager.c_wells(), reference.c_wells(), false));
+    BOOST_CHECK(well_controls_well_is_open(wellsManager.c_wells()->ctrls[0]));
+    check_controls_epoch1(wellsManager.c_wells()->ctrls);
+
+    // wells not constructed from a schedule cannot be restored
+    Opm::WellsManager copy(const_cast<Wells*>(reference.c_wells()));
+    BOOST_CHECK(!copy.restoreInitialWells());
+}
+
 BOOST_AUTO_TEST_CASE(WellShutOK) {
     const std::string filename = "wells_manager_data.data";
     Opm::ParseContext parseContext;
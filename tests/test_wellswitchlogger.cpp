@@ -47,6 +47,21 @@ BOOST_AUTO_TEST_CASE(wellswitchlog)
 
 }
 
+BOOST_AUTO_TEST_CASE(wellswitchlog_noswitch)
+{
+    auto cc = Dune::MPIHelper::getCollectiveCommunication();
+
+    // Only the last rank switches; the other loggers have nothing to send.
+    Opm::wellhelpers::WellSwitchingLogger logger(cc);
+    if ( cc.rank() == cc.size() - 1 )
+    {
+        logger.wellSwitched("Well on last rank", THP, BHP);
+    }
+
+    // No rank switches at all.
+    Opm::wellhelpers::WellSwitchingLogger idle_logger(cc);
+}
+
 int main(int argc, char** argv)
 {
     Dune::MPIHelper::instance(argc, argv);